@@ -0,0 +1,67 @@
+#!/bin/bash
+# This script selects the build profile of the CompileAndLink*.sh scripts.
+# It is sourced by them after they have assigned EXE_DIR and it sets:
+# - PROFILE_OPT: the options which the script adds to its compilation options
+# - PROFILE_LNK: the options with which the script links its executable
+# - PROFILE_MAP: 1 if the script must write the linker map of its executable
+#
+# The build profile is taken from the BUILD_PROFILE environment variable:
+# - coverage (default): no optimization and gcov instrumentation; the scripts keep
+#   their own compilation options
+# - release: optimization with -O3 and link-time optimization across the FW Profile,
+#   CORDET FW, configuration and application object files
+# - pgo-gen: as release but the executables record an execution profile in
+#   directory $PGO_DIR when they run (the training run)
+# - pgo-use: as release but the optimization uses the execution profile recorded
+#   in directory $PGO_DIR by the training run
+# - footprint: optimization for size without instrumentation or link-time optimization
+#   (so that the code and data of each object file remain visible); the scripts write
+#   the linker map of their executable next to it
+#
+# All object files and executables of one build must be created with the same
+# profile. The profile-guided build is done by the pgo target of the Makefile.
+#
+#====================================================================================
+# Assign variables
+#====================================================================================
+
+BUILD_PROFILE=${BUILD_PROFILE-"coverage"}
+# The execution profile is found through an absolute path because it is recorded by
+# the executables at run time
+PGO_DIR=${PGO_DIR-"$(cd $EXE_DIR && pwd)/pgo"}
+
+RELEASE_OPT="-O3 -flto=auto"
+PROFILE_MAP=0
+
+#====================================================================================
+# Set the profile options
+#====================================================================================
+case "$BUILD_PROFILE" in
+coverage)
+	PROFILE_OPT="-O0 -g3 -fprofile-arcs -ftest-coverage"
+	PROFILE_LNK="-fprofile-arcs"
+	;;
+release)
+	PROFILE_OPT="$RELEASE_OPT"
+	PROFILE_LNK="$RELEASE_OPT"
+	;;
+pgo-gen)
+	# The I/O thread and the manager threads update the profile concurrently
+	PROFILE_OPT="$RELEASE_OPT -fprofile-generate=$PGO_DIR -fprofile-update=atomic"
+	PROFILE_LNK="$PROFILE_OPT"
+	;;
+pgo-use)
+	PROFILE_OPT="$RELEASE_OPT -fprofile-use=$PGO_DIR -fprofile-correction -Wno-missing-profile"
+	PROFILE_LNK="$PROFILE_OPT"
+	;;
+footprint)
+	PROFILE_OPT="-Os"
+	PROFILE_LNK=""
+	PROFILE_MAP=1
+	;;
+*)
+	echo "Unknown build profile: $BUILD_PROFILE (coverage, release, pgo-gen, pgo-use or footprint)"
+	exit 1
+	;;
+esac
+echo "- Build profile: $BUILD_PROFILE"
@@ -0,0 +1,312 @@
+#!/bin/bash
+# This script compiles and links the micro-benchmarks of the CORDET Demo.
+# The micro-benchmarks are built with the configuration of the Master Application and
+# with the same packet, socket and cycle options as the Master Application.
+# The script assumes that the FW Profile object files are available for linking
+# in directory $FW_OBJ.
+#
+# The script takes the following parameters:
+# 1. The path of the FW Profile source directory
+# 2. The path of the CORDET FW source directory
+# 3. The path of the CORDET FW examples directory
+# 4. The path to the directory where executables are created
+#
+# This script performs the following actions:
+# 1. Compile the CORDET FW files with the Master Demo #INCLUDE files
+# 2. Compile the Master Application Files (except its main program)
+# 3. Compile the micro-benchmark files
+# 4. Build the executable to run the micro-benchmarks
+#
+# Compilation is done with optimization and without the gcov options (or with the
+# options of the build profile selected by the BUILD_PROFILE environment variable,
+# see BuildProfile.sh).
+#
+#====================================================================================
+# Assign variables 
+#====================================================================================
+
+FW_DIR=$1
+CR_DIR=$2
+EXM_DIR=$3
+EXE_DIR=$4
+
+CR_SRC="$CR_DIR"
+
+FW_OBJ="$EXE_DIR"
+
+MA_SRC="$EXM_DIR/CrDemoMaster"
+MA_CNF_SRC="$EXM_DIR/CrConfigDemoMaster" 
+BN_SRC="$EXM_DIR/CrDemoBench"
+BN_OBJ="$EXE_DIR/bench"
+
+mkdir -p ${BN_OBJ}
+
+#====================================================================================
+# Set the compilation options
+#====================================================================================
+# The benchmarks are not instrumented in the coverage build profile; in the other
+# build profiles, they are built like the applications (see BuildProfile.sh)
+. "$(dirname $0)/BuildProfile.sh"
+if [ "$BUILD_PROFILE" = "coverage" ]; then
+	PROFILE_OPT="-O2"
+	PROFILE_LNK=""
+fi
+OPT="$PROFILE_OPT -Wall -c -fmessage-length=0"
+
+#====================================================================================
+# Set the packet options
+#====================================================================================
+# The inline packet header accessors are used by default (see CrFwPcktInline.h).
+# Set PCKT_OPT to an empty string in the environment to use the out-of-line accessors.
+# Add -DCR_FW_WIDE_APP_ID=1 to PCKT_OPT for 16-bit destinations and sources and 1024
+# application identifiers (see CrFwUserConstants.h); all applications must use the same setting.
+# Add -DCR_FW_PCKT_NET_ORDER=1 to PCKT_OPT to store the packets in network byte order so that hosts
+# of different byte orders can exchange them (see CrFwPcktWire.h); all applications must use the same setting.
+PCKT_OPT=${PCKT_OPT-"-DCR_FW_PCKT_INLINE=1"}
+OPT="$OPT $PCKT_OPT"
+
+#====================================================================================
+# Set the socket options
+#====================================================================================
+# The socket adapters use the epoll backend by default (see CrDaConstants.h).
+# Set SOCKET_OPT to an empty string in the environment to poll every connection.
+# Add -DCR_DA_SHM_TRANSPORT=1 to exchange packets through shared memory instead of
+# sockets (all applications must then run on the same host).
+# Replace -DCR_DA_SOCKET_EPOLL=1 with -DCR_DA_SOCKET_URING=1 to use the io_uring backend
+# of the server socket (Linux 6.0 or later).
+# Add -DCR_DA_IO_THREAD=1 -DCR_FW_PCKT_LOCK_FREE=1 to move the socket into a dedicated
+# I/O thread (see CrDaIoThread.h).
+SOCKET_OPT=${SOCKET_OPT-"-DCR_DA_SOCKET_EPOLL=1 -DCR_DA_SOCKET_TX_BATCH=1"}
+OPT="$OPT $SOCKET_OPT"
+
+#====================================================================================
+# Set the cycle options
+#====================================================================================
+# The demo applications execute the incoming packets in their control cycles by default
+# (see CrDaCycle.h).
+# Set CYCLE_OPT to -DCR_DA_CYCLE_EVENT_DRIVEN=1 in the environment to execute them as
+# soon as they arrive and add -DCR_DA_CYCLE_PERIOD_USEC=<period> to change the period.
+# Add -DCR_DA_MGR_POOL=1 -DCR_FW_PCKT_LOCK_FREE=1 to execute the independent managers
+# concurrently (see CrDaMgrPool.h).
+# Add -DCR_DA_IN_LOAD_DRAIN=1 to load all pending packets of the InStreams in every
+# cycle within a budget (see CrDaInLoad.h).
+# Add -DCR_DA_INMANAGER_SPILL=1 to extend the full InManagers with spill InManagers
+# (see CrDaInManagerChain.h).
+# Add -DCR_DA_INCMD_BATCH=1 to execute the bursts of InCommands of one kind in batches
+# (see CrDaInCmdBatch.h).
+# Add -DCR_DA_INSTREAM_DEDUP=1 to drop the duplicate packets before they reach the
+# InStreams (see CrDaLinkStats.h).
+# Add -DCR_DA_INCMD_EXPRESS=1 to execute the express InCommands as soon as they are
+# loaded (see CrDaInCmdExpress.h).
+# Add -DCR_DA_ACK_BATCH=1 to send the outcomes of the InCommands of a cycle in one
+# report to each source (see CrDaOutCmpAckBatch.h).
+# Add -DCR_DA_TEMP_STATS=1 to report windowed per-channel temperature statistics
+# instead of the individual violations (see CrDaOutCmpTempStats.h).
+# Add -DCR_DA_TEMP_STATS_ENCODING=1 to delta-encode the entries of the statistics reports
+# with a periodic key frame (see CrDaOutCmpTempStats.h).
+# Add -DCR_DA_STATIC_CREATION=1 to allocate the procedures of the configuration
+# statically (see CrDaConstants.h).
+# Add -DCR_DA_SM_FAST_PATH=1 to skip the executions of the InLoader and of the managers
+# which have nothing to do (see CrDaSmExec.h).
+# Add -DCR_DA_FOOTPRINT=1 to print the memory used by each framework component
+# (see CrDaFootprint.h).
+# Add -DCR_DA_SNAPSHOT=1 to resume from the state of the previous run after a restart
+# (see CrDaSnapshot.h).
+# Add -DCR_MA_TEMP_STORE_FILE=1 to write the time-series store of the temperature
+# violations through to a memory-mapped file (see CrMaTempStore.h).
+# Add -DCR_DA_STARTUP_PARALLEL=1 to set up the streams while the other framework components
+# are configured and to report the duration of each start-up task (see CrDaStartUp.h).
+# Add -DCR_DA_SM_PROF=1 to count and time the executions and transitions of the state machines
+# and procedures and print their profile at the end of the run (see CrDaSmProf.h).
+# Add -DCR_DA_FRAME_SCHED=1 to execute each control cycle as a frame of slots with time budgets
+# and to defer the work which exceeds them to the next frame (see CrDaFrame.h).
+# Add -DCR_DA_THREAD_PLACEMENT=1 to give each thread the CPU affinity and SCHED_FIFO priority of
+# its role and to lock the memory of the process (see CrDaThread.h).
+# Add -DCR_DA_SIM=1 (in all applications, with SOCKET_OPT set to -DCR_DA_SHM_TRANSPORT=1) to
+# run the applications on a virtual clock in deterministic turns without sleeping (see CrDaSim.h).
+# Add -DCR_DA_HEARTBEAT=1 (in all applications) to send heartbeats on the idle links and to declare
+# a silent peer down, which also fails a silent server over to the standby server (see CrDaHeartbeat.h).
+CYCLE_OPT=${CYCLE_OPT-""}
+OPT="$OPT $CYCLE_OPT"
+
+#====================================================================================
+# Set the trace options
+#====================================================================================
+# The error reports are printed to standard output by default.
+# Set TRACE_OPT to -DCR_DA_TRACE=1 in the environment to write them to the ring buffer
+# of the binary trace instead (see CrDaTrace.h).
+# Add -DCR_DA_METRICS=1 to count the packets and errors of the streams and to serve
+# them on a side TCP port for scraping (see CrDaMetrics.h).
+# Add -DCR_DA_CAPTURE=1 to record the packets of the transport in a memory-mapped
+# capture file (see CrDaCapture.h).
+# Add -DCR_DA_EVENT_LOG=1 to append the temperature violations to memory-mapped log
+# files which are synchronized with the disk by a flush thread (see CrDaEventLog.h).
+# Add -DCR_DA_ERR_QUEUE=1 to count the application errors and error reports per code and
+# to log them from a lock-free event queue (see CrDaErrQueue.h).
+# Add -DCR_DA_REPLAY=1 to feed a capture file back into the InStreams instead of
+# using the sockets (see CrDaReplay.h).
+# Add -DCR_DA_OUT_BACKLOG=1 to absorb the packets which the transport does not accept
+# in a growable backlog in front of the OutStream packet queues (see CrDaOutBacklog.h).
+# Add -DCR_DA_OUT_ADMIT_CMD_POLICY=<policy> (or ACK_POLICY or REP_POLICY) to choose whether the
+# commands (acknowledgements, violation reports) which find no OutComponent are rejected, deferred
+# or deferred in place of the oldest deferred one (see CrDaOutAdmit.h).
+# Add -DCR_DA_PCKT_TEMPLATE=1 to copy the headers of the repeated reports from templates
+# instead of serializing every header field (see CrDaPcktTemplate.h).
+# Add -DCR_DA_PCKT_CRC=1 (in all applications) to protect each packet on the socket connections
+# with a CRC-32C trailer; add -msse4.2 to compute it with the CRC32 instruction (see CrDaCrc.h).
+# Add -DCR_DA_LAT_TRACE=1 (in all applications) to record the hops of each packet in a trailer
+# and to print the latency histograms of its stages (see CrDaLatTrace.h).
+# Add -DCR_DA_SOCKET_RECONNECT=1 to OPT to re-establish the client connections which fail
+# and -DCR_DA_SOCKET_STANDBY_PORT=<port> to fail them over to a standby server (see CrDaClientSocket.h).
+# Add -DCR_DA_SOCKET_N_OF_CONNS=2 to OPT to give each packet group its own socket connection;
+# all applications must use the same setting (see CrDaServerSocket.h).
+# Add -DCR_FW_PCKT_ARENA=1 to map the packet pool at startup, on huge pages if it is at least
+# CR_FW_PCKT_ARENA_HUGE_SIZE bytes large, and -DCR_FW_PCKT_SLOT_ALIGN=<n> to change the
+# 64-byte alignment of the packets (see CrFwPcktArena.h).
+TRACE_OPT=${TRACE_OPT-""}
+OPT="$OPT $TRACE_OPT"
+
+#====================================================================================
+# Set the include path
+#====================================================================================
+INCLUDE="-I"$FW_DIR" -I"$BN_SRC" -I"$MA_SRC" -I"$CR_SRC" -I"$MA_CNF_SRC"" 
+
+echo "===================================================================================="
+echo " Compile all the C2 Implementation Files "
+echo "===================================================================================="
+gcc $INCLUDE $OPT -o $BN_OBJ/CrFwAux.o $CR_SRC/Aux/CrFwAux.c
+gcc $INCLUDE $OPT -o $BN_OBJ/CrFwBaseCmp.o $CR_SRC/BaseCmp/CrFwBaseCmp.c
+gcc $INCLUDE $OPT -o $BN_OBJ/CrFwDummyExecProc.o $CR_SRC/BaseCmp/CrFwDummyExecProc.c
+gcc $INCLUDE $OPT -o $BN_OBJ/CrFwInitProc.o $CR_SRC/BaseCmp/CrFwInitProc.c
+gcc $INCLUDE $OPT -o $BN_OBJ/CrFwResetProc.o $CR_SRC/BaseCmp/CrFwResetProc.c
+gcc $INCLUDE $OPT -o $BN_OBJ/CrFwInCmd.o $CR_SRC/InCmd/CrFwInCmd.c
+gcc $INCLUDE $OPT -o $BN_OBJ/CrFwInFactory.o $CR_SRC/InFactory/CrFwInFactory.c
+gcc $INCLUDE $OPT -o $BN_OBJ/CrFwInRegistry.o $CR_SRC/InRegistry/CrFwInRegistry.c
+gcc $INCLUDE $OPT -o $BN_OBJ/CrFwInManager.o $CR_SRC/InManager/CrFwInManager.c
+gcc $INCLUDE $OPT -o $BN_OBJ/CrFwInRep.o $CR_SRC/InRep/CrFwInRep.c
+gcc $INCLUDE $OPT -o $BN_OBJ/CrFwInRepExecProc.o $CR_SRC/InRep/CrFwInRepExecProc.c
+gcc $INCLUDE $OPT -o $BN_OBJ/CrFwInStream.o $CR_SRC/InStream/CrFwInStream.c
+gcc $INCLUDE $OPT -o $BN_OBJ/CrFwInLoader.o $CR_SRC/InLoader/CrFwInLoader.c
+gcc $INCLUDE $OPT -o $BN_OBJ/CrFwOutCmp.o $CR_SRC/OutCmp/CrFwOutCmp.c
+gcc $INCLUDE $OPT -o $BN_OBJ/CrFwOutFactory.o $CR_SRC/OutFactory/CrFwOutFactory.c
+gcc $INCLUDE $OPT -o $BN_OBJ/CrFwOutLoader.o $CR_SRC/OutLoader/CrFwOutLoader.c
+gcc $INCLUDE $OPT -o $BN_OBJ/CrFwOutManager.o $CR_SRC/OutManager/CrFwOutManager.c
+gcc $INCLUDE $OPT -o $BN_OBJ/CrFwOutRegistry.o $CR_SRC/OutRegistry/CrFwOutRegistry.c
+gcc $INCLUDE $OPT -o $BN_OBJ/CrFwOutStream.o $CR_SRC/OutStream/CrFwOutStream.c
+gcc $INCLUDE $OPT -o $BN_OBJ/CrFwPcktQueue.o $CR_SRC/Pckt/CrFwPcktQueue.c
+gcc $INCLUDE $OPT -o $BN_OBJ/CrFwUtilityFunctions.o $CR_SRC/UtilityFunctions/CrFwUtilityFunctions.c
+gcc $INCLUDE $OPT -o $BN_OBJ/CrFwAppSm.o $CR_SRC/AppStartUp/CrFwAppSm.c
+
+echo "===================================================================================="
+echo "- Compile the Master Application"
+echo "===================================================================================="
+function compileMasterFile {
+gcc $INCLUDE $OPT -o $BN_OBJ/"$1.o" $MA_SRC/"$1.c"
+}
+compileMasterFile "CrMaInRepTempViolation"
+compileMasterFile "CrMaOutCmpEnableDisable"
+compileMasterFile "CrMaOutCmpSetTempLimit"
+compileMasterFile "CrMaOutLane"
+compileMasterFile "CrMaCmdState"
+compileMasterFile "CrMaCmdSched"
+compileMasterFile "CrMaTempStore"
+compileMasterFile "CrMaKindIndex"
+compileMasterFile "CrMaInRepCmdAck"
+compileMasterFile "CrMaLatency"
+compileMasterFile "CrMaLoadGen"
+compileMasterFile "CrDaClientSocket"
+compileMasterFile "CrDaOutCmpTempViolation"
+compileMasterFile "CrDaOutCmpTempBatch"
+compileMasterFile "CrDaOutCmpTempStats"
+compileMasterFile "CrDaOutCmpAck"
+compileMasterFile "CrDaOutCmpAckBatch"
+compileMasterFile "CrDaPcktTemplate"
+compileMasterFile "CrDaServerSocket"
+compileMasterFile "CrDaRxRing"
+compileMasterFile "CrDaTxQueue"
+compileMasterFile "CrDaCrc"
+compileMasterFile "CrDaConfig"
+compileMasterFile "CrDaShm"
+compileMasterFile "CrDaUdpSocket"
+compileMasterFile "CrDaSocketProfile"
+compileMasterFile "CrDaHandshake"
+compileMasterFile "CrDaUring"
+compileMasterFile "CrDaCycle"
+compileMasterFile "CrDaIoThread"
+compileMasterFile "CrDaPhase"
+compileMasterFile "CrDaLinkStats"
+compileMasterFile "CrDaTrace"
+compileMasterFile "CrDaLog"
+compileMasterFile "CrDaMetrics"
+compileMasterFile "CrDaCapture"
+compileMasterFile "CrDaEventLog"
+compileMasterFile "CrDaErrQueue"
+compileMasterFile "CrDaStatShard"
+compileMasterFile "CrDaSim"
+compileMasterFile "CrDaHeartbeat"
+compileMasterFile "CrDaLatTrace"
+compileMasterFile "CrDaReplay"
+compileMasterFile "CrDaOutBacklog"
+compileMasterFile "CrDaOutCmpPool"
+compileMasterFile "CrDaOutAdmit"
+compileMasterFile "CrDaOutLoadQueue"
+compileMasterFile "CrDaInCmpPool"
+compileMasterFile "CrDaMgrPool"
+compileMasterFile "CrDaInLoad"
+compileMasterFile "CrDaInManagerChain"
+compileMasterFile "CrDaInCmdBatch"
+compileMasterFile "CrDaInCmdExpress"
+compileMasterFile "CrDaInCmdAsync"
+compileMasterFile "CrDaSmExec"
+compileMasterFile "CrDaSmProf"
+compileMasterFile "CrDaFootprint"
+compileMasterFile "CrDaSnapshot"
+compileMasterFile "CrDaStartUp"
+compileMasterFile "CrDaStreamMap"
+compileMasterFile "CrDaFrame"
+compileMasterFile "CrDaThread"
+compileMasterFile "CrDaShutdown"
+compileMasterFile "CrDaTempMonitor"
+
+echo "===================================================================================="
+echo " Compile the C2 Configuration Files for the Master Application "
+echo "===================================================================================="
+function compileConfigFile {
+gcc $INCLUDE $OPT -o $BN_OBJ/"$1.o" $MA_CNF_SRC/"$1.c"
+}
+compileConfigFile "CrFwRepErr"
+compileConfigFile "CrFwPckt"
+compileConfigFile "CrFwRepInCmdOutcome"
+compileConfigFile "CrFwTime"
+compileConfigFile "CrFwAppStartUpProc"
+compileConfigFile "CrFwAppResetProc"
+compileConfigFile "CrFwAppShutdownProc"
+
+echo "===================================================================================="
+echo " Compile the micro-benchmarks "
+echo "===================================================================================="
+gcc $INCLUDE $OPT -o $BN_OBJ/CrBnMain.o $BN_SRC/CrBnMain.c
+
+echo "===================================================================================="
+echo " Build the executable to run the micro-benchmarks "
+echo "===================================================================================="
+# The linker map is written by the footprint build profile (see BuildProfile.sh)
+LNKMAP=""
+if [ "$PROFILE_MAP" = "1" ]; then
+	LNKMAP="-Wl,-Map,$EXE_DIR/cr_bench.map"
+fi
+gcc $PROFILE_LNK -o $EXE_DIR/cr_bench \
+$FW_OBJ/FwPrConfig.o $FW_OBJ/FwPrCore.o $FW_OBJ/FwPrDCreate.o $FW_OBJ/FwPrSCreate.o $FW_OBJ/FwSmAux.o \
+$FW_OBJ/FwSmConfig.o $FW_OBJ/FwSmCore.o $FW_OBJ/FwSmDCreate.o $FW_OBJ/FwSmSCreate.o \
+$BN_OBJ/CrFwAux.o $BN_OBJ/CrFwBaseCmp.o $BN_OBJ/CrFwDummyExecProc.o \
+$BN_OBJ/CrFwInitProc.o $BN_OBJ/CrFwResetProc.o $BN_OBJ/CrFwInCmd.o $BN_OBJ/CrFwInRegistry.o \
+$BN_OBJ/CrFwInManager.o $BN_OBJ/CrFwInRep.o $BN_OBJ/CrFwInRepExecProc.o $BN_OBJ/CrFwInLoader.o \
+$BN_OBJ/CrFwInFactory.o $BN_OBJ/CrFwInStream.o $BN_OBJ/CrFwOutCmp.o $BN_OBJ/CrFwOutFactory.o \
+$BN_OBJ/CrFwOutLoader.o $BN_OBJ/CrFwOutManager.o $BN_OBJ/CrFwOutRegistry.o $BN_OBJ/CrFwOutStream.o $BN_OBJ/CrFwPcktQueue.o \
+$BN_OBJ/CrFwUtilityFunctions.o $BN_OBJ/CrFwPckt.o $BN_OBJ/CrFwRepErr.o $BN_OBJ/CrFwTime.o \
+$BN_OBJ/CrFwAppSm.o $BN_OBJ/CrFwAppStartUpProc.o $BN_OBJ/CrFwAppResetProc.o $BN_OBJ/CrFwAppShutdownProc.o \
+$BN_OBJ/CrFwRepInCmdOutcome.o \
+$BN_OBJ/CrMaInRepTempViolation.o $BN_OBJ/CrMaOutCmpEnableDisable.o $BN_OBJ/CrMaOutCmpSetTempLimit.o $BN_OBJ/CrMaOutLane.o $BN_OBJ/CrMaCmdState.o $BN_OBJ/CrMaCmdSched.o $BN_OBJ/CrMaTempStore.o $BN_OBJ/CrMaKindIndex.o $BN_OBJ/CrMaInRepCmdAck.o $BN_OBJ/CrMaLatency.o \
+$BN_OBJ/CrBnMain.o $BN_OBJ/CrDaClientSocket.o $BN_OBJ/CrDaServerSocket.o $BN_OBJ/CrDaRxRing.o $BN_OBJ/CrDaTxQueue.o $BN_OBJ/CrDaCrc.o $BN_OBJ/CrDaConfig.o $BN_OBJ/CrDaShm.o $BN_OBJ/CrDaUdpSocket.o $BN_OBJ/CrDaSocketProfile.o $BN_OBJ/CrDaHandshake.o $BN_OBJ/CrDaUring.o $BN_OBJ/CrDaCycle.o $BN_OBJ/CrDaIoThread.o $BN_OBJ/CrDaPhase.o $BN_OBJ/CrDaLinkStats.o $BN_OBJ/CrDaTrace.o $BN_OBJ/CrDaLog.o $BN_OBJ/CrDaMetrics.o $BN_OBJ/CrDaCapture.o $BN_OBJ/CrDaEventLog.o $BN_OBJ/CrDaErrQueue.o $BN_OBJ/CrDaStatShard.o $BN_OBJ/CrDaSim.o $BN_OBJ/CrDaHeartbeat.o $BN_OBJ/CrDaLatTrace.o $BN_OBJ/CrDaReplay.o $BN_OBJ/CrDaOutBacklog.o $BN_OBJ/CrDaOutCmpPool.o $BN_OBJ/CrDaOutAdmit.o $BN_OBJ/CrDaOutLoadQueue.o $BN_OBJ/CrDaInCmpPool.o $BN_OBJ/CrDaMgrPool.o $BN_OBJ/CrDaInLoad.o $BN_OBJ/CrDaInManagerChain.o $BN_OBJ/CrDaInCmdBatch.o $BN_OBJ/CrDaInCmdExpress.o $BN_OBJ/CrDaInCmdAsync.o $BN_OBJ/CrDaSmExec.o $BN_OBJ/CrDaSmProf.o $BN_OBJ/CrDaFootprint.o $BN_OBJ/CrDaSnapshot.o $BN_OBJ/CrDaStartUp.o $BN_OBJ/CrDaStreamMap.o $BN_OBJ/CrDaFrame.o $BN_OBJ/CrDaThread.o $BN_OBJ/CrDaShutdown.o $BN_OBJ/CrMaLoadGen.o \
+$BN_OBJ/CrDaOutCmpTempViolation.o $BN_OBJ/CrDaOutCmpTempBatch.o $BN_OBJ/CrDaOutCmpTempStats.o $BN_OBJ/CrDaOutCmpAck.o $BN_OBJ/CrDaOutCmpAckBatch.o $BN_OBJ/CrDaPcktTemplate.o $BN_OBJ/CrDaTempMonitor.o \
+-lpthread -lrt $LNKMAP
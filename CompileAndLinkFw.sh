@@ -25,8 +25,14 @@ mkdir -p ${FW_OBJ}
 #====================================================================================
 # Set the compilation options
 #====================================================================================
+# The FW Profile is not instrumented in the coverage build profile; in the other build
+# profiles, it is optimized together with the applications (see BuildProfile.sh)
+. "$(dirname $0)/BuildProfile.sh"
+if [ "$BUILD_PROFILE" = "coverage" ]; then
+	PROFILE_OPT="-Os"
+fi
 # Use the following definition for linker map
-OPT="-Os -Wall -c -ansi -pedantic -fmessage-length=0" 
+OPT="$PROFILE_OPT -Wall -c -ansi -pedantic -fmessage-length=0" 
 #OPT="-O0 -g3 -Wall -c -fmessage-length=0 -fprofile-arcs -ftest-coverage"  
 
 echo "===================================================================================="
@@ -35,6 +41,7 @@ echo "==========================================================================
 gcc $OPT -o $FW_OBJ/FwPrConfig.o $FW_SRC/FwPrConfig.c 
 gcc $OPT -o $FW_OBJ/FwPrCore.o $FW_SRC/FwPrCore.c
 gcc $OPT -o $FW_OBJ/FwPrDCreate.o $FW_SRC/FwPrDCreate.c
+gcc $OPT -o $FW_OBJ/FwPrSCreate.o $FW_SRC/FwPrSCreate.c
 gcc $OPT -o $FW_OBJ/FwSmAux.o $FW_SRC/FwSmAux.c
 gcc $OPT -o $FW_OBJ/FwSmConfig.o $FW_SRC/FwSmConfig.c
 gcc $OPT -o $FW_OBJ/FwSmCore.o $FW_SRC/FwSmCore.c
@@ -14,7 +14,9 @@
 # 2. Compile the Master Application Files for the C2 Implementation
 # 3. Build the executable to run the Master Application 
 #
-# In all cases, compilation and linking is done with the gcov options.
+# Compilation and linking is done with the options of the build profile selected by
+# the BUILD_PROFILE environment variable (see BuildProfile.sh): by default, they are
+# the gcov options.
 #
 #====================================================================================
 # Assign variables 
@@ -40,7 +42,128 @@ mkdir -p ${MA_OBJ}
 #====================================================================================
 # Use the following definition for linker map
 #OPT="-Os -Wall -c -fmessage-length=0" 
-OPT="-O0 -g3 -Wall -c -fmessage-length=0 -fprofile-arcs -ftest-coverage"  
+# The optimization and instrumentation options are those of the build profile
+. "$(dirname $0)/BuildProfile.sh"
+OPT="$PROFILE_OPT -Wall -c -fmessage-length=0"
+
+#====================================================================================
+# Set the packet options
+#====================================================================================
+# The inline packet header accessors are used by default (see CrFwPcktInline.h).
+# Set PCKT_OPT to an empty string in the environment to use the out-of-line accessors.
+# Add -DCR_FW_WIDE_APP_ID=1 to PCKT_OPT for 16-bit destinations and sources and 1024
+# application identifiers (see CrFwUserConstants.h); all applications must use the same setting.
+# Add -DCR_FW_PCKT_NET_ORDER=1 to PCKT_OPT to store the packets in network byte order so that hosts
+# of different byte orders can exchange them (see CrFwPcktWire.h); all applications must use the same setting.
+PCKT_OPT=${PCKT_OPT-"-DCR_FW_PCKT_INLINE=1"}
+OPT="$OPT $PCKT_OPT"
+
+#====================================================================================
+# Set the socket options
+#====================================================================================
+# The socket adapters use the epoll backend by default (see CrDaConstants.h).
+# Set SOCKET_OPT to an empty string in the environment to poll every connection.
+# Add -DCR_DA_SHM_TRANSPORT=1 to exchange packets through shared memory instead of
+# sockets (all applications must then run on the same host).
+# Replace -DCR_DA_SOCKET_EPOLL=1 with -DCR_DA_SOCKET_URING=1 to use the io_uring backend
+# of the server socket (Linux 6.0 or later).
+# Add -DCR_DA_IO_THREAD=1 -DCR_FW_PCKT_LOCK_FREE=1 to move the socket into a dedicated
+# I/O thread (see CrDaIoThread.h).
+# Add -DCR_DA_IO_THREAD_PIPELINE=1 as well to overlap the I/O of the adjacent cycles
+# with the processing of the current cycle (the pipelined cycle, see CrDaIoThread.h).
+SOCKET_OPT=${SOCKET_OPT-"-DCR_DA_SOCKET_EPOLL=1 -DCR_DA_SOCKET_TX_BATCH=1"}
+OPT="$OPT $SOCKET_OPT"
+
+#====================================================================================
+# Set the cycle options
+#====================================================================================
+# The demo applications execute the incoming packets in their control cycles by default
+# (see CrDaCycle.h).
+# Set CYCLE_OPT to -DCR_DA_CYCLE_EVENT_DRIVEN=1 in the environment to execute them as
+# soon as they arrive and add -DCR_DA_CYCLE_PERIOD_USEC=<period> to change the period.
+# Add -DCR_DA_MGR_POOL=1 -DCR_FW_PCKT_LOCK_FREE=1 to execute the independent managers
+# concurrently (see CrDaMgrPool.h).
+# Add -DCR_DA_IN_LOAD_DRAIN=1 to load all pending packets of the InStreams in every
+# cycle within a budget (see CrDaInLoad.h).
+# Add -DCR_DA_INMANAGER_SPILL=1 to extend the full InManagers with spill InManagers
+# (see CrDaInManagerChain.h).
+# Add -DCR_DA_INCMD_BATCH=1 to execute the bursts of InCommands of one kind in batches
+# (see CrDaInCmdBatch.h).
+# Add -DCR_DA_INSTREAM_DEDUP=1 to drop the duplicate packets before they reach the
+# InStreams (see CrDaLinkStats.h).
+# Add -DCR_DA_INCMD_EXPRESS=1 to execute the express InCommands as soon as they are
+# loaded (see CrDaInCmdExpress.h).
+# Add -DCR_DA_ACK_BATCH=1 to send the outcomes of the InCommands of a cycle in one
+# report to each source (see CrDaOutCmpAckBatch.h).
+# Add -DCR_DA_TEMP_STATS=1 to report windowed per-channel temperature statistics
+# instead of the individual violations (see CrDaOutCmpTempStats.h).
+# Add -DCR_DA_TEMP_STATS_ENCODING=1 to delta-encode the entries of the statistics reports
+# with a periodic key frame (see CrDaOutCmpTempStats.h).
+# Add -DCR_DA_STATIC_CREATION=1 to allocate the procedures of the configuration
+# statically (see CrDaConstants.h).
+# Add -DCR_DA_SM_FAST_PATH=1 to skip the executions of the InLoader and of the managers
+# which have nothing to do (see CrDaSmExec.h).
+# Add -DCR_DA_FOOTPRINT=1 to print the memory used by each framework component
+# (see CrDaFootprint.h).
+# Add -DCR_DA_SNAPSHOT=1 to resume from the state of the previous run after a restart
+# (see CrDaSnapshot.h).
+# Add -DCR_DA_RUNTIME_CONFIG=1 to override the sizes of the packet pool, its quotas and the
+# budgets of the cycle frame from a configuration file at start-up (see CrDaConfig.h).
+# Add -DCR_MA_TEMP_STORE_FILE=1 to write the time-series store of the temperature
+# violations through to a memory-mapped file (see CrMaTempStore.h).
+# Add -DCR_DA_STARTUP_PARALLEL=1 to set up the streams while the other framework components
+# are configured and to report the duration of each start-up task (see CrDaStartUp.h).
+# Add -DCR_DA_SM_PROF=1 to count and time the executions and transitions of the state machines
+# and procedures and print their profile at the end of the run (see CrDaSmProf.h).
+# Add -DCR_DA_FRAME_SCHED=1 to execute each control cycle as a frame of slots with time budgets
+# and to defer the work which exceeds them to the next frame (see CrDaFrame.h).
+# Add -DCR_DA_THREAD_PLACEMENT=1 to give each thread the CPU affinity and SCHED_FIFO priority of
+# its role and to lock the memory of the process (see CrDaThread.h).
+# Add -DCR_DA_SIM=1 (in all applications, with SOCKET_OPT set to -DCR_DA_SHM_TRANSPORT=1) to
+# run the applications on a virtual clock in deterministic turns without sleeping (see CrDaSim.h).
+# Add -DCR_DA_HEARTBEAT=1 (in all applications) to send heartbeats on the idle links and to declare
+# a silent peer down, which also fails a silent server over to the standby server (see CrDaHeartbeat.h).
+CYCLE_OPT=${CYCLE_OPT-""}
+OPT="$OPT $CYCLE_OPT"
+
+#====================================================================================
+# Set the trace options
+#====================================================================================
+# The error reports are printed to standard output by default.
+# Set TRACE_OPT to -DCR_DA_TRACE=1 in the environment to write them to the ring buffer
+# of the binary trace instead (see CrDaTrace.h).
+# Add -DCR_DA_METRICS=1 to count the packets and errors of the streams and to serve
+# them on a side TCP port for scraping (see CrDaMetrics.h).
+# Add -DCR_DA_CAPTURE=1 to record the packets of the transport in a memory-mapped
+# capture file (see CrDaCapture.h).
+# Add -DCR_DA_EVENT_LOG=1 to append the temperature violations to memory-mapped log
+# files which are synchronized with the disk by a flush thread (see CrDaEventLog.h).
+# Add -DCR_DA_ERR_QUEUE=1 to count the application errors and error reports per code and
+# to log them from a lock-free event queue (see CrDaErrQueue.h).
+# Add -DCR_DA_REPLAY=1 to feed a capture file back into the InStreams instead of
+# using the sockets (see CrDaReplay.h).
+# Add -DCR_DA_OUT_BACKLOG=1 to absorb the packets which the transport does not accept
+# in a growable backlog in front of the OutStream packet queues (see CrDaOutBacklog.h).
+# Add -DCR_DA_OUT_ADMIT_CMD_POLICY=<policy> (or ACK_POLICY or REP_POLICY) to choose whether the
+# commands (acknowledgements, violation reports) which find no OutComponent are rejected, deferred
+# or deferred in place of the oldest deferred one (see CrDaOutAdmit.h).
+# Add -DCR_DA_PCKT_TEMPLATE=1 to copy the headers of the repeated reports from templates
+# instead of serializing every header field (see CrDaPcktTemplate.h).
+# Add -DCR_DA_PCKT_CRC=1 (in all applications) to protect each packet on the socket connections
+# with a CRC-32C trailer; add -msse4.2 to compute it with the CRC32 instruction (see CrDaCrc.h).
+# Add -DCR_DA_HANDSHAKE=1 (in all applications) to let the peers of each socket connection
+# agree on the features of the wire format, e.g. the CRC-32C trailer (see CrDaHandshake.h).
+# Add -DCR_DA_LAT_TRACE=1 (in all applications) to record the hops of each packet in a trailer
+# and to print the latency histograms of its stages (see CrDaLatTrace.h).
+# Add -DCR_DA_SOCKET_RECONNECT=1 to OPT to re-establish the client connections which fail
+# and -DCR_DA_SOCKET_STANDBY_PORT=<port> to fail them over to a standby server (see CrDaClientSocket.h).
+# Add -DCR_DA_SOCKET_N_OF_CONNS=2 to OPT to give each packet group its own socket connection;
+# all applications must use the same setting (see CrDaServerSocket.h).
+# Add -DCR_FW_PCKT_ARENA=1 to map the packet pool at startup, on huge pages if it is at least
+# CR_FW_PCKT_ARENA_HUGE_SIZE bytes large, and -DCR_FW_PCKT_SLOT_ALIGN=<n> to change the
+# 64-byte alignment of the packets (see CrFwPcktArena.h).
+TRACE_OPT=${TRACE_OPT-""}
+OPT="$OPT $TRACE_OPT"
 
 #====================================================================================
 # Set the include path
@@ -82,10 +205,67 @@ gcc $INCLUDE $OPT -o $MA_OBJ/"$1.o" $MA_SRC/"$1.c"
 compileMasterFile "CrMaInRepTempViolation"
 compileMasterFile "CrMaOutCmpEnableDisable"
 compileMasterFile "CrMaOutCmpSetTempLimit"
+compileMasterFile "CrMaOutLane"
+compileMasterFile "CrMaCmdState"
+compileMasterFile "CrMaCmdSched"
+compileMasterFile "CrMaTempStore"
+compileMasterFile "CrMaKindIndex"
+compileMasterFile "CrMaInRepCmdAck"
+compileMasterFile "CrMaLatency"
 compileMasterFile "CrMaMain"
+compileMasterFile "CrMaLoadGen"
 compileMasterFile "CrDaClientSocket"
 compileMasterFile "CrDaOutCmpTempViolation"
+compileMasterFile "CrDaOutCmpTempBatch"
+compileMasterFile "CrDaOutCmpTempStats"
+compileMasterFile "CrDaOutCmpAck"
+compileMasterFile "CrDaOutCmpAckBatch"
+compileMasterFile "CrDaPcktTemplate"
 compileMasterFile "CrDaServerSocket"
+compileMasterFile "CrDaRxRing"
+compileMasterFile "CrDaTxQueue"
+compileMasterFile "CrDaCrc"
+compileMasterFile "CrDaConfig"
+compileMasterFile "CrDaShm"
+compileMasterFile "CrDaUdpSocket"
+compileMasterFile "CrDaSocketProfile"
+compileMasterFile "CrDaHandshake"
+compileMasterFile "CrDaUring"
+compileMasterFile "CrDaCycle"
+compileMasterFile "CrDaIoThread"
+compileMasterFile "CrDaPhase"
+compileMasterFile "CrDaLinkStats"
+compileMasterFile "CrDaTrace"
+compileMasterFile "CrDaLog"
+compileMasterFile "CrDaMetrics"
+compileMasterFile "CrDaCapture"
+compileMasterFile "CrDaEventLog"
+compileMasterFile "CrDaErrQueue"
+compileMasterFile "CrDaStatShard"
+compileMasterFile "CrDaSim"
+compileMasterFile "CrDaHeartbeat"
+compileMasterFile "CrDaLatTrace"
+compileMasterFile "CrDaReplay"
+compileMasterFile "CrDaOutBacklog"
+compileMasterFile "CrDaOutCmpPool"
+compileMasterFile "CrDaOutAdmit"
+compileMasterFile "CrDaOutLoadQueue"
+compileMasterFile "CrDaInCmpPool"
+compileMasterFile "CrDaMgrPool"
+compileMasterFile "CrDaInLoad"
+compileMasterFile "CrDaInManagerChain"
+compileMasterFile "CrDaInCmdBatch"
+compileMasterFile "CrDaInCmdExpress"
+compileMasterFile "CrDaInCmdAsync"
+compileMasterFile "CrDaSmExec"
+compileMasterFile "CrDaSmProf"
+compileMasterFile "CrDaFootprint"
+compileMasterFile "CrDaSnapshot"
+compileMasterFile "CrDaStartUp"
+compileMasterFile "CrDaStreamMap"
+compileMasterFile "CrDaFrame"
+compileMasterFile "CrDaThread"
+compileMasterFile "CrDaShutdown"
 compileMasterFile "CrDaTempMonitor"
 
 echo "===================================================================================="
@@ -105,12 +285,13 @@ compileConfigFile "CrFwAppShutdownProc"
 echo "===================================================================================="
 echo " Build the executable to run the Master Application "
 echo "===================================================================================="
-# Use following definition for linker map (and remove -fprofile-arcs option)
-#LNKMAP="-Wl,-Map,$EXE_DIR/cr_master.map" 
+# The linker map is written by the footprint build profile (see BuildProfile.sh)
 LNKMAP=""
-#gcc -o $EXE_DIR/cr_master \
-gcc -fprofile-arcs -o $EXE_DIR/cr_master \
-$FW_OBJ/FwPrConfig.o $FW_OBJ/FwPrCore.o $FW_OBJ/FwPrDCreate.o $FW_OBJ/FwSmAux.o \
+if [ "$PROFILE_MAP" = "1" ]; then
+	LNKMAP="-Wl,-Map,$EXE_DIR/cr_master.map"
+fi
+# The object files of the application
+APP_OBJ="$FW_OBJ/FwPrConfig.o $FW_OBJ/FwPrCore.o $FW_OBJ/FwPrDCreate.o $FW_OBJ/FwPrSCreate.o $FW_OBJ/FwSmAux.o \
 $FW_OBJ/FwSmConfig.o $FW_OBJ/FwSmCore.o $FW_OBJ/FwSmDCreate.o $FW_OBJ/FwSmSCreate.o \
 $MA_OBJ/CrFwAux.o $MA_OBJ/CrFwBaseCmp.o $MA_OBJ/CrFwDummyExecProc.o \
 $MA_OBJ/CrFwInitProc.o $MA_OBJ/CrFwResetProc.o $MA_OBJ/CrFwInCmd.o $MA_OBJ/CrFwInRegistry.o \
@@ -120,7 +301,14 @@ $MA_OBJ/CrFwOutLoader.o $MA_OBJ/CrFwOutManager.o $MA_OBJ/CrFwOutRegistry.o $MA_O
 $MA_OBJ/CrFwUtilityFunctions.o $MA_OBJ/CrFwPckt.o $MA_OBJ/CrFwRepErr.o $MA_OBJ/CrFwTime.o \
 $MA_OBJ/CrFwAppSm.o $MA_OBJ/CrFwAppStartUpProc.o $MA_OBJ/CrFwAppResetProc.o $MA_OBJ/CrFwAppShutdownProc.o \
 $MA_OBJ/CrFwRepInCmdOutcome.o \
-$MA_OBJ/CrMaInRepTempViolation.o $MA_OBJ/CrMaOutCmpEnableDisable.o $MA_OBJ/CrMaOutCmpSetTempLimit.o \
-$MA_OBJ/CrMaMain.o $MA_OBJ/CrDaClientSocket.o $MA_OBJ/CrDaServerSocket.o \
-$MA_OBJ/CrDaOutCmpTempViolation.o $MA_OBJ/CrDaTempMonitor.o \
--lpthread $LNKMAP
+$MA_OBJ/CrMaInRepTempViolation.o $MA_OBJ/CrMaOutCmpEnableDisable.o $MA_OBJ/CrMaOutCmpSetTempLimit.o $MA_OBJ/CrMaOutLane.o $MA_OBJ/CrMaCmdState.o $MA_OBJ/CrMaCmdSched.o $MA_OBJ/CrMaTempStore.o $MA_OBJ/CrMaKindIndex.o $MA_OBJ/CrMaInRepCmdAck.o $MA_OBJ/CrMaLatency.o \
+$MA_OBJ/CrMaMain.o $MA_OBJ/CrDaClientSocket.o $MA_OBJ/CrDaServerSocket.o $MA_OBJ/CrDaRxRing.o $MA_OBJ/CrDaTxQueue.o $MA_OBJ/CrDaCrc.o $MA_OBJ/CrDaConfig.o $MA_OBJ/CrDaShm.o $MA_OBJ/CrDaUdpSocket.o $MA_OBJ/CrDaSocketProfile.o $MA_OBJ/CrDaHandshake.o $MA_OBJ/CrDaUring.o $MA_OBJ/CrDaCycle.o $MA_OBJ/CrDaIoThread.o $MA_OBJ/CrDaPhase.o $MA_OBJ/CrDaLinkStats.o $MA_OBJ/CrDaTrace.o $MA_OBJ/CrDaLog.o $MA_OBJ/CrDaMetrics.o $MA_OBJ/CrDaCapture.o $MA_OBJ/CrDaEventLog.o $MA_OBJ/CrDaErrQueue.o $MA_OBJ/CrDaStatShard.o $MA_OBJ/CrDaSim.o $MA_OBJ/CrDaHeartbeat.o $MA_OBJ/CrDaLatTrace.o $MA_OBJ/CrDaReplay.o $MA_OBJ/CrDaOutBacklog.o $MA_OBJ/CrDaOutCmpPool.o $MA_OBJ/CrDaOutAdmit.o $MA_OBJ/CrDaOutLoadQueue.o $MA_OBJ/CrDaInCmpPool.o $MA_OBJ/CrDaMgrPool.o $MA_OBJ/CrDaInLoad.o $MA_OBJ/CrDaInManagerChain.o $MA_OBJ/CrDaInCmdBatch.o $MA_OBJ/CrDaInCmdExpress.o $MA_OBJ/CrDaInCmdAsync.o $MA_OBJ/CrDaSmExec.o $MA_OBJ/CrDaSmProf.o $MA_OBJ/CrDaFootprint.o $MA_OBJ/CrDaSnapshot.o $MA_OBJ/CrDaStartUp.o $MA_OBJ/CrDaStreamMap.o $MA_OBJ/CrDaFrame.o $MA_OBJ/CrDaThread.o $MA_OBJ/CrDaShutdown.o $MA_OBJ/CrMaLoadGen.o \
+$MA_OBJ/CrDaOutCmpTempViolation.o $MA_OBJ/CrDaOutCmpTempBatch.o $MA_OBJ/CrDaOutCmpTempStats.o $MA_OBJ/CrDaOutCmpAck.o $MA_OBJ/CrDaOutCmpAckBatch.o $MA_OBJ/CrDaPcktTemplate.o $MA_OBJ/CrDaTempMonitor.o"
+#gcc -o $EXE_DIR/cr_master \
+gcc $PROFILE_LNK -o $EXE_DIR/cr_master $APP_OBJ -lpthread -lrt $LNKMAP
+
+# In the single-process mode, the application is also combined into one relocatable
+# object (see CompileAndLinkMulti.sh)
+if [ "$MULTI_APP" = "1" ]; then
+	gcc $PROFILE_LNK -r -nostdlib -flinker-output=nolto-rel -o $EXE_DIR/cr_master.o $APP_OBJ
+fi
@@ -0,0 +1,83 @@
+#!/bin/bash
+# This script compiles and links the single-process mode of the CORDET Demo in which
+# the Master, Slave 1 and Slave 2 Applications run as threads of one process (see
+# CrMuMain.c).
+#
+# The script takes the following parameters:
+# 1. The path of the FW Profile source directory
+# 2. The path of the CORDET FW source directory
+# 3. The path of the CORDET FW examples directory
+# 4. The path to the directory where executables are created
+#
+# This script performs the following actions:
+# 1. Compile the FW Profile and the three applications with the shared-memory
+#    transport in directory $EXE_DIR/multi and combine the object files of each
+#    application into one relocatable object
+# 2. Make all symbols of each relocatable object local except for the main program of
+#    the application and for its CrDaCycleStop function, which are renamed after the
+#    application (e.g. CrMaAppMain and CrMaCycleStop): each application then keeps its
+#    own instance of the framework in the process
+# 3. Build the executable which runs the three applications
+#
+# Compilation and linking is done with the options of the build profile selected by
+# the BUILD_PROFILE environment variable (see BuildProfile.sh).
+# The packet, cycle and trace options are taken from the environment as in the other
+# scripts; the socket options are replaced by the shared-memory transport.
+#
+#====================================================================================
+# Assign variables
+#====================================================================================
+
+FW_DIR=$1
+CR_DIR=$2
+EXM_DIR=$3
+EXE_DIR=$4
+
+MU_SRC="$EXM_DIR/CrDemoMulti"
+MU_OBJ="$EXE_DIR/multi"
+SCRIPT_DIR="$(dirname $0)"
+
+mkdir -p ${MU_OBJ}
+
+#====================================================================================
+# Set the compilation options
+#====================================================================================
+. "$SCRIPT_DIR/BuildProfile.sh"
+OPT="$PROFILE_OPT -Wall -c -fmessage-length=0"
+
+#====================================================================================
+# Compile the applications
+#====================================================================================
+echo "===================================================================================="
+echo "- Compile the applications for the single-process mode"
+echo "===================================================================================="
+export SOCKET_OPT="-DCR_DA_SHM_TRANSPORT=1"
+export MULTI_APP=1
+"$SCRIPT_DIR/CompileAndLinkFw.sh" $FW_DIR $MU_OBJ || exit 1
+"$SCRIPT_DIR/CompileAndLinkMa.sh" $FW_DIR $CR_DIR $EXM_DIR $MU_OBJ || exit 1
+"$SCRIPT_DIR/CompileAndLinkS1.sh" $FW_DIR $CR_DIR $EXM_DIR $MU_OBJ || exit 1
+"$SCRIPT_DIR/CompileAndLinkS2.sh" $FW_DIR $CR_DIR $EXM_DIR $MU_OBJ || exit 1
+
+#====================================================================================
+# Make the symbols of the applications local
+#====================================================================================
+# The references to getopt are redirected to CrMuGetopt (see CrMuMain.c)
+function localizeApp {
+objcopy --redefine-sym main=Cr$2AppMain --redefine-sym CrDaCycleStop=Cr$2CycleStop \
+	--redefine-sym getopt=CrMuGetopt $MU_OBJ/$1.o $MU_OBJ/$1_local.o || exit 1
+objcopy --keep-global-symbol=Cr$2AppMain --keep-global-symbol=Cr$2CycleStop $MU_OBJ/$1_local.o || exit 1
+}
+localizeApp "cr_master" "Ma"
+localizeApp "cr_slave1" "S1"
+localizeApp "cr_slave2" "S2"
+
+#====================================================================================
+# Build the executable
+#====================================================================================
+echo "===================================================================================="
+echo "- Build the executable for the single-process mode"
+echo "===================================================================================="
+gcc -I"$MU_SRC" $OPT -o $MU_OBJ/CrMuMain.o $MU_SRC/CrMuMain.c
+gcc $PROFILE_LNK -o $EXE_DIR/cr_multi $MU_OBJ/CrMuMain.o \
+$MU_OBJ/cr_master_local.o $MU_OBJ/cr_slave1_local.o $MU_OBJ/cr_slave2_local.o \
+-lpthread -lrt
@@ -13,7 +13,9 @@
 # 2. Compile the Slave 1 Demo Files for the C2 Implementation
 # 3. Build the executables to run the Test Suite 
 #
-# In all cases, compilation and linking is done with the gcov options.
+# Compilation and linking is done with the options of the build profile selected by
+# the BUILD_PROFILE environment variable (see BuildProfile.sh): by default, they are
+# the gcov options.
 #
 #====================================================================================
 # Assign variables 
@@ -39,7 +41,130 @@ mkdir -p ${S1_OBJ}
 #====================================================================================
 # Use the following definition for linker map
 #OPT="-Os -Wall -c -fmessage-length=0" 
-OPT="-O0 -g3 -Wall -c -fmessage-length=0 -fprofile-arcs -ftest-coverage"  
+# The optimization and instrumentation options are those of the build profile
+. "$(dirname $0)/BuildProfile.sh"
+OPT="$PROFILE_OPT -Wall -c -fmessage-length=0"
+
+#====================================================================================
+# Set the packet options
+#====================================================================================
+# The inline packet header accessors are used by default (see CrFwPcktInline.h).
+# Set PCKT_OPT to an empty string in the environment to use the out-of-line accessors.
+# Add -DCR_FW_WIDE_APP_ID=1 to PCKT_OPT for 16-bit destinations and sources and 1024
+# application identifiers (see CrFwUserConstants.h); all applications must use the same setting.
+# Add -DCR_FW_PCKT_NET_ORDER=1 to PCKT_OPT to store the packets in network byte order so that hosts
+# of different byte orders can exchange them (see CrFwPcktWire.h); all applications must use the same setting.
+PCKT_OPT=${PCKT_OPT-"-DCR_FW_PCKT_INLINE=1"}
+OPT="$OPT $PCKT_OPT"
+
+#====================================================================================
+# Set the socket options
+#====================================================================================
+# The socket adapters use the epoll backend by default (see CrDaConstants.h).
+# Set SOCKET_OPT to an empty string in the environment to poll every connection.
+# Add -DCR_DA_SHM_TRANSPORT=1 to exchange packets through shared memory instead of
+# sockets (all applications must then run on the same host).
+# Replace -DCR_DA_SOCKET_EPOLL=1 with -DCR_DA_SOCKET_URING=1 to use the io_uring backend
+# of the server socket (Linux 6.0 or later).
+# Add -DCR_DA_IO_THREAD=1 -DCR_FW_PCKT_LOCK_FREE=1 to move the socket into a dedicated
+# I/O thread (see CrDaIoThread.h).
+# Add -DCR_DA_IO_THREAD_PIPELINE=1 as well to overlap the I/O of the adjacent cycles
+# with the processing of the current cycle (the pipelined cycle, see CrDaIoThread.h).
+SOCKET_OPT=${SOCKET_OPT-"-DCR_DA_SOCKET_EPOLL=1 -DCR_DA_SOCKET_TX_BATCH=1"}
+OPT="$OPT $SOCKET_OPT"
+
+#====================================================================================
+# Set the cycle options
+#====================================================================================
+# The demo applications execute the incoming packets in their control cycles by default
+# (see CrDaCycle.h).
+# Set CYCLE_OPT to -DCR_DA_CYCLE_EVENT_DRIVEN=1 in the environment to execute them as
+# soon as they arrive and add -DCR_DA_CYCLE_PERIOD_USEC=<period> to change the period.
+# Add -DCR_DA_MGR_POOL=1 -DCR_FW_PCKT_LOCK_FREE=1 to execute the independent managers
+# concurrently (see CrDaMgrPool.h).
+# Add -DCR_DA_IN_LOAD_DRAIN=1 to load all pending packets of the InStreams in every
+# cycle within a budget (see CrDaInLoad.h).
+# Add -DCR_DA_INMANAGER_SPILL=1 to extend the full InManagers with spill InManagers
+# (see CrDaInManagerChain.h).
+# Add -DCR_DA_INCMD_BATCH=1 to execute the bursts of InCommands of one kind in batches
+# (see CrDaInCmdBatch.h).
+# Add -DCR_DA_INSTREAM_DEDUP=1 to drop the duplicate packets before they reach the
+# InStreams (see CrDaLinkStats.h).
+# Add -DCR_DA_INCMD_EXPRESS=1 to execute the express InCommands as soon as they are
+# loaded (see CrDaInCmdExpress.h).
+# Add -DCR_DA_ACK_BATCH=1 to send the outcomes of the InCommands of a cycle in one
+# report to each source (see CrDaOutCmpAckBatch.h).
+# Add -DCR_DA_TEMP_STATS=1 to report windowed per-channel temperature statistics
+# instead of the individual violations (see CrDaOutCmpTempStats.h).
+# Add -DCR_DA_TEMP_STATS_ENCODING=1 to delta-encode the entries of the statistics reports
+# with a periodic key frame (see CrDaOutCmpTempStats.h).
+# Add -DCR_DA_STATIC_CREATION=1 to allocate the procedures of the configuration
+# statically (see CrDaConstants.h).
+# Add -DCR_DA_SM_FAST_PATH=1 to skip the executions of the InLoader and of the managers
+# which have nothing to do (see CrDaSmExec.h).
+# Add -DCR_DA_FOOTPRINT=1 to print the memory used by each framework component
+# (see CrDaFootprint.h).
+# Add -DCR_DA_SNAPSHOT=1 to resume from the state of the previous run after a restart
+# (see CrDaSnapshot.h).
+# Add -DCR_DA_RUNTIME_CONFIG=1 to override the sizes of the packet pool, its quotas and the
+# budgets of the cycle frame from a configuration file at start-up (see CrDaConfig.h).
+# Add -DCR_DA_STARTUP_PARALLEL=1 to set up the streams while the other framework components
+# are configured and to report the duration of each start-up task (see CrDaStartUp.h).
+# Add -DCR_DA_SM_PROF=1 to count and time the executions and transitions of the state machines
+# and procedures and print their profile at the end of the run (see CrDaSmProf.h).
+# Add -DCR_DA_FRAME_SCHED=1 to execute each control cycle as a frame of slots with time budgets
+# and to defer the work which exceeds them to the next frame (see CrDaFrame.h).
+# Add -DCR_DA_THREAD_PLACEMENT=1 to give each thread the CPU affinity and SCHED_FIFO priority of
+# its role and to lock the memory of the process (see CrDaThread.h).
+# Add -DCR_DA_SIM=1 (in all applications, with SOCKET_OPT set to -DCR_DA_SHM_TRANSPORT=1) to
+# run the applications on a virtual clock in deterministic turns without sleeping (see CrDaSim.h).
+# Add -DCR_DA_HEARTBEAT=1 (in all applications) to send heartbeats on the idle links and to declare
+# a silent peer down, which also fails a silent server over to the standby server (see CrDaHeartbeat.h).
+# Add -mavx2 to compare 32 channels at a time in the multi-channel temperature monitoring
+# (the default kernel compares 16 channels at a time with SSE2, see CrDaTempMonitor.h).
+CYCLE_OPT=${CYCLE_OPT-""}
+OPT="$OPT $CYCLE_OPT"
+
+#====================================================================================
+# Set the trace options
+#====================================================================================
+# The error reports are printed to standard output by default.
+# Set TRACE_OPT to -DCR_DA_TRACE=1 in the environment to write them to the ring buffer
+# of the binary trace instead (see CrDaTrace.h).
+# Add -DCR_DA_METRICS=1 to count the packets and errors of the streams and to serve
+# them on a side TCP port for scraping (see CrDaMetrics.h).
+# Add -DCR_DA_CAPTURE=1 to record the packets of the transport in a memory-mapped
+# capture file (see CrDaCapture.h).
+# Add -DCR_DA_EVENT_LOG=1 to append the temperature violations to memory-mapped log
+# files which are synchronized with the disk by a flush thread (see CrDaEventLog.h).
+# Add -DCR_DA_ERR_QUEUE=1 to count the application errors and error reports per code and
+# to log them from a lock-free event queue (see CrDaErrQueue.h).
+# Add -DCR_DA_REPLAY=1 to feed a capture file back into the InStreams instead of
+# using the sockets (see CrDaReplay.h).
+# Add -DCR_DA_OUT_BACKLOG=1 to absorb the packets which the transport does not accept
+# in a growable backlog in front of the OutStream packet queues (see CrDaOutBacklog.h).
+# Add -DCR_DA_OUT_ADMIT_CMD_POLICY=<policy> (or ACK_POLICY or REP_POLICY) to choose whether the
+# commands (acknowledgements, violation reports) which find no OutComponent are rejected, deferred
+# or deferred in place of the oldest deferred one (see CrDaOutAdmit.h).
+# Add -DCR_DA_PCKT_TEMPLATE=1 to copy the headers of the repeated reports from templates
+# instead of serializing every header field (see CrDaPcktTemplate.h).
+# Add -DCR_DA_PCKT_CRC=1 (in all applications) to protect each packet on the socket connections
+# with a CRC-32C trailer; add -msse4.2 to compute it with the CRC32 instruction (see CrDaCrc.h).
+# Add -DCR_DA_HANDSHAKE=1 (in all applications) to let the peers of each socket connection
+# agree on the features of the wire format, e.g. the CRC-32C trailer (see CrDaHandshake.h).
+# Add -DCR_DA_LAT_TRACE=1 (in all applications) to record the hops of each packet in a trailer
+# and to print the latency histograms of its stages (see CrDaLatTrace.h).
+# Add -DCR_DA_SOCKET_RECONNECT=1 to OPT to re-establish the client connections which fail
+# and -DCR_DA_SOCKET_STANDBY_PORT=<port> to fail them over to a standby server (see CrDaClientSocket.h).
+# Add -DCR_DA_SOCKET_N_OF_CONNS=2 to OPT to give each packet group its own socket connection;
+# all applications must use the same setting (see CrDaServerSocket.h).
+# Add -DCR_FW_PCKT_ARENA=1 to map the packet pool at startup, on huge pages if it is at least
+# CR_FW_PCKT_ARENA_HUGE_SIZE bytes large, and -DCR_FW_PCKT_SLOT_ALIGN=<n> to change the
+# 64-byte alignment of the packets (see CrFwPcktArena.h).
+# Add -DCR_DA_SAMPLER=1 to acquire the temperature samples at their own rate in a sampler
+# thread which hands them over to the control cycles through a lock-free ring (see CrDaSampler.h).
+TRACE_OPT=${TRACE_OPT-""}
+OPT="$OPT $TRACE_OPT"
 
 #====================================================================================
 # Set the include path
@@ -78,8 +203,59 @@ echo "==========================================================================
 gcc $INCLUDE $OPT -o $S1_OBJ/CrS1Main.o $S1_SRC/CrS1Main.c
 gcc $INCLUDE $OPT -o $S1_OBJ/CrDaClientSocket.o $S1_SRC/CrDaClientSocket.c
 gcc $INCLUDE $OPT -o $S1_OBJ/CrDaOutCmpTempViolation.o $S1_SRC/CrDaOutCmpTempViolation.c
+gcc $INCLUDE $OPT -o $S1_OBJ/CrDaOutCmpTempBatch.o $S1_SRC/CrDaOutCmpTempBatch.c
+gcc $INCLUDE $OPT -o $S1_OBJ/CrDaOutCmpTempStats.o $S1_SRC/CrDaOutCmpTempStats.c
+gcc $INCLUDE $OPT -o $S1_OBJ/CrDaOutCmpAck.o $S1_SRC/CrDaOutCmpAck.c
+gcc $INCLUDE $OPT -o $S1_OBJ/CrDaOutCmpAckBatch.o $S1_SRC/CrDaOutCmpAckBatch.c
+gcc $INCLUDE $OPT -o $S1_OBJ/CrDaPcktTemplate.o $S1_SRC/CrDaPcktTemplate.c
 gcc $INCLUDE $OPT -o $S1_OBJ/CrDaServerSocket.o $S1_SRC/CrDaServerSocket.c
+gcc $INCLUDE $OPT -o $S1_OBJ/CrDaRxRing.o $S1_SRC/CrDaRxRing.c
+gcc $INCLUDE $OPT -o $S1_OBJ/CrDaTxQueue.o $S1_SRC/CrDaTxQueue.c
+gcc $INCLUDE $OPT -o $S1_OBJ/CrDaCrc.o $S1_SRC/CrDaCrc.c
+gcc $INCLUDE $OPT -o $S1_OBJ/CrDaConfig.o $S1_SRC/CrDaConfig.c
+gcc $INCLUDE $OPT -o $S1_OBJ/CrDaShm.o $S1_SRC/CrDaShm.c
+gcc $INCLUDE $OPT -o $S1_OBJ/CrDaUdpSocket.o $S1_SRC/CrDaUdpSocket.c
+gcc $INCLUDE $OPT -o $S1_OBJ/CrDaSocketProfile.o $S1_SRC/CrDaSocketProfile.c
+gcc $INCLUDE $OPT -o $S1_OBJ/CrDaHandshake.o $S1_SRC/CrDaHandshake.c
+gcc $INCLUDE $OPT -o $S1_OBJ/CrDaUring.o $S1_SRC/CrDaUring.c
+gcc $INCLUDE $OPT -o $S1_OBJ/CrDaCycle.o $S1_SRC/CrDaCycle.c
+gcc $INCLUDE $OPT -o $S1_OBJ/CrDaIoThread.o $S1_SRC/CrDaIoThread.c
+gcc $INCLUDE $OPT -o $S1_OBJ/CrDaPhase.o $S1_SRC/CrDaPhase.c
+gcc $INCLUDE $OPT -o $S1_OBJ/CrDaLinkStats.o $S1_SRC/CrDaLinkStats.c
+gcc $INCLUDE $OPT -o $S1_OBJ/CrDaTrace.o $S1_SRC/CrDaTrace.c
+gcc $INCLUDE $OPT -o $S1_OBJ/CrDaLog.o $S1_SRC/CrDaLog.c
+gcc $INCLUDE $OPT -o $S1_OBJ/CrDaMetrics.o $S1_SRC/CrDaMetrics.c
+gcc $INCLUDE $OPT -o $S1_OBJ/CrDaCapture.o $S1_SRC/CrDaCapture.c
+gcc $INCLUDE $OPT -o $S1_OBJ/CrDaEventLog.o $S1_SRC/CrDaEventLog.c
+gcc $INCLUDE $OPT -o $S1_OBJ/CrDaErrQueue.o $S1_SRC/CrDaErrQueue.c
+gcc $INCLUDE $OPT -o $S1_OBJ/CrDaStatShard.o $S1_SRC/CrDaStatShard.c
+gcc $INCLUDE $OPT -o $S1_OBJ/CrDaSim.o $S1_SRC/CrDaSim.c
+gcc $INCLUDE $OPT -o $S1_OBJ/CrDaHeartbeat.o $S1_SRC/CrDaHeartbeat.c
+gcc $INCLUDE $OPT -o $S1_OBJ/CrDaLatTrace.o $S1_SRC/CrDaLatTrace.c
+gcc $INCLUDE $OPT -o $S1_OBJ/CrDaReplay.o $S1_SRC/CrDaReplay.c
+gcc $INCLUDE $OPT -o $S1_OBJ/CrDaOutBacklog.o $S1_SRC/CrDaOutBacklog.c
+gcc $INCLUDE $OPT -o $S1_OBJ/CrDaOutCmpPool.o $S1_SRC/CrDaOutCmpPool.c
+gcc $INCLUDE $OPT -o $S1_OBJ/CrDaOutAdmit.o $S1_SRC/CrDaOutAdmit.c
+gcc $INCLUDE $OPT -o $S1_OBJ/CrDaOutLoadQueue.o $S1_SRC/CrDaOutLoadQueue.c
+gcc $INCLUDE $OPT -o $S1_OBJ/CrDaInCmpPool.o $S1_SRC/CrDaInCmpPool.c
+gcc $INCLUDE $OPT -o $S1_OBJ/CrDaMgrPool.o $S1_SRC/CrDaMgrPool.c
+gcc $INCLUDE $OPT -o $S1_OBJ/CrDaInLoad.o $S1_SRC/CrDaInLoad.c
+gcc $INCLUDE $OPT -o $S1_OBJ/CrDaInManagerChain.o $S1_SRC/CrDaInManagerChain.c
+gcc $INCLUDE $OPT -o $S1_OBJ/CrDaInCmdBatch.o $S1_SRC/CrDaInCmdBatch.c
+gcc $INCLUDE $OPT -o $S1_OBJ/CrDaInCmdExpress.o $S1_SRC/CrDaInCmdExpress.c
+gcc $INCLUDE $OPT -o $S1_OBJ/CrDaInCmdAsync.o $S1_SRC/CrDaInCmdAsync.c
+gcc $INCLUDE $OPT -o $S1_OBJ/CrDaSmExec.o $S1_SRC/CrDaSmExec.c
+gcc $INCLUDE $OPT -o $S1_OBJ/CrDaSmProf.o $S1_SRC/CrDaSmProf.c
+gcc $INCLUDE $OPT -o $S1_OBJ/CrDaFootprint.o $S1_SRC/CrDaFootprint.c
+gcc $INCLUDE $OPT -o $S1_OBJ/CrDaSnapshot.o $S1_SRC/CrDaSnapshot.c
+gcc $INCLUDE $OPT -o $S1_OBJ/CrDaStartUp.o $S1_SRC/CrDaStartUp.c
+gcc $INCLUDE $OPT -o $S1_OBJ/CrDaStreamMap.o $S1_SRC/CrDaStreamMap.c
+gcc $INCLUDE $OPT -o $S1_OBJ/CrDaFrame.o $S1_SRC/CrDaFrame.c
+gcc $INCLUDE $OPT -o $S1_OBJ/CrDaThread.o $S1_SRC/CrDaThread.c
+gcc $INCLUDE $OPT -o $S1_OBJ/CrDaShutdown.o $S1_SRC/CrDaShutdown.c
 gcc $INCLUDE $OPT -o $S1_OBJ/CrDaTempMonitor.o $S1_SRC/CrDaTempMonitor.c
+gcc $INCLUDE $OPT -o $S1_OBJ/CrDaTempGen.o $S1_SRC/CrDaTempGen.c
+gcc $INCLUDE $OPT -o $S1_OBJ/CrDaSampler.o $S1_SRC/CrDaSampler.c
 
 echo "===================================================================================="
 echo " Compile the C2 Configuration Files for the Slave 1 Application "
@@ -98,12 +274,13 @@ compileConfigFile "CrFwAppShutdownProc"
 echo "===================================================================================="
 echo " Build the executable to run the Slave 1 Application "
 echo "===================================================================================="
-# Use following definition for linker map (and remove -fprofile-arcs option)
-#LNKMAP="-Wl,-Map,$EXE_DIR/cr_Slave 1.map" 
+# The linker map is written by the footprint build profile (see BuildProfile.sh)
 LNKMAP=""
-#gcc -o $EXE_DIR/cr_Slave 1 \
-gcc -fprofile-arcs -o $EXE_DIR/cr_slave1 \
-$FW_OBJ/FwPrConfig.o $FW_OBJ/FwPrCore.o $FW_OBJ/FwPrDCreate.o $FW_OBJ/FwSmAux.o \
+if [ "$PROFILE_MAP" = "1" ]; then
+	LNKMAP="-Wl,-Map,$EXE_DIR/cr_slave1.map"
+fi
+# The object files of the application
+APP_OBJ="$FW_OBJ/FwPrConfig.o $FW_OBJ/FwPrCore.o $FW_OBJ/FwPrDCreate.o $FW_OBJ/FwPrSCreate.o $FW_OBJ/FwSmAux.o \
 $FW_OBJ/FwSmConfig.o $FW_OBJ/FwSmCore.o $FW_OBJ/FwSmDCreate.o $FW_OBJ/FwSmSCreate.o \
 $S1_OBJ/CrFwAux.o $S1_OBJ/CrFwBaseCmp.o $S1_OBJ/CrFwDummyExecProc.o \
 $S1_OBJ/CrFwInitProc.o $S1_OBJ/CrFwResetProc.o $S1_OBJ/CrFwInCmd.o $S1_OBJ/CrFwInRegistry.o \
@@ -113,6 +290,13 @@ $S1_OBJ/CrFwOutLoader.o $S1_OBJ/CrFwOutManager.o $S1_OBJ/CrFwOutRegistry.o $S1_O
 $S1_OBJ/CrFwUtilityFunctions.o $S1_OBJ/CrFwPckt.o $S1_OBJ/CrFwRepErr.o $S1_OBJ/CrFwTime.o \
 $S1_OBJ/CrFwAppSm.o $S1_OBJ/CrFwAppStartUpProc.o $S1_OBJ/CrFwAppResetProc.o $S1_OBJ/CrFwAppShutdownProc.o \
 $S1_OBJ/CrFwRepInCmdOutcome.o \
-$S1_OBJ/CrS1Main.o $S1_OBJ/CrDaClientSocket.o $S1_OBJ/CrDaServerSocket.o \
-$S1_OBJ/CrDaOutCmpTempViolation.o $S1_OBJ/CrDaTempMonitor.o \
--lpthread $LNKMAP
+$S1_OBJ/CrS1Main.o $S1_OBJ/CrDaClientSocket.o $S1_OBJ/CrDaServerSocket.o $S1_OBJ/CrDaRxRing.o $S1_OBJ/CrDaTxQueue.o $S1_OBJ/CrDaCrc.o $S1_OBJ/CrDaConfig.o $S1_OBJ/CrDaShm.o $S1_OBJ/CrDaUdpSocket.o $S1_OBJ/CrDaSocketProfile.o $S1_OBJ/CrDaHandshake.o $S1_OBJ/CrDaUring.o $S1_OBJ/CrDaCycle.o $S1_OBJ/CrDaIoThread.o $S1_OBJ/CrDaPhase.o $S1_OBJ/CrDaLinkStats.o $S1_OBJ/CrDaTrace.o $S1_OBJ/CrDaLog.o $S1_OBJ/CrDaMetrics.o $S1_OBJ/CrDaCapture.o $S1_OBJ/CrDaEventLog.o $S1_OBJ/CrDaErrQueue.o $S1_OBJ/CrDaStatShard.o $S1_OBJ/CrDaSim.o $S1_OBJ/CrDaHeartbeat.o $S1_OBJ/CrDaLatTrace.o $S1_OBJ/CrDaReplay.o $S1_OBJ/CrDaOutBacklog.o $S1_OBJ/CrDaOutCmpPool.o $S1_OBJ/CrDaOutAdmit.o $S1_OBJ/CrDaOutLoadQueue.o $S1_OBJ/CrDaInCmpPool.o $S1_OBJ/CrDaMgrPool.o $S1_OBJ/CrDaInLoad.o $S1_OBJ/CrDaInManagerChain.o $S1_OBJ/CrDaInCmdBatch.o $S1_OBJ/CrDaInCmdExpress.o $S1_OBJ/CrDaInCmdAsync.o $S1_OBJ/CrDaSmExec.o $S1_OBJ/CrDaSmProf.o $S1_OBJ/CrDaFootprint.o $S1_OBJ/CrDaSnapshot.o $S1_OBJ/CrDaStartUp.o $S1_OBJ/CrDaStreamMap.o $S1_OBJ/CrDaFrame.o $S1_OBJ/CrDaThread.o $S1_OBJ/CrDaShutdown.o \
+$S1_OBJ/CrDaOutCmpTempViolation.o $S1_OBJ/CrDaOutCmpTempBatch.o $S1_OBJ/CrDaOutCmpTempStats.o $S1_OBJ/CrDaOutCmpAck.o $S1_OBJ/CrDaOutCmpAckBatch.o $S1_OBJ/CrDaPcktTemplate.o $S1_OBJ/CrDaTempMonitor.o $S1_OBJ/CrDaTempGen.o $S1_OBJ/CrDaSampler.o"
+#gcc -o $EXE_DIR/cr_Slave 1 \
+gcc $PROFILE_LNK -o $EXE_DIR/cr_slave1 $APP_OBJ -lpthread -lrt $LNKMAP
+
+# In the single-process mode, the application is also combined into one relocatable
+# object (see CompileAndLinkMulti.sh)
+if [ "$MULTI_APP" = "1" ]; then
+	gcc $PROFILE_LNK -r -nostdlib -flinker-output=nolto-rel -o $EXE_DIR/cr_slave1.o $APP_OBJ
+fi
@@ -0,0 +1,58 @@
+#!/bin/bash
+# This script reports the memory footprint of the demo applications of the CORDET Framework.
+# The applications should have been built with the footprint build profile (see
+# BuildProfile.sh and the footprint target of the Makefile) so that the sizes are those
+# of code optimized for size without instrumentation.
+#
+# This script takes one parameter:
+# 1. The path to the directory where the executables and object files are located
+#
+# This script performs the following actions:
+# 1. It prints the text, data and bss sizes of each object file of each application
+#    (largest first) and their totals
+# 2. It prints the sizes of the executables
+# .
+# The linker maps (cr_*.map) written by the footprint build profile are in the same
+# directory: they give the size of each symbol.
+#
+#====================================================================================
+# Assign variables
+#====================================================================================
+
+EXE_DIR=$1
+
+#====================================================================================
+# Report the size of the object files
+#====================================================================================
+
+for APP in master S1 S2 bench; do
+	if [ ! -d $EXE_DIR/$APP ]; then
+		continue
+	fi
+	echo "===================================================================================="
+	echo " Object files of $APP (bytes)"
+	echo "===================================================================================="
+	size $EXE_DIR/$APP/*.o | awk 'NR == 1 { print; next } { print | "sort -k4 -n -r" }'
+	size -t $EXE_DIR/$APP/*.o | tail -1
+done
+echo "===================================================================================="
+echo " Object files of the FW Profile (bytes)"
+echo "===================================================================================="
+size -t $EXE_DIR/Fw*.o
+
+#====================================================================================
+# Report the size of the executables
+#====================================================================================
+
+echo "===================================================================================="
+echo " Executables (bytes)"
+echo "===================================================================================="
+EXES=""
+for EXE in cr_master cr_slave1 cr_slave2 cr_bench; do
+	if [ -f $EXE_DIR/$EXE ]; then
+		EXES="$EXES $EXE_DIR/$EXE"
+	fi
+done
+if [ -n "$EXES" ]; then
+	size $EXES
+fi
@@ -6,6 +6,10 @@
 #
 # This script performs the following actions:
 # 1. It spawns three processes each of which runs one of the 3 demo applications
+# 2. It waits until the three processes have terminated
+#
+# The run lasts as long as the control cycles of the applications unless they were built
+# in the simulation mode (see CrDaSim.h) in which case it only lasts as long as their work.
 #
 #====================================================================================
 # Assign variables
@@ -21,15 +25,15 @@ rm -f $EXE_DIR/$OUTFILE2
 rm -f $EXE_DIR/$OUTFILE3
 
 echo " "
-echo "Run Demo Applications -- this takes nearly 2 minutes"
+echo "Run Demo Applications -- this takes about 100 seconds"
 echo "(Demo application outputs is in DemoAppOut_*.txt files)"
 echo " "
-$EXE_DIR/cr_slave1 > $EXE_DIR/$OUTFILE2 &
-sleep 1
+# the applications may be started in any order: the client sockets retry their
+# connection until the server socket of the Slave 1 Application is listening
 $EXE_DIR/cr_master > $EXE_DIR/$OUTFILE1 &
-sleep 1
+$EXE_DIR/cr_slave1 > $EXE_DIR/$OUTFILE2 &
 $EXE_DIR/cr_slave2 > $EXE_DIR/$OUTFILE3 &
 
-# give time to the demo applications to terminate
-sleep 105
+# wait for the demo applications to terminate
+wait
 
@@ -0,0 +1,157 @@
+#!/bin/bash
+# This script runs the saturation harness of the demo applications of the CORDET Framework.
+# It ramps up the command rate of the Master Application until the applications are past
+# their limits and it records, for each step of the ramp, the throughput, the command
+# round-trip latency and the counts of the errors which signal that a configured limit
+# has been reached.
+#
+# This script takes up to six parameters:
+# 1. The path to the directory where the demo application executables are located
+# 2. The command rates of the steps of the ramp in commands per second
+#    (default: "1000 2000 5000 10000 20000 50000 100000 200000")
+# 3. The duration of each step in seconds (default: 2)
+# 4. The time in microseconds for which the Slave Applications stall each of their control
+#    cycles to act as slow consumers (default: 0 for consumers which run at full speed)
+# 5. The label of the run in the results (default: "default"); it is used to compare
+#    the configurations of the applications side by side
+# 6. The file to which the results are appended (default: saturation.csv)
+#
+# This script performs the following actions for each step of the ramp:
+# 1. It spawns the two Slave Applications with free-running control cycles (stalled by
+#    the slow-consumer time)
+# 2. It spawns the Master Application in the load-generation mode with the latency
+#    benchmark at the rate of the step and waits until the step has elapsed
+# 3. It stops the Slave Applications with a termination signal and waits until they
+#    have terminated
+# 4. It appends the results of the step to the results file
+# At the end of the ramp, it prints the knee point of the run, i.e. the first rate at
+# which the commands acknowledged by the transport fall below KNEE_RATIO (default: 0.95)
+# of the offered rate, and the knee point of each configured limit, i.e. the first rate at
+# which one of the applications reports an error which signals that the limit was reached.
+#
+# The errors are counted by the error queue of the applications: they must be built with
+# -DCR_DA_ERR_QUEUE=1 in TRACE_OPT (see CrDaErrQueue.h) or no limit knee is detected.
+# The limits are those of the *UserPar.h files of the configurations of the applications:
+# - CR_FW_MAX_NOF_PCKTS (packet pool exhausted, application error crPcktAllocationFail or
+#   error report crOutStreamNoMorePckt)
+# - CR_FW_OUTFACTORY_MAX_NOF_OUTCMP (OutComponent pool exhausted, crOutCmpAllocationFail)
+# - CR_FW_OUTSTREAM_PQSIZE (OutStream packet queue full, crOutStreamPQFull)
+# - CR_FW_INSTREAM_PQSIZE (InStream packet queue full, crInStreamPQFull)
+# - CR_FW_OUTMANAGER_POCLSIZE (POCL full, crOutManagerPoclFull)
+# - CR_FW_INMANAGER_PCRLSIZE (PCRL full, crInManagerPcrlFull or crInLoaderLdFail)
+# - CR_FW_INFACTORY_MAX_NOF_INCMD (crInCmdAllocationFail)
+# - CR_FW_INFACTORY_MAX_NOF_INREP (crInRepAllocationFail or crInLoaderCreFail)
+#
+#====================================================================================
+# Assign variables
+#====================================================================================
+
+EXE_DIR=$1
+RATES=${2:-"1000 2000 5000 10000 20000 50000 100000 200000"}
+DURATION=${3:-2}
+STALL_USEC=${4:-0}
+LABEL=${5:-default}
+RESULTS=${6:-saturation.csv}
+KNEE_RATIO=${KNEE_RATIO:-0.95}
+OUTFILE1="SaturationOut_Master.txt"
+OUTFILE2="SaturationOut_Slave1.txt"
+OUTFILE3="SaturationOut_Slave2.txt"
+
+# The limits and the error codes which signal them (see CrFwUserConstants.h): "app" for an
+# application error code and "rep" for an error report code
+LIMITS="CR_FW_MAX_NOF_PCKTS:app:5,rep:12
+CR_FW_OUTFACTORY_MAX_NOF_OUTCMP:app:10
+CR_FW_OUTSTREAM_PQSIZE:rep:2
+CR_FW_INSTREAM_PQSIZE:rep:3
+CR_FW_OUTMANAGER_POCLSIZE:rep:6
+CR_FW_INMANAGER_PCRLSIZE:rep:7,rep:14
+CR_FW_INFACTORY_MAX_NOF_INCMD:app:19
+CR_FW_INFACTORY_MAX_NOF_INREP:app:21,rep:13"
+
+#====================================================================================
+# Return the count of the errors with a list of codes in the outputs of a step
+#====================================================================================
+
+errCount() {
+	local total=0 kind code n
+	for entry in $(echo $1 | tr ',' ' '); do
+		kind=${entry%%:*}
+		code=${entry##*:}
+		if [ "$kind" == "app" ]; then kind="application errors"; else kind="error reports"; fi
+		n=$(cat $EXE_DIR/$OUTFILE1 $EXE_DIR/$OUTFILE2 $EXE_DIR/$OUTFILE3 | \
+		    awk -v k="$kind" -v c="$code" '$0 ~ ("Error queue: [0-9]+ " k " with code " c "( |$)") {s += $4} END {print s+0}')
+		total=$((total + n))
+	done
+	echo $total
+}
+
+#====================================================================================
+# Run the ramp
+#====================================================================================
+
+echo " "
+echo "Run Saturation Harness -- rates $RATES commands/s, $DURATION s per step, slow-consumer stall $STALL_USEC us, label $LABEL"
+echo "(Application outputs of the last step are in SaturationOut_*.txt files)"
+echo " "
+
+if [ ! -f $RESULTS ]; then
+	HEADER="label,stall_us,rate,issued_per_s,acked_per_s,alloc_fail,load_fail,lat_p50_us,lat_p99_us,lat_max_us,admit_rejected"
+	while IFS=: read -r LIMIT CODES; do
+		HEADER="$HEADER,$LIMIT"
+	done <<< "$LIMITS"
+	echo $HEADER > $RESULTS
+fi
+
+KNEE=""
+declare -A LIMIT_KNEE
+for RATE in $RATES; do
+	rm -f $EXE_DIR/$OUTFILE1 $EXE_DIR/$OUTFILE2 $EXE_DIR/$OUTFILE3
+	$EXE_DIR/cr_slave1 -f -w $STALL_USEC > $EXE_DIR/$OUTFILE2 &
+	SLAVE1_PID=$!
+	$EXE_DIR/cr_slave2 -f -w $STALL_USEC > $EXE_DIR/$OUTFILE3 &
+	SLAVE2_PID=$!
+	$EXE_DIR/cr_master -l -b -r $RATE -t $DURATION > $EXE_DIR/$OUTFILE1
+
+	# give the slave applications the time to process the last commands and then stop them
+	sleep 1
+	kill -TERM $SLAVE2_PID $SLAVE1_PID
+	wait
+
+	# Throughput, failures and latency of the Master Application
+	ROW=$(awk '
+		function val(key) { return match($0, key " [0-9.]+") ? substr($0, RSTART+length(key)+1, RLENGTH-length(key)-1) : 0 }
+		/Load generation: [0-9]+ commands issued/ { split($0, f, /[^0-9.]+/); issued = f[3]; acked = f[5] }
+		/Load generation: failures:/ { split($0, f, /[^0-9.]+/); alloc = f[2]; load = f[3] }
+		/Latency to .*: p50/ { if (val("p50") > p50) p50 = val("p50"); if (val("p99") > p99) p99 = val("p99"); if (val("max") > max) max = val("max") }
+		/OutLoader admission:/ { rej += (match($0, /[0-9]+ rejected/) ? substr($0, RSTART, RLENGTH-9) : 0) }
+		END { printf "%s,%s,%s,%s,%s,%s,%s,%d", issued+0, acked+0, alloc+0, load+0, p50+0, p99+0, max+0, rej }
+	' $EXE_DIR/$OUTFILE1)
+	ACKED=$(echo $ROW | cut -d, -f2)
+	ROW="$LABEL,$STALL_USEC,$RATE,$ROW"
+	while IFS=: read -r LIMIT CODES; do
+		N=$(errCount $CODES)
+		ROW="$ROW,$N"
+		if [ $N -gt 0 ] && [ -z "${LIMIT_KNEE[$LIMIT]}" ]; then
+			LIMIT_KNEE[$LIMIT]=$RATE
+		fi
+	done <<< "$LIMITS"
+	echo $ROW | tee -a $RESULTS
+
+	if [ -z "$KNEE" ] && awk -v a="$ACKED" -v r="$RATE" -v k="$KNEE_RATIO" 'BEGIN {exit !(a < k*r)}'; then
+		KNEE=$RATE
+	fi
+done
+
+#====================================================================================
+# Report the knee points
+#====================================================================================
+
+echo " "
+if [ -n "$KNEE" ]; then
+	echo "KNEE,$LABEL,throughput,$KNEE"
+else
+	echo "KNEE,$LABEL,throughput,none (the acknowledged rate kept up with the offered rate)"
+fi
+while IFS=: read -r LIMIT CODES; do
+	echo "KNEE,$LABEL,$LIMIT,${LIMIT_KNEE[$LIMIT]:-none}"
+done <<< "$LIMITS"
@@ -0,0 +1,60 @@
+#!/bin/bash
+# This script runs the throughput benchmark of the demo applications of the CORDET Framework.
+#
+# This script takes up to four parameters:
+# 1. The path to the directory where the demo application executables are located
+# 2. The number of commands which the Master Application sends as fast as it can
+#    (default: 100000)
+# 3. The label of the run in the results (default: "default"); it is used to compare
+#    the transport and allocator variants of the applications side by side
+# 4. The file to which the results are appended (default: throughput.csv)
+#
+# This script performs the following actions:
+# 1. It spawns the two Slave Applications with free-running control cycles
+# 2. It spawns the Master Application in the throughput mode of its load generator
+#    and waits until it has sent all its commands
+# 3. It stops the Slave Applications with a termination signal and waits until they
+#    have terminated
+# 4. It appends the link statistics of the three applications to the results file
+#
+#====================================================================================
+# Assign variables
+#====================================================================================
+
+EXE_DIR=$1
+N_OF_PCKTS=${2:-100000}
+LABEL=${3:-default}
+RESULTS=${4:-throughput.csv}
+OUTFILE1="ThroughputOut_Master.txt"
+OUTFILE2="ThroughputOut_Slave1.txt"
+OUTFILE3="ThroughputOut_Slave2.txt"
+
+rm -f $EXE_DIR/$OUTFILE1
+rm -f $EXE_DIR/$OUTFILE2
+rm -f $EXE_DIR/$OUTFILE3
+
+echo " "
+echo "Run Throughput Benchmark -- $N_OF_PCKTS commands, label $LABEL"
+echo "(Application outputs is in ThroughputOut_*.txt files)"
+echo " "
+$EXE_DIR/cr_slave1 -f > $EXE_DIR/$OUTFILE2 &
+SLAVE1_PID=$!
+$EXE_DIR/cr_slave2 -f > $EXE_DIR/$OUTFILE3 &
+SLAVE2_PID=$!
+$EXE_DIR/cr_master -l -c $N_OF_PCKTS > $EXE_DIR/$OUTFILE1
+
+# give the slave applications the time to process the last commands and then stop them
+sleep 1
+kill -TERM $SLAVE2_PID $SLAVE1_PID
+wait
+
+#====================================================================================
+# Collect the results
+#====================================================================================
+
+if [ ! -f $RESULTS ]; then
+	echo "label,app,dir,src,dest,pckts,bytes,duration_s,pckts_per_s,bytes_per_s,cpu_user_s,cpu_sys_s" > $RESULTS
+fi
+for OUTFILE in $OUTFILE1 $OUTFILE2 $OUTFILE3; do
+	grep "^TP," $EXE_DIR/$OUTFILE | sed "s/^TP,/$LABEL,/" | tee -a $RESULTS
+done
@@ -29,6 +29,7 @@
 #include <stdlib.h>
 /* Include FW Profile Files */
 #include "FwPrDCreate.h"
+#include "FwPrSCreate.h"
 #include "FwPrConfig.h"
 #include "FwPrCore.h"
 #include "FwPrConstants.h"
@@ -36,24 +37,38 @@
 #include "CrFwConstants.h"
 #include "AppStartUp/CrFwAppResetProc.h"
 #include "UtilityFunctions/CrFwUtilityFunctions.h"
+/* Include Demo Application Files */
+#include "CrDaConstants.h"
 
 /** The singleton instance of the Application Reset Procedure */
 FwPrDesc_t resetPrDesc;
 
+#if (CR_DA_STATIC_CREATION == 1)
+/** The statically allocated descriptor of the Application Reset Procedure (1 action node, 2 flows, 1 action, 1 guard) */
+FW_PR_INST_NODEC(resetPrDescStatic, 1, 2, 1, 1)
+#endif
+
 /*-----------------------------------------------------------------------------------------*/
 FwPrDesc_t CrFwAppSmGetAppResetProc() {
+#if (CR_DA_STATIC_CREATION == 0)
 	const FwPrCounterS1_t nOfANodes = 1;	/* Number of action nodes */
 	const FwPrCounterS1_t nOfDNodes = 0;	/* Number of decision nodes */
 	const FwPrCounterS1_t nOfFlows = 2;		/* Number of control flows */
 	const FwPrCounterS1_t nOfActions = 1;	/* Number of actions */
 	const FwPrCounterS1_t nOfGuards = 1;	/* Number of guards */
+#endif
 	const FwPrCounterS1_t N1 = 1;			/* Identifier of first action node */
 
 	if (resetPrDesc != NULL)
 		return resetPrDesc;
 
 	/* Create the initialization procedure */
+#if (CR_DA_STATIC_CREATION == 1)
+	resetPrDesc = &resetPrDescStatic;
+	FwPrInit(resetPrDesc);
+#else
 	resetPrDesc = FwPrCreate(nOfANodes, nOfDNodes, nOfFlows, nOfActions, nOfGuards);
+#endif
 
 	/* Configure the initialization procedure */
 	FwPrAddActionNode(resetPrDesc, N1, &CrFwPrEmptyAction);
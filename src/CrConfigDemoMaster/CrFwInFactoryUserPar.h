@@ -21,20 +21,38 @@
 #define CRMA_INFACTORY_USERPAR_H_
 
 #include "CrMaInRepTempViolation.h"
+#include "CrMaInRepCmdAck.h"
+#include "CrDaInCmdBatch.h"
+#include "CrDaInCmdExpress.h"
 #include "UtilityFunctions/CrFwUtilityFunctions.h"
+#include "CrFwInManagerUserPar.h"
+/**
+ * The number of InCommands or InReports which may be allocated and not yet loaded into an
+ * InManager (the InLoader loads each of them as soon as it has made it).
+ */
+#define CR_DA_INFACTORY_NOF_UNLOADED 1
+
 /**
  * The maximum number of components representing an incoming command which may be allocated
  * at any one time.
  * This constant must be a positive integer smaller than the range of
  * <code>::CrFwInFactoryPoolIndex_t</code>.
+ * An InCommand is released when its InManager has executed it: the pool holds enough
+ * InCommands to fill the PCRL of their InManager, the spill InManagers and the express
+ * InManager (see <code>CrDaInCmpPool.h</code>, <code>CrDaInManagerChain.h</code> and
+ * <code>CrDaInCmdExpress.h</code>).
  */
-#define CR_FW_INFACTORY_MAX_NOF_INCMD 5
+#define CR_FW_INFACTORY_MAX_NOF_INCMD (CR_DA_INMANAGER_PCRLSIZE_INCMD + CR_DA_INMANAGER_SPILL_CAPACITY + \
+                                       CR_DA_INMANAGER_EXPRESS_CAPACITY + CR_DA_INFACTORY_NOF_UNLOADED)
 
 /**
  * The maximum number of InReports which may be allocated at any one time.
  * This constant must be smaller than the range of <code>::CrFwInFactoryPoolIndex_t</code>.
+ * An InReport is released when its InManager has executed it: the pool holds enough
+ * InReports to fill the PCRL of their InManager and the spill InManagers (see
+ * <code>CrDaInCmpPool.h</code> and <code>CrDaInManagerChain.h</code>).
  */
-#define CR_FW_INFACTORY_MAX_NOF_INREP 5
+#define CR_FW_INFACTORY_MAX_NOF_INREP (CR_DA_INMANAGER_PCRLSIZE_INREP + CR_DA_INMANAGER_SPILL_CAPACITY + CR_DA_INFACTORY_NOF_UNLOADED)
 
 /**
  * The total number of kinds of incoming commands supported by the application.
@@ -61,7 +79,7 @@
  * initializer <code>#CR_FW_INREP_INIT_KIND_DESC</code> and it must be smaller
  * than the range of the <code>::CrFwCmdRepKindIndex_t</code> type.
  */
-#define CR_FW_INREP_NKINDS 1
+#define CR_FW_INREP_NKINDS 5
 
 /**
  * Definition of the incoming command kinds supported by the application.
@@ -118,6 +136,26 @@
 						&CrFwSmEmptyAction, &CrFwSmEmptyAction, &CrFwSmEmptyAction}, \
 	}
 
+/**
+ * The batch handlers of the InCommand kinds (see <code>CrDaInCmdBatch.h</code>).
+ * Each line in this initializer gives the service type, service sub-type, discriminant
+ * value and batch handler (or NULL) of one kind of <code>#CR_FW_INCMD_INIT_KIND_DESC</code>.
+ * The Master Application does not batch its (dummy) InCommands.
+ */
+#define CR_DA_INCMD_INIT_KIND_BATCH \
+	{ {1, 1, 1, NULL}, \
+	}
+
+/**
+ * The express flags of the InCommand kinds (see <code>CrDaInCmdExpress.h</code>).
+ * Each line in this initializer gives the service type, service sub-type, discriminant
+ * value and express flag of one kind of <code>#CR_FW_INCMD_INIT_KIND_DESC</code>.
+ * The (dummy) InCommands of the Master Application are not express.
+ */
+#define CR_DA_INCMD_INIT_KIND_EXPRESS \
+	{ {1, 1, 1, 0}, \
+	}
+
 /**
  * Definition of the incoming report kinds supported by an application.
  * An application supports a number of service types and, for each service type, it supports
@@ -154,10 +192,15 @@
  * <code>::CrFwAuxInFactoryInRepConfigCheck</code>.
  *
  * The initializer values defined below are those which are used for the Master Application.
- * The function pointers are defined in <code>CrMaInRepTempViolation.h</code>.
+ * The function pointers are defined in <code>CrMaInRepTempViolation.h</code> and
+ * <code>CrMaInRepCmdAck.h</code>.
  */
 #define CR_FW_INREP_INIT_KIND_DESC \
 	{ {64, 4, 0, &CrMaInRepTempViolationUpdateAction, &CrMaInRepTempViolationValidityCheck}, \
+	  {64, 5, 0, &CrMaInRepCmdAckUpdateAction, &CrMaInRepCmdAckValidityCheck}, \
+	  {64, 6, 0, &CrMaInRepTempViolationBatchUpdateAction, &CrMaInRepTempViolationBatchValidityCheck}, \
+	  {64, 7, 0, &CrMaInRepCmdAckBatchUpdateAction, &CrMaInRepCmdAckBatchValidityCheck}, \
+	  {64, 8, 0, &CrMaInRepTempStatsUpdateAction, &CrMaInRepTempStatsValidityCheck}, \
 	}
 
 #endif /* CRFW_INFACTORY_USERPAR_H_ */
@@ -26,6 +26,8 @@
 #define CR_MA_INLOADER_USERPAR_H_
 
 #include "InLoader/CrFwInLoader.h"
+#include "CrDaInManagerChain.h"
+#include "CrDaInCmdExpress.h"
 
 /**
  * The function which determines the re-routing destination of a packet.
@@ -41,7 +43,18 @@
  * This function must conform to the prototype defined by <code>::CrFwInLoaderGetInManager_t</code>.
  * The function specified here is the default re-routing destination function defined in
  * <code>CrFwInLoader.h</code>.
+ * If the spill InManagers are selected (see <code>#CR_DA_INMANAGER_SPILL</code>), the
+ * function provided by <code>CrDaInManagerChain.h</code> is used instead.
+ * If the express lane is selected (see <code>#CR_DA_INCMD_EXPRESS</code>), the function
+ * provided by <code>CrDaInCmdExpress.h</code> is used (it uses the InManager chains for
+ * the components which are not express).
  */
+#if (CR_DA_INCMD_EXPRESS == 1)
+#define CR_FW_INLOADER_SEL_INMANAGER CrDaInCmdExpressSelect;
+#elif (CR_DA_INMANAGER_SPILL == 1)
+#define CR_FW_INLOADER_SEL_INMANAGER CrDaInManagerChainSelect;
+#else
 #define CR_FW_INLOADER_SEL_INMANAGER CrFwInLoaderDefGetInManager;
+#endif
 
 #endif /* CR_MA_INLOADER_USERPAR_H_ */
@@ -34,14 +34,21 @@
 #include "BaseCmp/CrFwResetProc.h"
 /* Include Demo Application files */
 #include "CrDaClientSocket.h"
+#include "CrDaShm.h"
+#include "CrDaReplay.h"
+#include "CrDaIoThread.h"
 #include "CrDaConstants.h"
+#include "CrMaConstants.h"
 
 /**
  * The number of InStream components in the application.
  * The value of this constant must be smaller than the range of the <code>::CrFwCounterU1_t</code>
  * integer type.
+ *
+ * The Master Application has one InStream for each of its peers and the stream tables in
+ * this file are generated from the list of its peers (see <code>#CR_MA_PEERS</code>).
  */
-#define CR_FW_NOF_INSTREAM 2
+#define CR_FW_NOF_INSTREAM (0 CR_MA_PEERS(CR_DA_PEER_COUNT, 0))
 
 /**
  * The sizes of the packet queues in the InStream components.
@@ -52,7 +59,34 @@
  * The size of a packet queue must be a positive integer (i.e. it is not legal
  * to define a zero-size packet queue).
  */
-#define CR_FW_INSTREAM_PQSIZE {10,10}
+#define CR_FW_INSTREAM_PQSIZE {CR_MA_PEERS(CR_DA_PEER_ARG, 10)}
+
+/**
+ * The reserved quotas of the InStreams in the packet pool.
+ * This constant defines the number of packets of the packet pool which are reserved for
+ * the i-th InStream (see <code>CrFwPcktPart.h</code>).
+ * The packets of an InStream which exceed its quota are taken from the shared overflow
+ * region of the packet pool.
+ * The sum of the quotas of the InStreams and OutStreams must not exceed
+ * <code>#CR_FW_MAX_NOF_PCKTS</code>.
+ */
+#define CR_FW_INSTREAM_PCKT_QUOTA {CR_MA_PEERS(CR_DA_PEER_ARG, 2)}
+
+/**
+ * The weights of the InStreams in the InLoader drain (see <code>CrDaInLoad.h</code>).
+ * This constant defines the maximum number of packets which are loaded from the i-th
+ * InStream in one round-robin pass of the drain.
+ * The weights must be positive integers.
+ * All peers of the Master Application have the same weight.
+ */
+#define CR_DA_INSTREAM_LOAD_WEIGHT {CR_MA_PEERS(CR_DA_PEER_ARG, 1)}
+
+/**
+ * The quotas of the InStreams in the InLoader drain (see <code>CrDaInLoad.h</code>).
+ * This constant defines the maximum number of packets which are loaded from the i-th
+ * InStream in one drain.
+ */
+#define CR_DA_INSTREAM_LOAD_QUOTA {CR_MA_PEERS(CR_DA_PEER_ARG, 4)}
 
 /**
  * The packet sources which are managed by the InStream components.
@@ -60,16 +94,18 @@
  * This constant is the initializer for the array which defines the packet source
  * associated to the i-th InStream.
  */
-#define CR_FW_INSTREAM_SRC {CR_DA_SLAVE_1,CR_DA_SLAVE_2}
+#define CR_FW_INSTREAM_SRC {CR_MA_PEERS(CR_DA_PEER_ID, 0)}
 
 /**
  * The number of groups of the InStream components.
  * The number of groups must be a positive integer.
  * This array defines the number of groups of the i-th InStream.
  *
+ * Each stream has one group for the time-critical packets and one for the routine packets
+ * (see <code>#CR_DA_PCKT_N_OF_GROUPS</code>).
  * The number of groups defined in this file are those used for the Master Application.
  */
-#define CR_FW_INSTREAM_NOF_GROUPS {1,1}
+#define CR_FW_INSTREAM_NOF_GROUPS {CR_MA_PEERS(CR_DA_PEER_ARG, CR_DA_PCKT_N_OF_GROUPS)}
 
 /**
  * The functions implementing  the Packet Collect Operations of the InStream components.
@@ -82,8 +118,22 @@
  *
  * The packet collection operation defined in this file is the one provided
  * by the socket-based interface of <code>CrDaClientSocket.h</code>.
+ * If the shared-memory transport is selected (see <code>#CR_DA_SHM_TRANSPORT</code>),
+ * the function provided by <code>CrDaShm.h</code> is used instead.
+ * If the replay transport is selected (see <code>#CR_DA_REPLAY</code>), the function
+ * provided by <code>CrDaReplay.h</code> is used instead.
+ * If the I/O thread is selected (see <code>#CR_DA_IO_THREAD</code>), the function
+ * provided by <code>CrDaIoThread.h</code> is used instead.
  */
-#define CR_FW_INSTREAM_PCKTCOLLECT {&CrDaClientSocketPcktCollect, &CrDaClientSocketPcktCollect}
+#if (CR_DA_SHM_TRANSPORT == 1)
+#define CR_FW_INSTREAM_PCKTCOLLECT {CR_MA_PEERS(CR_DA_PEER_ARG, &CrDaShmPcktCollect)}
+#elif (CR_DA_IO_THREAD == 1)
+#define CR_FW_INSTREAM_PCKTCOLLECT {CR_MA_PEERS(CR_DA_PEER_ARG, &CrDaIoThreadPcktCollect)}
+#elif (CR_DA_REPLAY == 1)
+#define CR_FW_INSTREAM_PCKTCOLLECT {CR_MA_PEERS(CR_DA_PEER_ARG, &CrDaReplayPcktCollect)}
+#else
+#define CR_FW_INSTREAM_PCKTCOLLECT {CR_MA_PEERS(CR_DA_PEER_ARG, &CrDaClientSocketPcktCollect)}
+#endif
 
 /**
  * The functions implementing the Packet Available Check Operations of the InStream
@@ -99,9 +149,22 @@
  *
  * The packet collection operation defined in this file is the one provided
  * by the socket-based interface of <code>CrDaClientSocket.h</code>.
+ * If the shared-memory transport is selected (see <code>#CR_DA_SHM_TRANSPORT</code>),
+ * the function provided by <code>CrDaShm.h</code> is used instead.
+ * If the replay transport is selected (see <code>#CR_DA_REPLAY</code>), the function
+ * provided by <code>CrDaReplay.h</code> is used instead.
+ * If the I/O thread is selected (see <code>#CR_DA_IO_THREAD</code>), the function
+ * provided by <code>CrDaIoThread.h</code> is used instead.
  */
-#define CR_FW_INSTREAM_PCKTAVAILCHECK {&CrDaClientSocketIsPcktAvail,  \
-									   &CrDaClientSocketIsPcktAvail}
+#if (CR_DA_SHM_TRANSPORT == 1)
+#define CR_FW_INSTREAM_PCKTAVAILCHECK {CR_MA_PEERS(CR_DA_PEER_ARG, &CrDaShmIsPcktAvail)}
+#elif (CR_DA_IO_THREAD == 1)
+#define CR_FW_INSTREAM_PCKTAVAILCHECK {CR_MA_PEERS(CR_DA_PEER_ARG, &CrDaIoThreadIsPcktAvail)}
+#elif (CR_DA_REPLAY == 1)
+#define CR_FW_INSTREAM_PCKTAVAILCHECK {CR_MA_PEERS(CR_DA_PEER_ARG, &CrDaReplayIsPcktAvail)}
+#else
+#define CR_FW_INSTREAM_PCKTAVAILCHECK {CR_MA_PEERS(CR_DA_PEER_ARG, &CrDaClientSocketIsPcktAvail)}
+#endif
 
 /**
  * The functions implementing the Initialization Check of the InStream components.
@@ -119,9 +182,18 @@
  *
  * The initialization check operation defined in this file is the one provided
  * by the socket-based interface of <code>CrDaClientSocket.h</code>.
+ * If the shared-memory transport is selected (see <code>#CR_DA_SHM_TRANSPORT</code>),
+ * the function provided by <code>CrDaShm.h</code> is used instead.
+ * If the replay transport is selected (see <code>#CR_DA_REPLAY</code>), the default
+ * initialization check is used instead.
  */
-#define CR_FW_INSTREAM_INITCHECK {&CrDaClientSocketInitCheck, \
-	                              &CrDaClientSocketInitCheck}
+#if (CR_DA_SHM_TRANSPORT == 1)
+#define CR_FW_INSTREAM_INITCHECK {CR_MA_PEERS(CR_DA_PEER_ARG, &CrDaShmInitCheck)}
+#elif (CR_DA_REPLAY == 1)
+#define CR_FW_INSTREAM_INITCHECK {CR_MA_PEERS(CR_DA_PEER_ARG, &CrFwBaseCmpDefInitCheck)}
+#else
+#define CR_FW_INSTREAM_INITCHECK {CR_MA_PEERS(CR_DA_PEER_ARG, &CrDaClientSocketInitCheck)}
+#endif
 
 /**
  * The functions implementing the Initialization Action of the InStream components.
@@ -142,9 +214,18 @@
  *
  * The initialization check operation defined in this file is the one provided
  * by the socket-based interface of <code>CrDaClientSocket.h</code>.
+ * If the shared-memory transport is selected (see <code>#CR_DA_SHM_TRANSPORT</code>),
+ * the function provided by <code>CrDaShm.h</code> is used instead.
+ * If the replay transport is selected (see <code>#CR_DA_REPLAY</code>), the function
+ * provided by <code>CrDaReplay.h</code> is used instead.
  */
-#define CR_FW_INSTREAM_INITACTION {&CrDaClientSocketInitAction, \
-	                               &CrDaClientSocketInitAction}
+#if (CR_DA_SHM_TRANSPORT == 1)
+#define CR_FW_INSTREAM_INITACTION {CR_MA_PEERS(CR_DA_PEER_ARG, &CrDaShmInitAction)}
+#elif (CR_DA_REPLAY == 1)
+#define CR_FW_INSTREAM_INITACTION {CR_MA_PEERS(CR_DA_PEER_ARG, &CrDaReplayInitAction)}
+#else
+#define CR_FW_INSTREAM_INITACTION {CR_MA_PEERS(CR_DA_PEER_ARG, &CrDaClientSocketInitAction)}
+#endif
 
 /**
  * The functions implementing the Configuration Check of the InStream components.
@@ -160,8 +241,7 @@
  * Function <code>::CrFwBaseCmpDefConfigCheck</code> can be used as a default
  * implementation for this function.
  */
-#define CR_FW_INSTREAM_CONFIGCHECK {&CrFwBaseCmpDefConfigCheck, \
-	                                &CrFwBaseCmpDefConfigCheck}
+#define CR_FW_INSTREAM_CONFIGCHECK {CR_MA_PEERS(CR_DA_PEER_ARG, &CrFwBaseCmpDefConfigCheck)}
 
 /**
  * The functions implementing the Configuration Action of the InStream components.
@@ -182,9 +262,18 @@
  *
  * The configuration action operation defined in this file is the one provided
  * by the socket-based interface of <code>CrDaClientSocket.h</code>.
+ * If the shared-memory transport is selected (see <code>#CR_DA_SHM_TRANSPORT</code>),
+ * the function provided by <code>CrDaShm.h</code> is used instead.
+ * If the replay transport is selected (see <code>#CR_DA_REPLAY</code>), the function
+ * provided by <code>CrDaReplay.h</code> is used instead.
  */
-#define CR_FW_INSTREAM_CONFIGACTION {&CrDaClientSocketConfigAction, \
-	                                 &CrDaClientSocketConfigAction}
+#if (CR_DA_SHM_TRANSPORT == 1)
+#define CR_FW_INSTREAM_CONFIGACTION {CR_MA_PEERS(CR_DA_PEER_ARG, &CrDaShmConfigAction)}
+#elif (CR_DA_REPLAY == 1)
+#define CR_FW_INSTREAM_CONFIGACTION {CR_MA_PEERS(CR_DA_PEER_ARG, &CrDaReplayConfigAction)}
+#else
+#define CR_FW_INSTREAM_CONFIGACTION {CR_MA_PEERS(CR_DA_PEER_ARG, &CrDaClientSocketConfigAction)}
+#endif
 
 /**
  * The functions implementing the Shutdown Action of the InStream components.
@@ -202,8 +291,17 @@
  *
  * The shutdown action operation defined in this file is the one provided
  * by the socket-based interface of <code>CrDaClientSocket.h</code>.
+ * If the shared-memory transport is selected (see <code>#CR_DA_SHM_TRANSPORT</code>),
+ * the function provided by <code>CrDaShm.h</code> is used instead.
+ * If the replay transport is selected (see <code>#CR_DA_REPLAY</code>), the function
+ * provided by <code>CrDaReplay.h</code> is used instead.
  */
-#define CR_FW_INSTREAM_SHUTDOWNACTION {&CrDaClientSocketShutdownAction, \
-									   &CrDaClientSocketShutdownAction}
+#if (CR_DA_SHM_TRANSPORT == 1)
+#define CR_FW_INSTREAM_SHUTDOWNACTION {CR_MA_PEERS(CR_DA_PEER_ARG, &CrDaShmShutdownAction)}
+#elif (CR_DA_REPLAY == 1)
+#define CR_FW_INSTREAM_SHUTDOWNACTION {CR_MA_PEERS(CR_DA_PEER_ARG, &CrDaReplayShutdownAction)}
+#else
+#define CR_FW_INSTREAM_SHUTDOWNACTION {CR_MA_PEERS(CR_DA_PEER_ARG, &CrDaClientSocketShutdownAction)}
+#endif
 
 #endif /* CR_FW_INSTREAM_USERPAR_H_ */
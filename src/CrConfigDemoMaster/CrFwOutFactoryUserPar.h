@@ -19,15 +19,25 @@
 
 #include "CrMaOutCmpEnableDisable.h"
 #include "CrMaOutCmpSetTempLimit.h"
+#include "CrMaOutLane.h"
+#include "CrFwOutManagerUserPar.h"
 
 #ifndef CRFW_OUTFACTORY_USERPAR_H_
 #define CRFW_OUTFACTORY_USERPAR_H_
 
+/**
+ * The number of OutComponents which may be allocated and not yet loaded into an OutManager
+ * (they are loaded as soon as they have been configured).
+ */
+#define CR_DA_OUTFACTORY_NOF_UNLOADED 2
+
 /**
  * The maximum number of OutComponents which may be allocated at any one time.
  * This constant must be smaller than the range of <code>::CrFwOutFactoryPoolIndex_t</code>.
+ * An OutComponent is released when its OutManager has sent it: the pool holds enough
+ * OutComponents to fill the POCLs of all OutManagers (see <code>CrDaOutCmpPool.h</code>).
  */
-#define CR_FW_OUTFACTORY_MAX_NOF_OUTCMP 10
+#define CR_FW_OUTFACTORY_MAX_NOF_OUTCMP (CR_DA_OUTMANAGER_POCLSIZE_TOTAL + CR_DA_OUTFACTORY_NOF_UNLOADED)
 
 /**
  * The total number of kinds of OutComponents supported by the application.
@@ -37,7 +47,7 @@
  * initializer <code>#CR_FW_OUTCMP_INIT_KIND_DESC</code> and it must be smaller
  * than the range of the <code>::CrFwCmdRepKindIndex_t</code> type.
  */
-#define CR_FW_OUTCMP_NKINDS 3
+#define CR_FW_OUTCMP_NKINDS 6
 
 /**
  * Definition of the OutComponent kinds supported by an application.
@@ -91,14 +101,51 @@
  * The initializer values defined below are which are used for the Master Application.
  * The function pointers for the serialize operations are defined in
  * <code>CrMaOutCmpEnableDisable.h</code> and in <code>CrMaOutCmpSetTempLimit.h</code>.
+ * The parameters of the Bulk Set Temperature Limit command are written when it is made
+ * and its length is <code>#CR_DA_TEMP_BULK_PCKT_LENGTH</code>.
+ * The parameters of the Bulk Enable and Bulk Disable Temperature Monitoring commands are
+ * likewise written when they are made and their length is
+ * <code>#CR_DA_TEMP_MASK_PCKT_LENGTH</code>.
+ * The Ready Check Operation enforces the budgets of the OutManager lanes (see
+ * <code>CrMaOutLane.h</code>).
  */
 #define CR_FW_OUTCMP_INIT_KIND_DESC \
-	{ {64, 1, 0, 1, 100, &CrFwOutCmpDefEnableCheck, &CrFwSmCheckAlwaysTrue, \
+	{ {64, 1, 0, 1, 100, &CrFwOutCmpDefEnableCheck, &CrMaOutLaneReadyCheck, \
 							&CrFwSmCheckAlwaysFalse, &CrFwSmEmptyAction, &CrMaOutCmpEnableDisableSerialize}, \
-	  {64, 2, 0, 1, 100, &CrFwOutCmpDefEnableCheck, &CrFwSmCheckAlwaysTrue, \
+	  {64, 2, 0, 1, 100, &CrFwOutCmpDefEnableCheck, &CrMaOutLaneReadyCheck, \
 							&CrFwSmCheckAlwaysFalse, &CrFwSmEmptyAction, &CrMaOutCmpEnableDisableSerialize}, \
-	  {64, 3, 0, 1, 100, &CrFwOutCmpDefEnableCheck, &CrFwSmCheckAlwaysTrue, \
+	  {64, 3, 0, 1, 100, &CrFwOutCmpDefEnableCheck, &CrMaOutLaneReadyCheck, \
 							&CrFwSmCheckAlwaysFalse, &CrFwSmEmptyAction, &CrMaOutCmpSetTempLimitSerialize}, \
+	  {64, 9, 0, 1, CR_DA_TEMP_BULK_PCKT_LENGTH, &CrFwOutCmpDefEnableCheck, &CrMaOutLaneReadyCheck, \
+							&CrFwSmCheckAlwaysFalse, &CrFwSmEmptyAction, &CrMaOutCmpSetTempLimitBulkSerialize}, \
+	  {64, 10, 0, 1, CR_DA_TEMP_MASK_PCKT_LENGTH, &CrFwOutCmpDefEnableCheck, &CrMaOutLaneReadyCheck, \
+							&CrFwSmCheckAlwaysFalse, &CrFwSmEmptyAction, &CrMaOutCmpEnableDisableMaskSerialize}, \
+	  {64, 11, 0, 1, CR_DA_TEMP_MASK_PCKT_LENGTH, &CrFwOutCmpDefEnableCheck, &CrMaOutLaneReadyCheck, \
+							&CrFwSmCheckAlwaysFalse, &CrFwSmEmptyAction, &CrMaOutCmpEnableDisableMaskSerialize}, \
+	}
+
+/**
+ * The OutManager lanes of the OutComponent kinds (see <code>CrMaOutLane.h</code>).
+ * Each line in this initializer gives the lane of the OutComponents of one kind of
+ * <code>#CR_FW_OUTCMP_INIT_KIND_DESC</code>.
+ * The elements in each line are as follows:
+ * - The service type.
+ * - The service sub-type.
+ * - The discriminant value.
+ * - The lane (<code>#CR_MA_OUT_LANE_URGENT</code> or <code>#CR_MA_OUT_LANE_BULK</code>).
+ * .
+ * The commands which enable and disable the temperature monitoring are urgent: they must
+ * not wait behind the commands which set the temperature limits.
+ * The number of lines must be the same as <code>::CR_FW_OUTCMP_NKINDS</code> and the lines
+ * must be sorted in the same order (this is checked by <code>::CrMaOutLaneConfigCheck</code>).
+ */
+#define CR_MA_OUTCMP_INIT_KIND_LANE \
+	{ {64, 1, 0, CR_MA_OUT_LANE_URGENT}, \
+	  {64, 2, 0, CR_MA_OUT_LANE_URGENT}, \
+	  {64, 3, 0, CR_MA_OUT_LANE_BULK}, \
+	  {64, 9, 0, CR_MA_OUT_LANE_BULK}, \
+	  {64, 10, 0, CR_MA_OUT_LANE_URGENT}, \
+	  {64, 11, 0, CR_MA_OUT_LANE_URGENT}, \
 	}
 
 #endif /* CRFW_OUTFACTORY_USERPAR_H_ */
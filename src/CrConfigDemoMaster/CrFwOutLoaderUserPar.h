@@ -19,6 +19,8 @@
 #ifndef CRFW_OUTLOADER_USERPAR_H_
 #define CRFW_OUTLOADER_USERPAR_H_
 
+#include "CrMaOutLane.h"
+
 /**
  * The function implementing the OutManager Selection Operation for the OutLoader.
  * The value of this constant must be a function pointer of type:
@@ -26,10 +28,10 @@
  * As default value for this adaptation point, the OutLoader defines function
  * <code>::CrFwOutLoaderDefOutManagerSelect</code>.
  *
- * The OutManager Selection Operation defined in this file is the one used for the test cases
- * of <code>CrFwOutLoaderTestCases.h</code>.
+ * The OutManager Selection Operation defined in this file loads each OutComponent into
+ * the OutManager of its lane (see <code>CrMaOutLane.h</code>).
  */
-#define CR_FW_OUTLOADER_OUTMANAGER_SELECT &CrFwOutLoaderDefOutManagerSelect
+#define CR_FW_OUTLOADER_OUTMANAGER_SELECT &CrMaOutLaneSelect
 
 /**
  * The function implementing the OutManager Activation Operation for the OutLoader.
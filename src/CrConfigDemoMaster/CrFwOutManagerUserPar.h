@@ -9,8 +9,9 @@
  * The parameters defined in this file determine the configuration of the OutManager Components.
  * The value of these parameters cannot be changed dynamically.
  *
- * The Master Application only uses one single OutManager which is responsible for sending out
- * the commands to the Slave Applications.
+ * The Master Application uses two OutManagers which are responsible for sending out the
+ * commands to the Slave Applications: one for the urgent commands and one for the bulk
+ * commands (see <code>CrMaOutLane.h</code>).
  *
  * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
  * @author Alessandro Pasetti <pasetti@pnp-software.com>
@@ -36,8 +37,38 @@
  * The number of OutManager components in the application.
  * The value of this constant must be smaller than the range of the <code>::CrFwCounterU1_t</code>
  * integer type.
+ *
+ * The Master Application has one OutManager per lane (see <code>CrMaOutLane.h</code>):
+ * OutManager 0 holds the urgent commands and OutManager 1 holds the bulk commands.
  */
-#define CR_FW_NOF_OUTMANAGER 1
+#define CR_FW_NOF_OUTMANAGER 2
+
+/**
+ * The OutManager components of the application.
+ * Each entry <code>X(pocl, independent)</code> of this list describes one OutManager:
+ * - The size of its POCL (see <code>#CR_FW_OUTMANAGER_POCLSIZE</code>).
+ * - Its independence flag (see <code>#CR_FW_OUTMANAGER_INDEPENDENT</code>).
+ * .
+ * The initializers of the OutManagers and the size of the OutComponent pool of the
+ * OutFactory (see <code>#CR_FW_OUTFACTORY_MAX_NOF_OUTCMP</code>) are derived from this
+ * list so that they cannot get out of step.
+ * The number of entries must be the same as <code>#CR_FW_NOF_OUTMANAGER</code>.
+ */
+#define CR_DA_OUTMANAGER_LIST(X) \
+	X(10, 0)	/* The urgent lane */ \
+	X(10, 0)	/* The bulk lane */
+
+/** Return the POCL size of an entry of <code>#CR_DA_OUTMANAGER_LIST</code>. */
+#define CR_DA_OUTMANAGER_POCLSIZE_OF(pocl, independent) pocl,
+
+/** Return the independence flag of an entry of <code>#CR_DA_OUTMANAGER_LIST</code>. */
+#define CR_DA_OUTMANAGER_INDEPENDENT_OF(pocl, independent) independent,
+
+/** Add the POCL size of an entry of <code>#CR_DA_OUTMANAGER_LIST</code> to a sum. */
+#define CR_DA_OUTMANAGER_POCLSIZE_ADD(pocl, independent) pocl +
+
+/** The total size of the POCLs of the OutManager components. */
+#define CR_DA_OUTMANAGER_POCLSIZE_TOTAL (CR_DA_OUTMANAGER_LIST(CR_DA_OUTMANAGER_POCLSIZE_ADD) 0)
 
 /**
  * The sizes of the Pending OutComponent List (POCL) of the OutManager components.
@@ -46,6 +77,16 @@
  * The size of a POCL must be a positive integer (i.e. it is not legal
  * to define a zero-size POCL) in the range of the <code>#CrFwCounterU2_t</code> type.
  */
-#define CR_FW_OUTMANAGER_POCLSIZE {10}
+#define CR_FW_OUTMANAGER_POCLSIZE { CR_DA_OUTMANAGER_LIST(CR_DA_OUTMANAGER_POCLSIZE_OF) }
+
+/**
+ * The independence flags of the OutManager components.
+ * This constant defines the independence flag of the i-th OutManager.
+ * If the manager pool is selected (see <code>#CR_DA_MGR_POOL</code>), the OutManagers whose
+ * flag is set to 1 are executed concurrently with the other managers by their own worker
+ * thread (see <code>CrDaMgrPool.h</code> for the conditions under which a manager may be
+ * marked as independent).
+ */
+#define CR_FW_OUTMANAGER_INDEPENDENT { CR_DA_OUTMANAGER_LIST(CR_DA_OUTMANAGER_INDEPENDENT_OF) }
 
 #endif /* CR_FW_OUTMANAGER_USERPAR_H_ */
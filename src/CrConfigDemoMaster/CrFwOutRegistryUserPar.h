@@ -40,7 +40,7 @@
  * by the application.
  * This constant must be smaller than the range of: <code>CrFwCmdRepIndex_t</code>.
  */
-#define CR_FW_OUTREGISTRY_NSERV 3
+#define CR_FW_OUTREGISTRY_NSERV 6
 
 /**
  * Definition of the range of out-going services supported by the application.
@@ -70,6 +70,9 @@
 	{ {64, 1, 0}, \
 	  {64, 2, 0}, \
 	  {64, 3, 0}, \
+	  {64, 9, 0}, \
+	  {64, 10, 0}, \
+	  {64, 11, 0}, \
 	}
 
 #endif /* CRFW_OUTREGISTRY_USERPAR_H_ */
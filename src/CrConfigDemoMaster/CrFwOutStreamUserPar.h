@@ -33,7 +33,12 @@
 #include "BaseCmp/CrFwResetProc.h"
 /* Include Demo Application files */
 #include "CrDaClientSocket.h"
+#include "CrDaShm.h"
+#include "CrDaReplay.h"
+#include "CrDaIoThread.h"
+#include "CrDaOutBacklog.h"
 #include "CrDaConstants.h"
+#include "CrMaConstants.h"
 
 /**
  * The number of OutStream components in the application.
@@ -41,8 +46,11 @@
  * destination to which a report or a command may be sent.
  * The value of this constant must be smaller than the range of the <code>::CrFwCounterU1_t</code>
  * integer type.
+ *
+ * The Master Application has one OutStream for each of its peers and the stream tables in
+ * this file are generated from the list of its peers (see <code>#CR_MA_PEERS</code>).
  */
-#define CR_FW_NOF_OUTSTREAM 2
+#define CR_FW_NOF_OUTSTREAM (0 CR_MA_PEERS(CR_DA_PEER_COUNT, 0))
 
 /**
  * The sizes of the packet queues in the OutStream component.
@@ -56,7 +64,18 @@
  * The packet sizes defined in this file are those used for the Master Application
  * of the CORDET Demo.
  */
-#define CR_FW_OUTSTREAM_PQSIZE {10,10}
+#define CR_FW_OUTSTREAM_PQSIZE {CR_MA_PEERS(CR_DA_PEER_ARG, 10)}
+
+/**
+ * The reserved quotas of the OutStreams in the packet pool.
+ * This constant defines the number of packets of the packet pool which are reserved for
+ * the i-th OutStream (see <code>CrFwPcktPart.h</code>).
+ * The packets of an OutStream which exceed its quota are taken from the shared overflow
+ * region of the packet pool.
+ * The sum of the quotas of the InStreams and OutStreams must not exceed
+ * <code>#CR_FW_MAX_NOF_PCKTS</code>.
+ */
+#define CR_FW_OUTSTREAM_PCKT_QUOTA {CR_MA_PEERS(CR_DA_PEER_ARG, 2)}
 
 /**
  * The destinations of the OutStream components.
@@ -69,17 +88,19 @@
  * The destinations defined in this file are those used for the Master Application
  * of the CORDET Demo.
  */
-#define CR_FW_OUTSTREAM_DEST {CR_DA_SLAVE_1,CR_DA_SLAVE_2}
+#define CR_FW_OUTSTREAM_DEST {CR_MA_PEERS(CR_DA_PEER_ID, 0)}
 
 /**
  * The number of groups of the OutStream components.
  * The number of groups must be a positive integer.
  * This array defines the number of groups of the i-th OutStream.
  *
+ * Each stream has one group for the time-critical packets and one for the routine packets
+ * (see <code>#CR_DA_PCKT_N_OF_GROUPS</code>).
  * The number of groups defined in this file are those used for the Master Application
  * of the CORDET Demo.
  */
-#define CR_FW_OUTSTREAM_NOF_GROUPS {1,1}
+#define CR_FW_OUTSTREAM_NOF_GROUPS {CR_MA_PEERS(CR_DA_PEER_ARG, CR_DA_PCKT_N_OF_GROUPS)}
 
 /**
  * The functions implementing the packet hand-over operations of the OutStream components.
@@ -93,8 +114,27 @@
  *
  * The packet handover functions defined in this file is the one provided
  * by the socket-based interface of <code>CrDaClientSocket.h</code>.
+ * If the shared-memory transport is selected (see <code>#CR_DA_SHM_TRANSPORT</code>),
+ * the function provided by <code>CrDaShm.h</code> is used instead.
+ * If the replay transport is selected (see <code>#CR_DA_REPLAY</code>), the function
+ * provided by <code>CrDaReplay.h</code> is used instead.
+ * If the I/O thread is selected (see <code>#CR_DA_IO_THREAD</code>), the function
+ * provided by <code>CrDaIoThread.h</code> is used instead.
+ * If the OutStream backlog is selected (see <code>#CR_DA_OUT_BACKLOG</code>), the function
+ * provided by <code>CrDaOutBacklog.h</code> is used and it hands the packets over to the
+ * function of the selected transport.
  */
-#define CR_FW_OUTSTREAM_PCKTHANDOVER {&CrDaClientSocketPcktHandover,&CrDaClientSocketPcktHandover}
+#if (CR_DA_OUT_BACKLOG == 1)
+#define CR_FW_OUTSTREAM_PCKTHANDOVER {CR_MA_PEERS(CR_DA_PEER_ARG, &CrDaOutBacklogPcktHandover)}
+#elif (CR_DA_SHM_TRANSPORT == 1)
+#define CR_FW_OUTSTREAM_PCKTHANDOVER {CR_MA_PEERS(CR_DA_PEER_ARG, &CrDaShmPcktHandover)}
+#elif (CR_DA_IO_THREAD == 1)
+#define CR_FW_OUTSTREAM_PCKTHANDOVER {CR_MA_PEERS(CR_DA_PEER_ARG, &CrDaIoThreadPcktHandover)}
+#elif (CR_DA_REPLAY == 1)
+#define CR_FW_OUTSTREAM_PCKTHANDOVER {CR_MA_PEERS(CR_DA_PEER_ARG, &CrDaReplayPcktHandover)}
+#else
+#define CR_FW_OUTSTREAM_PCKTHANDOVER {CR_MA_PEERS(CR_DA_PEER_ARG, &CrDaClientSocketPcktHandover)}
+#endif
 
 /**
  * The functions implementing the Initialization Check of the OutStream components.
@@ -111,8 +151,18 @@
  *
  * The Initialization Check function defined in this file is the one provided
  * by the socket-based interface of <code>CrDaClientSocket.h</code>.
+ * If the shared-memory transport is selected (see <code>#CR_DA_SHM_TRANSPORT</code>),
+ * the function provided by <code>CrDaShm.h</code> is used instead.
+ * If the replay transport is selected (see <code>#CR_DA_REPLAY</code>), the default
+ * initialization check is used instead.
  */
-#define CR_FW_OUTSTREAM_INITCHECK {&CrDaClientSocketInitCheck,&CrDaClientSocketInitCheck}
+#if (CR_DA_SHM_TRANSPORT == 1)
+#define CR_FW_OUTSTREAM_INITCHECK {CR_MA_PEERS(CR_DA_PEER_ARG, &CrDaShmInitCheck)}
+#elif (CR_DA_REPLAY == 1)
+#define CR_FW_OUTSTREAM_INITCHECK {CR_MA_PEERS(CR_DA_PEER_ARG, &CrFwBaseCmpDefInitCheck)}
+#else
+#define CR_FW_OUTSTREAM_INITCHECK {CR_MA_PEERS(CR_DA_PEER_ARG, &CrDaClientSocketInitCheck)}
+#endif
 
 /**
  * The functions implementing the Initialization Action of the OutStream components.
@@ -133,8 +183,18 @@
  *
  * The Initialization Action function defined in this file is the one provided
  * by the socket-based interface of <code>CrDaClientSocket.h</code>.
+ * If the shared-memory transport is selected (see <code>#CR_DA_SHM_TRANSPORT</code>),
+ * the function provided by <code>CrDaShm.h</code> is used instead.
+ * If the replay transport is selected (see <code>#CR_DA_REPLAY</code>), the function
+ * provided by <code>CrDaReplay.h</code> is used instead.
  */
-#define CR_FW_OUTSTREAM_INITACTION {&CrDaClientSocketInitAction,&CrDaClientSocketInitAction}
+#if (CR_DA_SHM_TRANSPORT == 1)
+#define CR_FW_OUTSTREAM_INITACTION {CR_MA_PEERS(CR_DA_PEER_ARG, &CrDaShmInitAction)}
+#elif (CR_DA_REPLAY == 1)
+#define CR_FW_OUTSTREAM_INITACTION {CR_MA_PEERS(CR_DA_PEER_ARG, &CrDaReplayInitAction)}
+#else
+#define CR_FW_OUTSTREAM_INITACTION {CR_MA_PEERS(CR_DA_PEER_ARG, &CrDaClientSocketInitAction)}
+#endif
 
 /**
  * The functions implementing the Configuration Check of the OutStream components.
@@ -152,7 +212,7 @@
  * The Configuration Check function defined in this file is the one provided
  * by the socket-based interface of <code>CrDaClientSocket.h</code>.
  */
-#define CR_FW_OUTSTREAM_CONFIGCHECK {&CrFwBaseCmpDefConfigCheck,&CrFwBaseCmpDefConfigCheck}
+#define CR_FW_OUTSTREAM_CONFIGCHECK {CR_MA_PEERS(CR_DA_PEER_ARG, &CrFwBaseCmpDefConfigCheck)}
 
 /**
  * The functions implementing the Configuration Action of the OutStream components.
@@ -171,7 +231,7 @@
  * An application-specific Configuration Action should therefore include a call
  * to this function.
  */
-#define CR_FW_OUTSTREAM_CONFIGACTION {&CrFwOutStreamDefConfigAction,&CrFwOutStreamDefConfigAction}
+#define CR_FW_OUTSTREAM_CONFIGACTION {CR_MA_PEERS(CR_DA_PEER_ARG, &CrFwOutStreamDefConfigAction)}
 
 /**
  * The functions implementing the Shutdown Action of the OutStream components.
@@ -189,7 +249,17 @@
  *
  * The Shutdown Action function defined in this file is the one provided
  * by the socket-based interface of <code>CrDaClientSocket.h</code>.
+ * If the shared-memory transport is selected (see <code>#CR_DA_SHM_TRANSPORT</code>),
+ * the function provided by <code>CrDaShm.h</code> is used instead.
+ * If the replay transport is selected (see <code>#CR_DA_REPLAY</code>), the function
+ * provided by <code>CrDaReplay.h</code> is used instead.
  */
-#define CR_FW_OUTSTREAM_SHUTDOWNACTION {&CrDaClientSocketShutdownAction,&CrDaClientSocketShutdownAction}
+#if (CR_DA_SHM_TRANSPORT == 1)
+#define CR_FW_OUTSTREAM_SHUTDOWNACTION {CR_MA_PEERS(CR_DA_PEER_ARG, &CrDaShmShutdownAction)}
+#elif (CR_DA_REPLAY == 1)
+#define CR_FW_OUTSTREAM_SHUTDOWNACTION {CR_MA_PEERS(CR_DA_PEER_ARG, &CrDaReplayShutdownAction)}
+#else
+#define CR_FW_OUTSTREAM_SHUTDOWNACTION {CR_MA_PEERS(CR_DA_PEER_ARG, &CrDaClientSocketShutdownAction)}
+#endif
 
 #endif /* CR_FW_OUTSTREAM_USERPAR_H_ */
@@ -0,0 +1,102 @@
+/**
+ * @file
+ * @ingroup crConfigDemoMaster
+ * Interface for the memory which backs the packet pool of the default packet
+ * implementation (see <code>CrFwPckt.c</code>).
+ *
+ * The packets of a size class are stored in slots whose size (the <i>stride</i>) is the
+ * slot size of the class rounded up to a multiple of <code>#CR_FW_PCKT_SLOT_ALIGN</code>
+ * and the packet array starts on a boundary of <code>#CR_FW_PCKT_SLOT_ALIGN</code> bytes.
+ * With the default alignment of 64 bytes, each packet starts on a cache line, no two
+ * packets share a cache line and the header attributes of a packet never straddle two
+ * cache lines.
+ *
+ * By default, the packet array is a static array whose pages are mapped by the operating
+ * system when they are first touched.
+ * If the packet arena is selected (see <code>#CR_FW_PCKT_ARENA</code>), the packet array is
+ * instead mapped by <code>::CrFwPcktArenaInit</code> at startup:
+ * - a pool of at least <code>#CR_FW_PCKT_ARENA_HUGE_SIZE</code> bytes is first mapped on
+ *   huge pages reserved by the system (<code>MAP_HUGETLB</code>) and, if none are
+ *   available, on normal pages which are advised to be backed by transparent huge pages
+ *   (<code>MADV_HUGEPAGE</code>);
+ * - a smaller pool is mapped on normal pages;
+ * - if the mapping fails, the static array is used.
+ * .
+ * In all cases, <code>::CrFwPcktArenaInit</code> touches each page of the packet array so that
+ * the page faults are taken at startup and not in the receive path.
+ *
+ * The packet array is sized by the compile-time number of packets of each size class
+ * (e.g. <code>#CR_FW_NOF_SMALL_PCKTS</code>) but the pool may use fewer packets and other
+ * quotas if the runtime configuration sets them (see <code>::CrFwPcktArenaConfigure</code>).
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRFW_PCKTARENA_H_
+#define CRFW_PCKTARENA_H_
+
+#include "CrFwConstants.h"
+#include "CrFwUserConstants.h"
+
+/** The memory which backs the packet array. */
+typedef enum {
+	/** The static array of the packet pool. */
+	crFwPcktArenaStatic = 0,
+	/** A mapping on normal pages. */
+	crFwPcktArenaPages = 1,
+	/** A mapping on normal pages which are advised to be backed by transparent huge pages. */
+	crFwPcktArenaAdvisedHugePages = 2,
+	/** A mapping on huge pages reserved by the system. */
+	crFwPcktArenaHugePages = 3
+} CrFwPcktArenaBacking_t;
+
+/**
+ * Map the packet array (if the packet arena is selected) and prefault its pages.
+ * This function must be called once at startup, before the first packet is made and
+ * before the threads which access the packet pool are started.
+ * If a packet has already been made, the packet array is left where it is and only
+ * its pages are touched.
+ * @return the memory which backs the packet array
+ */
+CrFwPcktArenaBacking_t CrFwPcktArenaInit();
+
+/**
+ * Apply the runtime configuration (see <code>CrDaConfig.h</code>) to the packet pool.
+ * The number of packets of each size class and the reserved quotas of the InStream and
+ * OutStream partitions (see <code>CrFwPcktPart.h</code>) are set to the values of the
+ * runtime configuration or, for the elements which it does not set, to their
+ * compile-time values.
+ * A size class cannot hold more packets than its slab of the packet array: the
+ * configuration can only shrink the pool and the packets which it leaves out are never
+ * allocated.
+ * This function must be called at startup before the first packet is made.
+ * @return 1 if the configuration was applied; 0 if the pool holds packets, if a size
+ * class is larger than its slab, if the pool is empty or if the sum of the quotas exceeds
+ * the number of packets of the pool (the pool is then left unchanged)
+ */
+CrFwBool_t CrFwPcktArenaConfigure();
+
+/**
+ * Return the memory which backs the packet array.
+ * @return the memory which backs the packet array
+ */
+CrFwPcktArenaBacking_t CrFwPcktArenaGetBacking();
+
+/**
+ * Return the size in number of bytes of the packet array.
+ * This is the sum of the strides of all packets.
+ * @return the size of the packet array
+ */
+unsigned int CrFwPcktArenaGetSize();
+
+#endif /* CRFW_PCKTARENA_H_ */
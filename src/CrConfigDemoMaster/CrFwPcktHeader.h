@@ -0,0 +1,70 @@
+/**
+ * @file
+ * @ingroup crConfigDemoMaster
+ * Interface for the single-pass decoding of the packet header of the default packet
+ * implementation (see <code>CrFwPckt.c</code>).
+ * The function <code>::CrFwPcktDecodeHeader</code> extracts all the attributes of a
+ * packet which are needed to route it and to identify its command or report kind
+ * and stores them in a <code>::CrFwPcktHeader_t</code> structure.
+ * Modules which need several of these attributes can decode the header once and
+ * then read the attributes from the structure instead of calling one accessor
+ * per attribute.
+ *
+ * The structure is a snapshot of the packet header: it is not updated when the
+ * attributes of the packet are subsequently modified.
+ * The time stamp, the acknowledge levels and the parameter area are not part of the
+ * structure and must be read through their accessors.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRFW_PCKTHEADER_H_
+#define CRFW_PCKTHEADER_H_
+
+#include "CrFwConstants.h"
+#include "CrFwUserConstants.h"
+
+/** Type for the decoded header of a packet. */
+typedef struct {
+	/** The packet length. */
+	CrFwPcktLength_t length;
+	/** The packet type (command or report). */
+	CrFwCmdRepType_t cmdRepType;
+	/** The service type. */
+	CrFwServType_t servType;
+	/** The service sub-type. */
+	CrFwServSubType_t servSubType;
+	/** The discriminant. */
+	CrFwDiscriminant_t discriminant;
+	/** The source. */
+	CrFwDestSrc_t src;
+	/** The destination. */
+	CrFwDestSrc_t dest;
+	/** The group. */
+	CrFwGroup_t group;
+	/** The sequence counter. */
+	CrFwSeqCnt_t seqCnt;
+	/** The command or report identifier. */
+	CrFwInstanceId_t cmdRepId;
+} CrFwPcktHeader_t;
+
+/**
+ * Decode the header of a packet.
+ * The routing attributes of the packet are read in one pass and stored in the
+ * argument structure.
+ * @param pckt the packet
+ * @param hdr the location where the decoded header is returned
+ */
+void CrFwPcktDecodeHeader(CrFwPckt_t pckt, CrFwPcktHeader_t* hdr);
+
+#endif /* CRFW_PCKTHEADER_H_ */
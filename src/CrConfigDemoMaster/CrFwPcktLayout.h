@@ -0,0 +1,171 @@
+/**
+ * @file
+ * @ingroup crConfigDemoMaster
+ * Description of the layout of the packet header of the default packet implementation
+ * (see <code>CrFwPckt.c</code>).
+ * The layout is a table of fields (<code>#CR_FW_PCKT_LAYOUT</code>) from which the
+ * accessors of the header fields and the offset constants are generated at compile time.
+ * Each row of the table has the form:
+ * <pre>
+ *   X(Name, Type, offset, width, bit)
+ * </pre>
+ * where:
+ * - <code>Name</code> is the name of the field (e.g. <code>SeqCnt</code>);
+ * - <code>Type</code> is the type of the storage unit of the field: the unit is
+ *   <code>sizeof(Type)</code> bytes long and it is loaded and stored in the byte order
+ *   selected by <code>#CR_FW_PCKT_NET_ORDER</code> (see <code>CrFwPcktWire.h</code>);
+ * - <code>offset</code> is the offset in bytes of the storage unit in the packet;
+ * - <code>width</code> is the width in bits of the field or <code>#CR_FW_PCKT_WHOLE</code>
+ *   if the field occupies the whole storage unit;
+ * - <code>bit</code> is the position of the least significant bit of the field in its
+ *   storage unit (zero for a field which occupies the whole storage unit).
+ * .
+ * Several fields may share a storage unit (e.g. the flags of the compact layout or
+ * the sub-byte fields of a PUS packet header).
+ * For each row, this file generates the inline functions <code>CrFwPcktLayoutGetName</code>
+ * and <code>CrFwPcktLayoutSetName</code> and the constants <code>crFwPcktOffsetName</code>,
+ * <code>crFwPcktWidthName</code> and <code>crFwPcktBitName</code>.
+ * Since all arguments of the generated functions except the packet are constants, each
+ * access compiles into a load or store at a constant offset (plus a shift and a mask for
+ * the fields which do not occupy their whole storage unit): the layout has no cost at
+ * run time.
+ * A row which places a field outside the header or outside its storage unit is rejected
+ * at compile time.
+ *
+ * The accessors of <code>CrFwPcktInline.h</code> are implemented on top of the generated
+ * functions and require the following fields: <code>Length</code>,
+ * <code>CmdRepType</code>, <code>TimeStamp</code>, <code>ServType</code>,
+ * <code>ServSubType</code>, <code>Dest</code>, <code>Src</code>,
+ * <code>Discriminant</code>, <code>SeqCnt</code>, <code>CmdRepId</code>,
+ * <code>AcceptAck</code>, <code>StartAck</code>, <code>ProgressAck</code>,
+ * <code>TermAck</code> and <code>Group</code>.
+ * A field <code>CmdRepType</code> of one bit is set for a report and cleared for a
+ * command; a wider field holds the value of <code>CrFwCmdRepType_t</code>.
+ * The <code>Length</code> field must be a <code>CrFwPcktLength_t</code> stored at the
+ * start of the packet (the transports frame the packets on it).
+ *
+ * Two layouts are provided and are selected through <code>#CR_FW_PCKT_COMPACT_LAYOUT</code>.
+ * A mission-specific layout is selected by defining <code>CR_FW_PCKT_LAYOUT_HEADER</code>
+ * as the name of a header file (e.g. <code>-DCR_FW_PCKT_LAYOUT_HEADER='"MyLayout.h"'</code>)
+ * which defines <code>#CR_FW_PCKT_LAYOUT</code> and <code>#CR_FW_PCKT_HEADER_LENGTH</code>.
+ * All applications which exchange packets must use the same layout.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRFW_PCKTLAYOUT_H_
+#define CRFW_PCKTLAYOUT_H_
+
+#include "CrFwConstants.h"
+#include "CrFwUserConstants.h"
+#include "Pckt/CrFwPckt.h"
+#include "CrFwPcktWire.h"
+
+/** The width of a field which occupies its whole storage unit. */
+#define CR_FW_PCKT_WHOLE 0
+
+#if defined(CR_FW_PCKT_LAYOUT_HEADER)
+#include CR_FW_PCKT_LAYOUT_HEADER
+#elif (CR_FW_PCKT_COMPACT_LAYOUT == 1)
+/**
+ * The compact layout: each field is as large as its type and the packet type and the
+ * four acknowledge levels are bits of one flag byte.
+ */
+#define CR_FW_PCKT_LAYOUT(X) \
+	X(Length,       CrFwPcktLength_t,   0,  CR_FW_PCKT_WHOLE, 0) \
+	X(Discriminant, CrFwDiscriminant_t, 2,  CR_FW_PCKT_WHOLE, 0) \
+	X(TimeStamp,    CrFwTimeStamp_t,    4,  CR_FW_PCKT_WHOLE, 0) \
+	X(SeqCnt,       CrFwSeqCnt_t,       8,  CR_FW_PCKT_WHOLE, 0) \
+	X(CmdRepId,     CrFwInstanceId_t,   12, CR_FW_PCKT_WHOLE, 0) \
+	X(ServType,     CrFwServType_t,     14, CR_FW_PCKT_WHOLE, 0) \
+	X(ServSubType,  CrFwServSubType_t,  15, CR_FW_PCKT_WHOLE, 0) \
+	X(Dest,         CrFwDestSrc_t,      16, CR_FW_PCKT_WHOLE, 0) \
+	X(Src,          CrFwDestSrc_t,      17, CR_FW_PCKT_WHOLE, 0) \
+	X(Group,        CrFwGroup_t,        18, CR_FW_PCKT_WHOLE, 0) \
+	X(CmdRepType,   unsigned char,      19, 1,                0) \
+	X(AcceptAck,    unsigned char,      19, 1,                1) \
+	X(StartAck,     unsigned char,      19, 1,                2) \
+	X(ProgressAck,  unsigned char,      19, 1,                3) \
+	X(TermAck,      unsigned char,      19, 1,                4)
+
+/** The length of the packet header (i.e. the offset of the parameter area in a packet) */
+#define CR_FW_PCKT_HEADER_LENGTH 20
+#else
+/** The standard layout: each field is stored at the start of its own 4-byte word. */
+#define CR_FW_PCKT_LAYOUT(X) \
+	X(Length,       CrFwPcktLength_t,   0,  CR_FW_PCKT_WHOLE, 0) \
+	X(CmdRepType,   CrFwBool_t,         4,  CR_FW_PCKT_WHOLE, 0) \
+	X(TimeStamp,    CrFwTimeStamp_t,    8,  CR_FW_PCKT_WHOLE, 0) \
+	X(ServType,     CrFwServType_t,     12, CR_FW_PCKT_WHOLE, 0) \
+	X(ServSubType,  CrFwServSubType_t,  16, CR_FW_PCKT_WHOLE, 0) \
+	X(Dest,         CrFwDestSrc_t,      20, CR_FW_PCKT_WHOLE, 0) \
+	X(Src,          CrFwDestSrc_t,      24, CR_FW_PCKT_WHOLE, 0) \
+	X(Discriminant, CrFwDiscriminant_t, 28, CR_FW_PCKT_WHOLE, 0) \
+	X(SeqCnt,       CrFwSeqCnt_t,       32, CR_FW_PCKT_WHOLE, 0) \
+	X(CmdRepId,     CrFwInstanceId_t,   36, CR_FW_PCKT_WHOLE, 0) \
+	X(AcceptAck,    CrFwBool_t,         40, CR_FW_PCKT_WHOLE, 0) \
+	X(StartAck,     CrFwBool_t,         44, CR_FW_PCKT_WHOLE, 0) \
+	X(ProgressAck,  CrFwBool_t,         48, CR_FW_PCKT_WHOLE, 0) \
+	X(TermAck,      CrFwBool_t,         52, CR_FW_PCKT_WHOLE, 0) \
+	X(Group,        CrFwGroup_t,        56, CR_FW_PCKT_WHOLE, 0)
+
+/** The length of the packet header (i.e. the offset of the parameter area in a packet) */
+#define CR_FW_PCKT_HEADER_LENGTH 60
+#endif
+
+/** The mask of the bits of a field of the given width (the whole storage unit for <code>#CR_FW_PCKT_WHOLE</code>). */
+#define CR_FW_PCKT_LAYOUT_MASK(width) \
+	(((width) == CR_FW_PCKT_WHOLE) ? ~0ULL : ((1ULL << ((width) & 63)) - 1))
+
+/** Generate the offset, width and bit constants of a field. */
+#define CR_FW_PCKT_LAYOUT_CONST(Name, Type, offset, width, bit) \
+	crFwPcktOffset##Name = (offset), \
+	crFwPcktWidth##Name = (width), \
+	crFwPcktBit##Name = (bit),
+
+/** Generate the compile-time check of a field (the array has a negative size if the check fails). */
+#define CR_FW_PCKT_LAYOUT_CHECK(Name, Type, offset, width, bit) \
+	typedef char CrFwPcktLayoutCheck##Name[(((offset) + sizeof(Type) <= CR_FW_PCKT_HEADER_LENGTH) && \
+	        ((bit) + (width) <= 8*sizeof(Type)) && (((width) != CR_FW_PCKT_WHOLE) || ((bit) == 0))) ? 1 : -1];
+
+/** Generate the accessors of a field. */
+#define CR_FW_PCKT_LAYOUT_ACCESSORS(Name, Type, offset, width, bit) \
+	static inline Type CrFwPcktLayoutGet##Name(CrFwPckt_t pckt) { \
+		Type v; \
+		CrFwPcktWireLoad(&v, pckt+(offset), sizeof(Type)); \
+		if ((width) != CR_FW_PCKT_WHOLE) \
+			v = (Type)(((unsigned long long)v >> (bit)) & CR_FW_PCKT_LAYOUT_MASK(width)); \
+		return v; \
+	} \
+	static inline void CrFwPcktLayoutSet##Name(CrFwPckt_t pckt, Type v) { \
+		Type u; \
+		if ((width) != CR_FW_PCKT_WHOLE) { \
+			CrFwPcktWireLoad(&u, pckt+(offset), sizeof(Type)); \
+			v = (Type)(((unsigned long long)u & ~(CR_FW_PCKT_LAYOUT_MASK(width) << (bit))) | \
+			           (((unsigned long long)v & CR_FW_PCKT_LAYOUT_MASK(width)) << (bit))); \
+		} \
+		CrFwPcktWireStore(pckt+(offset), &v, sizeof(Type)); \
+	}
+
+/** The offsets, widths and bit positions of the fields of the packet header. */
+enum {
+	CR_FW_PCKT_LAYOUT(CR_FW_PCKT_LAYOUT_CONST)
+	/** The offset of the parameter area in a packet. */
+	crFwPcktOffsetPar = CR_FW_PCKT_HEADER_LENGTH
+};
+
+CR_FW_PCKT_LAYOUT(CR_FW_PCKT_LAYOUT_CHECK)
+
+CR_FW_PCKT_LAYOUT(CR_FW_PCKT_LAYOUT_ACCESSORS)
+
+#endif /* CRFW_PCKTLAYOUT_H_ */
@@ -0,0 +1,113 @@
+/**
+ * @file
+ * @ingroup crConfigDemoMaster
+ * Loads and stores of the multi-byte fields of the packets of the default packet
+ * implementation (see <code>CrFwPckt.c</code>).
+ * The fields of a packet are at fixed offsets which need not be aligned for the type of
+ * the field (e.g. in the compact layout or in the parameter area).
+ * They are therefore copied with <code>memcpy</code> whose size is a constant: the
+ * compiler turns each copy into one load or store of the size of the field.
+ *
+ * The byte order of the fields is selected with <code>#CR_FW_PCKT_NET_ORDER</code>.
+ * If network byte order is selected and the host is little-endian, the loads and stores
+ * reverse the bytes of the field with the byte-swap built-ins of the compiler (one
+ * instruction on the common processors).
+ * Otherwise the byte order of the host is the byte order of the packets and the loads
+ * and stores are plain copies: no byte is moved and no code is generated for the
+ * conversion.
+ * One-byte fields (e.g. the service type) have no byte order and are not converted.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRFW_PCKTWIRE_H_
+#define CRFW_PCKTWIRE_H_
+
+#include <stdint.h>
+#include <string.h>
+#include "CrFwUserConstants.h"
+
+#if !defined(__BYTE_ORDER__)
+#error "The byte order of the host is not known"
+#endif
+
+/**
+ * Flag which is set to 1 if the byte order of the packets differs from the byte order
+ * of the host (i.e. if the fields must be swapped when they are loaded and stored).
+ */
+#if (CR_FW_PCKT_NET_ORDER == 1) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#define CR_FW_PCKT_WIRE_SWAP 1
+#else
+#define CR_FW_PCKT_WIRE_SWAP 0
+#endif
+
+/**
+ * Convert a field between the byte order of the packets and the byte order of the host.
+ * The conversion is its own inverse: it is used in both directions.
+ * @param loc the location of the field (it need not be aligned)
+ * @param size the size of the field in number of bytes (1, 2, 4 or 8)
+ */
+static inline void CrFwPcktWireSwap(void* loc, unsigned int size) {
+#if (CR_FW_PCKT_WIRE_SWAP == 1)
+	uint16_t v2;
+	uint32_t v4;
+	uint64_t v8;
+
+	switch (size) {
+	case 2:
+		memcpy(&v2, loc, 2);
+		v2 = __builtin_bswap16(v2);
+		memcpy(loc, &v2, 2);
+		break;
+	case 4:
+		memcpy(&v4, loc, 4);
+		v4 = __builtin_bswap32(v4);
+		memcpy(loc, &v4, 4);
+		break;
+	case 8:
+		memcpy(&v8, loc, 8);
+		v8 = __builtin_bswap64(v8);
+		memcpy(loc, &v8, 8);
+		break;
+	default:	/* one-byte fields have no byte order */
+		break;
+	}
+#else
+	(void)loc;
+	(void)size;
+#endif
+}
+
+/**
+ * Load a field of a packet into a host variable.
+ * @param v the host variable
+ * @param loc the location of the field in the packet
+ * @param size the size of the field (and of the host variable) in number of bytes
+ */
+static inline void CrFwPcktWireLoad(void* v, const char* loc, unsigned int size) {
+	memcpy(v, loc, size);
+	CrFwPcktWireSwap(v, size);
+}
+
+/**
+ * Store a host variable into a field of a packet.
+ * @param loc the location of the field in the packet
+ * @param v the host variable
+ * @param size the size of the field (and of the host variable) in number of bytes
+ */
+static inline void CrFwPcktWireStore(char* loc, const void* v, unsigned int size) {
+	memcpy(loc, v, size);
+	CrFwPcktWireSwap(loc, size);
+}
+
+#endif /* CRFW_PCKTWIRE_H_ */
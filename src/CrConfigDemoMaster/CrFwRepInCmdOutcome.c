@@ -3,7 +3,9 @@
  * @ingroup crConfigDemoMaster
  * Implementation of the error reporting interface of <code>CrFwRepErr.h</code>
  * for the Master Application of the CORDET Demo.
- * This implementation writes the InCommand Outcome Reports to standard output.
+ * This implementation writes the InCommand Outcome Reports to the log (see
+ * <code>CrDaLog.h</code>) or, if the binary trace is selected, to the ring buffer of the
+ * trace (see <code>CrDaTrace.h</code>).
  *
  * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
  * @author Alessandro Pasetti <pasetti@pnp-software.com>
@@ -22,6 +24,11 @@
 #include <stdlib.h>
 #include <string.h>
 #include "CrDaConstants.h"
+#include "CrDaTrace.h"
+#include "CrDaLatTrace.h"
+#include "CrDaInCmdAsync.h"
+#include "CrDaLog.h"
+#include "CrDaInCmpPool.h"
 /* Include Framework Files */
 #include "CrFwConstants.h"
 #include "CrFwRepInCmdOutcome.h"
@@ -29,15 +36,32 @@
 /*-----------------------------------------------------------------------------------------*/
 void CrFwRepInCmdOutcome(CrFwRepInCmdOutcome_t outcome, CrFwInstanceId_t instanceId, CrFwServType_t servType,
                          CrFwServSubType_t servSubType, CrFwDiscriminant_t disc, CrFwOutcome_t failCode, FwSmDesc_t inCmd) {
+	/* Record the hop of the InCommand in its latency trace */
+	CrDaLatTraceInCmd(outcome, inCmd);
 
-	printf("CrFwRepInCmdOutcome: unexpected outcome for InCommand %d, service type %d,\n",instanceId,servType);
-	printf("                     service sub-type %d, and discriminant %d\n",servSubType,disc);
+	/* The executions in which the continuation of an InCommand still waits are no progress */
+	if ((outcome == crCmdAckPrgSucc) && CrDaInCmdAsyncIsWaiting(inCmd))
+		return;
+
+
+#if (CR_DA_TRACE == 1)
+	CrDaTraceWrite(crDaTraceInCmdOutcome, outcome, failCode, instanceId, servType, servSubType, disc);
+#else
+	CR_DA_LOG(crDaLogWarn, "CrFwRepInCmdOutcome: unexpected outcome for InCommand %d, service type %d,\n"
+	          "                     service sub-type %d, and discriminant %d\n", instanceId, servType, servSubType, disc);
+#endif
 
 }
 
 /*-----------------------------------------------------------------------------------------*/
 void CrFwRepInCmdOutcomeCreFail(CrFwRepInCmdOutcome_t outcome, CrFwOutcome_t failCode, CrFwPckt_t pckt) {
+	/* Count the failure against the InCommand pool */
+	CrDaInCmpPoolInCmdCreFail();
 
-	printf("CrFwRepInCmdOutcomeCreFailt: failure to create InCommand component\n");
+#if (CR_DA_TRACE == 1)
+	CrDaTraceWrite(crDaTraceInCmdOutcomeCreFail, outcome, failCode, 0, 0, 0, 0);
+#else
+	CR_DA_LOG(crDaLogWarn, "CrFwRepInCmdOutcomeCreFailt: failure to create InCommand component\n");
+#endif
 }
 
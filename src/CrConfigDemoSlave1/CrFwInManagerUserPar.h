@@ -25,12 +25,64 @@
 #ifndef CR_FW_INMANAGER_USERPAR_H_
 #define CR_FW_INMANAGER_USERPAR_H_
 
+#include "CrDaConstants.h"
+
+/** The number of primary InManagers (InManager 0 for the InCommands). */
+#define CR_DA_INMANAGER_NOF_PRIMARY 1
+
+#if (CR_DA_INMANAGER_SPILL == 1)
+/** The number of spill InManagers (see <code>CrDaInManagerChain.h</code>). */
+#define CR_DA_INMANAGER_NOF_SPILL 2
+#else
+#define CR_DA_INMANAGER_NOF_SPILL 0
+#endif
+
+/** The size of the PCRL of each spill InManager. */
+#define CR_DA_INMANAGER_PCRLSIZE_SPILL 5
+
+/** The capacity of the spill InManagers. */
+#define CR_DA_INMANAGER_SPILL_CAPACITY (CR_DA_INMANAGER_NOF_SPILL * CR_DA_INMANAGER_PCRLSIZE_SPILL)
+
+#if (CR_DA_INCMD_EXPRESS == 1)
+/** The number of express InManagers (see <code>CrDaInCmdExpress.h</code>). */
+#define CR_DA_INMANAGER_NOF_EXPRESS 1
+#else
+#define CR_DA_INMANAGER_NOF_EXPRESS 0
+#endif
+
+/** The identifier of the express InManager (it follows the spill InManagers). */
+#define CR_DA_INMANAGER_EXPRESS (CR_DA_INMANAGER_NOF_PRIMARY + CR_DA_INMANAGER_NOF_SPILL)
+
+/** The size of the PCRL of the express InManager. */
+#define CR_DA_INMANAGER_PCRLSIZE_EXPRESS CR_DA_INCMD_EXPRESS_BUDGET
+
+/** The capacity of the express InManager. */
+#define CR_DA_INMANAGER_EXPRESS_CAPACITY (CR_DA_INMANAGER_NOF_EXPRESS * CR_DA_INMANAGER_PCRLSIZE_EXPRESS)
+
+/**
+ * The entries of the express InManager at the end of <code>#CR_FW_INMANAGER_PCRLSIZE</code>
+ * and <code>#CR_FW_INMANAGER_INDEPENDENT</code> (none if the express lane is not selected).
+ */
+#if (CR_DA_INCMD_EXPRESS == 1)
+#define CR_DA_INMANAGER_PCRLSIZE_EXPRESS_LIST , CR_DA_INMANAGER_PCRLSIZE_EXPRESS
+#define CR_DA_INMANAGER_INDEPENDENT_EXPRESS_LIST , 0
+#else
+#define CR_DA_INMANAGER_PCRLSIZE_EXPRESS_LIST
+#define CR_DA_INMANAGER_INDEPENDENT_EXPRESS_LIST
+#endif
+
 /**
  * The number of InManager components in the application.
  * The value of this constant must be smaller than the range of the <code>::CrFwCounterU1_t</code>
  * integer type.
+ * The primary InManagers are followed by the spill InManagers (see
+ * <code>CrDaInManagerChain.h</code>) and by the express InManager (see
+ * <code>CrDaInCmdExpress.h</code>).
  */
-#define CR_FW_NOF_INMANAGER 1
+#define CR_FW_NOF_INMANAGER (CR_DA_INMANAGER_NOF_PRIMARY + CR_DA_INMANAGER_NOF_SPILL + CR_DA_INMANAGER_NOF_EXPRESS)
+
+/** The size of the PCRL of the InManager which holds the InCommands (InManager 0). */
+#define CR_DA_INMANAGER_PCRLSIZE_INCMD 10
 
 /**
  * The sizes of the Pending Command/Report List (PCRL) of the InManager components.
@@ -39,6 +91,27 @@
  * The size of a PCRL must be a positive integer (i.e. it is not legal
  * to define a zero-size PCRL) in the range of the <code>#CrFwCounterU2_t</code> type.
  */
-#define CR_FW_INMANAGER_PCRLSIZE {10}
+#if (CR_DA_INMANAGER_SPILL == 1)
+#define CR_FW_INMANAGER_PCRLSIZE {CR_DA_INMANAGER_PCRLSIZE_INCMD, \
+                                  CR_DA_INMANAGER_PCRLSIZE_SPILL, CR_DA_INMANAGER_PCRLSIZE_SPILL CR_DA_INMANAGER_PCRLSIZE_EXPRESS_LIST}
+#else
+#define CR_FW_INMANAGER_PCRLSIZE {CR_DA_INMANAGER_PCRLSIZE_INCMD CR_DA_INMANAGER_PCRLSIZE_EXPRESS_LIST}
+#endif
+
+/**
+ * The independence flags of the InManager components.
+ * This constant defines the independence flag of the i-th InManager.
+ * If the manager pool is selected (see <code>#CR_DA_MGR_POOL</code>), the InManagers whose
+ * flag is set to 1 are executed concurrently with the other managers by their own worker
+ * thread (see <code>CrDaMgrPool.h</code> for the conditions under which a manager may be
+ * marked as independent).
+ * The InManagers of the demo applications share the framework components and are not
+ * independent.
+ */
+#if (CR_DA_INMANAGER_SPILL == 1)
+#define CR_FW_INMANAGER_INDEPENDENT {0,0,0 CR_DA_INMANAGER_INDEPENDENT_EXPRESS_LIST}
+#else
+#define CR_FW_INMANAGER_INDEPENDENT {0 CR_DA_INMANAGER_INDEPENDENT_EXPRESS_LIST}
+#endif
 
 #endif /* CR_FW_INMANAGER_USERPAR_H_ */
@@ -18,15 +18,26 @@
  */
 
 #include "CrDaOutCmpTempViolation.h"
+#include "CrDaOutCmpAck.h"
+#include "CrDaPcktTemplate.h"
+#include "CrFwOutManagerUserPar.h"
 
 #ifndef CRFW_OUTFACTORY_USERPAR_H_
 #define CRFW_OUTFACTORY_USERPAR_H_
 
+/**
+ * The number of OutComponents which may be allocated and not yet loaded into an OutManager
+ * (they are loaded as soon as they have been configured).
+ */
+#define CR_DA_OUTFACTORY_NOF_UNLOADED 2
+
 /**
  * The maximum number of OutComponents which may be allocated at any one time.
  * This constant must be smaller than the range of <code>::CrFwOutFactoryPoolIndex_t</code>.
+ * An OutComponent is released when its OutManager has sent it: the pool holds enough
+ * OutComponents to fill the POCLs of all OutManagers (see <code>CrDaOutCmpPool.h</code>).
  */
-#define CR_FW_OUTFACTORY_MAX_NOF_OUTCMP 10
+#define CR_FW_OUTFACTORY_MAX_NOF_OUTCMP (CR_DA_OUTMANAGER_POCLSIZE_TOTAL + CR_DA_OUTFACTORY_NOF_UNLOADED)
 
 /**
  * The total number of kinds of OutComponents supported by the application.
@@ -36,7 +47,7 @@
  * initializer <code>#CR_FW_OUTCMP_INIT_KIND_DESC</code> and it must be smaller
  * than the range of the <code>::CrFwCmdRepKindIndex_t</code> type.
  */
-#define CR_FW_OUTCMP_NKINDS 1
+#define CR_FW_OUTCMP_NKINDS 5
 
 /**
  * Definition of the OutComponent kinds supported by an application.
@@ -89,11 +100,29 @@
  *
  * The initializer values defined below are which are used for the Slave Applications.
  * The non-default function pointers for the serialize operationas are defined in
- * <code>CrDaOutCmpTempViolation</code>.
+ * <code>CrDaOutCmpTempViolation</code> and <code>CrDaOutCmpAck</code>.
+ * The batch report of temperature violations (see <code>CrDaOutCmpTempBatch.h</code>) only
+ * serializes its header because its parameters are written when it is made;
+ * its length is <code>#CR_DA_TEMP_BATCH_PCKT_LENGTH</code>.
+ * The acknowledgement batch report (see <code>CrDaOutCmpAckBatch.h</code>) likewise only
+ * serializes its header; its length is <code>#CR_DA_ACK_BATCH_PCKT_LENGTH</code>.
+ * The statistics report of the temperature monitoring (see <code>CrDaOutCmpTempStats.h</code>)
+ * likewise only serializes its header; its length is <code>#CR_DA_TEMP_STATS_PCKT_LENGTH</code>.
+ * The headers of all reports are serialized by <code>::CrDaPcktTemplateSerialize</code> which
+ * copies them from templates if the packet header templates are selected (see
+ * <code>CrDaPcktTemplate.h</code>).
  */
 #define CR_FW_OUTCMP_INIT_KIND_DESC \
 	{ {64, 4, 0, 2, 100, &CrFwOutCmpDefEnableCheck, &CrFwSmCheckAlwaysTrue, \
 							&CrFwSmCheckAlwaysFalse, &CrFwSmEmptyAction, &CrDaOutCmpTempViolationSerialize}, \
+	  {64, 5, 0, 2, 64, &CrFwOutCmpDefEnableCheck, &CrFwSmCheckAlwaysTrue, \
+							&CrFwSmCheckAlwaysFalse, &CrFwSmEmptyAction, &CrDaOutCmpAckSerialize}, \
+	  {64, 6, 0, 2, 128, &CrFwOutCmpDefEnableCheck, &CrFwSmCheckAlwaysTrue, \
+							&CrFwSmCheckAlwaysFalse, &CrFwSmEmptyAction, &CrDaPcktTemplateSerialize}, \
+	  {64, 7, 0, 2, 128, &CrFwOutCmpDefEnableCheck, &CrFwSmCheckAlwaysTrue, \
+							&CrFwSmCheckAlwaysFalse, &CrFwSmEmptyAction, &CrDaPcktTemplateSerialize}, \
+	  {64, 8, 0, 2, 128, &CrFwOutCmpDefEnableCheck, &CrFwSmCheckAlwaysTrue, \
+							&CrFwSmCheckAlwaysFalse, &CrFwSmEmptyAction, &CrDaPcktTemplateSerialize}, \
 	}
 
 #endif /* CR_FW_OUTFACTORY_USERPAR_H_ */
@@ -39,6 +39,32 @@
  */
 #define CR_FW_NOF_OUTMANAGER 1
 
+/**
+ * The OutManager components of the application.
+ * Each entry <code>X(pocl, independent)</code> of this list describes one OutManager:
+ * - The size of its POCL (see <code>#CR_FW_OUTMANAGER_POCLSIZE</code>).
+ * - Its independence flag (see <code>#CR_FW_OUTMANAGER_INDEPENDENT</code>).
+ * .
+ * The initializers of the OutManagers and the size of the OutComponent pool of the
+ * OutFactory (see <code>#CR_FW_OUTFACTORY_MAX_NOF_OUTCMP</code>) are derived from this
+ * list so that they cannot get out of step.
+ * The number of entries must be the same as <code>#CR_FW_NOF_OUTMANAGER</code>.
+ */
+#define CR_DA_OUTMANAGER_LIST(X) \
+	X(10, 0)
+
+/** Return the POCL size of an entry of <code>#CR_DA_OUTMANAGER_LIST</code>. */
+#define CR_DA_OUTMANAGER_POCLSIZE_OF(pocl, independent) pocl,
+
+/** Return the independence flag of an entry of <code>#CR_DA_OUTMANAGER_LIST</code>. */
+#define CR_DA_OUTMANAGER_INDEPENDENT_OF(pocl, independent) independent,
+
+/** Add the POCL size of an entry of <code>#CR_DA_OUTMANAGER_LIST</code> to a sum. */
+#define CR_DA_OUTMANAGER_POCLSIZE_ADD(pocl, independent) pocl +
+
+/** The total size of the POCLs of the OutManager components. */
+#define CR_DA_OUTMANAGER_POCLSIZE_TOTAL (CR_DA_OUTMANAGER_LIST(CR_DA_OUTMANAGER_POCLSIZE_ADD) 0)
+
 /**
  * The sizes of the Pending OutComponent List (POCL) of the OutManager components.
  * Each OutManager has one POCL.
@@ -46,6 +72,16 @@
  * The size of a POCL must be a positive integer (i.e. it is not legal
  * to define a zero-size POCL) in the range of the <code>#CrFwCounterU2_t</code> type.
  */
-#define CR_FW_OUTMANAGER_POCLSIZE {10}
+#define CR_FW_OUTMANAGER_POCLSIZE { CR_DA_OUTMANAGER_LIST(CR_DA_OUTMANAGER_POCLSIZE_OF) }
+
+/**
+ * The independence flags of the OutManager components.
+ * This constant defines the independence flag of the i-th OutManager.
+ * If the manager pool is selected (see <code>#CR_DA_MGR_POOL</code>), the OutManagers whose
+ * flag is set to 1 are executed concurrently with the other managers by their own worker
+ * thread (see <code>CrDaMgrPool.h</code> for the conditions under which a manager may be
+ * marked as independent).
+ */
+#define CR_FW_OUTMANAGER_INDEPENDENT { CR_DA_OUTMANAGER_LIST(CR_DA_OUTMANAGER_INDEPENDENT_OF) }
 
 #endif /* CR_FW_OUTMANAGER_USERPAR_H_ */
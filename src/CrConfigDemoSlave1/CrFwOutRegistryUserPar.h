@@ -40,7 +40,7 @@
  * by the application.
  * This constant must be smaller than the range of: <code>CrFwCmdRepIndex_t</code>.
  */
-#define CR_FW_OUTREGISTRY_NSERV 1
+#define CR_FW_OUTREGISTRY_NSERV 5
 
 /**
  * Definition of the range of out-going services supported by the application.
@@ -68,6 +68,10 @@
  */
 #define CR_FW_OUTREGISTRY_INIT_SERV_DESC \
 	{ {64, 4, 0}, \
+	  {64, 5, 0}, \
+	  {64, 6, 0}, \
+	  {64, 7, 0}, \
+	  {64, 8, 0}, \
 	}
 
 #endif /* CRFW_OUTREGISTRY_USERPAR_H_ */
@@ -35,6 +35,10 @@
 #include "BaseCmp/CrFwResetProc.h"
 /* Include Demo Application files */
 #include "CrDaServerSocket.h"
+#include "CrDaShm.h"
+#include "CrDaReplay.h"
+#include "CrDaIoThread.h"
+#include "CrDaOutBacklog.h"
 #include "CrDaConstants.h"
 
 /**
@@ -60,6 +64,17 @@
  */
 #define CR_FW_OUTSTREAM_PQSIZE {10,10}
 
+/**
+ * The reserved quotas of the OutStreams in the packet pool.
+ * This constant defines the number of packets of the packet pool which are reserved for
+ * the i-th OutStream (see <code>CrFwPcktPart.h</code>).
+ * The packets of an OutStream which exceed its quota are taken from the shared overflow
+ * region of the packet pool.
+ * The sum of the quotas of the InStreams and OutStreams must not exceed
+ * <code>#CR_FW_MAX_NOF_PCKTS</code>.
+ */
+#define CR_FW_OUTSTREAM_PCKT_QUOTA {2,2}
+
 /**
  * The destinations of the OutStream components.
  * The destination of an OutStream is the middleware node to which the OutStream
@@ -78,10 +93,12 @@
  * The number of groups must be a positive integer.
  * This array defines the number of groups of the i-th OutStream.
  *
+ * Each stream has one group for the time-critical packets and one for the routine packets
+ * (see <code>#CR_DA_PCKT_N_OF_GROUPS</code>).
  * The number of groups defined in this file are those used for the Slave 1 Application
  * of the CORDET Demo.
  */
-#define CR_FW_OUTSTREAM_NOF_GROUPS {1,1}
+#define CR_FW_OUTSTREAM_NOF_GROUPS {CR_DA_PCKT_N_OF_GROUPS,CR_DA_PCKT_N_OF_GROUPS}
 
 /**
  * The functions implementing the packet hand-over operations of the OutStream components.
@@ -95,8 +112,27 @@
  *
  * The packet handover functions defined in this file is the one provided
  * by the socket-based interface of <code>CrDaServerSocket.h</code>.
+ * If the shared-memory transport is selected (see <code>#CR_DA_SHM_TRANSPORT</code>),
+ * the function provided by <code>CrDaShm.h</code> is used instead.
+ * If the replay transport is selected (see <code>#CR_DA_REPLAY</code>), the function
+ * provided by <code>CrDaReplay.h</code> is used instead.
+ * If the I/O thread is selected (see <code>#CR_DA_IO_THREAD</code>), the function
+ * provided by <code>CrDaIoThread.h</code> is used instead.
+ * If the OutStream backlog is selected (see <code>#CR_DA_OUT_BACKLOG</code>), the function
+ * provided by <code>CrDaOutBacklog.h</code> is used and it hands the packets over to the
+ * function of the selected transport.
  */
+#if (CR_DA_OUT_BACKLOG == 1)
+#define CR_FW_OUTSTREAM_PCKTHANDOVER {&CrDaOutBacklogPcktHandover,&CrDaOutBacklogPcktHandover}
+#elif (CR_DA_SHM_TRANSPORT == 1)
+#define CR_FW_OUTSTREAM_PCKTHANDOVER {&CrDaShmPcktHandover,&CrDaShmPcktHandover}
+#elif (CR_DA_IO_THREAD == 1)
+#define CR_FW_OUTSTREAM_PCKTHANDOVER {&CrDaIoThreadPcktHandover,&CrDaIoThreadPcktHandover}
+#elif (CR_DA_REPLAY == 1)
+#define CR_FW_OUTSTREAM_PCKTHANDOVER {&CrDaReplayPcktHandover,&CrDaReplayPcktHandover}
+#else
 #define CR_FW_OUTSTREAM_PCKTHANDOVER {&CrDaServerSocketPcktHandover,&CrDaServerSocketPcktHandover}
+#endif
 
 /**
  * The functions implementing the Initialization Check of the OutStream components.
@@ -113,8 +149,18 @@
  *
  * The Initialization Check function defined in this file is the one provided
  * by the socket-based interface of <code>CrDaServerSocket.h</code>.
+ * If the shared-memory transport is selected (see <code>#CR_DA_SHM_TRANSPORT</code>),
+ * the function provided by <code>CrDaShm.h</code> is used instead.
+ * If the replay transport is selected (see <code>#CR_DA_REPLAY</code>), the default
+ * initialization check is used instead.
  */
+#if (CR_DA_SHM_TRANSPORT == 1)
+#define CR_FW_OUTSTREAM_INITCHECK {&CrDaShmInitCheck,&CrDaShmInitCheck}
+#elif (CR_DA_REPLAY == 1)
+#define CR_FW_OUTSTREAM_INITCHECK {&CrFwBaseCmpDefInitCheck,&CrFwBaseCmpDefInitCheck}
+#else
 #define CR_FW_OUTSTREAM_INITCHECK {&CrDaServerSocketInitCheck,&CrDaServerSocketInitCheck}
+#endif
 
 /**
  * The functions implementing the Initialization Action of the OutStream components.
@@ -135,8 +181,18 @@
  *
  * The Initialization Action function defined in this file is the one provided
  * by the socket-based interface of <code>CrDaServerSocket.h</code>.
+ * If the shared-memory transport is selected (see <code>#CR_DA_SHM_TRANSPORT</code>),
+ * the function provided by <code>CrDaShm.h</code> is used instead.
+ * If the replay transport is selected (see <code>#CR_DA_REPLAY</code>), the function
+ * provided by <code>CrDaReplay.h</code> is used instead.
  */
+#if (CR_DA_SHM_TRANSPORT == 1)
+#define CR_FW_OUTSTREAM_INITACTION {&CrDaShmInitAction,&CrDaShmInitAction}
+#elif (CR_DA_REPLAY == 1)
+#define CR_FW_OUTSTREAM_INITACTION {&CrDaReplayInitAction,&CrDaReplayInitAction}
+#else
 #define CR_FW_OUTSTREAM_INITACTION {&CrDaServerSocketInitAction,&CrDaServerSocketInitAction}
+#endif
 
 /**
  * The functions implementing the Configuration Check of the OutStream components.
@@ -191,7 +247,17 @@
  *
  * The Shutdown Action function defined in this file is the one provided
  * by the socket-based interface of <code>CrDaServerSocket.h</code>.
+ * If the shared-memory transport is selected (see <code>#CR_DA_SHM_TRANSPORT</code>),
+ * the function provided by <code>CrDaShm.h</code> is used instead.
+ * If the replay transport is selected (see <code>#CR_DA_REPLAY</code>), the function
+ * provided by <code>CrDaReplay.h</code> is used instead.
  */
+#if (CR_DA_SHM_TRANSPORT == 1)
+#define CR_FW_OUTSTREAM_SHUTDOWNACTION {&CrDaShmShutdownAction,&CrDaShmShutdownAction}
+#elif (CR_DA_REPLAY == 1)
+#define CR_FW_OUTSTREAM_SHUTDOWNACTION {&CrDaReplayShutdownAction,&CrDaReplayShutdownAction}
+#else
 #define CR_FW_OUTSTREAM_SHUTDOWNACTION {&CrDaServerSocketShutdownAction,&CrDaServerSocketShutdownAction}
+#endif
 
 #endif /* CR_FW_OUTSTREAM_USERPAR_H_ */
@@ -11,19 +11,94 @@
  * Application will therefore normally replace this file with their own file
  * providing their application-specific implementation.
  *
- * This implementation pre-allocates the memory for a predefined number of packets
- * of fixed size.
+ * This implementation pre-allocates the memory for a predefined number of packets.
+ * The packets are organized in three size classes (small, medium and large).
+ * Each class has its own slot size and number of packets (see
+ * <code>#CR_FW_SMALL_PCKT_LENGTH</code> and <code>#CR_FW_NOF_SMALL_PCKTS</code>
+ * and the analogous constants for the other classes).
+ * A packet request is served from the smallest class whose slot size is large enough
+ * for the requested length and which still has free packets.
  * Packets can be either "in use" or "not in use".
  * A packet is in use if it has been requested through a call to <code>::CrFwPcktMake</code>
  * and has not yet been released through a call to <code>::CrFwPcktRelease</code>.
  *
+ * Packets in use are reference-counted (see <code>CrFwPcktRefCnt.h</code>).
+ * A packet is created with a reference count of 1.
+ * Each call to <code>::CrFwPcktRetain</code> increments its reference count and each
+ * call to <code>::CrFwPcktRelease</code> decrements it.
+ * The packet is returned to the pool when its reference count drops to zero.
+ * This allows one packet to be held by several users (e.g. several OutStreams)
+ * without being copied.
+ *
+ * The packet pool is partitioned (see <code>CrFwPcktPart.h</code>).
+ * Each InStream and each OutStream has a reserved quota of packets and the remaining
+ * packets form a shared overflow region.
+ * Each packet in use is charged to one partition and records whether it was taken
+ * from the reserved quota of its partition or from the shared overflow region.
+ *
+ * The packets which are not in use are linked together in a <i>free list</i>.
+ * The free list is intrusive: the link to the next free packet is stored in the
+ * first bytes of the free packet itself.
+ * The link is stored as the distance from the next packet in index order.
+ * A link of zero therefore points to the next packet and the zero-initialized
+ * packet array already forms a valid free list without any initialization step.
+ * Each size class has its own free list.
+ * Packet allocation pops the head of a free list and packet release pushes the
+ * released packet back onto the free list of its class.
+ * The class and the index of a packet are computed from its address.
+ * Hence, the make, release and availability check operations all execute in constant
+ * time, independently of the value of <code>#CR_FW_MAX_NOF_PCKTS</code>.
+ *
+ * The slot of each packet is rounded up to a multiple of <code>#CR_FW_PCKT_SLOT_ALIGN</code>
+ * bytes and the packet array is aligned to the same boundary.
+ * The packet array is either a static array or an arena which is mapped at startup
+ * (see <code>CrFwPcktArena.h</code>).
+ *
+ * The make and release operations also collect the usage statistics of the packet
+ * pool defined in <code>CrFwPcktStats.h</code>.
+ *
  * The implementation provided in this file uses global data structures to hold
  * the pool of pre-allocated packets.
+ * By default, these data structures are not protected against concurrent access.
+ * If <code>#CR_FW_PCKT_LOCK_FREE</code> is set to 1, a lock-free variant of the pool
+ * is built instead which allows several threads to make and release packets
+ * concurrently.
+ * In this variant, the head of each free list is a 32-bit word holding the index
+ * of the first free packet in its lower half and a modification tag in its upper half.
+ * The head is updated through compare-and-swap operations (Treiber stack) and the tag
+ * is incremented at every update to protect the list against the ABA problem.
+ * The reference counts are updated through atomic operations and the statistics counters
+ * are kept in per-thread shards (see <code>CrDaStatShard.h</code>).
+ * The other functions in this file are not affected by the selection of the variant.
+ * The lock-free variant relies on the <code>__atomic</code> built-ins of the GCC compiler.
  *
  * A packet encapsulates a command or a report and it holds all the attributes of the
  * command or report.
- * The layout of a packet is defined by the value of the <code>offsetYyy</code> constants
- * which defines the offset within a packet at which attribute "Yyy" is stored.
+ * The layout of a packet is defined by a table of the header fields in
+ * <code>CrFwPcktLayout.h</code> which gives the offset, width and bit position of each
+ * field and from which the accessors of the fields are generated at compile time.
+ * The accessors for the packet attributes are implemented as inline functions in
+ * <code>CrFwPcktInline.h</code> on top of the generated accessors: the accessors in this
+ * file are thin wrappers around them.
+ * Two layouts are supported and are selected through <code>#CR_FW_PCKT_COMPACT_LAYOUT</code>:
+ * - In the standard layout, each attribute is stored in its own 4-byte word and the
+ *   parameter area starts at byte 60.
+ * - In the compact layout, each attribute is stored in a field which is as large as its
+ *   type, the packet type and the four acknowledge levels are stored as bits in one flag
+ *   byte, and the parameter area starts at byte 20.
+ * .
+ * In both layouts, the packet length is stored as a <code>CrFwPcktLength_t</code> in the
+ * first two bytes of the packet.
+ * Packets can therefore be up to <code>#CR_FW_PCKT_LENGTH_MAX</code> bytes long.
+ * In both layouts, the multi-byte attributes are aligned to their size, provided that the
+ * packet itself starts on a 4-byte boundary.
+ * The multi-byte attributes are stored in the byte order which is selected through
+ * <code>#CR_FW_PCKT_NET_ORDER</code> (the byte order of the host or network byte order,
+ * see <code>CrFwPcktWire.h</code>).
+ * The sizes of the fields in the compact layout assume the sizes of the types defined in
+ * <code>CrFwUserConstants.h</code> for the CORDET Demo.
+ * A mission-specific layout can be supplied instead (see <code>CrFwPcktLayout.h</code>).
+ * Applications which exchange packets must use the same layout.
  *
  * The setter functions for the packet attributes assume that the packet length is
  * adequate to hold the attributes.
@@ -43,331 +118,1118 @@
  * For information on alternative licensing, please contact P&P Software GmbH.
  */
 
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE	/* for MAP_HUGETLB */
+#endif
+
 #include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include <sys/mman.h>
+/* The out-of-line accessors are defined in this file */
+#define CR_FW_PCKT_INLINE_IMPL
 #include "CrFwConstants.h"
 #include "UtilityFunctions/CrFwUtilityFunctions.h"
 #include "Pckt/CrFwPckt.h"
 #include "BaseCmp/CrFwBaseCmp.h"
+#include "CrFwTime.h"
+#include "CrFwPcktStats.h"
+#include "CrFwPcktArena.h"
+#include "CrFwPcktRefCnt.h"
+#include "CrFwPcktHeader.h"
+#include "CrFwPcktPart.h"
+#include "CrFwInStreamUserPar.h"
+#include "CrFwOutStreamUserPar.h"
+#include "CrFwPcktInline.h"
+#include "CrDaStreamMap.h"
+#include "CrDaErrQueue.h"
+#include "CrDaStatShard.h"
+#include "CrDaLatTrace.h"
+#include "CrDaConfig.h"
+
+/** The number of packet size classes (small, medium and large) */
+#define CR_FW_NOF_PCKT_CLASSES 3
+
+#if ((CR_FW_PCKT_SLOT_ALIGN & (CR_FW_PCKT_SLOT_ALIGN-1)) != 0) || (CR_FW_PCKT_SLOT_ALIGN < 4)
+#error "CR_FW_PCKT_SLOT_ALIGN must be a power of two and at least 4"
+#endif
+
+/** The stride in number of bytes of the slots of a given size (the size rounded up to the alignment) */
+#define CR_FW_PCKT_STRIDE(length) ((((length)+CR_FW_PCKT_SLOT_ALIGN-1)/CR_FW_PCKT_SLOT_ALIGN)*CR_FW_PCKT_SLOT_ALIGN)
+
+/** The size in number of bytes of the slab holding the small packets */
+#define CR_FW_SMALL_SLAB_SIZE (CR_FW_NOF_SMALL_PCKTS*CR_FW_PCKT_STRIDE(CR_FW_SMALL_PCKT_LENGTH))
+
+/** The size in number of bytes of the slab holding the medium packets */
+#define CR_FW_MEDIUM_SLAB_SIZE (CR_FW_NOF_MEDIUM_PCKTS*CR_FW_PCKT_STRIDE(CR_FW_MEDIUM_PCKT_LENGTH))
+
+/** The size in number of bytes of the slab holding the large packets */
+#define CR_FW_LARGE_SLAB_SIZE (CR_FW_NOF_LARGE_PCKTS*CR_FW_PCKT_STRIDE(CR_FW_LARGE_PCKT_LENGTH))
+
+/** The size in number of bytes of the packet array */
+#define CR_FW_PCKT_ARRAY_SIZE (CR_FW_SMALL_SLAB_SIZE+CR_FW_MEDIUM_SLAB_SIZE+CR_FW_LARGE_SLAB_SIZE)
+
+/** The size in number of bytes of the pages which are touched to prefault the packet array */
+#define CR_FW_PCKT_ARENA_PAGE_SIZE 4096
+
+#if (CR_FW_PCKT_LOCK_FREE == 1)
+/** Type for the head of a free list in the lock-free variant (tag and index). */
+typedef unsigned int CrFwPcktFreeListHead_t;
+
+/** Mask for the packet index in the head of a free list */
+#define CR_FW_FREE_LIST_INDEX_MASK 0xFFFFu
+
+/** Increment of the modification tag in the head of a free list */
+#define CR_FW_FREE_LIST_TAG_INC 0x10000u
+#else
+/** Type for the head of a free list (the index of the first free packet). */
+typedef CrFwCounterU2_t CrFwPcktFreeListHead_t;
+#endif
+
+#if (CR_FW_PCKT_LOCK_FREE == 1)
+/** The number of shards of the usage statistics (one per thread which accesses the pool, see <code>CrDaStatShard.h</code>) */
+#define CR_FW_PCKT_STATS_N_OF_SHARDS CR_DA_STAT_N_OF_SHARDS
+#else
+/** The number of shards of the usage statistics (the pool is accessed by one thread) */
+#define CR_FW_PCKT_STATS_N_OF_SHARDS 1
+#endif
 
 /**
- * Maximum length of a packet expressed in number of bytes (see <code>CrFwPacket.h</code>).
- * The value of this constant must be smaller than the range of the <code>::CrFwPcktLength_t</code>
- * integer type.
+ * The usage statistics counters of the packet pool which are updated by one thread.
+ * The number of allocated packets is the number of makes minus the number of releases.
  */
-#define CR_FW_MAX_PACKET_LENGTH 100
+typedef struct {
+	/** The number of successful packet allocations. */
+	unsigned int nOfMake;
+	/** The number of successful packet releases. */
+	unsigned int nOfRelease;
+	/** The number of failed packet allocations broken down by requested length. */
+	unsigned int nOfMakeFail[CR_FW_PCKT_STATS_NOF_FAIL_BINS];
+	/** The histogram of the lifetime in cycles of the released packets. */
+	unsigned int lifetime[CR_FW_PCKT_STATS_NOF_LIFETIME_BINS];
+} __attribute__((aligned(CR_DA_STAT_CACHE_LINE))) CrFwPcktStatsShard_t;
 
-/** The maximum size in number of bytes of a packet */
-#define CR_FW_MAX_PCKT_LENGTH 100
+/**
+ * Descriptor of a packet size class.
+ * All packets in a size class have the same slot size and are stored contiguously
+ * in one slab of the packet array, one packet every stride.
+ */
+typedef struct {
+	/** The slot size in number of bytes of the packets in the class. */
+	CrFwPcktLength_t slotLength;
+	/** The stride in number of bytes of the packets in the class. */
+	CrFwPcktLength_t slotStride;
+	/** The number of packets in the class. */
+	CrFwCounterU2_t nOfPckts;
+	/** The offset in the packet array of the slab holding the packets of the class. */
+	unsigned int slabOffset;
+	/** The index in the reference count array of the first packet of the class. */
+	CrFwCounterU2_t firstIndex;
+	/**
+	 * The index (relative to the class) of the first packet in the free list of the class.
+	 * A value equal to <code>nOfPckts</code> indicates that the free list is empty.
+	 * In the lock-free variant of the pool, the index is held in the lower 16 bits and
+	 * the modification tag in the upper 16 bits.
+	 */
+	CrFwPcktFreeListHead_t freeListHead;
+} CrFwPcktClass_t;
+
+#if (CR_FW_PCKT_ARENA == 1)
+/** The static array which holds the packets if the arena cannot be mapped. */
+static char pcktStore[CR_FW_PCKT_ARRAY_SIZE] __attribute__((aligned(CR_FW_PCKT_SLOT_ALIGN)));
 
+/**
+ * The array holding the packets (the arena or the static array).
+ * The array is split into three slabs holding, in this order, the small, the medium
+ * and the large packets.
+ * Within each slab, packets are stored in blocks of the stride of their class.
+ */
+static char* pcktArray = pcktStore;
+#else
 /**
  * The array holding the packets.
- * Packets are stored in this array in blocks of size CR_FW_MAX_PCKT_LENGTH.
+ * The array is split into three slabs holding, in this order, the small, the medium
+ * and the large packets.
+ * Within each slab, packets are stored in blocks of the stride of their class.
+ */
+static char pcktArray[CR_FW_PCKT_ARRAY_SIZE] __attribute__((aligned(CR_FW_PCKT_SLOT_ALIGN)));
+#endif
+
+/** The memory which backs the packet array. */
+static CrFwPcktArenaBacking_t pcktArenaBacking = crFwPcktArenaStatic;
+
+/**
+ * The array holding the reference counts of the packets.
+ * A packet is in use if its reference count is greater than zero.
  */
-static char pcktArray[CR_FW_MAX_NOF_PCKTS*CR_FW_MAX_PCKT_LENGTH];
+static CrFwCounterU1_t pcktRefCnt[CR_FW_MAX_NOF_PCKTS] = {0};
+
+/** The maximum value of the reference count of a packet */
+#define CR_FW_PCKT_MAX_REF_CNT 255
+
+/** The number of partitions of the packet pool (the shared partition, the InStream and the OutStream partitions) */
+#define CR_FW_PCKT_NOF_PARTS (1+CR_FW_NOF_INSTREAM+CR_FW_NOF_OUTSTREAM)
+
+/** The compile-time reserved quotas of the InStream partitions */
+static const CrFwCounterU2_t inStreamQuotaDef[CR_FW_NOF_INSTREAM] = CR_FW_INSTREAM_PCKT_QUOTA;
+
+/** The compile-time reserved quotas of the OutStream partitions */
+static const CrFwCounterU2_t outStreamQuotaDef[CR_FW_NOF_OUTSTREAM] = CR_FW_OUTSTREAM_PCKT_QUOTA;
+
+/** The reserved quotas of the InStream partitions (see <code>::CrFwPcktArenaConfigure</code>) */
+static CrFwCounterU2_t inStreamQuota[CR_FW_NOF_INSTREAM] = CR_FW_INSTREAM_PCKT_QUOTA;
+
+/** The reserved quotas of the OutStream partitions (see <code>::CrFwPcktArenaConfigure</code>) */
+static CrFwCounterU2_t outStreamQuota[CR_FW_NOF_OUTSTREAM] = CR_FW_OUTSTREAM_PCKT_QUOTA;
+
+/** The number of packets of the pool (the runtime configuration may leave packets of the packet array unused) */
+static CrFwCounterU2_t nOfPoolPckts = CR_FW_MAX_NOF_PCKTS;
+
+/** The number of packets of each partition which are allocated from its reserved quota. */
+static CrFwCounterU2_t partNOfReserved[CR_FW_PCKT_NOF_PARTS] = {0};
+
+/** The number of packets which are allocated from the shared overflow region. */
+static CrFwCounterU2_t nOfSharedPckts = 0;
+
+/** The partition to which each allocated packet is charged. */
+static CrFwPcktPartId_t pcktPart[CR_FW_MAX_NOF_PCKTS];
+
+/** The flag indicating whether each allocated packet is taken from the shared overflow region. */
+static CrFwBool_t pcktInShared[CR_FW_MAX_NOF_PCKTS];
+
+#if (CR_FW_PCKT_LOCK_FREE == 1)
+/** The partition to which the packets created through <code>::CrFwPcktMake</code> are charged (one per thread). */
+static __thread CrFwPcktPartId_t makePart = CR_FW_PCKT_PART_SHARED;
+#else
+/** The partition to which the packets created through <code>::CrFwPcktMake</code> are charged. */
+static CrFwPcktPartId_t makePart = CR_FW_PCKT_PART_SHARED;
+#endif
 
+/** The cycle time at which each packet in use was allocated. */
+static CrFwTimeCyc_t pcktAllocCycle[CR_FW_MAX_NOF_PCKTS];
+
+/** The shards of the usage statistics counters of the packet pool. */
+static CrFwPcktStatsShard_t statsShard[CR_FW_PCKT_STATS_N_OF_SHARDS];
+
+/** The totals of the usage statistics counters when the statistics were last reset. */
+static CrFwPcktStatsShard_t statsBase;
+
+/** The largest number of packets which were allocated at the same time. */
+static CrFwCounterU2_t statsHighWaterMark = 0;
+
+#if (CR_FW_PCKT_LOCK_FREE == 1) && (CR_FW_PCKT_STATS_EXACT_HWM == 1)
 /**
- * The array holding the "in use" status of the packets.
- * A packet is in use if it has been requested through a call to the "make" function
- * and has not yet been released through a call to the "release" function.
+ * The number of packets which are allocated.
+ * The sums of the shards are not taken at one instant: the exact high-water mark is
+ * raised from this counter which is updated at each allocation and release.
  */
-static CrFwBool_t pcktInUse[CR_FW_MAX_NOF_PCKTS] = {0};
+static CrFwCounterU2_t statsNOfOutstanding = 0;
+#endif
 
-/** The number of currently allocated packets. */
-static CrFwCounterU2_t nOfAllocatedPckts = 0;
+/** The packet size classes ordered by increasing slot size. */
+static CrFwPcktClass_t pcktClass[CR_FW_NOF_PCKT_CLASSES] = {
+	{CR_FW_SMALL_PCKT_LENGTH, CR_FW_PCKT_STRIDE(CR_FW_SMALL_PCKT_LENGTH), CR_FW_NOF_SMALL_PCKTS, 0, 0, 0},
+	{CR_FW_MEDIUM_PCKT_LENGTH, CR_FW_PCKT_STRIDE(CR_FW_MEDIUM_PCKT_LENGTH), CR_FW_NOF_MEDIUM_PCKTS,
+		CR_FW_SMALL_SLAB_SIZE, CR_FW_NOF_SMALL_PCKTS, 0},
+	{CR_FW_LARGE_PCKT_LENGTH, CR_FW_PCKT_STRIDE(CR_FW_LARGE_PCKT_LENGTH), CR_FW_NOF_LARGE_PCKTS,
+		CR_FW_SMALL_SLAB_SIZE+CR_FW_MEDIUM_SLAB_SIZE, CR_FW_NOF_SMALL_PCKTS+CR_FW_NOF_MEDIUM_PCKTS, 0}
+};
 
-/** Offset of the length field in a packet */
-static const CrFwPcktLength_t offsetLength = 0;
+/** The number of packets of the slab of each size class (the largest number of packets of the class). */
+static const CrFwCounterU2_t pcktClassCapacity[CR_FW_NOF_PCKT_CLASSES] = {
+	CR_FW_NOF_SMALL_PCKTS, CR_FW_NOF_MEDIUM_PCKTS, CR_FW_NOF_LARGE_PCKTS
+};
+
+
+/**
+ * Return the start address of a packet in a size class.
+ * @param c the size class
+ * @param i the index of the packet relative to its class
+ * @return the start address of the i-th packet of the size class
+ */
+static char* pcktAddr(CrFwPcktClass_t* c, CrFwCounterU2_t i) {
+	return &pcktArray[c->slabOffset+(unsigned int)i*c->slotStride];
+}
+
+/**
+ * Return the index of the packet which follows the argument packet in the free list.
+ * @param c the size class
+ * @param i the index of the free packet relative to its class
+ * @return the index of the next free packet relative to its class
+ */
+static CrFwCounterU2_t freeListGetNext(CrFwPcktClass_t* c, CrFwCounterU2_t i) {
+	CrFwCounterU2_t* loc = (CrFwCounterU2_t*)pcktAddr(c, i);
+#if (CR_FW_PCKT_LOCK_FREE == 1)
+	/* The packet may be concurrently taken by another thread: the link is then stale
+	 * but the compare-and-swap on the head of the free list will fail */
+	return (CrFwCounterU2_t)(i+1+__atomic_load_n(loc, __ATOMIC_RELAXED));
+#else
+	return (CrFwCounterU2_t)(i+1+(*loc));
+#endif
+}
 
-/** Offset of the flag defining the type of packet (1 for a command, 2 for a report) */
-static const CrFwPcktLength_t offsetCmdRepType = 4;
+/**
+ * Set the index of the packet which follows the argument packet in the free list.
+ * @param c the size class
+ * @param i the index of the free packet relative to its class
+ * @param next the index of the next free packet relative to its class
+ */
+static void freeListSetNext(CrFwPcktClass_t* c, CrFwCounterU2_t i, CrFwCounterU2_t next) {
+	CrFwCounterU2_t* loc = (CrFwCounterU2_t*)pcktAddr(c, i);
+#if (CR_FW_PCKT_LOCK_FREE == 1)
+	__atomic_store_n(loc, (CrFwCounterU2_t)(next-(i+1)), __ATOMIC_RELAXED);
+#else
+	(*loc) = (CrFwCounterU2_t)(next-(i+1));
+#endif
+}
 
-/** Offset of the time stamp field in a packet */
-static const CrFwPcktLength_t offsetTimeStamp = 8;
+/**
+ * Remove the first packet from the free list of a size class.
+ * @param c the size class
+ * @param i the location where the index of the removed packet is returned
+ * @return 1 if a packet was removed; 0 if the free list was empty
+ */
+static CrFwBool_t freeListPop(CrFwPcktClass_t* c, CrFwCounterU2_t* i) {
+#if (CR_FW_PCKT_LOCK_FREE == 1)
+	CrFwPcktFreeListHead_t head, newHead;
+
+	head = __atomic_load_n(&c->freeListHead, __ATOMIC_ACQUIRE);
+	do {
+		if ((head & CR_FW_FREE_LIST_INDEX_MASK) == c->nOfPckts)
+			return 0;
+		(*i) = (CrFwCounterU2_t)(head & CR_FW_FREE_LIST_INDEX_MASK);
+		newHead = ((head & ~CR_FW_FREE_LIST_INDEX_MASK) + CR_FW_FREE_LIST_TAG_INC) | freeListGetNext(c, *i);
+	} while (!__atomic_compare_exchange_n(&c->freeListHead, &head, newHead, 1,
+	                                      __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE));
+	return 1;
+#else
+	if (c->freeListHead == c->nOfPckts)
+		return 0;
+	(*i) = c->freeListHead;
+	c->freeListHead = freeListGetNext(c, *i);
+	return 1;
+#endif
+}
 
-/** Offset of the service type field in a packet */
-static const CrFwPcktLength_t offsetServType = 12;
+/**
+ * Add a packet to the front of the free list of a size class.
+ * @param c the size class
+ * @param i the index of the packet relative to its class
+ */
+static void freeListPush(CrFwPcktClass_t* c, CrFwCounterU2_t i) {
+#if (CR_FW_PCKT_LOCK_FREE == 1)
+	CrFwPcktFreeListHead_t head, newHead;
+
+	head = __atomic_load_n(&c->freeListHead, __ATOMIC_RELAXED);
+	do {
+		freeListSetNext(c, i, (CrFwCounterU2_t)(head & CR_FW_FREE_LIST_INDEX_MASK));
+		newHead = ((head & ~CR_FW_FREE_LIST_INDEX_MASK) + CR_FW_FREE_LIST_TAG_INC) | i;
+	} while (!__atomic_compare_exchange_n(&c->freeListHead, &head, newHead, 1,
+	                                      __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+#else
+	freeListSetNext(c, i, c->freeListHead);
+	c->freeListHead = i;
+#endif
+}
 
-/** Offset of the service sub-type field in a packet */
-static const CrFwPcktLength_t offsetServSubType = 16;
+/**
+ * Check whether the free list of a size class is empty.
+ * @param c the size class
+ * @return 1 if the free list is empty; 0 otherwise
+ */
+static CrFwBool_t freeListIsEmpty(CrFwPcktClass_t* c) {
+#if (CR_FW_PCKT_LOCK_FREE == 1)
+	return ((__atomic_load_n(&c->freeListHead, __ATOMIC_RELAXED) & CR_FW_FREE_LIST_INDEX_MASK) == c->nOfPckts);
+#else
+	return (c->freeListHead == c->nOfPckts);
+#endif
+}
+
+/**
+ * Increment the reference count of a packet unless it is zero or has reached its maximum value.
+ * @param j the index of the packet in the reference count array
+ * @return 1 if the reference count was incremented; 0 otherwise
+ */
+static CrFwBool_t refCntInc(CrFwCounterU2_t j) {
+#if (CR_FW_PCKT_LOCK_FREE == 1)
+	CrFwCounterU1_t cnt = __atomic_load_n(&pcktRefCnt[j], __ATOMIC_RELAXED);
+	do {
+		if ((cnt == 0) || (cnt == CR_FW_PCKT_MAX_REF_CNT))
+			return 0;
+	} while (!__atomic_compare_exchange_n(&pcktRefCnt[j], &cnt, (CrFwCounterU1_t)(cnt+1), 1,
+	                                      __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+	return 1;
+#else
+	if ((pcktRefCnt[j] == 0) || (pcktRefCnt[j] == CR_FW_PCKT_MAX_REF_CNT))
+		return 0;
+	pcktRefCnt[j]++;
+	return 1;
+#endif
+}
+
+/**
+ * Decrement the reference count of a packet unless it is already zero.
+ * @param j the index of the packet in the reference count array
+ * @param cnt the location where the decremented reference count is returned
+ * @return 1 if the reference count was decremented; 0 if it was already zero
+ */
+static CrFwBool_t refCntDec(CrFwCounterU2_t j, CrFwCounterU1_t* cnt) {
+#if (CR_FW_PCKT_LOCK_FREE == 1)
+	CrFwCounterU1_t old = __atomic_load_n(&pcktRefCnt[j], __ATOMIC_RELAXED);
+	do {
+		if (old == 0)
+			return 0;
+	} while (!__atomic_compare_exchange_n(&pcktRefCnt[j], &old, (CrFwCounterU1_t)(old-1), 1,
+	                                      __ATOMIC_ACQ_REL, __ATOMIC_RELAXED));
+	(*cnt) = (CrFwCounterU1_t)(old-1);
+	return 1;
+#else
+	if (pcktRefCnt[j] == 0)
+		return 0;
+	pcktRefCnt[j]--;
+	(*cnt) = pcktRefCnt[j];
+	return 1;
+#endif
+}
+
+#if (CR_FW_PCKT_ARENA == 1)
+/**
+ * Map the arena which holds the packets.
+ * A packet array of at least <code>#CR_FW_PCKT_ARENA_HUGE_SIZE</code> bytes is mapped on
+ * reserved huge pages or, if none are available, on pages advised to be backed by
+ * transparent huge pages; a smaller packet array is mapped on normal pages.
+ * The mapping is zero-initialized and therefore already holds an empty pool.
+ * The static array is kept if the mapping fails.
+ */
+static void pcktArenaMap() {
+	size_t size = CR_FW_PCKT_ARRAY_SIZE;
+	CrFwPcktArenaBacking_t backing = crFwPcktArenaPages;
+	void* arena;
+
+	if (CR_FW_PCKT_ARRAY_SIZE >= CR_FW_PCKT_ARENA_HUGE_SIZE) {
+		/* A mapping on huge pages covers a whole number of huge pages */
+		size = ((size+CR_FW_PCKT_ARENA_HUGE_SIZE-1)/CR_FW_PCKT_ARENA_HUGE_SIZE)*CR_FW_PCKT_ARENA_HUGE_SIZE;
+		arena = mmap(NULL, size, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANONYMOUS|MAP_HUGETLB, -1, 0);
+		backing = crFwPcktArenaHugePages;
+		if (arena == MAP_FAILED) {
+			/* No huge pages are reserved: ask for transparent huge pages */
+			arena = mmap(NULL, size, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
+			backing = crFwPcktArenaAdvisedHugePages;
+			if ((arena != MAP_FAILED) && (madvise(arena, size, MADV_HUGEPAGE) != 0))
+				backing = crFwPcktArenaPages;
+		}
+	} else
+		arena = mmap(NULL, size, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
+
+	if (arena == MAP_FAILED)
+		return;
+	pcktArray = (char*)arena;
+	pcktArenaBacking = backing;
+}
+#endif
+
+/**
+ * Locate a packet in the packet array.
+ * @param pckt the packet
+ * @param c the location where the size class of the packet is returned
+ * @param i the location where the index of the packet relative to its class is returned
+ * @return 1 if the argument is the start address of a packet; 0 otherwise
+ */
+static CrFwBool_t pcktLocate(CrFwPckt_t pckt, CrFwPcktClass_t** c, CrFwCounterU2_t* i) {
+	CrFwCounterU1_t k;
+	ptrdiff_t offset;
+
+	offset = pckt - pcktArray;
+	if ((offset < 0) || (offset >= (ptrdiff_t)CR_FW_PCKT_ARRAY_SIZE))
+		return 0;
+
+	/* Identify the class from the slab in which the packet is located */
+	k = CR_FW_NOF_PCKT_CLASSES-1;
+	while (offset < (ptrdiff_t)pcktClass[k].slabOffset)
+		k--;
+	(*c) = &pcktClass[k];
+
+	offset = offset - (*c)->slabOffset;
+	if ((offset % (*c)->slotStride) != 0)
+		return 0;
+
+	(*i) = (CrFwCounterU2_t)(offset / (*c)->slotStride);
+	return 1;
+}
+
+/**
+ * Return the reserved quota of a partition.
+ * @param part the partition
+ * @return the reserved quota of the partition
+ */
+static CrFwCounterU2_t partGetQuota(CrFwPcktPartId_t part) {
+	if (part == CR_FW_PCKT_PART_SHARED)
+		return 0;
+	if (part <= CR_FW_NOF_INSTREAM)
+		return inStreamQuota[part-1];
+	return outStreamQuota[part-1-CR_FW_NOF_INSTREAM];
+}
+
+/**
+ * Return the size of the shared overflow region (the packets which are not covered
+ * by the reserved quotas).
+ * @return the size of the shared overflow region
+ */
+static CrFwCounterU2_t partGetSharedSize() {
+	CrFwPcktPartId_t part;
+	int size = nOfPoolPckts;
+
+	for (part=1; part<CR_FW_PCKT_NOF_PARTS; part++)
+		size = size - partGetQuota(part);
+	if (size < 0)
+		return 0;
+	return (CrFwCounterU2_t)size;
+}
+
+/**
+ * Increment a partition counter unless it has reached its maximum value.
+ * @param cnt the counter
+ * @param max the maximum value of the counter
+ * @return 1 if the counter was incremented; 0 otherwise
+ */
+static CrFwBool_t partCntInc(CrFwCounterU2_t* cnt, CrFwCounterU2_t max) {
+#if (CR_FW_PCKT_LOCK_FREE == 1)
+	CrFwCounterU2_t n = __atomic_load_n(cnt, __ATOMIC_RELAXED);
+	do {
+		if (n >= max)
+			return 0;
+	} while (!__atomic_compare_exchange_n(cnt, &n, (CrFwCounterU2_t)(n+1), 1,
+	                                      __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+	return 1;
+#else
+	if ((*cnt) >= max)
+		return 0;
+	(*cnt)++;
+	return 1;
+#endif
+}
+
+/**
+ * Decrement a partition counter.
+ * @param cnt the counter
+ */
+static void partCntDec(CrFwCounterU2_t* cnt) {
+#if (CR_FW_PCKT_LOCK_FREE == 1)
+	__atomic_sub_fetch(cnt, 1, __ATOMIC_RELAXED);
+#else
+	(*cnt)--;
+#endif
+}
+
+/**
+ * Charge a new packet to a partition.
+ * The packet is taken from the reserved quota of the partition if this is not
+ * exhausted and from the shared overflow region otherwise.
+ * @param part the partition
+ * @param inShared the location where the flag is returned which indicates whether
+ * the packet was taken from the shared overflow region
+ * @return 1 if the packet could be charged to the partition; 0 otherwise
+ */
+static CrFwBool_t partAcquire(CrFwPcktPartId_t part, CrFwBool_t* inShared) {
+	if (partCntInc(&partNOfReserved[part], partGetQuota(part))) {
+		(*inShared) = 0;
+		return 1;
+	}
+	if (partCntInc(&nOfSharedPckts, partGetSharedSize())) {
+		(*inShared) = 1;
+		return 1;
+	}
+	return 0;
+}
 
-/** Offset of the destination field in a packet */
-static const CrFwPcktLength_t offsetDest = 20;
+/**
+ * Check whether a new packet can be charged to a partition.
+ * @param part the partition
+ * @return 1 if a new packet can be charged to the partition; 0 otherwise
+ */
+static CrFwBool_t partIsAvail(CrFwPcktPartId_t part) {
+#if (CR_FW_PCKT_LOCK_FREE == 1)
+	if (__atomic_load_n(&partNOfReserved[part], __ATOMIC_RELAXED) < partGetQuota(part))
+		return 1;
+	return (__atomic_load_n(&nOfSharedPckts, __ATOMIC_RELAXED) < partGetSharedSize());
+#else
+	if (partNOfReserved[part] < partGetQuota(part))
+		return 1;
+	return (nOfSharedPckts < partGetSharedSize());
+#endif
+}
 
-/** Offset of the source field in a packet */
-static const CrFwPcktLength_t offsetSrc = 24;
+/**
+ * Return a packet to its partition.
+ * @param part the partition
+ * @param inShared the flag indicating whether the packet was taken from the shared
+ * overflow region
+ */
+static void partRelease(CrFwPcktPartId_t part, CrFwBool_t inShared) {
+	if (inShared)
+		partCntDec(&nOfSharedPckts);
+	else
+		partCntDec(&partNOfReserved[part]);
+}
 
-/** Offset of the discriminant field in a packet */
-static const CrFwPcktLength_t offsetDiscriminant = 28;
+/**
+ * Return the shard of the usage statistics counters of the calling thread.
+ * @return the shard
+ */
+static CrFwPcktStatsShard_t* statsShardOf() {
+#if (CR_FW_PCKT_LOCK_FREE == 1)
+	return &statsShard[CrDaStatShardId()];
+#else
+	return &statsShard[0];
+#endif
+}
 
-/** Offset of the sequence counter field in a packet */
-static const CrFwPcktLength_t offsetSeqCnt = 32;
+/**
+ * Increment a statistics counter.
+ * @param cnt the counter
+ */
+static void statsInc(unsigned int* cnt) {
+#if (CR_FW_PCKT_LOCK_FREE == 1)
+	__atomic_add_fetch(cnt, 1, __ATOMIC_RELAXED);
+#else
+	(*cnt)++;
+#endif
+}
 
-/** Offset of the command or report identifier in a packet */
-static const CrFwPcktLength_t offsetCmdRepId = 36;
+/**
+ * Return the sum of a statistics counter over the shards.
+ * @param cnt the counter in the first shard
+ * @return the sum of the counter
+ */
+static unsigned int statsSumOf(const unsigned int* cnt) {
+	unsigned int sum = 0;
+	unsigned int k;
+
+	/* The same counter of the next shard is one shard further */
+	for (k=0; k<CR_FW_PCKT_STATS_N_OF_SHARDS; k++)
+#if (CR_FW_PCKT_LOCK_FREE == 1)
+		sum += __atomic_load_n((const unsigned int*)((const char*)cnt + k*sizeof(CrFwPcktStatsShard_t)),
+		                       __ATOMIC_RELAXED);
+#else
+		sum += *(const unsigned int*)((const char*)cnt + k*sizeof(CrFwPcktStatsShard_t));
+#endif
+	return sum;
+}
 
-/** Offset of the acceptance acknowledge level field in a packet */
-static const CrFwPcktLength_t offsetAcceptAckLev = 40;
+/**
+ * Sum the usage statistics counters over the shards.
+ * @param total the location where the sums are returned
+ */
+static void statsSum(CrFwPcktStatsShard_t* total) {
+	CrFwCounterU1_t k;
+
+	total->nOfMake = statsSumOf(&statsShard[0].nOfMake);
+	total->nOfRelease = statsSumOf(&statsShard[0].nOfRelease);
+	for (k=0; k<CR_FW_PCKT_STATS_NOF_FAIL_BINS; k++)
+		total->nOfMakeFail[k] = statsSumOf(&statsShard[0].nOfMakeFail[k]);
+	for (k=0; k<CR_FW_PCKT_STATS_NOF_LIFETIME_BINS; k++)
+		total->lifetime[k] = statsSumOf(&statsShard[0].lifetime[k]);
+}
 
-/** Offset of the start acknowledge level field in a packet */
-static const CrFwPcktLength_t offsetStartAckLev = 44;
+/**
+ * Return the number of allocated packets from the sums of the usage statistics counters.
+ * A packet which is made by one thread may be released by another: in a sum which is
+ * taken while they run, the release may be counted before the make.
+ * @param total the sums of the counters
+ * @return the number of allocated packets
+ */
+static CrFwCounterU2_t statsNOfAllocated(const CrFwPcktStatsShard_t* total) {
+	int n = (int)(total->nOfMake - total->nOfRelease);
 
-/** Offset of the progress acknowledge level field in a packet */
-static const CrFwPcktLength_t offsetProgressAckLev = 48;
+	return (n < 0) ? 0 : (CrFwCounterU2_t)n;
+}
 
-/** Offset of the termination acknowledge level field in a packet */
-static const CrFwPcktLength_t offsetTermAckLev = 52;
+/**
+ * Raise the high-water mark of the number of allocated packets.
+ * @param n the number of allocated packets
+ */
+static void statsUpdateHighWaterMark(CrFwCounterU2_t n) {
+#if (CR_FW_PCKT_LOCK_FREE == 1)
+	CrFwCounterU2_t hwm = __atomic_load_n(&statsHighWaterMark, __ATOMIC_RELAXED);
+	while ((n > hwm) && !__atomic_compare_exchange_n(&statsHighWaterMark, &hwm, n, 1,
+	        __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+#else
+	if (n > statsHighWaterMark)
+		statsHighWaterMark = n;
+#endif
+}
 
-/** Offset of the group in a packet */
-static const CrFwPcktLength_t offsetGroup = 56;
+/**
+ * Update the statistics after a successful packet allocation.
+ * @param j the index of the packet in the reference count array
+ */
+static void statsUpdateMake(CrFwCounterU2_t j) {
+	CrFwPcktStatsShard_t* shard = statsShardOf();
+
+	statsInc(&shard->nOfMake);
+#if (CR_FW_PCKT_LOCK_FREE == 0)
+	/* With one thread, the high-water mark is raised at each allocation */
+	statsUpdateHighWaterMark(statsNOfAllocated(shard));
+#elif (CR_FW_PCKT_STATS_EXACT_HWM == 1)
+	statsUpdateHighWaterMark(__atomic_add_fetch(&statsNOfOutstanding, 1, __ATOMIC_RELAXED));
+#endif
+	pcktAllocCycle[j] = CrFwGetCurrentCycTime();
+}
 
-/** Offset of the parameter area in a packet */
-static const CrFwPcktLength_t offsetPar = 60;
+/**
+ * Update the statistics after a successful packet release.
+ * @param j the index of the packet in the reference count array
+ */
+static void statsUpdateRelease(CrFwCounterU2_t j) {
+	CrFwTimeCyc_t lifetime = CrFwGetCurrentCycTime() - pcktAllocCycle[j];
+	CrFwPcktStatsShard_t* shard = statsShardOf();
+	CrFwCounterU1_t bin = 0;
+
+	statsInc(&shard->nOfRelease);
+#if (CR_FW_PCKT_LOCK_FREE == 1) && (CR_FW_PCKT_STATS_EXACT_HWM == 1)
+	__atomic_sub_fetch(&statsNOfOutstanding, 1, __ATOMIC_RELAXED);
+#endif
+	while ((lifetime > 0) && (bin < CR_FW_PCKT_STATS_NOF_LIFETIME_BINS-1)) {
+		lifetime = lifetime >> 1;
+		bin++;
+	}
+	statsInc(&shard->lifetime[bin]);
+}
 
 /*-----------------------------------------------------------------------------------------*/
 CrFwPckt_t CrFwPcktMake(CrFwPcktLength_t pcktLength) {
+#if (CR_DA_LAT_TRACE == 1)
+	/* The packets which are made (and not received) carry the latency trace trailer */
+	CrFwPckt_t pckt = CrFwPcktMakeInPart(makePart, (CrFwPcktLength_t)(pcktLength + CR_DA_LAT_TRACE_LENGTH));
+
+	if (pckt != NULL)
+		CrDaLatTraceInit(pckt);
+	return pckt;
+#else
+	return CrFwPcktMakeInPart(makePart, pcktLength);
+#endif
+}
+
+/*-----------------------------------------------------------------------------------------*/
+CrFwPckt_t CrFwPcktMakeInPart(CrFwPcktPartId_t part, CrFwPcktLength_t pcktLength) {
+	CrFwCounterU1_t k;
 	CrFwCounterU2_t i;
+	CrFwPcktClass_t* c;
+	CrFwBool_t inShared;
 
-	if (pcktLength > CR_FW_MAX_PCKT_LENGTH) {
-		CrFwSetAppErrCode(crPcktAllocationFail);
+	if (pcktLength > CR_FW_LARGE_PCKT_LENGTH) {
+		statsInc(&statsShardOf()->nOfMakeFail[CR_FW_PCKT_STATS_NOF_FAIL_BINS-1]);
+		CrDaErrQueueSetAppErrCode(crPcktAllocationFail);
 		return NULL;
 	}
 
 	if (pcktLength < 1) {
-		CrFwSetAppErrCode(crPcktAllocationFail);
+		statsInc(&statsShardOf()->nOfMakeFail[CR_FW_PCKT_STATS_NOF_FAIL_BINS-1]);
+		CrDaErrQueueSetAppErrCode(crPcktAllocationFail);
 		return NULL;
 	}
 
-	for (i=0; i<CR_FW_MAX_NOF_PCKTS; i++) {
-		if (pcktInUse[i] == 0) {
-			pcktInUse[i] = 1;
-			pcktArray[i*CR_FW_MAX_PCKT_LENGTH] = (char)pcktLength;
-			nOfAllocatedPckts++;
-			return (&pcktArray[i*CR_FW_MAX_PCKT_LENGTH]);
+	if (part >= CR_FW_PCKT_NOF_PARTS)
+		part = CR_FW_PCKT_PART_SHARED;
+
+	/* Charge the packet to its partition and take it from the smallest class which fits */
+	if (partAcquire(part, &inShared)) {
+		for (k=0; k<CR_FW_NOF_PCKT_CLASSES; k++) {
+			c = &pcktClass[k];
+			if ((pcktLength <= c->slotLength) && freeListPop(c, &i)) {
+#if (CR_FW_PCKT_LOCK_FREE == 1)
+				__atomic_store_n(&pcktRefCnt[c->firstIndex+i], 1, __ATOMIC_RELAXED);
+#else
+				pcktRefCnt[c->firstIndex+i] = 1;
+#endif
+				pcktPart[c->firstIndex+i] = part;
+				pcktInShared[c->firstIndex+i] = inShared;
+				CrFwPcktInlSetLength(pcktAddr(c, i), pcktLength);
+				statsUpdateMake((CrFwCounterU2_t)(c->firstIndex+i));
+				return pcktAddr(c, i);
+			}
 		}
+		partRelease(part, inShared);
 	}
 
-	CrFwSetAppErrCode(crPcktAllocationFail);
+	/* Record the failure against the smallest class which fits the requested length */
+	for (k=0; k<CR_FW_NOF_PCKT_CLASSES-1; k++)
+		if (pcktLength <= pcktClass[k].slotLength)
+			break;
+	statsInc(&statsShardOf()->nOfMakeFail[k]);
+	CrDaErrQueueSetAppErrCode(crPcktAllocationFail);
 	return NULL;
 }
 
 /*-----------------------------------------------------------------------------------------*/
 void CrFwPcktRelease(CrFwPckt_t pckt) {
 	CrFwCounterU2_t i;
+	CrFwCounterU1_t cnt;
+	CrFwPcktClass_t* c;
 
-	for (i=0; i<CR_FW_MAX_NOF_PCKTS; i++) {
-		if (pckt == &pcktArray[i*CR_FW_MAX_PCKT_LENGTH]) {
-			if (pcktInUse[i] == 0) {
-				CrFwSetAppErrCode(crPcktRelErr);
-			} else {
-				nOfAllocatedPckts--;
-				pcktInUse[i] = 0;
-			}
-			return;
-		}
+	if (!pcktLocate(pckt, &c, &i)) {
+		CrDaErrQueueSetAppErrCode(crPcktRelErr);
+		return;
 	}
 
-	CrFwSetAppErrCode(crPcktRelErr);
+	if (!refCntDec((CrFwCounterU2_t)(c->firstIndex+i), &cnt)) {
+		CrDaErrQueueSetAppErrCode(crPcktRelErr);
+		return;
+	}
+
+	if (cnt > 0)	/* the packet is still held by other users */
+		return;
+
+	statsUpdateRelease((CrFwCounterU2_t)(c->firstIndex+i));
+	partRelease(pcktPart[c->firstIndex+i], pcktInShared[c->firstIndex+i]);
+	freeListPush(c, i);
 	return;
 }
 
 /*-----------------------------------------------------------------------------------------*/
-CrFwBool_t CrFwPcktIsAvail(CrFwPcktLength_t pcktLength) {
+void CrFwPcktRetain(CrFwPckt_t pckt) {
 	CrFwCounterU2_t i;
+	CrFwPcktClass_t* c;
 
-	if (pcktLength > CR_FW_MAX_PCKT_LENGTH)
+	if (!pcktLocate(pckt, &c, &i)) {
+		CrDaErrQueueSetAppErrCode(crPcktRetainErr);
+		return;
+	}
+
+	if (!refCntInc((CrFwCounterU2_t)(c->firstIndex+i)))
+		CrDaErrQueueSetAppErrCode(crPcktRetainErr);
+}
+
+/*-----------------------------------------------------------------------------------------*/
+CrFwCounterU1_t CrFwPcktGetRefCnt(CrFwPckt_t pckt) {
+	CrFwCounterU2_t i;
+	CrFwPcktClass_t* c;
+
+	if (!pcktLocate(pckt, &c, &i))
+		return 0;
+
+#if (CR_FW_PCKT_LOCK_FREE == 1)
+	return __atomic_load_n(&pcktRefCnt[c->firstIndex+i], __ATOMIC_RELAXED);
+#else
+	return pcktRefCnt[c->firstIndex+i];
+#endif
+}
+
+/*-----------------------------------------------------------------------------------------*/
+void CrFwPcktSetMakePart(CrFwPcktPartId_t part) {
+	if (part >= CR_FW_PCKT_NOF_PARTS)
+		makePart = CR_FW_PCKT_PART_SHARED;
+	else
+		makePart = part;
+}
+
+/*-----------------------------------------------------------------------------------------*/
+CrFwPcktPartId_t CrFwPcktGetInStreamPart(CrFwDestSrc_t src) {
+	/* The i-th InStream owns partition i+1 */
+	int k = CrDaStreamMapGetInStreamIndex(src);
+
+	if (k < 0)
+		return CR_FW_PCKT_PART_SHARED;
+	return (CrFwPcktPartId_t)(k+1);
+}
+
+/*-----------------------------------------------------------------------------------------*/
+CrFwPcktPartId_t CrFwPcktGetOutStreamPart(CrFwDestSrc_t dest) {
+	/* The i-th OutStream owns partition i+1+CR_FW_NOF_INSTREAM */
+	int k = CrDaStreamMapGetOutStreamIndex(dest);
+
+	if (k < 0)
+		return CR_FW_PCKT_PART_SHARED;
+	return (CrFwPcktPartId_t)(k+1+CR_FW_NOF_INSTREAM);
+}
+
+/*-----------------------------------------------------------------------------------------*/
+CrFwBool_t CrFwPcktIsAvail(CrFwPcktLength_t pcktLength) {
+	CrFwCounterU1_t k;
+
+	if (pcktLength > CR_FW_LARGE_PCKT_LENGTH)
 		return 0;
 
 	if (pcktLength < 1)
 		return 0;
 
-	for (i=0; i<CR_FW_MAX_NOF_PCKTS; i++) {
-		if (pcktInUse[i] == 0)
+	if (!partIsAvail(makePart))
+		return 0;
+
+	for (k=0; k<CR_FW_NOF_PCKT_CLASSES; k++)
+		if ((pcktLength <= pcktClass[k].slotLength) && !freeListIsEmpty(&pcktClass[k]))
 			return 1;
-	}
 
 	return 0;
 }
 
+/*-----------------------------------------------------------------------------------------*/
+CrFwCounterU2_t CrFwPcktGetNOfAllocated() {
+	CrFwPcktStatsShard_t total;
 
+	total.nOfMake = statsSumOf(&statsShard[0].nOfMake);
+	total.nOfRelease = statsSumOf(&statsShard[0].nOfRelease);
+	return statsNOfAllocated(&total);
+}
 
 /*-----------------------------------------------------------------------------------------*/
-CrFwCounterU2_t CrFwPcktGetNOfAllocated() {
-	return nOfAllocatedPckts;
+void CrFwPcktGetStats(CrFwPcktStats_t* stats) {
+	CrFwPcktStatsShard_t total;
+	CrFwCounterU1_t k;
+
+	statsSum(&total);
+	stats->nOfAllocated = statsNOfAllocated(&total);
+#if (CR_FW_PCKT_LOCK_FREE == 1) && (CR_FW_PCKT_STATS_EXACT_HWM == 0)
+	/* Without the shared counter, the high-water mark is raised when a snapshot is taken */
+	statsUpdateHighWaterMark(stats->nOfAllocated);
+#endif
+#if (CR_FW_PCKT_LOCK_FREE == 1)
+	stats->highWaterMark = __atomic_load_n(&statsHighWaterMark, __ATOMIC_RELAXED);
+#else
+	stats->highWaterMark = statsHighWaterMark;
+#endif
+	stats->nOfMake = total.nOfMake - statsBase.nOfMake;
+	stats->nOfRelease = total.nOfRelease - statsBase.nOfRelease;
+	for (k=0; k<CR_FW_PCKT_STATS_NOF_FAIL_BINS; k++)
+		stats->nOfMakeFail[k] = total.nOfMakeFail[k] - statsBase.nOfMakeFail[k];
+	for (k=0; k<CR_FW_PCKT_STATS_NOF_LIFETIME_BINS; k++)
+		stats->lifetime[k] = total.lifetime[k] - statsBase.lifetime[k];
+}
+
+/*-----------------------------------------------------------------------------------------*/
+void CrFwPcktResetStats() {
+	/* The shards are written by their threads: the counters restart from the current totals */
+	statsSum(&statsBase);
+#if (CR_FW_PCKT_LOCK_FREE == 1) && (CR_FW_PCKT_STATS_EXACT_HWM == 1)
+	__atomic_store_n(&statsHighWaterMark, __atomic_load_n(&statsNOfOutstanding, __ATOMIC_RELAXED),
+	                 __ATOMIC_RELAXED);
+#elif (CR_FW_PCKT_LOCK_FREE == 1)
+	__atomic_store_n(&statsHighWaterMark, statsNOfAllocated(&statsBase), __ATOMIC_RELAXED);
+#else
+	statsHighWaterMark = statsNOfAllocated(&statsBase);
+#endif
+}
+
+/*-----------------------------------------------------------------------------------------*/
+CrFwPcktArenaBacking_t CrFwPcktArenaInit() {
+	volatile char* page;
+	unsigned int k;
+
+#if (CR_FW_PCKT_ARENA == 1)
+	/* The packet array can only be moved while it holds no packets */
+	if ((pcktArray == pcktStore) && (CrFwPcktGetNOfAllocated() == 0))
+		pcktArenaMap();
+#endif
+
+	/* Write each page so that its page fault is taken now and not in the receive path */
+	page = pcktArray;
+	for (k=0; k<CR_FW_PCKT_ARRAY_SIZE; k+=CR_FW_PCKT_ARENA_PAGE_SIZE)
+		page[k] = page[k];
+	return pcktArenaBacking;
+}
+
+/*-----------------------------------------------------------------------------------------*/
+CrFwBool_t CrFwPcktArenaConfigure() {
+	CrFwCounterU2_t nOfPckts[CR_FW_NOF_PCKT_CLASSES];
+	CrFwCounterU2_t inQuota[CR_FW_NOF_INSTREAM];
+	CrFwCounterU2_t outQuota[CR_FW_NOF_OUTSTREAM];
+	unsigned long v, nOfTotal = 0, nOfReserved = 0;
+	CrFwCounterU2_t i;
+	unsigned int k;
+
+	if (CrFwPcktGetNOfAllocated() != 0)
+		return 0;
+
+	for (k=0; k<CR_FW_NOF_PCKT_CLASSES; k++) {
+		v = CrDaConfigGet(crDaConfigNOfPckts, k, pcktClassCapacity[k]);
+		if (v > pcktClassCapacity[k])
+			return 0;	/* a size class cannot grow beyond its slab */
+		nOfPckts[k] = (CrFwCounterU2_t)v;
+		nOfTotal += v;
+	}
+	for (k=0; k<CR_FW_NOF_INSTREAM; k++) {
+		v = CrDaConfigGet(crDaConfigInStreamQuota, k, inStreamQuotaDef[k]);
+		inQuota[k] = (CrFwCounterU2_t)v;
+		nOfReserved += v;
+	}
+	for (k=0; k<CR_FW_NOF_OUTSTREAM; k++) {
+		v = CrDaConfigGet(crDaConfigOutStreamQuota, k, outStreamQuotaDef[k]);
+		outQuota[k] = (CrFwCounterU2_t)v;
+		nOfReserved += v;
+	}
+	if ((nOfTotal == 0) || (nOfReserved > nOfTotal))
+		return 0;
+
+	/* The free list of each class is rebuilt in index order over the packets of the class */
+	for (k=0; k<CR_FW_NOF_PCKT_CLASSES; k++) {
+		pcktClass[k].nOfPckts = nOfPckts[k];
+		for (i=0; i<nOfPckts[k]; i++)
+			freeListSetNext(&pcktClass[k], i, (CrFwCounterU2_t)(i+1));
+		pcktClass[k].freeListHead = 0;
+	}
+	memcpy(inStreamQuota, inQuota, sizeof(inStreamQuota));
+	memcpy(outStreamQuota, outQuota, sizeof(outStreamQuota));
+	nOfPoolPckts = (CrFwCounterU2_t)nOfTotal;
+	return 1;
+}
+
+/*-----------------------------------------------------------------------------------------*/
+CrFwPcktArenaBacking_t CrFwPcktArenaGetBacking() {
+	return pcktArenaBacking;
+}
+
+/*-----------------------------------------------------------------------------------------*/
+unsigned int CrFwPcktArenaGetSize() {
+	return CR_FW_PCKT_ARRAY_SIZE;
 }
 
 /*-----------------------------------------------------------------------------------------*/
 CrFwPcktLength_t CrFwPcktGetMaxLength() {
-	return CR_FW_MAX_PCKT_LENGTH;
+	return CR_FW_LARGE_PCKT_LENGTH;
 }
 
 /*-----------------------------------------------------------------------------------------*/
 CrFwPcktLength_t CrFwPcktGetLength(CrFwPckt_t pckt) {
-	return (CrFwPcktLength_t)pckt[offsetLength];
+	return CrFwPcktInlGetLength(pckt);
 }
 
 /*-----------------------------------------------------------------------------------------*/
 CrFwCmdRepType_t CrFwPcktGetCmdRepType(CrFwPckt_t pckt) {
-	CrFwBool_t* loc = (CrFwBool_t*)(pckt+offsetCmdRepType);
-	return (*loc);
+	return CrFwPcktInlGetCmdRepType(pckt);
 }
 
 /*-----------------------------------------------------------------------------------------*/
 void CrFwPcktSetCmdRepType(CrFwPckt_t pckt, CrFwCmdRepType_t type) {
-	CrFwBool_t* loc = (CrFwBool_t*)(pckt+offsetCmdRepType);
-	(*loc) = type;
+	CrFwPcktInlSetCmdRepType(pckt, type);
 }
 
 /*-----------------------------------------------------------------------------------------*/
 CrFwSeqCnt_t CrFwPcktGetSeqCnt(CrFwPckt_t pckt) {
-	CrFwSeqCnt_t* loc = (CrFwSeqCnt_t*)(pckt+offsetSeqCnt);
-	return (*loc);
+	return CrFwPcktInlGetSeqCnt(pckt);
 }
 
 /*-----------------------------------------------------------------------------------------*/
 void CrFwPcktSetSeqCnt(CrFwPckt_t pckt, CrFwSeqCnt_t seqCnt) {
-	CrFwSeqCnt_t* loc = (CrFwSeqCnt_t*)(pckt+offsetSeqCnt);
-	(*loc) = seqCnt;
+	CrFwPcktInlSetSeqCnt(pckt, seqCnt);
 }
 
 /*-----------------------------------------------------------------------------------------*/
 CrFwTimeStamp_t CrFwPcktGetTimeStamp(CrFwPckt_t pckt) {
-	CrFwTimeStamp_t* loc = (CrFwTimeStamp_t*)(pckt+offsetTimeStamp);
-	return (*loc);
+	return CrFwPcktInlGetTimeStamp(pckt);
 }
 
 /*-----------------------------------------------------------------------------------------*/
 void CrFwPcktSetTimeStamp(CrFwPckt_t pckt, CrFwTimeStamp_t timeStamp) {
-	CrFwTimeStamp_t* loc = (CrFwTimeStamp_t*)(pckt+offsetTimeStamp);
-	(*loc) = timeStamp;
+	CrFwPcktInlSetTimeStamp(pckt, timeStamp);
 }
 
 /*-----------------------------------------------------------------------------------------*/
 CrFwDiscriminant_t CrFwPcktGetDiscriminant(CrFwPckt_t pckt) {
-	CrFwDiscriminant_t* loc = (CrFwDiscriminant_t*)(pckt+offsetDiscriminant);
-	return (*loc);
+	return CrFwPcktInlGetDiscriminant(pckt);
 }
 
 /*-----------------------------------------------------------------------------------------*/
 void CrFwPcktSetDiscriminant(CrFwPckt_t pckt, CrFwDiscriminant_t discriminant) {
-	CrFwDiscriminant_t* loc = (CrFwDiscriminant_t*)(pckt+offsetDiscriminant);
-	(*loc) = discriminant;
+	CrFwPcktInlSetDiscriminant(pckt, discriminant);
 }
 
 /*-----------------------------------------------------------------------------------------*/
 void CrFwPcktSetServType(CrFwPckt_t pckt, CrFwServType_t servType) {
-	CrFwServType_t* loc = (CrFwServType_t*)(pckt+offsetServType);
-	(*loc) = servType;
+	CrFwPcktInlSetServType(pckt, servType);
 }
 
 /*-----------------------------------------------------------------------------------------*/
 CrFwServType_t CrFwPcktGetServType(CrFwPckt_t pckt) {
-	CrFwServSubType_t* loc = (CrFwServSubType_t*)(pckt+offsetServType);
-	return (*loc);
+	return CrFwPcktInlGetServType(pckt);
 }
 
 /*-----------------------------------------------------------------------------------------*/
 void CrFwPcktSetServSubType(CrFwPckt_t pckt, CrFwServSubType_t servSubType) {
-	CrFwServSubType_t* loc = (CrFwServSubType_t*)(pckt+offsetServSubType);
-	(*loc) = servSubType;
+	CrFwPcktInlSetServSubType(pckt, servSubType);
 }
 
 /*-----------------------------------------------------------------------------------------*/
 CrFwServSubType_t CrFwPcktGetServSubType(CrFwPckt_t pckt) {
-	CrFwServSubType_t* loc = (CrFwServSubType_t*)(pckt+offsetServSubType);
-	return (*loc);
+	return CrFwPcktInlGetServSubType(pckt);
 }
 
 /*-----------------------------------------------------------------------------------------*/
 void CrFwPcktSetDest(CrFwPckt_t pckt, CrFwDestSrc_t dest) {
-	CrFwDestSrc_t* loc = (CrFwDestSrc_t*)(pckt+offsetDest);
-	(*loc) = dest;
+	CrFwPcktInlSetDest(pckt, dest);
 }
 
 /*-----------------------------------------------------------------------------------------*/
 CrFwDestSrc_t CrFwPcktGetDest(CrFwPckt_t pckt) {
-	CrFwDestSrc_t* loc = (CrFwDestSrc_t*)(pckt+offsetDest);
-	return (*loc);
+	return CrFwPcktInlGetDest(pckt);
 }
 
 /*-----------------------------------------------------------------------------------------*/
 void CrFwPcktSetSrc(CrFwPckt_t pckt, CrFwDestSrc_t src) {
-	CrFwDestSrc_t* loc = (CrFwDestSrc_t*)(pckt+offsetSrc);
-	(*loc) = src;
+	CrFwPcktInlSetSrc(pckt, src);
 }
 
 /*-----------------------------------------------------------------------------------------*/
 CrFwDestSrc_t CrFwPcktGetSrc(CrFwPckt_t pckt) {
-	CrFwDestSrc_t* loc = (CrFwDestSrc_t*)(pckt+offsetSrc);
-	return (*loc);
+	return CrFwPcktInlGetSrc(pckt);
 }
 
 /*-----------------------------------------------------------------------------------------*/
 void CrFwPcktSetCmdRepId(CrFwPckt_t pckt, CrFwInstanceId_t id) {
-	CrFwInstanceId_t* loc = (CrFwInstanceId_t*)(pckt+offsetCmdRepId);
-	(*loc) = id;
+	CrFwPcktInlSetCmdRepId(pckt, id);
 }
 
 /*-----------------------------------------------------------------------------------------*/
 CrFwInstanceId_t CrFwPcktGetCmdRepId(CrFwPckt_t pckt) {
-	CrFwInstanceId_t* loc = (CrFwInstanceId_t*)(pckt+offsetCmdRepId);
-	return (*loc);
+	return CrFwPcktInlGetCmdRepId(pckt);
 }
 
 /*-----------------------------------------------------------------------------------------*/
 void CrFwPcktSetAckLevel(CrFwPckt_t pckt, CrFwBool_t accept, CrFwBool_t start,
                          CrFwBool_t progress, CrFwBool_t term) {
-	CrFwBool_t* loc = (CrFwBool_t*)(pckt+offsetAcceptAckLev);
-	(*loc) = accept;
-	loc = (CrFwBool_t*)(pckt+offsetStartAckLev);
-	(*loc) = start;
-	loc = (CrFwBool_t*)(pckt+offsetProgressAckLev);
-	(*loc) = progress;
-	loc = (CrFwBool_t*)(pckt+offsetTermAckLev);
-	(*loc) = term;
+	CrFwPcktInlSetAckLevel(pckt, accept, start, progress, term);
 }
 
 /*-----------------------------------------------------------------------------------------*/
 CrFwBool_t CrFwPcktIsAcceptAck(CrFwPckt_t pckt) {
-	CrFwBool_t* loc = (CrFwBool_t*)(pckt+offsetAcceptAckLev);
-	return (*loc);
+	return CrFwPcktInlIsAcceptAck(pckt);
 }
 
 /*-----------------------------------------------------------------------------------------*/
 CrFwBool_t CrFwPcktIsStartAck(CrFwPckt_t pckt) {
-	CrFwBool_t* loc = (CrFwBool_t*)(pckt+offsetStartAckLev);
-	return (*loc);
+	return CrFwPcktInlIsStartAck(pckt);
 }
 
 /*-----------------------------------------------------------------------------------------*/
 CrFwBool_t CrFwPcktIsProgressAck(CrFwPckt_t pckt) {
-	CrFwBool_t* loc = (CrFwBool_t*)(pckt+offsetProgressAckLev);
-	return (*loc);
+	return CrFwPcktInlIsProgressAck(pckt);
 }
 
 /*-----------------------------------------------------------------------------------------*/
 CrFwBool_t CrFwPcktIsTermAck(CrFwPckt_t pckt) {
-	CrFwBool_t* loc = (CrFwBool_t*)(pckt+offsetTermAckLev);
-	return (*loc);
+	return CrFwPcktInlIsTermAck(pckt);
 }
 
 /*-----------------------------------------------------------------------------------------*/
 char* CrFwPcktGetParStart(CrFwPckt_t pckt) {
-	return (char*)(pckt+offsetPar);
+	return CrFwPcktInlGetParStart(pckt);
 }
 
 /*-----------------------------------------------------------------------------------------*/
 CrFwPcktLength_t CrFwPcktGetParLength(CrFwPckt_t pckt) {
-	return (CrFwPcktLength_t)(CrFwPcktGetLength(pckt)-offsetPar);
+	return CrFwPcktInlGetParLength(pckt);
 }
 
 /*-----------------------------------------------------------------------------------------*/
 void CrFwPcktSetGroup(CrFwPckt_t pckt, CrFwGroup_t group) {
-	CrFwGroup_t* loc = (CrFwGroup_t*)(pckt+offsetGroup);
-	(*loc) = group;
+	CrFwPcktInlSetGroup(pckt, group);
 }
 
 /*-----------------------------------------------------------------------------------------*/
 CrFwGroup_t CrFwPcktGetGroup(CrFwPckt_t pckt) {
-	CrFwGroup_t* loc = (CrFwGroup_t*)(pckt+offsetGroup);
-	return (*loc);
+	return CrFwPcktInlGetGroup(pckt);
+}
+
+/*-----------------------------------------------------------------------------------------*/
+void CrFwPcktDecodeHeader(CrFwPckt_t pckt, CrFwPcktHeader_t* hdr) {
+	CrFwPcktInlDecodeHeader(pckt, hdr);
 }
@@ -0,0 +1,266 @@
+/**
+ * @file
+ * @ingroup crConfigDemoSlave1
+ * Inline implementation of the header accessors of the default packet
+ * implementation (see <code>CrFwPckt.c</code>).
+ * This file implements the functions which get and set the packet attributes as
+ * <code>static inline</code> functions on top of the accessors which are generated from
+ * the layout of the packet header (see <code>CrFwPcktLayout.h</code>).
+ * The out-of-line accessors declared in <code>CrFwPckt.h</code> are implemented
+ * in <code>CrFwPckt.c</code> on top of these inline functions and are therefore
+ * always available.
+ *
+ * If <code>#CR_FW_PCKT_INLINE</code> is set to 1, this file also maps the names
+ * of the out-of-line accessors to their inline implementations.
+ * Calls to the accessors in the modules which include this file are then
+ * compiled into direct loads and stores from the packet.
+ * Modules which only include <code>CrFwPckt.h</code> continue to call the
+ * out-of-line accessors.
+ * The mapping is done through function-like macros: the accessors can still
+ * be used as function pointers.
+ *
+ * The multi-byte attributes are loaded and stored through <code>CrFwPcktWire.h</code>:
+ * they are in the byte order selected by <code>#CR_FW_PCKT_NET_ORDER</code> and they
+ * need not be aligned.
+ * The packet type and the acknowledge levels are stored as bits or as words according
+ * to the widths of their fields in the layout.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRFW_PCKTINLINE_H_
+#define CRFW_PCKTINLINE_H_
+
+#include "CrFwConstants.h"
+#include "CrFwUserConstants.h"
+#include "Pckt/CrFwPckt.h"
+#include "CrFwPcktHeader.h"
+#include "CrFwPcktLayout.h"
+#include "CrDaConstants.h"
+
+/**
+ * The largest packet length which can be represented in the length field of a packet.
+ * In all layouts, the length field is a <code>CrFwPcktLength_t</code> stored at
+ * the start of the packet.
+ */
+#define CR_FW_PCKT_LENGTH_MAX 0xFFFF
+
+/** Inline implementation of <code>::CrFwPcktGetLength</code>. */
+static inline CrFwPcktLength_t CrFwPcktInlGetLength(CrFwPckt_t pckt) {
+	return CrFwPcktLayoutGetLength(pckt);
+}
+
+/**
+ * Set the length of a packet.
+ * The length of a packet is normally only set by <code>::CrFwPcktMake</code>.
+ * A length of zero is used by the socket adapters to mark an empty read buffer.
+ * @param pckt the packet
+ * @param pcktLength the packet length
+ */
+static inline void CrFwPcktInlSetLength(CrFwPckt_t pckt, CrFwPcktLength_t pcktLength) {
+	CrFwPcktLayoutSetLength(pckt, pcktLength);
+}
+
+/** Inline implementation of <code>::CrFwPcktGetCmdRepType</code>. */
+static inline CrFwCmdRepType_t CrFwPcktInlGetCmdRepType(CrFwPckt_t pckt) {
+	/* A one-bit field is set for a report */
+	if (crFwPcktWidthCmdRepType == 1)
+		return ((CrFwPcktLayoutGetCmdRepType(pckt) != 0) ? crRepType : crCmdType);
+	return (CrFwCmdRepType_t)CrFwPcktLayoutGetCmdRepType(pckt);
+}
+
+/** Inline implementation of <code>::CrFwPcktSetCmdRepType</code>. */
+static inline void CrFwPcktInlSetCmdRepType(CrFwPckt_t pckt, CrFwCmdRepType_t type) {
+	if (crFwPcktWidthCmdRepType == 1)
+		CrFwPcktLayoutSetCmdRepType(pckt, (type == crRepType));
+	else
+		CrFwPcktLayoutSetCmdRepType(pckt, type);
+}
+
+/** Inline implementation of <code>::CrFwPcktGetSeqCnt</code>. */
+static inline CrFwSeqCnt_t CrFwPcktInlGetSeqCnt(CrFwPckt_t pckt) {
+	return CrFwPcktLayoutGetSeqCnt(pckt);
+}
+
+/** Inline implementation of <code>::CrFwPcktSetSeqCnt</code>. */
+static inline void CrFwPcktInlSetSeqCnt(CrFwPckt_t pckt, CrFwSeqCnt_t seqCnt) {
+	CrFwPcktLayoutSetSeqCnt(pckt, seqCnt);
+}
+
+/** Inline implementation of <code>::CrFwPcktGetTimeStamp</code>. */
+static inline CrFwTimeStamp_t CrFwPcktInlGetTimeStamp(CrFwPckt_t pckt) {
+	return CrFwPcktLayoutGetTimeStamp(pckt);
+}
+
+/** Inline implementation of <code>::CrFwPcktSetTimeStamp</code>. */
+static inline void CrFwPcktInlSetTimeStamp(CrFwPckt_t pckt, CrFwTimeStamp_t timeStamp) {
+	CrFwPcktLayoutSetTimeStamp(pckt, timeStamp);
+}
+
+/** Inline implementation of <code>::CrFwPcktGetDiscriminant</code>. */
+static inline CrFwDiscriminant_t CrFwPcktInlGetDiscriminant(CrFwPckt_t pckt) {
+	return CrFwPcktLayoutGetDiscriminant(pckt);
+}
+
+/** Inline implementation of <code>::CrFwPcktSetDiscriminant</code>. */
+static inline void CrFwPcktInlSetDiscriminant(CrFwPckt_t pckt, CrFwDiscriminant_t discriminant) {
+	CrFwPcktLayoutSetDiscriminant(pckt, discriminant);
+}
+
+/** Inline implementation of <code>::CrFwPcktSetServType</code>. */
+static inline void CrFwPcktInlSetServType(CrFwPckt_t pckt, CrFwServType_t servType) {
+	CrFwPcktLayoutSetServType(pckt, servType);
+}
+
+/** Inline implementation of <code>::CrFwPcktGetServType</code>. */
+static inline CrFwServType_t CrFwPcktInlGetServType(CrFwPckt_t pckt) {
+	return CrFwPcktLayoutGetServType(pckt);
+}
+
+/** Inline implementation of <code>::CrFwPcktSetServSubType</code>. */
+static inline void CrFwPcktInlSetServSubType(CrFwPckt_t pckt, CrFwServSubType_t servSubType) {
+	CrFwPcktLayoutSetServSubType(pckt, servSubType);
+}
+
+/** Inline implementation of <code>::CrFwPcktGetServSubType</code>. */
+static inline CrFwServSubType_t CrFwPcktInlGetServSubType(CrFwPckt_t pckt) {
+	return CrFwPcktLayoutGetServSubType(pckt);
+}
+
+/** Inline implementation of <code>::CrFwPcktSetDest</code>. */
+static inline void CrFwPcktInlSetDest(CrFwPckt_t pckt, CrFwDestSrc_t dest) {
+	CrFwPcktLayoutSetDest(pckt, dest);
+}
+
+/** Inline implementation of <code>::CrFwPcktGetDest</code>. */
+static inline CrFwDestSrc_t CrFwPcktInlGetDest(CrFwPckt_t pckt) {
+	return CrFwPcktLayoutGetDest(pckt);
+}
+
+/** Inline implementation of <code>::CrFwPcktSetSrc</code>. */
+static inline void CrFwPcktInlSetSrc(CrFwPckt_t pckt, CrFwDestSrc_t src) {
+	CrFwPcktLayoutSetSrc(pckt, src);
+}
+
+/** Inline implementation of <code>::CrFwPcktGetSrc</code>. */
+static inline CrFwDestSrc_t CrFwPcktInlGetSrc(CrFwPckt_t pckt) {
+	return CrFwPcktLayoutGetSrc(pckt);
+}
+
+/** Inline implementation of <code>::CrFwPcktSetCmdRepId</code>. */
+static inline void CrFwPcktInlSetCmdRepId(CrFwPckt_t pckt, CrFwInstanceId_t id) {
+	CrFwPcktLayoutSetCmdRepId(pckt, id);
+}
+
+/** Inline implementation of <code>::CrFwPcktGetCmdRepId</code>. */
+static inline CrFwInstanceId_t CrFwPcktInlGetCmdRepId(CrFwPckt_t pckt) {
+	return CrFwPcktLayoutGetCmdRepId(pckt);
+}
+
+/** Inline implementation of <code>::CrFwPcktSetAckLevel</code>. */
+static inline void CrFwPcktInlSetAckLevel(CrFwPckt_t pckt, CrFwBool_t accept, CrFwBool_t start,
+                         CrFwBool_t progress, CrFwBool_t term) {
+	CrFwPcktLayoutSetAcceptAck(pckt, (accept != 0));
+	CrFwPcktLayoutSetStartAck(pckt, (start != 0));
+	CrFwPcktLayoutSetProgressAck(pckt, (progress != 0));
+	CrFwPcktLayoutSetTermAck(pckt, (term != 0));
+}
+
+/** Inline implementation of <code>::CrFwPcktIsAcceptAck</code>. */
+static inline CrFwBool_t CrFwPcktInlIsAcceptAck(CrFwPckt_t pckt) {
+	return (CrFwPcktLayoutGetAcceptAck(pckt) != 0);
+}
+
+/** Inline implementation of <code>::CrFwPcktIsStartAck</code>. */
+static inline CrFwBool_t CrFwPcktInlIsStartAck(CrFwPckt_t pckt) {
+	return (CrFwPcktLayoutGetStartAck(pckt) != 0);
+}
+
+/** Inline implementation of <code>::CrFwPcktIsProgressAck</code>. */
+static inline CrFwBool_t CrFwPcktInlIsProgressAck(CrFwPckt_t pckt) {
+	return (CrFwPcktLayoutGetProgressAck(pckt) != 0);
+}
+
+/** Inline implementation of <code>::CrFwPcktIsTermAck</code>. */
+static inline CrFwBool_t CrFwPcktInlIsTermAck(CrFwPckt_t pckt) {
+	return (CrFwPcktLayoutGetTermAck(pckt) != 0);
+}
+
+/** Inline implementation of <code>::CrFwPcktGetParStart</code>. */
+static inline char* CrFwPcktInlGetParStart(CrFwPckt_t pckt) {
+	return (char*)(pckt+crFwPcktOffsetPar);
+}
+
+/** Inline implementation of <code>::CrFwPcktGetParLength</code>. */
+static inline CrFwPcktLength_t CrFwPcktInlGetParLength(CrFwPckt_t pckt) {
+	return (CrFwPcktLength_t)(CrFwPcktInlGetLength(pckt)-crFwPcktOffsetPar-CR_DA_LAT_TRACE_LENGTH);
+}
+
+/** Inline implementation of <code>::CrFwPcktSetGroup</code>. */
+static inline void CrFwPcktInlSetGroup(CrFwPckt_t pckt, CrFwGroup_t group) {
+	CrFwPcktLayoutSetGroup(pckt, group);
+}
+
+/** Inline implementation of <code>::CrFwPcktGetGroup</code>. */
+static inline CrFwGroup_t CrFwPcktInlGetGroup(CrFwPckt_t pckt) {
+	return CrFwPcktLayoutGetGroup(pckt);
+}
+
+/** Inline implementation of <code>::CrFwPcktDecodeHeader</code>. */
+static inline void CrFwPcktInlDecodeHeader(CrFwPckt_t pckt, CrFwPcktHeader_t* hdr) {
+	hdr->length = CrFwPcktLayoutGetLength(pckt);
+	hdr->cmdRepType = CrFwPcktInlGetCmdRepType(pckt);
+	hdr->servType = CrFwPcktLayoutGetServType(pckt);
+	hdr->servSubType = CrFwPcktLayoutGetServSubType(pckt);
+	hdr->discriminant = CrFwPcktLayoutGetDiscriminant(pckt);
+	hdr->src = CrFwPcktLayoutGetSrc(pckt);
+	hdr->dest = CrFwPcktLayoutGetDest(pckt);
+	hdr->group = CrFwPcktLayoutGetGroup(pckt);
+	hdr->seqCnt = CrFwPcktLayoutGetSeqCnt(pckt);
+	hdr->cmdRepId = CrFwPcktLayoutGetCmdRepId(pckt);
+}
+
+#if (CR_FW_PCKT_INLINE == 1) && !defined(CR_FW_PCKT_INLINE_IMPL)
+#define CrFwPcktGetLength(pckt) CrFwPcktInlGetLength(pckt)
+#define CrFwPcktGetCmdRepType(pckt) CrFwPcktInlGetCmdRepType(pckt)
+#define CrFwPcktSetCmdRepType(pckt, type) CrFwPcktInlSetCmdRepType((pckt), (type))
+#define CrFwPcktGetSeqCnt(pckt) CrFwPcktInlGetSeqCnt(pckt)
+#define CrFwPcktSetSeqCnt(pckt, seqCnt) CrFwPcktInlSetSeqCnt((pckt), (seqCnt))
+#define CrFwPcktGetTimeStamp(pckt) CrFwPcktInlGetTimeStamp(pckt)
+#define CrFwPcktSetTimeStamp(pckt, timeStamp) CrFwPcktInlSetTimeStamp((pckt), (timeStamp))
+#define CrFwPcktGetDiscriminant(pckt) CrFwPcktInlGetDiscriminant(pckt)
+#define CrFwPcktSetDiscriminant(pckt, discriminant) CrFwPcktInlSetDiscriminant((pckt), (discriminant))
+#define CrFwPcktSetServType(pckt, servType) CrFwPcktInlSetServType((pckt), (servType))
+#define CrFwPcktGetServType(pckt) CrFwPcktInlGetServType(pckt)
+#define CrFwPcktSetServSubType(pckt, servSubType) CrFwPcktInlSetServSubType((pckt), (servSubType))
+#define CrFwPcktGetServSubType(pckt) CrFwPcktInlGetServSubType(pckt)
+#define CrFwPcktSetDest(pckt, dest) CrFwPcktInlSetDest((pckt), (dest))
+#define CrFwPcktGetDest(pckt) CrFwPcktInlGetDest(pckt)
+#define CrFwPcktSetSrc(pckt, src) CrFwPcktInlSetSrc((pckt), (src))
+#define CrFwPcktGetSrc(pckt) CrFwPcktInlGetSrc(pckt)
+#define CrFwPcktSetCmdRepId(pckt, id) CrFwPcktInlSetCmdRepId((pckt), (id))
+#define CrFwPcktGetCmdRepId(pckt) CrFwPcktInlGetCmdRepId(pckt)
+#define CrFwPcktSetAckLevel(pckt, accept, start, progress, term) \
+	CrFwPcktInlSetAckLevel((pckt), (accept), (start), (progress), (term))
+#define CrFwPcktIsAcceptAck(pckt) CrFwPcktInlIsAcceptAck(pckt)
+#define CrFwPcktIsStartAck(pckt) CrFwPcktInlIsStartAck(pckt)
+#define CrFwPcktIsProgressAck(pckt) CrFwPcktInlIsProgressAck(pckt)
+#define CrFwPcktIsTermAck(pckt) CrFwPcktInlIsTermAck(pckt)
+#define CrFwPcktGetParStart(pckt) CrFwPcktInlGetParStart(pckt)
+#define CrFwPcktGetParLength(pckt) CrFwPcktInlGetParLength(pckt)
+#define CrFwPcktSetGroup(pckt, group) CrFwPcktInlSetGroup((pckt), (group))
+#define CrFwPcktGetGroup(pckt) CrFwPcktInlGetGroup(pckt)
+#define CrFwPcktDecodeHeader(pckt, hdr) CrFwPcktInlDecodeHeader((pckt), (hdr))
+#endif
+
+#endif /* CRFW_PCKTINLINE_H_ */
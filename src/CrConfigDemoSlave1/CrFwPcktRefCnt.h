@@ -0,0 +1,59 @@
+/**
+ * @file
+ * @ingroup crConfigDemoSlave1
+ * Interface for the reference counting of packets of the default packet
+ * implementation (see <code>CrFwPckt.c</code>).
+ * Reference counting allows the same packet to be held by several users
+ * (e.g. a packet which is sent to several destinations through several
+ * OutStreams) without the packet having to be copied.
+ *
+ * A packet is created by <code>::CrFwPcktMake</code> with a reference count of 1.
+ * A user who wishes to keep a packet which is also held by other users calls
+ * <code>::CrFwPcktRetain</code> on it and calls <code>::CrFwPcktRelease</code>
+ * when it no longer needs it.
+ * The packet is returned to the packet pool when the last holder releases it.
+ * A packet which is held by more than one user must be treated as read-only.
+ *
+ * The reference count of a packet is an unsigned 8-bit quantity: a packet can be
+ * held by up to 255 users at the same time.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRFW_PCKTREFCNT_H_
+#define CRFW_PCKTREFCNT_H_
+
+#include "CrFwConstants.h"
+#include "CrFwUserConstants.h"
+
+/**
+ * Increment the reference count of a packet.
+ * The packet must be in use (i.e. it must have been created through
+ * <code>::CrFwPcktMake</code> and not yet been released by all its holders).
+ * If this is not the case, or if the reference count of the packet has already
+ * reached its maximum value, the function sets the application error code to
+ * <code>::crPcktRetainErr</code> and leaves the reference count unchanged.
+ * @param pckt the packet to be retained
+ */
+void CrFwPcktRetain(CrFwPckt_t pckt);
+
+/**
+ * Return the reference count of a packet.
+ * The function returns zero if the packet is not in use or if the argument
+ * is not a packet of the packet pool.
+ * @param pckt the packet
+ * @return the reference count of the packet
+ */
+CrFwCounterU1_t CrFwPcktGetRefCnt(CrFwPckt_t pckt);
+
+#endif /* CRFW_PCKTREFCNT_H_ */
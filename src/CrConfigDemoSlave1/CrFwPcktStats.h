@@ -0,0 +1,105 @@
+/**
+ * @file
+ * @ingroup crConfigDemoSlave1
+ * Interface for the usage statistics of the packet pool of the default packet
+ * implementation (see <code>CrFwPckt.c</code>).
+ * The statistics are collected by the make and release operations of the packet
+ * interface and they are intended to support the sizing of the packet pool
+ * (see <code>#CR_FW_MAX_NOF_PCKTS</code>) on the basis of the actual load of an
+ * application.
+ *
+ * The statistics consist of:
+ * - The number of currently allocated packets and its high-water mark
+ * - The total number of successful packet allocations and releases
+ * - The number of failed packet allocations broken down by requested length
+ * - A histogram of the lifetime of the released packets expressed in cycles
+ * .
+ * The number of failed allocations is broken down by size class: the i-th bin
+ * counts the failed requests for a length which fits in the i-th size class
+ * but not in the (i-1)-th size class.
+ * The last bin counts the requests for an illegal length (zero or greater than
+ * the maximum packet length).
+ *
+ * The lifetime of a packet is the number of cycles (as returned by
+ * <code>::CrFwGetCurrentCycTime</code>) between its allocation and its release.
+ * The lifetime histogram has logarithmic bins: bin 0 counts the packets released in
+ * the same cycle in which they were allocated and bin i (for i greater than zero)
+ * counts the packets with a lifetime in the range 2^(i-1) to 2^i-1.
+ * The last bin also counts all packets with a longer lifetime.
+ *
+ * All statistics are simple counters which are updated in constant time and can
+ * therefore be left enabled in operational builds.
+ * In the lock-free variant of the packet pool, each thread updates the counters of its
+ * own cache line (see <code>CrDaStatShard.h</code>) and the counters of all threads are
+ * summed when a statistics snapshot is taken.
+ * A snapshot is not guaranteed to be consistent across counters.
+ * The number of allocated packets is the number of allocations minus the number of
+ * releases.
+ * In the single-threaded variant, the high-water mark is raised at each allocation.
+ * In the lock-free variant, the allocations and releases only update the counters of
+ * their thread and the high-water mark is raised when a snapshot is taken (the demo
+ * applications take one in every cycle, see <code>::CrDaMetricsSample</code>): it is
+ * approximate as a peak which rises and falls between two snapshots is not recorded.
+ * An exact high-water mark can be selected with <code>#CR_FW_PCKT_STATS_EXACT_HWM</code>
+ * at the cost of one counter which is shared by all threads and updated by each
+ * allocation and release.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRFW_PCKTSTATS_H_
+#define CRFW_PCKTSTATS_H_
+
+#include "CrFwConstants.h"
+#include "CrFwUserConstants.h"
+
+/**
+ * The number of bins for the failed packet allocations.
+ * There is one bin for each of the three size classes and one bin for illegal lengths.
+ */
+#define CR_FW_PCKT_STATS_NOF_FAIL_BINS 4
+
+/** The number of bins of the packet lifetime histogram. */
+#define CR_FW_PCKT_STATS_NOF_LIFETIME_BINS 8
+
+/** Type for the usage statistics of the packet pool. */
+typedef struct {
+	/** The number of currently allocated packets. */
+	CrFwCounterU2_t nOfAllocated;
+	/** The largest number of packets which were allocated at the same time. */
+	CrFwCounterU2_t highWaterMark;
+	/** The total number of successful packet allocations. */
+	unsigned int nOfMake;
+	/** The total number of successful packet releases. */
+	unsigned int nOfRelease;
+	/** The number of failed packet allocations broken down by requested length. */
+	unsigned int nOfMakeFail[CR_FW_PCKT_STATS_NOF_FAIL_BINS];
+	/** The histogram of the lifetime in cycles of the released packets. */
+	unsigned int lifetime[CR_FW_PCKT_STATS_NOF_LIFETIME_BINS];
+} CrFwPcktStats_t;
+
+/**
+ * Get a snapshot of the usage statistics of the packet pool.
+ * @param stats the location where the statistics are returned
+ */
+void CrFwPcktGetStats(CrFwPcktStats_t* stats);
+
+/**
+ * Reset the usage statistics of the packet pool.
+ * All counters are cleared with the exception of the number of currently allocated
+ * packets.
+ * The high-water mark is set to the number of currently allocated packets.
+ */
+void CrFwPcktResetStats();
+
+#endif /* CRFW_PCKTSTATS_H_ */
@@ -3,7 +3,9 @@
  * @ingroup crConfigDemoSlave1
  * Implementation of the error reporting interface of <code>CrFwRepErr.h</code>
  * for the Slave Application of the CORDET Demo.
- * This implementation writes the error reports to standard output.
+ * This implementation writes the error reports to standard output or, if the binary
+ * trace is selected (see <code>#CR_DA_TRACE</code>), to the ring buffer of the trace
+ * (see <code>CrDaTrace.h</code>).
  *
  * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
  * @author Alessandro Pasetti <pasetti@pnp-software.com>
@@ -21,74 +23,129 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include "CrDaConstants.h"
+#include "CrDaTrace.h"
+#include "CrDaErrQueue.h"
+#include "CrDaInCmpPool.h"
 /* Include Framework Files */
 #include "CrFwConstants.h"
 #include "CrFwRepErr.h"
 
 /*-----------------------------------------------------------------------------------------*/
 void CrFwRepErr(CrFwRepErrCode_t errCode, CrFwTypeId_t typeId, CrFwInstanceId_t instanceId) {
+	CrDaErrQueueRepErr(errCode, typeId, instanceId);
+	/* Count the failure against the InReport pool */
+	if (errCode == crInLoaderCreFail)
+		CrDaInCmpPoolInRepCreFail();
+#if (CR_DA_TRACE == 1)
+	CrDaTraceWrite(crDaTraceRepErr, errCode, typeId, instanceId, 0, 0, 0);
+#else
 	printf("CrFwErrRep: error %d generated by component %d of type %d\n", errCode,instanceId,typeId);
+#endif
 }
 
 /*-----------------------------------------------------------------------------------------*/
 void CrFwRepErrDestSrc(CrFwRepErrCode_t errCode, CrFwTypeId_t typeId, CrFwInstanceId_t instanceId,
                        CrFwDestSrc_t destSrc) {
+	CrDaErrQueueRepErr(errCode, typeId, instanceId);
+#if (CR_DA_TRACE == 1)
+	CrDaTraceWrite(crDaTraceRepErrDestSrc, errCode, typeId, instanceId, destSrc, 0, 0);
+#else
 	printf("CrFwRepErrDestSrc: error %d generated by component %d of type %d for dest/src %d\n",
 	       errCode,instanceId,typeId,destSrc);
+#endif
 }
 
 /*-----------------------------------------------------------------------------------------*/
 void CrFwRepErrInstanceIdAndDest(CrFwRepErrCode_t errCode, CrFwTypeId_t typeId,
                                  CrFwInstanceId_t instanceId, CrFwInstanceId_t secondaryInstanceId, CrFwDestSrc_t dest) {
+	CrDaErrQueueRepErr(errCode, typeId, instanceId);
+#if (CR_DA_TRACE == 1)
+	CrDaTraceWrite(crDaTraceRepErrInstanceIdAndDest, errCode, typeId, instanceId, secondaryInstanceId, dest, 0);
+#else
 	printf("CrFwRepErrInstanceIdAndDest: error %d generated by component %d of type %d\n",errCode,instanceId,typeId);
 	printf("                             secondary sequence identifier: %d, destination: %d\n",secondaryInstanceId,dest);
+#endif
 }
 
 /*-----------------------------------------------------------------------------------------*/
 void CrFwRepErrSeqCnt(CrFwRepErrCode_t errCode, CrFwTypeId_t typeId, CrFwInstanceId_t instanceId,
                       CrFwSeqCnt_t expSeqCnt, CrFwSeqCnt_t actSeqCnt) {
+	CrDaErrQueueRepErr(errCode, typeId, instanceId);
+#if (CR_DA_TRACE == 1)
+	CrDaTraceWrite(crDaTraceRepErrSeqCnt, errCode, typeId, instanceId, expSeqCnt, actSeqCnt, 0);
+#else
 	printf("CrFwRepErrSeqCnt: error %d generated by component %d of type %d\n",errCode,instanceId,typeId);
 	printf("                  expected sequence counter: %d, actual sequence counter: %d\n",expSeqCnt,actSeqCnt);
+#endif
 }
 
 /*-----------------------------------------------------------------------------------------*/
 void CrFwRepErrGroup(CrFwRepErrCode_t errCode, CrFwTypeId_t typeId, CrFwInstanceId_t instanceId,
                      CrFwGroup_t group) {
+	CrDaErrQueueRepErr(errCode, typeId, instanceId);
+#if (CR_DA_TRACE == 1)
+	CrDaTraceWrite(crDaTraceRepErrGroup, errCode, typeId, instanceId, group, 0, 0);
+#else
 	printf("CrFwRepErrGroup: error %d generated by component %d of type %d\n",errCode,instanceId,typeId);
 	printf("                  invalid group: %d\n",group);
-
+#endif
 }
 
 /*-----------------------------------------------------------------------------------------*/
 void CrFwRepErrInstanceIdAndOutcome(CrFwRepErrCode_t errCode, CrFwTypeId_t typeId,
                                     CrFwInstanceId_t instanceId, CrFwInstanceId_t secondaryInstanceId, CrFwOutcome_t outcome) {
+	CrDaErrQueueRepErr(errCode, typeId, instanceId);
+#if (CR_DA_TRACE == 1)
+	CrDaTraceWrite(crDaTraceRepErrInstanceIdAndOutcome, errCode, typeId, instanceId, secondaryInstanceId, outcome, 0);
+#else
 	printf("CrFwRepErrInstanceIdAndOutcome: error %d generated by component %d of type %d\n",errCode,instanceId,typeId);
 	printf("                                secondary sequence identifier: %d, outcome: %d\n",secondaryInstanceId,outcome);
+#endif
 }
 
 /*-----------------------------------------------------------------------------------------*/
 void CrFwRepErrPckt(CrFwRepErrCode_t errCode, CrFwTypeId_t typeId,
                                     CrFwInstanceId_t instanceId, CrFwPckt_t pckt) {
+	CrDaErrQueueRepErr(errCode, typeId, instanceId);
+#if (CR_DA_TRACE == 1)
+	CrDaTraceWrite(crDaTraceRepErrPckt, errCode, typeId, instanceId, (unsigned char)pckt[0], (unsigned char)pckt[1], 0);
+#else
 	printf("CrFwRepErrPckt: error %d generated by component %d of type %d\n",errCode,instanceId,typeId);
 	printf("                pckt[0] : %d, pckt[1]: %d\n",pckt[0],pckt[1]);
+#endif
 }
 
 /*-----------------------------------------------------------------------------------------*/
 void CrFwRepErrRep(CrFwRepErrCode_t errCode, CrFwTypeId_t typeId,
                                     CrFwInstanceId_t instanceId, FwSmDesc_t rep) {
+	CrDaErrQueueRepErr(errCode, typeId, instanceId);
+#if (CR_DA_TRACE == 1)
+	CrDaTraceWrite(crDaTraceRepErrRep, errCode, typeId, instanceId, 0, 0, 0);
+#else
 	printf("CrFwRepErrPckt: error %d generated by component %d of type %d\n",errCode,instanceId,typeId);
+#endif
 }
 
 /*-----------------------------------------------------------------------------------------*/
 void CrFwRepErrCmd(CrFwRepErrCode_t errCode, CrFwTypeId_t typeId,
                                     CrFwInstanceId_t instanceId, FwSmDesc_t cmd) {
+	CrDaErrQueueRepErr(errCode, typeId, instanceId);
+#if (CR_DA_TRACE == 1)
+	CrDaTraceWrite(crDaTraceRepErrCmd, errCode, typeId, instanceId, 0, 0, 0);
+#else
 	printf("CrFwRepErrCmd: error %d generated by component %d of type %d\n",errCode,instanceId,typeId);
+#endif
 }
 
 /*-----------------------------------------------------------------------------------------*/
 void CrFwRepErrKind(CrFwRepErrCode_t errCode, CrFwTypeId_t typeId,
                                     CrFwInstanceId_t instanceId, CrFwServType_t  servType,
 									CrFwServSubType_t servSubType, CrFwDiscriminant_t disc) {
+	CrDaErrQueueRepErr(errCode, typeId, instanceId);
+#if (CR_DA_TRACE == 1)
+	CrDaTraceWrite(crDaTraceRepErrKind, errCode, typeId, instanceId, servType, servSubType, disc);
+#else
 	printf("CrFwRepErrKind: error %d generated by component %d of type %d\n",errCode,instanceId,typeId);
+#endif
 }
-
@@ -2,18 +2,38 @@
  * @file
  * @ingroup crConfigDemoSlave1
  *
- * Default implementation of the time interface of <code>CrFwTime.h</code>.
+ * Implementation of the time interface of <code>CrFwTime.h</code> for the demo
+ * applications.
  * The implementation of this interface is one of the adaptation points of the
  * CORDET Framework.
- * This file provides a default implementation which is primarily intended to
- * support testing.
- * It is expected that applications will provide their own implementation.
- * Application will therefore normally replace this file with their own file
- * providing their application-specific implementation.
  *
- * This implementation maintains an integer which is incremented by 1 every
- * time function <code>::CrFwGetCurrentTimeStamp</code> is called.
- * The function returns the value of this integer.
+ * This implementation is backed by the monotonic clock of the host
+ * (<code>CLOCK_MONOTONIC</code>) which is shared by all processes on the host and
+ * which therefore provides a common time base to the demo applications:
+ * - The current time (<code>::CrFwGetCurrentTime</code>) is the time of the
+ *   monotonic clock in seconds.
+ * - The time stamp of a command or report (<code>::CrFwGetCurrentTimeStamp</code>)
+ *   is the time of the monotonic clock in units of 2^<code>#CR_FW_TIME_STAMP_SHIFT</code>
+ *   nanoseconds truncated to the width of the <code>::CrFwTimeStamp_t</code> type.
+ *   With the default shift of zero, the time stamps have nanosecond resolution and they
+ *   wrap around every 4.29 seconds; each increment of the shift doubles both the
+ *   resolution and the wrap-around period.
+ * - A time stamp is converted back to a time (<code>::CrFwTimeStampToStdTime</code>)
+ *   under the assumption that it lies no more than one wrap-around period in the past.
+ * - The cycle time (<code>::CrFwGetCurrentCycTime</code>) is the number of periods
+ *   <code>#CR_DA_CYCLE_PERIOD_USEC</code> which have elapsed since the time interface
+ *   was first used.
+ * .
+ * The monotonic clock is read through <code>clock_gettime</code> which on Linux is
+ * served by the vDSO without a system call.
+ * If <code>#CR_FW_TIME_TSC</code> is set to 1 and the processor has an invariant
+ * time-stamp counter, the time is instead derived from the time-stamp counter which is
+ * calibrated against the monotonic clock when the time interface is first used.
+ * The calibration takes <code>#CR_FW_TIME_TSC_CALIB_USEC</code> microseconds.
+ *
+ * In the simulation mode (see <code>#CR_DA_SIM</code>), the time is instead the virtual
+ * clock of the simulation (<code>::CrDaSimGetTime</code>) which starts at zero and only
+ * advances when the applications pass the turn.
  *
  * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
  * @author Alessandro Pasetti <pasetti@pnp-software.com>
@@ -29,38 +49,154 @@
  */
 
 #include <stdlib.h>
+#include <time.h>
+#include <pthread.h>
 #include "CrFwConstants.h"
 #include "CrFwTime.h"
+#include "CrDaConstants.h"
+#include "CrDaSim.h"
+#if (CR_FW_TIME_TSC == 1) && (defined(__x86_64__) || defined(__i386__))
+#include <cpuid.h>
+#include <x86intrin.h>
+/** The time-stamp counter is used if it is invariant. */
+#define CR_FW_TIME_USE_TSC 1
+#else
+/** The time-stamp counter is not available. */
+#define CR_FW_TIME_USE_TSC 0
+#endif
+
+/** The number of nanoseconds in one second. */
+#define CR_FW_TIME_NSEC_PER_SEC 1000000000ULL
+
+/** The one-time initialization of the time interface. */
+static pthread_once_t timeOnce = PTHREAD_ONCE_INIT;
+
+/** The time of the monotonic clock in nanoseconds when the time interface was first used. */
+static unsigned long long timeStart = 0;
 
-/** The <code>::CrFwGetCurrentTimeStamp</code> function increments this counter and then returns its value */
-static CrFwTimeStamp_t dummyTime = 0;
+#if (CR_FW_TIME_USE_TSC == 1)
+/** Flag which is set if the time is derived from the time-stamp counter. */
+static CrFwBool_t tscValid = 0;
+
+/** The value of the time-stamp counter at the end of the calibration. */
+static unsigned long long tscBase = 0;
+
+/** The time of the monotonic clock in nanoseconds at the end of the calibration. */
+static unsigned long long tscBaseNsec = 0;
+
+/** The duration of one tick of the time-stamp counter in units of 2^-32 nanoseconds. */
+static unsigned long long tscMult = 0;
+#endif
+
+/**
+ * Initialize the time interface.
+ * The function records the start time and, if the time-stamp counter is used,
+ * calibrates it.
+ */
+static void timeInit();
+
+/**
+ * Return the time of the monotonic clock read through <code>clock_gettime</code>.
+ * @return the time in nanoseconds
+ */
+static unsigned long long timeClockNsec();
+
+/**
+ * Return the current time of the monotonic clock.
+ * @return the time in nanoseconds
+ */
+static unsigned long long timeNowNsec();
 
 /*-----------------------------------------------------------------------------------------*/
 CrFwTimeStamp_t CrFwGetCurrentTimeStamp() {
-	dummyTime++;
-	return dummyTime;
+	return (CrFwTimeStamp_t)(timeNowNsec() >> CR_FW_TIME_STAMP_SHIFT);
 }
 
 /*-----------------------------------------------------------------------------------------*/
 CrFwTime_t CrFwGetCurrentTime() {
-	return dummyTime;
+	return (CrFwTime_t)timeNowNsec() / (CrFwTime_t)CR_FW_TIME_NSEC_PER_SEC;
 }
 
 /*-----------------------------------------------------------------------------------------*/
 CrFwTimeCyc_t CrFwGetCurrentCycTime() {
-	return dummyTime;
+	unsigned long long now = timeNowNsec();
+
+	return (CrFwTimeCyc_t)((now - timeStart) / (CR_DA_CYCLE_PERIOD_USEC * 1000ULL));
 }
 
 /*-----------------------------------------------------------------------------------------*/
 CrFwTimeStamp_t CrFwStdTimeToTimeStamp(CrFwTime_t stdTime) {
-	return (CrFwTimeStamp_t) stdTime;
+	unsigned long long nsec = (unsigned long long)(stdTime * (CrFwTime_t)CR_FW_TIME_NSEC_PER_SEC);
+
+	return (CrFwTimeStamp_t)(nsec >> CR_FW_TIME_STAMP_SHIFT);
 }
 
 /*-----------------------------------------------------------------------------------------*/
 CrFwTime_t CrFwTimeStampToStdTime(CrFwTimeStamp_t timeStamp) {
-	return (CrFwTime_t) timeStamp;
+	unsigned long long now = timeNowNsec() >> CR_FW_TIME_STAMP_SHIFT;
+	CrFwTimeStamp_t age;
+
+	/* The time stamp holds the low-order bits of the time: its age is their difference
+	 * with the low-order bits of the current time (modulo the wrap-around period) */
+	age = (CrFwTimeStamp_t)((CrFwTimeStamp_t)now - timeStamp);
+	return (CrFwTime_t)((now - age) << CR_FW_TIME_STAMP_SHIFT) / (CrFwTime_t)CR_FW_TIME_NSEC_PER_SEC;
+}
+
+/*-----------------------------------------------------------------------------------------*/
+static void timeInit() {
+#if (CR_FW_TIME_USE_TSC == 1)
+	unsigned int eax, ebx, ecx, edx;
+	unsigned long long tsc0, nsec0, tsc1, nsec1;
+#endif
+
+	timeStart = timeClockNsec();
+
+#if (CR_FW_TIME_USE_TSC == 1)
+	/* The time-stamp counter is only used if it is invariant (CPUID 0x80000007, EDX bit 8) */
+	if (!__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx) || ((edx & (1U << 8)) == 0))
+		return;
+
+	/* Calibrate the time-stamp counter against the monotonic clock */
+	tsc0 = __rdtsc();
+	nsec0 = timeClockNsec();
+	do {
+		tsc1 = __rdtsc();
+		nsec1 = timeClockNsec();
+	} while (nsec1 - nsec0 < CR_FW_TIME_TSC_CALIB_USEC * 1000ULL);
+	if (tsc1 == tsc0)
+		return;
+	tscMult = (unsigned long long)(((unsigned __int128)(nsec1 - nsec0) << 32) / (tsc1 - tsc0));
+	tscBase = tsc1;
+	tscBaseNsec = nsec1;
+	tscValid = 1;
+#endif
 }
 
+/*-----------------------------------------------------------------------------------------*/
+static unsigned long long timeClockNsec() {
+	struct timespec t;
 
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return (unsigned long long)t.tv_sec * CR_FW_TIME_NSEC_PER_SEC + (unsigned long long)t.tv_nsec;
+}
 
+/*-----------------------------------------------------------------------------------------*/
+static unsigned long long timeNowNsec() {
+#if (CR_FW_TIME_USE_TSC == 1)
+	unsigned long long tsc;
+#endif
 
+#if (CR_DA_SIM == 1)
+	return CrDaSimGetTime();
+#endif
+	pthread_once(&timeOnce, &timeInit);
+#if (CR_FW_TIME_USE_TSC == 1)
+	if (tscValid) {
+		tsc = __rdtsc();
+		/* The counters of the cores may differ slightly just after the calibration */
+		if (tsc >= tscBase)
+			return tscBaseNsec + (unsigned long long)(((unsigned __int128)(tsc - tscBase) * tscMult) >> 32);
+	}
+#endif
+	return timeClockNsec();
+}
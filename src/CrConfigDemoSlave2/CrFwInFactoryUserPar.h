@@ -21,18 +21,34 @@
 #define CRMA_INFACTORY_USERPAR_H_
 
 #include "CrDaTempMonitor.h"
+#include "CrDaInCmdBatch.h"
+#include "CrDaInCmdExpress.h"
 #include "UtilityFunctions/CrFwUtilityFunctions.h"
+#include "CrFwInManagerUserPar.h"
+/**
+ * The number of InCommands or InReports which may be allocated and not yet loaded into an
+ * InManager (the InLoader loads each of them as soon as it has made it).
+ */
+#define CR_DA_INFACTORY_NOF_UNLOADED 1
+
 /**
  * The maximum number of components representing an incoming command which may be allocated
  * at any one time.
  * This constant must be a positive integer smaller than the range of
  * <code>::CrFwInFactoryPoolIndex_t</code>.
+ * An InCommand is released when its InManager has executed it: the pool holds enough
+ * InCommands to fill the PCRL of their InManager, the spill InManagers and the express
+ * InManager (see <code>CrDaInCmpPool.h</code>, <code>CrDaInManagerChain.h</code> and
+ * <code>CrDaInCmdExpress.h</code>).
  */
-#define CR_FW_INFACTORY_MAX_NOF_INCMD 10
+#define CR_FW_INFACTORY_MAX_NOF_INCMD (CR_DA_INMANAGER_PCRLSIZE_INCMD + CR_DA_INMANAGER_SPILL_CAPACITY + \
+                                       CR_DA_INMANAGER_EXPRESS_CAPACITY + CR_DA_INFACTORY_NOF_UNLOADED)
 
 /**
  * The maximum number of InReports which may be allocated at any one time.
  * This constant must be smaller than the range of <code>::CrFwInFactoryPoolIndex_t</code>.
+ * The Slave Applications do not receive any InReports and this pool is tuned independently
+ * of the InCommand pool.
  */
 #define CR_FW_INFACTORY_MAX_NOF_INREP 10
 
@@ -44,9 +60,9 @@
  * initializer <code>#CR_FW_INCMD_INIT_KIND_DESC</code> and it must be smaller
  * than the range of the <code>::CrFwCmdRepKindIndex_t</code> type.
  *
- * The Slave Application receives three kinds of InCommand.
+ * The Slave Application receives six kinds of InCommand.
  */
-#define CR_FW_INCMD_NKINDS 3
+#define CR_FW_INCMD_NKINDS 6
 
 /**
  * The total number of kinds of incoming reports supported by the application.
@@ -65,6 +81,18 @@
  */
 #define CR_FW_INREP_NKINDS 1
 
+/**
+ * The Progress Action of a kind of InCommand which has a batch handler in
+ * <code>#CR_DA_INCMD_INIT_KIND_BATCH</code>.
+ * If the batched execution of the InCommands is selected (see <code>#CR_DA_INCMD_BATCH</code>),
+ * the InCommands are added to batches; otherwise, the argument action is used.
+ */
+#if (CR_DA_INCMD_BATCH == 1)
+#define CR_DA_INCMD_PROGRESS(action) &CrDaInCmdBatchProgress
+#else
+#define CR_DA_INCMD_PROGRESS(action) action
+#endif
+
 /**
  * Definition of the incoming command kinds supported by the application.
  * An application supports a number of service types and, for each service type, it supports
@@ -114,14 +142,67 @@
  * The initializer values defined below are those which are used for the Slave Applications.
  * The non-default function pointers for the Progress Actions are defined in
  * <code>CrDaTempMonitoring.h</code>.
+ * If the batched execution of the InCommands is selected (see
+ * <code>#CR_DA_INCMD_BATCH</code>), their Progress Action is the one provided by
+ * <code>CrDaInCmdBatch.h</code> instead.
+ * The Bulk Set Temperature Limit command (64,9) already sets many limits in one command:
+ * it has its own Validity Check and it is never batched.
+ * The Bulk Enable and Bulk Disable Temperature Monitoring commands (64,10) and (64,11)
+ * likewise have their own Validity Check and are never batched; the Bulk Disable
+ * Temperature Monitoring command is express like the Disable Temperature Monitoring command.
  */
 #define CR_FW_INCMD_INIT_KIND_DESC \
 	{ {64, 1, 0, &CrFwPrCheckAlwaysTrue, &CrFwSmCheckAlwaysTrue, &CrFwSmEmptyAction, \
-						&CrDaTempMonitoringEnable, &CrFwSmEmptyAction, &CrFwSmEmptyAction}, \
+						CR_DA_INCMD_PROGRESS(&CrDaTempMonitoringEnable), &CrFwSmEmptyAction, &CrFwSmEmptyAction}, \
       {64, 2, 0, &CrFwPrCheckAlwaysTrue, &CrFwSmCheckAlwaysTrue, &CrFwSmEmptyAction, \
-						&CrDaTempMonitoringDisable, &CrFwSmEmptyAction, &CrFwSmEmptyAction}, \
+						CR_DA_INCMD_PROGRESS(&CrDaTempMonitoringDisable), &CrFwSmEmptyAction, &CrFwSmEmptyAction}, \
       {64, 3, 0, &CrFwPrCheckAlwaysTrue, &CrFwSmCheckAlwaysTrue, &CrFwSmEmptyAction, \
-						&CrDaTempMonitoringSetTempLimit, &CrFwSmEmptyAction, &CrFwSmEmptyAction}, \
+						CR_DA_INCMD_PROGRESS(&CrDaTempMonitoringSetTempLimit), &CrFwSmEmptyAction, &CrFwSmEmptyAction}, \
+      {64, 9, 0, &CrDaTempMonitoringSetTempLimitsValidityCheck, &CrFwSmCheckAlwaysTrue, &CrFwSmEmptyAction, \
+						&CrDaTempMonitoringSetTempLimits, &CrFwSmEmptyAction, &CrFwSmEmptyAction}, \
+      {64, 10, 0, &CrDaTempMonitoringSetEnabledMaskValidityCheck, &CrFwSmCheckAlwaysTrue, &CrFwSmEmptyAction, \
+						&CrDaTempMonitoringEnableMask, &CrFwSmEmptyAction, &CrFwSmEmptyAction}, \
+      {64, 11, 0, &CrDaTempMonitoringSetEnabledMaskValidityCheck, &CrFwSmCheckAlwaysTrue, &CrFwSmEmptyAction, \
+						&CrDaTempMonitoringDisableMask, &CrFwSmEmptyAction, &CrFwSmEmptyAction}, \
+	}
+
+/**
+ * The batch handlers of the InCommand kinds (see <code>CrDaInCmdBatch.h</code>).
+ * Each line in this initializer gives the batch handler of the InCommands of one kind of
+ * <code>#CR_FW_INCMD_INIT_KIND_DESC</code>.
+ * The elements in each line are as follows:
+ * - The service type.
+ * - The service sub-type.
+ * - The discriminant value.
+ * - The batch handler (a function pointer of type <code>::CrDaInCmdBatchHandler_t</code>)
+ *   or NULL if the InCommands of the kind are not batched.
+ * .
+ * The number of lines must be the same as <code>::CR_FW_INCMD_NKINDS</code>.
+ * The batch handlers are defined in <code>CrDaTempMonitoring.h</code>.
+ */
+#define CR_DA_INCMD_INIT_KIND_BATCH \
+	{ {64, 1, 0, &CrDaTempMonitoringEnableBatch}, \
+	  {64, 2, 0, &CrDaTempMonitoringDisableBatch}, \
+	  {64, 3, 0, &CrDaTempMonitoringSetTempLimitBatch}, \
+	  {64, 9, 0, NULL}, \
+	  {64, 10, 0, NULL}, \
+	  {64, 11, 0, NULL}, \
+	}
+
+/**
+ * The express flags of the InCommand kinds (see <code>CrDaInCmdExpress.h</code>).
+ * Each line in this initializer gives the service type, service sub-type, discriminant
+ * value and express flag of one kind of <code>#CR_FW_INCMD_INIT_KIND_DESC</code>.
+ * The command which disables the temperature monitoring is a safety command and it is
+ * express.
+ */
+#define CR_DA_INCMD_INIT_KIND_EXPRESS \
+	{ {64, 1, 0, 0}, \
+	  {64, 2, 0, 1}, \
+	  {64, 3, 0, 0}, \
+	  {64, 9, 0, 0}, \
+	  {64, 10, 0, 0}, \
+	  {64, 11, 0, 1}, \
 	}
 
 /**
@@ -37,6 +37,9 @@
 #include "BaseCmp/CrFwResetProc.h"
 /* Include Demo Application files */
 #include "CrDaClientSocket.h"
+#include "CrDaShm.h"
+#include "CrDaReplay.h"
+#include "CrDaIoThread.h"
 #include "CrDaConstants.h"
 
 /**
@@ -57,6 +60,32 @@
  */
 #define CR_FW_INSTREAM_PQSIZE {10}
 
+/**
+ * The reserved quotas of the InStreams in the packet pool.
+ * This constant defines the number of packets of the packet pool which are reserved for
+ * the i-th InStream (see <code>CrFwPcktPart.h</code>).
+ * The packets of an InStream which exceed its quota are taken from the shared overflow
+ * region of the packet pool.
+ * The sum of the quotas of the InStreams and OutStreams must not exceed
+ * <code>#CR_FW_MAX_NOF_PCKTS</code>.
+ */
+#define CR_FW_INSTREAM_PCKT_QUOTA {2}
+
+/**
+ * The weights of the InStreams in the InLoader drain (see <code>CrDaInLoad.h</code>).
+ * This constant defines the maximum number of packets which are loaded from the i-th
+ * InStream in one round-robin pass of the drain.
+ * The weights must be positive integers.
+ */
+#define CR_DA_INSTREAM_LOAD_WEIGHT {1}
+
+/**
+ * The quotas of the InStreams in the InLoader drain (see <code>CrDaInLoad.h</code>).
+ * This constant defines the maximum number of packets which are loaded from the i-th
+ * InStream in one drain.
+ */
+#define CR_DA_INSTREAM_LOAD_QUOTA {8}
+
 /**
  * The packet sources which are managed by the InStream components.
  * Each InStream is responsible for collecting packets from one packet source.
@@ -70,9 +99,11 @@
  * The number of groups must be a positive integer.
  * This array defines the number of groups of the i-th InStream.
  *
+ * Each stream has one group for the time-critical packets and one for the routine packets
+ * (see <code>#CR_DA_PCKT_N_OF_GROUPS</code>).
  * The number of groups defined in this file are those used for the Slave 2 Application.
  */
-#define CR_FW_INSTREAM_NOF_GROUPS {1}
+#define CR_FW_INSTREAM_NOF_GROUPS {CR_DA_PCKT_N_OF_GROUPS}
 
 /**
  * The functions implementing  the Packet Collect Operations of the InStream components.
@@ -85,8 +116,22 @@
  *
  * The packet collection operation defined in this file is the one provided
  * by the socket-based interface of <code>CrDaClientSocket.h</code>.
+ * If the shared-memory transport is selected (see <code>#CR_DA_SHM_TRANSPORT</code>),
+ * the function provided by <code>CrDaShm.h</code> is used instead.
+ * If the replay transport is selected (see <code>#CR_DA_REPLAY</code>), the function
+ * provided by <code>CrDaReplay.h</code> is used instead.
+ * If the I/O thread is selected (see <code>#CR_DA_IO_THREAD</code>), the function
+ * provided by <code>CrDaIoThread.h</code> is used instead.
  */
+#if (CR_DA_SHM_TRANSPORT == 1)
+#define CR_FW_INSTREAM_PCKTCOLLECT {&CrDaShmPcktCollect}
+#elif (CR_DA_IO_THREAD == 1)
+#define CR_FW_INSTREAM_PCKTCOLLECT {&CrDaIoThreadPcktCollect}
+#elif (CR_DA_REPLAY == 1)
+#define CR_FW_INSTREAM_PCKTCOLLECT {&CrDaReplayPcktCollect}
+#else
 #define CR_FW_INSTREAM_PCKTCOLLECT {&CrDaClientSocketPcktCollect}
+#endif
 
 /**
  * The functions implementing the Packet Available Check Operations of the InStream
@@ -102,8 +147,22 @@
  *
  * The packet collection operation defined in this file is the one provided
  * by the socket-based interface of <code>CrDaClientSocket.h</code>.
+ * If the shared-memory transport is selected (see <code>#CR_DA_SHM_TRANSPORT</code>),
+ * the function provided by <code>CrDaShm.h</code> is used instead.
+ * If the replay transport is selected (see <code>#CR_DA_REPLAY</code>), the function
+ * provided by <code>CrDaReplay.h</code> is used instead.
+ * If the I/O thread is selected (see <code>#CR_DA_IO_THREAD</code>), the function
+ * provided by <code>CrDaIoThread.h</code> is used instead.
  */
+#if (CR_DA_SHM_TRANSPORT == 1)
+#define CR_FW_INSTREAM_PCKTAVAILCHECK {&CrDaShmIsPcktAvail}
+#elif (CR_DA_IO_THREAD == 1)
+#define CR_FW_INSTREAM_PCKTAVAILCHECK {&CrDaIoThreadIsPcktAvail}
+#elif (CR_DA_REPLAY == 1)
+#define CR_FW_INSTREAM_PCKTAVAILCHECK {&CrDaReplayIsPcktAvail}
+#else
 #define CR_FW_INSTREAM_PCKTAVAILCHECK {&CrDaClientSocketIsPcktAvail}
+#endif
 
 /**
  * The functions implementing the Initialization Check of the InStream components.
@@ -121,8 +180,18 @@
  *
  * The initialization check operation defined in this file is the one provided
  * by the socket-based interface of <code>CrDaClientSocket.h</code>.
+ * If the shared-memory transport is selected (see <code>#CR_DA_SHM_TRANSPORT</code>),
+ * the function provided by <code>CrDaShm.h</code> is used instead.
+ * If the replay transport is selected (see <code>#CR_DA_REPLAY</code>), the default
+ * initialization check is used instead.
  */
+#if (CR_DA_SHM_TRANSPORT == 1)
+#define CR_FW_INSTREAM_INITCHECK {&CrDaShmInitCheck}
+#elif (CR_DA_REPLAY == 1)
+#define CR_FW_INSTREAM_INITCHECK {&CrFwBaseCmpDefInitCheck}
+#else
 #define CR_FW_INSTREAM_INITCHECK {&CrDaClientSocketInitCheck}
+#endif
 
 /**
  * The functions implementing the Initialization Action of the InStream components.
@@ -143,8 +212,18 @@
  *
  * The initialization check operation defined in this file is the one provided
  * by the socket-based interface of <code>CrDaClientSocket.h</code>.
+ * If the shared-memory transport is selected (see <code>#CR_DA_SHM_TRANSPORT</code>),
+ * the function provided by <code>CrDaShm.h</code> is used instead.
+ * If the replay transport is selected (see <code>#CR_DA_REPLAY</code>), the function
+ * provided by <code>CrDaReplay.h</code> is used instead.
  */
+#if (CR_DA_SHM_TRANSPORT == 1)
+#define CR_FW_INSTREAM_INITACTION {&CrDaShmInitAction}
+#elif (CR_DA_REPLAY == 1)
+#define CR_FW_INSTREAM_INITACTION {&CrDaReplayInitAction}
+#else
 #define CR_FW_INSTREAM_INITACTION {&CrDaClientSocketInitAction}
+#endif
 
 /**
  * The functions implementing the Configuration Check of the InStream components.
@@ -181,8 +260,18 @@
  *
  * The configuration action operation defined in this file is the one provided
  * by the socket-based interface of <code>CrDaClientSocket.h</code>.
+ * If the shared-memory transport is selected (see <code>#CR_DA_SHM_TRANSPORT</code>),
+ * the function provided by <code>CrDaShm.h</code> is used instead.
+ * If the replay transport is selected (see <code>#CR_DA_REPLAY</code>), the function
+ * provided by <code>CrDaReplay.h</code> is used instead.
  */
+#if (CR_DA_SHM_TRANSPORT == 1)
+#define CR_FW_INSTREAM_CONFIGACTION {&CrDaShmConfigAction}
+#elif (CR_DA_REPLAY == 1)
+#define CR_FW_INSTREAM_CONFIGACTION {&CrDaReplayConfigAction}
+#else
 #define CR_FW_INSTREAM_CONFIGACTION {&CrDaClientSocketConfigAction}
+#endif
 
 /**
  * The functions implementing the Shutdown Action of the InStream components.
@@ -200,7 +289,17 @@
  *
  * The shutdown action operation defined in this file is the one provided
  * by the socket-based interface of <code>CrDaClientSocket.h</code>.
+ * If the shared-memory transport is selected (see <code>#CR_DA_SHM_TRANSPORT</code>),
+ * the function provided by <code>CrDaShm.h</code> is used instead.
+ * If the replay transport is selected (see <code>#CR_DA_REPLAY</code>), the function
+ * provided by <code>CrDaReplay.h</code> is used instead.
  */
+#if (CR_DA_SHM_TRANSPORT == 1)
+#define CR_FW_INSTREAM_SHUTDOWNACTION {&CrDaShmShutdownAction}
+#elif (CR_DA_REPLAY == 1)
+#define CR_FW_INSTREAM_SHUTDOWNACTION {&CrDaReplayShutdownAction}
+#else
 #define CR_FW_INSTREAM_SHUTDOWNACTION {&CrDaClientSocketShutdownAction}
+#endif
 
 #endif /* CR_FW_INSTREAM_USERPAR_H_ */
@@ -33,6 +33,10 @@
 #include "BaseCmp/CrFwResetProc.h"
 /* Include Demo Application files */
 #include "CrDaClientSocket.h"
+#include "CrDaShm.h"
+#include "CrDaReplay.h"
+#include "CrDaIoThread.h"
+#include "CrDaOutBacklog.h"
 #include "CrDaConstants.h"
 
 /**
@@ -58,6 +62,17 @@
  */
 #define CR_FW_OUTSTREAM_PQSIZE {10}
 
+/**
+ * The reserved quotas of the OutStreams in the packet pool.
+ * This constant defines the number of packets of the packet pool which are reserved for
+ * the i-th OutStream (see <code>CrFwPcktPart.h</code>).
+ * The packets of an OutStream which exceed its quota are taken from the shared overflow
+ * region of the packet pool.
+ * The sum of the quotas of the InStreams and OutStreams must not exceed
+ * <code>#CR_FW_MAX_NOF_PCKTS</code>.
+ */
+#define CR_FW_OUTSTREAM_PCKT_QUOTA {2}
+
 /**
  * The destinations of the OutStream components.
  * The destination of an OutStream is the middleware node to which the OutStream
@@ -76,10 +91,12 @@
  * The number of groups must be a positive integer.
  * This array defines the number of groups of the i-th OutStream.
  *
+ * Each stream has one group for the time-critical packets and one for the routine packets
+ * (see <code>#CR_DA_PCKT_N_OF_GROUPS</code>).
  * The number of groups defined in this file are those used for the Slave 2 Application
  * of the CORDET Demo.
  */
-#define CR_FW_OUTSTREAM_NOF_GROUPS {1}
+#define CR_FW_OUTSTREAM_NOF_GROUPS {CR_DA_PCKT_N_OF_GROUPS}
 
 /**
  * The functions implementing the packet hand-over operations of the OutStream components.
@@ -93,8 +110,27 @@
  *
  * The packet handover functions defined in this file is the one provided
  * by the socket-based interface of <code>CrDaClientSocket.h</code>.
+ * If the shared-memory transport is selected (see <code>#CR_DA_SHM_TRANSPORT</code>),
+ * the function provided by <code>CrDaShm.h</code> is used instead.
+ * If the replay transport is selected (see <code>#CR_DA_REPLAY</code>), the function
+ * provided by <code>CrDaReplay.h</code> is used instead.
+ * If the I/O thread is selected (see <code>#CR_DA_IO_THREAD</code>), the function
+ * provided by <code>CrDaIoThread.h</code> is used instead.
+ * If the OutStream backlog is selected (see <code>#CR_DA_OUT_BACKLOG</code>), the function
+ * provided by <code>CrDaOutBacklog.h</code> is used and it hands the packets over to the
+ * function of the selected transport.
  */
+#if (CR_DA_OUT_BACKLOG == 1)
+#define CR_FW_OUTSTREAM_PCKTHANDOVER {&CrDaOutBacklogPcktHandover}
+#elif (CR_DA_SHM_TRANSPORT == 1)
+#define CR_FW_OUTSTREAM_PCKTHANDOVER {&CrDaShmPcktHandover}
+#elif (CR_DA_IO_THREAD == 1)
+#define CR_FW_OUTSTREAM_PCKTHANDOVER {&CrDaIoThreadPcktHandover}
+#elif (CR_DA_REPLAY == 1)
+#define CR_FW_OUTSTREAM_PCKTHANDOVER {&CrDaReplayPcktHandover}
+#else
 #define CR_FW_OUTSTREAM_PCKTHANDOVER {&CrDaClientSocketPcktHandover}
+#endif
 
 /**
  * The functions implementing the Initialization Check of the OutStream components.
@@ -111,8 +147,18 @@
  *
  * The Initialization Check function defined in this file is the one provided
  * by the socket-based interface of <code>CrDaClientSocket.h</code>.
+ * If the shared-memory transport is selected (see <code>#CR_DA_SHM_TRANSPORT</code>),
+ * the function provided by <code>CrDaShm.h</code> is used instead.
+ * If the replay transport is selected (see <code>#CR_DA_REPLAY</code>), the default
+ * initialization check is used instead.
  */
+#if (CR_DA_SHM_TRANSPORT == 1)
+#define CR_FW_OUTSTREAM_INITCHECK {&CrDaShmInitCheck}
+#elif (CR_DA_REPLAY == 1)
+#define CR_FW_OUTSTREAM_INITCHECK {&CrFwBaseCmpDefInitCheck}
+#else
 #define CR_FW_OUTSTREAM_INITCHECK {&CrDaClientSocketInitCheck}
+#endif
 
 /**
  * The functions implementing the Initialization Action of the OutStream components.
@@ -133,8 +179,18 @@
  *
  * The Initialization Action function defined in this file is the one provided
  * by the socket-based interface of <code>CrDaClientSocket.h</code>.
+ * If the shared-memory transport is selected (see <code>#CR_DA_SHM_TRANSPORT</code>),
+ * the function provided by <code>CrDaShm.h</code> is used instead.
+ * If the replay transport is selected (see <code>#CR_DA_REPLAY</code>), the function
+ * provided by <code>CrDaReplay.h</code> is used instead.
  */
+#if (CR_DA_SHM_TRANSPORT == 1)
+#define CR_FW_OUTSTREAM_INITACTION {&CrDaShmInitAction}
+#elif (CR_DA_REPLAY == 1)
+#define CR_FW_OUTSTREAM_INITACTION {&CrDaReplayInitAction}
+#else
 #define CR_FW_OUTSTREAM_INITACTION {&CrDaClientSocketInitAction}
+#endif
 
 /**
  * The functions implementing the Configuration Check of the OutStream components.
@@ -189,7 +245,17 @@
  *
  * The Shutdown Action function defined in this file is the one provided
  * by the socket-based interface of <code>CrDaClientSocket.h</code>.
+ * If the shared-memory transport is selected (see <code>#CR_DA_SHM_TRANSPORT</code>),
+ * the function provided by <code>CrDaShm.h</code> is used instead.
+ * If the replay transport is selected (see <code>#CR_DA_REPLAY</code>), the function
+ * provided by <code>CrDaReplay.h</code> is used instead.
  */
+#if (CR_DA_SHM_TRANSPORT == 1)
+#define CR_FW_OUTSTREAM_SHUTDOWNACTION {&CrDaShmShutdownAction}
+#elif (CR_DA_REPLAY == 1)
+#define CR_FW_OUTSTREAM_SHUTDOWNACTION {&CrDaReplayShutdownAction}
+#else
 #define CR_FW_OUTSTREAM_SHUTDOWNACTION {&CrDaClientSocketShutdownAction}
+#endif
 
 #endif /* CR_FW_OUTSTREAM_USERPAR_H_ */
@@ -0,0 +1,114 @@
+/**
+ * @file
+ * @ingroup crConfigDemoSlave2
+ * Interface for the partitioning of the packet pool of the default packet
+ * implementation (see <code>CrFwPckt.c</code>).
+ * The packet pool is divided into partitions which prevent a single source of
+ * packets from exhausting the packet pool and starving the other sources:
+ * - There is one partition for each InStream and one partition for each OutStream.
+ *   Each of these partitions has a reserved quota of packets which is defined by
+ *   <code>#CR_FW_INSTREAM_PCKT_QUOTA</code> and <code>#CR_FW_OUTSTREAM_PCKT_QUOTA</code>.
+ * - All packets which are not covered by the reserved quotas form a shared overflow
+ *   region.
+ *   There is no reserved quota for the shared partition
+ *   (<code>#CR_FW_PCKT_PART_SHARED</code>): its packets are always taken from the
+ *   overflow region.
+ * .
+ * A packet allocation for a partition is served from the reserved quota of the
+ * partition while this is not exhausted and from the shared overflow region
+ * afterwards.
+ * It fails if both are exhausted, even if the packet pool still holds free packets.
+ * The sum of the reserved quotas must not exceed <code>#CR_FW_MAX_NOF_PCKTS</code>.
+ * The quotas and the number of packets of the pool may be changed at startup by the
+ * runtime configuration (see <code>::CrFwPcktArenaConfigure</code>).
+ *
+ * The quotas are counted in number of packets independently of their size class.
+ * A partition which is within its quota is therefore guaranteed to find a free
+ * packet in the pool, but not necessarily a free packet which is large enough
+ * for the requested length.
+ *
+ * Packets which are created through <code>::CrFwPcktMake</code> are charged to the
+ * partition selected with <code>::CrFwPcktSetMakePart</code> (by default, the shared
+ * partition).
+ * This is used for the packets which are created by the framework on behalf of the
+ * application (e.g. the packets of the OutComponents made by the OutFactory).
+ * Packets which are created through <code>::CrFwPcktMakeInPart</code> are charged to
+ * the partition given as argument.
+ * This is used by the socket adapters to charge incoming packets to the partition
+ * of their InStream.
+ * A packet is returned to its partition when it is released.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRFW_PCKTPART_H_
+#define CRFW_PCKTPART_H_
+
+#include "CrFwConstants.h"
+#include "CrFwUserConstants.h"
+
+/** Type for the identifier of a partition of the packet pool. */
+typedef unsigned char CrFwPcktPartId_t;
+
+/** The identifier of the shared partition of the packet pool. */
+#define CR_FW_PCKT_PART_SHARED 0
+
+/**
+ * Make a packet and charge it to a partition of the packet pool.
+ * This function behaves like <code>::CrFwPcktMake</code> but the packet is charged
+ * to the argument partition.
+ * If the reserved quota of the partition and the shared overflow region are both
+ * exhausted, the function returns NULL and sets the application error code to
+ * <code>::crPcktAllocationFail</code>.
+ * An illegal partition identifier is treated as the shared partition.
+ * @param part the partition
+ * @param pcktLength the packet length
+ * @return the new packet or NULL if no packet could be allocated
+ */
+CrFwPckt_t CrFwPcktMakeInPart(CrFwPcktPartId_t part, CrFwPcktLength_t pcktLength);
+
+/**
+ * Select the partition of the packet pool to which the packets created through
+ * <code>::CrFwPcktMake</code> are charged.
+ * In the lock-free variant of the packet pool, the selection is local to the
+ * calling thread.
+ * An illegal partition identifier is treated as the shared partition.
+ * @param part the partition
+ */
+void CrFwPcktSetMakePart(CrFwPcktPartId_t part);
+
+/**
+ * Return the partition of the InStream which receives the packets from the argument
+ * source.
+ * The function returns <code>#CR_FW_PCKT_PART_SHARED</code> if there is no such InStream.
+ * The partition is found in constant time through the stream map (see
+ * <code>CrDaStreamMap.h</code>): <code>#CR_FW_PCKT_PART_SHARED</code> is also returned
+ * before the stream map is built.
+ * @param src the source
+ * @return the partition of the InStream
+ */
+CrFwPcktPartId_t CrFwPcktGetInStreamPart(CrFwDestSrc_t src);
+
+/**
+ * Return the partition of the OutStream which sends the packets to the argument
+ * destination.
+ * The function returns <code>#CR_FW_PCKT_PART_SHARED</code> if there is no such OutStream.
+ * The partition is found in constant time through the stream map (see
+ * <code>CrDaStreamMap.h</code>): <code>#CR_FW_PCKT_PART_SHARED</code> is also returned
+ * before the stream map is built.
+ * @param dest the destination
+ * @return the partition of the OutStream
+ */
+CrFwPcktPartId_t CrFwPcktGetOutStreamPart(CrFwDestSrc_t dest);
+
+#endif /* CRFW_PCKTPART_H_ */
@@ -3,7 +3,11 @@
  * @ingroup crConfigDemoSlave2
  * Implementation of the error reporting interface of <code>CrFwRepErr.h</code>
  * for the Slave 2 Application of the CORDET Demo.
- * This implementation writes the InCommand Outcome Reports to standard output.
+ * This implementation writes the InCommand Outcome Reports to the log (see
+ * <code>CrDaLog.h</code>) or, if the binary trace is selected, to the ring buffer of the
+ * trace (see <code>CrDaTrace.h</code>)
+ * and acknowledges the successful start of the InCommands which request it (see
+ * <code>CrDaOutCmpAck.h</code>).
  *
  * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
  * @author Alessandro Pasetti <pasetti@pnp-software.com>
@@ -22,47 +26,94 @@
 #include <stdlib.h>
 #include <string.h>
 #include "CrDaConstants.h"
+#include "CrDaOutCmpAck.h"
+#include "CrDaOutCmpAckBatch.h"
+#include "CrDaTrace.h"
+#include "CrDaLatTrace.h"
+#include "CrDaInCmdAsync.h"
+#include "CrDaLog.h"
+#include "CrDaInCmpPool.h"
 /* Include Framework Files */
 #include "CrFwConstants.h"
 #include "CrFwRepInCmdOutcome.h"
+/* Include configuration files */
+#include "CrFwCmpData.h"
+/* Include FW Profile files */
+#include "FwSmConfig.h"
 
 /*-----------------------------------------------------------------------------------------*/
 void CrFwRepInCmdOutcome(CrFwRepInCmdOutcome_t outcome, CrFwInstanceId_t instanceId, CrFwServType_t servType,
                          CrFwServSubType_t servSubType, CrFwDiscriminant_t disc, CrFwOutcome_t failCode, FwSmDesc_t inCmd) {
+	/* Record the hop of the InCommand in its latency trace */
+	CrDaLatTraceInCmd(outcome, inCmd);
+
+	/* The executions in which the continuation of an InCommand still waits are no progress */
+	if ((outcome == crCmdAckPrgSucc) && CrDaInCmdAsyncIsWaiting(inCmd))
+		return;
+
+#if (CR_DA_ACK_BATCH == 1)
+	/* Add the outcome to the acknowledgement batch of the source of the command */
+	CrFwCmpData_t* cmpData = (CrFwCmpData_t*)FwSmGetData(inCmd);
+	CrDaOutCmpAckBatchAdd(((CrFwInCmdData_t*)(cmpData->cmpSpecificData))->pckt, outcome, failCode);
+#else
+	/* Acknowledge the start to the source of the command if it has requested it */
+	if (outcome == crCmdAckStrSucc)
+		CrDaOutCmpAckSend(inCmd);
+#endif
+
+#if (CR_DA_TRACE == 1)
+	CrDaTraceWrite(crDaTraceInCmdOutcome, outcome, failCode, instanceId, servType, servSubType, disc);
+#else
 	if (outcome == crCmdAckStrSucc) {
 		if ((servType == CR_DA_SERV_TYPE) && (servSubType == CR_DA_SERV_SUBTYPE_EN))
-			printf("S2: successful start for InCommand to enable temperature monitoring\n");
+			CR_DA_LOG(crDaLogInfo, "S2: successful start for InCommand to enable temperature monitoring\n");
 		else if ((servType == CR_DA_SERV_TYPE) && (servSubType == CR_DA_SERV_SUBTYPE_DIS))
-			printf("S2: successful start for InCommand to disable temperature monitoring\n");
+			CR_DA_LOG(crDaLogInfo, "S2: successful start for InCommand to disable temperature monitoring\n");
 		else if ((servType == CR_DA_SERV_TYPE) && (servSubType == CR_DA_SERV_SUBTYPE_SET))
-			printf("S2: successful start for InCommand to set temperature limit\n");
+			CR_DA_LOG(crDaLogInfo, "S2: successful start for InCommand to set temperature limit\n");
+		else if ((servType == CR_DA_SERV_TYPE) && (servSubType == CR_DA_SERV_SUBTYPE_SET_BULK))
+			CR_DA_LOG(crDaLogInfo, "S2: successful start for InCommand to set the temperature limits of a range of channels\n");
+		else if ((servType == CR_DA_SERV_TYPE) && (servSubType == CR_DA_SERV_SUBTYPE_EN_MASK))
+			CR_DA_LOG(crDaLogInfo, "S2: successful start for InCommand to enable temperature monitoring of a range of channels\n");
+		else if ((servType == CR_DA_SERV_TYPE) && (servSubType == CR_DA_SERV_SUBTYPE_DIS_MASK))
+			CR_DA_LOG(crDaLogInfo, "S2: successful start for InCommand to disable temperature monitoring of a range of channels\n");
 		return;
 	}
 
 	if (outcome == crCmdAckPrgSucc) {
-		printf("S2: unexpected progress report for InCommand %d, service type %d,\n",instanceId,servType);
-		printf("    service sub-type %d, and discriminant %d\n",servSubType,disc);
+		CR_DA_LOG(crDaLogWarn, "S2: unexpected progress report for InCommand %d, service type %d,\n"
+		          "    service sub-type %d, and discriminant %d\n", instanceId, servType, servSubType, disc);
 	} else if (outcome == crCmdAckTrmSucc) {
-		printf("S2: unexpected termination report for InCommand %d, service type %d,\n",instanceId,servType);
-		printf("    service sub-type %d, and discriminant %d\n",servSubType,disc);
+		CR_DA_LOG(crDaLogWarn, "S2: unexpected termination report for InCommand %d, service type %d,\n"
+		          "    service sub-type %d, and discriminant %d\n", instanceId, servType, servSubType, disc);
 	} else if (outcome == crCmdAckAccFail) {
-		printf("S2: unexpected acceptance failure report for InCommand %d, service type %d,\n",instanceId,servType);
-		printf("    service sub-type %d, and discriminant %d; fail code: %d\n",servSubType,disc,failCode);
+		CR_DA_LOG(crDaLogWarn, "S2: unexpected acceptance failure report for InCommand %d, service type %d,\n"
+		          "    service sub-type %d, and discriminant %d; fail code: %d\n", instanceId, servType, servSubType, disc, failCode);
 	} else if (outcome == crCmdAckStrFail) {
-		printf("S2: unexpected start failure report for InCommand %d, service type %d,\n",instanceId,servType);
-		printf("    service sub-type %d, and discriminant %d; fail code: %d\n",servSubType,disc,failCode);
+		CR_DA_LOG(crDaLogWarn, "S2: unexpected start failure report for InCommand %d, service type %d,\n"
+		          "    service sub-type %d, and discriminant %d; fail code: %d\n", instanceId, servType, servSubType, disc, failCode);
 	} else if (outcome == crCmdAckPrgFail) {
-		printf("S2: unexpected progress failure report for InCommand %d, service type %d,\n",instanceId,servType);
-		printf("    service sub-type %d, and discriminant %d; fail code: %d\n",servSubType,disc,failCode);
+		CR_DA_LOG(crDaLogWarn, "S2: unexpected progress failure report for InCommand %d, service type %d,\n"
+		          "    service sub-type %d, and discriminant %d; fail code: %d\n", instanceId, servType, servSubType, disc, failCode);
 	} else if (outcome == crCmdAckTrmFail) {
-		printf("S2: unexpected termination failure report for InCommand %d, service type %d,\n",instanceId,servType);
-		printf("    service sub-type %d, and discriminant %d; fail code: %d\n",servSubType,disc,failCode);
+		CR_DA_LOG(crDaLogWarn, "S2: unexpected termination failure report for InCommand %d, service type %d,\n"
+		          "    service sub-type %d, and discriminant %d; fail code: %d\n", instanceId, servType, servSubType, disc, failCode);
 	}
+#endif
 }
 
 /*-----------------------------------------------------------------------------------------*/
 void CrFwRepInCmdOutcomeCreFail(CrFwRepInCmdOutcome_t outcome, CrFwOutcome_t failCode, CrFwPckt_t pckt) {
+	/* Count the failure against the InCommand pool */
+	CrDaInCmpPoolInCmdCreFail();
+#if (CR_DA_ACK_BATCH == 1)
+	CrDaOutCmpAckBatchAdd(pckt, outcome, failCode);
+#endif
 
-	printf("S2: failure to create InCommand component\n");
+#if (CR_DA_TRACE == 1)
+	CrDaTraceWrite(crDaTraceInCmdOutcomeCreFail, outcome, failCode, 0, 0, 0, 0);
+#else
+	CR_DA_LOG(crDaLogWarn, "S2: failure to create InCommand component\n");
+#endif
 }
 
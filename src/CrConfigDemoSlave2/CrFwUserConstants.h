@@ -27,8 +27,29 @@
 
 #include "FwPrConstants.h"
 
+/**
+ * Selection of the wide application identifiers.
+ * If this constant is set to 1, the destination and source of commands and reports are
+ * 16-bit integers, the command and report identifiers are 32-bit integers and
+ * <code>#CR_FW_NBITS_APP_ID</code> bits of them are reserved for the application
+ * identifier: the demo applications can then address up to 1024 applications.
+ * If it is set to 0, the destination and source are 8-bit integers, the command and
+ * report identifiers are 16-bit integers and up to 16 applications can be addressed.
+ * The wide application identifiers require the standard packet layout (see
+ * <code>#CR_FW_PCKT_COMPACT_LAYOUT</code>).
+ * All applications of the CORDET Demo must use the same setting.
+ */
+#ifndef CR_FW_WIDE_APP_ID
+#define CR_FW_WIDE_APP_ID 0
+#endif
+
+#if (CR_FW_WIDE_APP_ID == 1)
+/** Type used for instance identifiers. */
+typedef unsigned int CrFwInstanceId_t;
+#else
 /** Type used for instance identifiers. */
 typedef unsigned short CrFwInstanceId_t;
+#endif
 
 /** Type used for the identifier of a component type. */
 typedef unsigned short int CrFwTypeId_t;
@@ -39,10 +60,18 @@ typedef unsigned char CrFwOutcome_t;
 /** Type used for the sequence counter of commands or reports. */
 typedef unsigned int CrFwSeqCnt_t;
 
-/** Type used for the application time. */
-typedef float CrFwTime_t;
+/**
+ * Type used for the application time.
+ * The application time is the time in seconds of the monotonic clock of the host
+ * (see <code>CrFwTime.c</code>).
+ */
+typedef double CrFwTime_t;
 
-/** Type used for the time stamp of a command or report. */
+/**
+ * Type used for the time stamp of a command or report.
+ * The time stamp holds the low-order bits of the time of the monotonic clock in units
+ * of 2^<code>#CR_FW_TIME_STAMP_SHIFT</code> nanoseconds (see <code>CrFwTime.c</code>).
+ */
 typedef unsigned int CrFwTimeStamp_t;
 
 /** Type used for the number of elapsed cycles.
@@ -59,8 +88,13 @@ typedef unsigned char CrFwServSubType_t;
 /** Type used for the destination or source group of a packet. */
 typedef unsigned char CrFwGroup_t;
 
+#if (CR_FW_WIDE_APP_ID == 1)
+/** Type used for the command or report destination and source. */
+typedef unsigned short CrFwDestSrc_t;
+#else
 /** Type used for the command or report destination and source. */
 typedef unsigned char CrFwDestSrc_t;
+#endif
 
 /** Type used for the discriminant of a command or report. */
 typedef unsigned short CrFwDiscriminant_t;
@@ -204,26 +238,201 @@ typedef enum {
 	/** An InCommand release request has encountered an error (see <code>::CrFwInFactoryReleaseInCmd</code>). */
 	crInCmdRelErr = 23,
 	/** A framework function has been called with an illegal InManager identifier. */
-	crInManagerIllId = 24
+	crInManagerIllId = 24,
+	/** A packet retain request has encountered an error (see <code>::CrFwPcktRetain</code>). */
+	crPcktRetainErr = 25
 } CrFwAppErrCode_t;
 
+/**
+ * The slot size in number of bytes of the packets in the small size class of the
+ * default packet implementation.
+ * This class is sized to hold the commands and reports of the CORDET Demo.
+ * The slot sizes must be multiples of 4 and must be listed in increasing order
+ * (small, medium, large).
+ */
+#define CR_FW_SMALL_PCKT_LENGTH 64
+
+/** The number of packets in the small size class of the default packet implementation. */
+#define CR_FW_NOF_SMALL_PCKTS 10
+
+/** The slot size in number of bytes of the packets in the medium size class of the default packet implementation. */
+#define CR_FW_MEDIUM_PCKT_LENGTH 128
+
+/** The number of packets in the medium size class of the default packet implementation. */
+#define CR_FW_NOF_MEDIUM_PCKTS 2
+
+/**
+ * The slot size in number of bytes of the packets in the large size class of the
+ * default packet implementation.
+ * This is the maximum length of a packet.
+ * This class is sized to carry bulk transfers (e.g. large parameter blocks or batched
+ * reports) in one packet.
+ * Its value must not exceed <code>#CR_FW_PCKT_LENGTH_MAX</code>.
+ */
+#define CR_FW_LARGE_PCKT_LENGTH 1024
+
+/** The number of packets in the large size class of the default packet implementation. */
+#define CR_FW_NOF_LARGE_PCKTS 1
+
 /**
  * The maximum number of packets which can be created with the default packet implementation.
+ * This is the sum of the number of packets in the three size classes.
  * The value of this constant must not exceed the range of the <code>CrFwCounterU2_t</code> type.
  */
-#define CR_FW_MAX_NOF_PCKTS 12
+#define CR_FW_MAX_NOF_PCKTS (CR_FW_NOF_SMALL_PCKTS+CR_FW_NOF_MEDIUM_PCKTS+CR_FW_NOF_LARGE_PCKTS)
+
+/**
+ * The alignment in number of bytes of the packets of the default packet implementation.
+ * The slot of each packet is rounded up to a multiple of this value and the packet array
+ * starts on a boundary of this value (see <code>CrFwPcktArena.h</code>).
+ * The default value is the size of a cache line.
+ * The value must be a power of two and at least 4.
+ * The constant may be overridden on the compiler command line
+ * (e.g. <code>-DCR_FW_PCKT_SLOT_ALIGN=128</code>).
+ */
+#ifndef CR_FW_PCKT_SLOT_ALIGN
+#define CR_FW_PCKT_SLOT_ALIGN 64
+#endif
+
+/**
+ * Selection of the packet arena of the default packet implementation.
+ * If this constant is set to 1, the packet array is mapped at startup, on huge pages if
+ * the pool is large enough (see <code>CrFwPcktArena.h</code>).
+ * If it is set to 0, the packet array is a static array.
+ * The constant may be overridden on the compiler command line
+ * (e.g. <code>-DCR_FW_PCKT_ARENA=1</code>).
+ */
+#ifndef CR_FW_PCKT_ARENA
+#define CR_FW_PCKT_ARENA 0
+#endif
+
+/**
+ * The size in number of bytes of a huge page.
+ * A packet array of at least this size is mapped on huge pages if the packet arena is
+ * selected (see <code>#CR_FW_PCKT_ARENA</code>); a smaller one is mapped on normal pages.
+ */
+#ifndef CR_FW_PCKT_ARENA_HUGE_SIZE
+#define CR_FW_PCKT_ARENA_HUGE_SIZE (2*1024*1024)
+#endif
+
+/**
+ * Selection of the lock-free variant of the default packet implementation.
+ * If this constant is set to 1, the packet pool can be accessed concurrently by several
+ * threads without a global lock (see <code>CrFwPckt.c</code>).
+ * If it is set to 0, the packet pool is built without atomic operations and must only
+ * be accessed by one thread.
+ * The constant may be overridden on the compiler command line
+ * (e.g. <code>-DCR_FW_PCKT_LOCK_FREE=1</code>).
+ */
+#ifndef CR_FW_PCKT_LOCK_FREE
+#define CR_FW_PCKT_LOCK_FREE 0
+#endif
+
+/**
+ * Selection of the exact high-water mark of the lock-free variant of the default packet
+ * implementation (see <code>CrFwPcktStats.h</code>).
+ * If this constant is set to 1, each allocation and release updates one counter of the
+ * allocated packets which is shared by all threads and the high-water mark is raised at
+ * each allocation.
+ * If it is set to 0, the allocations and releases only update the counters of their
+ * thread and the high-water mark is raised when a statistics snapshot is taken.
+ * The constant has no effect if <code>#CR_FW_PCKT_LOCK_FREE</code> is 0.
+ * The constant may be overridden on the compiler command line
+ * (e.g. <code>-DCR_FW_PCKT_STATS_EXACT_HWM=1</code>).
+ */
+#ifndef CR_FW_PCKT_STATS_EXACT_HWM
+#define CR_FW_PCKT_STATS_EXACT_HWM 0
+#endif
+
+/**
+ * Selection of the packet layout of the default packet implementation.
+ * If this constant is set to 1, the compact layout is used in which each packet
+ * attribute is stored in a field which is as large as its type and the parameter
+ * area starts at byte 20.
+ * If it is set to 0, the standard layout is used in which each packet attribute is
+ * stored in a 4-byte word and the parameter area starts at byte 60
+ * (see <code>CrFwPckt.c</code>).
+ * All applications of the CORDET Demo must use the same layout.
+ */
+#ifndef CR_FW_PCKT_COMPACT_LAYOUT
+#define CR_FW_PCKT_COMPACT_LAYOUT 0
+#endif
+
+#if (CR_FW_PCKT_COMPACT_LAYOUT == 1) && (CR_FW_WIDE_APP_ID == 1)
+#error "The wide application identifiers require the standard packet layout"
+#endif
+
+/**
+ * Selection of the byte order of the packets of the default packet implementation.
+ * If this constant is set to 1, the multi-byte packet attributes and parameters are
+ * stored in network byte order (most significant byte first) so that applications
+ * which run on hosts of different byte orders can exchange packets
+ * (see <code>CrFwPcktWire.h</code>).
+ * If it is set to 0, they are stored in the byte order of the host.
+ * All applications of the CORDET Demo must use the same byte order.
+ */
+#ifndef CR_FW_PCKT_NET_ORDER
+#define CR_FW_PCKT_NET_ORDER 0
+#endif
+
+/**
+ * Selection of the inline header accessors of the default packet implementation.
+ * If this constant is set to 1, the modules which include <code>CrFwPcktInline.h</code>
+ * access the packet attributes through inline functions instead of calling the
+ * out-of-line accessors of <code>CrFwPckt.c</code>.
+ * The constant is normally set on the compiler command line by the build scripts
+ * (e.g. <code>-DCR_FW_PCKT_INLINE=1</code>).
+ */
+#ifndef CR_FW_PCKT_INLINE
+#define CR_FW_PCKT_INLINE 0
+#endif
+
+/**
+ * The resolution of the time stamps of commands and reports (see <code>CrFwTime.c</code>).
+ * The time stamps are in units of 2^CR_FW_TIME_STAMP_SHIFT nanoseconds.
+ * With a value of zero, the time stamps have nanosecond resolution and they wrap around
+ * every 4.29 seconds; with a value of 10, they have a resolution of 1.024 microseconds
+ * and they wrap around every 73 minutes.
+ * All applications of the CORDET Demo must use the same resolution.
+ */
+#ifndef CR_FW_TIME_STAMP_SHIFT
+#define CR_FW_TIME_STAMP_SHIFT 0
+#endif
+
+/**
+ * Selection of the time-stamp counter as the time source (see <code>CrFwTime.c</code>).
+ * If this constant is set to 1 and the processor has an invariant time-stamp counter,
+ * the time is derived from the time-stamp counter instead of being read from the
+ * monotonic clock.
+ * If it is set to 0 or if no invariant time-stamp counter is available, the time is
+ * read from the monotonic clock.
+ */
+#ifndef CR_FW_TIME_TSC
+#define CR_FW_TIME_TSC 0
+#endif
+
+/**
+ * The duration in microseconds of the calibration of the time-stamp counter against
+ * the monotonic clock (see <code>#CR_FW_TIME_TSC</code>).
+ */
+#define CR_FW_TIME_TSC_CALIB_USEC 10000
 
 /** The identifier of the Slave 2 Application of the CORDET Demo */
 #define CR_FW_HOST_APP_ID 3
 
+#if (CR_FW_WIDE_APP_ID == 1)
+/** The number of bits reserved for the application identifier in a command or report identifier */
+#define CR_FW_NBITS_APP_ID 10
+#else
 /** The number of bits reserved for the application identifier in a command or report identifier */
 #define CR_FW_NBITS_APP_ID 4
+#endif
 
 /** Maximum value of the service type attribute of InReports and InCommands for the Master Application */
 #define CR_FW_MAX_SERV_TYPE 64
 
 /** Maximum value of the service sub-type attribute of InReports and InCommands for the Master Application */
-#define CR_FW_MAX_SERV_SUBTYPE 4
+#define CR_FW_MAX_SERV_SUBTYPE 11
 
 /** Maximum value of the discriminant attribute of InReports and InCommands for the Master Application */
 #define CR_FW_MAX_DISCRIMINANT 1
@@ -0,0 +1,37 @@
+/**
+ * @file
+ * @ingroup crDemoBench
+ * Header file to define constants and types for the micro-benchmarks of the CORDET Demo.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRBN_CONSTANTS_H_
+#define CRBN_CONSTANTS_H_
+
+/**
+ * The number of timed runs of each benchmark.
+ * The median and the minimum over the runs are reported.
+ */
+#define CR_BN_NOF_RUNS 11
+
+/** The number of repetitions of the operation in one run of a packet accessor benchmark. */
+#define CR_BN_NOF_ACCESSOR_REPS 1000000
+
+/** The number of repetitions of the operation in one run of a packet pool benchmark. */
+#define CR_BN_NOF_POOL_REPS 200000
+
+/** The number of repetitions of the operation in one run of a serialization benchmark. */
+#define CR_BN_NOF_SERIALIZE_REPS 200000
+
+#endif /* CRBN_CONSTANTS_H_ */
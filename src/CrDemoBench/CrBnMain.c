@@ -0,0 +1,299 @@
+/**
+ * @file
+ * @ingroup crDemoBench
+ * Main program for the micro-benchmarks of the CORDET Demo.
+ * The micro-benchmarks measure the cost of the operations which are executed for
+ * every command and report by the demo applications:
+ * - the allocation and release of a packet (<code>::CrFwPcktMake</code> and
+ *   <code>::CrFwPcktRelease</code>) for each packet size class and, for the small
+ *   packets, at several fill levels of the packet pool (when the small packets are
+ *   exhausted, the allocation falls back to the medium packets);
+ * - every getter and setter of the packet header (<code>CrFwPckt.h</code>);
+ * - the Serialize Operations of the OutComponents of the demo applications
+ *   (<code>::CrMaOutCmpSetTempLimitSerialize</code> and
+ *   <code>::CrDaOutCmpTempViolationSerialize</code>) and the creation and release of an
+ *   OutComponent by the OutFactory.
+ * .
+ * The micro-benchmarks are built with the configuration of the Master Application and
+ * with the same packet options as the demo applications (see
+ * <code>CompileAndLinkBench.sh</code>): the header accessors are measured as the demo
+ * applications call them, i.e. inline if <code>#CR_FW_PCKT_INLINE</code> is set and
+ * out-of-line otherwise.
+ *
+ * Each benchmark executes its operation a fixed number of times in one run and it is
+ * run <code>#CR_BN_NOF_RUNS</code> times after one untimed warm-up run.
+ * The median and the minimum over the runs of the time per operation are printed in
+ * nanoseconds.
+ * A compiler barrier follows each operation so that the operations on the same packet
+ * are not merged or hoisted out of the loop.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+/* Include Benchmark Files */
+#include "CrBnConstants.h"
+/* Include Common Demo Files */
+#include "CrDaConstants.h"
+#include "CrDaOutCmpTempViolation.h"
+/* Include Master Demo Files */
+#include "CrMaOutCmpSetTempLimit.h"
+/* Include FW Profile files */
+#include "FwSmConstants.h"
+#include "FwSmConfig.h"
+#include "FwSmCore.h"
+/* Include framework files */
+#include "BaseCmp/CrFwBaseCmp.h"
+#include "OutFactory/CrFwOutFactory.h"
+#include "OutCmp/CrFwOutCmp.h"
+#include "Pckt/CrFwPckt.h"
+#include "UtilityFunctions/CrFwUtilityFunctions.h"
+/* Include configuration files */
+#include "CrFwPcktInline.h"
+#include "CrFwPcktHeader.h"
+#include "CrFwPcktArena.h"
+
+/** The fill levels of the small packets in percent at which the packet pool is measured. */
+static const unsigned int fillLevel[] = {0, 50, 90, 100};
+
+/** Type for the operation of a benchmark: it executes the operation the argument number of times. */
+typedef void (*CrBnOp_t)(unsigned int nOfReps);
+
+/**
+ * Define the operation of a benchmark.
+ * The operation executes a statement followed by a compiler barrier.
+ * @param name the name of the operation
+ * @param stmt the statement (it may use the repetition counter <code>k</code>)
+ */
+#define CR_BN_DEFINE_OP(name, stmt) \
+	static void name(unsigned int nOfReps) { \
+		unsigned int k; \
+		for (k=0; k<nOfReps; k++) { \
+			stmt; \
+			__asm__ __volatile__("" ::: "memory"); \
+		} \
+	}
+
+/** The packet on which the header accessors are measured. */
+static CrFwPckt_t benchPckt = NULL;
+
+/** The OutComponent on which the Serialize Operations are measured. */
+static FwSmDesc_t benchOutCmp = NULL;
+
+/** The length of the packets made by the packet pool benchmark. */
+static CrFwPcktLength_t benchLength = 0;
+
+/** The number of failed allocations of the packet pool benchmark. */
+static unsigned int benchNOfMakeFail = 0;
+
+/** The header of the packet decoded by the benchmark of <code>::CrFwPcktDecodeHeader</code>. */
+static CrFwPcktHeader_t benchHdr;
+
+/** The sink for the values read by the benchmarks (it prevents their elimination). */
+static volatile unsigned long benchSink = 0;
+
+/**
+ * Run a benchmark and print the median and the minimum time per operation.
+ * @param name the name of the benchmark
+ * @param op the operation of the benchmark
+ * @param nOfReps the number of repetitions of the operation in one run
+ */
+static void benchRun(const char* name, CrBnOp_t op, unsigned int nOfReps);
+
+/**
+ * Compare two durations (for <code>qsort</code>).
+ * @param a the first duration
+ * @param b the second duration
+ * @return a negative, zero or positive value if the first duration is shorter than,
+ * equal to or longer than the second one
+ */
+static int benchCompare(const void* a, const void* b);
+
+/** Operation of the packet pool benchmark: make and release a packet. */
+static void benchMakeRelease(unsigned int nOfReps) {
+	unsigned int k;
+	CrFwPckt_t pckt;
+
+	for (k=0; k<nOfReps; k++) {
+		pckt = CrFwPcktMake(benchLength);
+		if (pckt == NULL) {
+			benchNOfMakeFail++;
+			continue;
+		}
+		CrFwPcktRelease(pckt);
+		__asm__ __volatile__("" ::: "memory");
+	}
+}
+
+CR_BN_DEFINE_OP(benchGetLength, benchSink = CrFwPcktGetLength(benchPckt))
+CR_BN_DEFINE_OP(benchGetCmdRepType, benchSink = CrFwPcktGetCmdRepType(benchPckt))
+CR_BN_DEFINE_OP(benchSetCmdRepType, CrFwPcktSetCmdRepType(benchPckt, (k & 1) ? crCmdType : crRepType))
+CR_BN_DEFINE_OP(benchGetSeqCnt, benchSink = CrFwPcktGetSeqCnt(benchPckt))
+CR_BN_DEFINE_OP(benchSetSeqCnt, CrFwPcktSetSeqCnt(benchPckt, (CrFwSeqCnt_t)k))
+CR_BN_DEFINE_OP(benchGetTimeStamp, benchSink = CrFwPcktGetTimeStamp(benchPckt))
+CR_BN_DEFINE_OP(benchSetTimeStamp, CrFwPcktSetTimeStamp(benchPckt, (CrFwTimeStamp_t)k))
+CR_BN_DEFINE_OP(benchGetDiscriminant, benchSink = CrFwPcktGetDiscriminant(benchPckt))
+CR_BN_DEFINE_OP(benchSetDiscriminant, CrFwPcktSetDiscriminant(benchPckt, (CrFwDiscriminant_t)k))
+CR_BN_DEFINE_OP(benchGetServType, benchSink = CrFwPcktGetServType(benchPckt))
+CR_BN_DEFINE_OP(benchSetServType, CrFwPcktSetServType(benchPckt, (CrFwServType_t)k))
+CR_BN_DEFINE_OP(benchGetServSubType, benchSink = CrFwPcktGetServSubType(benchPckt))
+CR_BN_DEFINE_OP(benchSetServSubType, CrFwPcktSetServSubType(benchPckt, (CrFwServSubType_t)k))
+CR_BN_DEFINE_OP(benchGetDest, benchSink = CrFwPcktGetDest(benchPckt))
+CR_BN_DEFINE_OP(benchSetDest, CrFwPcktSetDest(benchPckt, (CrFwDestSrc_t)k))
+CR_BN_DEFINE_OP(benchGetSrc, benchSink = CrFwPcktGetSrc(benchPckt))
+CR_BN_DEFINE_OP(benchSetSrc, CrFwPcktSetSrc(benchPckt, (CrFwDestSrc_t)k))
+CR_BN_DEFINE_OP(benchGetCmdRepId, benchSink = CrFwPcktGetCmdRepId(benchPckt))
+CR_BN_DEFINE_OP(benchSetCmdRepId, CrFwPcktSetCmdRepId(benchPckt, (CrFwInstanceId_t)k))
+CR_BN_DEFINE_OP(benchSetAckLevel, CrFwPcktSetAckLevel(benchPckt, k & 1, k & 2, k & 4, k & 8))
+CR_BN_DEFINE_OP(benchIsAcceptAck, benchSink = CrFwPcktIsAcceptAck(benchPckt))
+CR_BN_DEFINE_OP(benchIsStartAck, benchSink = CrFwPcktIsStartAck(benchPckt))
+CR_BN_DEFINE_OP(benchIsProgressAck, benchSink = CrFwPcktIsProgressAck(benchPckt))
+CR_BN_DEFINE_OP(benchIsTermAck, benchSink = CrFwPcktIsTermAck(benchPckt))
+CR_BN_DEFINE_OP(benchGetParStart, benchSink = (unsigned long)CrFwPcktGetParStart(benchPckt))
+CR_BN_DEFINE_OP(benchGetParLength, benchSink = CrFwPcktGetParLength(benchPckt))
+CR_BN_DEFINE_OP(benchGetGroup, benchSink = CrFwPcktGetGroup(benchPckt))
+CR_BN_DEFINE_OP(benchSetGroup, CrFwPcktSetGroup(benchPckt, (CrFwGroup_t)(k & 1)))
+CR_BN_DEFINE_OP(benchDecodeHeader, CrFwPcktDecodeHeader(benchPckt, &benchHdr))
+CR_BN_DEFINE_OP(benchSetTempLimitSerialize, CrMaOutCmpSetTempLimitSerialize(benchOutCmp))
+CR_BN_DEFINE_OP(benchTempViolationSerialize, CrDaOutCmpTempViolationSerialize(benchOutCmp))
+CR_BN_DEFINE_OP(benchMakeReleaseOutCmp,
+                CrFwOutFactoryReleaseOutCmp(CrFwOutFactoryMakeOutCmp(CR_DA_SERV_TYPE, CR_DA_SERV_SUBTYPE_SET, 0, 0)))
+
+/**
+ * Main program for the micro-benchmarks.
+ * @return EXIT_SUCCESS if the benchmarks could be executed; EXIT_FAILURE otherwise
+ */
+int main() {
+	CrFwPckt_t fill[CR_FW_NOF_SMALL_PCKTS];
+	FwSmDesc_t outFactory;
+	unsigned int i, j, nOfFill;
+	char name[64];
+
+	printf("BN: Packet accessors: %s, %s layout; %d runs per benchmark\n",
+	       (CR_FW_PCKT_INLINE == 1) ? "inline" : "out-of-line",
+	       (CR_FW_PCKT_COMPACT_LAYOUT == 1) ? "compact" : "standard", CR_BN_NOF_RUNS);
+
+	/* The pages of the packet pool are faulted in before the first benchmark */
+	CrFwPcktArenaInit();
+
+	/* Packet pool: one packet of each size class from the empty pool */
+	benchLength = CR_FW_SMALL_PCKT_LENGTH;
+	benchRun("make/release small", &benchMakeRelease, CR_BN_NOF_POOL_REPS);
+	benchLength = CR_FW_MEDIUM_PCKT_LENGTH;
+	benchRun("make/release medium", &benchMakeRelease, CR_BN_NOF_POOL_REPS);
+	benchLength = CR_FW_LARGE_PCKT_LENGTH;
+	benchRun("make/release large", &benchMakeRelease, CR_BN_NOF_POOL_REPS);
+
+	/* Packet pool: small packets at increasing fill levels of the small packets */
+	benchLength = CR_FW_SMALL_PCKT_LENGTH;
+	for (i=0; i<sizeof(fillLevel)/sizeof(fillLevel[0]); i++) {
+		nOfFill = (fillLevel[i] * CR_FW_NOF_SMALL_PCKTS) / 100;
+		for (j=0; j<nOfFill; j++)
+			if ((fill[j] = CrFwPcktMake(CR_FW_SMALL_PCKT_LENGTH)) == NULL)
+				break;
+		nOfFill = j;
+		benchNOfMakeFail = 0;
+		snprintf(name, sizeof(name), "make/release small at %u%% fill", fillLevel[i]);
+		benchRun(name, &benchMakeRelease, CR_BN_NOF_POOL_REPS);
+		if (benchNOfMakeFail > 0)
+			printf("BN: %u allocations failed (the packet partition is exhausted)\n", benchNOfMakeFail);
+		for (j=0; j<nOfFill; j++)
+			CrFwPcktRelease(fill[j]);
+	}
+
+	/* Packet header accessors */
+	benchPckt = CrFwPcktMake(CR_FW_SMALL_PCKT_LENGTH);
+	if (benchPckt == NULL) {
+		printf("BN: No packet available for the accessor benchmarks\n");
+		return EXIT_FAILURE;
+	}
+	benchRun("CrFwPcktGetLength", &benchGetLength, CR_BN_NOF_ACCESSOR_REPS);
+	benchRun("CrFwPcktGetCmdRepType", &benchGetCmdRepType, CR_BN_NOF_ACCESSOR_REPS);
+	benchRun("CrFwPcktSetCmdRepType", &benchSetCmdRepType, CR_BN_NOF_ACCESSOR_REPS);
+	benchRun("CrFwPcktGetSeqCnt", &benchGetSeqCnt, CR_BN_NOF_ACCESSOR_REPS);
+	benchRun("CrFwPcktSetSeqCnt", &benchSetSeqCnt, CR_BN_NOF_ACCESSOR_REPS);
+	benchRun("CrFwPcktGetTimeStamp", &benchGetTimeStamp, CR_BN_NOF_ACCESSOR_REPS);
+	benchRun("CrFwPcktSetTimeStamp", &benchSetTimeStamp, CR_BN_NOF_ACCESSOR_REPS);
+	benchRun("CrFwPcktGetDiscriminant", &benchGetDiscriminant, CR_BN_NOF_ACCESSOR_REPS);
+	benchRun("CrFwPcktSetDiscriminant", &benchSetDiscriminant, CR_BN_NOF_ACCESSOR_REPS);
+	benchRun("CrFwPcktGetServType", &benchGetServType, CR_BN_NOF_ACCESSOR_REPS);
+	benchRun("CrFwPcktSetServType", &benchSetServType, CR_BN_NOF_ACCESSOR_REPS);
+	benchRun("CrFwPcktGetServSubType", &benchGetServSubType, CR_BN_NOF_ACCESSOR_REPS);
+	benchRun("CrFwPcktSetServSubType", &benchSetServSubType, CR_BN_NOF_ACCESSOR_REPS);
+	benchRun("CrFwPcktGetDest", &benchGetDest, CR_BN_NOF_ACCESSOR_REPS);
+	benchRun("CrFwPcktSetDest", &benchSetDest, CR_BN_NOF_ACCESSOR_REPS);
+	benchRun("CrFwPcktGetSrc", &benchGetSrc, CR_BN_NOF_ACCESSOR_REPS);
+	benchRun("CrFwPcktSetSrc", &benchSetSrc, CR_BN_NOF_ACCESSOR_REPS);
+	benchRun("CrFwPcktGetCmdRepId", &benchGetCmdRepId, CR_BN_NOF_ACCESSOR_REPS);
+	benchRun("CrFwPcktSetCmdRepId", &benchSetCmdRepId, CR_BN_NOF_ACCESSOR_REPS);
+	benchRun("CrFwPcktSetAckLevel", &benchSetAckLevel, CR_BN_NOF_ACCESSOR_REPS);
+	benchRun("CrFwPcktIsAcceptAck", &benchIsAcceptAck, CR_BN_NOF_ACCESSOR_REPS);
+	benchRun("CrFwPcktIsStartAck", &benchIsStartAck, CR_BN_NOF_ACCESSOR_REPS);
+	benchRun("CrFwPcktIsProgressAck", &benchIsProgressAck, CR_BN_NOF_ACCESSOR_REPS);
+	benchRun("CrFwPcktIsTermAck", &benchIsTermAck, CR_BN_NOF_ACCESSOR_REPS);
+	benchRun("CrFwPcktGetParStart", &benchGetParStart, CR_BN_NOF_ACCESSOR_REPS);
+	benchRun("CrFwPcktGetParLength", &benchGetParLength, CR_BN_NOF_ACCESSOR_REPS);
+	benchRun("CrFwPcktGetGroup", &benchGetGroup, CR_BN_NOF_ACCESSOR_REPS);
+	benchRun("CrFwPcktSetGroup", &benchSetGroup, CR_BN_NOF_ACCESSOR_REPS);
+	benchRun("CrFwPcktDecodeHeader", &benchDecodeHeader, CR_BN_NOF_ACCESSOR_REPS);
+	CrFwPcktRelease(benchPckt);
+
+	/* Serialize Operations of the OutComponents */
+	outFactory = CrFwOutFactoryMake();
+	CrFwCmpInit(outFactory);
+	CrFwCmpReset(outFactory);
+	if (!CrFwCmpIsInConfigured(outFactory)) {
+		printf("BN: The OutFactory could not be configured\n");
+		return EXIT_FAILURE;
+	}
+	benchOutCmp = CrFwOutFactoryMakeOutCmp(CR_DA_SERV_TYPE, CR_DA_SERV_SUBTYPE_SET, 0, 0);
+	if (benchOutCmp == NULL) {
+		printf("BN: No OutComponent available for the serialization benchmarks\n");
+		return EXIT_FAILURE;
+	}
+	benchRun("CrMaOutCmpSetTempLimitSerialize", &benchSetTempLimitSerialize, CR_BN_NOF_SERIALIZE_REPS);
+	benchRun("CrDaOutCmpTempViolationSerialize", &benchTempViolationSerialize, CR_BN_NOF_SERIALIZE_REPS);
+	CrFwOutFactoryReleaseOutCmp(benchOutCmp);
+	benchRun("OutFactory make/release OutCmp", &benchMakeReleaseOutCmp, CR_BN_NOF_SERIALIZE_REPS);
+
+	if (CrFwGetAppErrCode() != crNoAppErr)
+		printf("BN: Application Error Code is set and is equal to: %d\n", CrFwGetAppErrCode());
+	return EXIT_SUCCESS;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void benchRun(const char* name, CrBnOp_t op, unsigned int nOfReps) {
+	struct timespec start, end;
+	double nsPerOp[CR_BN_NOF_RUNS];
+	unsigned int run;
+
+	op(nOfReps);	/* warm-up */
+	for (run=0; run<CR_BN_NOF_RUNS; run++) {
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		op(nOfReps);
+		clock_gettime(CLOCK_MONOTONIC, &end);
+		nsPerOp[run] = ((double)(end.tv_sec - start.tv_sec) * 1e9 + (double)(end.tv_nsec - start.tv_nsec)) / nOfReps;
+	}
+	qsort(nsPerOp, CR_BN_NOF_RUNS, sizeof(nsPerOp[0]), &benchCompare);
+	printf("BN: %-40s %9.2f ns/op (min %9.2f)\n", name, nsPerOp[CR_BN_NOF_RUNS/2], nsPerOp[0]);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static int benchCompare(const void* a, const void* b) {
+	double x = *(const double*)a;
+	double y = *(const double*)b;
+
+	return (x > y) - (x < y);
+}
@@ -0,0 +1,118 @@
+/**
+ * @file
+ * @ingroup crDemoMaster
+ * Interface for the packet capture of the demo applications of the CORDET Demo.
+ * If the packet capture is selected (see <code>#CR_DA_CAPTURE</code>), the transports
+ * record every packet which they hand over to the middleware
+ * (<code>::CrDaCaptureTx</code>) and which they collect from it
+ * (<code>::CrDaCaptureRx</code>) in a capture file.
+ * The capture can be replayed into the InStreams of an application by the replay
+ * transport of <code>CrDaReplay.h</code>.
+ *
+ * The capture file is written through a shared memory mapping: recording a packet is a
+ * copy into the mapping and it does not cost a system call.
+ * The file is extended by <code>#CR_DA_CAPTURE_CHUNK_SIZE</code> bytes whenever the
+ * mapping is full and it is truncated to its content when the capture is stopped.
+ * The file starts with a header (<code>::CrDaCaptureHeader_t</code>) which is followed
+ * by the records: each record (<code>::CrDaCaptureRec_t</code>) is followed by the bytes
+ * of its packet which are padded to a multiple of 8 bytes.
+ * The capture ends at the end of the file or at a record of length zero (this is the
+ * case for the unused part of the last chunk if the application did not stop the
+ * capture).
+ *
+ * The capture functions must be called by the thread which owns the transport: the
+ * thread of the cycle scheduler or the I/O thread (see <code>CrDaIoThread.h</code>).
+ * If the capture is not selected or has not been started, they return immediately.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRDA_CAPTURE_H_
+#define CRDA_CAPTURE_H_
+
+#include <stdint.h>
+/* Include Framework Files */
+#include "CrFwConstants.h"
+/* Include Configuration Files */
+#include "CrFwUserConstants.h"
+#include "CrDaConstants.h"
+
+/** The identifier of the capture files ("CRCP"). */
+#define CR_DA_CAPTURE_MAGIC 0x43524350
+
+/** The version of the format of the capture files. */
+#define CR_DA_CAPTURE_VERSION 1
+
+/** The direction of a captured packet. */
+typedef enum {
+	/** A packet collected from the middleware. */
+	crDaCaptureRx = 1,
+	/** A packet handed over to the middleware. */
+	crDaCaptureTx = 2
+} CrDaCaptureDir_t;
+
+/** The header of a capture file. */
+typedef struct {
+	/** The identifier of the capture files (<code>#CR_DA_CAPTURE_MAGIC</code>). */
+	uint32_t magic;
+	/** The version of the format (<code>#CR_DA_CAPTURE_VERSION</code>). */
+	uint16_t version;
+	/** The identifier of the application which wrote the capture. */
+	uint16_t appId;
+	/** The number of records in the capture. */
+	uint64_t nOfRecs;
+} CrDaCaptureHeader_t;
+
+/** A record of a capture file. */
+typedef struct {
+	/** The time of the record in nanoseconds since the start of the capture. */
+	uint64_t time;
+	/** The length of the packet in bytes (zero at the end of the capture). */
+	uint32_t len;
+	/** The direction of the packet (see <code>::CrDaCaptureDir_t</code>). */
+	uint8_t dir;
+	/** Unused. */
+	uint8_t spare[3];
+} CrDaCaptureRec_t;
+
+/**
+ * Start the packet capture.
+ * The capture file <code>CrDaCapture_&lt;app&gt;.cap</code> is created in the working
+ * directory (an existing file is overwritten).
+ * Nothing is done if the packet capture is not selected (see <code>#CR_DA_CAPTURE</code>).
+ * @param app the name of the application (e.g. "MA")
+ * @param appId the identifier of the application
+ * @return 1 if the capture was started; 0 otherwise
+ */
+CrFwBool_t CrDaCaptureStart(const char* app, unsigned int appId);
+
+/**
+ * Record a packet which has been collected from the middleware.
+ * @param pckt the packet
+ */
+void CrDaCaptureRx(CrFwPckt_t pckt);
+
+/**
+ * Record a packet which has been handed over to the middleware.
+ * @param pckt the packet
+ */
+void CrDaCaptureTx(CrFwPckt_t pckt);
+
+/**
+ * Stop the packet capture and close the capture file.
+ * The number of captured packets is printed.
+ * Nothing is done if the capture is not running.
+ */
+void CrDaCaptureStop();
+
+#endif /* CRDA_CAPTURE_H_ */
@@ -0,0 +1,80 @@
+/**
+ * @file
+ * @ingroup crDemoMaster
+ * Interface for the integrity check of the packets on the socket connections of the
+ * CORDET Demo.
+ * TCP protects the bytes of a connection with a 16-bit checksum only and a packet which
+ * is damaged between the packet pool of the sender and the packet pool of the receiver
+ * (e.g. by a faulty buffer in between) is otherwise collected as if it were valid.
+ *
+ * If the integrity check is selected (see <code>#CR_DA_PCKT_CRC</code>), each packet
+ * travels on a socket connection with a trailer of <code>#CR_DA_PCKT_CRC_LENGTH</code>
+ * bytes which holds the CRC-32C (Castagnoli) of its bytes, most significant byte first:
+ * - the transmit queue computes the trailer when a packet is handed over to a socket
+ *   connection and writes it after the packet (see <code>CrDaTxQueue.h</code>);
+ * - the socket adapters recompute the CRC when they frame a packet and discard a packet
+ *   whose trailer does not match (it is counted by <code>::CrDaMetricsCrcError</code>).
+ * .
+ * The trailer is not part of the packet: it is neither stored in the packet pool nor
+ * counted in the packet length.
+ * The two ends of a connection must therefore be built with the same setting unless the
+ * capability handshake is selected (see <code>CrDaHandshake.h</code>): the trailer is then
+ * only used on the connections whose peers both support it.
+ *
+ * The CRC is computed with the CRC32 instructions of the processor where the compiler
+ * targets them (SSE4.2 on x86, e.g. with <code>-msse4.2</code>, or the CRC extension of
+ * ARMv8, e.g. with <code>-march=armv8-a+crc</code>) and otherwise with a table of the
+ * CRC of each byte value.
+ * All implementations compute the same CRC so that the two ends of a connection need
+ * not be built for the same processor.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRDA_CRC_H_
+#define CRDA_CRC_H_
+
+#include <stdint.h>
+/* Include Framework Files */
+#include "CrFwConstants.h"
+/* Include Configuration Files */
+#include "CrFwUserConstants.h"
+#include "CrDaConstants.h"
+
+/**
+ * Compute the CRC-32C of a sequence of bytes.
+ * @param buf the bytes
+ * @param n the number of bytes
+ * @return the CRC-32C
+ */
+uint32_t CrDaCrc32c(const unsigned char* buf, unsigned int n);
+
+/**
+ * Write the trailer of a packet.
+ * @param pckt the packet
+ * @param len the length of the packet
+ * @param trailer the location of the trailer (<code>#CR_DA_PCKT_CRC_LENGTH</code> bytes)
+ */
+void CrDaCrcWrite(const unsigned char* pckt, unsigned int len, unsigned char* trailer);
+
+/**
+ * Check the trailer of a packet.
+ * @param pckt the packet
+ * @param len the length of the packet
+ * @param trailer the trailer which was received after the packet
+ * (<code>#CR_DA_PCKT_CRC_LENGTH</code> bytes)
+ * @return 1 if the trailer matches the bytes of the packet; 0 otherwise
+ */
+CrFwBool_t CrDaCrcCheck(const unsigned char* pckt, unsigned int len, const unsigned char* trailer);
+
+#endif /* CRDA_CRC_H_ */
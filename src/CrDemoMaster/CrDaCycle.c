@@ -0,0 +1,248 @@
+/**
+ * @file
+ * @ingroup crDemoMaster
+ * Implementation of the cycle scheduler of the demo applications.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdio.h>
+#include <errno.h>
+#include <signal.h>
+#include <time.h>
+#include "CrDaCycle.h"
+#include "CrDaSim.h"
+
+/** The period of the control cycles in microseconds. */
+static unsigned long cyclePeriod = CR_DA_CYCLE_PERIOD_USEC;
+
+/** The Cycle Work Function. */
+static CrDaCycleWork_t cycleWork = NULL;
+
+/** The Cycle Wait Function. */
+static CrDaCycleWait_t cycleWait = NULL;
+
+/** The Event Work Function. */
+static CrDaCycleEvent_t cycleEvent = NULL;
+
+/** Flag which is set when the cycle scheduler is requested to stop (it may be set by a signal handler). */
+static volatile sig_atomic_t cycleStop = 0;
+
+/** The statistics of the cycle scheduler. */
+static CrDaCycleStats_t cycleStats = {0, 0, 0, 0, 0, 0, 0, 0};
+
+/**
+ * Advance a point in time by a number of microseconds.
+ * @param t the point in time
+ * @param usec the number of microseconds
+ */
+static void cycleAdvance(struct timespec* t, unsigned long long usec);
+
+/**
+ * Return the difference between two points in time.
+ * @param a the first point in time
+ * @param b the second point in time
+ * @return the difference <code>a-b</code> in nanoseconds
+ */
+static long long cycleDiff(const struct timespec* a, const struct timespec* b);
+
+#if (CR_DA_SIM == 1)
+/**
+ * Execute control cycles on the virtual clock of the simulation mode (see <code>CrDaSim.h</code>).
+ * @param nOfCycles the number of cycles to be executed
+ */
+static void cycleRunSim(unsigned int nOfCycles);
+
+/**
+ * Service the transport without waiting and process the packets which have arrived.
+ */
+static void cycleService();
+#endif
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaCycleSetPeriod(unsigned long period) {
+	cyclePeriod = period;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaCycleSetWork(CrDaCycleWork_t work) {
+	cycleWork = work;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaCycleSetWait(CrDaCycleWait_t wait) {
+	cycleWait = wait;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaCycleSetEvent(CrDaCycleEvent_t event) {
+	cycleEvent = event;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaCycleRun(unsigned int nOfCycles) {
+	struct timespec deadline, now;
+	long long late, remaining, jitter;
+	unsigned long long nOfSkipped;
+	unsigned int cycle;
+	CrFwBool_t arrived;
+
+#if (CR_DA_SIM == 1)
+	cycleRunSim(nOfCycles);
+	return;
+#endif
+	clock_gettime(CLOCK_MONOTONIC, &deadline);
+	for (cycle=1; (cycle<=nOfCycles) && !cycleStop; cycle++) {
+		if (cycleWork != NULL)
+			cycleWork(cycle);
+		cycleStats.nOfCycles++;
+
+		/* Free-running: service the transport without waiting and start the next cycle */
+		if (cyclePeriod == 0) {
+			if (cycleWait != NULL) {
+				do {
+					arrived = cycleWait(0);
+					if (arrived && (cycleEvent != NULL)) {
+						cycleEvent();
+						cycleStats.nOfEvents++;
+					}
+				} while (arrived && !cycleStop);
+			}
+			continue;
+		}
+		cycleAdvance(&deadline, cyclePeriod);
+
+		/* Skip the deadlines which expired while the work was running */
+		clock_gettime(CLOCK_MONOTONIC, &now);
+		late = cycleDiff(&now, &deadline);
+		if (late >= 0) {
+			nOfSkipped = (unsigned long long)late / (cyclePeriod * 1000ULL) + 1;
+			cycleStats.nOfOverruns++;
+			cycleStats.nOfSkipped += (unsigned int)nOfSkipped;
+			if ((unsigned long long)late / 1000 > cycleStats.maxOverrun)
+				cycleStats.maxOverrun = (unsigned long)(late / 1000);
+			printf("CrDaCycleRun: cycle %u overran its deadline by %lld us\n", cycle, late / 1000);
+			cycleAdvance(&deadline, nOfSkipped * cyclePeriod);
+		}
+
+		/* Service the transport for the whole milliseconds until the deadline and
+		 * process the packets which arrive in the meantime */
+		if (cycleWait != NULL) {
+			do {
+				remaining = cycleDiff(&deadline, &now);
+				if (remaining < 0)
+					remaining = 0;
+				arrived = cycleWait((unsigned int)(remaining / 1000000));
+				if (arrived && (cycleEvent != NULL)) {
+					cycleEvent();
+					cycleStats.nOfEvents++;
+				}
+				clock_gettime(CLOCK_MONOTONIC, &now);
+			} while (arrived && !cycleStop);
+		}
+
+		/* Sleep for the remainder on the absolute deadline (a stop request interrupts the sleep) */
+		while (!cycleStop && (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL) == EINTR))
+			;
+
+		/* Record the wake-up jitter of the next cycle */
+		if (!cycleStop) {
+			clock_gettime(CLOCK_MONOTONIC, &now);
+			jitter = cycleDiff(&now, &deadline);
+			if (jitter < 0)
+				jitter = 0;
+			cycleStats.nOfWakeUps++;
+			cycleStats.totJitter += (unsigned long long)jitter;
+			if ((unsigned long long)jitter > cycleStats.maxJitter)
+				cycleStats.maxJitter = (unsigned long)jitter;
+		}
+	}
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaCycleStop() {
+	cycleStop = 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaCycleIsStopped() {
+	return (cycleStop != 0);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrDaCycleWait_t CrDaCycleGetWait() {
+	return cycleWait;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaCycleGetStats(CrDaCycleStats_t* stats) {
+	*stats = cycleStats;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void cycleAdvance(struct timespec* t, unsigned long long usec) {
+	t->tv_sec += (time_t)(usec / 1000000);
+	t->tv_nsec += (long)(usec % 1000000) * 1000;
+	if (t->tv_nsec >= 1000000000) {
+		t->tv_sec++;
+		t->tv_nsec -= 1000000000;
+	}
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static long long cycleDiff(const struct timespec* a, const struct timespec* b) {
+	return (long long)(a->tv_sec - b->tv_sec) * 1000000000LL + (a->tv_nsec - b->tv_nsec);
+}
+
+#if (CR_DA_SIM == 1)
+/* ---------------------------------------------------------------------------------------------*/
+static void cycleRunSim(unsigned int nOfCycles) {
+	unsigned long long deadline;
+	unsigned int cycle;
+
+	if (!CrDaSimJoin())
+		return;
+	deadline = CrDaSimGetTime();
+	for (cycle=1; (cycle<=nOfCycles) && !cycleStop; cycle++) {
+		if (!CrDaSimWaitTurn())
+			return;
+		/* The packets which arrived during the wait of the previous cycle */
+		if (cycle > 1)
+			cycleService();
+		if (cycleWork != NULL)
+			cycleWork(cycle);
+		cycleStats.nOfCycles++;
+		deadline += cyclePeriod * 1000ULL;
+		CrDaSimEndTurn(deadline);
+	}
+
+	/* The wait of the last cycle (the turn is kept until the application leaves the simulation) */
+	if (!cycleStop && CrDaSimWaitTurn())
+		cycleService();
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void cycleService() {
+	CrFwBool_t arrived;
+
+	if (cycleWait == NULL)
+		return;
+	do {
+		arrived = cycleWait(0);
+		if (arrived && (cycleEvent != NULL)) {
+			cycleEvent();
+			cycleStats.nOfEvents++;
+		}
+	} while (arrived && !cycleStop);
+}
+#endif
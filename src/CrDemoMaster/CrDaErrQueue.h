@@ -0,0 +1,139 @@
+/**
+ * @file
+ * @ingroup crDemoMaster
+ * Interface for the error event queue of the demo applications of the CORDET Demo.
+ * The framework keeps one sticky application error code (<code>CrFwGetAppErrCode</code>)
+ * which the main loop of each application checks once per cycle: only the last error
+ * of a cycle is seen and the number of errors is lost.
+ *
+ * If the error event queue is selected (see <code>#CR_DA_ERR_QUEUE</code>), each
+ * application error and each error report of the demo applications is instead:
+ * - counted in a counter of its code (one atomic increment), and
+ * - recorded as an event (<code>::CrDaErrQueueEvent_t</code>) in a bounded queue of
+ *   <code>#CR_DA_ERR_QUEUE_N_OF_EVENTS</code> events.
+ * .
+ * The events are recorded by <code>::CrDaErrQueueSetAppErrCode</code> (which the packet
+ * pool uses in place of <code>CrFwSetAppErrCode</code>) and by
+ * <code>::CrDaErrQueueRepErr</code> (which the <code>CrFwRepErr*</code> functions
+ * call).
+ * The application errors which are set inside the framework are recorded when the
+ * sticky code is taken by <code>::CrDaErrQueueTakeAppErr</code>: once per cycle by the
+ * monitor and by the demo components which clear the code after a failed allocation.
+ *
+ * The queue has several producers (the thread of the control cycles, the I/O thread and
+ * the threads of the manager pool) and one consumer (the monitor which runs in the
+ * thread of the control cycles).
+ * Each slot of the queue carries a sequence number which tells whether it is free or
+ * holds an event: a producer claims the next slot with a compare-and-swap of the head
+ * and publishes its event with a release store of the sequence number; the consumer
+ * releases a slot with a release store of its sequence number after it has read the
+ * event.
+ * No side takes a lock and no side waits for the other: an event which finds the queue
+ * full is dropped (its error is still counted).
+ *
+ * The monitor (<code>::CrDaErrQueueMonitor</code>) drains up to
+ * <code>#CR_DA_ERR_QUEUE_BATCH</code> events per call and writes them to the log.
+ * The counters and the number of dropped events are printed by
+ * <code>::CrDaErrQueueReport</code>.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRDA_ERRQUEUE_H_
+#define CRDA_ERRQUEUE_H_
+
+/* Include Framework Files */
+#include "CrFwConstants.h"
+/* Include Configuration Files */
+#include "CrFwUserConstants.h"
+#include "CrDaConstants.h"
+
+/** The kinds of the events of the error event queue. */
+typedef enum {
+	/** An application error (the code is a <code>CrFwAppErrCode_t</code>). */
+	crDaErrQueueAppErr = 0,
+	/** An error report (the code is a <code>CrFwRepErrCode_t</code>). */
+	crDaErrQueueRepErr = 1
+} CrDaErrQueueKind_t;
+
+/** Type for an event of the error event queue. */
+typedef struct {
+	/** The kind of the event. */
+	CrDaErrQueueKind_t kind;
+	/** The error code. */
+	unsigned int code;
+	/** The type of the component which reported the error (zero for an application error). */
+	CrFwTypeId_t typeId;
+	/** The instance of the component which reported the error (zero for an application error). */
+	CrFwInstanceId_t instanceId;
+} CrDaErrQueueEvent_t;
+
+/**
+ * Set the application error code and record the application error.
+ * This function is called in place of <code>CrFwSetAppErrCode</code>.
+ * If the error event queue is not selected, it only sets the application error code.
+ * @param errCode the application error code
+ */
+void CrDaErrQueueSetAppErrCode(CrFwAppErrCode_t errCode);
+
+/**
+ * Record an error report.
+ * Nothing is done if the error event queue is not selected.
+ * @param errCode the error code
+ * @param typeId the type of the component which reported the error
+ * @param instanceId the instance of the component which reported the error
+ */
+void CrDaErrQueueRepErr(CrFwRepErrCode_t errCode, CrFwTypeId_t typeId, CrFwInstanceId_t instanceId);
+
+/**
+ * Take the sticky application error code: the code is cleared and, unless it was set by
+ * <code>::CrDaErrQueueSetAppErrCode</code> (which has already recorded it), the application
+ * error is recorded.
+ * Nothing is done if the error event queue is not selected.
+ */
+void CrDaErrQueueTakeAppErr();
+
+/**
+ * Remove the oldest events from the queue.
+ * This function must only be called by the consumer of the queue.
+ * @param ev the events (output)
+ * @param max the maximum number of events to be removed
+ * @return the number of events which have been removed
+ */
+unsigned int CrDaErrQueueDrain(CrDaErrQueueEvent_t* ev, unsigned int max);
+
+/**
+ * Take the sticky application error code and write up to <code>#CR_DA_ERR_QUEUE_BATCH</code>
+ * events of the queue to the log.
+ * This function is called once per cycle by the main loop.
+ * @param app the name of the application (e.g. "MA")
+ */
+void CrDaErrQueueMonitor(const char* app);
+
+/**
+ * Return the number of errors of a code which have been counted.
+ * @param kind the kind of the errors
+ * @param code the error code
+ * @return the number of errors
+ */
+unsigned long long CrDaErrQueueGetCount(CrDaErrQueueKind_t kind, unsigned int code);
+
+/**
+ * Print the codes whose errors have been counted and the number of events which were
+ * dropped because the queue was full.
+ * Nothing is printed if no error has been counted.
+ * @param app the name of the application (e.g. "MA")
+ */
+void CrDaErrQueueReport(const char* app);
+
+#endif /* CRDA_ERRQUEUE_H_ */
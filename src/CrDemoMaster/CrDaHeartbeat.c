@@ -0,0 +1,290 @@
+/**
+ * @file
+ * @ingroup crDemoMaster
+ * Implementation of the heartbeats and of the link liveness detection of the demo
+ * applications.
+ * The packet hooks count the packets collected from and handed over to each peer and
+ * the cycle compares the counts with those of the previous cycle: a peer has been silent
+ * (or a link has been idle) for as many cycles as its count has not changed.
+ * The packet hooks therefore do one atomic increment per packet and the liveness of the
+ * peers costs nothing on a busy link.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "CrDaHeartbeat.h"
+#include "CrDaLog.h"
+/* Include framework files */
+#include "Pckt/CrFwPckt.h"
+#include "CrFwTime.h"
+/* Include configuration files */
+#include "CrFwPcktInline.h"
+
+/** The number of application identifiers covered by the heartbeats (identifier 0 is not used). */
+#define CR_DA_HEARTBEAT_N_OF_APPS (CR_DA_SLAVE_2+1)
+
+#if (CR_DA_HEARTBEAT_PERIOD < 1) || (CR_DA_HEARTBEAT_MISS_COUNT < 1)
+#error "CR_DA_HEARTBEAT_PERIOD and CR_DA_HEARTBEAT_MISS_COUNT must be positive"
+#endif
+
+/** The liveness of a peer. */
+typedef enum {
+	/** No packet has yet been collected from the peer. */
+	crDaHeartbeatUnknown = 0,
+	/** A packet has been collected from the peer within the last miss count periods. */
+	crDaHeartbeatUp = 1,
+	/** No packet has been collected from the peer for the miss count periods. */
+	crDaHeartbeatDown = 2
+} CrDaHeartbeatState_t;
+
+/** The supervision of one peer. */
+typedef struct {
+	/** Flag which is set if the peer is supervised. */
+	CrFwBool_t supervised;
+	/** The liveness of the peer. */
+	CrDaHeartbeatState_t state;
+	/** The number of packets collected from the peer (written by the packet hooks). */
+	unsigned int nOfRx;
+	/** The number of packets handed over to the peer (written by the packet hooks). */
+	unsigned int nOfTx;
+	/** The number of packets collected from the peer at the previous cycle. */
+	unsigned int prevRx;
+	/** The number of packets handed over to the peer at the previous cycle. */
+	unsigned int prevTx;
+	/** The number of cycles since the last packet was collected from the peer. */
+	unsigned int silent;
+	/** The number of cycles since the last packet was handed over to the peer. */
+	unsigned int idle;
+	/** The cycle in which the last packet was collected from the peer. */
+	unsigned int lastSeen;
+	/** The number of times the peer was declared down. */
+	unsigned int nOfDowns;
+	/** The number of heartbeats sent to the peer. */
+	unsigned long long nOfBeatsTx;
+	/** The number of heartbeats received from the peer (written by the packet hooks). */
+	unsigned long long nOfBeatsRx;
+} CrDaHeartbeatPeer_t;
+
+/** The one-way delays of the packets collected from one application. */
+typedef struct {
+	/** The number of delays. */
+	unsigned long long nOfDelays;
+	/** The sum of the delays in nanoseconds. */
+	unsigned long long sum;
+	/** The minimum delay in nanoseconds. */
+	unsigned long long min;
+	/** The maximum delay in nanoseconds. */
+	unsigned long long max;
+} CrDaHeartbeatDelay_t;
+
+/** The supervision of the peers indexed by application identifier. */
+static CrDaHeartbeatPeer_t peer[CR_DA_HEARTBEAT_N_OF_APPS];
+
+/** The one-way delays indexed by the application identifier of the source. */
+static CrDaHeartbeatDelay_t delay[CR_DA_HEARTBEAT_N_OF_APPS];
+
+/** The function to which the heartbeats are handed over. */
+static CrFwPcktHandover_t handover = NULL;
+
+/** The Liveness Handler. */
+static CrDaHeartbeatHandler_t handler = NULL;
+
+/** The number of cycles executed since the start of the application. */
+static unsigned int nOfCycles = 0;
+
+/**
+ * Hand a heartbeat over to a peer.
+ * Nothing is sent if no packet can be allocated or if the transport does not accept the
+ * heartbeat (it is then sent at the next cycle).
+ * @param dest the peer
+ */
+static void heartbeatSend(CrFwDestSrc_t dest);
+
+/**
+ * Change the liveness of a peer, log the change and signal it to the Liveness Handler.
+ * @param dest the peer
+ * @param state the new liveness of the peer
+ */
+static void heartbeatSetState(CrFwDestSrc_t dest, CrDaHeartbeatState_t state);
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaHeartbeatSetHandover(CrFwPcktHandover_t h) {
+	handover = h;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaHeartbeatSetHandler(CrDaHeartbeatHandler_t h) {
+	handler = h;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaHeartbeatAddPeer(CrFwDestSrc_t dest) {
+	if ((dest >= CR_DA_HEARTBEAT_N_OF_APPS) || (dest == CR_FW_HOST_APP_ID))
+		return;
+	peer[dest].supervised = 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaHeartbeatRx(CrFwPckt_t pckt) {
+	CrFwDestSrc_t src = CrFwPcktGetSrc(pckt);
+	CrDaHeartbeatDelay_t* d;
+	CrFwTimeStamp_t age;
+	unsigned long long nsec;
+	CrFwBool_t isBeat;
+
+	if (src >= CR_DA_HEARTBEAT_N_OF_APPS)
+		return 0;
+	isBeat = ((CrFwPcktGetServType(pckt) == CR_DA_HEARTBEAT_SERV_TYPE) &&
+	          (CrFwPcktGetServSubType(pckt) == CR_DA_HEARTBEAT_SERV_SUBTYPE));
+	__atomic_fetch_add(&peer[src].nOfRx, 1, __ATOMIC_RELAXED);
+	if (isBeat)
+		peer[src].nOfBeatsRx++;
+
+	/* The age of the time stamp is computed modulo the wrap-around period of the time stamps */
+	age = (CrFwTimeStamp_t)(CrFwGetCurrentTimeStamp() - CrFwPcktGetTimeStamp(pckt));
+	if (age <= ((CrFwTimeStamp_t)~0U >> 1)) {
+		nsec = (unsigned long long)age << CR_FW_TIME_STAMP_SHIFT;
+		d = &delay[src];
+		if ((d->nOfDelays == 0) || (nsec < d->min))
+			d->min = nsec;
+		if (nsec > d->max)
+			d->max = nsec;
+		d->sum += nsec;
+		d->nOfDelays++;
+	}
+	return isBeat;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaHeartbeatTx(CrFwPckt_t pckt) {
+	CrFwDestSrc_t dest = CrFwPcktGetDest(pckt);
+
+	if (dest < CR_DA_HEARTBEAT_N_OF_APPS)
+		__atomic_fetch_add(&peer[dest].nOfTx, 1, __ATOMIC_RELAXED);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaHeartbeatCycle() {
+#if (CR_DA_HEARTBEAT == 1)
+	CrDaHeartbeatPeer_t* p;
+	unsigned int n;
+	CrFwDestSrc_t dest;
+
+	nOfCycles++;
+	for (dest=0; dest<CR_DA_HEARTBEAT_N_OF_APPS; dest++) {
+		p = &peer[dest];
+		if (!p->supervised)
+			continue;
+
+		/* A heartbeat is only sent on a link which has been idle for a whole period */
+		n = __atomic_load_n(&p->nOfTx, __ATOMIC_RELAXED);
+		p->idle = (n == p->prevTx) ? p->idle+1 : 0;
+		p->prevTx = n;
+		if (p->idle >= CR_DA_HEARTBEAT_PERIOD) {
+			heartbeatSend(dest);
+			p->idle = 0;
+		}
+
+		/* Any packet collected from the peer shows that it is alive */
+		n = __atomic_load_n(&p->nOfRx, __ATOMIC_RELAXED);
+		if (n != p->prevRx) {
+			p->prevRx = n;
+			p->silent = 0;
+			p->lastSeen = nOfCycles;
+			if (p->state != crDaHeartbeatUp)
+				heartbeatSetState(dest, crDaHeartbeatUp);
+			continue;
+		}
+		p->silent++;
+		if ((p->state == crDaHeartbeatUp) && (p->silent >= CR_DA_HEARTBEAT_PERIOD*CR_DA_HEARTBEAT_MISS_COUNT))
+			heartbeatSetState(dest, crDaHeartbeatDown);
+	}
+#endif
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaHeartbeatIsUp(CrFwDestSrc_t dest) {
+	if (dest >= CR_DA_HEARTBEAT_N_OF_APPS)
+		return 0;
+	return (peer[dest].supervised && (peer[dest].state == crDaHeartbeatUp));
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaHeartbeatReport(const char* app) {
+#if (CR_DA_HEARTBEAT == 1)
+	static const char* stateName[] = {"unknown", "up", "down"};
+	const CrDaHeartbeatPeer_t* p;
+	const CrDaHeartbeatDelay_t* d;
+	CrFwDestSrc_t i;
+
+	for (i=0; i<CR_DA_HEARTBEAT_N_OF_APPS; i++) {
+		p = &peer[i];
+		if (!p->supervised)
+			continue;
+		printf("%s: Heartbeat of %u: %s, last seen in cycle %u of %u, %u times down, %llu heartbeats sent, %llu received\n",
+		       app, i, stateName[p->state], p->lastSeen, nOfCycles, p->nOfDowns, p->nOfBeatsTx, p->nOfBeatsRx);
+	}
+	for (i=0; i<CR_DA_HEARTBEAT_N_OF_APPS; i++) {
+		d = &delay[i];
+		if (d->nOfDelays == 0)
+			continue;
+		printf("%s: One-way delay from %u: %llu packets, min/mean/max: %.1f/%.1f/%.1f us\n", app, i,
+		       d->nOfDelays, d->min / 1e3, (double)d->sum / d->nOfDelays / 1e3, d->max / 1e3);
+	}
+#else
+	(void)app;
+#endif
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void heartbeatSend(CrFwDestSrc_t dest) {
+	CrFwPckt_t pckt;
+
+	if (handover == NULL)
+		return;
+	pckt = CrFwPcktMake(CR_FW_PCKT_HEADER_LENGTH);
+	if (pckt == NULL)
+		return;
+
+	memset(pckt, 0, CR_FW_PCKT_HEADER_LENGTH);
+	CrFwPcktInlSetLength(pckt, CR_FW_PCKT_HEADER_LENGTH);
+	CrFwPcktSetCmdRepType(pckt, crRepType);
+	CrFwPcktSetServType(pckt, CR_DA_HEARTBEAT_SERV_TYPE);
+	CrFwPcktSetServSubType(pckt, CR_DA_HEARTBEAT_SERV_SUBTYPE);
+	CrFwPcktSetSrc(pckt, CR_FW_HOST_APP_ID);
+	CrFwPcktSetDest(pckt, dest);
+	CrFwPcktSetGroup(pckt, CR_DA_PCKT_GROUP_URGENT);
+	CrFwPcktSetTimeStamp(pckt, CrFwGetCurrentTimeStamp());
+
+	/* The transport copies or retains the packet */
+	if (handover(pckt))
+		peer[dest].nOfBeatsTx++;
+	CrFwPcktRelease(pckt);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void heartbeatSetState(CrFwDestSrc_t dest, CrDaHeartbeatState_t state) {
+	CrDaHeartbeatPeer_t* p = &peer[dest];
+
+	if (state == crDaHeartbeatDown) {
+		p->nOfDowns++;
+		CR_DA_LOG(crDaLogWarn, "CrDaHeartbeatCycle: link to %u is down (silent for %u cycles)\n", dest, p->silent);
+	} else if (p->state == crDaHeartbeatDown) {
+		CR_DA_LOG(crDaLogWarn, "CrDaHeartbeatCycle: link to %u is up again\n", dest);
+	}
+	p->state = state;
+	if (handler != NULL)
+		handler(dest, (state == crDaHeartbeatUp));
+}
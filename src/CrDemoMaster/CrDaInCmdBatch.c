@@ -0,0 +1,95 @@
+/**
+ * @file
+ * @ingroup crDemoMaster
+ * Implementation of the batched execution of the InCommands of the demo applications.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "CrDaInCmdBatch.h"
+/* Include configuration files */
+#include "CrFwInFactoryUserPar.h"
+/* Include framework files */
+#include "BaseCmp/CrFwBaseCmp.h"
+#include "InCmd/CrFwInCmd.h"
+
+/** The batch handler table. */
+static const CrDaInCmdBatchKind_t batchKind[CR_FW_INCMD_NKINDS] = CR_DA_INCMD_INIT_KIND_BATCH;
+
+/** The InCommands of the pending batch. */
+static CrDaInCmdBatchEntry_t batchEntry[CR_DA_INCMD_BATCH_MAX_N];
+
+/** The number of InCommands of the pending batch. */
+static unsigned int batchN = 0;
+
+/** The line of the batch handler table of the InCommands of the pending batch. */
+static unsigned int batchKindIndex = 0;
+
+/** The number of batches which have been executed. */
+static unsigned long long nOfBatches = 0;
+
+/** The number of InCommands which have been executed in batches. */
+static unsigned long long nOfBatched = 0;
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaInCmdBatchProgress(FwSmDesc_t smDesc) {
+	CrFwServType_t servType = CrFwInCmdGetServType(smDesc);
+	CrFwServSubType_t servSubType = CrFwInCmdGetServSubType(smDesc);
+	CrFwDiscriminant_t discriminant = CrFwInCmdGetDiscriminant(smDesc);
+	CrFwPcktLength_t parLength = CrFwInCmdGetParLength(smDesc);
+	unsigned int i;
+
+	for (i=0; i<CR_FW_INCMD_NKINDS; i++)
+		if ((batchKind[i].servType == servType) && (batchKind[i].servSubType == servSubType) &&
+		        (batchKind[i].discriminant == discriminant))
+			break;
+	if ((i == CR_FW_INCMD_NKINDS) || (batchKind[i].handler == NULL))
+		return;	/* the kind has no batch handler */
+
+	/* The InCommands of a batch are of one kind */
+	if ((batchN > 0) && (batchKindIndex != i))
+		CrDaInCmdBatchFlush();
+	batchKindIndex = i;
+
+	batchEntry[batchN].cmdId = CrFwCmpGetInstanceId(smDesc);
+	batchEntry[batchN].src = CrFwInCmdGetSrc(smDesc);
+	if (parLength > CR_DA_INCMD_BATCH_PAR_LENGTH)
+		parLength = CR_DA_INCMD_BATCH_PAR_LENGTH;
+	memset(batchEntry[batchN].par, 0, CR_DA_INCMD_BATCH_PAR_LENGTH);
+	memcpy(batchEntry[batchN].par, CrFwInCmdGetParStart(smDesc), parLength);
+	batchN++;
+	if (batchN == CR_DA_INCMD_BATCH_MAX_N)
+		CrDaInCmdBatchFlush();
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaInCmdBatchFlush() {
+	if (batchN == 0)
+		return;	/* the batch is always empty if the batched execution is not selected */
+	batchKind[batchKindIndex].handler(batchEntry, batchN);
+	nOfBatches++;
+	nOfBatched += batchN;
+	batchN = 0;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaInCmdBatchReport(const char* app) {
+#if (CR_DA_INCMD_BATCH == 1)
+	printf("%s: InCommand batches: %llu batches of up to %d InCommands (%.1f on average)\n", app,
+	       nOfBatches, CR_DA_INCMD_BATCH_MAX_N, (nOfBatches == 0 ? 0.0 : (double)nOfBatched / nOfBatches));
+#else
+	(void)app;
+#endif
+}
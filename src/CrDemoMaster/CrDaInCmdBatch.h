@@ -0,0 +1,109 @@
+/**
+ * @file
+ * @ingroup crDemoMaster
+ * Interface for the batched execution of the InCommands of the demo applications of the
+ * CORDET Demo.
+ * An InManager executes each of its InCommands on its own: a burst of InCommands of the
+ * same kind (e.g. the commands which enable and disable the temperature monitoring)
+ * therefore executes the Progress Action of the kind once for each InCommand.
+ *
+ * If the batched execution is selected (see <code>#CR_DA_INCMD_BATCH</code>), a kind
+ * of InCommand may have a batch handler (<code>::CrDaInCmdBatchHandler_t</code>) in the
+ * table <code>#CR_DA_INCMD_INIT_KIND_BATCH</code> which extends the kind descriptor of
+ * the InFactory (<code>#CR_FW_INCMD_INIT_KIND_DESC</code>).
+ * The Progress Action of such a kind is <code>::CrDaInCmdBatchProgress</code> which adds
+ * the InCommand (its identifier, its source and the start of its parameter area) to the
+ * pending batch.
+ * The pending batch is executed by one call to the batch handler of its kind:
+ * - when an InCommand of another kind is added to the batch (the InCommands are therefore
+ *   executed in the order in which they arrived);
+ * - when the batch holds <code>#CR_DA_INCMD_BATCH_MAX_N</code> InCommands; or
+ * - at the end of the execution of the InManagers (<code>::CrDaInCmdBatchFlush</code>).
+ * .
+ * The InCommands of a batch have completed their Progress Action when they are added to
+ * the batch and they are released by their InManager before the batch is executed.
+ * A batch handler must therefore not fail and it may only use the data of the entries of
+ * the batch.
+ * The kinds without a batch handler are executed by their own Progress Action.
+ *
+ * The acknowledgements of the InCommands are not affected: the acknowledgement of the
+ * successful start of an InCommand is sent before its Progress Action is executed.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRDA_INCMDBATCH_H_
+#define CRDA_INCMDBATCH_H_
+
+/* Include Framework Files */
+#include "CrFwConstants.h"
+/* Include Configuration Files */
+#include "CrFwUserConstants.h"
+#include "CrDaConstants.h"
+/* Include FW Profile files */
+#include "FwSmConstants.h"
+
+/** The entry of one InCommand in a batch. */
+typedef struct {
+	/** The instance identifier of the InCommand. */
+	CrFwInstanceId_t cmdId;
+	/** The source of the InCommand. */
+	CrFwDestSrc_t src;
+	/** The first <code>#CR_DA_INCMD_BATCH_PAR_LENGTH</code> bytes of the parameter area of the InCommand. */
+	char par[CR_DA_INCMD_BATCH_PAR_LENGTH];
+} CrDaInCmdBatchEntry_t;
+
+/**
+ * Type for the batch handler of a kind of InCommand.
+ * @param entry the entries of the InCommands of the batch (in the order of their arrival)
+ * @param n the number of InCommands of the batch (at least one)
+ */
+typedef void (*CrDaInCmdBatchHandler_t)(const CrDaInCmdBatchEntry_t* entry, unsigned int n);
+
+/** Type for a line of the batch handler table (<code>#CR_DA_INCMD_INIT_KIND_BATCH</code>). */
+typedef struct {
+	/** The service type. */
+	CrFwServType_t servType;
+	/** The service sub-type. */
+	CrFwServSubType_t servSubType;
+	/** The discriminant value. */
+	CrFwDiscriminant_t discriminant;
+	/** The batch handler of the kind or NULL if the InCommands of the kind are not batched. */
+	CrDaInCmdBatchHandler_t handler;
+} CrDaInCmdBatchKind_t;
+
+/**
+ * Progress Action of the kinds of InCommands which have a batch handler.
+ * The InCommand is added to the pending batch (the pending batch is first executed if its
+ * InCommands are of another kind) and the batch is executed if it is full.
+ * @param smDesc the descriptor of the InCommand
+ */
+void CrDaInCmdBatchProgress(FwSmDesc_t smDesc);
+
+/**
+ * Execute the pending batch if it holds at least one InCommand.
+ * This function must be called by the demo applications after the execution of their
+ * InManagers.
+ * Nothing is done if the batched execution is not selected.
+ */
+void CrDaInCmdBatchFlush();
+
+/**
+ * Print the number of batches which have been executed and the number of InCommands
+ * which they held.
+ * Nothing is printed if the batched execution is not selected.
+ * @param app the name of the application (e.g. "S1")
+ */
+void CrDaInCmdBatchReport(const char* app);
+
+#endif /* CRDA_INCMDBATCH_H_ */
@@ -0,0 +1,152 @@
+/**
+ * @file
+ * @ingroup crDemoMaster
+ * Implementation of the express lane of the InCommands of the demo applications.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdio.h>
+#include "CrDaInCmdExpress.h"
+#include "CrDaInCmdBatch.h"
+#include "CrDaInManagerChain.h"
+#include "CrDaSmProf.h"
+/* Include configuration files */
+#include "CrFwInFactoryUserPar.h"
+#include "CrFwInManagerUserPar.h"
+/* Include FW Profile files */
+#include "FwSmConfig.h"
+#include "FwSmCore.h"
+/* Include framework files */
+#include "BaseCmp/CrFwBaseCmp.h"
+#include "InManager/CrFwInManager.h"
+
+#if (CR_DA_INCMD_EXPRESS == 1)
+/** The express table. */
+static const CrDaInCmdExpressKind_t expressKind[CR_FW_INCMD_NKINDS] = CR_DA_INCMD_INIT_KIND_EXPRESS;
+
+/** The number of express InCommands which the hand-offs may still execute in the current cycle. */
+static unsigned int budget = CR_DA_INCMD_EXPRESS_BUDGET;
+
+/** Flag which is set when a hand-off of the current cycle has exceeded the budget. */
+static CrFwBool_t isOverBudget = 0;
+
+/** The number of express InCommands which have been loaded into the express InManager. */
+static unsigned long long nOfSelected = 0;
+
+/** The number of express InCommands which have been loaded into their normal InManager. */
+static unsigned long long nOfOverflows = 0;
+
+/** The number of express InCommands which have been executed by the hand-offs. */
+static unsigned long long nOfHandedOff = 0;
+
+/** The number of executions of the express InManager by the hand-offs. */
+static unsigned long long nOfHandOffs = 0;
+
+/** The number of cycles in which the budget of the hand-offs has been exceeded. */
+static unsigned long long nOfOverBudget = 0;
+#endif
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaInCmdExpressInit() {
+#if (CR_DA_INCMD_EXPRESS == 1)
+	FwSmDesc_t inManager = CrFwInManagerMake(CR_DA_INMANAGER_EXPRESS);
+
+	CrFwCmpInit(inManager);
+	if (!CrFwCmpIsInInitialized(inManager))
+		return 0;
+	CrFwCmpReset(inManager);
+	if (!CrFwCmpIsInConfigured(inManager))
+		return 0;
+	budget = CR_DA_INCMD_EXPRESS_BUDGET;
+	isOverBudget = 0;
+#endif
+	return 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwInstanceId_t CrDaInCmdExpressSelect(CrFwServType_t servType, CrFwServSubType_t servSubType,
+                                        CrFwDiscriminant_t discriminant, CrFwCmdRepType_t cmdRepFlag) {
+#if (CR_DA_INCMD_EXPRESS == 1)
+	FwSmDesc_t inManager;
+	unsigned int i;
+
+	if (cmdRepFlag == crCmdType)
+		for (i=0; i<CR_FW_INCMD_NKINDS; i++) {
+			if ((expressKind[i].servType != servType) || (expressKind[i].servSubType != servSubType) ||
+			        (expressKind[i].discriminant != discriminant))
+				continue;
+			if (!expressKind[i].isExpress)
+				break;
+			inManager = CrFwInManagerMake(CR_DA_INMANAGER_EXPRESS);
+			if (CrFwInManagerGetNOfPendingInCmp(inManager) >= CrFwInManagerGetPCRLSize(inManager)) {
+				nOfOverflows++;
+				break;
+			}
+			nOfSelected++;
+			return CR_DA_INMANAGER_EXPRESS;
+		}
+#endif
+	return CrDaInManagerChainSelect(servType, servSubType, discriminant, cmdRepFlag);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaInCmdExpressHandOff() {
+#if (CR_DA_INCMD_EXPRESS == 1)
+	FwSmDesc_t inManager = CrFwInManagerMake(CR_DA_INMANAGER_EXPRESS);
+	CrFwCounterU1_t nOfPending = CrFwInManagerGetNOfPendingInCmp(inManager);
+
+	if (nOfPending == 0)
+		return;
+	if (nOfPending > budget) {
+		isOverBudget = 1;	/* the InCommands wait for the execution of the InManagers */
+		return;
+	}
+	budget -= nOfPending;
+	CR_DA_SM_EXECUTE(inManager);
+	CrDaInCmdBatchFlush();
+	nOfHandOffs++;
+	nOfHandedOff += nOfPending;
+#endif
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaInCmdExpressExecute() {
+#if (CR_DA_INCMD_EXPRESS == 1)
+	FwSmDesc_t inManager = CrFwInManagerMake(CR_DA_INMANAGER_EXPRESS);
+
+	if (CrFwInManagerGetNOfPendingInCmp(inManager) > 0)
+		CR_DA_SM_EXECUTE(inManager);
+	CrDaInCmdExpressRelease();
+#endif
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaInCmdExpressRelease() {
+#if (CR_DA_INCMD_EXPRESS == 1)
+	if (isOverBudget)
+		nOfOverBudget++;
+	isOverBudget = 0;
+	budget = CR_DA_INCMD_EXPRESS_BUDGET;
+#endif
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaInCmdExpressReport(const char* app) {
+#if (CR_DA_INCMD_EXPRESS == 1)
+	printf("%s: Express lane: %llu InCommands (%llu overflows), %llu executed by %llu hand-offs, %llu cycles over budget\n",
+	       app, nOfSelected, nOfOverflows, nOfHandedOff, nOfHandOffs, nOfOverBudget);
+#else
+	(void)app;
+#endif
+}
@@ -0,0 +1,85 @@
+/**
+ * @file
+ * @ingroup crDemoMaster
+ * Interface for the InCommand and InReport pools of the demo applications of the CORDET Demo.
+ * The InLoader makes an InCommand or an InReport for each packet which it collects from
+ * an InStream and loads it into an InManager which releases it when it has been executed.
+ * The InFactory allocates them from two pools which are sized independently: one of
+ * <code>#CR_FW_INFACTORY_MAX_NOF_INCMD</code> InCommands and one of
+ * <code>#CR_FW_INFACTORY_MAX_NOF_INREP</code> InReports.
+ * An InCommand or an InReport which cannot be made is lost: its creation failure is
+ * reported through <code>::CrFwRepInCmdOutcomeCreFail</code> (for an InCommand) or
+ * through <code>::CrFwRepErr</code> with error code <code>::crInLoaderCreFail</code>
+ * (for an InReport).
+ * Each pool is therefore sized from the PCRL of the InManager which holds its
+ * components (see <code>CrFwInFactoryUserPar.h</code>) so that a full PCRL, and not the
+ * pool, limits the number of components which can be alive at the same time.
+ *
+ * For each pool, this module records the creation failures and the peak use.
+ * The InCommands and InReports are only made by the InLoader: the peak use is sampled by
+ * <code>::CrDaInCmpPoolSample</code> which the demo applications call after executing the
+ * InLoader in every control cycle (and before the InManagers release the components).
+ * The statistics are printed by <code>::CrDaInCmpPoolReport</code>.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRDA_INCMPPOOL_H_
+#define CRDA_INCMPPOOL_H_
+
+/* Include Framework Files */
+#include "CrFwConstants.h"
+/* Include Configuration Files */
+#include "CrFwUserConstants.h"
+
+/** The statistics of the InCommand or InReport pool. */
+typedef struct {
+	/** The largest number of components which have been allocated at the same time. */
+	unsigned int highWaterMark;
+	/** The number of components which could not be made. */
+	unsigned long long nOfCreFail;
+} CrDaInCmpPoolStats_t;
+
+/**
+ * Sample the number of allocated InCommands and InReports and update the high-water
+ * marks of the pools.
+ * This function must be called after the InLoader has been executed.
+ */
+void CrDaInCmpPoolSample();
+
+/**
+ * Count an InCommand which the InLoader could not make.
+ * This function is called by <code>::CrFwRepInCmdOutcomeCreFail</code>.
+ */
+void CrDaInCmpPoolInCmdCreFail();
+
+/**
+ * Count an InReport which the InLoader could not make.
+ * This function is called by <code>::CrFwRepErr</code>.
+ */
+void CrDaInCmpPoolInRepCreFail();
+
+/**
+ * Get the statistics of the InCommand pool and of the InReport pool.
+ * @param cmdStats the statistics of the InCommand pool (output)
+ * @param repStats the statistics of the InReport pool (output)
+ */
+void CrDaInCmpPoolGetStats(CrDaInCmpPoolStats_t* cmdStats, CrDaInCmpPoolStats_t* repStats);
+
+/**
+ * Print the statistics of the InCommand pool and of the InReport pool.
+ * @param app the name of the application (e.g. "MA")
+ */
+void CrDaInCmpPoolReport(const char* app);
+
+#endif /* CRDA_INCMPPOOL_H_ */
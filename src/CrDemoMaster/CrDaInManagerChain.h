@@ -0,0 +1,115 @@
+/**
+ * @file
+ * @ingroup crDemoMaster
+ * Interface for the InManager chains of the demo applications of the CORDET Demo.
+ * The InCommands and InReports which the InLoader loads are held in the Pending
+ * Command/Report List (PCRL) of an InManager until they terminate.
+ * The size of a PCRL is fixed (see <code>#CR_FW_INMANAGER_PCRLSIZE</code>) and the
+ * InLoader rejects the components which do not fit in the PCRL of their InManager.
+ *
+ * If the spill InManagers are selected (see <code>#CR_DA_INMANAGER_SPILL</code>), the
+ * last <code>#CR_DA_INMANAGER_NOF_SPILL</code> InManagers of an application are spill
+ * InManagers which are shared by its <code>#CR_DA_INMANAGER_NOF_PRIMARY</code> primary
+ * InManagers.
+ * Each primary InManager is the head of a chain of spill InManagers:
+ * - The InLoader loads a component into the last InManager of the chain of its primary
+ *   InManager (<code>::CrDaInManagerChainSelect</code> is the InManager Selection
+ *   Operation of the InLoader).
+ * - If that InManager is full, a spill InManager is taken from the free list and
+ *   appended to the chain.
+ *   Hence, the capacity of a primary InManager grows in steps of
+ *   <code>#CR_DA_INMANAGER_PCRLSIZE_SPILL</code> components up to the capacity of all
+ *   spill InManagers.
+ * - The InManagers of a chain are executed in the order of the chain
+ *   (<code>::CrDaInManagerChainExecute</code>) so that the components are executed in
+ *   the order in which they were loaded.
+ * - A spill InManager which no longer holds pending components after its execution is
+ *   removed from its chain and returned to the free list.
+ * .
+ * The chains and the free list are lists which are linked through an array of indices:
+ * a spill InManager is taken from or returned to the free list, and appended to or
+ * removed from a chain, in a constant time.
+ * Since a spill InManager is only executed while it holds pending components, the cost
+ * of the execution of a chain grows with the number of its pending components and not
+ * with the capacity of the spill InManagers.
+ *
+ * The components in the PCRL of an InManager are removed by the InManager as soon as
+ * they terminate.
+ * The InFactory must be able to make enough components to fill the primary and the
+ * spill InManagers (see <code>CrFwInFactoryUserPar.h</code>).
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRDA_INMANAGERCHAIN_H_
+#define CRDA_INMANAGERCHAIN_H_
+
+/* Include Framework Files */
+#include "CrFwConstants.h"
+/* Include Configuration Files */
+#include "CrFwUserConstants.h"
+#include "CrFwInManagerUserPar.h"
+#include "CrDaConstants.h"
+
+/**
+ * Initialize and configure the spill InManagers and make the free list hold all of them.
+ * This function must be called when the application starts after the primary
+ * InManagers have been configured.
+ * Nothing is done if the spill InManagers are not selected.
+ * @return 1 if all spill InManagers are configured; 0 otherwise
+ */
+CrFwBool_t CrDaInManagerChainInit();
+
+/**
+ * InManager Selection Operation of the InLoader.
+ * The primary InManager of a component is the one selected by the default operation of
+ * the InLoader (<code>::CrFwInLoaderDefGetInManager</code>).
+ * The function returns the last InManager of the chain of the primary InManager or, if
+ * that InManager is full, the spill InManager which it appends to the chain.
+ * If the free list is empty, the full InManager is returned (and the InLoader rejects
+ * the component).
+ * @param servType the service type of the component
+ * @param servSubType the service sub-type of the component
+ * @param discriminant the discriminant of the component
+ * @param cmdRepFlag the type of the component (command or report)
+ * @return the identifier of the InManager into which the component is loaded
+ */
+CrFwInstanceId_t CrDaInManagerChainSelect(CrFwServType_t servType, CrFwServSubType_t servSubType,
+        CrFwDiscriminant_t discriminant, CrFwCmdRepType_t cmdRepFlag);
+
+/**
+ * Execute a primary InManager and the spill InManagers of its chain, and return the
+ * spill InManagers which no longer hold pending components to the free list.
+ * If the spill InManagers are not selected, only the primary InManager is executed.
+ * @param primary the identifier of the primary InManager
+ */
+void CrDaInManagerChainExecute(CrFwInstanceId_t primary);
+
+/**
+ * Return the spill InManagers which no longer hold pending components to the free list.
+ * This function must be called after the InManagers have been executed by other means
+ * than <code>::CrDaInManagerChainExecute</code> (e.g. by the manager pool).
+ * Nothing is done if the spill InManagers are not selected.
+ */
+void CrDaInManagerChainRelease();
+
+/**
+ * Print the number of components which have been directed to spill InManagers, the
+ * number of spill InManagers which have been taken from the free list and the largest
+ * number of spill InManagers in use at the same time.
+ * Nothing is printed if the spill InManagers are not selected.
+ * @param app the name of the application (e.g. "MA")
+ */
+void CrDaInManagerChainReport(const char* app);
+
+#endif /* CRDA_INMANAGERCHAIN_H_ */
@@ -0,0 +1,111 @@
+/**
+ * @file
+ * @ingroup crDemoMaster
+ * Interface for the asynchronous leveled logging of the demo applications of the CORDET Demo.
+ * The messages which the demo applications print while they execute their control cycles
+ * are written with the macro <code>#CR_DA_LOG</code>.
+ * Each message has a level (see <code>::CrDaLogLevel_t</code>) and it is discarded:
+ * - at compile time if its level is above <code>#CR_DA_LOG_LEVEL</code> (the macro then
+ *   expands to no code at all);
+ * - at run time if its level is above the level set with <code>::CrDaLogSetLevel</code>
+ *   (by default, <code>#CR_DA_LOG_LEVEL</code>; the level is also taken from the
+ *   environment variable <code>CR_DA_LOG_LEVEL</code> when the logging thread is started).
+ * .
+ * While the logging thread is running (between <code>::CrDaLogStart</code> and
+ * <code>::CrDaLogStop</code>), a message is formatted by the thread which writes it and
+ * it is put into a queue of <code>#CR_DA_LOG_QUEUE_SIZE</code> messages which the
+ * logging thread writes to standard output.
+ * The writing thread only holds the lock of the queue to copy the message: it never
+ * waits for standard output and the timing of the control cycles therefore does not
+ * depend on how fast the terminal or the output file consumes the messages.
+ * If the queue is full, the message is discarded and counted; the number of discarded
+ * messages is printed when the logging thread is stopped.
+ *
+ * While the logging thread is not running, the messages are printed directly to
+ * standard output (this is the case for the messages printed before the control cycles
+ * start and after they have ended).
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRDA_LOG_H_
+#define CRDA_LOG_H_
+
+/* Include Framework Files */
+#include "CrFwConstants.h"
+/* Include Configuration Files */
+#include "CrFwUserConstants.h"
+#include "CrDaConstants.h"
+
+/** The levels of the log messages (a lower level is more important). */
+typedef enum {
+	/** An error. */
+	crDaLogError = 0,
+	/** An unexpected event which does not prevent the application from continuing. */
+	crDaLogWarn = 1,
+	/** The normal progress of the application (the output of the demo). */
+	crDaLogInfo = 2,
+	/** Details of the execution (e.g. the start of every control cycle). */
+	crDaLogDebug = 3
+} CrDaLogLevel_t;
+
+/**
+ * Write a log message.
+ * The message is discarded at compile time if its level is above
+ * <code>#CR_DA_LOG_LEVEL</code>; its arguments are then not evaluated.
+ * @param level the level of the message
+ * @param ... the format and the arguments of the message as for <code>printf</code>
+ */
+#define CR_DA_LOG(level, ...) \
+	do { \
+		if ((level) <= CR_DA_LOG_LEVEL) \
+			CrDaLogWrite((level), __VA_ARGS__); \
+	} while (0)
+
+/**
+ * Write a log message (use the macro <code>#CR_DA_LOG</code> instead).
+ * The message is discarded if its level is above the run-time level.
+ * @param level the level of the message
+ * @param format the format of the message as for <code>printf</code>
+ */
+void CrDaLogWrite(CrDaLogLevel_t level, const char* format, ...) __attribute__((format(printf, 2, 3)));
+
+/**
+ * Set the run-time level of the log messages.
+ * @param level the level above which the messages are discarded
+ */
+void CrDaLogSetLevel(CrDaLogLevel_t level);
+
+/**
+ * Return the run-time level of the log messages.
+ * @return the level above which the messages are discarded
+ */
+CrDaLogLevel_t CrDaLogGetLevel();
+
+/**
+ * Start the logging thread.
+ * If the environment variable <code>CR_DA_LOG_LEVEL</code> is set to a level (0 to 3),
+ * the run-time level is set to it.
+ * @return 1 if the logging thread was started; 0 otherwise (the messages are then
+ * printed directly)
+ */
+CrFwBool_t CrDaLogStart();
+
+/**
+ * Stop the logging thread after it has written all queued messages.
+ * The number of discarded messages is printed if it is not zero.
+ * Nothing is done if the logging thread is not running.
+ */
+void CrDaLogStop();
+
+#endif /* CRDA_LOG_H_ */
@@ -0,0 +1,240 @@
+/**
+ * @file
+ * @ingroup crDemoMaster
+ * Implementation of the manager pool of the demo applications.
+ * The worker threads wait for a new generation of the pool: the calling thread of
+ * <code>::CrDaMgrPoolExecute</code> starts a generation and then waits until all
+ * worker threads have executed their manager for this generation.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include "CrDaMgrPool.h"
+#include "CrDaSmExec.h"
+#include "CrDaSmProf.h"
+#include "CrDaThread.h"
+
+#if (CR_DA_MGR_POOL == 1)
+
+#if (CR_FW_PCKT_LOCK_FREE == 0)
+#error "The manager pool requires the lock-free packet pool (CR_FW_PCKT_LOCK_FREE)"
+#endif
+
+#include <stdio.h>
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+/* Include FW Profile files */
+#include "FwSmConstants.h"
+#include "FwSmConfig.h"
+#include "FwSmCore.h"
+/* Include framework files */
+#include "InManager/CrFwInManager.h"
+#include "OutManager/CrFwOutManager.h"
+/* Include configuration files */
+#include "CrFwInManagerUserPar.h"
+#include "CrFwOutManagerUserPar.h"
+
+/** The total number of managers of the application. */
+#define CR_DA_MGR_POOL_N_OF_MGR (CR_FW_NOF_INMANAGER + CR_FW_NOF_OUTMANAGER)
+
+/** Type for a worker thread of the manager pool. */
+typedef struct {
+	/** The manager executed by the worker thread. */
+	FwSmDesc_t mgr;
+	/** The worker thread. */
+	pthread_t thread;
+	/** The generation of the pool in which the worker thread was started. */
+	unsigned int gen;
+} CrDaMgrPoolWorker_t;
+
+/** The independence flags of the InManagers. */
+static const CrFwBool_t inManagerIndependent[CR_FW_NOF_INMANAGER] = CR_FW_INMANAGER_INDEPENDENT;
+
+/** The independence flags of the OutManagers. */
+static const CrFwBool_t outManagerIndependent[CR_FW_NOF_OUTMANAGER] = CR_FW_OUTMANAGER_INDEPENDENT;
+
+/** The worker threads. */
+static CrDaMgrPoolWorker_t worker[CR_DA_MGR_POOL_N_OF_MGR];
+
+/** The number of running worker threads. */
+static unsigned int nOfWorkers = 0;
+
+/** The managers executed by the calling thread (in their order of execution). */
+static FwSmDesc_t serialMgr[CR_DA_MGR_POOL_N_OF_MGR];
+
+/** The flags which mark the managers executed by the calling thread which are InManagers. */
+static CrFwBool_t serialIsInManager[CR_DA_MGR_POOL_N_OF_MGR];
+
+/** The number of managers executed by the calling thread. */
+static unsigned int nOfSerialMgr = 0;
+
+/** The mutex which protects the generation, the pending counter and the stop flag. */
+static pthread_mutex_t poolMutex = PTHREAD_MUTEX_INITIALIZER;
+
+/** The condition on which the worker threads wait for a new generation. */
+static pthread_cond_t poolStartCond = PTHREAD_COND_INITIALIZER;
+
+/** The condition on which the calling thread waits for the end of a generation. */
+static pthread_cond_t poolEndCond = PTHREAD_COND_INITIALIZER;
+
+/** The current generation of the pool. */
+static unsigned int poolGen = 0;
+
+/** The number of worker threads which have not yet executed their manager in the current generation. */
+static unsigned int poolPending = 0;
+
+/** Flag which requests the worker threads to terminate. */
+static CrFwBool_t poolStop = 0;
+
+/**
+ * The function executed by the worker threads.
+ * @param arg the worker (a pointer to a <code>CrDaMgrPoolWorker_t</code>)
+ * @return always NULL
+ */
+static void* mgrPoolRun(void* arg);
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaMgrPoolStart() {
+	cpu_set_t cpuSet;
+	long nOfCpus;
+	unsigned int i;
+	int err;
+	FwSmDesc_t mgr[CR_DA_MGR_POOL_N_OF_MGR];
+	CrFwBool_t independent[CR_DA_MGR_POOL_N_OF_MGR];
+	CrFwBool_t started = 1;
+
+	for (i=0; i<CR_FW_NOF_INMANAGER; i++) {
+		mgr[i] = CrFwInManagerMake((CrFwInstanceId_t)i);
+		independent[i] = inManagerIndependent[i];
+	}
+	for (i=0; i<CR_FW_NOF_OUTMANAGER; i++) {
+		mgr[CR_FW_NOF_INMANAGER+i] = CrFwOutManagerMake((CrFwInstanceId_t)i);
+		independent[CR_FW_NOF_INMANAGER+i] = outManagerIndependent[i];
+	}
+
+	nOfCpus = sysconf(_SC_NPROCESSORS_ONLN);
+	if (nOfCpus < 1)
+		nOfCpus = 1;
+	nOfWorkers = 0;
+	nOfSerialMgr = 0;
+	poolStop = 0;
+	for (i=0; i<CR_DA_MGR_POOL_N_OF_MGR; i++) {
+		if (!independent[i] || !started) {
+			serialMgr[nOfSerialMgr] = mgr[i];
+			serialIsInManager[nOfSerialMgr] = (i < CR_FW_NOF_INMANAGER);
+			nOfSerialMgr++;
+			continue;
+		}
+		worker[nOfWorkers].mgr = mgr[i];
+		worker[nOfWorkers].gen = poolGen;
+		err = pthread_create(&worker[nOfWorkers].thread, NULL, &mgrPoolRun, &worker[nOfWorkers]);
+		if (err != 0) {
+			errno = err;
+			perror("CrDaMgrPoolStart, thread creation");
+			started = 0;
+			serialMgr[nOfSerialMgr] = mgr[i];
+			serialIsInManager[nOfSerialMgr] = (i < CR_FW_NOF_INMANAGER);
+			nOfSerialMgr++;
+			continue;
+		}
+		/* Without a placement of the manager pool, each worker thread has its own core */
+		if ((CR_DA_THREAD_PLACEMENT == 0) || (CR_DA_THREAD_CPUS_MGR_POOL == 0)) {
+			CPU_ZERO(&cpuSet);
+			CPU_SET((unsigned int)((CR_DA_MGR_POOL_FIRST_CPU + nOfWorkers) % nOfCpus), &cpuSet);
+			err = pthread_setaffinity_np(worker[nOfWorkers].thread, sizeof(cpuSet), &cpuSet);
+			if (err != 0) {
+				errno = err;
+				perror("CrDaMgrPoolStart, thread pinning");
+			}
+		}
+		nOfWorkers++;
+	}
+	return started;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaMgrPoolStop() {
+	unsigned int i;
+
+	pthread_mutex_lock(&poolMutex);
+	poolStop = 1;
+	pthread_cond_broadcast(&poolStartCond);
+	pthread_mutex_unlock(&poolMutex);
+	for (i=0; i<nOfWorkers; i++)
+		pthread_join(worker[i].thread, NULL);
+	nOfWorkers = 0;
+	nOfSerialMgr = 0;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaMgrPoolExecute() {
+	unsigned int i;
+
+	/* Start a new generation of the worker threads */
+	if (nOfWorkers > 0) {
+		pthread_mutex_lock(&poolMutex);
+		poolPending = nOfWorkers;
+		poolGen++;
+		pthread_cond_broadcast(&poolStartCond);
+		pthread_mutex_unlock(&poolMutex);
+	}
+
+	for (i=0; i<nOfSerialMgr; i++)
+		if (serialIsInManager[i])
+			CrDaSmExecInManager(serialMgr[i]);
+		else
+			CrDaSmExecOutManager(serialMgr[i]);
+
+	/* Wait until all worker threads have executed their manager */
+	if (nOfWorkers > 0) {
+		pthread_mutex_lock(&poolMutex);
+		while (poolPending > 0)
+			pthread_cond_wait(&poolEndCond, &poolMutex);
+		pthread_mutex_unlock(&poolMutex);
+	}
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void* mgrPoolRun(void* arg) {
+	CrDaMgrPoolWorker_t* w = (CrDaMgrPoolWorker_t*)arg;
+	unsigned int gen;
+
+	CrDaThreadPlace(crDaThreadMgrPool);
+	pthread_mutex_lock(&poolMutex);
+	gen = w->gen;
+	for (;;) {
+		while ((poolGen == gen) && !poolStop)
+			pthread_cond_wait(&poolStartCond, &poolMutex);
+		if (poolStop)
+			break;
+		gen = poolGen;
+		pthread_mutex_unlock(&poolMutex);
+
+		CR_DA_SM_EXECUTE(w->mgr);
+
+		pthread_mutex_lock(&poolMutex);
+		poolPending--;
+		if (poolPending == 0)
+			pthread_cond_signal(&poolEndCond);
+	}
+	pthread_mutex_unlock(&poolMutex);
+	return NULL;
+}
+
+#endif /* CR_DA_MGR_POOL */
@@ -0,0 +1,78 @@
+/**
+ * @file
+ * @ingroup crDemoMaster
+ * Interface for the manager pool of the demo applications of the CORDET Demo.
+ * The manager pool executes the InManagers and OutManagers of a demo application in a
+ * control cycle.
+ * The managers which are marked as independent in the configuration of the application
+ * (<code>#CR_FW_INMANAGER_INDEPENDENT</code> and <code>#CR_FW_OUTMANAGER_INDEPENDENT</code>)
+ * are each executed by a dedicated worker thread and run concurrently with each other.
+ * The other managers are executed in sequence by the calling thread while the workers
+ * are running.
+ * <code>::CrDaMgrPoolExecute</code> returns when all managers have completed their
+ * execution (the barrier at the end of the manager phase of the cycle).
+ * Hence, on a host with enough cores, the duration of the manager phase is the duration
+ * of the slowest manager rather than the sum of the durations of all managers.
+ *
+ * The worker threads are pinned to consecutive cores starting with core
+ * <code>#CR_DA_MGR_POOL_FIRST_CPU</code> (wrapping around at the number of online cores)
+ * so that they do not compete with the thread which executes the rest of the cycle.
+ * If a worker thread cannot be pinned, it runs unpinned.
+ *
+ * The framework components are not thread-safe.
+ * A manager may only be marked as independent if the commands and reports which it
+ * holds do not access framework components or application data which are accessed by
+ * the other managers while they run (in particular, an independent InManager must not
+ * load OutComponents into an OutManager which is executed concurrently and no two
+ * independent OutManagers may send to the same OutStream).
+ * Since the packets are released by the worker threads, the manager pool requires the
+ * lock-free packet pool (<code>#CR_FW_PCKT_LOCK_FREE</code>).
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRDA_MGRPOOL_H_
+#define CRDA_MGRPOOL_H_
+
+/* Include Framework Files */
+#include "CrFwConstants.h"
+/* Include Configuration Files */
+#include "CrFwUserConstants.h"
+#include "CrDaConstants.h"
+
+/**
+ * Start the worker threads of the manager pool.
+ * One worker thread is started for each independent manager.
+ * The InManagers and OutManagers must have been created (and they should have been
+ * initialized and configured) before this function is called.
+ * If a worker thread cannot be started, its manager and the following independent
+ * managers are executed by the calling thread.
+ * @return 1 if all worker threads were started; 0 otherwise
+ */
+CrFwBool_t CrDaMgrPoolStart();
+
+/**
+ * Stop the worker threads of the manager pool.
+ * The function waits until the worker threads have terminated.
+ */
+void CrDaMgrPoolStop();
+
+/**
+ * Execute all InManagers and OutManagers once.
+ * The independent managers are executed concurrently by the worker threads and the
+ * other managers are executed by the calling thread.
+ * The function returns when all managers have been executed.
+ */
+void CrDaMgrPoolExecute();
+
+#endif /* CRDA_MGRPOOL_H_ */
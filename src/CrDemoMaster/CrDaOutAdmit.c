@@ -0,0 +1,255 @@
+/**
+ * @file
+ * @ingroup crDemoMaster
+ * Implementation of the admission control of the OutComponents of the demo applications
+ * of the CORDET Demo.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+#include "CrDaOutAdmit.h"
+#include "CrDaOutCmpPool.h"
+#include "CrDaErrQueue.h"
+/* Include configuration files */
+#include "CrFwPcktPart.h"
+/* Include framework files */
+#include "UtilityFunctions/CrFwUtilityFunctions.h"
+
+/**
+ * The number of destinations whose order is kept by the retries (the destinations are
+ * indexed by their identifier and the last entry is shared by the other destinations).
+ */
+#define CR_DA_OUT_ADMIT_N_OF_DEST (CR_DA_SLAVE_2+2)
+
+/** The type for a deferred request. */
+typedef struct {
+	/** The request. */
+	CrDaOutAdmitReq_t req;
+	/** The argument of the Issue Function of the request. */
+	unsigned char arg[CR_DA_OUT_ADMIT_ARG_SIZE];
+} CrDaOutAdmitEntry_t;
+
+/** The deferred requests in the order in which they were deferred. */
+static CrDaOutAdmitEntry_t queue[CR_DA_OUT_ADMIT_QUEUE_SIZE];
+
+/** The number of deferred requests (read without the mutex by the requests which are made). */
+static unsigned int nOfQueued = 0;
+
+/** The number of deferred requests for each destination. */
+static unsigned int nOfQueuedForDest[CR_DA_OUT_ADMIT_N_OF_DEST];
+
+/** The mutex which protects the deferred requests. */
+static pthread_mutex_t queueMutex = PTHREAD_MUTEX_INITIALIZER;
+
+/** The statistics of the admission control (the counters are incremented atomically). */
+static CrDaOutAdmitStats_t stats;
+
+/**
+ * Return the index of a destination in the per-destination arrays.
+ * @param dest the destination
+ * @return the index
+ */
+static unsigned int admitDestIndex(CrFwDestSrc_t dest);
+
+/**
+ * Make an OutComponent for a destination.
+ * The allocation failure is counted and it is cleared from the application error code.
+ * @param type the service type of the OutComponent
+ * @param subType the service sub-type of the OutComponent
+ * @param discriminant the discriminant of the OutComponent
+ * @param length the length of the packet of the OutComponent
+ * @param dest the destination of the OutComponent
+ * @return the OutComponent or NULL if it could not be made
+ */
+static FwSmDesc_t admitMake(CrFwServType_t type, CrFwServSubType_t subType, CrFwDiscriminant_t discriminant,
+                            CrFwPcktLength_t length, CrFwDestSrc_t dest);
+
+/**
+ * Append a request to the deferred requests.
+ * If the queue is full and the policy of the request is
+ * <code>#CR_DA_OUT_ADMIT_DROP_OLDEST</code>, the oldest deferred request of the same kind
+ * and destination is dropped.
+ * This function is called with the mutex taken.
+ * @param req the request
+ * @param arg the argument of the Issue Function
+ * @param argLength the length of the argument
+ * @return 1 if the request was deferred; 0 if the queue is full
+ */
+static CrFwBool_t admitDefer(const CrDaOutAdmitReq_t* req, const void* arg, unsigned int argLength);
+
+/* ---------------------------------------------------------------------------------------------*/
+FwSmDesc_t CrDaOutAdmitMake(CrFwServType_t type, CrFwServSubType_t subType, CrFwDiscriminant_t discriminant,
+                            CrFwPcktLength_t length, CrFwDestSrc_t dest) {
+	FwSmDesc_t outCmp = admitMake(type, subType, discriminant, length, dest);
+
+	if (outCmp == NULL)
+		__atomic_fetch_add(&stats.nOfRejected, 1, __ATOMIC_RELAXED);
+	else
+		__atomic_fetch_add(&stats.nOfAdmitted, 1, __ATOMIC_RELAXED);
+	return outCmp;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaOutAdmitIssue(const CrDaOutAdmitReq_t* req, const void* arg, unsigned int argLength) {
+	FwSmDesc_t outCmp;
+	CrFwBool_t deferred;
+
+	if (argLength > CR_DA_OUT_ADMIT_ARG_SIZE) {
+		__atomic_fetch_add(&stats.nOfRejected, 1, __ATOMIC_RELAXED);
+		return 0;
+	}
+
+	/* The requests for a destination must not overtake its deferred requests */
+	if ((req->policy == CR_DA_OUT_ADMIT_REJECT) || (__atomic_load_n(&nOfQueued, __ATOMIC_ACQUIRE) == 0)) {
+		outCmp = admitMake(req->servType, req->servSubType, req->discriminant, req->length, req->dest);
+		if (outCmp != NULL) {
+			__atomic_fetch_add(&stats.nOfAdmitted, 1, __ATOMIC_RELAXED);
+			req->issue(outCmp, req->dest, arg);
+			return 1;
+		}
+		if (req->policy == CR_DA_OUT_ADMIT_REJECT) {
+			__atomic_fetch_add(&stats.nOfRejected, 1, __ATOMIC_RELAXED);
+			return 0;
+		}
+		pthread_mutex_lock(&queueMutex);
+	} else {
+		pthread_mutex_lock(&queueMutex);
+		if (nOfQueuedForDest[admitDestIndex(req->dest)] == 0) {
+			outCmp = admitMake(req->servType, req->servSubType, req->discriminant, req->length, req->dest);
+			if (outCmp != NULL) {
+				pthread_mutex_unlock(&queueMutex);
+				__atomic_fetch_add(&stats.nOfAdmitted, 1, __ATOMIC_RELAXED);
+				req->issue(outCmp, req->dest, arg);
+				return 1;
+			}
+		}
+	}
+
+	deferred = admitDefer(req, arg, argLength);
+	pthread_mutex_unlock(&queueMutex);
+	if (!deferred)
+		__atomic_fetch_add(&stats.nOfRejected, 1, __ATOMIC_RELAXED);
+	return deferred;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaOutAdmitCycle() {
+	CrFwBool_t blocked[CR_DA_OUT_ADMIT_N_OF_DEST];
+	CrDaOutAdmitEntry_t* e;
+	FwSmDesc_t outCmp;
+	unsigned int i, j, d;
+
+	if (__atomic_load_n(&nOfQueued, __ATOMIC_ACQUIRE) == 0)
+		return;
+	memset(blocked, 0, sizeof(blocked));
+
+	pthread_mutex_lock(&queueMutex);
+	/* The requests which fail again are compacted towards the head of the queue */
+	for (i=0, j=0; i<nOfQueued; i++) {
+		e = &queue[i];
+		d = admitDestIndex(e->req.dest);
+		outCmp = NULL;
+		if (!blocked[d])
+			outCmp = admitMake(e->req.servType, e->req.servSubType, e->req.discriminant, e->req.length, e->req.dest);
+		if (outCmp == NULL) {
+			blocked[d] = 1;
+			if (j != i)
+				queue[j] = *e;
+			j++;
+			continue;
+		}
+		e->req.issue(outCmp, e->req.dest, e->arg);
+		nOfQueuedForDest[d]--;
+		__atomic_fetch_add(&stats.nOfRetried, 1, __ATOMIC_RELAXED);
+	}
+	__atomic_store_n(&nOfQueued, j, __ATOMIC_RELEASE);
+	pthread_mutex_unlock(&queueMutex);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaOutAdmitGetStats(CrDaOutAdmitStats_t* s) {
+	pthread_mutex_lock(&queueMutex);
+	s->nOfAdmitted = __atomic_load_n(&stats.nOfAdmitted, __ATOMIC_RELAXED);
+	s->nOfDeferred = stats.nOfDeferred;
+	s->nOfRetried = __atomic_load_n(&stats.nOfRetried, __ATOMIC_RELAXED);
+	s->nOfRejected = __atomic_load_n(&stats.nOfRejected, __ATOMIC_RELAXED);
+	s->nOfDropped = stats.nOfDropped;
+	s->nOfQueued = nOfQueued;
+	s->highWaterMark = stats.highWaterMark;
+	pthread_mutex_unlock(&queueMutex);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaOutAdmitReport(const char* app) {
+	CrDaOutAdmitStats_t s;
+
+	CrDaOutAdmitGetStats(&s);
+	if ((s.nOfDeferred == 0) && (s.nOfRejected == 0))
+		return;
+	printf("%s: OutLoader admission: %llu requests admitted, %llu deferred (%llu admitted on retry, %llu dropped, %u still deferred), %llu rejected, high-water mark %u of %d\n",
+	       app, s.nOfAdmitted, s.nOfDeferred, s.nOfRetried, s.nOfDropped, s.nOfQueued, s.nOfRejected,
+	       s.highWaterMark, CR_DA_OUT_ADMIT_QUEUE_SIZE);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static unsigned int admitDestIndex(CrFwDestSrc_t dest) {
+	return (dest < CR_DA_OUT_ADMIT_N_OF_DEST-1) ? dest : (unsigned int)(CR_DA_OUT_ADMIT_N_OF_DEST-1);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static FwSmDesc_t admitMake(CrFwServType_t type, CrFwServSubType_t subType, CrFwDiscriminant_t discriminant,
+                            CrFwPcktLength_t length, CrFwDestSrc_t dest) {
+	FwSmDesc_t outCmp;
+
+	CrFwPcktSetMakePart(CrFwPcktGetOutStreamPart(dest));
+	outCmp = CrDaOutCmpPoolMake(type, subType, discriminant, length);
+	CrFwPcktSetMakePart(CR_FW_PCKT_PART_SHARED);
+	if (outCmp == NULL) {
+		CrDaErrQueueTakeAppErr();	/* the failure is counted before the code is cleared */
+		if ((CrFwGetAppErrCode() == crOutCmpAllocationFail) || (CrFwGetAppErrCode() == crPcktAllocationFail))
+			CrFwSetAppErrCode(crNoAppErr);
+	}
+	return outCmp;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static CrFwBool_t admitDefer(const CrDaOutAdmitReq_t* req, const void* arg, unsigned int argLength) {
+	unsigned int i;
+
+	if (nOfQueued == CR_DA_OUT_ADMIT_QUEUE_SIZE) {
+		if (req->policy != CR_DA_OUT_ADMIT_DROP_OLDEST)
+			return 0;
+		for (i=0; i<nOfQueued; i++)
+			if ((queue[i].req.servType == req->servType) && (queue[i].req.servSubType == req->servSubType) &&
+			        (queue[i].req.discriminant == req->discriminant) && (queue[i].req.dest == req->dest))
+				break;
+		if (i == nOfQueued)
+			return 0;
+		memmove(&queue[i], &queue[i+1], (nOfQueued-i-1)*sizeof(CrDaOutAdmitEntry_t));
+		nOfQueuedForDest[admitDestIndex(req->dest)]--;
+		nOfQueued--;
+		stats.nOfDropped++;
+	}
+
+	queue[nOfQueued].req = *req;
+	memcpy(queue[nOfQueued].arg, arg, argLength);
+	nOfQueuedForDest[admitDestIndex(req->dest)]++;
+	__atomic_store_n(&nOfQueued, nOfQueued+1, __ATOMIC_RELEASE);
+	stats.nOfDeferred++;
+	if (nOfQueued > stats.highWaterMark)
+		stats.highWaterMark = nOfQueued;
+	return 1;
+}
@@ -0,0 +1,338 @@
+/**
+ * @file
+ * @ingroup crDemoMaster
+ * Implementation of the OutStream backlog of the demo applications of the CORDET Demo.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include "CrDaOutBacklog.h"
+#include "CrDaStreamMap.h"
+/* Include FW Profile files */
+#include "FwSmConstants.h"
+/* Include framework files */
+#include "OutStream/CrFwOutStream.h"
+#include "Pckt/CrFwPckt.h"
+#include "CrFwPcktInline.h"
+#include "CrFwPcktRefCnt.h"
+
+/** The number of destinations of the backlog (the destinations are indexed by their identifier). */
+#define CR_DA_OUT_BACKLOG_N_OF_DEST (CR_DA_SLAVE_2+1)
+
+/** The type for the queue of one group of the backlog of a destination. */
+typedef struct {
+	/** The chunk which holds the first packet (undefined if the queue is empty). */
+	int headChunk;
+	/** The chunk which holds the last packet (undefined if the queue is empty). */
+	int tailChunk;
+	/** The position of the first packet in its chunk. */
+	unsigned int headPos;
+	/** The position after the last packet in its chunk. */
+	unsigned int tailPos;
+	/** The number of packets in the queue. */
+	unsigned int nOfPckts;
+} CrDaOutBacklogQueue_t;
+
+/** The type for the backlog of a destination. */
+typedef struct {
+	/** The queues of the groups (in the order of their priority). */
+	CrDaOutBacklogQueue_t queue[CR_DA_PCKT_N_OF_GROUPS];
+	/** The time of the last change of the number of packets in the backlog. */
+	struct timespec since;
+	/** The statistics of the backlog. */
+	CrDaOutBacklogStats_t stats;
+} CrDaOutBacklog_t;
+
+/** The thresholds above which the time spent by the backlogs is recorded. */
+static const unsigned int threshold[CR_DA_OUT_BACKLOG_N_OF_THRESHOLDS] = CR_DA_OUT_BACKLOG_THRESHOLDS;
+
+/** The arena from which the chunks of the backlogs are taken. */
+static CrFwPckt_t arena[CR_DA_OUT_BACKLOG_N_OF_CHUNKS][CR_DA_OUT_BACKLOG_CHUNK_SIZE];
+
+/** The next chunk of each chunk (in a backlog or in the list of free chunks). */
+static int nextChunk[CR_DA_OUT_BACKLOG_N_OF_CHUNKS];
+
+/** The first free chunk of the arena (-1 if the arena is exhausted). */
+static int freeChunk = -1;
+
+/** Flag which is set when the list of free chunks has been initialized. */
+static CrFwBool_t arenaInit = 0;
+
+/** The mutex which protects the list of free chunks. */
+static pthread_mutex_t arenaMutex = PTHREAD_MUTEX_INITIALIZER;
+
+/** The backlogs of the destinations. */
+static CrDaOutBacklog_t backlog[CR_DA_OUT_BACKLOG_N_OF_DEST];
+
+/** The hand-over operation of the transport. */
+static CrFwBool_t (*transportHandover)(CrFwPckt_t pckt) = NULL;
+
+/**
+ * Take a chunk from the arena.
+ * @return the chunk or -1 if the arena is exhausted
+ */
+static int backlogChunkAlloc();
+
+/**
+ * Return a chunk to the arena.
+ * @param chunk the chunk
+ */
+static void backlogChunkFree(int chunk);
+
+/**
+ * Return the group of the queue of a packet.
+ * The packets whose group is out of range are queued in the last group.
+ * @param pckt the packet
+ * @return the group
+ */
+static CrFwGroup_t backlogGroup(CrFwPckt_t pckt);
+
+/**
+ * Append a packet to the queue of a group of the backlog of a destination.
+ * @param q the backlog
+ * @param group the group
+ * @param pckt the packet
+ * @return 1 if the packet was appended; 0 if the backlog is full or the arena is exhausted
+ */
+static CrFwBool_t backlogPush(CrDaOutBacklog_t* q, CrFwGroup_t group, CrFwPckt_t pckt);
+
+/**
+ * Remove the first packet from the queue of a group of the backlog of a destination.
+ * The queue must not be empty.
+ * @param q the backlog
+ * @param group the group
+ * @return the packet
+ */
+static CrFwPckt_t backlogPop(CrDaOutBacklog_t* q, CrFwGroup_t group);
+
+/**
+ * Record a change of the number of packets in the backlog of a destination.
+ * The time since the previous change is added to the time spent above the thresholds
+ * which the previous number of packets exceeded.
+ * @param q the backlog
+ * @param nOfPckts the new number of packets
+ */
+static void backlogSetDepth(CrDaOutBacklog_t* q, unsigned int nOfPckts);
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaOutBacklogSetHandover(CrFwBool_t (*handover)(CrFwPckt_t pckt)) {
+	transportHandover = handover;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaOutBacklogPcktHandover(CrFwPckt_t pckt) {
+	CrFwDestSrc_t dest = CrFwPcktGetDest(pckt);
+	CrFwGroup_t group = backlogGroup(pckt);
+	CrDaOutBacklog_t* q;
+	CrFwGroup_t g;
+	unsigned int nOfAhead = 0;
+
+	if (dest >= CR_DA_OUT_BACKLOG_N_OF_DEST)
+		return transportHandover(pckt);
+	q = &backlog[dest];
+
+	/* The packets must not overtake the packets of their group or of the groups before it */
+	for (g=0; g<=group; g++)
+		nOfAhead += q->queue[g].nOfPckts;
+	if ((nOfAhead == 0) && transportHandover(pckt)) {
+		if (q->stats.nOfPckts > 0)
+			q->stats.nOfBypassed++;
+		return 1;
+	}
+	if (!backlogPush(q, group, pckt)) {
+		q->stats.nOfRejected++;
+		return 0;
+	}
+	return 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+unsigned int CrDaOutBacklogFlush() {
+	unsigned int nOfPckts = 0;
+	CrFwDestSrc_t dest;
+	CrDaOutBacklog_t* q;
+	CrDaOutBacklogQueue_t* gq;
+	CrFwGroup_t group;
+	FwSmDesc_t outStream;
+
+	for (dest=0; dest<CR_DA_OUT_BACKLOG_N_OF_DEST; dest++) {
+		q = &backlog[dest];
+		if (q->stats.nOfPckts == 0)
+			continue;
+		/* The groups are drained in the order of their priority until the transport is full */
+		for (group=0; group<CR_DA_PCKT_N_OF_GROUPS; group++) {
+			gq = &q->queue[group];
+			while ((gq->nOfPckts > 0) && transportHandover(arena[gq->headChunk][gq->headPos]))
+				CrFwPcktRelease(backlogPop(q, group));
+			if (gq->nOfPckts > 0)
+				break;
+		}
+		if (q->stats.nOfPckts > 0) {
+			nOfPckts += q->stats.nOfPckts;
+			continue;
+		}
+		/* The packets which the OutStream buffered while the backlog was full come next */
+		outStream = CrDaStreamMapGetOutStream(dest);
+		if ((outStream != NULL) && (CrFwOutStreamGetNOfPendingPckts(outStream) > 0))
+			CrFwOutStreamConnectionAvail(outStream);
+		nOfPckts += q->stats.nOfPckts;
+	}
+	return nOfPckts;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaOutBacklogClear() {
+	CrFwDestSrc_t dest;
+	CrFwGroup_t group;
+
+	for (dest=0; dest<CR_DA_OUT_BACKLOG_N_OF_DEST; dest++)
+		for (group=0; group<CR_DA_PCKT_N_OF_GROUPS; group++)
+			while (backlog[dest].queue[group].nOfPckts > 0)
+				CrFwPcktRelease(backlogPop(&backlog[dest], group));
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaOutBacklogGetStats(CrFwDestSrc_t dest, CrDaOutBacklogStats_t* stats) {
+	if (dest >= CR_DA_OUT_BACKLOG_N_OF_DEST) {
+		memset(stats, 0, sizeof(CrDaOutBacklogStats_t));
+		return;
+	}
+	/* Account for the time since the last change */
+	if (backlog[dest].stats.nOfPckts > 0)
+		backlogSetDepth(&backlog[dest], backlog[dest].stats.nOfPckts);
+	*stats = backlog[dest].stats;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaOutBacklogReport(const char* app) {
+	CrDaOutBacklogStats_t stats;
+	CrFwDestSrc_t dest;
+
+	for (dest=0; dest<CR_DA_OUT_BACKLOG_N_OF_DEST; dest++) {
+		CrDaOutBacklogGetStats(dest, &stats);
+		if ((stats.nOfBacklogged == 0) && (stats.nOfRejected == 0))
+			continue;
+		printf("%s: OutStream backlog to %u: %llu packets backlogged, %llu rejected, %llu bypassed, high-water mark %u of %d\n",
+		       app, dest, stats.nOfBacklogged, stats.nOfRejected, stats.nOfBypassed, stats.highWaterMark,
+		       CR_DA_OUT_BACKLOG_MAX_NOF_PCKTS);
+		printf("%s: OutStream backlog to %u: time above %u/%u/%u packets: %.3f/%.3f/%.3f ms\n", app, dest,
+		       threshold[0], threshold[1], threshold[2], stats.timeAbove[0] / 1e6, stats.timeAbove[1] / 1e6,
+		       stats.timeAbove[2] / 1e6);
+	}
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static int backlogChunkAlloc() {
+	int chunk;
+
+	pthread_mutex_lock(&arenaMutex);
+	if (!arenaInit) {
+		for (chunk=0; chunk<CR_DA_OUT_BACKLOG_N_OF_CHUNKS; chunk++)
+			nextChunk[chunk] = chunk+1;
+		nextChunk[CR_DA_OUT_BACKLOG_N_OF_CHUNKS-1] = -1;
+		freeChunk = 0;
+		arenaInit = 1;
+	}
+	chunk = freeChunk;
+	if (chunk >= 0)
+		freeChunk = nextChunk[chunk];
+	pthread_mutex_unlock(&arenaMutex);
+	return chunk;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void backlogChunkFree(int chunk) {
+	pthread_mutex_lock(&arenaMutex);
+	nextChunk[chunk] = freeChunk;
+	freeChunk = chunk;
+	pthread_mutex_unlock(&arenaMutex);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static CrFwGroup_t backlogGroup(CrFwPckt_t pckt) {
+	CrFwGroup_t group = CrFwPcktGetGroup(pckt);
+
+	return (group < CR_DA_PCKT_N_OF_GROUPS) ? group : (CrFwGroup_t)(CR_DA_PCKT_N_OF_GROUPS-1);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static CrFwBool_t backlogPush(CrDaOutBacklog_t* q, CrFwGroup_t group, CrFwPckt_t pckt) {
+	CrDaOutBacklogQueue_t* gq = &q->queue[group];
+	int chunk;
+
+	if (q->stats.nOfPckts >= CR_DA_OUT_BACKLOG_MAX_NOF_PCKTS)
+		return 0;
+	if ((gq->nOfPckts == 0) || (gq->tailPos == CR_DA_OUT_BACKLOG_CHUNK_SIZE)) {
+		chunk = backlogChunkAlloc();
+		if (chunk < 0)
+			return 0;
+		if (gq->nOfPckts == 0) {
+			gq->headChunk = chunk;
+			gq->headPos = 0;
+		} else
+			nextChunk[gq->tailChunk] = chunk;
+		gq->tailChunk = chunk;
+		gq->tailPos = 0;
+	}
+
+	CrFwPcktRetain(pckt);
+	arena[gq->tailChunk][gq->tailPos] = pckt;
+	gq->tailPos++;
+	gq->nOfPckts++;
+	q->stats.nOfBacklogged++;
+	backlogSetDepth(q, q->stats.nOfPckts+1);
+	return 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static CrFwPckt_t backlogPop(CrDaOutBacklog_t* q, CrFwGroup_t group) {
+	CrDaOutBacklogQueue_t* gq = &q->queue[group];
+	CrFwPckt_t pckt = arena[gq->headChunk][gq->headPos];
+	int chunk;
+
+	gq->headPos++;
+	gq->nOfPckts--;
+	backlogSetDepth(q, q->stats.nOfPckts-1);
+	if (gq->nOfPckts == 0)
+		backlogChunkFree(gq->headChunk);
+	else if (gq->headPos == CR_DA_OUT_BACKLOG_CHUNK_SIZE) {
+		chunk = gq->headChunk;
+		gq->headChunk = nextChunk[chunk];
+		gq->headPos = 0;
+		backlogChunkFree(chunk);
+	}
+	return pckt;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void backlogSetDepth(CrDaOutBacklog_t* q, unsigned int nOfPckts) {
+	struct timespec now;
+	unsigned long long elapsed;
+	unsigned int i;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	if (q->stats.nOfPckts > 0) {
+		elapsed = (unsigned long long)(now.tv_sec - q->since.tv_sec) * 1000000000ULL + now.tv_nsec - q->since.tv_nsec;
+		for (i=0; i<CR_DA_OUT_BACKLOG_N_OF_THRESHOLDS; i++)
+			if (q->stats.nOfPckts > threshold[i])
+				q->stats.timeAbove[i] += elapsed;
+	}
+	q->since = now;
+	q->stats.nOfPckts = nOfPckts;
+	if (nOfPckts > q->stats.highWaterMark)
+		q->stats.highWaterMark = nOfPckts;
+}
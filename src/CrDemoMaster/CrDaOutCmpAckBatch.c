@@ -0,0 +1,153 @@
+/**
+ * @file
+ * @ingroup crDemoMaster
+ * Implementation of the acknowledgement batch report of the CORDET Demo.
+ * With the default sizes, a batch report of <code>#CR_DA_ACK_BATCH_MAX_N</code> outcomes
+ * needs 1+16*4 bytes of parameters which, with the largest packet header (60 bytes), fit
+ * in the <code>#CR_DA_ACK_BATCH_PCKT_LENGTH</code> bytes of its packet.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdio.h>
+#include "CrDaConstants.h"
+#include "CrDaOutCmpAckBatch.h"
+#include "CrDaOutAdmit.h"
+/* Include framework files */
+#include "OutCmp/CrFwOutCmp.h"
+#include "OutLoader/CrFwOutLoader.h"
+#include "Pckt/CrFwPckt.h"
+#include "UtilityFunctions/CrFwUtilityFunctions.h"
+
+/** The number of application identifiers which may be the source of an InCommand (identifier 0 is not used). */
+#define CR_DA_ACK_BATCH_N_OF_APPS (CR_DA_SLAVE_2+1)
+
+/** The outcomes of the pending batch of each source (in the layout of the entries of a batch report). */
+static CrDaParAckEntry_t batchEntry[CR_DA_ACK_BATCH_N_OF_APPS][CR_DA_ACK_BATCH_MAX_N];
+
+/** The number of outcomes of the pending batch of each source. */
+static unsigned int batchN[CR_DA_ACK_BATCH_N_OF_APPS];
+
+/** The number of acknowledgement batch reports which have been made. */
+static unsigned long long nOfBatches = 0;
+
+/** The number of outcomes which have been carried by the acknowledgement batch reports. */
+static unsigned long long nOfSent = 0;
+
+/** The number of outcomes which have been lost because their batch report could not be made. */
+static unsigned long long nOfLost = 0;
+
+/**
+ * Make and load the report of the pending batch of one source.
+ * @param dest the source of the InCommands (the destination of the report)
+ */
+static void ackBatchFlush(CrFwDestSrc_t dest);
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaOutCmpAckBatchAdd(CrFwPckt_t pckt, CrFwRepInCmdOutcome_t outcome, CrFwOutcome_t failCode) {
+	CrFwDestSrc_t dest = CrFwPcktGetSrc(pckt);
+	CrDaParAckEntry_t* entry;
+
+	switch (outcome) {
+	case crCmdAckAccSucc:
+		if (!CrFwPcktIsAcceptAck(pckt))
+			return;
+		break;
+	case crCmdAckStrSucc:
+		if (!CrFwPcktIsStartAck(pckt))
+			return;
+		break;
+	case crCmdAckPrgSucc:
+		if (!CrFwPcktIsProgressAck(pckt))
+			return;
+		break;
+	case crCmdAckTrmSucc:
+		if (!CrFwPcktIsTermAck(pckt))
+			return;
+		break;
+	default:	/* the failures are always reported */
+		break;
+	}
+
+	if (dest >= CR_DA_ACK_BATCH_N_OF_APPS) {
+		nOfLost++;
+		return;
+	}
+	entry = &batchEntry[dest][batchN[dest]];
+	entry->cmdId = CrFwPcktGetCmdRepId(pckt);
+	entry->outcome = (unsigned char)outcome;
+	entry->failCode = failCode;
+	batchN[dest]++;
+	if (batchN[dest] == CR_DA_ACK_BATCH_MAX_N)
+		ackBatchFlush(dest);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaOutCmpAckBatchFlush() {
+	CrFwDestSrc_t dest;
+
+	for (dest=0; dest<CR_DA_ACK_BATCH_N_OF_APPS; dest++)
+		if (batchN[dest] > 0)
+			ackBatchFlush(dest);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+unsigned int CrDaOutCmpAckBatchGetN(const char* pcktPar) {
+	return (unsigned char)pcktPar[0];
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaOutCmpAckBatchGetEntry(const char* pcktPar, unsigned int i, CrFwInstanceId_t* cmdId,
+                                CrFwRepInCmdOutcome_t* outcome, CrFwOutcome_t* failCode) {
+	const char* entry = pcktPar + 1 + i*CR_DA_ACK_BATCH_ENTRY_LENGTH;
+
+	*cmdId = CrDaParAckEntryGetCmdId(entry);
+	*outcome = (CrFwRepInCmdOutcome_t)CrDaParAckEntryGetOutcome(entry);
+	*failCode = CrDaParAckEntryGetFailCode(entry);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaOutCmpAckBatchReport(const char* app) {
+#if (CR_DA_ACK_BATCH == 1)
+	printf("%s: Acknowledgement batches: %llu reports of up to %d outcomes (%.1f on average), %llu outcomes lost\n", app,
+	       nOfBatches, CR_DA_ACK_BATCH_MAX_N, (nOfBatches == 0 ? 0.0 : (double)nOfSent / nOfBatches), nOfLost);
+#else
+	(void)app;
+#endif
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void ackBatchFlush(CrFwDestSrc_t dest) {
+	FwSmDesc_t rep;
+	char* pcktPar;
+	unsigned int n = batchN[dest];
+
+	batchN[dest] = 0;
+	rep = CrDaOutAdmitMake(CR_DA_SERV_TYPE,CR_DA_SERV_SUBTYPE_ACK_BATCH,0,0,dest);
+	if (rep == NULL) {
+		/* The entries of the batch are lost (the rejection is counted by the admission control) */
+		nOfLost += n;
+		return;
+	}
+
+	pcktPar = CrFwOutCmpGetParStart(rep);
+	pcktPar[0] = (char)n;
+	CrDaParAckEntryWrite(pcktPar+1, batchEntry[dest], n);
+	nOfBatches++;
+	nOfSent += n;
+
+	CrFwOutCmpSetDest(rep,dest);
+	CrFwOutCmpSetGroup(rep,CR_DA_PCKT_GROUP_URGENT);
+	/* Request the batch report to be sent out */
+	CrFwOutLoaderLoad(rep);
+}
@@ -0,0 +1,79 @@
+/**
+ * @file
+ * @ingroup crDemoMaster
+ * Interface for the OutComponent pool of the demo applications of the CORDET Demo.
+ * The OutComponents are allocated by the OutFactory from a pool of
+ * <code>#CR_FW_OUTFACTORY_MAX_NOF_OUTCMP</code> OutComponents which are built when the
+ * OutFactory is initialized and which are reused after they have been released.
+ * An OutComponent is held by the pool from the time it is made until it has been sent
+ * by its OutManager (or until its loading has failed).
+ * The size of the pool is therefore derived from the sizes of the POCLs of the
+ * OutManagers (see <code>CrFwOutFactoryUserPar.h</code>) so that the pool is never the
+ * limit on the number of OutComponents which an application can issue in a control
+ * cycle.
+ *
+ * The demo applications make their OutComponents through
+ * <code>::CrDaOutCmpPoolMake</code> which records the number of allocations, the
+ * number of failed allocations and the peak use of the pool (the number of allocated
+ * OutComponents only grows when an OutComponent is made, so that the peak which is
+ * recorded after every allocation is exact).
+ * They are printed by <code>::CrDaOutCmpPoolReport</code>.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRDA_OUTCMPPOOL_H_
+#define CRDA_OUTCMPPOOL_H_
+
+/* Include FW Profile Files */
+#include "FwSmConstants.h"
+/* Include Framework Files */
+#include "CrFwConstants.h"
+/* Include Configuration Files */
+#include "CrFwUserConstants.h"
+
+/** The statistics of the OutComponent pool. */
+typedef struct {
+	/** The number of OutComponents which have been allocated. */
+	unsigned long long nOfMake;
+	/** The number of allocation requests which have failed. */
+	unsigned long long nOfMakeFail;
+	/** The largest number of OutComponents which have been allocated at the same time. */
+	unsigned int highWaterMark;
+} CrDaOutCmpPoolStats_t;
+
+/**
+ * Make an OutComponent (see <code>::CrFwOutFactoryMakeOutCmp</code>) and update the
+ * statistics of the pool.
+ * @param type the service type of the OutComponent
+ * @param subType the service sub-type of the OutComponent
+ * @param discriminant the discriminant of the OutComponent
+ * @param length the length of the packet of the OutComponent (zero for the default length)
+ * @return the OutComponent or NULL if the allocation failed
+ */
+FwSmDesc_t CrDaOutCmpPoolMake(CrFwServType_t type, CrFwServSubType_t subType, CrFwDiscriminant_t discriminant,
+                              CrFwPcktLength_t length);
+
+/**
+ * Get the statistics of the OutComponent pool.
+ * @param stats the statistics (output)
+ */
+void CrDaOutCmpPoolGetStats(CrDaOutCmpPoolStats_t* stats);
+
+/**
+ * Print the statistics of the OutComponent pool.
+ * @param app the name of the application (e.g. "MA")
+ */
+void CrDaOutCmpPoolReport(const char* app);
+
+#endif /* CRDA_OUTCMPPOOL_H_ */
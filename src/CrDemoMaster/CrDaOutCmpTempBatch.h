@@ -0,0 +1,118 @@
+/**
+ * @file
+ * @ingroup crDemoMaster
+ * Interface for the batch report of temperature violations of the CORDET Demo.
+ * When the coalescing of the temperature violations is selected (see
+ * <code>#CR_DA_TEMP_BATCH</code>), the temperature monitoring of a Slave Application
+ * does not send one report for each temperature violation.
+ * It instead adds the violation to a pending batch (<code>::CrDaOutCmpTempBatchAdd</code>)
+ * which is sent to the Master Application as one report:
+ * - at the end of each window of <code>#CR_DA_TEMP_BATCH_WINDOW</code> control cycles
+ *   (<code>::CrDaOutCmpTempBatchCycle</code>) if it holds at least one violation; or
+ * - as soon as it holds <code>#CR_DA_TEMP_BATCH_MAX_N</code> violations.
+ * .
+ * The batch is written into the parameter area of the packet of the report when the report
+ * is made, so that several batch reports can be waiting in the OutManager at the same time
+ * (the Serialize Operation of the report is therefore the default one).
+ * The parameter area of a batch report holds the number of violations in its first byte,
+ * followed by one entry of <code>#CR_DA_TEMP_BATCH_ENTRY_LENGTH</code> bytes for each
+ * violation:
+ * - the channel on which the violation was detected (<code>unsigned short</code>);
+ * - the temperature which violated the limit (<code>char</code>);
+ * - the number of reports which the channel has suppressed since its previous report
+ *   (<code>unsigned char</code>, see <code>#CR_DA_TEMP_SUPPRESS</code>);
+ * - the time stamp of the detection of the violation (<code>::CrFwTimeStamp_t</code>).
+ * .
+ * The layout of the entries is the parameter kind <code>ViolationEntry</code> of the
+ * schema <code>#CR_DA_PAR_SCHEMA</code>.
+ * The Master Application reads a batch report with <code>::CrDaOutCmpTempBatchGetN</code> and
+ * <code>::CrDaOutCmpTempBatchGetEntry</code>.
+ *
+ * If a batch report cannot be made because the OutFactory or the packet pool is exhausted,
+ * the violations of the batch are lost.
+ * The number of batch reports and of lost violations is printed by
+ * <code>::CrDaOutCmpTempBatchReport</code>.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRDA_OUTCMP_TEMP_BATCH_H_
+#define CRDA_OUTCMP_TEMP_BATCH_H_
+
+/* Include framework components */
+#include "CrFwConstants.h"
+/* Include configuration files */
+#include "CrFwUserConstants.h"
+#include "CrDaPar.h"
+
+/** The length in number of bytes of the entry of one violation in a batch report. */
+#define CR_DA_TEMP_BATCH_ENTRY_LENGTH CR_DA_PAR_LENGTH(ViolationEntry)
+
+/**
+ * Add a temperature violation to the pending batch.
+ * The batch report is made and loaded if the batch is full.
+ * @param chan the channel on which the violation was detected
+ * @param temp the temperature which violated the limit
+ * @param nOfSuppressed the number of reports which the channel has suppressed since its
+ * previous report
+ * @return 0 if the batch was full but its report could not be made (its violations are
+ * lost); 1 otherwise
+ */
+CrFwBool_t CrDaOutCmpTempBatchAdd(unsigned short chan, char temp, unsigned char nOfSuppressed);
+
+/**
+ * Make and load the report of the pending batch if it holds at least one violation.
+ * @return 0 if the report could not be made (the violations of the batch are lost);
+ * 1 otherwise
+ */
+CrFwBool_t CrDaOutCmpTempBatchFlush();
+
+/**
+ * End a control cycle and flush the pending batch at the end of each window of
+ * <code>#CR_DA_TEMP_BATCH_WINDOW</code> control cycles.
+ * This function must be called by the Slave Applications after the temperature monitoring
+ * of each control cycle.
+ * Nothing is done if the coalescing of the temperature violations is not selected.
+ */
+void CrDaOutCmpTempBatchCycle();
+
+/**
+ * Return the number of violations in the parameter area of a batch report.
+ * @param pcktPar the parameter area of the packet of the batch report
+ * @return the number of violations
+ */
+unsigned int CrDaOutCmpTempBatchGetN(const char* pcktPar);
+
+/**
+ * Read the entry of one violation in the parameter area of a batch report.
+ * @param pcktPar the parameter area of the packet of the batch report
+ * @param i the position of the violation in the batch (it must be smaller than the number
+ * of violations of the batch)
+ * @param chan the channel of the violation (output)
+ * @param temp the temperature of the violation (output)
+ * @param nOfSuppressed the number of reports which the channel of the violation has
+ * suppressed since its previous report (output)
+ * @param timeStamp the time stamp of the violation (output)
+ */
+void CrDaOutCmpTempBatchGetEntry(const char* pcktPar, unsigned int i, unsigned short* chan, char* temp,
+                                 unsigned char* nOfSuppressed, CrFwTimeStamp_t* timeStamp);
+
+/**
+ * Print the number of batch reports which have been made and the number of violations
+ * which they carried and which have been lost.
+ * Nothing is printed if the coalescing of the temperature violations is not selected.
+ * @param app the name of the application (e.g. "S1")
+ */
+void CrDaOutCmpTempBatchReport(const char* app);
+
+#endif /* CRDA_OUTCMP_TEMP_BATCH_H_ */
@@ -0,0 +1,409 @@
+/**
+ * @file
+ * @ingroup crDemoMaster
+ * Implementation of the statistics report of the temperature monitoring of the CORDET Demo.
+ * With the default sizes, a statistics report of <code>#CR_DA_TEMP_STATS_MAX_N</code>
+ * channels needs 5+6*10 bytes of parameters which, with the largest packet header (60
+ * bytes), fit in the <code>#CR_DA_TEMP_STATS_PCKT_LENGTH</code> bytes of its packet.
+ * The delta-encoded entries are first encoded in a buffer of
+ * <code>#CR_DA_TEMP_STATS_ENC_ENTRY_MAX</code> bytes per entry and they are only copied
+ * to the packet if they are shorter than the plain entries (and therefore fit in it).
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include "CrDaConstants.h"
+#include "CrDaOutCmpTempStats.h"
+#include "CrDaOutAdmit.h"
+/* Include configuration files */
+#include "CrFwCmpData.h"
+#include "CrFwPcktInline.h"
+/* Include framework files */
+#include "OutCmp/CrFwOutCmp.h"
+#include "OutLoader/CrFwOutLoader.h"
+#include "UtilityFunctions/CrFwUtilityFunctions.h"
+/* Include FW Profile files */
+#include "FwSmConfig.h"
+
+/** The number of words of 32 channels of the statistics. */
+#define CR_DA_TEMP_STATS_N_OF_WORDS (CR_DA_TEMP_N_OF_CHANNELS/32)
+
+/** The statistics of the channels in the current window, one array for each statistic. */
+typedef struct {
+	/** The number of samples of the channels. */
+	unsigned int nOfSamples[CR_DA_TEMP_N_OF_CHANNELS];
+	/** The number of samples of the channels which exceed their limit. */
+	unsigned int nOfAbove[CR_DA_TEMP_N_OF_CHANNELS];
+	/** The sums of the samples of the channels. */
+	long long sum[CR_DA_TEMP_N_OF_CHANNELS];
+	/** The minimum samples of the channels. */
+	char min[CR_DA_TEMP_N_OF_CHANNELS];
+	/** The maximum samples of the channels. */
+	char max[CR_DA_TEMP_N_OF_CHANNELS];
+	/** The bits of the channels which have samples in the current window. */
+	uint32_t hasSamples[CR_DA_TEMP_STATS_N_OF_WORDS];
+} CrDaTempStats_t;
+
+/** The statistics of the current window. */
+static CrDaTempStats_t stats;
+
+/** The number of control cycles of the current window. */
+static unsigned int nOfWindowCycles = 0;
+
+/** The number of statistics reports which have been made. */
+static unsigned long long nOfReps = 0;
+
+/** The number of channel statistics which have been carried by the statistics reports. */
+static unsigned long long nOfSent = 0;
+
+/** The number of channel statistics which have been lost because their report could not be made. */
+static unsigned long long nOfLost = 0;
+
+/** The number of the next statistics report (modulo 256). */
+static unsigned char nextRepNo = 0;
+
+#if (CR_DA_TEMP_STATS_ENCODING == 1)
+/** The references of the channels for the delta encoding (the entries which were last reported). */
+static CrDaParStatsEntry_t sentRef[CR_DA_TEMP_N_OF_CHANNELS];
+
+/** The number of statistics reports which have been made since the last key frame. */
+static unsigned int nOfSinceKey = 0;
+
+/** The number of key frames which have been made. */
+static unsigned long long nOfKeys = 0;
+
+/** The length in number of bytes of the plain entries of the statistics reports. */
+static unsigned long long nOfPlainBytes = 0;
+
+/** The length in number of bytes of the entries of the statistics reports as they were sent. */
+static unsigned long long nOfSentBytes = 0;
+#endif
+
+/**
+ * Make and load a statistics report of the current window.
+ * @param entry the entries of the channels of the report
+ * @param n the number of channels of the report
+ * @return 0 if the report could not be made; 1 otherwise
+ */
+static CrFwBool_t tempStatsSend(const CrDaParStatsEntry_t* entry, unsigned int n);
+
+#if (CR_DA_TEMP_STATS_ENCODING == 1)
+/**
+ * Delta-encode the entries of a statistics report against the references of their channels.
+ * @param entry the entries of the channels of the report
+ * @param n the number of channels of the report
+ * @param buf the buffer of the encoded entries (output, room for
+ * <code>#CR_DA_TEMP_STATS_ENC_ENTRY_MAX</code> bytes per entry)
+ * @return the length in number of bytes of the encoded entries
+ */
+static unsigned int tempStatsEncode(const CrDaParStatsEntry_t* entry, unsigned int n, unsigned char* buf);
+
+/**
+ * Write a variable-length integer (7 bits per byte, least significant bits first).
+ * @param buf the buffer where the integer is written
+ * @param v the integer
+ * @return the number of bytes which were written
+ */
+static unsigned int tempStatsPutVarint(unsigned char* buf, unsigned int v);
+
+/**
+ * Zigzag-encode a difference (0, -1, 1, -2, ... become 0, 1, 2, 3, ...).
+ * @param d the difference
+ * @return the zigzag-encoded difference
+ */
+static unsigned int tempStatsZigzag(int d);
+#endif
+
+/**
+ * Read a variable-length integer (7 bits per byte, least significant bits first).
+ * @param buf the buffer from which the integer is read
+ * @param len the length of the buffer
+ * @param pos the position of the integer in the buffer (updated to the position after it)
+ * @param v the integer (output)
+ * @return 1 if the integer was read; 0 if it does not end within the buffer or has more
+ * than 32 bits
+ */
+static CrFwBool_t tempStatsGetVarint(const unsigned char* buf, unsigned int len, unsigned int* pos, unsigned int* v);
+
+/**
+ * Decode a zigzag-encoded difference.
+ * @param v the zigzag-encoded difference
+ * @return the difference
+ */
+static int tempStatsUnzigzag(unsigned int v);
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaOutCmpTempStatsAdd(unsigned short chan, char temp, CrFwBool_t isAbove) {
+	uint32_t bit = (uint32_t)1 << (chan % 32);
+
+	if ((stats.hasSamples[chan/32] & bit) == 0) {
+		/* First sample of the channel in the window */
+		stats.hasSamples[chan/32] |= bit;
+		stats.nOfSamples[chan] = 0;
+		stats.nOfAbove[chan] = 0;
+		stats.sum[chan] = 0;
+		stats.min[chan] = temp;
+		stats.max[chan] = temp;
+	} else if (temp < stats.min[chan])
+		stats.min[chan] = temp;
+	else if (temp > stats.max[chan])
+		stats.max[chan] = temp;
+	stats.nOfSamples[chan]++;
+	stats.nOfAbove[chan] += (isAbove ? 1 : 0);
+	stats.sum[chan] += temp;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+unsigned int CrDaOutCmpTempStatsFlush() {
+	CrDaParStatsEntry_t entry[CR_DA_TEMP_STATS_MAX_N];
+	CrDaParStatsEntry_t* e;
+	unsigned int w, n = 0, nOfFail = 0;
+	unsigned short chan;
+	uint32_t word;
+
+	for (w=0; w<CR_DA_TEMP_STATS_N_OF_WORDS; w++) {
+		for (word=stats.hasSamples[w]; word!=0; word&=(word-1)) {
+			chan = (unsigned short)(w*32 + (unsigned int)__builtin_ctz(word));
+			e = &entry[n];
+			e->chan = chan;
+			e->nOfSamples = (unsigned short)(stats.nOfSamples[chan] < 0xFFFF ? stats.nOfSamples[chan] : 0xFFFF);
+			e->nOfAbove = (unsigned short)(stats.nOfAbove[chan] < 0xFFFF ? stats.nOfAbove[chan] : 0xFFFF);
+			e->min = stats.min[chan];
+			e->max = stats.max[chan];
+			e->mean = (short)((stats.sum[chan] * 100) / (long long)stats.nOfSamples[chan]);
+			n++;
+			if (n < CR_DA_TEMP_STATS_MAX_N)
+				continue;
+			if (!tempStatsSend(entry, n))
+				nOfFail += n;
+			n = 0;
+		}
+		stats.hasSamples[w] = 0;
+	}
+	if ((n > 0) && !tempStatsSend(entry, n))
+		nOfFail += n;
+	nOfWindowCycles = 0;
+	return nOfFail;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaOutCmpTempStatsCycle() {
+#if (CR_DA_TEMP_STATS == 1)
+	nOfWindowCycles++;
+	if (nOfWindowCycles < CR_DA_TEMP_STATS_WINDOW)
+		return;
+	CrDaOutCmpTempStatsFlush();
+#endif
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+unsigned int CrDaOutCmpTempStatsGetN(const char* pcktPar) {
+	return CrDaParStatsGetN(pcktPar);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaOutCmpTempStatsGetEntry(const char* pcktPar, unsigned int i, CrDaParStatsEntry_t* entry) {
+	CrDaParStatsEntryRead(pcktPar + CR_DA_PAR_LENGTH(Stats) + i*CR_DA_TEMP_STATS_ENTRY_LENGTH, entry, 1);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+unsigned int CrDaOutCmpTempStatsDecode(const char* pcktPar, unsigned int parLength, CrDaParStatsEntry_t* ref,
+                                       CrDaParStatsEntry_t* entry) {
+	const unsigned char* buf = (const unsigned char*)pcktPar + CR_DA_PAR_LENGTH(Stats);
+	unsigned int i, k, pos = 0, len, n = CrDaParStatsGetN(pcktPar);
+	unsigned int d[6];
+	unsigned int chan = 0;
+	CrDaParStatsEntry_t* r;
+
+	if ((n == 0) || (n > CR_DA_TEMP_STATS_MAX_N) || (parLength < CR_DA_PAR_LENGTH(Stats)))
+		return 0;
+	len = parLength - CR_DA_PAR_LENGTH(Stats);
+
+	switch (CrDaParStatsGetEnc(pcktPar)) {
+	case CR_DA_TEMP_STATS_ENC_KEY:
+		memset(ref, 0, CR_DA_TEMP_N_OF_CHANNELS*sizeof(CrDaParStatsEntry_t));
+		/* fall through: the entries of a key frame are plain */
+	case CR_DA_TEMP_STATS_ENC_PLAIN:
+		if (n*CR_DA_TEMP_STATS_ENTRY_LENGTH > len)
+			return 0;
+		CrDaParStatsEntryRead((const char*)buf, entry, n);
+		for (i=0; i<n; i++) {
+			if (entry[i].chan >= CR_DA_TEMP_N_OF_CHANNELS)
+				return 0;
+			ref[entry[i].chan] = entry[i];
+		}
+		return n;
+	case CR_DA_TEMP_STATS_ENC_DELTA:
+		for (i=0; i<n; i++) {
+			for (k=0; k<6; k++)
+				if (!tempStatsGetVarint(buf, len, &pos, &d[k]))
+					return 0;
+			/* The channels of the entries are strictly increasing */
+			if ((d[0] >= CR_DA_TEMP_N_OF_CHANNELS) || ((i > 0) && (d[0] == 0)))
+				return 0;
+			chan += d[0];
+			if (chan >= CR_DA_TEMP_N_OF_CHANNELS)
+				return 0;
+			r = &ref[chan];
+			r->chan = (unsigned short)chan;
+			r->nOfSamples = (unsigned short)(r->nOfSamples + tempStatsUnzigzag(d[1]));
+			r->nOfAbove = (unsigned short)(r->nOfAbove + tempStatsUnzigzag(d[2]));
+			r->min = (char)(r->min + tempStatsUnzigzag(d[3]));
+			r->max = (char)(r->max + tempStatsUnzigzag(d[4]));
+			r->mean = (short)(r->mean + tempStatsUnzigzag(d[5]));
+			entry[i] = *r;
+		}
+		return n;
+	default:
+		return 0;
+	}
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaOutCmpTempStatsReport(const char* app) {
+#if (CR_DA_TEMP_STATS == 1)
+	printf("%s: Statistics reports: %llu reports of up to %d channels (%.1f on average) over %d cycles, %llu lost\n",
+	       app, nOfReps, CR_DA_TEMP_STATS_MAX_N, (nOfReps == 0 ? 0.0 : (double)nOfSent / nOfReps),
+	       CR_DA_TEMP_STATS_WINDOW, nOfLost);
+#if (CR_DA_TEMP_STATS_ENCODING == 1)
+	printf("%s: Statistics encoding: %llu key frames, %llu bytes of entries sent in %llu bytes (%.1f%%)\n",
+	       app, nOfKeys, nOfPlainBytes, nOfSentBytes,
+	       (nOfPlainBytes == 0 ? 100.0 : (100.0 * (double)nOfSentBytes) / (double)nOfPlainBytes));
+#endif
+#endif
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static CrFwBool_t tempStatsSend(const CrDaParStatsEntry_t* entry, unsigned int n) {
+	FwSmDesc_t rep;
+	char* pcktPar;
+#if (CR_DA_TEMP_STATS_ENCODING == 1)
+	CrFwCmpData_t* cmpData;
+	unsigned char buf[CR_DA_TEMP_STATS_MAX_N*CR_DA_TEMP_STATS_ENC_ENTRY_MAX];
+	unsigned int i, len = n*CR_DA_TEMP_STATS_ENTRY_LENGTH;
+	unsigned char enc = CR_DA_TEMP_STATS_ENC_PLAIN;
+#endif
+
+	rep = CrDaOutAdmitMake(CR_DA_SERV_TYPE,CR_DA_SERV_SUBTYPE_REP_STATS,0,0,CR_DA_MASTER);
+	if (rep == NULL) {
+		/* The entries of the report are lost (the rejection is counted by the admission control) */
+		nOfLost += n;
+		return 0;
+	}
+
+	pcktPar = CrFwOutCmpGetParStart(rep);
+	CrDaParStatsSetN(pcktPar, (unsigned char)n);
+	CrDaParStatsSetNOfCycles(pcktPar, (unsigned short)nOfWindowCycles);
+	CrDaParStatsSetRepNo(pcktPar, nextRepNo);
+#if (CR_DA_TEMP_STATS_ENCODING == 1)
+	if (nOfSinceKey == 0) {
+		memset(sentRef, 0, sizeof(sentRef));
+		enc = CR_DA_TEMP_STATS_ENC_KEY;
+		nOfKeys++;
+	} else {
+		i = tempStatsEncode(entry, n, buf);
+		if (i < len) {
+			len = i;
+			enc = CR_DA_TEMP_STATS_ENC_DELTA;
+		}
+	}
+	nOfSinceKey = (nOfSinceKey + 1) % CR_DA_TEMP_STATS_KEYFRAME;
+	CrDaParStatsSetEnc(pcktPar, enc);
+	if (enc == CR_DA_TEMP_STATS_ENC_DELTA)
+		memcpy(pcktPar + CR_DA_PAR_LENGTH(Stats), buf, len);
+	else
+		CrDaParStatsEntryWrite(pcktPar + CR_DA_PAR_LENGTH(Stats), entry, n);
+	for (i=0; i<n; i++)
+		sentRef[entry[i].chan] = entry[i];
+	/* The packet is cut to the length of its entries (its slot in the packet pool is unchanged) */
+	cmpData = (CrFwCmpData_t*)FwSmGetData(rep);
+	CrFwPcktInlSetLength(((CrFwOutCmpData_t*)(cmpData->cmpSpecificData))->pckt,
+	                     (CrFwPcktLength_t)(CR_FW_PCKT_HEADER_LENGTH + CR_DA_PAR_LENGTH(Stats) + len));
+	nOfPlainBytes += n*CR_DA_TEMP_STATS_ENTRY_LENGTH;
+	nOfSentBytes += len;
+#else
+	CrDaParStatsSetEnc(pcktPar, CR_DA_TEMP_STATS_ENC_PLAIN);
+	CrDaParStatsEntryWrite(pcktPar + CR_DA_PAR_LENGTH(Stats), entry, n);
+#endif
+	nextRepNo++;
+	nOfReps++;
+	nOfSent += n;
+
+	CrFwOutCmpSetDest(rep,CR_DA_MASTER);
+	CrFwOutCmpSetGroup(rep,CR_DA_PCKT_GROUP_ROUTINE);
+	/* Request the statistics report to be sent out */
+	CrFwOutLoaderLoad(rep);
+	return 1;
+}
+
+#if (CR_DA_TEMP_STATS_ENCODING == 1)
+/* ---------------------------------------------------------------------------------------------*/
+static unsigned int tempStatsEncode(const CrDaParStatsEntry_t* entry, unsigned int n, unsigned char* buf) {
+	const CrDaParStatsEntry_t* r;
+	unsigned int i, len = 0, chan = 0;
+
+	for (i=0; i<n; i++) {
+		r = &sentRef[entry[i].chan];
+		len += tempStatsPutVarint(buf + len, (unsigned int)entry[i].chan - chan);
+		len += tempStatsPutVarint(buf + len, tempStatsZigzag((int)entry[i].nOfSamples - (int)r->nOfSamples));
+		len += tempStatsPutVarint(buf + len, tempStatsZigzag((int)entry[i].nOfAbove - (int)r->nOfAbove));
+		len += tempStatsPutVarint(buf + len, tempStatsZigzag((int)entry[i].min - (int)r->min));
+		len += tempStatsPutVarint(buf + len, tempStatsZigzag((int)entry[i].max - (int)r->max));
+		len += tempStatsPutVarint(buf + len, tempStatsZigzag((int)entry[i].mean - (int)r->mean));
+		chan = entry[i].chan;
+	}
+	return len;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static unsigned int tempStatsPutVarint(unsigned char* buf, unsigned int v) {
+	unsigned int len = 0;
+
+	while (v >= 0x80) {
+		buf[len++] = (unsigned char)(v | 0x80);
+		v >>= 7;
+	}
+	buf[len++] = (unsigned char)v;
+	return len;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static unsigned int tempStatsZigzag(int d) {
+	return (d < 0) ? (((unsigned int)(-d) << 1) - 1) : ((unsigned int)d << 1);
+}
+#endif
+
+/* ---------------------------------------------------------------------------------------------*/
+static CrFwBool_t tempStatsGetVarint(const unsigned char* buf, unsigned int len, unsigned int* pos, unsigned int* v) {
+	unsigned int shift;
+	unsigned char b;
+
+	*v = 0;
+	for (shift=0; shift<32; shift+=7) {
+		if (*pos >= len)
+			return 0;
+		b = buf[(*pos)++];
+		*v |= (unsigned int)(b & 0x7F) << shift;
+		if ((b & 0x80) == 0)
+			return 1;
+	}
+	return 0;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static int tempStatsUnzigzag(unsigned int v) {
+	return ((v & 1) != 0) ? -(int)((v + 1) >> 1) : (int)(v >> 1);
+}
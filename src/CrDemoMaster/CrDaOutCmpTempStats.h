@@ -0,0 +1,167 @@
+/**
+ * @file
+ * @ingroup crDemoMaster
+ * Interface for the statistics report of the temperature monitoring of the CORDET Demo.
+ * When the windowed statistics are selected (see <code>#CR_DA_TEMP_STATS</code>), the
+ * temperature monitoring of a Slave Application does not report the samples which violate
+ * the limit.
+ * It instead adds every sample of an enabled channel to the statistics of the channel
+ * (<code>::CrDaOutCmpTempStatsAdd</code>): the number of samples, the number of samples
+ * which exceed the limit, the minimum, the maximum and the sum of the samples.
+ * Adding a sample takes constant time and the statistics of a channel are only kept while
+ * it has samples in the current window.
+ *
+ * At the end of each window of <code>#CR_DA_TEMP_STATS_WINDOW</code> control cycles
+ * (<code>::CrDaOutCmpTempStatsCycle</code>), the statistics of the channels which had
+ * samples in the window are sent to the Master Application in statistics reports of up to
+ * <code>#CR_DA_TEMP_STATS_MAX_N</code> channels and they are then cleared.
+ * The parameter area of a statistics report holds the number of channels, the number
+ * of control cycles of the window, the encoding of the entries and the number of the
+ * report modulo 256 (the parameter kind <code>Stats</code> of the schema
+ * <code>#CR_DA_PAR_SCHEMA</code>), followed by one entry of
+ * <code>#CR_DA_TEMP_STATS_ENTRY_LENGTH</code> bytes for each channel (the parameter kind
+ * <code>StatsEntry</code>):
+ * - the channel (<code>unsigned short</code>);
+ * - the number of samples and the number of samples which exceed the limit of the channel
+ *   (<code>unsigned short</code>, saturated at 65535);
+ * - the minimum and the maximum temperature (<code>char</code>);
+ * - the mean temperature in hundredths of a degree (<code>short</code>).
+ * .
+ * The Master Application reads a statistics report with
+ * <code>::CrDaOutCmpTempStatsGetN</code> and <code>::CrDaOutCmpTempStatsDecode</code>.
+ *
+ * If the delta encoding is selected (see <code>#CR_DA_TEMP_STATS_ENCODING</code>), the
+ * entries are instead encoded (<code>#CR_DA_TEMP_STATS_ENC_DELTA</code>) against the
+ * references of their channels, namely the entries of the same channels in the previous
+ * statistics reports (or zero for a channel which has not been reported since the last key
+ * frame).
+ * The channel of an entry is encoded as its difference to the channel of the previous
+ * entry of the report (the entries are in the order of their channels) and the other
+ * fields of an entry as their difference to the reference of the channel, all of them as
+ * variable-length integers of 7 bits per byte (the differences of the other fields are
+ * first zigzag-encoded so that the small negative differences are small integers too).
+ * Statistics which change little from one window to the next are thus encoded in about
+ * one byte per field and the length of the packet is cut to the length of its entries.
+ * A report whose encoded entries would not be shorter than its plain entries is sent with
+ * plain entries (<code>#CR_DA_TEMP_STATS_ENC_PLAIN</code>).
+ *
+ * The Master Application must have received all previous statistics reports of a Slave
+ * Application to decode its delta-encoded reports: one statistics report in
+ * <code>#CR_DA_TEMP_STATS_KEYFRAME</code> is a key frame
+ * (<code>#CR_DA_TEMP_STATS_ENC_KEY</code>) which clears the references of all channels
+ * and carries plain entries.
+ * A Master Application which detects a missing report (from the number of the reports)
+ * drops the delta-encoded reports of the Slave Application until its next key frame.
+ *
+ * If a statistics report cannot be made because the OutFactory or the packet pool is
+ * exhausted, the statistics of its channels are lost.
+ * The number of statistics reports and of lost channel statistics and the ratio of the
+ * length of the encoded entries to the length of the plain entries are printed by
+ * <code>::CrDaOutCmpTempStatsReport</code>.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRDA_OUTCMP_TEMP_STATS_H_
+#define CRDA_OUTCMP_TEMP_STATS_H_
+
+/* Include framework components */
+#include "CrFwConstants.h"
+/* Include configuration files */
+#include "CrFwUserConstants.h"
+#include "CrDaPar.h"
+
+/** The length in number of bytes of the entry of one channel in a statistics report. */
+#define CR_DA_TEMP_STATS_ENTRY_LENGTH CR_DA_PAR_LENGTH(StatsEntry)
+
+/** The encoding of a statistics report whose entries are plain. */
+#define CR_DA_TEMP_STATS_ENC_PLAIN 0
+
+/** The encoding of a statistics report which is a key frame (its entries are plain). */
+#define CR_DA_TEMP_STATS_ENC_KEY 1
+
+/** The encoding of a statistics report whose entries are delta-encoded. */
+#define CR_DA_TEMP_STATS_ENC_DELTA 2
+
+/** The maximum length in number of bytes of a delta-encoded entry (3+3+3+2+2+3). */
+#define CR_DA_TEMP_STATS_ENC_ENTRY_MAX 16
+
+/**
+ * Add a sample to the statistics of its channel in the current window.
+ * @param chan the channel of the sample (it must be smaller than
+ * <code>#CR_DA_TEMP_N_OF_CHANNELS</code>)
+ * @param temp the temperature of the sample
+ * @param isAbove whether the sample exceeds the limit of the channel
+ */
+void CrDaOutCmpTempStatsAdd(unsigned short chan, char temp, CrFwBool_t isAbove);
+
+/**
+ * Make and load the statistics reports of the current window and clear its statistics.
+ * @return the number of channels whose statistics could not be reported
+ */
+unsigned int CrDaOutCmpTempStatsFlush();
+
+/**
+ * End a control cycle and flush the statistics at the end of each window of
+ * <code>#CR_DA_TEMP_STATS_WINDOW</code> control cycles.
+ * This function must be called by the Slave Applications after the temperature monitoring
+ * of each control cycle.
+ * Nothing is done if the windowed statistics are not selected.
+ */
+void CrDaOutCmpTempStatsCycle();
+
+/**
+ * Return the number of channels in the parameter area of a statistics report.
+ * @param pcktPar the parameter area of the packet of the statistics report
+ * @return the number of channels
+ */
+unsigned int CrDaOutCmpTempStatsGetN(const char* pcktPar);
+
+/**
+ * Read the entry of one channel in the parameter area of a statistics report.
+ * @param pcktPar the parameter area of the packet of the statistics report
+ * @param i the position of the channel in the report (it must be smaller than the number
+ * of channels of the report)
+ * @param entry the entry of the channel (output)
+ */
+void CrDaOutCmpTempStatsGetEntry(const char* pcktPar, unsigned int i, CrDaParStatsEntry_t* entry);
+
+/**
+ * Decode the entries in the parameter area of a statistics report.
+ * The references of the channels of the report are updated: a key frame clears the
+ * references of all channels and the decoded entries become the references of their
+ * channels.
+ * The caller must only decode a delta-encoded report if it has decoded all previous
+ * statistics reports of its source since a key frame.
+ * @param pcktPar the parameter area of the packet of the statistics report
+ * @param parLength the length in number of bytes of the parameter area
+ * @param ref the references of the channels of the source of the report (one entry for
+ * each of the <code>#CR_DA_TEMP_N_OF_CHANNELS</code> channels)
+ * @param entry the entries of the channels of the report (output, room for
+ * <code>#CR_DA_TEMP_STATS_MAX_N</code> entries)
+ * @return the number of entries or zero if the parameter area is not a valid statistics
+ * report (the references are then not valid anymore)
+ */
+unsigned int CrDaOutCmpTempStatsDecode(const char* pcktPar, unsigned int parLength, CrDaParStatsEntry_t* ref,
+                                       CrDaParStatsEntry_t* entry);
+
+/**
+ * Print the number of statistics reports which have been made, the number of channel
+ * statistics which they carried and the number which have been lost and, if the delta
+ * encoding is selected, the number of key frames and the length of the encoded entries.
+ * Nothing is printed if the windowed statistics are not selected.
+ * @param app the name of the application (e.g. "S1")
+ */
+void CrDaOutCmpTempStatsReport(const char* app);
+
+#endif /* CRDA_OUTCMP_TEMP_STATS_H_ */
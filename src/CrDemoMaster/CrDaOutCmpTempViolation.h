@@ -14,9 +14,12 @@
  *   <code>CrFwOutCmpDefEnableCheck.h</code> is used.
  * - Ready Check Operation: the default Ready Check Operation of
  *   <code>CrFwSmCheckAlwaysTrue.h</code> is used.
- * - Serialize Operation: this operation calls the default Serialize Operation of
- *   <code>CrFwOutCmpDefSerialize.h</code> and then it writes the temperature
- *   which violated the limit in the first byte of the parameter part of the report packet;
+ * - Serialize Operation: this operation serializes the header of the report packet
+ *   (from its template if the packet header templates of <code>CrDaPcktTemplate.h</code>
+ *   are selected; otherwise with the default Serialize Operation of
+ *   <code>CrFwOutCmpDefSerialize.h</code>) and then it writes the temperature
+ *   which violated the limit in the first byte of the parameter part of the report packet
+ *   and the number of suppressed reports in its second byte;
  *   and it sets the command destination to be the Master Application.
  * .
  *
@@ -43,9 +46,10 @@
 
 /**
  * Implementation of the Serialize Operation for the report for a temperature violation.
- * This operation calls the default Serialize Operation of
- * <code>CrFwOutCmpDefSerialize.h</code> and then writes the temperature
- * which violated the limit in the first byte of the parameter part of the report packet;
+ * This operation serializes the header of the report packet with
+ * <code>::CrDaPcktTemplateSerialize</code> and then writes the temperature
+ * which violated the limit in the first byte of the parameter part of the report packet
+ * and the number of suppressed reports in its second byte;
  * and it sets the command destination to be the Master Application.
  * The value of the limit violating temperature is set through function
  * <code>CrDaOutCmpTempViolationSetTemp</code>.
@@ -60,4 +64,12 @@ void CrDaOutCmpTempViolationSerialize(FwSmDesc_t smDesc);
  */
 void CrDaOutCmpTempViolationSetTemp(char temp);
 
+/**
+ * Set the number of reports which the channel of the violation has suppressed since its
+ * previous report (see <code>#CR_DA_TEMP_SUPPRESS</code>).
+ * The number is written in the second byte of the parameter part of the report packet.
+ * @param nOfSuppressed the number of suppressed reports
+ */
+void CrDaOutCmpTempViolationSetNOfSuppressed(unsigned char nOfSuppressed);
+
 #endif /* CRMA_OUTCMP_TEMP_VIOLATION_H_ */
@@ -0,0 +1,119 @@
+/**
+ * @file
+ * @ingroup crDemoMaster
+ * Parameter structures and parameter accessors of the commands and reports of the CORDET
+ * Demo.
+ * The content of this file is generated from the schema <code>#CR_DA_PAR_SCHEMA</code>
+ * (see <code>CrDaParSchema.h</code>) by the preprocessor.
+ * For each parameter kind of the schema, it defines:
+ * - the parameter structure <code>CrDaPar{kind}_t</code> which holds the fields of the kind
+ *   without padding (its size is the length of the parameter area of the kind, see
+ *   <code>#CR_DA_PAR_LENGTH</code>);
+ * - for each field, the accessors <code>CrDaPar{kind}Get{Member}(par)</code> and
+ *   <code>CrDaPar{kind}Set{Member}(par, v)</code> which read and write the field in a
+ *   parameter area;
+ * - the bulk accessors <code>CrDaPar{kind}Read(par, v, n)</code> and
+ *   <code>CrDaPar{kind}Write(par, v, n)</code> which read and write <code>n</code>
+ *   consecutive parameter structures of the kind.
+ * .
+ * The parameter area of a packet has no alignment guarantee.
+ * The accessors therefore copy the fields with <code>memcpy</code> whose size is a
+ * constant: the compiler turns each copy into one load or store of the size of the field
+ * (an unaligned one where the processor allows it) and no function is called.
+ * The fields are in the byte order of the packet header (see <code>CrFwPcktWire.h</code>):
+ * if it differs from the byte order of the host, the field accessors swap the bytes of
+ * each field and the bulk accessors swap the fields of each structure after copying them
+ * (<code>CrDaPar{kind}Swap</code>).
+ * The accessors are <code>static inline</code> and this file has no implementation file.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRDA_PAR_H_
+#define CRDA_PAR_H_
+
+#include <stddef.h>
+#include <string.h>
+#include "CrDaParSchema.h"
+/* Include Framework Files */
+#include "CrFwConstants.h"
+/* Include Configuration Files */
+#include "CrFwUserConstants.h"
+#include "CrFwPcktWire.h"
+
+/**
+ * The length in number of bytes of the parameters of a parameter kind.
+ * @param kind the name of the parameter kind
+ */
+#define CR_DA_PAR_LENGTH(kind) (sizeof(CrDaPar##kind##_t))
+
+/** Open the parameter structure of a kind. */
+#define CR_DA_PAR_STRUCT_KIND(kind) typedef struct __attribute__((packed)) {
+
+/** Declare a field of the parameter structure of a kind. */
+#define CR_DA_PAR_STRUCT_FIELD(kind, member, Member, type) type member;
+
+/** Close the parameter structure of a kind. */
+#define CR_DA_PAR_STRUCT_END(kind) } CrDaPar##kind##_t;
+
+/** Nothing is generated when a kind is opened. */
+#define CR_DA_PAR_NONE(kind)
+
+/** Define the accessors of a field of a kind. */
+#define CR_DA_PAR_FIELD_ACCESSORS(kind, member, Member, type) \
+	static inline type CrDaPar##kind##Get##Member(const char* par) { \
+		type v; \
+		CrFwPcktWireLoad(&v, par + offsetof(CrDaPar##kind##_t, member), sizeof(type)); \
+		return v; \
+	} \
+	static inline void CrDaPar##kind##Set##Member(char* par, type v) { \
+		CrFwPcktWireStore(par + offsetof(CrDaPar##kind##_t, member), &v, sizeof(type)); \
+	}
+
+/** Open the function which swaps the fields of a parameter structure of a kind. */
+#define CR_DA_PAR_SWAP_KIND(kind) \
+	static inline void CrDaPar##kind##Swap(char* v) {
+
+/** Swap a field of a parameter structure of a kind. */
+#define CR_DA_PAR_SWAP_FIELD(kind, member, Member, type) \
+		CrFwPcktWireSwap(v + offsetof(CrDaPar##kind##_t, member), sizeof(type));
+
+/** Close the function which swaps the fields of a parameter structure of a kind. */
+#define CR_DA_PAR_SWAP_END(kind) \
+	}
+
+/** Define the bulk accessors of a kind. */
+#define CR_DA_PAR_BULK_ACCESSORS(kind) \
+	static inline void CrDaPar##kind##Read(const char* par, CrDaPar##kind##_t* v, unsigned int n) { \
+		unsigned int i; \
+		memcpy(v, par, n*sizeof(CrDaPar##kind##_t)); \
+		for (i=0; (CR_FW_PCKT_WIRE_SWAP == 1) && (i<n); i++) \
+			CrDaPar##kind##Swap((char*)(v+i)); \
+	} \
+	static inline void CrDaPar##kind##Write(char* par, const CrDaPar##kind##_t* v, unsigned int n) { \
+		unsigned int i; \
+		memcpy(par, v, n*sizeof(CrDaPar##kind##_t)); \
+		for (i=0; (CR_FW_PCKT_WIRE_SWAP == 1) && (i<n); i++) \
+			CrDaPar##kind##Swap(par + i*sizeof(CrDaPar##kind##_t)); \
+	}
+
+/* Generate the parameter structures */
+CR_DA_PAR_SCHEMA(CR_DA_PAR_STRUCT_KIND, CR_DA_PAR_STRUCT_FIELD, CR_DA_PAR_STRUCT_END)
+
+/* Generate the swap functions */
+CR_DA_PAR_SCHEMA(CR_DA_PAR_SWAP_KIND, CR_DA_PAR_SWAP_FIELD, CR_DA_PAR_SWAP_END)
+
+/* Generate the accessors */
+CR_DA_PAR_SCHEMA(CR_DA_PAR_NONE, CR_DA_PAR_FIELD_ACCESSORS, CR_DA_PAR_BULK_ACCESSORS)
+
+#endif /* CRDA_PAR_H_ */
@@ -0,0 +1,114 @@
+/**
+ * @file
+ * @ingroup crDemoMaster
+ * Schema of the parameter areas of the commands and reports of the CORDET Demo.
+ * The schema is the only place where the layout of a parameter area is defined: the
+ * parameter structures and their accessors (see <code>CrDaPar.h</code>) are generated
+ * from it by the preprocessor when the demo applications are compiled.
+ *
+ * The schema is the list <code>#CR_DA_PAR_SCHEMA</code> of the parameter kinds.
+ * Each kind is a <code>KIND(kind)</code> line, followed by one
+ * <code>FIELD(kind, member, Member, type)</code> line for each of its fields (in the order
+ * in which they are written in the parameter area), and closed by an
+ * <code>END(kind)</code> line, where:
+ * - <code>kind</code> is the name of the kind (the parameter structure of the kind is
+ *   <code>CrDaPar{kind}_t</code>);
+ * - <code>member</code> is the name of the field in the parameter structure;
+ * - <code>Member</code> is the name of the field in its accessors
+ *   (<code>CrDaPar{kind}Get{Member}</code> and <code>CrDaPar{kind}Set{Member}</code>);
+ * - <code>type</code> is the type of the field (a type which declares a variable as
+ *   <code>type v</code>).
+ * .
+ * The fields are written without padding and in the byte order of the host (as the fields
+ * of the packet header).
+ * A new kind of command or report only needs its lines in the schema.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRDA_PARSCHEMA_H_
+#define CRDA_PARSCHEMA_H_
+
+/**
+ * The parameter kinds of the commands and reports of the CORDET Demo:
+ * - <code>Chan</code>: the Enable and Disable Temperature Monitoring commands (64,1) and (64,2);
+ * - <code>Limit</code>: the Set Temperature Limit command (64,3);
+ * - <code>Violation</code>: the Temperature Violation report (64,4);
+ * - <code>Ack</code>: the acknowledgement report of an InCommand (64,5);
+ * - <code>ViolationEntry</code>: the entry of one violation in a batch report (64,6);
+ * - <code>AckEntry</code>: the entry of one outcome in an acknowledgement batch report (64,7);
+ * - <code>Stats</code>: the statistics report of the temperature monitoring (64,8);
+ * - <code>StatsEntry</code>: the entry of one channel in a statistics report (64,8);
+ * - <code>LimitBlock</code>: the Bulk Set Temperature Limit command (64,9), whose fields are
+ *   followed by the limits of its channels (one byte per channel);
+ * - <code>ChanMask</code>: the Bulk Enable and Bulk Disable Temperature Monitoring commands
+ *   (64,10) and (64,11), whose fields are followed, if <code>isMasked</code> is set, by the
+ *   mask of their channels (one bit per channel, the first channel in the least significant
+ *   bit of the first byte).
+ * .
+ * @param KIND the macro which opens a kind
+ * @param FIELD the macro which describes a field of a kind
+ * @param END the macro which closes a kind
+ */
+#define CR_DA_PAR_SCHEMA(KIND, FIELD, END) \
+	KIND(Chan) \
+		FIELD(Chan, chan, Chan, unsigned short) \
+	END(Chan) \
+	KIND(Limit) \
+		FIELD(Limit, chan, Chan, unsigned short) \
+		FIELD(Limit, temp, Temp, char) \
+		FIELD(Limit, hyst, Hyst, char) \
+	END(Limit) \
+	KIND(Violation) \
+		FIELD(Violation, temp, Temp, char) \
+		FIELD(Violation, nOfSuppressed, NOfSuppressed, unsigned char) \
+	END(Violation) \
+	KIND(Ack) \
+		FIELD(Ack, cmdId, CmdId, CrFwInstanceId_t) \
+	END(Ack) \
+	KIND(ViolationEntry) \
+		FIELD(ViolationEntry, chan, Chan, unsigned short) \
+		FIELD(ViolationEntry, temp, Temp, char) \
+		FIELD(ViolationEntry, nOfSuppressed, NOfSuppressed, unsigned char) \
+		FIELD(ViolationEntry, timeStamp, TimeStamp, CrFwTimeStamp_t) \
+	END(ViolationEntry) \
+	KIND(AckEntry) \
+		FIELD(AckEntry, cmdId, CmdId, CrFwInstanceId_t) \
+		FIELD(AckEntry, outcome, Outcome, unsigned char) \
+		FIELD(AckEntry, failCode, FailCode, CrFwOutcome_t) \
+	END(AckEntry) \
+	KIND(Stats) \
+		FIELD(Stats, n, N, unsigned char) \
+		FIELD(Stats, nOfCycles, NOfCycles, unsigned short) \
+		FIELD(Stats, enc, Enc, unsigned char) \
+		FIELD(Stats, repNo, RepNo, unsigned char) \
+	END(Stats) \
+	KIND(StatsEntry) \
+		FIELD(StatsEntry, chan, Chan, unsigned short) \
+		FIELD(StatsEntry, nOfSamples, NOfSamples, unsigned short) \
+		FIELD(StatsEntry, nOfAbove, NOfAbove, unsigned short) \
+		FIELD(StatsEntry, min, Min, char) \
+		FIELD(StatsEntry, max, Max, char) \
+		FIELD(StatsEntry, mean, Mean, short) \
+	END(StatsEntry) \
+	KIND(LimitBlock) \
+		FIELD(LimitBlock, first, First, unsigned short) \
+		FIELD(LimitBlock, n, N, unsigned short) \
+	END(LimitBlock) \
+	KIND(ChanMask) \
+		FIELD(ChanMask, first, First, unsigned short) \
+		FIELD(ChanMask, n, N, unsigned short) \
+		FIELD(ChanMask, isMasked, IsMasked, unsigned char) \
+	END(ChanMask)
+
+#endif /* CRDA_PARSCHEMA_H_ */
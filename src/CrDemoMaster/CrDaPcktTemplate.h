@@ -0,0 +1,71 @@
+/**
+ * @file
+ * @ingroup crDemoMaster
+ * Interface for the packet header templates of the demo applications of the CORDET Demo.
+ * The default Serialize Operation (<code>CrFwOutCmpDefSerialize</code>) writes every
+ * field of the header of the packet of an OutComponent although, for the reports of a
+ * given kind, destination and group, only the command or report identifier and the time
+ * stamp change from one report to the next (the sequence counter is written by the
+ * OutStream when the packet is sent).
+ *
+ * If the packet header templates are selected (see <code>#CR_DA_PCKT_TEMPLATE</code>),
+ * <code>::CrDaPcktTemplateSerialize</code> keeps a template of the header for each kind,
+ * destination and group: the first report of a template is serialized by the default
+ * Serialize Operation and its header is recorded as the template; the header of the
+ * next reports is copied from the template in one block and their identifier and time
+ * stamp are then patched.
+ * The length of the packet is patched too as the packets of a kind need not have the
+ * same length (e.g. the statistics reports whose entries are delta-encoded, see
+ * <code>CrDaOutCmpTempStats.h</code>).
+ * If there are already <code>#CR_DA_PCKT_TEMPLATE_N</code> templates, the reports of a
+ * new template are serialized by the default Serialize Operation.
+ *
+ * <code>::CrDaPcktTemplateSerialize</code> has the prototype of a Serialize Operation: it
+ * can be used as the Serialize Operation of the kinds whose parameters are written when
+ * they are made or it can be called by a Serialize Operation in place of the default one.
+ * It may be called concurrently by the threads of the manager pool (see
+ * <code>CrDaMgrPool.h</code>): a template is only used once it is complete (two threads
+ * which serialize the first report of a template at the same time may record it twice).
+ * If the templates are not selected, it calls the default Serialize Operation.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRDA_PCKTTEMPLATE_H_
+#define CRDA_PCKTTEMPLATE_H_
+
+/* Include FW Profile Files */
+#include "FwSmConstants.h"
+/* Include Framework Files */
+#include "CrFwConstants.h"
+/* Include Configuration Files */
+#include "CrFwUserConstants.h"
+#include "CrDaConstants.h"
+
+/**
+ * Serialize the header of the packet of an OutComponent from the template of its kind,
+ * destination and group.
+ * The template is recorded when the first OutComponent of the template is serialized.
+ * @param smDesc the descriptor of the OutComponent state machine
+ */
+void CrDaPcktTemplateSerialize(FwSmDesc_t smDesc);
+
+/**
+ * Print the number of templates and the number of headers which were copied from a
+ * template and which were serialized by the default Serialize Operation.
+ * Nothing is printed if the templates are not selected.
+ * @param app the prefix of the printed lines (e.g. "S1")
+ */
+void CrDaPcktTemplateReport(const char* app);
+
+#endif /* CRDA_PCKTTEMPLATE_H_ */
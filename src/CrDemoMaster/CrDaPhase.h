@@ -0,0 +1,112 @@
+/**
+ * @file
+ * @ingroup crDemoMaster
+ * Interface for the phase timing of the control cycles of the demo applications of
+ * the CORDET Demo.
+ * A control cycle of a demo application is made up of phases: the poll of the
+ * transport, the executions of the InLoader, and the executions of the InManagers
+ * and OutManagers (see <code>::CrDaPhase_t</code>).
+ * The demo applications bracket each phase with calls to <code>::CrDaPhaseStart</code>
+ * and <code>::CrDaPhaseStop</code> which take timestamps from the monotonic clock.
+ * For each phase, the minimum, mean and maximum duration and the 99th percentile of
+ * the durations are kept (see <code>::CrDaPhaseGetStats</code>) and a summary line
+ * can be printed with <code>::CrDaPhaseReport</code>.
+ *
+ * The percentiles are computed from a histogram with logarithmic buckets: each power
+ * of two of the duration is divided into 2^<code>#CR_DA_PHASE_SUB_BUCKET_BITS</code>
+ * linear buckets.
+ * A percentile is returned as the upper bound of its bucket and its relative error is
+ * therefore less than 2^-<code>#CR_DA_PHASE_SUB_BUCKET_BITS</code>.
+ * The histogram has a fixed size and the cost of recording a duration is independent
+ * of the number of recorded durations.
+ *
+ * This module is not thread-safe: the phases must be timed by the thread which
+ * executes the framework components.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRDA_PHASE_H_
+#define CRDA_PHASE_H_
+
+/* Include Framework Files */
+#include "CrFwConstants.h"
+/* Include Configuration Files */
+#include "CrFwUserConstants.h"
+#include "CrDaConstants.h"
+
+/** Type for the phases of a control cycle. */
+typedef enum {
+	/** The poll of the transport. */
+	crDaPhasePoll = 0,
+	/** An execution of the InLoader (with the InLoader drain, a drain of all InStreams). */
+	crDaPhaseInLoader = 1,
+	/** An execution of an InManager (with the manager pool, an execution of all Managers). */
+	crDaPhaseInManager = 2,
+	/** An execution of an OutManager. */
+	crDaPhaseOutManager = 3
+} CrDaPhase_t;
+
+/** The number of phases of a control cycle. */
+#define CR_DA_PHASE_N_OF_PHASES 4
+
+/** Type for the timing statistics of a phase (all durations are in nanoseconds). */
+typedef struct {
+	/** The number of recorded durations. */
+	unsigned int nOfSamples;
+	/** The shortest recorded duration. */
+	unsigned long long min;
+	/** The mean of the recorded durations. */
+	unsigned long long mean;
+	/** The longest recorded duration. */
+	unsigned long long max;
+	/** The 99th percentile of the recorded durations. */
+	unsigned long long p99;
+} CrDaPhaseStats_t;
+
+/**
+ * Mark the start of a phase.
+ * @param phase the phase
+ */
+void CrDaPhaseStart(CrDaPhase_t phase);
+
+/**
+ * Mark the end of a phase and record its duration.
+ * The duration is the time elapsed since the last call to
+ * <code>::CrDaPhaseStart</code> for the same phase.
+ * @param phase the phase
+ */
+void CrDaPhaseStop(CrDaPhase_t phase);
+
+/**
+ * Return the timing statistics of a phase.
+ * If no duration has been recorded for the phase, all statistics are zero.
+ * @param phase the phase
+ * @param stats the location where the statistics are returned
+ */
+void CrDaPhaseGetStats(CrDaPhase_t phase, CrDaPhaseStats_t* stats);
+
+/**
+ * Print a summary line with the timing statistics of all phases.
+ * The durations are printed in microseconds as min/mean/max/p99.
+ * The summary line is written as an information message of the log (see <code>CrDaLog.h</code>).
+ * @param app the prefix of the summary line (e.g. "MA")
+ */
+void CrDaPhaseReport(const char* app);
+
+/**
+ * Clear the timing statistics of all phases.
+ */
+void CrDaPhaseReset();
+
+#endif /* CRDA_PHASE_H_ */
@@ -0,0 +1,139 @@
+/**
+ * @file
+ * @ingroup crDemoMaster
+ * Receive ring buffer for the socket connections of the CORDET Demo.
+ * A socket connection carries a stream of bytes: one read operation on the socket
+ * may return several packets or only a part of a packet.
+ * The receive ring buffer decouples the read operations on the socket from the
+ * framing of the packets:
+ * - Function <code>::CrDaRxRingFill</code> reads as many bytes from the socket as
+ *   can be stored in the ring buffer with one system call.
+ * - Function <code>::CrDaRxRingPeekPckt</code> checks whether the ring buffer holds
+ *   a complete packet and returns its length and header without removing it.
+ * - Function <code>::CrDaRxRingGet</code> then copies the packet directly into its
+ *   final location (normally a packet of the packet pool) and removes it from
+ *   the ring buffer.
+ * .
+ * A packet is complete when the ring buffer holds at least as many bytes as given
+ * by its length field.
+ * Incomplete packets remain in the ring buffer until the rest of their bytes
+ * is received.
+ *
+ * A packet with a length which is shorter than its header or longer than
+ * the maximum packet length indicates that the byte stream has lost its framing.
+ * In this case, the content of the ring buffer is discarded.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRDA_RXRING_H_
+#define CRDA_RXRING_H_
+
+/* Include Framework Files */
+#include "CrFwConstants.h"
+/* Include Configuration Files */
+#include "CrFwUserConstants.h"
+
+/** Type for the receive ring buffer of a socket connection. */
+typedef struct {
+	/** The storage area of the ring buffer. */
+	unsigned char* buf;
+	/** The size in number of bytes of the storage area. */
+	unsigned int size;
+	/** The index of the first byte in the ring buffer. */
+	unsigned int head;
+	/** The number of bytes in the ring buffer. */
+	unsigned int count;
+} CrDaRxRing_t;
+
+/**
+ * Create the storage area of a ring buffer and clear the ring buffer.
+ * @param ring the ring buffer
+ * @param size the size in number of bytes of the storage area
+ * @return 1 if the storage area could be created; 0 otherwise
+ */
+CrFwBool_t CrDaRxRingInit(CrDaRxRing_t* ring, unsigned int size);
+
+/**
+ * Release the storage area of a ring buffer.
+ * @param ring the ring buffer
+ */
+void CrDaRxRingFree(CrDaRxRing_t* ring);
+
+/**
+ * Discard the content of a ring buffer.
+ * @param ring the ring buffer
+ */
+void CrDaRxRingClear(CrDaRxRing_t* ring);
+
+/**
+ * Read bytes from a socket into a ring buffer.
+ * The function performs one read operation on the socket which may return as many
+ * bytes as there is free space in the ring buffer.
+ * @param ring the ring buffer
+ * @param fd the file descriptor of the socket
+ * @return the number of bytes read from the socket; 0 if the socket has been closed
+ * by its peer; -1 if no bytes are available from the socket or if the ring buffer
+ * is full
+ */
+int CrDaRxRingFill(CrDaRxRing_t* ring, int fd);
+
+/**
+ * Copy bytes which have already been received into a ring buffer.
+ * This is used when the bytes are received by the operating system into a buffer
+ * of its choice (e.g. by the io_uring backend of the server socket).
+ * As many bytes are copied as there is free space in the ring buffer.
+ * @param ring the ring buffer
+ * @param src the bytes to be copied
+ * @param n the number of bytes to be copied
+ * @return the number of bytes which were copied
+ */
+unsigned int CrDaRxRingPut(CrDaRxRing_t* ring, const unsigned char* src, unsigned int n);
+
+/**
+ * Extract a fixed number of bytes from a ring buffer.
+ * This is used to extract a packet after <code>::CrDaRxRingPeekPckt</code> has
+ * reported it as complete and for data which are exchanged on a socket connection
+ * outside of packets (e.g. the announcement of a client on a server socket).
+ * @param ring the ring buffer
+ * @param dest the location where the bytes are copied
+ * @param n the number of bytes to be extracted
+ * @return 1 if the bytes were extracted; 0 if the ring buffer holds fewer than
+ * <code>n</code> bytes (in this case, the ring buffer is left unchanged)
+ */
+CrFwBool_t CrDaRxRingGet(CrDaRxRing_t* ring, unsigned char* dest, unsigned int n);
+
+/**
+ * Check whether a ring buffer holds a complete packet.
+ * If the ring buffer holds a complete packet, its length is returned and its header
+ * is copied to the argument location but the packet is left in the ring buffer.
+ * The packet can then be extracted with <code>::CrDaRxRingGet</code>.
+ * A packet may be followed by a trailer which is not counted in its length (e.g. the CRC
+ * of the integrity check, see <code>CrDaCrc.h</code>): the packet is then only complete
+ * once its trailer has arrived too and the trailer is extracted separately.
+ * @param ring the ring buffer
+ * @param hdr the location where the packet header is copied
+ * @param hdrLength the length of the packet header (this is also the minimum length
+ * of a packet)
+ * @param maxLength the maximum length of a packet
+ * @param trailerLength the length of the trailer which follows a packet (zero if the
+ * packets have no trailer)
+ * @param len the location where the packet length is returned
+ * @return 1 if the ring buffer holds a complete packet; 0 if it does not hold a complete
+ * packet; -1 if it holds a packet with an invalid length (in this case, the content
+ * of the ring buffer is discarded)
+ */
+int CrDaRxRingPeekPckt(CrDaRxRing_t* ring, unsigned char* hdr, unsigned int hdrLength,
+                       unsigned int maxLength, unsigned int trailerLength, unsigned int* len);
+
+#endif /* CRDA_RXRING_H_ */
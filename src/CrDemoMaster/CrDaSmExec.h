@@ -0,0 +1,79 @@
+/**
+ * @file
+ * @ingroup crDemoMaster
+ * Interface for the execution fast path of the framework components of the demo
+ * applications of the CORDET Demo.
+ * In each control cycle, the demo applications execute the InLoader once for each
+ * InStream and each of their InManagers and OutManagers.
+ * An execution of these components goes through their state machine and their Execution
+ * Procedure even when it has nothing to do:
+ * - the InLoader does nothing when its InStream holds no packets;
+ * - an InManager does nothing when its PCRL holds no components; and
+ * - an OutManager does nothing when its POCL holds no components.
+ * .
+ * If the fast path is selected (see <code>#CR_DA_SM_FAST_PATH</code>), the functions of
+ * this module check these conditions and only execute the component when it has work to
+ * do.
+ * The check reads one counter of the component and an idle component is not executed at
+ * all.
+ * The behaviour of the applications is not affected: a skipped execution is one in which
+ * the component would not have changed state or executed an action (only the execution
+ * counters of its state machine and of its Execution Procedure do not advance).
+ * If the fast path is not selected, the components are always executed.
+ *
+ * The functions of this module must be called from the thread which executes the cycle.
+ * The number of executions and of skipped executions is printed by
+ * <code>::CrDaSmExecReport</code>.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRDA_SMEXEC_H_
+#define CRDA_SMEXEC_H_
+
+/* Include Framework Files */
+#include "CrFwConstants.h"
+/* Include Configuration Files */
+#include "CrFwUserConstants.h"
+#include "CrDaConstants.h"
+/* Include FW Profile files */
+#include "FwSmConstants.h"
+
+/**
+ * Set the InStream of the InLoader and execute the InLoader unless the InStream holds
+ * no packets.
+ * @param inStream the InStream from which the InLoader loads the packets
+ */
+void CrDaSmExecInLoader(FwSmDesc_t inStream);
+
+/**
+ * Execute an InManager unless its PCRL holds no components.
+ * @param inManager the InManager
+ */
+void CrDaSmExecInManager(FwSmDesc_t inManager);
+
+/**
+ * Execute an OutManager unless its POCL holds no components.
+ * @param outManager the OutManager
+ */
+void CrDaSmExecOutManager(FwSmDesc_t outManager);
+
+/**
+ * Print the number of executions of the InLoader and of the managers and the number of
+ * those which the fast path has skipped.
+ * Nothing is printed if the fast path is not selected.
+ * @param app the name of the application (e.g. "MA")
+ */
+void CrDaSmExecReport(const char* app);
+
+#endif /* CRDA_SMEXEC_H_ */
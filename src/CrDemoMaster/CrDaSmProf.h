@@ -0,0 +1,106 @@
+/**
+ * @file
+ * @ingroup crDemoMaster
+ * Interface for the execution profiler of the state machines and procedures of the demo
+ * applications of the CORDET Demo.
+ * The demo modules execute the state machines of the framework components through
+ * <code>#CR_DA_SM_EXECUTE</code> and procedures through <code>#CR_DA_PR_EXECUTE</code>.
+ * If the profiler is not selected (see <code>#CR_DA_SM_PROF</code>), these macros are
+ * <code>FwSmExecute</code> and <code>FwPrExecute</code> and the profiler adds no code.
+ *
+ * If the profiler is selected, each execution is recorded in the entry of the state
+ * machine or procedure (an entry is created at its first execution):
+ * - the number of executions;
+ * - the number of transitions, i.e. of executions after which the current state or node
+ *   has changed, and the number of each transition between two states or nodes (the
+ *   <code>#CR_DA_SM_PROF_N_OF_TRANS</code> transitions first taken are counted separately;
+ *   the others are counted together);
+ * - the total and the maximum time of an execution: this is the time spent in the guards
+ *   and actions of the state machine or procedure (including those of the components it
+ *   executes, e.g. the InCommands executed by an InManager).
+ * .
+ * An entry is identified by the type and instance identifiers of its component (taken from
+ * its <code>::CrFwCmpData_t</code>).
+ * <code>::CrDaSmProfDump</code> prints the entries from the one which took the most time
+ * and, for each entry, its hottest transitions.
+ *
+ * A state machine or procedure must only be executed by one thread at a time (as required
+ * by the framework); different entries may be updated by different threads (e.g. by the
+ * threads of the manager pool).
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRDA_SMPROF_H_
+#define CRDA_SMPROF_H_
+
+/* Include FW Profile files */
+#include "FwSmConstants.h"
+#include "FwSmCore.h"
+#include "FwPrConstants.h"
+#include "FwPrCore.h"
+/* Include Framework Files */
+#include "CrFwConstants.h"
+/* Include Configuration Files */
+#include "CrFwUserConstants.h"
+#include "CrDaConstants.h"
+
+/** The maximum number of state machines and procedures which are profiled. */
+#define CR_DA_SM_PROF_N_OF_ENTRIES 64
+
+/** The number of transitions which are counted separately for each entry. */
+#define CR_DA_SM_PROF_N_OF_TRANS 8
+
+/** The number of transitions of each entry which are printed by ::CrDaSmProfDump. */
+#define CR_DA_SM_PROF_N_OF_HOT_TRANS 3
+
+#if (CR_DA_SM_PROF == 1)
+/** Execute a state machine and record the execution in its profile. */
+#define CR_DA_SM_EXECUTE(smDesc) CrDaSmProfSmExecute(smDesc)
+/** Execute a procedure and record the execution in its profile. */
+#define CR_DA_PR_EXECUTE(prDesc) CrDaSmProfPrExecute(prDesc)
+#else
+/** Execute a state machine (the profiler is not selected). */
+#define CR_DA_SM_EXECUTE(smDesc) FwSmExecute(smDesc)
+/** Execute a procedure (the profiler is not selected). */
+#define CR_DA_PR_EXECUTE(prDesc) FwPrExecute(prDesc)
+#endif
+
+/**
+ * Execute a state machine and record the execution in its profile.
+ * The execution is not recorded if there are already
+ * <code>#CR_DA_SM_PROF_N_OF_ENTRIES</code> entries.
+ * This function should be called through <code>#CR_DA_SM_EXECUTE</code>.
+ * @param smDesc the state machine
+ */
+void CrDaSmProfSmExecute(FwSmDesc_t smDesc);
+
+/**
+ * Execute a procedure and record the execution in its profile.
+ * The execution is not recorded if there are already
+ * <code>#CR_DA_SM_PROF_N_OF_ENTRIES</code> entries.
+ * This function should be called through <code>#CR_DA_PR_EXECUTE</code>.
+ * @param prDesc the procedure
+ */
+void CrDaSmProfPrExecute(FwPrDesc_t prDesc);
+
+/**
+ * Print the profile of each state machine and procedure which has been executed, from
+ * the one which took the most time, with its <code>#CR_DA_SM_PROF_N_OF_HOT_TRANS</code>
+ * hottest transitions.
+ * Nothing is printed if the profiler is not selected.
+ * @param app the name of the application (e.g. "MA")
+ */
+void CrDaSmProfDump(const char* app);
+
+#endif /* CRDA_SMPROF_H_ */
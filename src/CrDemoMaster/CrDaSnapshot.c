@@ -0,0 +1,196 @@
+/**
+ * @file
+ * @ingroup crDemoMaster
+ * Implementation of the snapshot of the application state of the demo applications.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "CrDaSnapshot.h"
+#include "CrDaTempMonitor.h"
+/* Include framework files */
+#include "OutStream/CrFwOutStream.h"
+
+#if (CR_DA_SNAPSHOT == 1)
+/** The mapping of the snapshot file (NULL if the snapshot has not been started). */
+static CrDaSnapshotImage_t* image = NULL;
+
+/**
+ * Collect the current state of the application.
+ * @param state the state
+ */
+static void snapshotGet(CrDaSnapshotState_t* state);
+
+/**
+ * Restore the state of the application.
+ * @param state the state
+ */
+static void snapshotSet(const CrDaSnapshotState_t* state);
+
+/**
+ * Compute the checksum of a state (the Fletcher-32 checksum of its bytes).
+ * @param state the state
+ * @return the checksum
+ */
+static uint32_t snapshotChecksum(const CrDaSnapshotState_t* state);
+
+/**
+ * Write a state into the image.
+ * @param state the state
+ */
+static void snapshotWrite(const CrDaSnapshotState_t* state);
+#endif
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaSnapshotStart(const char* app, unsigned int appId) {
+#if (CR_DA_SNAPSHOT == 1)
+	CrDaSnapshotState_t state;
+	char fileName[64];
+	struct stat st;
+	void* p;
+	int fd;
+	CrFwBool_t isRestored;
+
+	if (image != NULL)
+		return 0;
+
+	snprintf(fileName, sizeof(fileName), "CrDaSnapshot_%s.img", app);
+	fd = open(fileName, O_RDWR | O_CREAT, 0644);
+	if (fd < 0) {
+		perror("CrDaSnapshotStart, Snapshot file opening");
+		return 0;
+	}
+	if ((fstat(fd, &st) < 0) || ((st.st_size != (off_t)sizeof(CrDaSnapshotImage_t)) &&
+	                             (ftruncate(fd, (off_t)sizeof(CrDaSnapshotImage_t)) < 0))) {
+		perror("CrDaSnapshotStart, Snapshot file sizing");
+		close(fd);
+		return 0;
+	}
+	p = mmap(NULL, sizeof(CrDaSnapshotImage_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);	/* the mapping keeps the file open */
+	if (p == MAP_FAILED) {
+		perror("CrDaSnapshotStart, Snapshot file mapping");
+		return 0;
+	}
+	image = (CrDaSnapshotImage_t*)p;
+
+	/* A file of another size has been truncated or extended and its image is not valid */
+	isRestored = (st.st_size == (off_t)sizeof(CrDaSnapshotImage_t)) && (image->magic == CR_DA_SNAPSHOT_MAGIC) &&
+	             (image->version == CR_DA_SNAPSHOT_VERSION) && (image->appId == appId) &&
+	             (image->length == sizeof(CrDaSnapshotState_t)) && ((image->gen % 2) == 0) &&
+	             (image->checksum == snapshotChecksum(&image->state));
+	if (isRestored) {
+		snapshotSet(&image->state);
+		printf("%s: Warm restart from snapshot image %s (generation %u)\n", app, fileName, image->gen);
+		return 1;
+	}
+
+	/* Start a new image with the current state */
+	memset(image, 0, sizeof(CrDaSnapshotImage_t));
+	image->magic = CR_DA_SNAPSHOT_MAGIC;
+	image->version = CR_DA_SNAPSHOT_VERSION;
+	image->appId = (uint16_t)appId;
+	image->length = sizeof(CrDaSnapshotState_t);
+	snapshotGet(&state);
+	snapshotWrite(&state);
+	return 0;
+#else
+	(void)app;
+	(void)appId;
+	return 0;
+#endif
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaSnapshotTake() {
+#if (CR_DA_SNAPSHOT == 1)
+	CrDaSnapshotState_t state;
+
+	if (image == NULL)
+		return;
+	snapshotGet(&state);
+	if (memcmp(&state, &image->state, sizeof(state)) != 0)
+		snapshotWrite(&state);
+#endif
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaSnapshotStop() {
+#if (CR_DA_SNAPSHOT == 1)
+	if (image == NULL)
+		return;
+	CrDaSnapshotTake();
+	msync(image, sizeof(CrDaSnapshotImage_t), MS_SYNC);
+	munmap(image, sizeof(CrDaSnapshotImage_t));
+	image = NULL;
+#endif
+}
+
+#if (CR_DA_SNAPSHOT == 1)
+/* ---------------------------------------------------------------------------------------------*/
+static void snapshotGet(CrDaSnapshotState_t* state) {
+	FwSmDesc_t outStream;
+	CrFwInstanceId_t i;
+	CrFwGroup_t g;
+
+	memset(state, 0, sizeof(CrDaSnapshotState_t));	/* the padding bytes are compared */
+	for (i=0; i<CR_FW_NOF_OUTSTREAM; i++) {
+		outStream = CrFwOutStreamMake(i);
+		for (g=0; g<CR_DA_PCKT_N_OF_GROUPS; g++)
+			state->seqCnt[i][g] = CrFwOutStreamGetSeqCnt(outStream, g);
+	}
+	CrDaTempMonitoringGetState(&state->tempChan);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void snapshotSet(const CrDaSnapshotState_t* state) {
+	FwSmDesc_t outStream;
+	CrFwInstanceId_t i;
+	CrFwGroup_t g;
+
+	for (i=0; i<CR_FW_NOF_OUTSTREAM; i++) {
+		outStream = CrFwOutStreamMake(i);
+		for (g=0; g<CR_DA_PCKT_N_OF_GROUPS; g++)
+			CrFwOutStreamSetSeqCnt(outStream, g, state->seqCnt[i][g]);
+	}
+	CrDaTempMonitoringSetState(&state->tempChan);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static uint32_t snapshotChecksum(const CrDaSnapshotState_t* state) {
+	const unsigned char* b = (const unsigned char*)state;
+	uint32_t sum1 = 0, sum2 = 0;
+	size_t i;
+
+	for (i=0; i<sizeof(CrDaSnapshotState_t); i++) {
+		sum1 = (sum1 + b[i]) % 65535;
+		sum2 = (sum2 + sum1) % 65535;
+	}
+	return (sum2 << 16) | sum1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void snapshotWrite(const CrDaSnapshotState_t* state) {
+	/* The generation is odd while the state and its checksum are written */
+	__atomic_store_n(&image->gen, image->gen + 1, __ATOMIC_RELEASE);
+	memcpy(&image->state, state, sizeof(CrDaSnapshotState_t));
+	image->checksum = snapshotChecksum(state);
+	__atomic_store_n(&image->gen, image->gen + 1, __ATOMIC_RELEASE);
+}
+#endif
@@ -0,0 +1,119 @@
+/**
+ * @file
+ * @ingroup crDemoMaster
+ * Interface for the snapshot of the application state of the demo applications of the
+ * CORDET Demo.
+ * When a demo application is restarted, its framework components are created and
+ * configured anew: the sequence counters of its OutStreams start again from their initial
+ * value and the temperature monitoring loses the limits and the enable status of the
+ * channels which the Master Application has commanded.
+ *
+ * If the snapshot is selected (see <code>#CR_DA_SNAPSHOT</code>), the state which must
+ * survive a restart is kept in a compact binary image in the memory-mapped file
+ * <code>CrDaSnapshot_&lt;app&gt;.img</code>:
+ * - the sequence counter of each group of each OutStream; and
+ * - the limit, the hysteresis band and the enable status of each channel of the
+ *   temperature monitoring.
+ * .
+ * <code>::CrDaSnapshotStart</code> maps the file when the application has configured its
+ * framework components and, if the file holds a valid image of the same application,
+ * restores the state from it (a warm restart).
+ * <code>::CrDaSnapshotTake</code> writes the state into the image after each execution of
+ * the InManagers and OutManagers: the image is only written when the state has changed
+ * and the writing is a copy of a few bytes into the mapping (the kernel writes the pages
+ * back to the file).
+ * The image therefore survives a crash of the application.
+ * The image carries a generation counter which is odd while the image is written and a
+ * checksum of the state: an image which was not completely written is not restored.
+ *
+ * The commands and reports which were pending in the components at the time of the
+ * restart, and the content of the InRegistry and OutRegistry (which track them), are not
+ * part of the image: they are lost in a restart.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRDA_SNAPSHOT_H_
+#define CRDA_SNAPSHOT_H_
+
+#include <stdint.h>
+/* Include Framework Files */
+#include "CrFwConstants.h"
+/* Include Configuration Files */
+#include "CrFwUserConstants.h"
+#include "CrFwOutStreamUserPar.h"
+#include "CrDaConstants.h"
+/* Include Demo Application files */
+#include "CrDaTempMonitor.h"
+
+/** The identifier of the snapshot images ("CRSN"). */
+#define CR_DA_SNAPSHOT_MAGIC 0x4352534E
+
+/** The version of the format of the snapshot images. */
+#define CR_DA_SNAPSHOT_VERSION 2
+
+/** The state of an application which is kept in its snapshot image. */
+typedef struct {
+	/** The sequence counter of each group of each OutStream. */
+	CrFwSeqCnt_t seqCnt[CR_FW_NOF_OUTSTREAM][CR_DA_PCKT_N_OF_GROUPS];
+	/** The configuration of the channels of the temperature monitoring. */
+	CrDaTempChanConfig_t tempChan;
+} CrDaSnapshotState_t;
+
+/** The snapshot image of an application. */
+typedef struct {
+	/** The identifier of the snapshot images (<code>#CR_DA_SNAPSHOT_MAGIC</code>). */
+	uint32_t magic;
+	/** The version of the format (<code>#CR_DA_SNAPSHOT_VERSION</code>). */
+	uint16_t version;
+	/** The identifier of the application which wrote the image. */
+	uint16_t appId;
+	/** The length of the state in bytes. */
+	uint32_t length;
+	/** The generation of the image (odd while the image is written). */
+	uint32_t gen;
+	/** The checksum of the state. */
+	uint32_t checksum;
+	/** The state. */
+	CrDaSnapshotState_t state;
+} CrDaSnapshotImage_t;
+
+/**
+ * Map the snapshot file and restore the state of the application from its image.
+ * The snapshot file <code>CrDaSnapshot_&lt;app&gt;.img</code> is created in the working
+ * directory if it does not exist.
+ * The state is only restored if the file holds a complete image of the same version,
+ * written by the same application; otherwise the current state is written into the image.
+ * This function must be called when the framework components of the application have
+ * been configured.
+ * Nothing is done if the snapshot is not selected.
+ * @param app the name of the application (e.g. "MA")
+ * @param appId the identifier of the application
+ * @return 1 if the state was restored from the image; 0 otherwise
+ */
+CrFwBool_t CrDaSnapshotStart(const char* app, unsigned int appId);
+
+/**
+ * Write the state of the application into its image if it has changed since the last
+ * time it was written.
+ * Nothing is done if the snapshot is not selected or has not been started.
+ */
+void CrDaSnapshotTake();
+
+/**
+ * Write the state of the application into its image and unmap the snapshot file.
+ * Nothing is done if the snapshot is not selected or has not been started.
+ */
+void CrDaSnapshotStop();
+
+#endif /* CRDA_SNAPSHOT_H_ */
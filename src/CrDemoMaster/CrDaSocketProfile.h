@@ -0,0 +1,97 @@
+/**
+ * @file
+ * @ingroup crDemoMaster
+ * Interface for the tuning profiles of the sockets of the CORDET Demo.
+ * A tuning profile is a set of socket options which is applied to every stream socket
+ * created by the client socket (see <code>CrDaClientSocket.h</code>) and to every
+ * connection accepted by the server socket (see <code>CrDaServerSocket.h</code>),
+ * including connections which are accepted after the profile has been selected.
+ * The following profiles are available:
+ * - <code>::crDaSocketDefault</code> leaves the socket options of the operating system
+ *   unchanged.
+ * - <code>::crDaSocketLowLatency</code> disables the Nagle algorithm (<code>TCP_NODELAY</code>)
+ *   so that small command packets are sent immediately instead of waiting for the
+ *   acknowledgement of the previous segment, and it enables busy polling of the
+ *   receive queue (<code>SO_BUSY_POLL</code>) for <code>#CR_DA_SOCKET_BUSY_POLL_USEC</code>
+ *   microseconds.
+ * - <code>::crDaSocketHighThroughput</code> keeps the Nagle algorithm enabled and sets
+ *   the send and receive buffers to <code>#CR_DA_SOCKET_BUF_SIZE</code> bytes.
+ * .
+ * The operating system may reject or adjust some options (e.g. busy polling may be
+ * disabled in the kernel and the buffer sizes are capped by system limits).
+ * Function <code>::CrDaSocketApplyProfile</code> therefore reads the options back after
+ * setting them and reports the values which actually took effect.
+ *
+ * The profile must be selected before the sockets are initialized.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRDA_SOCKETPROFILE_H_
+#define CRDA_SOCKETPROFILE_H_
+
+/* Include Framework Files */
+#include "CrFwConstants.h"
+/* Include Configuration Files */
+#include "CrFwUserConstants.h"
+#include "CrDaConstants.h"
+
+/** Type for the tuning profiles of the sockets. */
+typedef enum {
+	/** The socket options of the operating system are left unchanged. */
+	crDaSocketDefault = 0,
+	/** The socket options are tuned for the latency of small packets. */
+	crDaSocketLowLatency = 1,
+	/** The socket options are tuned for the throughput of bulk transfers. */
+	crDaSocketHighThroughput = 2
+} CrDaSocketProfile_t;
+
+/** Type for the socket options which took effect on a socket. */
+typedef struct {
+	/** The tuning profile which was applied. */
+	CrDaSocketProfile_t profile;
+	/** The value of the <code>TCP_NODELAY</code> option (1 if the Nagle algorithm is disabled). */
+	int noDelay;
+	/** The size of the send buffer in bytes as reported by the operating system. */
+	int sndBuf;
+	/** The size of the receive buffer in bytes as reported by the operating system. */
+	int rcvBuf;
+	/** The busy-poll time in microseconds (0 if busy polling is disabled or not supported). */
+	int busyPoll;
+} CrDaSocketTuning_t;
+
+/**
+ * Select the tuning profile of the sockets.
+ * The profile is applied to the sockets which are created after this call.
+ * @param profile the tuning profile
+ */
+void CrDaSocketSetProfile(CrDaSocketProfile_t profile);
+
+/**
+ * Return the tuning profile of the sockets.
+ * @return the tuning profile
+ */
+CrDaSocketProfile_t CrDaSocketGetProfile();
+
+/**
+ * Apply the selected tuning profile to a stream socket.
+ * The options of the profile are set on the socket and they are then read back
+ * from the socket.
+ * The values which took effect are returned in <code>tuning</code>.
+ * @param fd the file descriptor of the socket
+ * @param tuning the location where the socket options which took effect are returned
+ * @return 1 if all options of the profile took effect as requested; 0 otherwise
+ */
+CrFwBool_t CrDaSocketApplyProfile(int fd, CrDaSocketTuning_t* tuning);
+
+#endif /* CRDA_SOCKETPROFILE_H_ */
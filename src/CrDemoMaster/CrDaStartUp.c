@@ -0,0 +1,237 @@
+/**
+ * @file
+ * @ingroup crDemoMaster
+ * Implementation of the start-up orchestrator of the demo applications.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdio.h>
+#include <errno.h>
+#include <time.h>
+#include <pthread.h>
+#include "CrDaStartUp.h"
+#include "CrDaThread.h"
+/* Include framework files */
+#include "BaseCmp/CrFwBaseCmp.h"
+
+/** A start-up task. */
+typedef struct {
+	/** The name of the task. */
+	const char* name;
+	/** The lane of the task (0 or 1). */
+	unsigned int lane;
+	/** The kind of the task. */
+	CrDaStartUpKind_t kind;
+	/** The component which is initialized and/or configured (NULL for an action). */
+	FwSmDesc_t cmp;
+	/** The action (NULL for a component). */
+	CrFwBool_t (*action)();
+} CrDaStartUpTask_t;
+
+/** The start-up tasks. */
+static CrDaStartUpTask_t startUpTask[CR_DA_STARTUP_MAX_N_OF_TASKS];
+
+/** The number of start-up tasks. */
+static unsigned int nOfStartUpTasks = 0;
+
+/** Whether a start-up task could not be added because there were too many tasks. */
+static CrFwBool_t isStartUpTaskLost = 0;
+
+/** The duration in microseconds of each start-up task. */
+static long taskUsec[CR_DA_STARTUP_MAX_N_OF_TASKS];
+
+/** The outcome of each start-up task (-1 if the task was not run). */
+static int taskOutcome[CR_DA_STARTUP_MAX_N_OF_TASKS];
+
+/** The duration in microseconds of the start-up. */
+static long startUpUsec = 0;
+
+/**
+ * Add a task to the start-up tasks.
+ * @param name the name of the task
+ * @param lane the lane of the task
+ * @param kind the kind of the task
+ * @param cmp the component (NULL for an action)
+ * @param action the action (NULL for a component)
+ */
+static void startUpAdd(const char* name, unsigned int lane, CrDaStartUpKind_t kind, FwSmDesc_t cmp,
+                       CrFwBool_t (*action)());
+
+/**
+ * Run the tasks of one lane of the start-up.
+ * @param lane the lane
+ */
+static void startUpRunLane(unsigned int lane);
+
+/**
+ * Run one start-up task.
+ * @param task the task
+ * @return 1 if the task was successful; 0 otherwise
+ */
+static CrFwBool_t startUpRunTask(const CrDaStartUpTask_t* task);
+
+#if (CR_DA_STARTUP_PARALLEL == 1)
+/**
+ * Body of the start-up thread: it runs the tasks of lane 1.
+ * @param arg unused
+ * @return always NULL
+ */
+static void* startUpThreadRun(void* arg);
+#endif
+
+/**
+ * Return the number of microseconds between two times.
+ * @param start the first time
+ * @param end the second time
+ * @return the number of microseconds between the two times
+ */
+static long startUpUsecBetween(const struct timespec* start, const struct timespec* end);
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaStartUpAddCmp(const char* name, unsigned int lane, CrDaStartUpKind_t kind, FwSmDesc_t cmp) {
+	startUpAdd(name, lane, kind, cmp, NULL);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaStartUpAddAction(const char* name, unsigned int lane, CrFwBool_t (*action)()) {
+	startUpAdd(name, lane, crDaStartUpAction, NULL, action);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaStartUpRun() {
+	struct timespec start, end;
+	unsigned int i;
+#if (CR_DA_STARTUP_PARALLEL == 1)
+	pthread_t startUpThread;
+	int err;
+#endif
+
+	if (isStartUpTaskLost) {
+		printf("CrDaStartUpRun: more than %d start-up tasks\n", CR_DA_STARTUP_MAX_N_OF_TASKS);
+		return 0;
+	}
+	for (i=0; i<nOfStartUpTasks; i++) {
+		taskUsec[i] = 0;
+		taskOutcome[i] = -1;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+#if (CR_DA_STARTUP_PARALLEL == 1)
+	err = pthread_create(&startUpThread, NULL, &startUpThreadRun, NULL);
+	if (err != 0) {
+		errno = err;
+		perror("CrDaStartUpRun, thread creation");
+		startUpRunLane(0);
+		startUpRunLane(1);
+	} else {
+		startUpRunLane(0);
+		pthread_join(startUpThread, NULL);
+	}
+#else
+	startUpRunLane(0);
+	startUpRunLane(1);
+#endif
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	startUpUsec = startUpUsecBetween(&start, &end);
+
+	for (i=0; i<nOfStartUpTasks; i++)
+		if (taskOutcome[i] != 1)
+			return 0;
+	return 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaStartUpReport(const char* app) {
+#if (CR_DA_STARTUP_PARALLEL == 1)
+	unsigned int i;
+	long laneUsec[2] = {0, 0};
+
+	for (i=0; i<nOfStartUpTasks; i++) {
+		laneUsec[startUpTask[i].lane] += taskUsec[i];
+		printf("%s: Start-up: lane %u, %-24s %8.3f ms%s\n", app, startUpTask[i].lane, startUpTask[i].name,
+		       taskUsec[i]/1000.0, (taskOutcome[i] == 1 ? "" : (taskOutcome[i] == 0 ? " (failed)" : " (not run)")));
+	}
+	printf("%s: Start-up: %.3f ms (lane 0: %.3f ms, lane 1: %.3f ms)\n", app, startUpUsec/1000.0,
+	       laneUsec[0]/1000.0, laneUsec[1]/1000.0);
+#else
+	(void)app;
+#endif
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void startUpAdd(const char* name, unsigned int lane, CrDaStartUpKind_t kind, FwSmDesc_t cmp,
+                       CrFwBool_t (*action)()) {
+	if (nOfStartUpTasks == CR_DA_STARTUP_MAX_N_OF_TASKS) {
+		isStartUpTaskLost = 1;
+		return;
+	}
+	startUpTask[nOfStartUpTasks].name = name;
+	startUpTask[nOfStartUpTasks].lane = (lane == 0 ? 0 : 1);
+	startUpTask[nOfStartUpTasks].kind = kind;
+	startUpTask[nOfStartUpTasks].cmp = cmp;
+	startUpTask[nOfStartUpTasks].action = action;
+	nOfStartUpTasks++;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void startUpRunLane(unsigned int lane) {
+	struct timespec start, end;
+	unsigned int i;
+
+	for (i=0; i<nOfStartUpTasks; i++) {
+		if (startUpTask[i].lane != lane)
+			continue;
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		taskOutcome[i] = startUpRunTask(&startUpTask[i]);
+		clock_gettime(CLOCK_MONOTONIC, &end);
+		taskUsec[i] = startUpUsecBetween(&start, &end);
+		if (taskOutcome[i] != 1)
+			return;	/* the later tasks of the lane may depend on this one */
+	}
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static CrFwBool_t startUpRunTask(const CrDaStartUpTask_t* task) {
+	switch (task->kind) {
+	case crDaStartUpInit:
+		CrFwCmpInit(task->cmp);
+		return CrFwCmpIsInInitialized(task->cmp);
+	case crDaStartUpReset:
+		CrFwCmpReset(task->cmp);
+		return CrFwCmpIsInConfigured(task->cmp);
+	case crDaStartUpInitReset:
+		CrFwCmpInit(task->cmp);
+		if (!CrFwCmpIsInInitialized(task->cmp))
+			return 0;
+		CrFwCmpReset(task->cmp);
+		return CrFwCmpIsInConfigured(task->cmp);
+	default:	/* crDaStartUpAction */
+		return task->action();
+	}
+}
+
+#if (CR_DA_STARTUP_PARALLEL == 1)
+/* ---------------------------------------------------------------------------------------------*/
+static void* startUpThreadRun(void* arg) {
+	(void)arg;
+	CrDaThreadPlace(crDaThreadAux);
+	startUpRunLane(1);
+	return NULL;
+}
+#endif
+
+/* ---------------------------------------------------------------------------------------------*/
+static long startUpUsecBetween(const struct timespec* start, const struct timespec* end) {
+	return (end->tv_sec - start->tv_sec)*1000000L + (end->tv_nsec - start->tv_nsec)/1000;
+}
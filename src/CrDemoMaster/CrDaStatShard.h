@@ -0,0 +1,61 @@
+/**
+ * @file
+ * @ingroup crDemoMaster
+ * Interface for the shards of the statistics counters of the demo applications of the
+ * CORDET Demo.
+ * A statistics counter which is updated by several threads (e.g. the thread of the
+ * control cycles, the I/O thread and the threads of the manager pool) is a cache line
+ * which bounces between their cores at every update, even when the updates are atomic.
+ *
+ * A counter which is updated by several threads is therefore kept in
+ * <code>#CR_DA_STAT_N_OF_SHARDS</code> <i>shards</i>: each shard is a structure of counters
+ * which is aligned to a cache line (<code>#CR_DA_STAT_CACHE_LINE</code>) and each thread
+ * updates the counters of its own shard (<code>::CrDaStatShardId</code>).
+ * The reader of a counter sums the counters of all shards when it asks for it.
+ * A thread is given its shard the first time it updates a counter.
+ * If more threads than shards update the counters, the shards are given to the threads
+ * in turn and some threads share a shard.
+ * The counters of a shard are therefore still updated with (relaxed) atomic operations
+ * but, as long as each thread has its own shard, the cache line of a shard stays in the
+ * cache of its thread.
+ *
+ * The shards are used by the statistics of the packet pool (see
+ * <code>CrFwPcktStats.h</code>), the transport counters of the live metrics (see
+ * <code>CrDaMetrics.h</code>) and the counters of the packet header templates (see
+ * <code>CrDaPcktTemplate.h</code>).
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRDA_STATSHARD_H_
+#define CRDA_STATSHARD_H_
+
+/* Include Configuration Files */
+#include "CrDaConstants.h"
+
+/**
+ * Return the shard of the calling thread.
+ * The shard is given to the thread when it first calls this function.
+ * @return the index of the shard (smaller than <code>#CR_DA_STAT_N_OF_SHARDS</code>)
+ */
+unsigned int CrDaStatShardId();
+
+/**
+ * Return the number of threads which have been given a shard.
+ * If this number is greater than <code>#CR_DA_STAT_N_OF_SHARDS</code>, some threads share
+ * a shard.
+ * @return the number of threads
+ */
+unsigned int CrDaStatShardGetNOfThreads();
+
+#endif /* CRDA_STATSHARD_H_ */
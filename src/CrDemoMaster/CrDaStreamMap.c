@@ -0,0 +1,91 @@
+/**
+ * @file
+ * @ingroup crDemoMaster
+ * Implementation of the stream map of the demo applications.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include "CrDaStreamMap.h"
+/* Include Framework Files */
+#include "InStream/CrFwInStream.h"
+#include "OutStream/CrFwOutStream.h"
+/* Include Configuration Files */
+#include "CrFwInStreamUserPar.h"
+#include "CrFwOutStreamUserPar.h"
+
+/** The sources of the InStreams (the i-th InStream collects the packets of the i-th source). */
+static const CrFwDestSrc_t inStreamSrc[CR_FW_NOF_INSTREAM] = CR_FW_INSTREAM_SRC;
+
+/** The destinations of the OutStreams (the i-th OutStream sends the packets to the i-th destination). */
+static const CrFwDestSrc_t outStreamDest[CR_FW_NOF_OUTSTREAM] = CR_FW_OUTSTREAM_DEST;
+
+/** The InStreams in the order of the stream tables. */
+static FwSmDesc_t inStream[CR_FW_NOF_INSTREAM];
+
+/** The OutStreams in the order of the stream tables. */
+static FwSmDesc_t outStream[CR_FW_NOF_OUTSTREAM];
+
+/** One plus the index of the InStream of each application (zero if it has none). */
+static unsigned short inStreamOf[CR_DA_STREAM_MAP_N];
+
+/** One plus the index of the OutStream of each application (zero if it has none). */
+static unsigned short outStreamOf[CR_DA_STREAM_MAP_N];
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaStreamMapInit() {
+	CrFwCounterU1_t i;
+
+	for (i=0; i<CR_FW_NOF_INSTREAM; i++) {
+		inStream[i] = CrFwInStreamMake(i);
+		if (inStreamSrc[i] < CR_DA_STREAM_MAP_N)
+			inStreamOf[inStreamSrc[i]] = (unsigned short)(i+1);
+	}
+	for (i=0; i<CR_FW_NOF_OUTSTREAM; i++) {
+		outStream[i] = CrFwOutStreamMake(i);
+		if (outStreamDest[i] < CR_DA_STREAM_MAP_N)
+			outStreamOf[outStreamDest[i]] = (unsigned short)(i+1);
+	}
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+FwSmDesc_t CrDaStreamMapGetInStream(CrFwDestSrc_t src) {
+	int i = CrDaStreamMapGetInStreamIndex(src);
+
+	if (i < 0)
+		return CrFwInStreamGet(src);
+	return inStream[i];
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+FwSmDesc_t CrDaStreamMapGetOutStream(CrFwDestSrc_t dest) {
+	int i = CrDaStreamMapGetOutStreamIndex(dest);
+
+	if (i < 0)
+		return CrFwOutStreamGet(dest);
+	return outStream[i];
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+int CrDaStreamMapGetInStreamIndex(CrFwDestSrc_t src) {
+	if (src >= CR_DA_STREAM_MAP_N)
+		return -1;
+	return (int)inStreamOf[src] - 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+int CrDaStreamMapGetOutStreamIndex(CrFwDestSrc_t dest) {
+	if (dest >= CR_DA_STREAM_MAP_N)
+		return -1;
+	return (int)outStreamOf[dest] - 1;
+}
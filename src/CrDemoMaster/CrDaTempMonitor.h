@@ -14,6 +14,27 @@
  * commands in <code>CrFwInFactoryUserPar.h</code>).
  * They are therefore defined to comply with the <code>::CrFwInCmdProgressAction_t</code> prototype.
  *
+ * The state of the monitoring is held in a table of <code>#CR_DA_TEMP_N_OF_CHANNELS</code>
+ * channels which is laid out as a structure of arrays: the limits, the release
+ * temperatures (the limits minus the hysteresis bands), the hysteresis bands, the enable
+ * bits, the violation bits and the violation counters of the channels are each held in
+ * their own array, so that the limit checker streams through the arrays which it needs
+ * (the enable and violation bits hold one bit per channel in words of 32 channels).
+ * The commands of the Master Application target one channel by its index or all channels
+ * (<code>#CR_DA_TEMP_ALL_CHANNELS</code>).
+ * The bulk commands target a range of channels: the Bulk Set Temperature Limit command
+ * carries one limit per channel and the Bulk Enable and Bulk Disable Temperature
+ * Monitoring commands carry either no mask (the whole range is enabled or disabled) or a
+ * mask of one bit per channel which is applied to the enable bits 32 channels at a time.
+ *
+ * A channel enters its violation when its temperature exceeds its limit and it stays in
+ * violation until its temperature drops to its release temperature.
+ * Only the samples which exceed the limit are reported, but the reports are re-armed when
+ * a violation ends: with a suppression policy (see <code>#CR_DA_TEMP_SUPPRESS</code>), a
+ * temperature which oscillates around the limit within the hysteresis band therefore
+ * does not cause a storm of reports.
+ * The violation counter of a channel counts the violations which the channel has entered.
+ *
  * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
  * @author Alessandro Pasetti <pasetti@pnp-software.com>
  * @copyright P&P Software GmbH, 2013, All Rights Reserved
@@ -30,10 +51,12 @@
 #ifndef CRDA_TEMPMONITORING_H_
 #define CRDA_TEMPMONITORING_H_
 
+#include <stdint.h>
 /* Include Framework Files */
 #include "CrFwConstants.h"
 /* Include Configuration Files */
 #include "CrFwUserConstants.h"
+#include "CrDaInCmdBatch.h"
 /* Include FW Profile files */
 #include "FwSmConstants.h"
 #include "FwSmConfig.h"
@@ -42,8 +65,18 @@
 #include "FwPrCore.h"
 #include "FwPrConstants.h"
 
+/** The configuration of the channel table (it is the part of the table which is kept in a snapshot). */
+typedef struct {
+	/** The limits of the channels. */
+	char limit[CR_DA_TEMP_N_OF_CHANNELS];
+	/** The hysteresis bands of the channels. */
+	char hyst[CR_DA_TEMP_N_OF_CHANNELS];
+	/** The enable bits of the channels (bit <code>i%32</code> of word <code>i/32</code> for channel i). */
+	uint32_t isEnabled[CR_DA_TEMP_N_OF_CHANNELS/32];
+} CrDaTempChanConfig_t;
+
 /**
- * Enable temperature monitoring.
+ * Enable temperature monitoring on the channel (or all channels) of the InCommand.
  * This function is intended to be used as progress action for the
  * InCommand which enables temperature monitoring.
  * @param smDesc the InCommand state machine descriptor (this argument is
@@ -52,7 +85,7 @@
 void CrDaTempMonitoringEnable(FwSmDesc_t smDesc);
 
 /**
- * Disable temperature monitoring.
+ * Disable temperature monitoring on the channel (or all channels) of the InCommand.
  * This function is intended to be used as progress action for the
  * InCommand which disables temperature monitoring.
  * @param smDesc the InCommand state machine descriptor (this argument is
@@ -61,7 +94,7 @@ void CrDaTempMonitoringEnable(FwSmDesc_t smDesc);
 void CrDaTempMonitoringDisable(FwSmDesc_t smDesc);
 
 /**
- * Set the limit against the temperature is monitored.
+ * Set the limit and the hysteresis band of the channel (or all channels) of the InCommand.
  * This function is intended to be used as progress action for the
  * InCommand which set the temperature monitoring limit.
  * @param smDesc the InCommand state machine descriptor (this argument is
@@ -70,17 +103,195 @@ void CrDaTempMonitoringDisable(FwSmDesc_t smDesc);
 void CrDaTempMonitoringSetTempLimit(FwSmDesc_t smDesc);
 
 /**
- * Execute a temperature monitoring action on the argument temperature.
- * If temperature monitoring is disabled, this function returns without doing anything.
+ * Validity check of the Bulk Set Temperature Limit command.
+ * The command is valid if its range of channels is in the channel table, if it sets at
+ * most <code>#CR_DA_TEMP_BULK_MAX_N</code> limits and if its packet holds all the limits.
+ * @param prDesc the descriptor of the InCommand Validity Procedure
+ * @return 1 if the command is valid; 0 otherwise
+ */
+CrFwBool_t CrDaTempMonitoringSetTempLimitsValidityCheck(FwPrDesc_t prDesc);
+
+/**
+ * Set the limits of the range of channels of the Bulk Set Temperature Limit command.
+ * The limits are copied into the channel table in one block, the hysteresis bands of the
+ * channels are kept and their release temperatures are recomputed.
+ * This function is intended to be used as progress action for the Bulk Set Temperature
+ * Limit command.
+ * @param smDesc the InCommand state machine descriptor (this argument is
+ * required for compatibility with the <code>::CrFwInCmdProgressAction_t</code> prototype)
+ */
+void CrDaTempMonitoringSetTempLimits(FwSmDesc_t smDesc);
+
+/**
+ * Validity check of the Bulk Enable and Bulk Disable Temperature Monitoring commands.
+ * The command is valid if its range of channels is not empty and is in the channel table
+ * and if its packet holds the mask of the range (if the command carries a mask).
+ * @param prDesc the descriptor of the InCommand Validity Procedure
+ * @return 1 if the command is valid; 0 otherwise
+ */
+CrFwBool_t CrDaTempMonitoringSetEnabledMaskValidityCheck(FwPrDesc_t prDesc);
+
+/**
+ * Enable temperature monitoring on the channels of the range (or of the mask) of the Bulk
+ * Enable Temperature Monitoring command.
+ * The enable bits are set one word of 32 channels at a time.
+ * This function is intended to be used as progress action for the Bulk Enable
+ * Temperature Monitoring command.
+ * @param smDesc the InCommand state machine descriptor (this argument is
+ * required for compatibility with the <code>::CrFwInCmdProgressAction_t</code> prototype)
+ */
+void CrDaTempMonitoringEnableMask(FwSmDesc_t smDesc);
+
+/**
+ * Disable temperature monitoring on the channels of the range (or of the mask) of the Bulk
+ * Disable Temperature Monitoring command.
+ * The enable and violation bits are cleared one word of 32 channels at a time.
+ * This function is intended to be used as progress action for the Bulk Disable
+ * Temperature Monitoring command.
+ * @param smDesc the InCommand state machine descriptor (this argument is
+ * required for compatibility with the <code>::CrFwInCmdProgressAction_t</code> prototype)
+ */
+void CrDaTempMonitoringDisableMask(FwSmDesc_t smDesc);
+
+/**
+ * Batch handler of the InCommands which enable temperature monitoring (see
+ * <code>CrDaInCmdBatch.h</code>).
+ * The channels of the InCommands of the batch are enabled in the order of the InCommands.
+ * @param entry the entries of the InCommands of the batch
+ * @param n the number of InCommands of the batch
+ */
+void CrDaTempMonitoringEnableBatch(const CrDaInCmdBatchEntry_t* entry, unsigned int n);
+
+/**
+ * Batch handler of the InCommands which disable temperature monitoring (see
+ * <code>CrDaInCmdBatch.h</code>).
+ * The channels of the InCommands of the batch are disabled in the order of the InCommands.
+ * @param entry the entries of the InCommands of the batch
+ * @param n the number of InCommands of the batch
+ */
+void CrDaTempMonitoringDisableBatch(const CrDaInCmdBatchEntry_t* entry, unsigned int n);
+
+/**
+ * Batch handler of the InCommands which set the temperature monitoring limit (see
+ * <code>CrDaInCmdBatch.h</code>).
+ * The limits are set in the order of the InCommands: the last InCommand which targets a
+ * channel takes effect.
+ * @param entry the entries of the InCommands of the batch
+ * @param n the number of InCommands of the batch
+ */
+void CrDaTempMonitoringSetTempLimitBatch(const CrDaInCmdBatchEntry_t* entry, unsigned int n);
+
+/**
+ * Enable temperature monitoring on all channels with the argument temperature limit and
+ * the default hysteresis band <code>#CR_DA_TEMP_HYSTERESIS</code>.
+ * This function is used by the synthetic temperature source (see <code>CrDaTempGen.h</code>)
+ * so that temperature monitoring can be exercised without the commands of the Master
+ * Application.
+ * @param limit the temperature limit
+ */
+void CrDaTempMonitoringSetUp(char limit);
+
+/**
+ * Get the configuration of the channel table.
+ * This function is used by the snapshot of the application state (see
+ * <code>CrDaSnapshot.h</code>).
+ * @param config the location where the configuration is returned
+ */
+void CrDaTempMonitoringGetState(CrDaTempChanConfig_t* config);
+
+/**
+ * Set the configuration of the channel table.
+ * This function is used to restore the snapshot of the application state (see
+ * <code>CrDaSnapshot.h</code>).
+ * The channels are not in violation after the configuration has been set.
+ * @param config the configuration
+ */
+void CrDaTempMonitoringSetState(const CrDaTempChanConfig_t* config);
+
+/**
+ * Return the number of violations which a channel has entered.
+ * @param chan the channel
+ * @return the number of violations of the channel (zero if there is no such channel)
+ */
+unsigned int CrDaTempMonitoringGetNOfViolations(unsigned short chan);
+
+/**
+ * Execute a temperature monitoring action on the argument temperature of a channel.
+ * If temperature monitoring is disabled on the channel (or if there is no such channel),
+ * this function returns without doing anything.
  * If temperature monitoring is enabled, this function compares the argument temperature with
- * its temperature limit and if it finds that the argument temperature exceeds its limit,
+ * the limit of the channel and if it finds that the argument temperature exceeds its limit,
  * it generates a "temperature limit violated" report to the Master Application.
+ * The reports of a channel whose violation persists may be suppressed according to the
+ * suppression policy <code>#CR_DA_TEMP_SUPPRESS</code>: the number of reports which a
+ * channel has suppressed is then carried by its next report.
+ * If the coalescing of the temperature violations is selected (see
+ * <code>#CR_DA_TEMP_BATCH</code>), the violation is instead added to the pending batch
+ * report (see <code>CrDaOutCmpTempBatch.h</code>).
+ * If the windowed statistics are selected (see <code>#CR_DA_TEMP_STATS</code>), no
+ * violation is reported: the temperature is instead added to the statistics of the
+ * channel (see <code>CrDaOutCmpTempStats.h</code>).
  *
  * This function would normally be called periodically by the host application.
  * @param temp the temperature to be monitored (an integer in the range 0 to 127)
+ * @param chan the channel of the temperature
  * @param appId the identifier of the application which is performing the monitoring
  * (either Slave 1 or Slave 2)
+ * @return 0 if the temperature exceeds its limit but the report could not be made because
+ * the OutFactory or the packet pool is exhausted (or the batch was full and its report could
+ * not be made); 1 otherwise
+ */
+CrFwBool_t CrDaTempMonitoringExec(char temp, unsigned short chan, CrFwDestSrc_t appId);
+
+/**
+ * Compare the samples of a set of channels with the limits of the channels.
+ * Bit <code>i%32</code> of word <code>i/32</code> of the violation mask is set if sample
+ * <code>i</code> exceeds limit <code>i</code>; the bits of the last word beyond the last
+ * channel are cleared.
+ * The comparison is done by a vectorized kernel which is selected when the application is
+ * compiled: AVX2 (32 channels per comparison, with <code>-mavx2</code>), SSE2 (16 channels
+ * per comparison, the default on x86-64) or NEON (16 channels per comparison, on AArch64).
+ * On the other targets, and for the channels beyond the last multiple of 16, a scalar loop
+ * is used.
+ * The samples and the limits must be in the range 0 to 127.
+ * @param temp the samples of the channels
+ * @param limit the limits of the channels
+ * @param n the number of channels
+ * @param viol the violation mask (it must hold <code>(n+31)/32</code> words)
+ * @return the number of channels whose sample exceeds the limit
+ */
+unsigned int CrDaTempMonitoringCheck(const char* temp, const char* limit, unsigned int n, uint32_t* viol);
+
+/**
+ * Execute a temperature monitoring action on the samples of the first channels of the
+ * channel table.
+ * The samples are compared with the limits and with the release temperatures of their
+ * channels by <code>::CrDaTempMonitoringCheck</code>, 32 channels at a time, and the
+ * violation bits of the channels are updated with the enable bits.
+ * A report is then made for each enabled channel whose sample exceeds its limit, in the
+ * order of the channels.
+ * The reports are made, suppressed or coalesced as those of
+ * <code>::CrDaTempMonitoringExec</code> and, if the windowed statistics are selected,
+ * the samples of all enabled channels are instead added to their statistics.
+ * If no suppression policy is selected, the channels which do not exceed their limit
+ * cost no more than their comparisons in the kernel; otherwise the suppression state of
+ * every enabled channel is updated with its sample.
+ * @param temp the samples of the channels (sample i is the sample of channel i)
+ * @param n the number of channels (the channels beyond <code>#CR_DA_TEMP_N_OF_CHANNELS</code>
+ * are ignored)
+ * @param appId the identifier of the application which is performing the monitoring
+ * @return the number of violations whose report could not be made (see
+ * <code>::CrDaTempMonitoringExec</code>)
+ */
+unsigned int CrDaTempMonitoringExecMulti(const char* temp, unsigned int n, CrFwDestSrc_t appId);
+
+/**
+ * Print the number of enabled channels, the number of channels in violation, the number
+ * of violations and the number of reports which the temperature monitoring has suppressed
+ * (if a suppression policy is selected, see <code>#CR_DA_TEMP_SUPPRESS</code>).
+ * Nothing is printed if no channel has entered a violation.
+ * @param app the name of the application (e.g. "S1")
  */
-void CrDaTempMonitoringExec(char temp, CrFwDestSrc_t appId);
+void CrDaTempMonitoringReport(const char* app);
 
 #endif /* CRDA_TEMPMONITORING_H_ */
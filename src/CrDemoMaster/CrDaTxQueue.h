@@ -0,0 +1,173 @@
+/**
+ * @file
+ * @ingroup crDemoMaster
+ * Transmit queue for the socket connections of the CORDET Demo.
+ * The transmit queue allows the packets which are handed over to a socket connection
+ * to be written to the socket in batches:
+ * - Function <code>::CrDaTxQueueAdd</code> adds a packet to the transmit queue.
+ *   The packet is retained (see <code>CrFwPcktRefCnt.h</code>) and is therefore not
+ *   copied: the caller may release it as soon as the function returns.
+ * - Function <code>::CrDaTxQueueFlush</code> writes all queued packets to the socket
+ *   with a single <code>sendmsg</code> system call and releases the packets which
+ *   have been completely written.
+ * .
+ * If the socket does not accept all queued bytes, the bytes which have not been
+ * written remain in the transmit queue and are written by the next flush.
+ * Hence, the number of system calls grows with the number of flushes and not with
+ * the number of packets.
+ *
+ * The capacity of a transmit queue is <code>#CR_DA_TX_QUEUE_NOF_PCKTS</code> packets.
+ * The number of queued bytes is tracked so that the socket adapters can flush a transmit
+ * queue when it holds enough bytes to fill a write (see <code>#CR_DA_TX_QUEUE_FLUSH_BYTES</code>).
+ *
+ * If the integrity check is selected (see <code>#CR_DA_PCKT_CRC</code>), the trailer of a
+ * packet is computed when the packet is added and it is written after the packet.
+ * The queued bytes and the bytes which are reported as written then include the trailers.
+ * If the capability handshake is selected (see <code>CrDaHandshake.h</code>), the trailers
+ * are only written on the connections whose peer supports them
+ * (<code>::CrDaTxQueueSetTrailer</code>).
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRDA_TXQUEUE_H_
+#define CRDA_TXQUEUE_H_
+
+#include <sys/uio.h>
+/* Include Framework Files */
+#include "CrFwConstants.h"
+/* Include Configuration Files */
+#include "CrFwUserConstants.h"
+#include "CrDaConstants.h"
+
+/**
+ * The maximum number of elements of the I/O vector of a transmit queue (one for each
+ * packet and, if the integrity check is selected, one for each trailer).
+ */
+#if (CR_DA_PCKT_CRC == 1)
+#define CR_DA_TX_QUEUE_NOF_IOV (2*CR_DA_TX_QUEUE_NOF_PCKTS)
+#else
+#define CR_DA_TX_QUEUE_NOF_IOV CR_DA_TX_QUEUE_NOF_PCKTS
+#endif
+
+/** Type for the transmit queue of a socket connection. */
+typedef struct {
+	/** The queued packets. */
+	CrFwPckt_t pckt[CR_DA_TX_QUEUE_NOF_PCKTS];
+	/** The trailers of the queued packets (only used if the integrity check is selected). */
+	unsigned char crc[CR_DA_TX_QUEUE_NOF_PCKTS][4];
+	/** The index of the first packet in the transmit queue. */
+	unsigned int head;
+	/** The number of packets in the transmit queue. */
+	unsigned int count;
+	/** The number of bytes of the first packet (and of its trailer) which have already been written. */
+	unsigned int offset;
+	/** The number of queued bytes which have not yet been written. */
+	unsigned int nOfBytes;
+	/** The length of the trailer which is written after each packet (0 if no trailer is written). */
+	unsigned int trailerLength;
+} CrDaTxQueue_t;
+
+/**
+ * Initialize a transmit queue as empty.
+ * The trailers are written if the integrity check is selected.
+ * @param queue the transmit queue
+ */
+void CrDaTxQueueInit(CrDaTxQueue_t* queue);
+
+/**
+ * Select whether the trailers of the integrity check are written by a transmit queue.
+ * This is used by the capability handshake (see <code>CrDaHandshake.h</code>) when the
+ * features of a connection have been agreed.
+ * The trailers of the queued packets which were added without a trailer are computed.
+ * This function must not be called while the first packet of the transmit queue has been
+ * partially written (see <code>::CrDaTxQueueRewind</code>).
+ * Nothing is done if the integrity check is not selected.
+ * @param queue the transmit queue
+ * @param isCrc 1 if the trailers are written; 0 otherwise
+ */
+void CrDaTxQueueSetTrailer(CrDaTxQueue_t* queue, CrFwBool_t isCrc);
+
+/**
+ * Release all packets in a transmit queue and empty the transmit queue.
+ * The packets are discarded without being written.
+ * @param queue the transmit queue
+ */
+void CrDaTxQueueClear(CrDaTxQueue_t* queue);
+
+/**
+ * Add a packet to a transmit queue.
+ * The packet is retained by the transmit queue until it has been written.
+ * @param queue the transmit queue
+ * @param pckt the packet
+ * @return 1 if the packet was added; 0 if the transmit queue is full
+ */
+CrFwBool_t CrDaTxQueueAdd(CrDaTxQueue_t* queue, CrFwPckt_t pckt);
+
+/**
+ * Write the packets in a transmit queue to a socket.
+ * The packets are written with a non-blocking <code>sendmsg</code> system call.
+ * The packets which have been completely written are released and removed from the
+ * transmit queue.
+ * If the transmit queue is empty, no system call is made.
+ * @param queue the transmit queue
+ * @param fd the file descriptor of the socket
+ * @return the number of bytes written; 0 if the transmit queue is empty; -1 if the
+ * write failed (the reason is given by <code>errno</code>)
+ */
+int CrDaTxQueueFlush(CrDaTxQueue_t* queue, int fd);
+
+/**
+ * Gather the packets in a transmit queue into an I/O vector.
+ * The I/O vector describes the bytes which have not yet been written.
+ * This is used when the write operation is performed asynchronously
+ * (e.g. by the io_uring backend of the server socket): the packets remain in the
+ * transmit queue until <code>::CrDaTxQueueConsume</code> reports them as written.
+ * @param queue the transmit queue
+ * @param iov the I/O vector (it must have room for <code>#CR_DA_TX_QUEUE_NOF_IOV</code>
+ * elements)
+ * @return the number of elements of the I/O vector
+ */
+unsigned int CrDaTxQueueGetIov(CrDaTxQueue_t* queue, struct iovec* iov);
+
+/**
+ * Remove the bytes which have been written from a transmit queue.
+ * The packets which have been completely written are released.
+ * @param queue the transmit queue
+ * @param n the number of bytes which have been written
+ */
+void CrDaTxQueueConsume(CrDaTxQueue_t* queue, unsigned int n);
+
+/**
+ * Rewind a transmit queue so that its first packet is written again from its start.
+ * This is used when the connection on which the first packet was being written has
+ * been closed and the packets are to be written on a new connection.
+ * @param queue the transmit queue
+ */
+void CrDaTxQueueRewind(CrDaTxQueue_t* queue);
+
+/**
+ * Return the number of queued bytes of a transmit queue which have not yet been written.
+ * @param queue the transmit queue
+ * @return the number of bytes
+ */
+unsigned int CrDaTxQueueGetNOfBytes(CrDaTxQueue_t* queue);
+
+/**
+ * Check whether a transmit queue is empty.
+ * @param queue the transmit queue
+ * @return 1 if the transmit queue is empty; 0 otherwise
+ */
+CrFwBool_t CrDaTxQueueIsEmpty(CrDaTxQueue_t* queue);
+
+#endif /* CRDA_TXQUEUE_H_ */
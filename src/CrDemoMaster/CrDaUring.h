@@ -0,0 +1,219 @@
+/**
+ * @file
+ * @ingroup crDemoMaster
+ * Minimal interface to an io_uring instance for the socket adapters of the CORDET Demo.
+ * An io_uring instance consists of a submission queue and a completion queue which
+ * are shared between the application and the kernel.
+ * The application places operations in the submission queue and hands them over to
+ * the kernel with one system call (<code>::CrDaUringEnter</code>); the kernel places the
+ * results of the operations in the completion queue where the application reads them
+ * without any system call (<code>::CrDaUringPeekCqe</code>).
+ * The same system call can also wait until a completion arrives.
+ *
+ * The following operations on sockets are supported:
+ * - Multishot accept (<code>::CrDaUringPrepAccept</code>): one operation produces one
+ *   completion for each accepted connection.
+ * - Multishot receive (<code>::CrDaUringPrepRecv</code>): one operation produces one
+ *   completion for each chunk of data received on a connection.
+ *   The data are stored in a buffer which the kernel takes from a ring of provided
+ *   buffers: the identifier of the buffer is given in the flags of the completion
+ *   (see <code>::CrDaUringGetBuf</code>) and the buffer must be given back with
+ *   <code>::CrDaUringPutBuf</code> when its data have been consumed.
+ * - Gather send (<code>::CrDaUringPrepSendmsg</code>): the message header and the
+ *   data it describes must remain valid until the completion of the operation.
+ * - Cancellation of all operations on a file descriptor (<code>::CrDaUringPrepCancel</code>).
+ * .
+ * A multishot operation remains armed as long as its completions carry the flag
+ * <code>IORING_CQE_F_MORE</code>.
+ * A multishot receive terminates when no provided buffer is available and must then
+ * be armed again after buffers have been given back.
+ *
+ * This module uses the system calls of io_uring directly and does not need any library
+ * other than the C library.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRDA_URING_H_
+#define CRDA_URING_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/socket.h>
+#include <linux/io_uring.h>
+/* Include Framework Files */
+#include "CrFwConstants.h"
+/* Include Configuration Files */
+#include "CrFwUserConstants.h"
+
+/** Type for an io_uring instance with its ring of provided buffers. */
+typedef struct {
+	/** The file descriptor of the io_uring instance or -1 if the instance is not open. */
+	int fd;
+	/** The head index of the submission queue (written by the kernel). */
+	unsigned int* sqHead;
+	/** The tail index of the submission queue (written by the application). */
+	unsigned int* sqTail;
+	/** The flags of the submission queue (written by the kernel). */
+	unsigned int* sqFlags;
+	/** The mask which maps an index of the submission queue to an entry. */
+	unsigned int sqMask;
+	/** The entries of the submission queue. */
+	struct io_uring_sqe* sqes;
+	/** The head index of the completion queue (written by the application). */
+	unsigned int* cqHead;
+	/** The tail index of the completion queue (written by the kernel). */
+	unsigned int* cqTail;
+	/** The mask which maps an index of the completion queue to an entry. */
+	unsigned int cqMask;
+	/** The entries of the completion queue. */
+	struct io_uring_cqe* cqes;
+	/** The mapping of the submission queue ring. */
+	void* sqRing;
+	/** The size of the mapping of the submission queue ring. */
+	size_t sqRingSize;
+	/** The mapping of the completion queue ring (may be the same as the submission queue ring). */
+	void* cqRing;
+	/** The size of the mapping of the completion queue ring. */
+	size_t cqRingSize;
+	/** The size of the mapping of the submission queue entries. */
+	size_t sqesSize;
+	/** The ring of provided buffers (shared with the kernel). */
+	struct io_uring_buf_ring* bufRing;
+	/** The size of the mapping of the ring of provided buffers. */
+	size_t bufRingSize;
+	/** The storage area of the provided buffers. */
+	unsigned char* bufs;
+	/** The number of provided buffers. */
+	unsigned int nOfBufs;
+	/** The size in bytes of each provided buffer. */
+	unsigned int bufSize;
+	/** The tail index of the ring of provided buffers. */
+	unsigned short bufTail;
+} CrDaUring_t;
+
+/**
+ * Create an io_uring instance and register its ring of provided buffers.
+ * All provided buffers are initially given to the kernel.
+ * @param ring the io_uring instance
+ * @param nOfEntries the number of entries of the submission queue
+ * @param nOfBufs the number of provided buffers (must be a power of two)
+ * @param bufSize the size in bytes of each provided buffer
+ * @return 1 if the io_uring instance was created; 0 otherwise (the reason is given
+ * by <code>errno</code> and the io_uring instance is left closed)
+ */
+CrFwBool_t CrDaUringInit(CrDaUring_t* ring, unsigned int nOfEntries, unsigned int nOfBufs,
+                         unsigned int bufSize);
+
+/**
+ * Close an io_uring instance and release its resources.
+ * The operations which are still pending are cancelled by the kernel.
+ * @param ring the io_uring instance
+ */
+void CrDaUringFree(CrDaUring_t* ring);
+
+/**
+ * Place a multishot accept operation on a listening socket in the submission queue.
+ * The result of each completion is the file descriptor of an accepted connection.
+ * @param ring the io_uring instance
+ * @param fd the file descriptor of the listening socket
+ * @param userData the value which identifies the completions of the operation
+ * @return 1 if the operation was placed in the submission queue; 0 if the submission
+ * queue is full
+ */
+CrFwBool_t CrDaUringPrepAccept(CrDaUring_t* ring, int fd, uint64_t userData);
+
+/**
+ * Place a multishot receive operation on a connection in the submission queue.
+ * The result of each completion is the number of bytes received into the provided
+ * buffer identified by the flags of the completion, 0 if the peer has closed the
+ * connection, or a negative error code.
+ * @param ring the io_uring instance
+ * @param fd the file descriptor of the connection
+ * @param userData the value which identifies the completions of the operation
+ * @return 1 if the operation was placed in the submission queue; 0 if the submission
+ * queue is full
+ */
+CrFwBool_t CrDaUringPrepRecv(CrDaUring_t* ring, int fd, uint64_t userData);
+
+/**
+ * Place a gather send operation on a connection in the submission queue.
+ * The send does not raise <code>SIGPIPE</code> if the peer has closed the connection.
+ * The result of the completion is the number of bytes sent or a negative error code.
+ * @param ring the io_uring instance
+ * @param fd the file descriptor of the connection
+ * @param msg the message header (it must remain valid until the completion)
+ * @param userData the value which identifies the completion of the operation
+ * @return 1 if the operation was placed in the submission queue; 0 if the submission
+ * queue is full
+ */
+CrFwBool_t CrDaUringPrepSendmsg(CrDaUring_t* ring, int fd, struct msghdr* msg, uint64_t userData);
+
+/**
+ * Place an operation which cancels all pending operations on a file descriptor
+ * in the submission queue.
+ * The cancelled operations complete with result <code>-ECANCELED</code>.
+ * @param ring the io_uring instance
+ * @param fd the file descriptor
+ * @param userData the value which identifies the completion of the operation
+ * @return 1 if the operation was placed in the submission queue; 0 if the submission
+ * queue is full
+ */
+CrFwBool_t CrDaUringPrepCancel(CrDaUring_t* ring, int fd, uint64_t userData);
+
+/**
+ * Submit the operations in the submission queue and wait for completions.
+ * This function makes at most one system call.
+ * If the submission queue is empty and no wait is requested, no system call is made.
+ * The completions which are already in the completion queue count towards the
+ * number of completions to be waited for.
+ * @param ring the io_uring instance
+ * @param minComplete the number of completions to wait for
+ * @param timeout the maximum time in milliseconds to wait for the completions (zero to
+ * return immediately after the submission)
+ * @return the number of operations submitted or -1 if the system call failed
+ * (the reason is given by <code>errno</code>)
+ */
+int CrDaUringEnter(CrDaUring_t* ring, unsigned int minComplete, int timeout);
+
+/**
+ * Return the oldest completion in the completion queue.
+ * The completion remains in the completion queue until <code>::CrDaUringCqeSeen</code>
+ * is called.
+ * @param ring the io_uring instance
+ * @return the completion or NULL if the completion queue is empty
+ */
+struct io_uring_cqe* CrDaUringPeekCqe(CrDaUring_t* ring);
+
+/**
+ * Remove the oldest completion from the completion queue.
+ * @param ring the io_uring instance
+ */
+void CrDaUringCqeSeen(CrDaUring_t* ring);
+
+/**
+ * Return the storage area of a provided buffer.
+ * @param ring the io_uring instance
+ * @param bid the identifier of the buffer (as given by the flags of a completion)
+ * @return the storage area of the buffer
+ */
+unsigned char* CrDaUringGetBuf(CrDaUring_t* ring, unsigned int bid);
+
+/**
+ * Give a provided buffer back to the kernel.
+ * @param ring the io_uring instance
+ * @param bid the identifier of the buffer
+ */
+void CrDaUringPutBuf(CrDaUring_t* ring, unsigned int bid);
+
+#endif /* CRDA_URING_H_ */
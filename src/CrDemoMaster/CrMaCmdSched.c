@@ -0,0 +1,389 @@
+/**
+ * @file
+ * @ingroup crDemoMaster
+ * Implementation of the time-tagged command scheduler of the Master Application.
+ * The commands are kept in a static array of entries.
+ * The entries which are not in use form a free list.
+ * The entries of the commands which are due within the timing wheel are linked in the
+ * list of the slot of their release cycle in the order of their queue numbers; each slot
+ * also records its last entry so that a command which is queued after the commands of
+ * its slot is appended in constant time.
+ * The entries of the later commands are in a binary heap ordered by release cycle and,
+ * for the same release cycle, by queue number.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "CrMaCmdSched.h"
+#include "CrMaLatency.h"
+#include "CrMaOutCmpSetTempLimit.h"
+/* Include Common Demo Files */
+#include "CrDaConstants.h"
+#include "CrDaOutAdmit.h"
+#include "CrDaLog.h"
+/* Include FW Profile files */
+#include "FwSmConstants.h"
+/* Include framework files */
+#include "OutCmp/CrFwOutCmp.h"
+
+#if ((CR_MA_CMD_SCHED_N_OF_SLOTS & (CR_MA_CMD_SCHED_N_OF_SLOTS-1)) != 0)
+#error "CR_MA_CMD_SCHED_N_OF_SLOTS must be a power of two"
+#endif
+
+/** The index which terminates the lists of entries. */
+#define CR_MA_CMD_SCHED_NIL (-1)
+
+/** The maximum length of a line of a command timeline file. */
+#define CR_MA_CMD_SCHED_LINE_LENGTH 128
+
+/** Type for an entry of the command scheduler. */
+typedef struct {
+	/** The release cycle of the command. */
+	unsigned int cycle;
+	/** The period of the command in cycles (zero for a command which is released once). */
+	unsigned int period;
+	/** The queue number of the command (it orders the commands which are due in the same cycle). */
+	unsigned int seq;
+	/** The temperature limit of a command which sets the temperature limit. */
+	int tempLimit;
+	/** The sub-type of the command. */
+	CrFwServSubType_t subType;
+	/** The destination of the command. */
+	CrFwDestSrc_t dest;
+	/** The next entry in the free list or in the list of a slot. */
+	int next;
+} CrMaCmdSchedEntry_t;
+
+/** The argument of a command which is released through the admission control. */
+typedef struct {
+	/** The temperature limit of a command which sets the temperature limit. */
+	int tempLimit;
+	/** The sub-type of the command. */
+	CrFwServSubType_t subType;
+} CrMaCmdSchedArg_t;
+
+/** The entries of the command scheduler. */
+static CrMaCmdSchedEntry_t schedEntry[CR_MA_CMD_SCHED_N_OF_CMDS];
+
+/** The first free entry. */
+static int schedFree = CR_MA_CMD_SCHED_NIL;
+
+/** The first entry of each slot of the timing wheel. */
+static int schedHead[CR_MA_CMD_SCHED_N_OF_SLOTS];
+
+/** The last entry of each slot of the timing wheel. */
+static int schedTail[CR_MA_CMD_SCHED_N_OF_SLOTS];
+
+/** The binary heap of the entries which are due after the timing wheel. */
+static int schedHeap[CR_MA_CMD_SCHED_N_OF_CMDS];
+
+/** The number of entries in the heap. */
+static unsigned int schedHeapSize = 0;
+
+/** The last cycle whose commands have been released (the wheel holds the next cycles). */
+static unsigned int schedCycle = 0;
+
+/** Flag which is set when the lists of the scheduler have been initialized. */
+static CrFwBool_t schedReady = 0;
+
+/** The number of commands which have been queued. */
+static unsigned int nOfQueued = 0;
+
+/** The number of commands which could not be queued because the scheduler was full. */
+static unsigned int nOfRejected = 0;
+
+/** The number of commands which have been released. */
+static unsigned long nOfReleased = 0;
+
+/** The number of commands which were rejected by the admission control (see <code>CrDaOutAdmit.h</code>). */
+static unsigned long nOfFailed = 0;
+
+/** The number of pending entries. */
+static unsigned int nOfPending = 0;
+
+/** Initialize the free list and the slots of the timing wheel (once). */
+static void schedInit();
+
+/**
+ * Queue an entry in the slot of its release cycle or, if it is due after the timing
+ * wheel, in the heap.
+ * @param e the entry
+ */
+static void schedInsert(int e);
+
+/**
+ * Return true if an entry is due before another entry.
+ * @param a the first entry
+ * @param b the second entry
+ * @return 1 if entry <code>a</code> is due before entry <code>b</code>; 0 otherwise
+ */
+static CrFwBool_t schedBefore(int a, int b);
+
+/**
+ * Remove the first entry of the heap.
+ * @return the entry
+ */
+static int schedHeapPop();
+
+/**
+ * Make the OutComponent of a command and load it into the OutLoader (or defer it until an
+ * OutComponent is available, see <code>CrDaOutAdmit.h</code>).
+ * @param c the entry of the command
+ */
+static void schedRelease(const CrMaCmdSchedEntry_t* c);
+
+/**
+ * Issue Function of the commands (see <code>CrDaOutAdmit.h</code>): set the parameters and
+ * the destination of a command and load it.
+ * @param outCmd the command
+ * @param dest the destination of the command
+ * @param arg the parameters of the command (a <code>::CrMaCmdSchedArg_t</code>)
+ */
+static void schedIssue(FwSmDesc_t outCmd, CrFwDestSrc_t dest, const void* arg);
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrMaCmdSchedAdd(unsigned int cycle, unsigned int period, CrFwServSubType_t subType,
+                           CrFwDestSrc_t dest, int tempLimit) {
+	int e;
+
+	schedInit();
+	if (schedFree == CR_MA_CMD_SCHED_NIL) {
+		nOfRejected++;
+		return 0;
+	}
+	e = schedFree;
+	schedFree = schedEntry[e].next;
+
+	schedEntry[e].cycle = (cycle > schedCycle) ? cycle : schedCycle+1;
+	schedEntry[e].period = period;
+	schedEntry[e].seq = nOfQueued;
+	schedEntry[e].tempLimit = tempLimit;
+	schedEntry[e].subType = subType;
+	schedEntry[e].dest = dest;
+	schedInsert(e);
+	nOfQueued++;
+	nOfPending++;
+	return 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrMaCmdSchedLoadFile(const char* path) {
+	static const char* cmdName[3] = {"set", "enable", "disable"};
+	static const CrFwServSubType_t cmdSubType[3] = {CR_DA_SERV_SUBTYPE_SET, CR_DA_SERV_SUBTYPE_EN,
+	                                                 CR_DA_SERV_SUBTYPE_DIS};
+	char line[CR_MA_CMD_SCHED_LINE_LENGTH];
+	char cmd[CR_MA_CMD_SCHED_LINE_LENGTH];
+	unsigned int cycle, period, dest, lineNmb = 0;
+	int tempLimit, n, k;
+	FILE* f;
+
+	f = fopen(path, "r");
+	if (f == NULL) {
+		perror("CrMaCmdSchedLoadFile, fopen");
+		return 0;
+	}
+	while (fgets(line, sizeof(line), f) != NULL) {
+		lineNmb++;
+		if ((line[strspn(line, " \t\r\n")] == '\0') || (line[strspn(line, " \t")] == '#'))
+			continue;
+		tempLimit = TEMP_LIMIT;
+		n = sscanf(line, "%u %u %127s %u %d", &cycle, &period, cmd, &dest, &tempLimit);
+		for (k=0; (n >= 4) && (k < 3); k++)
+			if (strcmp(cmd, cmdName[k]) == 0)
+				break;
+		if ((n < 4) || (k == 3)) {
+			printf("CrMaCmdSchedLoadFile: %s, line %u: expected 'cycle period set|enable|disable dest [limit]'\n",
+			       path, lineNmb);
+			fclose(f);
+			return 0;
+		}
+		if (!CrMaCmdSchedAdd(cycle, period, cmdSubType[k], (CrFwDestSrc_t)dest, tempLimit)) {
+			printf("CrMaCmdSchedLoadFile: %s, line %u: more than %d commands\n", path, lineNmb,
+			       CR_MA_CMD_SCHED_N_OF_CMDS);
+			fclose(f);
+			return 0;
+		}
+	}
+	fclose(f);
+	printf("MA: Command timeline %s: %u commands queued\n", path, nOfQueued);
+	return 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrMaCmdSchedCycle(unsigned int cycle) {
+	unsigned int slot;
+	int e, next;
+
+	schedInit();
+	while (schedCycle < cycle) {
+		schedCycle++;
+		/* The commands which enter the timing wheel with this cycle */
+		while ((schedHeapSize > 0) && (schedEntry[schedHeap[0]].cycle < schedCycle+CR_MA_CMD_SCHED_N_OF_SLOTS))
+			schedInsert(schedHeapPop());
+
+		/* Release the commands of the slot of the cycle (the slot is then reused by a later cycle) */
+		slot = schedCycle & (CR_MA_CMD_SCHED_N_OF_SLOTS-1);
+		e = schedHead[slot];
+		schedHead[slot] = CR_MA_CMD_SCHED_NIL;
+		schedTail[slot] = CR_MA_CMD_SCHED_NIL;
+		while (e != CR_MA_CMD_SCHED_NIL) {
+			next = schedEntry[e].next;
+			schedRelease(&schedEntry[e]);
+			if (schedEntry[e].period > 0) {
+				schedEntry[e].cycle += schedEntry[e].period;
+				schedInsert(e);
+			} else {
+				schedEntry[e].next = schedFree;
+				schedFree = e;
+				nOfPending--;
+			}
+			e = next;
+		}
+	}
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+unsigned int CrMaCmdSchedGetNOfQueued() {
+	return nOfQueued;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+unsigned int CrMaCmdSchedGetNOfPending() {
+	return nOfPending;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrMaCmdSchedReport() {
+	if ((nOfQueued == 0) && (nOfRejected == 0))
+		return;
+	printf("MA: Command scheduler: %u commands queued, %lu released, %u pending, %u rejected (scheduler full), %lu not released (rejected by the OutLoader admission)\n",
+	       nOfQueued, nOfReleased, nOfPending, nOfRejected, nOfFailed);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void schedInit() {
+	int i;
+
+	if (schedReady)
+		return;
+	for (i=0; i<CR_MA_CMD_SCHED_N_OF_CMDS; i++)
+		schedEntry[i].next = ((i+1) < CR_MA_CMD_SCHED_N_OF_CMDS) ? (i+1) : CR_MA_CMD_SCHED_NIL;
+	schedFree = 0;
+	for (i=0; i<CR_MA_CMD_SCHED_N_OF_SLOTS; i++) {
+		schedHead[i] = CR_MA_CMD_SCHED_NIL;
+		schedTail[i] = CR_MA_CMD_SCHED_NIL;
+	}
+	schedReady = 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void schedInsert(int e) {
+	unsigned int slot, pos, parent;
+	int* link;
+
+	/* A command which is due after the timing wheel waits in the heap */
+	if (schedEntry[e].cycle >= schedCycle+1+CR_MA_CMD_SCHED_N_OF_SLOTS) {
+		pos = schedHeapSize++;
+		while (pos > 0) {
+			parent = (pos-1)/2;
+			if (!schedBefore(e, schedHeap[parent]))
+				break;
+			schedHeap[pos] = schedHeap[parent];
+			pos = parent;
+		}
+		schedHeap[pos] = e;
+		return;
+	}
+
+	/* The commands of a slot are kept in the order of their queue numbers */
+	slot = schedEntry[e].cycle & (CR_MA_CMD_SCHED_N_OF_SLOTS-1);
+	schedEntry[e].next = CR_MA_CMD_SCHED_NIL;
+	if ((schedTail[slot] == CR_MA_CMD_SCHED_NIL) || (schedEntry[schedTail[slot]].seq < schedEntry[e].seq)) {
+		if (schedTail[slot] == CR_MA_CMD_SCHED_NIL)
+			schedHead[slot] = e;
+		else
+			schedEntry[schedTail[slot]].next = e;
+		schedTail[slot] = e;
+		return;
+	}
+	link = &schedHead[slot];
+	while (schedEntry[*link].seq < schedEntry[e].seq)
+		link = &schedEntry[*link].next;
+	schedEntry[e].next = *link;
+	*link = e;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static CrFwBool_t schedBefore(int a, int b) {
+	if (schedEntry[a].cycle != schedEntry[b].cycle)
+		return (schedEntry[a].cycle < schedEntry[b].cycle);
+	return (schedEntry[a].seq < schedEntry[b].seq);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static int schedHeapPop() {
+	unsigned int pos = 0, child;
+	int first = schedHeap[0];
+	int last = schedHeap[--schedHeapSize];
+
+	for (;;) {
+		child = 2*pos+1;
+		if (child >= schedHeapSize)
+			break;
+		if ((child+1 < schedHeapSize) && schedBefore(schedHeap[child+1], schedHeap[child]))
+			child++;
+		if (!schedBefore(schedHeap[child], last))
+			break;
+		schedHeap[pos] = schedHeap[child];
+		pos = child;
+	}
+	schedHeap[pos] = last;
+	return first;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void schedRelease(const CrMaCmdSchedEntry_t* c) {
+	CrDaOutAdmitReq_t req = {CR_DA_SERV_TYPE, 0, 0, 0, 0, CR_DA_OUT_ADMIT_CMD_POLICY, &schedIssue};
+	CrMaCmdSchedArg_t arg;
+
+	req.servSubType = c->subType;
+	req.dest = c->dest;
+	arg.tempLimit = c->tempLimit;
+	arg.subType = c->subType;
+	/* A command which cannot be made now is deferred until an OutComponent is available */
+	if (!CrDaOutAdmitIssue(&req, &arg, sizeof(arg)))
+		nOfFailed++;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void schedIssue(FwSmDesc_t outCmd, CrFwDestSrc_t dest, const void* arg) {
+	const CrMaCmdSchedArg_t* a = (const CrMaCmdSchedArg_t*)arg;
+
+	if (a->subType == CR_DA_SERV_SUBTYPE_SET)
+		CrMaOutCmpSetTempLimitSetTempLimit(a->tempLimit);
+	CrFwOutCmpSetDest(outCmd, dest);
+	CrMaLatencyLoad(outCmd);
+	nOfReleased++;
+
+	if (a->subType == CR_DA_SERV_SUBTYPE_SET)
+		CR_DA_LOG(crDaLogInfo, "MA: Sending command to set the temperature limit in Slave %d to %d degC\n",
+		          dest-CR_DA_SLAVE_1+1, a->tempLimit);
+	else if (a->subType == CR_DA_SERV_SUBTYPE_EN)
+		CR_DA_LOG(crDaLogInfo, "MA: Sending command to enable temperature monitoring in Slave %d\n",
+		          dest-CR_DA_SLAVE_1+1);
+	else
+		CR_DA_LOG(crDaLogInfo, "MA: Sending command to disable temperature monitoring in Slave %d\n",
+		          dest-CR_DA_SLAVE_1+1);
+}
@@ -0,0 +1,110 @@
+/**
+ * @file
+ * @ingroup crDemoMaster
+ * Interface for the time-tagged command scheduler of the Master Application of the
+ * CORDET Demo.
+ * The commands of the Temperature Monitoring Service which the Master Application
+ * sends to the Slave Applications are queued with the control cycle in which they are
+ * due (their release cycle) and, optionally, a period with which they are repeated
+ * (see <code>::CrMaCmdSchedAdd</code>).
+ * In each cycle, the scheduler releases the commands which are due: it makes their
+ * OutComponents and loads them into the OutLoader (see <code>::CrMaCmdSchedCycle</code>).
+ * The commands which are due in the same cycle are released in the order in which they
+ * were queued.
+ *
+ * The commands are kept in a timing wheel of <code>#CR_MA_CMD_SCHED_N_OF_SLOTS</code>
+ * slots, one for each of the next cycles: a command which is due within the wheel is
+ * queued in the slot of its release cycle and the commands which are due later are kept
+ * in a binary heap ordered by release cycle.
+ * In each cycle, the scheduler moves the commands which enter the wheel from the heap to
+ * their slots and releases the commands of the slot of the cycle.
+ * The cost of a cycle is therefore independent of the number of commands which are
+ * pending: it only depends on the number of commands which are released or which enter
+ * the wheel (each command enters the wheel once).
+ * A periodic command is queued again after its release.
+ * At most <code>#CR_MA_CMD_SCHED_N_OF_CMDS</code> commands can be pending.
+ *
+ * If no command timeline has been uploaded, the Master Application queues the
+ * command timeline of the demo (see <code>CrMaMain.c</code>).
+ * A command timeline is uploaded from a text file with the <code>-s</code> option of
+ * the Master Application (see <code>::CrMaCmdSchedLoadFile</code>).
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRMA_CMDSCHED_H_
+#define CRMA_CMDSCHED_H_
+
+/* Include Framework Files */
+#include "CrFwConstants.h"
+/* Include Configuration Files */
+#include "CrFwUserConstants.h"
+#include "CrMaConstants.h"
+
+/**
+ * Queue a command.
+ * A command whose release cycle has already been executed is released in the next cycle.
+ * @param cycle the release cycle of the command (the first cycle has number 1)
+ * @param period the period in cycles with which the command is repeated (zero for a
+ * command which is only released once)
+ * @param subType the sub-type of the command (<code>#CR_DA_SERV_SUBTYPE_SET</code>,
+ * <code>#CR_DA_SERV_SUBTYPE_EN</code> or <code>#CR_DA_SERV_SUBTYPE_DIS</code>)
+ * @param dest the destination of the command
+ * @param tempLimit the temperature limit (only used by the commands which set the
+ * temperature limit)
+ * @return 1 if the command has been queued; 0 if the scheduler is full
+ */
+CrFwBool_t CrMaCmdSchedAdd(unsigned int cycle, unsigned int period, CrFwServSubType_t subType,
+                           CrFwDestSrc_t dest, int tempLimit);
+
+/**
+ * Upload a command timeline from a text file.
+ * Each line of the file queues one command and has the form
+ * <code>cycle period command dest [limit]</code> where <code>command</code> is
+ * <code>set</code>, <code>enable</code> or <code>disable</code>, <code>dest</code> is the
+ * application identifier of the destination and <code>limit</code> is the temperature
+ * limit of a <code>set</code> command.
+ * Empty lines and lines which start with <code>#</code> are ignored.
+ * @param path the path of the file
+ * @return 1 if all commands of the file have been queued; 0 otherwise
+ */
+CrFwBool_t CrMaCmdSchedLoadFile(const char* path);
+
+/**
+ * Release the commands which are due in a cycle.
+ * This function is called once per cycle by the Cycle Work Function of the Master
+ * Application with increasing cycle numbers.
+ * @param cycle the number of the cycle
+ */
+void CrMaCmdSchedCycle(unsigned int cycle);
+
+/**
+ * Return the number of commands which have been queued (a periodic command is counted once).
+ * @return the number of queued commands
+ */
+unsigned int CrMaCmdSchedGetNOfQueued();
+
+/**
+ * Return the number of commands which are pending.
+ * @return the number of pending commands
+ */
+unsigned int CrMaCmdSchedGetNOfPending();
+
+/**
+ * Print the numbers of queued, released and pending commands and the number of commands
+ * which could not be queued or released.
+ * Nothing is printed if no command has been queued.
+ */
+void CrMaCmdSchedReport();
+
+#endif /* CRMA_CMDSCHED_H_ */
@@ -0,0 +1,169 @@
+/**
+ * @file
+ * @ingroup crDemoMaster
+ * Implementation of the command state table of the Master Application of the CORDET Demo.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdio.h>
+#include "CrMaCmdState.h"
+/* Include framework files */
+#include "BaseCmp/CrFwBaseCmp.h"
+
+/** The mask which maps a hash value to a slot of the hash table. */
+#define CR_MA_CMD_STATE_MASK (CR_MA_CMD_STATE_N_OF_SLOTS-1)
+
+#if ((CR_MA_CMD_STATE_N_OF_SLOTS & CR_MA_CMD_STATE_MASK) != 0) || (CR_MA_CMD_STATE_N_OF_SLOTS < 2*CR_MA_CMD_STATE_N)
+#error "The number of slots of the command state table must be a power of two and at least twice its size"
+#endif
+
+/** The type for a slot of the hash table. */
+typedef struct {
+	/** The command identifier (undefined if the slot is empty). */
+	CrFwInstanceId_t cmdId;
+	/** The state of the command (<code>::crMaCmdNotTracked</code> if the slot is empty). */
+	unsigned char state;
+} CrMaCmdStateSlot_t;
+
+/** The hash table of the tracked commands. */
+static CrMaCmdStateSlot_t cmdSlot[CR_MA_CMD_STATE_N_OF_SLOTS];
+
+/** The command identifiers of the tracked commands in the order in which they were loaded. */
+static CrFwInstanceId_t cmdRing[CR_MA_CMD_STATE_N];
+
+/** The position in the ring of the next command (and of the oldest command if the ring is full). */
+static unsigned int ringNext = 0;
+
+/** The number of tracked commands. */
+static unsigned int nOfTracked = 0;
+
+/** The length of the longest probe sequence. */
+static unsigned int maxProbe = 0;
+
+/**
+ * Return the slot at which the probe sequence of a command identifier starts.
+ * @param cmdId the command identifier
+ * @return the slot
+ */
+static unsigned int cmdStateHash(CrFwInstanceId_t cmdId);
+
+/**
+ * Return the slot of a command identifier or, if the command is not tracked, the empty
+ * slot at which its probe sequence ends.
+ * @param cmdId the command identifier
+ * @return the slot
+ */
+static unsigned int cmdStateFind(CrFwInstanceId_t cmdId);
+
+/**
+ * Empty a slot of the hash table and shift back the slots of its probe sequence.
+ * @param pos the slot
+ */
+static void cmdStateRemove(unsigned int pos);
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrMaCmdStateLoad(FwSmDesc_t outCmd) {
+	CrFwInstanceId_t cmdId = CrFwCmpGetInstanceId(outCmd);
+	unsigned int pos = cmdStateFind(cmdId);
+
+	if (cmdSlot[pos].state != crMaCmdNotTracked) {
+		cmdSlot[pos].state = crMaCmdPending;
+		return;
+	}
+
+	/* Stop tracking the oldest command if the table is full */
+	if (nOfTracked == CR_MA_CMD_STATE_N) {
+		cmdStateRemove(cmdStateFind(cmdRing[ringNext]));
+		nOfTracked--;
+		pos = cmdStateFind(cmdId);
+	}
+	cmdSlot[pos].cmdId = cmdId;
+	cmdSlot[pos].state = crMaCmdPending;
+	cmdRing[ringNext] = cmdId;
+	ringNext = (ringNext+1) % CR_MA_CMD_STATE_N;
+	nOfTracked++;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrMaCmdStateSent(FwSmDesc_t outCmd) {
+	unsigned int pos = cmdStateFind(CrFwCmpGetInstanceId(outCmd));
+
+	if (cmdSlot[pos].state == crMaCmdPending)
+		cmdSlot[pos].state = crMaCmdSent;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrMaCmdStateAck(CrFwInstanceId_t cmdId) {
+	unsigned int pos = cmdStateFind(cmdId);
+
+	if (cmdSlot[pos].state != crMaCmdNotTracked)
+		cmdSlot[pos].state = crMaCmdAcknowledged;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrMaCmdState_t CrMaCmdStateGet(CrFwInstanceId_t cmdId) {
+	return (CrMaCmdState_t)cmdSlot[cmdStateFind(cmdId)].state;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrMaCmdStateReport() {
+	unsigned int nOfState[crMaCmdAcknowledged+1] = {0, 0, 0, 0};
+	unsigned int i;
+
+	if (nOfTracked == 0)
+		return;
+	for (i=0; i<CR_MA_CMD_STATE_N_OF_SLOTS; i++)
+		nOfState[cmdSlot[i].state]++;
+	printf("MA: Command states: %u of %d commands tracked (%u pending, %u sent, %u acknowledged), longest probe %u\n",
+	       nOfTracked, CR_MA_CMD_STATE_N, nOfState[crMaCmdPending], nOfState[crMaCmdSent],
+	       nOfState[crMaCmdAcknowledged], maxProbe);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static unsigned int cmdStateHash(CrFwInstanceId_t cmdId) {
+	return (unsigned int)(cmdId >> CR_FW_NBITS_APP_ID) & CR_MA_CMD_STATE_MASK;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static unsigned int cmdStateFind(CrFwInstanceId_t cmdId) {
+	unsigned int pos = cmdStateHash(cmdId);
+	unsigned int nOfProbes = 1;
+
+	while ((cmdSlot[pos].state != crMaCmdNotTracked) && (cmdSlot[pos].cmdId != cmdId)) {
+		pos = (pos+1) & CR_MA_CMD_STATE_MASK;
+		nOfProbes++;
+	}
+	if (nOfProbes > maxProbe)
+		maxProbe = nOfProbes;
+	return pos;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void cmdStateRemove(unsigned int pos) {
+	unsigned int next = pos;
+	unsigned int home;
+
+	for (;;) {
+		next = (next+1) & CR_MA_CMD_STATE_MASK;
+		if (cmdSlot[next].state == crMaCmdNotTracked)
+			break;
+		/* The slot can be shifted back unless its probe sequence starts after the empty slot */
+		home = cmdStateHash(cmdSlot[next].cmdId);
+		if (((next - home) & CR_MA_CMD_STATE_MASK) >= ((next - pos) & CR_MA_CMD_STATE_MASK)) {
+			cmdSlot[pos] = cmdSlot[next];
+			pos = next;
+		}
+	}
+	cmdSlot[pos].state = crMaCmdNotTracked;
+}
@@ -0,0 +1,101 @@
+/**
+ * @file
+ * @ingroup crDemoMaster
+ * Interface for the command state table of the Master Application of the CORDET Demo.
+ * The command state table tracks the state of the <code>#CR_MA_CMD_STATE_N</code> commands
+ * which the Master Application has most recently loaded:
+ * - A command is pending from the time it is loaded (<code>::CrMaCmdStateLoad</code>).
+ * - It is sent when its OutManager serializes it (<code>::CrMaCmdStateSent</code>).
+ * - It is acknowledged when the acknowledgement of its start arrives from its
+ *   destination (<code>::CrMaCmdStateAck</code>).
+ * .
+ * The state of a command is queried by its command identifier
+ * (<code>::CrMaCmdStateGet</code>).
+ *
+ * The table is indexed by an open-addressing hash table of
+ * <code>#CR_MA_CMD_STATE_N_OF_SLOTS</code> slots with linear probing and keyed by the
+ * command identifier, so that the insertions, updates and look-ups take a constant time
+ * also when the number of tracked commands is large.
+ * The command identifiers are allocated in sequence and the hash of an identifier is
+ * therefore its sequence part (i.e. the identifier without the application identifier)
+ * modulo the number of slots: the identifiers of the tracked commands then only collide
+ * when the sequence wraps around.
+ * The tracked commands are also kept in a ring in the order in which they were loaded:
+ * when the table is full, the oldest command is removed from the hash table (with a
+ * backward shift of the slots of its probe sequence, so that no tombstones are needed).
+ *
+ * The command state table is updated and queried by the thread of the cycle scheduler
+ * (the OutManagers and the InManager of the acknowledgements are not independent).
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRMA_CMDSTATE_H_
+#define CRMA_CMDSTATE_H_
+
+/* Include Framework Files */
+#include "CrFwConstants.h"
+/* Include Configuration Files */
+#include "CrFwUserConstants.h"
+#include "CrMaConstants.h"
+/* Include FW Profile files */
+#include "FwSmConstants.h"
+
+/** The state of a command in the command state table. */
+typedef enum {
+	/** The command is not tracked (it is unknown or it has been removed from the table). */
+	crMaCmdNotTracked = 0,
+	/** The command has been loaded and it is waiting to be sent. */
+	crMaCmdPending = 1,
+	/** The command has been sent. */
+	crMaCmdSent = 2,
+	/** The acknowledgement of the start of the command has arrived. */
+	crMaCmdAcknowledged = 3
+} CrMaCmdState_t;
+
+/**
+ * Start tracking a command which is being loaded.
+ * If the table is full, the oldest command is no longer tracked.
+ * @param outCmd the OutComponent of the command
+ */
+void CrMaCmdStateLoad(FwSmDesc_t outCmd);
+
+/**
+ * Record that a command has been sent.
+ * Nothing is done if the command is not tracked.
+ * @param outCmd the OutComponent of the command
+ */
+void CrMaCmdStateSent(FwSmDesc_t outCmd);
+
+/**
+ * Record that the acknowledgement of the start of a command has arrived.
+ * Nothing is done if the command is not tracked.
+ * @param cmdId the command identifier of the command
+ */
+void CrMaCmdStateAck(CrFwInstanceId_t cmdId);
+
+/**
+ * Return the state of a command.
+ * @param cmdId the command identifier of the command
+ * @return the state of the command (<code>::crMaCmdNotTracked</code> if the command is not
+ * tracked)
+ */
+CrMaCmdState_t CrMaCmdStateGet(CrFwInstanceId_t cmdId);
+
+/**
+ * Print the number of tracked commands in each state and the length of the longest
+ * probe sequence of the hash table.
+ */
+void CrMaCmdStateReport();
+
+#endif /* CRMA_CMDSTATE_H_ */
@@ -22,9 +22,119 @@
 #include "FwPrConstants.h"
 
 /** The number of framework components */
-#define CR_MA_N_OF_FW_CMP 9
+#define CR_MA_N_OF_FW_CMP 10
+
+/**
+ * The peers of the Master Application.
+ * The Master Application has one InStream and one OutStream for each peer and its stream
+ * tables (see <code>CrFwInStreamUserPar.h</code> and <code>CrFwOutStreamUserPar.h</code>)
+ * are generated from this list: the generator <code>PEER</code> is applied to the
+ * identifier of each peer and to <code>arg</code> (see <code>#CR_DA_PEER_ID</code>).
+ * A larger topology is configured by defining this macro on the compiler command line or
+ * in a header which is included ahead of all others (e.g. with <code>-include</code>).
+ */
+#ifndef CR_MA_PEERS
+#define CR_MA_PEERS(PEER, arg) PEER(CR_DA_SLAVE_1, arg) PEER(CR_DA_SLAVE_2, arg)
+#endif
 
 /** The temperature limit */
 #define TEMP_LIMIT 50
 
+/** The default rate in commands per second of the load generator (see <code>CrMaLoadGen.h</code>). */
+#define CR_MA_LOAD_GEN_RATE 1000
+
+/** The default duration in seconds of the load generation (see <code>CrMaLoadGen.h</code>). */
+#define CR_MA_LOAD_GEN_DURATION 10
+
+/** The period in microseconds of the control cycles in the load-generation mode. */
+#define CR_MA_LOAD_GEN_PERIOD_USEC 1000
+
+/** The number of OutManager lanes (see <code>CrMaOutLane.h</code>); it must be equal to <code>#CR_FW_NOF_OUTMANAGER</code>. */
+#define CR_MA_OUT_N_OF_LANES 2
+
+/** The OutManager lane of the time-critical commands (it is served first in every control cycle). */
+#define CR_MA_OUT_LANE_URGENT 0
+
+/** The OutManager lane of the bulk commands. */
+#define CR_MA_OUT_LANE_BULK 1
+
+/** The maximum number of OutComponents which each OutManager lane sends in a control cycle. */
+#define CR_MA_OUT_LANE_BUDGET {10, 8}
+
+/**
+ * The number of slots of the table of the commands awaiting their acknowledgement in
+ * the latency benchmark (see <code>CrMaLatency.h</code>).
+ * A command whose slot is re-used before its acknowledgement has arrived is counted as lost.
+ */
+#define CR_MA_LATENCY_N_OF_SLOTS 1024
+
+/**
+ * The number of bits of the linear sub-buckets of the latency histograms (see
+ * <code>CrMaLatency.h</code>): each power-of-two range of latencies is divided into
+ * <code>2^CR_MA_LATENCY_SUB_BITS</code> buckets of equal width.
+ */
+#define CR_MA_LATENCY_SUB_BITS 4
+
+/**
+ * The number of commands whose state is tracked by the command state table (see
+ * <code>CrMaCmdState.h</code>): the table tracks the most recently loaded commands.
+ * It must be smaller than the number of command identifiers of the Master Application
+ * (<code>2^(16-#CR_FW_NBITS_APP_ID)</code> or, with the wide application identifiers,
+ * <code>2^(32-#CR_FW_NBITS_APP_ID)</code>).
+ */
+#define CR_MA_CMD_STATE_N 1024
+
+/**
+ * The number of slots of the hash table of the command state table (see
+ * <code>CrMaCmdState.h</code>).
+ * It must be a power of two and at least twice <code>#CR_MA_CMD_STATE_N</code> so that the
+ * probe sequences remain short.
+ */
+#define CR_MA_CMD_STATE_N_OF_SLOTS 2048
+
+/**
+ * The maximum number of sub-type entries of a kind index (see <code>CrMaKindIndex.h</code>):
+ * each service type of a kind table takes one entry for each sub-type between its
+ * smallest and its largest sub-type.
+ */
+#define CR_MA_KIND_INDEX_N_OF_ENTRIES 1024
+
+/**
+ * The maximum number of commands which can be queued in the time-tagged command scheduler
+ * (see <code>CrMaCmdSched.h</code>); a periodic command takes one entry.
+ */
+#define CR_MA_CMD_SCHED_N_OF_CMDS 1024
+
+/**
+ * The number of slots of the timing wheel of the time-tagged command scheduler (see
+ * <code>CrMaCmdSched.h</code>): the commands which are due within this number of cycles
+ * are kept in the wheel and the later commands in a heap.
+ * It must be a power of two.
+ */
+#define CR_MA_CMD_SCHED_N_OF_SLOTS 256
+
+/**
+ * The number of channels of each slave whose temperature violations are kept by the
+ * time-series store (see <code>CrMaTempStore.h</code>); the violations of the other
+ * channels are counted but not stored.
+ */
+#define CR_MA_TEMP_STORE_N_OF_CHANNELS 64
+
+/**
+ * The number of samples which the time-series store keeps for each slave and channel
+ * (see <code>CrMaTempStore.h</code>); it must be a power of two.
+ */
+#define CR_MA_TEMP_STORE_DEPTH 64
+
+/**
+ * Switch which selects the write-through of the time-series store to a memory-mapped
+ * file (see <code>CrMaTempStore.h</code>).
+ * If this constant is set to 1, the store is kept in the file <code>CrMaTempStore.img</code>
+ * and the history of a previous run is kept across a restart.
+ * If it is set to 0, the store is only kept in memory.
+ */
+#ifndef CR_MA_TEMP_STORE_FILE
+#define CR_MA_TEMP_STORE_FILE 0
+#endif
+
 #endif /* CRMA_CONSTANTS_H_ */
@@ -0,0 +1,104 @@
+/**
+ * @file
+ * @ingroup crDemoMaster
+ * Implementation of the Command Acknowledgement InReport.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdlib.h>
+#include "CrMaInRepCmdAck.h"
+#include "CrMaLatency.h"
+#include "CrMaCmdState.h"
+#include "CrDaConstants.h"
+#include "CrDaLatTrace.h"
+#include "CrDaLog.h"
+#include "CrDaOutCmpAckBatch.h"
+#include "CrDaPar.h"
+/* Include configuration files */
+#include "CrFwCmpData.h"
+/* Include framework files */
+#include "CrFwConstants.h"
+#include "InRep/CrFwInRep.h"
+#include "Pckt/CrFwPckt.h"
+#include "CrFwPcktInline.h"
+/* Include FW Profile files */
+#include "FwPrConfig.h"
+
+/*-----------------------------------------------------------------------------------------*/
+CrFwBool_t CrMaInRepCmdAckValidityCheck(FwPrDesc_t prDesc) {
+	return 1;
+}
+
+/*-----------------------------------------------------------------------------------------*/
+void CrMaInRepCmdAckUpdateAction(FwPrDesc_t prDesc) {
+	CrFwCmpData_t* cmpData = (CrFwCmpData_t*)FwPrGetData(prDesc);
+	CrFwInRepData_t* cmpSpecificData = (CrFwInRepData_t*)(cmpData->cmpSpecificData);
+	CrFwPckt_t pckt = cmpSpecificData->pckt; /* the incoming packet */
+	CrFwInstanceId_t cmdId;	/* the identifier of the acknowledged command */
+
+	cmdId = CrDaParAckGetCmdId(CrFwPcktGetParStart(pckt));
+	CrMaLatencyAck(CrFwPcktGetSrc(pckt), cmdId);
+	CrMaCmdStateAck(cmdId);
+	CrDaLatTraceDone(pckt);
+	cmpData->outcome = 1;
+}
+
+/*-----------------------------------------------------------------------------------------*/
+CrFwBool_t CrMaInRepCmdAckBatchValidityCheck(FwPrDesc_t prDesc) {
+	CrFwCmpData_t* cmpData = (CrFwCmpData_t*)FwPrGetData(prDesc);
+	CrFwInRepData_t* cmpSpecificData = (CrFwInRepData_t*)(cmpData->cmpSpecificData);
+	CrFwPckt_t pckt = cmpSpecificData->pckt; /* the incoming packet */
+	unsigned int n = CrDaOutCmpAckBatchGetN(CrFwPcktGetParStart(pckt));
+
+	if ((n == 0) || (n > CR_DA_ACK_BATCH_MAX_N))
+		return 0;
+	return (1 + n*CR_DA_ACK_BATCH_ENTRY_LENGTH <= CrFwPcktGetParLength(pckt));
+}
+
+/*-----------------------------------------------------------------------------------------*/
+void CrMaInRepCmdAckBatchUpdateAction(FwPrDesc_t prDesc) {
+	CrFwCmpData_t* cmpData = (CrFwCmpData_t*)FwPrGetData(prDesc);
+	CrFwInRepData_t* cmpSpecificData = (CrFwInRepData_t*)(cmpData->cmpSpecificData);
+	CrFwPckt_t pckt = cmpSpecificData->pckt; /* the incoming packet */
+	char* pcktPar = CrFwPcktGetParStart(pckt);	/* the parameter area of the incoming packet */
+	CrFwDestSrc_t src = CrFwPcktGetSrc(pckt);
+	unsigned int i, n = CrDaOutCmpAckBatchGetN(pcktPar);
+	CrFwInstanceId_t cmdId;
+	CrFwRepInCmdOutcome_t outcome;
+	CrFwOutcome_t failCode;
+
+	if ((src != CR_DA_SLAVE_1) && (src != CR_DA_SLAVE_2)) {
+		cmpData->outcome = 0;
+		return;
+	}
+	for (i=0; i<n; i++) {
+		CrDaOutCmpAckBatchGetEntry(pcktPar, i, &cmdId, &outcome, &failCode);
+		switch (outcome) {
+		case crCmdAckStrSucc:
+			CrMaLatencyAck(src, cmdId);
+			CrMaCmdStateAck(cmdId);
+			break;
+		case crCmdAckAccSucc:
+		case crCmdAckPrgSucc:
+		case crCmdAckTrmSucc:
+			break;
+		default:
+			CR_DA_LOG(crDaLogWarn, "MA: outcome %d of command %u in Slave %d; fail code: %d\n",
+			          outcome, cmdId, (src == CR_DA_SLAVE_1 ? 1 : 2), failCode);
+			break;
+		}
+	}
+	CrDaLatTraceDone(pckt);
+	cmpData->outcome = 1;
+}
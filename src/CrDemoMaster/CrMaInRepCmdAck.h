@@ -0,0 +1,87 @@
+/**
+ * @file
+ * @ingroup crDemoMaster
+ * Command Acknowledgement InReport.
+ * The Command Acknowledgement InReport is the Report generated by a Slave Application
+ * to acknowledge the successful start of a command which has requested it (see
+ * <code>CrDaOutCmpAck.h</code>).
+ * In general, an InReport is defined by defining the functions which override its
+ * adaptation points, namely (see <code>CrFwInRep.h</code>):
+ * - The Validity Check Operation
+ * - The Update Action Operation
+ * .
+ * In the case of the Command Acknowledgement InReport, these functions are
+ * defined as follows:
+ * - The Validity Check always reports: "valid"
+ * - The Update Action Operation passes the acknowledgement to the latency benchmark
+ *   (see <code>CrMaLatency.h</code>).
+ * .
+ * This module defines functions which implement the above operations.
+ * These functions are associated to a specific kind of InReport in
+ * the initializer <code>#CR_FW_INREP_INIT_KIND_DESC</code>.
+ *
+ * This module also defines the operations of the Acknowledgement Batch InReport which a
+ * Slave Application sends instead when the batched acknowledgements are selected (see
+ * <code>CrDaOutCmpAckBatch.h</code>): each outcome of the batch is handled as if it had
+ * arrived in its own report.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRMA_INREP_CMD_ACK_H_
+#define CRMA_INREP_CMD_ACK_H_
+
+/* Include configuration files */
+#include "CrFwUserConstants.h"
+/* Include framework components */
+#include "CrFwConstants.h"
+/* Include FW Profile components */
+#include "FwSmCore.h"
+
+/**
+ * Implementation of the Validity Check Operation for the Master Application.
+ * This function always returns true.
+ * @param prDesc the descriptor of the InReport reset procedure
+ * @return always return true
+ */
+CrFwBool_t CrMaInRepCmdAckValidityCheck(FwPrDesc_t prDesc);
+
+/**
+ * Implementation of the Update Action Operation for the Master Application.
+ * This function reads the identifier of the acknowledged command from the parameter
+ * area of the report packet and passes it, together with the source of the report,
+ * to <code>::CrMaLatencyAck</code>.
+ * @param prDesc the descriptor of the InReport procedure
+ */
+void CrMaInRepCmdAckUpdateAction(FwPrDesc_t prDesc);
+
+/**
+ * Implementation of the Validity Check Operation for the Acknowledgement Batch InReport.
+ * The report is valid if it holds between 1 and <code>#CR_DA_ACK_BATCH_MAX_N</code>
+ * outcomes and if its parameter area is long enough to hold them.
+ * @param prDesc the descriptor of the InReport reset procedure
+ * @return 1 if the report is valid; 0 otherwise
+ */
+CrFwBool_t CrMaInRepCmdAckBatchValidityCheck(FwPrDesc_t prDesc);
+
+/**
+ * Implementation of the Update Action Operation for the Acknowledgement Batch InReport.
+ * The successful starts of the batch are passed to <code>::CrMaLatencyAck</code> and
+ * <code>::CrMaCmdStateAck</code> (as by <code>::CrMaInRepCmdAckUpdateAction</code>) and
+ * the failures are logged.
+ * The report is rejected if its source is not a Slave Application.
+ * @param prDesc the descriptor of the InReport procedure
+ */
+void CrMaInRepCmdAckBatchUpdateAction(FwPrDesc_t prDesc);
+
+#endif /* CRMA_INREP_CMD_ACK_H_ */
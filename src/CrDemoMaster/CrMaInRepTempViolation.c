@@ -20,6 +20,13 @@
 #include <stdlib.h>
 #include <string.h>
 #include "CrDaConstants.h"
+#include "CrDaEventLog.h"
+#include "CrDaLatTrace.h"
+#include "CrDaLog.h"
+#include "CrDaOutCmpTempBatch.h"
+#include "CrDaOutCmpTempStats.h"
+#include "CrDaPar.h"
+#include "CrMaTempStore.h"
 /* Include configuration files */
 #include "CrFwCmpData.h"
 /* Include framework files */
@@ -31,6 +38,8 @@
 #include "BaseCmp/CrFwDummyExecProc.h"
 #include "OutFactory/CrFwOutFactory.h"
 #include "Pckt/CrFwPckt.h"
+#include "CrFwPcktInline.h"
+#include "CrFwPcktHeader.h"
 /* Include FW Profile files */
 #include "FwPrConfig.h"
 #include "FwPrDCreate.h"
@@ -38,6 +47,30 @@
 #include "FwSmDCreate.h"
 #include "FwPrCore.h"
 
+/** The decoding state of the statistics reports of one Slave Application. */
+typedef struct {
+	/** The references of the channels (the entries which were last decoded). */
+	CrDaParStatsEntry_t ref[CR_DA_TEMP_N_OF_CHANNELS];
+	/** Whether a statistics report has been received. */
+	CrFwBool_t hasRep;
+	/** Whether all statistics reports since the last key frame have been received. */
+	CrFwBool_t isSynced;
+	/** The report number of the last statistics report. */
+	unsigned char lastRepNo;
+} CrMaTempStatsSrc_t;
+
+/** The decoding state of the statistics reports of the two Slave Applications. */
+static CrMaTempStatsSrc_t statsSrc[2];
+
+/** The number of statistics reports which have been received. */
+static unsigned long long statsNOfReps = 0;
+
+/** The number of delta-encoded statistics reports which have been received. */
+static unsigned long long statsNOfDeltas = 0;
+
+/** The number of delta-encoded statistics reports which have been dropped out of synchronization. */
+static unsigned long long statsNOfDropped = 0;
+
 /*-----------------------------------------------------------------------------------------*/
 CrFwBool_t CrMaInRepTempViolationValidityCheck(FwPrDesc_t prDesc) {
 	return 1;
@@ -49,17 +82,144 @@ void CrMaInRepTempViolationUpdateAction(FwPrDesc_t prDesc) {
 	CrFwInRepData_t* cmpSpecificData = (CrFwInRepData_t*)(cmpData->cmpSpecificData);
 	CrFwPckt_t pckt = cmpSpecificData->pckt; /* the incoming packet */
 	char* pcktPar = CrFwPcktGetParStart(pckt);	/* the parameter area of the incoming packet */
-	if (CrFwPcktGetSrc(pckt) == CR_DA_SLAVE_1) {
-		printf("MA: Seq. Counter %d - Limit Violation in Slave 1, Temperature = %d\n", CrFwPcktGetSeqCnt(pckt),
-		       pcktPar[0]);
-		cmpData->outcome = 1;
+	CrFwPcktHeader_t hdr;	/* the header of the incoming packet */
+
+	CrFwPcktDecodeHeader(pckt, &hdr);
+	if (hdr.src == CR_DA_SLAVE_1) {
+		CR_DA_LOG(crDaLogInfo, "MA: Seq. Counter %d - Limit Violation in Slave 1, Temperature = %d\n", hdr.seqCnt,
+		          CrDaParViolationGetTemp(pcktPar));
+	} else if (hdr.src == CR_DA_SLAVE_2) {
+		CR_DA_LOG(crDaLogInfo, "MA: Seq. Counter %d - Limit Violation in Slave 2, Temperature = %d\n", hdr.seqCnt,
+		          CrDaParViolationGetTemp(pcktPar));
+	} else {
+		cmpData->outcome = 0;
+		return;
+	}
+	CrMaTempStoreAppend(hdr.src, 0, CrFwPcktGetTimeStamp(pckt), hdr.seqCnt, CrDaParViolationGetTemp(pcktPar));
+	CrDaEventLogWrite(crDaEventLogViolationRep, hdr.src, 0, CrDaParViolationGetTemp(pcktPar), hdr.seqCnt);
+	if (CrDaParViolationGetNOfSuppressed(pcktPar) != 0)
+		CR_DA_LOG(crDaLogInfo, "MA: Seq. Counter %d - %u reports suppressed since the previous report\n", hdr.seqCnt,
+		          CrDaParViolationGetNOfSuppressed(pcktPar));
+	CrDaLatTraceDone(pckt);
+	cmpData->outcome = 1;
+}
+
+/*-----------------------------------------------------------------------------------------*/
+CrFwBool_t CrMaInRepTempViolationBatchValidityCheck(FwPrDesc_t prDesc) {
+	CrFwCmpData_t* cmpData = (CrFwCmpData_t*)FwPrGetData(prDesc);
+	CrFwInRepData_t* cmpSpecificData = (CrFwInRepData_t*)(cmpData->cmpSpecificData);
+	CrFwPckt_t pckt = cmpSpecificData->pckt; /* the incoming packet */
+	unsigned int n = CrDaOutCmpTempBatchGetN(CrFwPcktGetParStart(pckt));
+
+	if ((n == 0) || (n > CR_DA_TEMP_BATCH_MAX_N))
+		return 0;
+	return (1 + n*CR_DA_TEMP_BATCH_ENTRY_LENGTH <= CrFwPcktGetParLength(pckt));
+}
+
+/*-----------------------------------------------------------------------------------------*/
+void CrMaInRepTempViolationBatchUpdateAction(FwPrDesc_t prDesc) {
+	CrFwCmpData_t* cmpData = (CrFwCmpData_t*)FwPrGetData(prDesc);
+	CrFwInRepData_t* cmpSpecificData = (CrFwInRepData_t*)(cmpData->cmpSpecificData);
+	CrFwPckt_t pckt = cmpSpecificData->pckt; /* the incoming packet */
+	char* pcktPar = CrFwPcktGetParStart(pckt);	/* the parameter area of the incoming packet */
+	CrFwPcktHeader_t hdr;	/* the header of the incoming packet */
+	unsigned int i, n = CrDaOutCmpTempBatchGetN(pcktPar);
+	unsigned short chan;
+	char temp;
+	unsigned char nOfSuppressed;
+	CrFwTimeStamp_t timeStamp;
+
+	CrFwPcktDecodeHeader(pckt, &hdr);
+	if ((hdr.src != CR_DA_SLAVE_1) && (hdr.src != CR_DA_SLAVE_2)) {
+		cmpData->outcome = 0;
+		return;
+	}
+	for (i=0; i<n; i++) {
+		CrDaOutCmpTempBatchGetEntry(pcktPar, i, &chan, &temp, &nOfSuppressed, &timeStamp);
+		CR_DA_LOG(crDaLogInfo, "MA: Seq. Counter %d - Limit Violation in Slave %d, Channel %u, Temperature = %d, Time Stamp = %u, Suppressed = %u\n",
+		          hdr.seqCnt, (hdr.src == CR_DA_SLAVE_1 ? 1 : 2), chan, temp, timeStamp, nOfSuppressed);
+		CrMaTempStoreAppend(hdr.src, chan, timeStamp, hdr.seqCnt, temp);
+		CrDaEventLogWrite(crDaEventLogViolationRep, hdr.src, chan, temp, hdr.seqCnt);
+	}
+	CrDaLatTraceDone(pckt);
+	cmpData->outcome = 1;
+}
+
+/*-----------------------------------------------------------------------------------------*/
+CrFwBool_t CrMaInRepTempStatsValidityCheck(FwPrDesc_t prDesc) {
+	CrFwCmpData_t* cmpData = (CrFwCmpData_t*)FwPrGetData(prDesc);
+	CrFwInRepData_t* cmpSpecificData = (CrFwInRepData_t*)(cmpData->cmpSpecificData);
+	CrFwPckt_t pckt = cmpSpecificData->pckt; /* the incoming packet */
+	char* pcktPar = CrFwPcktGetParStart(pckt);	/* the parameter area of the incoming packet */
+	unsigned int n;
+
+	if (CR_DA_PAR_LENGTH(Stats) > CrFwPcktGetParLength(pckt))
+		return 0;
+	n = CrDaOutCmpTempStatsGetN(pcktPar);
+	if ((n == 0) || (n > CR_DA_TEMP_STATS_MAX_N))
+		return 0;
+	if (CrDaParStatsGetEnc(pcktPar) == CR_DA_TEMP_STATS_ENC_DELTA)
+		return 1;
+	if (CrDaParStatsGetEnc(pcktPar) > CR_DA_TEMP_STATS_ENC_DELTA)
+		return 0;
+	return (CR_DA_PAR_LENGTH(Stats) + n*CR_DA_TEMP_STATS_ENTRY_LENGTH <= CrFwPcktGetParLength(pckt));
+}
+
+/*-----------------------------------------------------------------------------------------*/
+void CrMaInRepTempStatsUpdateAction(FwPrDesc_t prDesc) {
+	CrFwCmpData_t* cmpData = (CrFwCmpData_t*)FwPrGetData(prDesc);
+	CrFwInRepData_t* cmpSpecificData = (CrFwInRepData_t*)(cmpData->cmpSpecificData);
+	CrFwPckt_t pckt = cmpSpecificData->pckt; /* the incoming packet */
+	char* pcktPar = CrFwPcktGetParStart(pckt);	/* the parameter area of the incoming packet */
+	CrFwPcktHeader_t hdr;	/* the header of the incoming packet */
+	unsigned int i, n, s;
+	unsigned char enc = CrDaParStatsGetEnc(pcktPar);
+	CrDaParStatsEntry_t entry[CR_DA_TEMP_STATS_MAX_N];
+
+	CrFwPcktDecodeHeader(pckt, &hdr);
+	if ((hdr.src != CR_DA_SLAVE_1) && (hdr.src != CR_DA_SLAVE_2)) {
+		cmpData->outcome = 0;
 		return;
 	}
-	if (CrFwPcktGetSrc(pckt) == CR_DA_SLAVE_2) {
-		printf("MA: Seq. Counter %d - Limit Violation in Slave 2, Temperature = %d\n", CrFwPcktGetSeqCnt(pckt),
-		       pcktPar[0]);
+	s = (hdr.src == CR_DA_SLAVE_1 ? 0 : 1);
+	statsNOfReps++;
+	if (enc == CR_DA_TEMP_STATS_ENC_DELTA)
+		statsNOfDeltas++;
+
+	/* A missing report puts the source out of synchronization until its next key frame */
+	if (statsSrc[s].hasRep && (CrDaParStatsGetRepNo(pcktPar) != (unsigned char)(statsSrc[s].lastRepNo+1)))
+		statsSrc[s].isSynced = 0;
+	statsSrc[s].hasRep = 1;
+	statsSrc[s].lastRepNo = CrDaParStatsGetRepNo(pcktPar);
+	if (enc == CR_DA_TEMP_STATS_ENC_KEY)
+		statsSrc[s].isSynced = 1;
+	else if ((enc == CR_DA_TEMP_STATS_ENC_DELTA) && !statsSrc[s].isSynced) {
+		statsNOfDropped++;
+		CR_DA_LOG(crDaLogInfo, "MA: Seq. Counter %d - Statistics of Slave %d dropped until the next key frame\n",
+		          hdr.seqCnt, s+1);
 		cmpData->outcome = 1;
 		return;
 	}
-	cmpData->outcome = 0;
+
+	n = CrDaOutCmpTempStatsDecode(pcktPar, CrFwPcktGetParLength(pckt), statsSrc[s].ref, entry);
+	if (n == 0) {
+		statsSrc[s].isSynced = 0;
+		cmpData->outcome = 0;
+		return;
+	}
+	for (i=0; i<n; i++) {
+		CR_DA_LOG(crDaLogInfo, "MA: Seq. Counter %d - Statistics of Slave %d over %u cycles, Channel %u, Samples = %u, Min = %d, Max = %d, Mean = %.2f, Above Limit = %u\n",
+		          hdr.seqCnt, s+1, CrDaParStatsGetNOfCycles(pcktPar), entry[i].chan,
+		          entry[i].nOfSamples, entry[i].min, entry[i].max, entry[i].mean/100.0, entry[i].nOfAbove);
+	}
+	CrDaLatTraceDone(pckt);
+	cmpData->outcome = 1;
+}
+
+/*-----------------------------------------------------------------------------------------*/
+void CrMaInRepTempStatsReport() {
+	if (statsNOfReps == 0)
+		return;
+	printf("MA: Statistics reports: %llu received, %llu delta-encoded, %llu dropped out of synchronization\n",
+	       statsNOfReps, statsNOfDeltas, statsNOfDropped);
 }
@@ -57,11 +57,73 @@ CrFwBool_t CrMaInRepTempViolationValidityCheck(FwPrDesc_t prDesc);
  * - the sequence counter of the incoming report
  * - the source application for the incoming report (either Slave 1 or Slave 2)
  * - the value of the temperature which violates the limit
+ * - the number of reports which the slave has suppressed since its previous report
+ *   (only if it is not zero)
  * .
+ * The violation is then appended to the time-series store (see <code>CrMaTempStore.h</code>)
+ * as a violation of channel 0 with the time stamp of the report.
  * This function assumes that the temperature is stored in the first byte of
- * the parameter area of the report packet.
+ * the parameter area of the report packet and the number of suppressed reports
+ * in its second byte.
  * @param prDesc the descriptor of the InReport procedure
  */
 void CrMaInRepTempViolationUpdateAction(FwPrDesc_t prDesc);
 
+/**
+ * Implementation of the Validity Check Operation for the batch report of temperature
+ * violations (see <code>CrDaOutCmpTempBatch.h</code>).
+ * This function checks that the number of violations of the batch is at least one and
+ * at most <code>#CR_DA_TEMP_BATCH_MAX_N</code> and that their entries fit in the parameter
+ * area of the report packet.
+ * @param prDesc the descriptor of the InReport reset procedure
+ * @return 1 if the batch report is valid; 0 otherwise
+ */
+CrFwBool_t CrMaInRepTempViolationBatchValidityCheck(FwPrDesc_t prDesc);
+
+/**
+ * Implementation of the Update Action Operation for the batch report of temperature
+ * violations (see <code>CrDaOutCmpTempBatch.h</code>).
+ * This function unpacks the violations of the batch and writes one message to
+ * <code>stdout</code> for each of them with the same information as
+ * <code>::CrMaInRepTempViolationUpdateAction</code> and with the channel, the time stamp
+ * and the number of suppressed reports of the violation.
+ * Each violation is also appended to the time-series store (see <code>CrMaTempStore.h</code>).
+ * @param prDesc the descriptor of the InReport procedure
+ */
+void CrMaInRepTempViolationBatchUpdateAction(FwPrDesc_t prDesc);
+
+/**
+ * Implementation of the Validity Check Operation for the statistics report of the
+ * temperature monitoring (see <code>CrDaOutCmpTempStats.h</code>).
+ * This function checks that the number of channels of the report is at least one and
+ * at most <code>#CR_DA_TEMP_STATS_MAX_N</code>, that its encoding is known and, if its
+ * entries are plain, that they fit in the parameter area of the report packet (the
+ * delta-encoded entries are checked when they are decoded).
+ * @param prDesc the descriptor of the InReport reset procedure
+ * @return 1 if the statistics report is valid; 0 otherwise
+ */
+CrFwBool_t CrMaInRepTempStatsValidityCheck(FwPrDesc_t prDesc);
+
+/**
+ * Implementation of the Update Action Operation for the statistics report of the
+ * temperature monitoring (see <code>CrDaOutCmpTempStats.h</code>).
+ * This function decodes the channels of the report against the references of its source
+ * (see <code>::CrDaOutCmpTempStatsDecode</code>) and writes one message to
+ * <code>stdout</code> for each of them with the sequence counter and the source of the
+ * report, the length of the window and the statistics of the channel.
+ * A source whose previous statistics report is missing (its report number is not the
+ * successor of the number of the last report of the source) is out of synchronization:
+ * its delta-encoded reports are dropped until its next key frame.
+ * @param prDesc the descriptor of the InReport procedure
+ */
+void CrMaInRepTempStatsUpdateAction(FwPrDesc_t prDesc);
+
+/**
+ * Print the number of statistics reports which have been received, the number which were
+ * delta-encoded and the number which were dropped because their source was out of
+ * synchronization.
+ * Nothing is printed if no statistics report has been received.
+ */
+void CrMaInRepTempStatsReport();
+
 #endif /* CRFW_INREP_SAMPLE1_H_ */
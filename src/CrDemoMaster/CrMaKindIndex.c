@@ -0,0 +1,101 @@
+/**
+ * @file
+ * @ingroup crDemoMaster
+ * Implementation of the direct-indexed kind look-up of the Master Application of the CORDET Demo.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include "CrMaKindIndex.h"
+
+/**
+ * Compare two kinds in the order of the kind tables.
+ * @param a the first kind
+ * @param b the second kind
+ * @return a negative value, zero or a positive value if the first kind comes before, is
+ * equal to or comes after the second kind
+ */
+static long kindCompare(const CrMaKindKey_t* a, const CrMaKindKey_t* b);
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrMaKindIndexBuild(CrMaKindIndex_t* index, const CrMaKindKey_t* key, unsigned int nOfKinds) {
+	unsigned int i, last, nOfEntries = 0;
+	CrFwServType_t type;
+	unsigned int nOfSubTypes;
+
+	index->key = key;
+	index->nOfKinds = nOfKinds;
+	for (i=0; i<CR_MA_KIND_INDEX_N_OF_TYPES; i++)
+		index->typeBase[i] = -1;
+
+	for (i=0; i<nOfKinds; i++) {
+		if ((i > 0) && (kindCompare(&key[i-1], &key[i]) >= 0))
+			return 0;	/* the table is not sorted or a kind is defined twice */
+		type = key[i].servType;
+
+		/* The first kind of a service type reserves the entries of its sub-types */
+		if ((i == 0) || (key[i-1].servType != type)) {
+			for (last=i; (last+1 < nOfKinds) && (key[last+1].servType == type); last++)
+				;
+			nOfSubTypes = (unsigned int)(key[last].servSubType - key[i].servSubType) + 1;
+			if (nOfEntries + nOfSubTypes > CR_MA_KIND_INDEX_N_OF_ENTRIES)
+				return 0;
+			index->typeBase[type] = (short)nOfEntries;
+			index->typeMinSubType[type] = key[i].servSubType;
+			index->typeNOfSubTypes[type] = (unsigned short)nOfSubTypes;
+			for (last=0; last<nOfSubTypes; last++)
+				index->entry[nOfEntries+last] = -1;
+			nOfEntries += nOfSubTypes;
+		}
+
+		/* The first kind of a [service type, service sub-type] pair is its entry */
+		if ((i == 0) || (key[i-1].servType != type) || (key[i-1].servSubType != key[i].servSubType))
+			index->entry[index->typeBase[type] + key[i].servSubType - index->typeMinSubType[type]] = (short)i;
+	}
+	return 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+int CrMaKindIndexFind(const CrMaKindIndex_t* index, CrFwServType_t servType, CrFwServSubType_t servSubType,
+                      CrFwDiscriminant_t discriminant) {
+	const CrMaKindKey_t* key = index->key;
+	int base = index->typeBase[servType];
+	int kind, defKind = -1;
+	unsigned int i;
+
+	if ((base < 0) || (servSubType < index->typeMinSubType[servType]))
+		return -1;
+	if ((unsigned int)(servSubType - index->typeMinSubType[servType]) >= index->typeNOfSubTypes[servType])
+		return -1;
+	kind = index->entry[base + servSubType - index->typeMinSubType[servType]];
+	if (kind < 0)
+		return -1;
+
+	for (i=(unsigned int)kind; (i < index->nOfKinds) && (key[i].servType == servType) &&
+	        (key[i].servSubType == servSubType); i++) {
+		if (key[i].discriminant == discriminant)
+			return (int)i;
+		if (key[i].discriminant == 0)
+			defKind = (int)i;
+	}
+	return defKind;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static long kindCompare(const CrMaKindKey_t* a, const CrMaKindKey_t* b) {
+	if (a->servType != b->servType)
+		return (long)a->servType - (long)b->servType;
+	if (a->servSubType != b->servSubType)
+		return (long)a->servSubType - (long)b->servSubType;
+	return (long)a->discriminant - (long)b->discriminant;
+}
@@ -0,0 +1,95 @@
+/**
+ * @file
+ * @ingroup crDemoMaster
+ * Interface for the direct-indexed kind look-up of the Master Application of the CORDET Demo.
+ * The kinds of commands and reports of an application are defined by sorted tables of
+ * [service type, service sub-type, discriminant] triplets (e.g.
+ * <code>#CR_FW_OUTCMP_INIT_KIND_DESC</code>).
+ * A kind index resolves a triplet to the position of its line in such a table in a
+ * constant time, also when the table has hundreds of lines:
+ * - The service type directly indexes a table which gives, for each service type, the
+ *   range of its service sub-types and the start of its sub-type entries.
+ * - The service sub-type directly indexes the sub-type entries of its service type which
+ *   give the first line of the table for the [service type, service sub-type] pair.
+ * - The lines of the pair are scanned for the discriminant (the discriminants of one
+ *   pair are normally few); the line with discriminant zero matches all discriminants
+ *   which have no line of their own.
+ * .
+ * The kind index is built from the table when the application starts
+ * (<code>::CrMaKindIndexBuild</code>).
+ * The build is also a consistency check of the table: it fails if the lines of the table
+ * are not sorted or not unique, or if the sub-type entries of the table exceed
+ * <code>#CR_MA_KIND_INDEX_N_OF_ENTRIES</code>.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRMA_KINDINDEX_H_
+#define CRMA_KINDINDEX_H_
+
+/* Include Framework Files */
+#include "CrFwConstants.h"
+/* Include Configuration Files */
+#include "CrFwUserConstants.h"
+#include "CrMaConstants.h"
+
+/** The number of service types (the range of <code>::CrFwServType_t</code>). */
+#define CR_MA_KIND_INDEX_N_OF_TYPES (1 << (8*sizeof(CrFwServType_t)))
+
+/** The key of a kind: one line of a kind table. */
+typedef struct {
+	/** The service type. */
+	CrFwServType_t servType;
+	/** The service sub-type. */
+	CrFwServSubType_t servSubType;
+	/** The discriminant (zero for all discriminants). */
+	CrFwDiscriminant_t discriminant;
+} CrMaKindKey_t;
+
+/** The kind index of a kind table. */
+typedef struct {
+	/** The start of the sub-type entries of each service type (-1 if the type has no kinds). */
+	short typeBase[CR_MA_KIND_INDEX_N_OF_TYPES];
+	/** The smallest service sub-type of each service type. */
+	CrFwServSubType_t typeMinSubType[CR_MA_KIND_INDEX_N_OF_TYPES];
+	/** The number of sub-type entries of each service type. */
+	unsigned short typeNOfSubTypes[CR_MA_KIND_INDEX_N_OF_TYPES];
+	/** The first line of each [service type, service sub-type] pair (-1 if the pair has no kinds). */
+	short entry[CR_MA_KIND_INDEX_N_OF_ENTRIES];
+	/** The kind table. */
+	const CrMaKindKey_t* key;
+	/** The number of lines of the kind table. */
+	unsigned int nOfKinds;
+} CrMaKindIndex_t;
+
+/**
+ * Build the kind index of a kind table.
+ * @param index the kind index (output)
+ * @param key the kind table (it must remain valid as long as the index is used)
+ * @param nOfKinds the number of lines of the kind table
+ * @return 1 if the kind table is consistent and the index was built; 0 otherwise
+ */
+CrFwBool_t CrMaKindIndexBuild(CrMaKindIndex_t* index, const CrMaKindKey_t* key, unsigned int nOfKinds);
+
+/**
+ * Return the line of the kind table which matches a kind.
+ * @param index the kind index
+ * @param servType the service type
+ * @param servSubType the service sub-type
+ * @param discriminant the discriminant
+ * @return the line of the kind table or -1 if no line matches
+ */
+int CrMaKindIndexFind(const CrMaKindIndex_t* index, CrFwServType_t servType, CrFwServSubType_t servSubType,
+                      CrFwDiscriminant_t discriminant);
+
+#endif /* CRMA_KINDINDEX_H_ */
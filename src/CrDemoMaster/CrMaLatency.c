@@ -0,0 +1,272 @@
+/**
+ * @file
+ * @ingroup crDemoMaster
+ * Implementation of the command round-trip latency benchmark of the Master Application.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "CrMaLatency.h"
+#include "CrMaCmdState.h"
+/* Include Common Demo Files */
+#include "CrDaConstants.h"
+/* Include framework files */
+#include "BaseCmp/CrFwBaseCmp.h"
+#include "OutCmp/CrFwOutCmp.h"
+#include "OutLoader/CrFwOutLoader.h"
+
+/** The number of destinations of the latency benchmark (Slave 1 and Slave 2). */
+#define CR_MA_LATENCY_N_OF_DEST 2
+
+/** The number of linear sub-buckets in each power-of-two range of a latency histogram. */
+#define CR_MA_LATENCY_N_OF_SUB (1U << CR_MA_LATENCY_SUB_BITS)
+
+/** The number of buckets of a latency histogram (it covers the full range of a 64-bit latency). */
+#define CR_MA_LATENCY_N_OF_BUCKETS ((64 - CR_MA_LATENCY_SUB_BITS + 1) * CR_MA_LATENCY_N_OF_SUB)
+
+/** A command awaiting its acknowledgement. */
+typedef struct {
+	/** The time at which the command was loaded. */
+	struct timespec load;
+	/** The command identifier of the command. */
+	CrFwInstanceId_t cmdId;
+	/** The index of the destination of the command. */
+	unsigned char dest;
+	/** Flag which is set while the command is awaiting its acknowledgement. */
+	CrFwBool_t pending;
+} CrMaLatencySlot_t;
+
+/** The latency histogram and the counters of one destination. */
+typedef struct {
+	/** The number of latencies in each bucket. */
+	unsigned int bucket[CR_MA_LATENCY_N_OF_BUCKETS];
+	/** The number of commands loaded for the destination. */
+	unsigned long nOfLoaded;
+	/** The number of acknowledged commands (the number of latencies in the histogram). */
+	unsigned long nOfAcks;
+	/** The number of commands whose slot was re-used before their acknowledgement arrived. */
+	unsigned long nOfLost;
+	/** The maximum latency in nanoseconds. */
+	unsigned long long max;
+} CrMaLatencyHist_t;
+
+/** The names of the destinations in the summary. */
+static const char* latencyDestName[CR_MA_LATENCY_N_OF_DEST] = {"Slave 1 (direct)", "Slave 2 (routed)"};
+
+/** Flag which is set if the latency benchmark is selected. */
+static CrFwBool_t latencySelected = 0;
+
+/** The commands awaiting their acknowledgement indexed by their command identifier. */
+static CrMaLatencySlot_t latencySlot[CR_MA_LATENCY_N_OF_SLOTS];
+
+/** The latency histograms of the destinations. */
+static CrMaLatencyHist_t latencyHist[CR_MA_LATENCY_N_OF_DEST];
+
+/** The number of acknowledgements which do not match a command awaiting its acknowledgement. */
+static unsigned long nOfUnmatched = 0;
+
+/**
+ * Return the index of the destination in the latency benchmark.
+ * @param dest the destination
+ * @return the index of the destination or <code>#CR_MA_LATENCY_N_OF_DEST</code> if the
+ * destination is not a Slave Application
+ */
+static unsigned int latencyGetDestIndex(CrFwDestSrc_t dest);
+
+/**
+ * Return the index of the slot of a command.
+ * The application identifier in the command identifier is the same for all commands
+ * and it is therefore ignored.
+ * @param cmdId the command identifier
+ * @return the index of the slot
+ */
+static unsigned int latencyGetSlotIndex(CrFwInstanceId_t cmdId);
+
+/**
+ * Return the index of the histogram bucket of a latency.
+ * Latencies below <code>#CR_MA_LATENCY_N_OF_SUB</code> nanoseconds have one bucket per
+ * nanosecond; larger latencies are located by the position of their most significant
+ * bit (the power-of-two range) and by the next <code>#CR_MA_LATENCY_SUB_BITS</code> bits
+ * (the linear sub-bucket).
+ * @param lat the latency in nanoseconds
+ * @return the index of the bucket
+ */
+static unsigned int latencyGetBucket(unsigned long long lat);
+
+/**
+ * Return the largest latency which is recorded in a histogram bucket.
+ * @param bucket the index of the bucket
+ * @return the largest latency in nanoseconds of the bucket
+ */
+static unsigned long long latencyGetBucketMax(unsigned int bucket);
+
+/**
+ * Return a percentile of a latency histogram.
+ * The percentile is the largest latency of the bucket which holds it and it is
+ * therefore accurate to within the width of that bucket.
+ * It is capped at the maximum latency of the histogram.
+ * @param hist the histogram
+ * @param perMille the percentile in per mille (e.g. 999 for the 99.9th percentile)
+ * @return the percentile in nanoseconds
+ */
+static unsigned long long latencyGetPercentile(const CrMaLatencyHist_t* hist, unsigned int perMille);
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrMaLatencySelect() {
+	latencySelected = 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrMaLatencyIsSelected() {
+	return latencySelected;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrMaLatencyLoad(FwSmDesc_t outCmd) {
+	CrMaLatencySlot_t* slot;
+	CrFwInstanceId_t cmdId;
+	unsigned int dest;
+
+	CrMaCmdStateLoad(outCmd);
+	if (!latencySelected) {
+		CrFwOutLoaderLoad(outCmd);
+		return;
+	}
+
+	dest = latencyGetDestIndex(CrFwOutCmpGetDest(outCmd));
+	if (dest == CR_MA_LATENCY_N_OF_DEST) {
+		CrFwOutLoaderLoad(outCmd);
+		return;
+	}
+	cmdId = CrFwCmpGetInstanceId(outCmd);
+	slot = &latencySlot[latencyGetSlotIndex(cmdId)];
+	if (slot->pending)
+		latencyHist[slot->dest].nOfLost++;
+	slot->cmdId = cmdId;
+	slot->dest = (unsigned char)dest;
+	slot->pending = 1;
+	latencyHist[dest].nOfLoaded++;
+
+	/* Request the acknowledgement of the start of the command */
+	CrFwOutCmpSetAckLevel(outCmd, 0, 1, 0, 0);
+	clock_gettime(CLOCK_MONOTONIC, &slot->load);
+	CrFwOutLoaderLoad(outCmd);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrMaLatencyAck(CrFwDestSrc_t src, CrFwInstanceId_t cmdId) {
+	CrMaLatencySlot_t* slot = &latencySlot[latencyGetSlotIndex(cmdId)];
+	CrMaLatencyHist_t* hist;
+	struct timespec now;
+	unsigned long long lat;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	if (!slot->pending || (slot->cmdId != cmdId) || (slot->dest != latencyGetDestIndex(src))) {
+		nOfUnmatched++;
+		return;
+	}
+	slot->pending = 0;
+
+	lat = (unsigned long long)(now.tv_sec - slot->load.tv_sec) * 1000000000ULL + now.tv_nsec - slot->load.tv_nsec;
+	hist = &latencyHist[slot->dest];
+	hist->bucket[latencyGetBucket(lat)]++;
+	hist->nOfAcks++;
+	if (lat > hist->max)
+		hist->max = lat;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrMaLatencyReport() {
+	const CrMaLatencyHist_t* hist;
+	unsigned long nOfPending[CR_MA_LATENCY_N_OF_DEST] = {0, 0};
+	unsigned int i;
+
+	if (!latencySelected)
+		return;
+	for (i=0; i<CR_MA_LATENCY_N_OF_SLOTS; i++)
+		if (latencySlot[i].pending)
+			nOfPending[latencySlot[i].dest]++;
+
+	for (i=0; i<CR_MA_LATENCY_N_OF_DEST; i++) {
+		hist = &latencyHist[i];
+		if (hist->nOfLoaded == 0)
+			continue;
+		printf("MA: Latency to %s: %lu commands, %lu acknowledged, %lu not acknowledged\n", latencyDestName[i],
+		       hist->nOfLoaded, hist->nOfAcks, nOfPending[i] + hist->nOfLost);
+		if (hist->nOfAcks == 0)
+			continue;
+		printf("MA: Latency to %s: p50 %.1f us, p99 %.1f us, p99.9 %.1f us, max %.1f us\n", latencyDestName[i],
+		       latencyGetPercentile(hist, 500) / 1e3, latencyGetPercentile(hist, 990) / 1e3,
+		       latencyGetPercentile(hist, 999) / 1e3, hist->max / 1e3);
+	}
+	if (nOfUnmatched > 0)
+		printf("MA: Latency: %lu unmatched acknowledgements\n", nOfUnmatched);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static unsigned int latencyGetDestIndex(CrFwDestSrc_t dest) {
+	if (dest == CR_DA_SLAVE_1)
+		return 0;
+	if (dest == CR_DA_SLAVE_2)
+		return 1;
+	return CR_MA_LATENCY_N_OF_DEST;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static unsigned int latencyGetSlotIndex(CrFwInstanceId_t cmdId) {
+	return (unsigned int)(cmdId >> CR_FW_NBITS_APP_ID) % CR_MA_LATENCY_N_OF_SLOTS;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static unsigned int latencyGetBucket(unsigned long long lat) {
+	unsigned int msb;
+
+	if (lat < CR_MA_LATENCY_N_OF_SUB)
+		return (unsigned int)lat;
+	msb = 63 - (unsigned int)__builtin_clzll(lat);
+	return (msb - CR_MA_LATENCY_SUB_BITS + 1) * CR_MA_LATENCY_N_OF_SUB +
+	       (unsigned int)(lat >> (msb - CR_MA_LATENCY_SUB_BITS)) - CR_MA_LATENCY_N_OF_SUB;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static unsigned long long latencyGetBucketMax(unsigned int bucket) {
+	unsigned int shift;
+
+	if (bucket < CR_MA_LATENCY_N_OF_SUB)
+		return bucket;
+	shift = bucket / CR_MA_LATENCY_N_OF_SUB - 1;
+	return (((unsigned long long)(bucket % CR_MA_LATENCY_N_OF_SUB + CR_MA_LATENCY_N_OF_SUB) + 1) << shift) - 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static unsigned long long latencyGetPercentile(const CrMaLatencyHist_t* hist, unsigned int perMille) {
+	unsigned long long rank, count = 0;
+	unsigned long long val;
+	unsigned int i;
+
+	/* The rank of the percentile (rounded up) in the ordered latencies */
+	rank = ((unsigned long long)hist->nOfAcks * perMille + 999) / 1000;
+	if (rank == 0)
+		rank = 1;
+	for (i=0; i<CR_MA_LATENCY_N_OF_BUCKETS; i++) {
+		count += hist->bucket[i];
+		if (count >= rank) {
+			val = latencyGetBucketMax(i);
+			return (val < hist->max) ? val : hist->max;
+		}
+	}
+	return hist->max;
+}
@@ -0,0 +1,93 @@
+/**
+ * @file
+ * @ingroup crDemoMaster
+ * Interface for the command round-trip latency benchmark of the Master Application of
+ * the CORDET Demo.
+ * The latency benchmark measures the time from the loading of a command into the
+ * OutLoader of the Master Application to the receipt of its acknowledgement from the
+ * Slave Application (see <code>CrDaOutCmpAck.h</code>).
+ * It is selected with option <code>-b</code> on the command line of the Master
+ * Application (see <code>::CrMaLoadGenParseArgs</code>) and it can be combined with the
+ * command schedule of the Master Application or with the load-generation mode (see
+ * <code>CrMaLoadGen.h</code>).
+ *
+ * When the latency benchmark is selected, the commands are loaded through
+ * <code>::CrMaLatencyLoad</code> which sets their start acknowledge flag and records the
+ * time at which they are loaded under their command identifier.
+ * The acknowledgement carries the command identifier of the acknowledged command.
+ * The command identifier is used as the matching key because the sequence counter of a
+ * command is only assigned by its OutStream when the command is sent and is therefore
+ * not yet known when the command is loaded.
+ *
+ * The latencies are recorded in one histogram for each destination: Slave 1 is a
+ * direct destination and Slave 2 is a destination which is routed through Slave 1.
+ * The histograms are log-linear: each power-of-two range of latencies is divided into
+ * <code>2^#CR_MA_LATENCY_SUB_BITS</code> buckets of equal width and the percentiles
+ * are therefore reported with a relative resolution of
+ * <code>2^-#CR_MA_LATENCY_SUB_BITS</code>.
+ * At the end of the run, <code>::CrMaLatencyReport</code> prints, for each destination,
+ * the number of acknowledged commands, the 50th, 99th and 99.9th percentiles and the
+ * maximum of the latencies, and the number of commands whose acknowledgement has not
+ * arrived.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRMA_LATENCY_H_
+#define CRMA_LATENCY_H_
+
+/* Include FW Profile files */
+#include "FwSmConstants.h"
+/* Include Framework Files */
+#include "CrFwConstants.h"
+/* Include Configuration Files */
+#include "CrFwUserConstants.h"
+#include "CrMaConstants.h"
+
+/**
+ * Select the latency benchmark.
+ */
+void CrMaLatencySelect();
+
+/**
+ * Return true if the latency benchmark has been selected on the command line.
+ * @return 1 if the latency benchmark is selected; 0 otherwise
+ */
+CrFwBool_t CrMaLatencyIsSelected();
+
+/**
+ * Load a command into the OutLoader.
+ * If the latency benchmark is selected, the start acknowledge flag of the command is
+ * set and the time at which the command is loaded is recorded.
+ * The command must have its destination set.
+ * @param outCmd the OutComponent representing the command
+ */
+void CrMaLatencyLoad(FwSmDesc_t outCmd);
+
+/**
+ * Record the receipt of the acknowledgement of a command.
+ * If the command is awaiting its acknowledgement, its latency is added to the histogram
+ * of its destination.
+ * Otherwise, the acknowledgement is counted as unmatched.
+ * @param src the source of the acknowledgement (the destination of the command)
+ * @param cmdId the command identifier of the acknowledged command
+ */
+void CrMaLatencyAck(CrFwDestSrc_t src, CrFwInstanceId_t cmdId);
+
+/**
+ * Print the summary of the latency histograms.
+ * This function does nothing if the latency benchmark is not selected.
+ */
+void CrMaLatencyReport();
+
+#endif /* CRMA_LATENCY_H_ */
@@ -0,0 +1,290 @@
+/**
+ * @file
+ * @ingroup crDemoMaster
+ * Implementation of the load generator of the Master Application.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <unistd.h>
+#include <time.h>
+#include "CrMaLoadGen.h"
+#include "CrMaLatency.h"
+#include "CrMaCmdSched.h"
+#include "CrDaCycle.h"
+#include "CrDaOutAdmit.h"
+#include "CrDaStreamMap.h"
+#include "CrMaOutCmpSetTempLimit.h"
+/* Include Common Demo Files */
+#include "CrDaConstants.h"
+/* Include configuration files */
+#include "CrFwOutManagerUserPar.h"
+/* Include FW Profile files */
+#include "FwSmConstants.h"
+/* Include framework files */
+#include "OutFactory/CrFwOutFactory.h"
+#include "OutLoader/CrFwOutLoader.h"
+#include "OutManager/CrFwOutManager.h"
+#include "OutStream/CrFwOutStream.h"
+#include "OutCmp/CrFwOutCmp.h"
+#include "UtilityFunctions/CrFwUtilityFunctions.h"
+
+/** The maximum number of destinations of the load generator. */
+#define CR_MA_LOAD_GEN_MAX_N_OF_DEST 2
+
+/** The destinations of the load generator. */
+static const CrFwDestSrc_t loadDest[CR_MA_LOAD_GEN_MAX_N_OF_DEST] = {CR_DA_SLAVE_1, CR_DA_SLAVE_2};
+
+/** The service sub-types of the commands issued by the load generator. */
+static const CrFwServSubType_t loadSubType[3] = {CR_DA_SERV_SUBTYPE_SET, CR_DA_SERV_SUBTYPE_EN,
+                                                  CR_DA_SERV_SUBTYPE_DIS};
+
+/** Flag which is set if the load-generation mode is selected. */
+static CrFwBool_t loadSelected = 0;
+
+/** The rate of the load generation in commands per second. */
+static unsigned int loadRate = CR_MA_LOAD_GEN_RATE;
+
+/** The number of destinations of the load generation. */
+static unsigned int loadNOfDest = CR_MA_LOAD_GEN_MAX_N_OF_DEST;
+
+/** The duration of the load generation in seconds. */
+static unsigned int loadDuration = CR_MA_LOAD_GEN_DURATION;
+
+/** The number of commands of the throughput mode (zero if the rate schedule is used). */
+static unsigned long loadCount = 0;
+
+/** Flag which is set when the schedule of the load generation has started. */
+static CrFwBool_t loadStarted = 0;
+
+/** The time at which the schedule of the load generation started. */
+static struct timespec loadStart;
+
+/** The number of commands whose issue has been attempted. */
+static unsigned long long nOfAttempts = 0;
+
+/** The number of commands which have been issued. */
+static unsigned long long nOfIssued = 0;
+
+/** The number of commands which could not be issued because no OutComponent was available. */
+static unsigned long long nOfAllocFail = 0;
+
+/** The number of OutComponents loaded into the OutManager when the load generation started. */
+static unsigned long long nOfLoadedStart = 0;
+
+/** The number of packets sent by the OutStreams when the load generation started. */
+static unsigned long long nOfSentStart = 0;
+
+/**
+ * Return the number of packets sent by the OutStreams of the destinations of the
+ * load generation.
+ * @return the sum of the sequence counters of the OutStreams
+ */
+static unsigned long long loadGetNOfSent();
+
+/**
+ * Return the number of OutComponents which have been loaded into the OutManagers.
+ * @return the number of OutComponents loaded into all OutManagers
+ */
+static unsigned long long loadGetNOfLoaded();
+
+/**
+ * Print the usage message of the Master Application.
+ * @param prog the name of the program
+ */
+static void loadUsage(const char* prog);
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrMaLoadGenParseArgs(int argc, char* argv[]) {
+	int opt;
+	long val;
+	char* end;
+
+	while ((opt = getopt(argc, argv, "blc:r:n:t:s:")) != -1) {
+		if (opt == 's') {
+			if (!CrMaCmdSchedLoadFile(optarg))
+				return 0;
+			continue;
+		}
+		if (opt == 'l') {
+			loadSelected = 1;
+			continue;
+		}
+		if (opt == 'b') {
+			CrMaLatencySelect();
+			continue;
+		}
+		if (opt == '?') {
+			loadUsage(argv[0]);
+			return 0;
+		}
+		val = strtol(optarg, &end, 10);
+		if ((*end != '\0') || (val <= 0)) {
+			loadUsage(argv[0]);
+			return 0;
+		}
+		if (opt == 'c') {
+			loadCount = (unsigned long)val;
+			loadSelected = 1;
+		} else if (opt == 'r')
+			loadRate = (unsigned int)val;
+		else if (opt == 'n') {
+			if (val > CR_MA_LOAD_GEN_MAX_N_OF_DEST) {
+				loadUsage(argv[0]);
+				return 0;
+			}
+			loadNOfDest = (unsigned int)val;
+		} else
+			loadDuration = (unsigned int)val;
+	}
+	if (optind < argc) {
+		loadUsage(argv[0]);
+		return 0;
+	}
+	return 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrMaLoadGenIsSelected() {
+	return loadSelected;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+unsigned long CrMaLoadGenGetPeriod() {
+	return (loadCount > 0) ? 0 : CR_MA_LOAD_GEN_PERIOD_USEC;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+unsigned int CrMaLoadGenGetNOfCycles() {
+	if (loadCount > 0)
+		return UINT_MAX;	/* the load generator stops the cycles when it has finished */
+	return (unsigned int)((loadDuration * 1000000ULL) / CR_MA_LOAD_GEN_PERIOD_USEC);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrMaLoadGenCycle() {
+	struct timespec now;
+	unsigned long long elapsed, due;
+	unsigned int dest;
+	FwSmDesc_t outCmd;
+
+	if (!loadStarted) {
+		clock_gettime(CLOCK_MONOTONIC, &loadStart);
+		CrMaOutCmpSetTempLimitSetTempLimit(TEMP_LIMIT);
+		nOfLoadedStart = loadGetNOfLoaded();
+		nOfSentStart = loadGetNOfSent();
+		loadStarted = 1;
+	}
+
+	/* Number of commands which are due by now (in the throughput mode: all of them) */
+	if (loadCount > 0)
+		due = loadCount;
+	else {
+		clock_gettime(CLOCK_MONOTONIC, &now);
+		elapsed = (unsigned long long)(now.tv_sec - loadStart.tv_sec) * 1000000000ULL + now.tv_nsec - loadStart.tv_nsec;
+		if (elapsed > loadDuration * 1000000000ULL)
+			elapsed = loadDuration * 1000000000ULL;
+		due = (elapsed * loadRate) / 1000000000ULL + 1;
+	}
+
+	while (nOfAttempts < due) {
+		dest = (unsigned int)(nOfAttempts % loadNOfDest);
+		outCmd = CrDaOutAdmitMake(CR_DA_SERV_TYPE, loadSubType[(nOfAttempts / loadNOfDest) % 3], 0, 0, loadDest[dest]);
+		if (outCmd == NULL) {
+			/* In the throughput mode, the command is issued again when an OutComponent is released */
+			if (loadCount > 0)
+				break;
+			nOfAttempts++;
+			nOfAllocFail++;
+			continue;
+		}
+		nOfAttempts++;
+		CrFwOutCmpSetDest(outCmd, loadDest[dest]);
+		CrMaLatencyLoad(outCmd);
+		nOfIssued++;
+	}
+
+	/* In the throughput mode, stop when all commands have been issued and sent */
+	if (CrMaLoadGenIsFinished())
+		CrDaCycleStop();
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrMaLoadGenIsFinished() {
+	return (loadCount > 0) && (nOfIssued == loadCount) && (CrFwOutFactoryGetNOfAllocatedOutCmp() == 0);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrMaLoadGenReport() {
+	struct timespec now;
+	double elapsed;
+	unsigned long long nOfLoaded, nOfSent;
+
+	if (!loadStarted)
+		return;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	elapsed = (double)(now.tv_sec - loadStart.tv_sec) + (now.tv_nsec - loadStart.tv_nsec) / 1e9;
+	nOfLoaded = loadGetNOfLoaded() - nOfLoadedStart;
+	nOfSent = loadGetNOfSent() - nOfSentStart;
+
+	if (loadCount > 0)
+		printf("MA: Load generation: %lu commands to %u destination(s) during %.3f s\n", loadCount, loadNOfDest,
+		       elapsed);
+	else
+		printf("MA: Load generation: %u commands/s to %u destination(s) during %.3f s\n", loadRate, loadNOfDest,
+		       elapsed);
+	printf("MA: Load generation: %llu commands issued (%.1f/s), %llu acknowledged by the transport (%.1f/s)\n",
+	       nOfIssued, nOfIssued / elapsed, nOfSent, nOfSent / elapsed);
+	printf("MA: Load generation: failures: %llu allocation, %llu load\n", nOfAllocFail, nOfIssued - nOfLoaded);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static unsigned long long loadGetNOfSent() {
+	unsigned long long nOfSent = 0;
+	unsigned int dest;
+	CrFwGroup_t group;
+	FwSmDesc_t outStream;
+
+	for (dest=0; dest<loadNOfDest; dest++) {
+		outStream = CrDaStreamMapGetOutStream(loadDest[dest]);
+		for (group=0; group<CrFwOutStreamGetNOfGroups(outStream); group++)
+			nOfSent += CrFwOutStreamGetSeqCnt(outStream, group);
+	}
+	return nOfSent;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static unsigned long long loadGetNOfLoaded() {
+	unsigned long long nOfLoaded = 0;
+	CrFwInstanceId_t i;
+
+	for (i=0; i<CR_FW_NOF_OUTMANAGER; i++)
+		nOfLoaded += CrFwOutManagerGetNOfLoadedOutCmp(CrFwOutManagerMake(i));
+	return nOfLoaded;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void loadUsage(const char* prog) {
+	printf("Usage: %s [-b] [-l] [-c count] [-r rate] [-n nOfDest] [-t duration] [-s timeline]\n", prog);
+	printf("  -b           measure the round-trip latency of the commands\n");
+	printf("  -l           generate load instead of executing the command schedule\n");
+	printf("  -c count     issue count commands as fast as possible instead of at a rate\n");
+	printf("  -r rate      commands per second (default: %d)\n", CR_MA_LOAD_GEN_RATE);
+	printf("  -n nOfDest   1 (Slave 1) or 2 (Slave 1 and Slave 2) destinations (default: %d)\n",
+	       CR_MA_LOAD_GEN_MAX_N_OF_DEST);
+	printf("  -t duration  duration in seconds (default: %d)\n", CR_MA_LOAD_GEN_DURATION);
+	printf("  -s timeline  upload the command timeline from a file (see CrMaCmdSched.h)\n");
+}
@@ -0,0 +1,117 @@
+/**
+ * @file
+ * @ingroup crDemoMaster
+ * Interface for the load generator of the Master Application of the CORDET Demo.
+ * In the load-generation mode, the Master Application does not execute its fixed
+ * command schedule.
+ * It instead issues commands to the Slave Applications at a constant rate for a given
+ * duration and reports the throughput which it has sustained.
+ * The commands cycle through the three commands of the Temperature Monitoring Service
+ * (set the temperature limit, enable and disable temperature monitoring) and through
+ * the destinations.
+ *
+ * The load-generation mode is selected on the command line of the Master Application
+ * (see <code>::CrMaLoadGenParseArgs</code>):
+ * - <code>-b</code> selects the latency benchmark (see <code>CrMaLatency.h</code>);
+ * - <code>-l</code> selects the load-generation mode;
+ * - <code>-r rate</code> sets the rate in commands per second
+ *   (default: <code>#CR_MA_LOAD_GEN_RATE</code>);
+ * - <code>-n nOfDest</code> sets the number of destinations: 1 for Slave 1 only or 2
+ *   for both Slave Applications (default: 2);
+ * - <code>-t duration</code> sets the duration in seconds
+ *   (default: <code>#CR_MA_LOAD_GEN_DURATION</code>);
+ * - <code>-c count</code> selects the throughput mode (it implies <code>-l</code>).
+ * - <code>-s timeline</code> uploads a command timeline from a file instead of the command
+ *   timeline of the demo (see <code>CrMaCmdSched.h</code>).
+ * .
+ * In the throughput mode, the load generator issues <code>count</code> commands as fast
+ * as the application can send them: the control cycles are free-running (see
+ * <code>CrDaCycle.h</code>), every cycle issues commands until the OutFactory has no
+ * more OutComponents, and the cycles are stopped when all commands have been issued and
+ * sent.
+ * The rate and duration options are then ignored.
+ * It is used by the throughput harness <code>RunThroughput.sh</code>.
+ * In the load-generation mode, the control cycles have a period of
+ * <code>#CR_MA_LOAD_GEN_PERIOD_USEC</code> and, in each cycle, the load generator
+ * issues the commands which are due at this point of the schedule.
+ *
+ * When the load generation has finished, the load generator reports:
+ * - the number and rate of the issued commands (OutComponents made and loaded);
+ * - the number and rate of the commands which have been acknowledged by the transport
+ *   (i.e. which have been sent by their OutStream as counted by the sequence counters of
+ *   the OutStreams);
+ * - the number of allocation failures (the OutFactory could not provide an OutComponent)
+ *   and of load failures (the OutManager could not accept the OutComponent).
+ * .
+ * The Slave Applications only send acknowledgement reports for the commands of the
+ * Temperature Monitoring Service if the latency benchmark is selected; otherwise, the
+ * acknowledgement by the transport is the last point at which the Master Application
+ * can observe a command.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRMA_LOADGEN_H_
+#define CRMA_LOADGEN_H_
+
+/* Include Framework Files */
+#include "CrFwConstants.h"
+/* Include Configuration Files */
+#include "CrFwUserConstants.h"
+#include "CrMaConstants.h"
+
+/**
+ * Parse the command line of the Master Application.
+ * If the arguments are not valid, a usage message is printed.
+ * @param argc the number of arguments
+ * @param argv the arguments
+ * @return 1 if the arguments are valid; 0 otherwise
+ */
+CrFwBool_t CrMaLoadGenParseArgs(int argc, char* argv[]);
+
+/**
+ * Return true if the load-generation mode has been selected on the command line.
+ * @return 1 if the load-generation mode is selected; 0 otherwise
+ */
+CrFwBool_t CrMaLoadGenIsSelected();
+
+/**
+ * Check whether the throughput mode has issued and sent all its commands.
+ * @return 1 if the throughput mode is selected and it has finished, 0 otherwise
+ */
+CrFwBool_t CrMaLoadGenIsFinished();
+
+/**
+ * Return the period of the control cycles of the load generation.
+ * @return the period in microseconds (zero in the throughput mode)
+ */
+unsigned long CrMaLoadGenGetPeriod();
+
+/**
+ * Return the number of control cycles of the load generation.
+ * @return the number of control cycles
+ */
+unsigned int CrMaLoadGenGetNOfCycles();
+
+/**
+ * Issue the commands which are due in the current control cycle.
+ * The schedule of the load generation starts with the first call to this function.
+ */
+void CrMaLoadGenCycle();
+
+/**
+ * Print the throughput and the failure counts of the load generation.
+ */
+void CrMaLoadGenReport();
+
+#endif /* CRMA_LOADGEN_H_ */
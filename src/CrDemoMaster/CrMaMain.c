@@ -17,6 +17,8 @@
  * - Sub-Type 2: Command to disable temperature monitoring
  * - Sub-Type 3: Command to set the temperature limit
  * - Sub-Type 4: Report to report a temperature limit violation
+ * - Sub-Type 5: Report to acknowledge the start of a command (only sent when the
+ *   command requests it, see <code>CrDaOutCmpAck.h</code>)
  * .
  * The logical links among the three applications are as follows:
  * - The Master Application sends commands to both Slave Applications
@@ -57,10 +59,55 @@
 #include <unistd.h>
 /* Include Master Demo Files */
 #include "CrMaConstants.h"
+#include "CrMaLoadGen.h"
+#include "CrMaLatency.h"
+#include "CrMaOutLane.h"
+#include "CrMaCmdState.h"
+#include "CrMaCmdSched.h"
+#include "CrMaTempStore.h"
+#include "CrMaInRepTempViolation.h"
 /* Include Common Demo Files */
 #include "CrDaConstants.h"
 #include "CrDaClientSocket.h"
 #include "CrDaServerSocket.h"
+#include "CrDaShm.h"
+#include "CrDaSocketProfile.h"
+#include "CrDaCycle.h"
+#include "CrDaIoThread.h"
+#include "CrDaHandshake.h"
+#include "CrDaPhase.h"
+#include "CrDaMgrPool.h"
+#include "CrDaInLoad.h"
+#include "CrDaInManagerChain.h"
+#include "CrDaInCmdBatch.h"
+#include "CrDaInCmdExpress.h"
+#include "CrDaInCmdAsync.h"
+#include "CrDaConfig.h"
+#include "CrDaSmExec.h"
+#include "CrDaSmProf.h"
+#include "CrDaFootprint.h"
+#include "CrDaSnapshot.h"
+#include "CrDaStartUp.h"
+#include "CrDaFrame.h"
+#include "CrDaThread.h"
+#include "CrDaStreamMap.h"
+#include "CrDaShutdown.h"
+#include "CrDaSim.h"
+#include "CrDaLinkStats.h"
+#include "CrDaHeartbeat.h"
+#include "CrDaLatTrace.h"
+#include "CrDaTrace.h"
+#include "CrDaLog.h"
+#include "CrDaMetrics.h"
+#include "CrDaCapture.h"
+#include "CrDaEventLog.h"
+#include "CrDaErrQueue.h"
+#include "CrDaReplay.h"
+#include "CrDaOutBacklog.h"
+#include "CrDaOutCmpPool.h"
+#include "CrDaOutAdmit.h"
+#include "CrDaOutLoadQueue.h"
+#include "CrDaInCmpPool.h"
 /* Include FW Profile files */
 #include "FwSmConstants.h"
 #include "FwSmConfig.h"
@@ -87,7 +134,104 @@
 #include "CrFwOutRegistryUserPar.h"
 #include "CrFwOutFactoryUserPar.h"
 #include "CrFwInFactoryUserPar.h"
+#include "CrFwInStreamUserPar.h"
+#include "CrFwOutStreamUserPar.h"
 #include "CrFwCmpData.h"
+#include "CrFwPcktStats.h"
+#include "CrFwPcktArena.h"
+#include "CrFwPcktPart.h"
+
+/** The InStreams for the packets from the peers (in the order of <code>#CR_FW_INSTREAM_SRC</code>). */
+static FwSmDesc_t inStream[CR_FW_NOF_INSTREAM];
+
+#if (CR_DA_IO_THREAD == 1)
+/** The transport of the I/O thread (see <code>CrDaIoThread.h</code>). */
+#if (CR_DA_REPLAY == 1)
+static const CrDaIoTransport_t ioTransport = {&CrDaReplaySetPcktAvail, &CrDaReplayPoll,
+	&CrDaReplayWait, &CrDaReplayPcktCollect, &CrDaReplayPcktHandover};
+#else
+static const CrDaIoTransport_t ioTransport = {&CrDaClientSocketSetPcktAvail, &CrDaClientSocketPoll,
+	&CrDaClientSocketWait, &CrDaClientSocketPcktCollect, &CrDaClientSocketPcktHandover};
+#endif
+#endif
+
+/**
+ * Cycle Work Function of the Master Application (see <code>CrDaCycle.h</code>).
+ * The function sends the commands which are due in the cycle, polls the
+ * transport for incoming reports, and executes the InLoader and the Managers.
+ * @param i the number of the cycle
+ */
+static void masterCycle(unsigned int i);
+
+/**
+ * Queue the command timeline of the demo in the time-tagged command scheduler (see
+ * <code>CrMaCmdSched.h</code>):
+ * - in cycles 10 and 11, the temperature limit is set in Slave 1 and in Slave 2;
+ * - temperature monitoring is enabled in Slave 1 every 12 cycles and in Slave 2 every
+ *   15 cycles;
+ * - temperature monitoring is disabled in Slave 1 every 18 cycles and in Slave 2 every
+ *   60 cycles.
+ * .
+ */
+static void masterQueueTimeline();
+
+/**
+ * Cycle Work Function of the Master Application in the load-generation mode (see
+ * <code>CrMaLoadGen.h</code>).
+ * The function issues the commands which are due according to the load generator,
+ * polls the transport for incoming reports, and executes the InLoader and the Managers.
+ * @param i the number of the cycle
+ */
+static void masterLoadCycle(unsigned int i);
+
+/**
+ * Event Work Function of the Master Application (see <code>CrDaCycle.h</code>).
+ * The function loads the packets from the InStreams, executes the Managers, and
+ * checks the application errors.
+ * It is called by the Cycle Work Function and, in the event-driven mode (see
+ * <code>#CR_DA_CYCLE_EVENT_DRIVEN</code>), whenever packets arrive between the cycles.
+ */
+static void masterProcess();
+
+/**
+ * Keep the state which must survive a restart (if the snapshot is selected) and check
+ * the application errors at the end of the processing of the incoming packets.
+ */
+static void masterCheck();
+
+/** Poll the socket (or the shared-memory transport or the I/O thread) for incoming packets. */
+static void masterPoll();
+
+#if (CR_DA_FRAME_SCHED == 1)
+/**
+ * Slot Step Function of the I/O slot (see <code>CrDaFrame.h</code>): it polls the transport.
+ * @return always 1
+ */
+static CrFwBool_t masterStepIo();
+#endif
+
+/**
+ * Slot Step Function of the InLoader slot: it loads the packets from the next InStream
+ * (with the InLoader drain, from all InStreams).
+ * @return 1 if the packets of all InStreams have been loaded; 0 otherwise
+ */
+static CrFwBool_t masterStepInLoader();
+
+/**
+ * Slot Step Function of the InManager slot: it executes the InManagers (with the manager
+ * pool, all Managers).
+ * @return always 1
+ */
+static CrFwBool_t masterStepInManager();
+
+#if (CR_DA_MGR_POOL == 0)
+/**
+ * Slot Step Function of the OutManager slot: it executes the OutManager of the next lane
+ * (the urgent lane is served first).
+ * @return 1 if the OutManagers of all lanes have been executed; 0 otherwise
+ */
+static CrFwBool_t masterStepOutManager();
+#endif
 
 /**
  * Main program for the Master Application.
@@ -95,36 +239,79 @@
  * - It checks the consistency of the configuration parameters using
  *   <code>::CrFwAuxConfigCheck</code>.
  * - It initializes and configures the InStreams and OutStreams components
- *   (note that their initialization action initializes the client socket and
- *   this must be synchronized with the initialization of the server socket
- *   in the Slave 1 Application).
+ *   (note that their initialization action initializes the client socket which
+ *   connects to the server socket of the Slave 1 Application and which retries
+ *   the connection until the Slave 1 Application has started).
  * - It initializes and configures all framework components used by the
- *   Master Application.
- * - It executes a loop and in every cycle of the loop commands may be
- *   sent to the Slave Applications and reports may be received from them.
+ *   Master Application (while the InStreams and OutStreams are initialized and
+ *   configured if the parallel start-up is selected, see <code>CrDaStartUp.h</code>).
+ * - It registers the work of a control cycle with the cycle scheduler (see
+ *   <code>CrDaCycle.h</code>) which executes the control cycles on absolute
+ *   deadlines with period <code>#CR_DA_CYCLE_PERIOD_USEC</code>; in every cycle
+ *   commands may be sent to the Slave Applications and reports may be
+ *   received from them.
  * .
- * The schedule for sending commands to the Slave Applications is as follows:
- * - In cycles which are multiples of 5, the command to set the temperature limit
- *   in Slave 1 is sent
- * - In cycles which are multiples of 6, the command to enable temperature monitoring
- *   in Slave 1 is sent
- * - In cycles which are multiples of 90, the command to disable temperature
- *   monitoring in Slave 1 is sent
+ * The commands to the Slave Applications are sent by the time-tagged command scheduler
+ * (see <code>CrMaCmdSched.h</code>) which releases them in the cycles in which they are
+ * due:
+ * - If a command timeline is uploaded with the <code>-s timeline</code> option, the
+ *   commands of the timeline are sent.
+ *   Each line of the timeline file has the form <code>cycle period command dest [limit]</code>
+ *   where <code>command</code> is <code>set</code>, <code>enable</code> or
+ *   <code>disable</code>, <code>period</code> is zero for a command which is sent once
+ *   and <code>limit</code> is the temperature limit of a <code>set</code> command (see
+ *   <code>::CrMaCmdSchedLoadFile</code>).
+ * - Otherwise, the command timeline of the demo is sent (see <code>masterQueueTimeline</code>).
  * .
  * In all control cycles, the client socket waiting for reports from the two
  * slave applications is polled through a call to <code>::CrDaClientSocketPoll</code>.
+ * If the shared-memory transport is selected (see <code>#CR_DA_SHM_TRANSPORT</code>),
+ * <code>::CrDaShmPoll</code> is called instead.
+ * The poll and the executions of the InLoader and of the Managers are timed (see
+ * <code>CrDaPhase.h</code>) and a summary of their durations is printed every
+ * <code>#CR_DA_PHASE_REPORT_PERIOD</code> cycles and at the end of the run.
+ *
+ * If the load-generation mode is selected on the command line (see
+ * <code>CrMaLoadGen.h</code>), the commands of the command scheduler are replaced by
+ * the commands of the load generator and the throughput of the load generation is printed at the end of
+ * the run.
+ *
+ * If the latency benchmark is selected on the command line (see
+ * <code>CrMaLatency.h</code>), the commands request the acknowledgement of their start
+ * from the Slave Applications and the distribution of their round-trip latencies is
+ * printed at the end of the run.
+ *
+ * At the end of the run, the packet and byte rates of the links are printed (see
+ * <code>CrDaLinkStats.h</code>).
+ * While the control cycles are executed, the messages of the application are written
+ * by a logging thread (see <code>CrDaLog.h</code>).
+ * If the binary trace is selected (see <code>#CR_DA_TRACE</code>), the error reports are
+ * written to the ring buffer of the trace and the ring buffer is written to a file at
+ * the end of the run (see <code>CrDaTrace.h</code>).
+ *
+ * At the end of the run, or when a termination signal is received, the application
+ * is shut down in an orderly way (see <code>CrDaShutdown.h</code>): its OutStreams
+ * are flushed and its framework components, OutStreams and InStreams are shut down.
+ * @param argc the number of command line arguments
+ * @param argv the command line arguments
  * @return always returns EXIT_SUCCESS
  */
-int main() {
+int main(int argc, char* argv[]) {
 	FwSmDesc_t fwCmp[CR_MA_N_OF_FW_CMP];
-	FwSmDesc_t inStreamSlave1, inStreamSlave2;
-	FwSmDesc_t outStreamSlave1, outStreamSlave2;
+	FwSmDesc_t stream[CR_FW_NOF_OUTSTREAM+CR_FW_NOF_INSTREAM];
 	CrFwConfigCheckOutcome_t configCheckOutcome;
-	FwSmDesc_t outCmd;
-	int i;
+	CrFwPcktStats_t pcktStats;
+	CrDaCycleStats_t cycleStats;
+	unsigned int nOfCycles;
+	CrFwCounterU1_t i;
+
+	/* Parse the command line */
+	if (!CrMaLoadGenParseArgs(argc, argv))
+		return EXIT_SUCCESS;
 
-	/* User warning about order in which demo applications are started */
-	printf("MA: The Slave 1 Application (Server Socket) must be started before the Master Application\n");
+	/* Load the runtime configuration which overrides the compile-time sizes and tables */
+	if (!CrDaConfigLoad("MA", CR_DA_MASTER))
+		return EXIT_SUCCESS;
 
 	/* Check consistency of configuration parameters */
 	configCheckOutcome = CrFwAuxConfigCheck();
@@ -139,47 +326,52 @@ int main() {
 			printf("Consistency check of InRepot parameters in InFactory failed\n");
 		return EXIT_SUCCESS;
 	}
+	if (!CrMaOutLaneConfigCheck()) {
+		printf("Consistency check of the OutManager lanes failed\n");
+		return EXIT_SUCCESS;
+	}
+	if (!CrFwPcktArenaConfigure()) {
+		printf("Consistency check of the packet pool parameters failed\n");
+		return EXIT_SUCCESS;
+	}
 	printf("MA: Consistency check of configuration parameters ran successfully.\n");
 
-	/* Create In- and OutStreams */
-	inStreamSlave1 = CrFwInStreamMake(0);
-	inStreamSlave2 = CrFwInStreamMake(1);
-	outStreamSlave1 = CrFwOutStreamMake(0);
-	outStreamSlave2 = CrFwOutStreamMake(1);
+	/* Shut down in an orderly way on a termination signal */
+	CrDaShutdownSetSignals();
+
+	/* The pages of the packet pool are faulted in before the first packet is received */
+	CrFwPcktArenaInit();
+
+	/* The heap allocated from now on is that of the framework components */
+	CrDaFootprintStart();
+
+	/* Create one InStream and one OutStream for each peer (see CR_MA_PEERS) */
+	for (i=0; i<CR_FW_NOF_INSTREAM; i++)
+		inStream[i] = CrFwInStreamMake(i);
+
+	/* The OutStreams are flushed and shut down before the InStreams */
+	for (i=0; i<CR_FW_NOF_OUTSTREAM; i++)
+		stream[i] = CrFwOutStreamMake(i);
+	for (i=0; i<CR_FW_NOF_INSTREAM; i++)
+		stream[CR_FW_NOF_OUTSTREAM+i] = inStream[i];
+
+	/* The streams of the packet sources and destinations are found in constant time */
+	CrDaStreamMapInit();
 
+#if (CR_DA_SHM_TRANSPORT == 0) && (CR_DA_REPLAY == 1)
+	/* Replay the packets captured by a previous run of the application */
+	CrDaReplaySetFile("CrDaCapture_MA.cap");
+#elif (CR_DA_SHM_TRANSPORT == 0)
 	/* Set port number and host name */
 	CrDaClientSocketSetPort(CR_DA_SOCKET_PORT);
 	CrDaClientSocketSetHost("localhost");
+	/* The standby server (if any) to which the connection fails over */
+	CrDaClientSocketSetStandby("localhost", CR_DA_SOCKET_STANDBY_PORT);
+	/* Small command and report packets must not wait for the Nagle algorithm */
+	CrDaSocketSetProfile(crDaSocketLowLatency);
+#endif
 
-	/* Initialize the InStreams and OutStreams */
-	CrFwCmpInit(outStreamSlave1);
-	if (!CrFwCmpIsInInitialized(outStreamSlave1))
-		return 0;
-	CrFwCmpInit(outStreamSlave2);
-	if (!CrFwCmpIsInInitialized(outStreamSlave2))
-		return 0;
-	CrFwCmpInit(inStreamSlave1);
-	if (!CrFwCmpIsInInitialized(inStreamSlave1))
-		return 0;
-	CrFwCmpInit(inStreamSlave2);
-	if (!CrFwCmpIsInInitialized(inStreamSlave2))
-		return 0;
-
-	/* Configure the InStream and OutStream */
-	CrFwCmpReset(inStreamSlave1);
-	CrFwCmpReset(inStreamSlave2);
-	CrFwCmpReset(outStreamSlave1);
-	CrFwCmpReset(outStreamSlave2);
-	if (!CrFwCmpIsInConfigured(inStreamSlave1))
-		return 0;
-	if (!CrFwCmpIsInConfigured(inStreamSlave2))
-		return 0;
-	if (!CrFwCmpIsInConfigured(outStreamSlave1))
-		return 0;
-	if (!CrFwCmpIsInConfigured(outStreamSlave2))
-		return 0;
-
-	/* Initialize and reset framework components */
+	/* Make the framework components */
 	fwCmp[0] = CrFwOutFactoryMake();
 	fwCmp[1] = CrFwInFactoryMake();
 	fwCmp[2] = CrFwInLoaderMake();
@@ -188,85 +380,396 @@ int main() {
 	fwCmp[5] = CrFwInRegistryMake();
 	fwCmp[6] = CrFwOutLoaderMake();
 	fwCmp[7] = CrFwOutRegistryMake();
-	fwCmp[8] = CrFwOutManagerMake(0);
-	for (i=0; i<CR_MA_N_OF_FW_CMP; i++) {
-		CrFwCmpInit(fwCmp[i]);
-		if (!CrFwCmpIsInInitialized(fwCmp[i]))
-			return 0;
-		CrFwCmpReset(fwCmp[i]);
-		if (!CrFwCmpIsInConfigured(fwCmp[i]))
-			return 0;
-	}
+	fwCmp[8] = CrFwOutManagerMake(CR_MA_OUT_LANE_URGENT);
+	fwCmp[9] = CrFwOutManagerMake(CR_MA_OUT_LANE_BULK);
+
+	/* Initialize and configure the InStreams and OutStreams (lane 1) while the other
+	 * framework components are initialized and configured (lane 0) */
+	for (i=0; i<CR_FW_NOF_OUTSTREAM; i++)
+		CrDaStartUpAddCmp("OutStream init", 1, crDaStartUpInit, stream[i]);
+	for (i=0; i<CR_FW_NOF_INSTREAM; i++)
+		CrDaStartUpAddCmp("InStream init", 1, crDaStartUpInit, inStream[i]);
+	for (i=0; i<CR_FW_NOF_INSTREAM; i++)
+		CrDaStartUpAddCmp("InStream reset", 1, crDaStartUpReset, inStream[i]);
+	for (i=0; i<CR_FW_NOF_OUTSTREAM; i++)
+		CrDaStartUpAddCmp("OutStream reset", 1, crDaStartUpReset, stream[i]);
+	CrDaStartUpAddCmp("OutFactory", 0, crDaStartUpInitReset, fwCmp[0]);
+	CrDaStartUpAddCmp("InFactory", 0, crDaStartUpInitReset, fwCmp[1]);
+	CrDaStartUpAddCmp("InLoader", 0, crDaStartUpInitReset, fwCmp[2]);
+	CrDaStartUpAddCmp("InManager 0", 0, crDaStartUpInitReset, fwCmp[3]);
+	CrDaStartUpAddCmp("InManager 1", 0, crDaStartUpInitReset, fwCmp[4]);
+	CrDaStartUpAddCmp("InRegistry", 0, crDaStartUpInitReset, fwCmp[5]);
+	CrDaStartUpAddCmp("OutLoader", 0, crDaStartUpInitReset, fwCmp[6]);
+	CrDaStartUpAddCmp("OutRegistry", 0, crDaStartUpInitReset, fwCmp[7]);
+	CrDaStartUpAddCmp("OutManager urgent", 0, crDaStartUpInitReset, fwCmp[8]);
+	CrDaStartUpAddCmp("OutManager bulk", 0, crDaStartUpInitReset, fwCmp[9]);
+	if (!CrDaStartUpRun())
+		return 0;
+	CrDaStartUpReport("MA");
+	if (!CrDaInManagerChainInit())
+		return 0;
+	if (!CrDaInCmdExpressInit())
+		return 0;
+	CrDaFootprintStop();
+
+	/* Resume from the state of the previous run (if the snapshot is selected) */
+	CrDaSnapshotStart("MA", CR_DA_MASTER);
+	/* Map the time-series store of the temperature violations (if its write-through is selected) */
+	CrMaTempStoreStart();
+
+#if (CR_DA_MGR_POOL == 1)
+	/* Start the worker threads of the independent managers */
+	CrDaMgrPoolStart();
+#endif
+
+	/* From now on, the log messages are written by the logging thread */
+	CrDaLogStart();
+
+	/* Sample the packet queues of the streams and serve the metrics (if selected) */
+	CrDaMetricsSetStreams(&stream[CR_FW_NOF_OUTSTREAM], CR_FW_NOF_INSTREAM, &stream[0], CR_FW_NOF_OUTSTREAM);
+	CrDaMetricsStart("MA");
+
+	/* Record the traffic of the transport (if selected) */
+	CrDaCaptureStart("MA", CR_DA_MASTER);
 
-	/* Execute control cycles */
-	for (i=1; i<100; i++) {
-		printf("MA: Starting cycle %d\n",i);
-		/* Set temperature limit in Slave 1 */
-		if (i == 10) {
-			CrMaOutCmpSetTempLimitSetTempLimit(TEMP_LIMIT);
-			outCmd = CrFwOutFactoryMakeOutCmp(CR_DA_SERV_TYPE,CR_DA_SERV_SUBTYPE_SET,0,0);
-			CrFwOutCmpSetDest(outCmd,CR_DA_SLAVE_1);
-			CrFwOutLoaderLoad(outCmd);
-			printf("MA: Sending command to set the temperature limit in Slave 1 to %d degC\n",TEMP_LIMIT);
-		}
-		/* Set temperature limit in Slave 2 */
-		if (i == 11) {
-			CrMaOutCmpSetTempLimitSetTempLimit(TEMP_LIMIT);
-			outCmd = CrFwOutFactoryMakeOutCmp(CR_DA_SERV_TYPE,CR_DA_SERV_SUBTYPE_SET,0,0);
-			CrFwOutCmpSetDest(outCmd,CR_DA_SLAVE_2);
-			CrFwOutLoaderLoad(outCmd);
-			printf("MA: Sending command to set the temperature limit in Slave 2 to %d degC\n",TEMP_LIMIT);
-		}
-		/* Enable temperature monitoring in Slave 1 in cycles which are multiples of 12 */
-		if ((i % 12) == 0) {
-			outCmd = CrFwOutFactoryMakeOutCmp(CR_DA_SERV_TYPE,CR_DA_SERV_SUBTYPE_EN,0,0);
-			CrFwOutCmpSetDest(outCmd,CR_DA_SLAVE_1);
-			CrFwOutLoaderLoad(outCmd);
-			printf("MA: Sending command to enable temperature monitoring in Slave 1\n");
-		}
-		/* Enable temperature monitoring in Slave 2 in cycles which are multiples of 15 */
-		if ((i % 15) == 0) {
-			outCmd = CrFwOutFactoryMakeOutCmp(CR_DA_SERV_TYPE,CR_DA_SERV_SUBTYPE_EN,0,0);
-			CrFwOutCmpSetDest(outCmd,CR_DA_SLAVE_2);
-			CrFwOutLoaderLoad(outCmd);
-			printf("MA: Sending command to enable temperature monitoring in Slave 2\n");
-		}
-		/* Disable temperature monitoring in Slave 1 in cycles which are multiples of 18 */
-		if ((i % 18) == 0) {
-			outCmd = CrFwOutFactoryMakeOutCmp(CR_DA_SERV_TYPE,CR_DA_SERV_SUBTYPE_DIS,0,0);
-			CrFwOutCmpSetDest(outCmd,CR_DA_SLAVE_1);
-			CrFwOutLoaderLoad(outCmd);
-			printf("MA: Sending command to disable temperature monitoring in Slave 1\n");
-		}
-		/* Disable temperature monitoring in Slave 2 in cycles which are multiples of 60 */
-		if ((i % 60) == 0) {
-			outCmd = CrFwOutFactoryMakeOutCmp(CR_DA_SERV_TYPE,CR_DA_SERV_SUBTYPE_DIS,0,0);
-			CrFwOutCmpSetDest(outCmd,CR_DA_SLAVE_2);
-			CrFwOutLoaderLoad(outCmd);
-			printf("MA: Sending command to disable temperature monitoring in Slave 2\n");
-		}
-		/* Poll socket for incoming reports */
-		CrDaClientSocketPoll();
-
-		/* Load packets from the two InStreams */
-		CrFwInLoaderSetInStream(inStreamSlave1);
-		FwSmExecute(CrFwInLoaderMake());
-		CrFwInLoaderSetInStream(inStreamSlave2);
-		FwSmExecute(CrFwInLoaderMake());
-
-		/* Execute Managers */
-		FwSmExecute(CrFwInManagerMake(1));	/* The first InManager is not used */
-		FwSmExecute(CrFwOutManagerMake(0));
-
-		/* Check application errors */
-		if (CrFwGetAppErrCode() != crNoAppErr) {
-			printf("MA: Application Error Code is set and is equal to: %d\n",CrFwGetAppErrCode());
-		}
-
-		/* Wait 1 second and then continue */
-		sleep(1);
+	/* Append the events to the persistent event log (if selected) */
+	CrDaEventLogStart("MA", CR_DA_MASTER);
+
+	/* Execute control cycles: between the cycles, the socket (or the shared-memory
+	 * transport) is serviced as incoming packets arrive and, in the event-driven mode,
+	 * the incoming packets are executed as soon as they arrive */
+	if (CrMaLoadGenIsSelected()) {
+		CrDaCycleSetPeriod(CrMaLoadGenGetPeriod());
+		CrDaCycleSetWork(&masterLoadCycle);
+		nOfCycles = CrMaLoadGenGetNOfCycles();
+	} else {
+		CrDaCycleSetPeriod(CR_DA_CYCLE_PERIOD_USEC);
+		CrDaCycleSetWork(&masterCycle);
+		/* The command timeline of the demo unless one has been uploaded (see CrMaCmdSched.h) */
+		if (CrMaCmdSchedGetNOfQueued() == 0)
+			masterQueueTimeline();
+		nOfCycles = 99;
 	}
+#if (CR_DA_SHM_TRANSPORT == 1)
+	CrDaCycleSetWait(&CrDaShmWait);
+#elif (CR_DA_IO_THREAD == 1)
+	CrDaCycleSetWait(&CrDaIoThreadWait);
+#elif (CR_DA_REPLAY == 1)
+	CrDaCycleSetWait(&CrDaReplayWait);
+#else
+	CrDaCycleSetWait(&CrDaClientSocketWait);
+#endif
+#if (CR_DA_OUT_BACKLOG == 1)
+	/* The OutStreams hand their packets over to the backlog which hands them over to the transport */
+#if (CR_DA_SHM_TRANSPORT == 1)
+	CrDaOutBacklogSetHandover(&CrDaShmPcktHandover);
+#elif (CR_DA_IO_THREAD == 1)
+	CrDaOutBacklogSetHandover(&CrDaIoThreadPcktHandover);
+#elif (CR_DA_REPLAY == 1)
+	CrDaOutBacklogSetHandover(&CrDaReplayPcktHandover);
+#else
+	CrDaOutBacklogSetHandover(&CrDaClientSocketPcktHandover);
+#endif
+#endif
+#if (CR_DA_CYCLE_EVENT_DRIVEN == 1)
+	CrDaCycleSetEvent(&masterProcess);
+#endif
+#if (CR_DA_HEARTBEAT == 1)
+	/* The heartbeats supervise the peers at the other end of the links (the server with the sockets) */
+#if (CR_DA_SHM_TRANSPORT == 1)
+	CrDaHeartbeatSetHandover(&CrDaShmPcktHandover);
+	CrDaHeartbeatAddPeer(CR_DA_SLAVE_1);
+	CrDaHeartbeatAddPeer(CR_DA_SLAVE_2);
+#elif (CR_DA_REPLAY == 0)
+#if (CR_DA_IO_THREAD == 1)
+	CrDaHeartbeatSetHandover(&CrDaIoThreadPcktHandover);
+#else
+	CrDaHeartbeatSetHandover(&CrDaClientSocketPcktHandover);
+	/* A silent server is abandoned for the standby server (the socket is owned by this thread) */
+	CrDaHeartbeatSetHandler(&CrDaClientSocketLiveness);
+#endif
+	CrDaHeartbeatAddPeer(CR_DA_SLAVE_1);
+#endif
+#endif
+#if (CR_DA_FRAME_SCHED == 1)
+	/* The slot table of the frames of the control cycles */
+	CrDaFrameAddSlot("I/O", &masterStepIo, CR_DA_FRAME_BUDGET_IO_USEC);
+	CrDaFrameAddSlot("InLoader", &masterStepInLoader, CR_DA_FRAME_BUDGET_IN_LOADER_USEC);
+	CrDaFrameAddSlot("InManager", &masterStepInManager, CR_DA_FRAME_BUDGET_IN_MANAGER_USEC);
+#if (CR_DA_MGR_POOL == 0)
+	CrDaFrameAddSlot("OutManager", &masterStepOutManager, CR_DA_FRAME_BUDGET_OUT_MANAGER_USEC);
+#endif
+#endif
+#if (CR_DA_IO_THREAD == 1)
+	/* From now on, the socket is owned by the I/O thread */
+	if (!CrDaIoThreadStart(&ioTransport))
+		return 0;
+	/* Keep the control loop on its core (the I/O thread has placed itself) */
+	CrDaThreadLockMemory();
+	CrDaThreadPlace(crDaThreadCycle);
+	CrDaCycleRun(nOfCycles);
+	CrDaShutdownFlush(stream, CR_FW_NOF_OUTSTREAM);
+	CrDaIoThreadStop();
+#else
+	/* Keep the control loop on its core (if the placement of the threads is selected) */
+	CrDaThreadLockMemory();
+	CrDaThreadPlace(crDaThreadCycle);
+	CrDaCycleRun(nOfCycles);
+	CrDaShutdownFlush(stream, CR_FW_NOF_OUTSTREAM);
+	/* Leave the simulation once the packets have been flushed (if the simulation mode is selected) */
+	CrDaSimLeave();
+#endif
+#if (CR_DA_MGR_POOL == 1)
+	CrDaMgrPoolStop();
+#endif
+	CrDaCaptureStop();
+	CrDaEventLogStop();
+	CrDaSnapshotStop();
+	CrMaTempStoreStop();
+	CrDaMetricsStop();
+	CrDaLogStop();
+	if (CrDaCycleIsStopped() && !CrMaLoadGenIsFinished())
+		printf("MA: Termination signal received, shutting down\n");
+
+	/* Report the overruns of the control cycles */
+	CrDaCycleGetStats(&cycleStats);
+	printf("MA: Control cycles: %u executed, %u overruns, %u deadlines skipped, worst overrun %lu us\n",
+	       cycleStats.nOfCycles, cycleStats.nOfOverruns, cycleStats.nOfSkipped, cycleStats.maxOverrun);
+	printf("MA: Control cycles: wake-up jitter mean %.1f us, max %.1f us over %u wake-ups\n",
+	       (cycleStats.nOfWakeUps == 0 ? 0.0 : (double)cycleStats.totJitter/cycleStats.nOfWakeUps/1000.0),
+	       cycleStats.maxJitter/1000.0, cycleStats.nOfWakeUps);
+	CrDaThreadReport("MA");
+	CrDaPhaseReport("MA");
+	CrDaFrameReport("MA");
+
+	/* Report the throughput of the load generation and the command latencies */
+	CrMaLoadGenReport();
+	CrMaLatencyReport();
+	CrMaOutLaneReport();
+	CrMaCmdStateReport();
+	CrMaCmdSchedReport();
+	CrMaTempStoreReport();
+	CrMaInRepTempStatsReport();
+	CrDaEventLogReport("MA");
+	CrDaErrQueueReport("MA");
+	CrDaLinkStatsReport("MA");
+	CrDaHandshakeReport("MA");
+	CrDaHeartbeatReport("MA");
+	CrDaLatTraceReport("MA");
+	CrDaIoThreadReport("MA");
+	CrDaOutBacklogReport("MA");
+	CrDaOutCmpPoolReport("MA");
+	CrDaOutAdmitReport("MA");
+	CrDaOutLoadQueueReport("MA");
+	CrDaInCmpPoolReport("MA");
+	CrDaInManagerChainReport("MA");
+	CrDaInCmdBatchReport("MA");
+	CrDaInCmdExpressReport("MA");
+	CrDaInCmdAsyncReport("MA");
+	CrDaSmExecReport("MA");
+	CrDaSmProfDump("MA");
+	CrDaFootprintReport("MA");
+
+	/* Shut down the framework components and then the OutStreams and InStreams (this
+	 * releases the packets which they still hold and closes the connections) */
+	CrDaShutdownCmp(fwCmp, CR_MA_N_OF_FW_CMP);
+	CrDaShutdownCmp(stream, CR_FW_NOF_OUTSTREAM+CR_FW_NOF_INSTREAM);
+
+	/* Report the usage of the packet pool */
+	CrFwPcktGetStats(&pcktStats);
+	printf("MA: Packet pool: high-water mark %d of %d, %u allocations, %u releases\n", pcktStats.highWaterMark,
+	       CR_FW_MAX_NOF_PCKTS, pcktStats.nOfMake, pcktStats.nOfRelease);
+	printf("MA: Packet pool: failed allocations (small/medium/large/illegal): %u/%u/%u/%u\n",
+	       pcktStats.nOfMakeFail[0], pcktStats.nOfMakeFail[1], pcktStats.nOfMakeFail[2], pcktStats.nOfMakeFail[3]);
+
+	/* Write the binary trace of the error reports (if the binary trace is selected) */
+	CrDaTraceDump("MA", CR_DA_MASTER);
 
 	return EXIT_SUCCESS;
 }
 
+/* ---------------------------------------------------------------------------------------------*/
+static void masterCycle(unsigned int i) {
+	CrDaMetricsSample();
+	/* Hand over the packets which the transport did not accept (if the OutStream backlog is selected) */
+	CrDaOutBacklogFlush();
+	/* Retry the requests which were deferred because no OutComponent was available */
+	CrDaOutAdmitCycle();
+	/* Restore the budgets of the OutManager lanes */
+	CrMaOutLaneCycle();
+	CR_DA_LOG(crDaLogDebug, "MA: Starting cycle %u\n",i);
+	/* Send the commands which are due in this cycle */
+	CrMaCmdSchedCycle(i);
+#if (CR_DA_FRAME_SCHED == 1)
+	/* Poll the transport and load and execute the incoming packets in the slots of the
+	 * frame, each one within its budget (see CrDaFrame.h) */
+	CrDaFrameRun();
+	masterCheck();
+#else
+	/* Poll socket (or shared-memory transport or I/O thread) for incoming reports */
+	masterPoll();
+
+	/* Load and execute the incoming packets */
+	masterProcess();
+#endif
+
+	/* Send the heartbeats which are due and check the liveness of the peers */
+	CrDaHeartbeatCycle();
+
+	/* Report where the time of the cycles goes */
+	if ((i % CR_DA_PHASE_REPORT_PERIOD) == 0)
+		CrDaPhaseReport("MA");
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void masterQueueTimeline() {
+	/* Commands which are due in the same cycle are sent in the order in which they are queued */
+	CrMaCmdSchedAdd(10, 0, CR_DA_SERV_SUBTYPE_SET, CR_DA_SLAVE_1, TEMP_LIMIT);
+	CrMaCmdSchedAdd(11, 0, CR_DA_SERV_SUBTYPE_SET, CR_DA_SLAVE_2, TEMP_LIMIT);
+	CrMaCmdSchedAdd(12, 12, CR_DA_SERV_SUBTYPE_EN, CR_DA_SLAVE_1, 0);
+	CrMaCmdSchedAdd(15, 15, CR_DA_SERV_SUBTYPE_EN, CR_DA_SLAVE_2, 0);
+	CrMaCmdSchedAdd(18, 18, CR_DA_SERV_SUBTYPE_DIS, CR_DA_SLAVE_1, 0);
+	CrMaCmdSchedAdd(60, 60, CR_DA_SERV_SUBTYPE_DIS, CR_DA_SLAVE_2, 0);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void masterLoadCycle(unsigned int i) {
+	(void)i;
+	CrDaMetricsSample();
+	/* Hand over the packets which the transport did not accept (if the OutStream backlog is selected) */
+	CrDaOutBacklogFlush();
+	/* Retry the requests which were deferred because no OutComponent was available */
+	CrDaOutAdmitCycle();
+	/* Restore the budgets of the OutManager lanes */
+	CrMaOutLaneCycle();
+	/* Issue the commands which are due */
+	CrMaLoadGenCycle();
+
+#if (CR_DA_FRAME_SCHED == 1)
+	/* Poll the transport and load and execute the incoming packets in the slots of the
+	 * frame, each one within its budget (see CrDaFrame.h) */
+	CrDaFrameRun();
+	masterCheck();
+#else
+	/* Poll socket (or shared-memory transport or I/O thread) for incoming reports */
+	masterPoll();
+
+	/* Load and execute the incoming packets */
+	masterProcess();
+#endif
+
+	/* Send the heartbeats which are due and check the liveness of the peers */
+	CrDaHeartbeatCycle();
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void masterProcess() {
+	/* Load packets from the InStreams */
+	while (!masterStepInLoader())
+		;
+	/* Execute Managers (with the manager pool, the independent ones are executed concurrently) */
+	masterStepInManager();
+#if (CR_DA_MGR_POOL == 0)
+	while (!masterStepOutManager())
+		;
+#endif
+	masterCheck();
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void masterCheck() {
+	/* Keep the state which must survive a restart (if the snapshot is selected) */
+	CrDaSnapshotTake();
+
+	/* Check application errors */
+#if (CR_DA_ERR_QUEUE == 1)
+	CrDaErrQueueMonitor("MA");
+#else
+	if (CrFwGetAppErrCode() != crNoAppErr) {
+		CR_DA_LOG(crDaLogError, "MA: Application Error Code is set and is equal to: %d\n",CrFwGetAppErrCode());
+	}
+#endif
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void masterPoll() {
+	CrDaPhaseStart(crDaPhasePoll);
+#if (CR_DA_SHM_TRANSPORT == 1)
+	CrDaShmPoll();
+#elif (CR_DA_IO_THREAD == 1)
+	CrDaIoThreadPoll();
+#elif (CR_DA_REPLAY == 1)
+	CrDaReplayPoll();
+#else
+	CrDaClientSocketPoll();
+#endif
+	CrDaPhaseStop(crDaPhasePoll);
+}
+
+#if (CR_DA_FRAME_SCHED == 1)
+/* ---------------------------------------------------------------------------------------------*/
+static CrFwBool_t masterStepIo() {
+	masterPoll();
+	return 1;
+}
+#endif
+
+/* ---------------------------------------------------------------------------------------------*/
+static CrFwBool_t masterStepInLoader() {
+#if (CR_DA_IN_LOAD_DRAIN == 1)
+	CrDaPhaseStart(crDaPhaseInLoader);
+	CrDaInLoadAll();
+	CrDaPhaseStop(crDaPhaseInLoader);
+#else
+	static CrFwCounterU1_t next = 0;
+
+	CrDaPhaseStart(crDaPhaseInLoader);
+	CrDaSmExecInLoader(inStream[next]);
+	CrDaInCmdExpressHandOff();
+	CrDaPhaseStop(crDaPhaseInLoader);
+	next++;
+	if (next < CR_FW_NOF_INSTREAM)
+		return 0;
+	next = 0;
+#endif
+
+	/* Record the peak use of the InCommand and InReport pools */
+	CrDaInCmpPoolSample();
+	return 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static CrFwBool_t masterStepInManager() {
+	CrDaPhaseStart(crDaPhaseInManager);
+#if (CR_DA_MGR_POOL == 1)
+	CrDaOutLoadQueueDrain();	/* the requests of the application threads are loaded before the OutManagers run */
+	CrDaMgrPoolExecute();
+	CrDaInManagerChainRelease();
+	CrDaInCmdExpressRelease();
+#else
+	CrDaInCmdExpressExecute();
+	CrDaInManagerChainExecute(1);	/* The first InManager is not used */
+#endif
+	CrDaInCmdBatchFlush();
+	CrDaPhaseStop(crDaPhaseInManager);
+	return 1;
+}
+
+#if (CR_DA_MGR_POOL == 0)
+/* ---------------------------------------------------------------------------------------------*/
+static CrFwBool_t masterStepOutManager() {
+	/* The lanes are numbered from the urgent one */
+	static unsigned int lane = CR_MA_OUT_LANE_URGENT;
+
+	CrDaPhaseStart(crDaPhaseOutManager);
+	if (lane == CR_MA_OUT_LANE_URGENT)
+		CrDaOutLoadQueueDrain();	/* the requests of the application threads are loaded before the first lane runs */
+	CrDaSmExecOutManager(CrFwOutManagerMake(lane));
+	CrDaPhaseStop(crDaPhaseOutManager);
+	lane++;
+	if (lane < CR_MA_OUT_N_OF_LANES)
+		return 0;
+	lane = CR_MA_OUT_LANE_URGENT;
+	return 1;
+}
+#endif
@@ -17,6 +17,7 @@
  */
 
 #include <stdlib.h>
+#include <string.h>
 /* Include configuration files */
 #include "CrFwCmpData.h"
 /* Include framework files */
@@ -28,15 +29,63 @@
 #include "BaseCmp/CrFwDummyExecProc.h"
 #include "OutFactory/CrFwOutFactory.h"
 #include "Pckt/CrFwPckt.h"
+#include "CrFwPcktPart.h"
 /* Include FW Profile files */
 #include "FwPrConfig.h"
 #include "FwPrDCreate.h"
 #include "FwSmConfig.h"
 #include "FwSmDCreate.h"
 #include "FwPrCore.h"
+/* Include Demo Application files */
+#include "CrMaOutCmpEnableDisable.h"
+#include "CrDaConstants.h"
+#include "CrDaPar.h"
+#include "CrMaCmdState.h"
+#include "CrDaOutCmpPool.h"
+
+/** The channel which is enabled or disabled */
+static unsigned short cmdChan = CR_DA_TEMP_ALL_CHANNELS;
 
 /*-----------------------------------------------------------------------------------------*/
 void CrMaOutCmpEnableDisableSerialize(FwSmDesc_t smDesc) {
 	CrFwOutCmpDefSerialize(smDesc);
 	CrFwOutCmpSetAckLevel(smDesc, 0, 1, 0, 0);
+	CrDaParChanSetChan(CrFwOutCmpGetParStart(smDesc), cmdChan);
+	CrMaCmdStateSent(smDesc);
+}
+
+/*-----------------------------------------------------------------------------------------*/
+void CrMaOutCmpEnableDisableSetChan(unsigned short chan) {
+	cmdChan = chan;
+}
+
+/*-----------------------------------------------------------------------------------------*/
+void CrMaOutCmpEnableDisableMaskSerialize(FwSmDesc_t smDesc) {
+	CrFwOutCmpDefSerialize(smDesc);
+	CrFwOutCmpSetAckLevel(smDesc, 0, 1, 0, 0);
+	CrMaCmdStateSent(smDesc);
+}
+
+/*-----------------------------------------------------------------------------------------*/
+FwSmDesc_t CrMaOutCmpEnableDisableMakeMask(CrFwDestSrc_t dest, CrFwBool_t isEnabled, unsigned short first,
+        unsigned short n, const unsigned char* mask) {
+	FwSmDesc_t outCmd;
+	char* pcktPar;
+
+	if (n > CR_DA_TEMP_N_OF_CHANNELS)
+		return NULL;
+	CrFwPcktSetMakePart(CrFwPcktGetOutStreamPart(dest));
+	outCmd = CrDaOutCmpPoolMake(CR_DA_SERV_TYPE,(isEnabled ? CR_DA_SERV_SUBTYPE_EN_MASK : CR_DA_SERV_SUBTYPE_DIS_MASK),0,0);
+	CrFwPcktSetMakePart(CR_FW_PCKT_PART_SHARED);
+	if (outCmd == NULL)
+		return NULL;
+
+	pcktPar = CrFwOutCmpGetParStart(outCmd);
+	CrDaParChanMaskSetFirst(pcktPar, first);
+	CrDaParChanMaskSetN(pcktPar, n);
+	CrDaParChanMaskSetIsMasked(pcktPar, (mask != NULL));
+	if (mask != NULL)
+		memcpy(pcktPar + CR_DA_PAR_LENGTH(ChanMask), mask, (n+7)/8);
+	CrFwOutCmpSetDest(outCmd, dest);
+	return outCmd;
 }
@@ -16,11 +16,18 @@
  * - Ready Check Operation: the default Ready Check Operation of
  *   <code>CrFwSmCheckAlwaysTrue.h</code> is used.
  * - Serialize Operation: this operation calls the default Serialize Operation of
- *   <code>CrFwOutCmpDefSerialize.h</code> and then it sets
- *   the command destination (either Slave 1 or Slave 2) and it sets the acknowledge
+ *   <code>CrFwOutCmpDefSerialize.h</code> and then it writes the channel which is
+ *   enabled or disabled in the parameter part of the command packet; it sets
+ *   the command destination (either Slave 1 or Slave 2); and it sets the acknowledge
  *   level to acknowledge execution start.
  * .
  *
+ * The Bulk Enable and Bulk Disable Temperature Monitoring commands enable or disable a
+ * range of channels with one packet, either the whole range or the channels of the range
+ * whose bit is set in a mask: their parameters are written when the command is made by
+ * <code>::CrMaOutCmpEnableDisableMakeMask</code> and their Serialize Operation only writes
+ * the header and the acknowledge level.
+ *
  * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
  * @author Alessandro Pasetti <pasetti@pnp-software.com>
  * @copyright P&P Software GmbH, 2013, All Rights Reserved
@@ -39,6 +46,8 @@
 
 /* Include framework components */
 #include "CrFwConstants.h"
+/* Include configuration files */
+#include "CrFwUserConstants.h"
 /* Include FW Profile components */
 #include "FwSmCore.h"
 
@@ -46,14 +55,48 @@
  * Implementation of the Serialize Operation for the command to enable or disable
  * temperature monitoring.
  * This operation calls the default Serialize Operation of
- * <code>CrFwOutCmpDefSerialize.h</code> and then it sets the
- * destination (either Slave 1 or Slave 2) and it sets the acknowledge level to acknowledge
+ * <code>CrFwOutCmpDefSerialize.h</code> and then it writes the channel in the parameter
+ * part of the command packet; and it sets the acknowledge level to acknowledge
  * execution start.
- * The value of the temperature limit is set through function
- * <code>::CrMaOutCmpSetTempLimitSetTempLimit</code>.
+ * The channel is set through function <code>::CrMaOutCmpEnableDisableSetChan</code>.
  * @param smDesc the descriptor of the OutComponent state machine
  * @return the value of the Enable Flag
  */
 void CrMaOutCmpEnableDisableSerialize(FwSmDesc_t smDesc);
 
+/**
+ * Set the channel which is enabled or disabled by the next commands
+ * (<code>#CR_DA_TEMP_ALL_CHANNELS</code>, the default, selects all channels).
+ * @param chan the channel
+ */
+void CrMaOutCmpEnableDisableSetChan(unsigned short chan);
+
+/**
+ * Implementation of the Serialize Operation for the Bulk Enable and Bulk Disable
+ * Temperature Monitoring commands.
+ * This operation calls the default Serialize Operation of
+ * <code>CrFwOutCmpDefSerialize.h</code> (the parameters were written when the command
+ * was made) and it sets the acknowledge level to acknowledge execution start.
+ * @param smDesc the descriptor of the OutComponent state machine
+ */
+void CrMaOutCmpEnableDisableMaskSerialize(FwSmDesc_t smDesc);
+
+/**
+ * Make a Bulk Enable or Bulk Disable Temperature Monitoring command for channels
+ * <code>first</code> to <code>first+n-1</code> of a Slave Application.
+ * If a mask is given, only the channels of the range whose bit is set in the mask are
+ * enabled or disabled (bit <code>i%8</code> of byte <code>i/8</code> of the mask is the bit
+ * of channel <code>first+i</code>); otherwise the whole range is.
+ * The command is allocated from the part of the packet pool of the OutStream of the
+ * destination and its destination is set; it must then be loaded in an OutLoader.
+ * @param dest the destination of the command
+ * @param isEnabled 1 to enable the channels; 0 to disable them
+ * @param first the first channel
+ * @param n the number of channels (at most <code>#CR_DA_TEMP_N_OF_CHANNELS</code>)
+ * @param mask the mask of the channels (<code>(n+7)/8</code> bytes) or NULL
+ * @return the command or NULL if it cannot be allocated or if <code>n</code> is too large
+ */
+FwSmDesc_t CrMaOutCmpEnableDisableMakeMask(CrFwDestSrc_t dest, CrFwBool_t isEnabled, unsigned short first,
+        unsigned short n, const unsigned char* mask);
+
 #endif /* CRMA_OUTCMP_ENABLE_DISABLE_H_ */
@@ -17,6 +17,7 @@
  */
 
 #include <stdlib.h>
+#include <string.h>
 /* Include configuration files */
 #include "CrFwCmpData.h"
 /* Include framework files */
@@ -28,6 +29,7 @@
 #include "BaseCmp/CrFwDummyExecProc.h"
 #include "OutFactory/CrFwOutFactory.h"
 #include "Pckt/CrFwPckt.h"
+#include "CrFwPcktPart.h"
 /* Include FW Profile files */
 #include "FwPrConfig.h"
 #include "FwPrDCreate.h"
@@ -36,19 +38,71 @@
 #include "FwPrCore.h"
 /* Include Demo Application files */
 #include "CrMaOutCmpSetTempLimit.h"
+#include "CrDaConstants.h"
+#include "CrDaPar.h"
+#include "CrMaCmdState.h"
+#include "CrDaOutCmpPool.h"
 
 /** The temperature limit */
 static char cmdTempLimit = 0;
 
+/** The channel whose limit is set */
+static unsigned short cmdChan = CR_DA_TEMP_ALL_CHANNELS;
+
+/** The hysteresis band */
+static char cmdHyst = CR_DA_TEMP_HYSTERESIS;
+
 /*-----------------------------------------------------------------------------------------*/
 void CrMaOutCmpSetTempLimitSerialize(FwSmDesc_t smDesc) {
 	char* pcktPar = CrFwOutCmpGetParStart(smDesc);
 	CrFwOutCmpDefSerialize(smDesc);
 	CrFwOutCmpSetAckLevel(smDesc, 0, 1, 0, 0);
-	pcktPar[0] = cmdTempLimit;
+	CrDaParLimitSetChan(pcktPar, cmdChan);
+	CrDaParLimitSetTemp(pcktPar, cmdTempLimit);
+	CrDaParLimitSetHyst(pcktPar, cmdHyst);
+	CrMaCmdStateSent(smDesc);
 }
 
 /*-----------------------------------------------------------------------------------------*/
 void CrMaOutCmpSetTempLimitSetTempLimit(char tempLimit) {
 	cmdTempLimit = tempLimit;
 }
+
+/*-----------------------------------------------------------------------------------------*/
+void CrMaOutCmpSetTempLimitSetChan(unsigned short chan) {
+	cmdChan = chan;
+}
+
+/*-----------------------------------------------------------------------------------------*/
+void CrMaOutCmpSetTempLimitSetHyst(char hyst) {
+	cmdHyst = hyst;
+}
+
+/*-----------------------------------------------------------------------------------------*/
+void CrMaOutCmpSetTempLimitBulkSerialize(FwSmDesc_t smDesc) {
+	CrFwOutCmpDefSerialize(smDesc);
+	CrFwOutCmpSetAckLevel(smDesc, 0, 1, 0, 0);
+	CrMaCmdStateSent(smDesc);
+}
+
+/*-----------------------------------------------------------------------------------------*/
+FwSmDesc_t CrMaOutCmpSetTempLimitMakeBulk(CrFwDestSrc_t dest, unsigned short first, unsigned short n,
+        const char* limit) {
+	FwSmDesc_t outCmd;
+	char* pcktPar;
+
+	if (n > CR_DA_TEMP_BULK_MAX_N)
+		return NULL;
+	CrFwPcktSetMakePart(CrFwPcktGetOutStreamPart(dest));
+	outCmd = CrDaOutCmpPoolMake(CR_DA_SERV_TYPE,CR_DA_SERV_SUBTYPE_SET_BULK,0,0);
+	CrFwPcktSetMakePart(CR_FW_PCKT_PART_SHARED);
+	if (outCmd == NULL)
+		return NULL;
+
+	pcktPar = CrFwOutCmpGetParStart(outCmd);
+	CrDaParLimitBlockSetFirst(pcktPar, first);
+	CrDaParLimitBlockSetN(pcktPar, n);
+	memcpy(pcktPar + CR_DA_PAR_LENGTH(LimitBlock), limit, n);
+	CrFwOutCmpSetDest(outCmd, dest);
+	return outCmd;
+}
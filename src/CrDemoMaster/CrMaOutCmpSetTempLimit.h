@@ -14,12 +14,19 @@
  * - Ready Check Operation: the default Ready Check Operation of
  *   <code>CrFwSmCheckAlwaysTrue.h</code> is used.
  * - Serialize Operation: this operation calls the default Serialize Operation of
- *   <code>CrFwOutCmpDefSerialize.h</code> and then it writes the temperature
- *   limit in the first byte of the parameter part of the command packet; it sets
+ *   <code>CrFwOutCmpDefSerialize.h</code> and then it writes the channel, the
+ *   temperature limit and the hysteresis band in the parameter part of the command
+ *   packet; it sets
  *   the command destination (either Slave 1 or Slave 2); and it sets the acknowledge
  *   level to acknowledge execution start.
  * .
  *
+ * The Bulk Set Temperature Limit command sets the limits of a range of channels with one
+ * packet: its parameters (the first channel, the number of channels and their limits) are
+ * written when the command is made by <code>::CrMaOutCmpSetTempLimitMakeBulk</code> and
+ * its Serialize Operation only writes the header and the acknowledge level.
+ * The whole range is acknowledged once.
+ *
  * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
  * @author Alessandro Pasetti <pasetti@pnp-software.com>
  * @copyright P&P Software GmbH, 2013, All Rights Reserved
@@ -38,17 +45,20 @@
 
 /* Include framework components */
 #include "CrFwConstants.h"
+/* Include configuration files */
+#include "CrFwUserConstants.h"
 /* Include FW Profile components */
 #include "FwSmCore.h"
 
 /**
  * Implementation of the Serialize Operation for the command setting the temperature limit.
  * This operation calls the default Serialize Operation of
- * <code>CrFwOutCmpDefSerialize.h</code> and then it writes the temperature
- * limit in the first byte of the parameter part of the command packet; and it sets the
- * acknowledge level to "acknowledge execution start".
- * The value of the temperature limit is set through function
- * <code>::CrMaOutCmpSetTempLimitSetTempLimit</code>.
+ * <code>CrFwOutCmpDefSerialize.h</code> and then it writes the channel, the temperature
+ * limit and the hysteresis band in the parameter part of the command packet; and it sets
+ * the acknowledge level to "acknowledge execution start".
+ * The values of the parameters are set through functions
+ * <code>::CrMaOutCmpSetTempLimitSetChan</code>, <code>::CrMaOutCmpSetTempLimitSetTempLimit</code>
+ * and <code>::CrMaOutCmpSetTempLimitSetHyst</code>.
  * @param smDesc the descriptor of the OutComponent state machine
  * @return the value of the Enable Flag
  */
@@ -60,4 +70,43 @@ void CrMaOutCmpSetTempLimitSerialize(FwSmDesc_t smDesc);
  */
 void CrMaOutCmpSetTempLimitSetTempLimit(char tempLimit);
 
+/**
+ * Set the channel whose limit is set by the next commands
+ * (<code>#CR_DA_TEMP_ALL_CHANNELS</code>, the default, selects all channels).
+ * @param chan the channel
+ */
+void CrMaOutCmpSetTempLimitSetChan(unsigned short chan);
+
+/**
+ * Set the hysteresis band of the next commands (default:
+ * <code>#CR_DA_TEMP_HYSTERESIS</code>): a violation of the limit ends when the
+ * temperature falls to the limit minus the hysteresis band.
+ * @param hyst the hysteresis band
+ */
+void CrMaOutCmpSetTempLimitSetHyst(char hyst);
+
+/**
+ * Implementation of the Serialize Operation for the Bulk Set Temperature Limit command.
+ * This operation calls the default Serialize Operation of
+ * <code>CrFwOutCmpDefSerialize.h</code> (the parameters were written when the command
+ * was made) and it sets the acknowledge level to "acknowledge execution start".
+ * @param smDesc the descriptor of the OutComponent state machine
+ */
+void CrMaOutCmpSetTempLimitBulkSerialize(FwSmDesc_t smDesc);
+
+/**
+ * Make a Bulk Set Temperature Limit command which sets the limits of channels
+ * <code>first</code> to <code>first+n-1</code> of a Slave Application.
+ * The hysteresis bands of the channels are not changed.
+ * The command is allocated from the part of the packet pool of the OutStream of the
+ * destination and its destination is set; it must then be loaded in an OutLoader.
+ * @param dest the destination of the command
+ * @param first the first channel
+ * @param n the number of channels (at most <code>#CR_DA_TEMP_BULK_MAX_N</code>)
+ * @param limit the limits of the channels
+ * @return the command or NULL if it cannot be allocated or if <code>n</code> is too large
+ */
+FwSmDesc_t CrMaOutCmpSetTempLimitMakeBulk(CrFwDestSrc_t dest, unsigned short first, unsigned short n,
+        const char* limit);
+
 #endif /* CRMA_OUTCMP_SET_TEMP_LIMIT_H_ */
@@ -0,0 +1,142 @@
+/**
+ * @file
+ * @ingroup crDemoMaster
+ * Implementation of the OutManager lanes of the Master Application of the CORDET Demo.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdio.h>
+#include "CrMaOutLane.h"
+#include "CrMaKindIndex.h"
+#include "CrDaConstants.h"
+/* Include configuration files */
+#include "CrFwOutFactoryUserPar.h"
+#include "CrFwOutManagerUserPar.h"
+/* Include framework files */
+#include "OutCmp/CrFwOutCmp.h"
+#include "OutManager/CrFwOutManager.h"
+
+/** The type for the lane of a kind of OutComponent. */
+typedef struct {
+	/** The service type. */
+	CrFwServType_t servType;
+	/** The service sub-type. */
+	CrFwServSubType_t servSubType;
+	/** The discriminant. */
+	CrFwDiscriminant_t discriminant;
+	/** The lane. */
+	CrFwInstanceId_t lane;
+} CrMaOutLaneKind_t;
+
+/** The lanes of the kinds of OutComponents. */
+static const CrMaOutLaneKind_t laneKind[CR_FW_OUTCMP_NKINDS] = CR_MA_OUTCMP_INIT_KIND_LANE;
+
+/** The kinds of the lane table. */
+static CrMaKindKey_t laneKey[CR_FW_OUTCMP_NKINDS];
+
+/** The kind index of the lane table. */
+static CrMaKindIndex_t laneIndex;
+
+/** Flag which is set when the kind index of the lane table has been built. */
+static CrFwBool_t laneIndexBuilt = 0;
+
+/** Flag which is set if the lane table is consistent. */
+static CrFwBool_t laneIndexValid = 0;
+
+/** The budgets of the lanes. */
+static const unsigned int laneBudget[CR_MA_OUT_N_OF_LANES] = CR_MA_OUT_LANE_BUDGET;
+
+/** The part of the budgets of the lanes which is left in the current control cycle. */
+static unsigned int laneLeft[CR_MA_OUT_N_OF_LANES] = CR_MA_OUT_LANE_BUDGET;
+
+/** The number of OutComponents which each lane has sent. */
+static unsigned long long nOfSent[CR_MA_OUT_N_OF_LANES];
+
+/** The number of times that an OutComponent of each lane was deferred to the next cycle. */
+static unsigned long long nOfDeferred[CR_MA_OUT_N_OF_LANES];
+
+#if (CR_MA_OUT_N_OF_LANES != CR_FW_NOF_OUTMANAGER)
+#error "The Master Application must have one OutManager per lane"
+#endif
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrMaOutLaneConfigCheck() {
+	unsigned int i;
+
+	for (i=0; i<CR_FW_OUTCMP_NKINDS; i++) {
+		laneKey[i].servType = laneKind[i].servType;
+		laneKey[i].servSubType = laneKind[i].servSubType;
+		laneKey[i].discriminant = laneKind[i].discriminant;
+	}
+	laneIndexValid = CrMaKindIndexBuild(&laneIndex, laneKey, CR_FW_OUTCMP_NKINDS);
+	for (i=0; laneIndexValid && (i<CR_FW_OUTCMP_NKINDS); i++)
+		if (laneKind[i].lane >= CR_MA_OUT_N_OF_LANES)
+			laneIndexValid = 0;
+	laneIndexBuilt = 1;
+	return laneIndexValid;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwInstanceId_t CrMaOutLaneGet(FwSmDesc_t outCmp) {
+	int kind;
+
+	if (!laneIndexBuilt)
+		CrMaOutLaneConfigCheck();
+	if (!laneIndexValid)
+		return CR_MA_OUT_LANE_BULK;
+	kind = CrMaKindIndexFind(&laneIndex, CrFwOutCmpGetServType(outCmp), CrFwOutCmpGetServSubType(outCmp),
+	                         CrFwOutCmpGetDiscriminant(outCmp));
+	if (kind < 0)
+		return CR_MA_OUT_LANE_BULK;
+	return laneKind[kind].lane;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+FwSmDesc_t CrMaOutLaneSelect(FwSmDesc_t outCmp) {
+	CrFwInstanceId_t lane = CrMaOutLaneGet(outCmp);
+
+	CrFwOutCmpSetGroup(outCmp, (lane == CR_MA_OUT_LANE_URGENT) ? CR_DA_PCKT_GROUP_URGENT : CR_DA_PCKT_GROUP_ROUTINE);
+	return CrFwOutManagerMake(lane);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrMaOutLaneReadyCheck(FwSmDesc_t outCmp) {
+	CrFwInstanceId_t lane = CrMaOutLaneGet(outCmp);
+
+	if (laneLeft[lane] == 0) {
+		nOfDeferred[lane]++;
+		return 0;
+	}
+	laneLeft[lane]--;
+	nOfSent[lane]++;
+	return 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrMaOutLaneCycle() {
+	unsigned int lane;
+
+	for (lane=0; lane<CR_MA_OUT_N_OF_LANES; lane++)
+		laneLeft[lane] = laneBudget[lane];
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrMaOutLaneReport() {
+	unsigned int lane;
+
+	for (lane=0; lane<CR_MA_OUT_N_OF_LANES; lane++)
+		printf("MA: OutManager lane %u (%s, budget %u per cycle): %llu commands sent, %llu deferrals\n",
+		       lane, (lane == CR_MA_OUT_LANE_URGENT) ? "urgent" : "bulk", laneBudget[lane], nOfSent[lane],
+		       nOfDeferred[lane]);
+}
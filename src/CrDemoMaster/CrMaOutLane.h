@@ -0,0 +1,106 @@
+/**
+ * @file
+ * @ingroup crDemoMaster
+ * Interface for the OutManager lanes of the Master Application of the CORDET Demo.
+ * The Master Application has one OutManager per lane (see <code>#CR_FW_NOF_OUTMANAGER</code>)
+ * and each lane has a priority class:
+ * - The urgent lane (<code>#CR_MA_OUT_LANE_URGENT</code>) holds the time-critical commands.
+ * - The bulk lane (<code>#CR_MA_OUT_LANE_BULK</code>) holds the other commands.
+ * .
+ * The lane of an OutComponent is defined by its service type and sub-type in the table
+ * <code>#CR_MA_OUTCMP_INIT_KIND_LANE</code> which extends the kind descriptor of the
+ * OutFactory (<code>#CR_FW_OUTCMP_INIT_KIND_DESC</code>).
+ * The OutLoader loads each OutComponent into the OutManager of its lane
+ * (<code>::CrMaOutLaneSelect</code> is the OutManager Selection Operation of the
+ * OutLoader) and the OutManagers are executed in the order of their lanes, so that the
+ * urgent commands are served first in every control cycle.
+ * The lane table is looked up through a kind index (see <code>CrMaKindIndex.h</code>) which
+ * is built and checked for consistency together with the framework configuration
+ * (<code>::CrMaOutLaneConfigCheck</code>).
+ *
+ * Each lane has a budget (<code>#CR_MA_OUT_LANE_BUDGET</code>): the maximum number of its
+ * OutComponents which are sent in a control cycle.
+ * The budget is enforced by the Ready Check of the OutComponents
+ * (<code>::CrMaOutLaneReadyCheck</code>): an OutComponent whose lane has exhausted its
+ * budget is not ready and it remains pending in its OutManager until the next cycle.
+ * Hence, a burst of bulk commands is spread over several cycles and the urgent commands
+ * never queue behind it in the OutStreams.
+ * The budgets are restored at the start of every control cycle by
+ * <code>::CrMaOutLaneCycle</code>.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRMA_OUTLANE_H_
+#define CRMA_OUTLANE_H_
+
+/* Include Framework Files */
+#include "CrFwConstants.h"
+/* Include Configuration Files */
+#include "CrFwUserConstants.h"
+#include "CrMaConstants.h"
+/* Include FW Profile files */
+#include "FwSmConstants.h"
+
+/**
+ * Build the kind index of the lane table and check the consistency of the lane table.
+ * The lane table is consistent if its kinds are sorted and unique and if its lanes are
+ * smaller than <code>#CR_MA_OUT_N_OF_LANES</code>.
+ * This function is called after <code>::CrFwAuxConfigCheck</code> when the Master
+ * Application starts (otherwise, it is called when the first lane is looked up).
+ * @return 1 if the lane table is consistent; 0 otherwise
+ */
+CrFwBool_t CrMaOutLaneConfigCheck();
+
+/**
+ * Return the lane of an OutComponent.
+ * The lane is looked up by the kind of the OutComponent in
+ * <code>#CR_MA_OUTCMP_INIT_KIND_LANE</code>; the OutComponents whose kind is not in the
+ * table (or whose lane table is not consistent) belong to the bulk lane.
+ * @param outCmp the OutComponent
+ * @return the lane of the OutComponent
+ */
+CrFwInstanceId_t CrMaOutLaneGet(FwSmDesc_t outCmp);
+
+/**
+ * Function implementing the OutManager Selection Operation of the OutLoader.
+ * The lane of the OutComponent also selects its group in the OutStream: the commands of
+ * the urgent lane belong to <code>#CR_DA_PCKT_GROUP_URGENT</code> and the other commands
+ * to <code>#CR_DA_PCKT_GROUP_ROUTINE</code>.
+ * @param outCmp the OutComponent to be loaded
+ * @return the OutManager of the lane of the OutComponent
+ */
+FwSmDesc_t CrMaOutLaneSelect(FwSmDesc_t outCmp);
+
+/**
+ * Function implementing the Ready Check Operation of the OutComponents.
+ * The OutComponent is ready if its lane has not yet exhausted its budget in the current
+ * control cycle; in this case, the budget of its lane is decremented.
+ * @param outCmp the OutComponent
+ * @return 1 if the OutComponent is ready; 0 otherwise
+ */
+CrFwBool_t CrMaOutLaneReadyCheck(FwSmDesc_t outCmp);
+
+/**
+ * Restore the budgets of the lanes.
+ * This function must be called at the start of every control cycle.
+ */
+void CrMaOutLaneCycle();
+
+/**
+ * Print the number of OutComponents which each lane has sent and the number of times
+ * that an OutComponent was deferred because its lane had exhausted its budget.
+ */
+void CrMaOutLaneReport();
+
+#endif /* CRMA_OUTLANE_H_ */
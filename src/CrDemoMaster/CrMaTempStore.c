@@ -0,0 +1,216 @@
+/**
+ * @file
+ * @ingroup crDemoMaster
+ * Implementation of the time-series store of the temperature violations of the Master
+ * Application.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "CrMaTempStore.h"
+#include "CrDaStreamMap.h"
+/* Include Configuration Files */
+#include "CrFwInStreamUserPar.h"
+
+#if ((CR_MA_TEMP_STORE_DEPTH & (CR_MA_TEMP_STORE_DEPTH-1)) != 0)
+#error "The depth of the time-series store must be a power of two"
+#endif
+
+/** The mask of the positions of a ring of the store. */
+#define CR_MA_TEMP_STORE_MASK (CR_MA_TEMP_STORE_DEPTH-1)
+
+/** The identifier of the store images ("CRTS"). */
+#define CR_MA_TEMP_STORE_MAGIC 0x43525453
+
+/** The ring of a slave and channel. */
+typedef struct {
+	/** The number of samples which have been appended to the ring. */
+	unsigned int nOfAppended;
+	/** The samples (sample i is at position i modulo the depth). */
+	CrMaTempSample_t sample[CR_MA_TEMP_STORE_DEPTH];
+} CrMaTempRing_t;
+
+/** The image of the store (the layout of the store file). */
+typedef struct {
+	/** The identifier of the store images (<code>#CR_MA_TEMP_STORE_MAGIC</code>). */
+	uint32_t magic;
+	/** The length of the image in bytes (images of another layout are not kept). */
+	uint32_t length;
+	/** The rings of each slave and channel. */
+	CrMaTempRing_t ring[CR_FW_NOF_INSTREAM][CR_MA_TEMP_STORE_N_OF_CHANNELS];
+} CrMaTempStoreImage_t;
+
+/** The store when it is kept in memory. */
+static CrMaTempStoreImage_t memImage;
+
+/** The store (the mapping of the store file or the store in memory). */
+static CrMaTempStoreImage_t* store = &memImage;
+
+/** The number of violations which have been appended to the store. */
+static unsigned long long nOfAppended = 0;
+
+/** The number of violations which could not be stored. */
+static unsigned long long nOfDropped = 0;
+
+/**
+ * Return the ring of a slave and channel.
+ * @param src the slave
+ * @param chan the channel
+ * @return the ring or NULL if there is no such ring
+ */
+static CrMaTempRing_t* tempStoreRing(CrFwDestSrc_t src, unsigned short chan);
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrMaTempStoreStart() {
+#if (CR_MA_TEMP_STORE_FILE == 1)
+	struct stat st;
+	void* p;
+	int fd;
+
+	if (store != &memImage)
+		return;
+	fd = open("CrMaTempStore.img", O_RDWR | O_CREAT, 0644);
+	if (fd < 0) {
+		perror("CrMaTempStoreStart, Store file opening");
+		return;
+	}
+	if ((fstat(fd, &st) < 0) || ((st.st_size != (off_t)sizeof(CrMaTempStoreImage_t)) &&
+	                             (ftruncate(fd, (off_t)sizeof(CrMaTempStoreImage_t)) < 0))) {
+		perror("CrMaTempStoreStart, Store file sizing");
+		close(fd);
+		return;
+	}
+	p = mmap(NULL, sizeof(CrMaTempStoreImage_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);	/* the mapping keeps the file open */
+	if (p == MAP_FAILED) {
+		perror("CrMaTempStoreStart, Store file mapping");
+		return;
+	}
+	store = (CrMaTempStoreImage_t*)p;
+
+	/* A file of another size has been truncated or extended and its content is not kept */
+	if ((st.st_size == (off_t)sizeof(CrMaTempStoreImage_t)) && (store->magic == CR_MA_TEMP_STORE_MAGIC) &&
+	    (store->length == sizeof(CrMaTempStoreImage_t)))
+		return;
+	memset(store, 0, sizeof(CrMaTempStoreImage_t));
+	store->magic = CR_MA_TEMP_STORE_MAGIC;
+	store->length = sizeof(CrMaTempStoreImage_t);
+#endif
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrMaTempStoreAppend(CrFwDestSrc_t src, unsigned short chan, CrFwTimeStamp_t timeStamp, CrFwSeqCnt_t seqCnt,
+                         char temp) {
+	CrMaTempRing_t* ring = tempStoreRing(src, chan);
+	CrMaTempSample_t* s;
+
+	if (ring == NULL) {
+		nOfDropped++;
+		return;
+	}
+	s = &ring->sample[ring->nOfAppended & CR_MA_TEMP_STORE_MASK];
+	s->timeStamp = timeStamp;
+	s->seqCnt = seqCnt;
+	s->temp = temp;
+	ring->nOfAppended++;
+	nOfAppended++;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+unsigned int CrMaTempStoreGetN(CrFwDestSrc_t src, unsigned short chan) {
+	CrMaTempRing_t* ring = tempStoreRing(src, chan);
+
+	if (ring == NULL)
+		return 0;
+	return (ring->nOfAppended < CR_MA_TEMP_STORE_DEPTH ? ring->nOfAppended : CR_MA_TEMP_STORE_DEPTH);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrMaTempStoreGetLatest(CrFwDestSrc_t src, unsigned short chan, CrMaTempSample_t* sample) {
+	CrMaTempRing_t* ring = tempStoreRing(src, chan);
+
+	if ((ring == NULL) || (ring->nOfAppended == 0))
+		return 0;
+	*sample = ring->sample[(ring->nOfAppended-1) & CR_MA_TEMP_STORE_MASK];
+	return 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+unsigned int CrMaTempStoreGetRange(CrFwDestSrc_t src, unsigned short chan, CrFwTimeStamp_t from,
+                                   CrFwTimeStamp_t to, CrMaTempSample_t* sample, unsigned int max) {
+	CrMaTempRing_t* ring = tempStoreRing(src, chan);
+	unsigned int first, lo, hi, mid, n = 0;
+
+	if (ring == NULL)
+		return 0;
+	first = (ring->nOfAppended < CR_MA_TEMP_STORE_DEPTH ? 0 : ring->nOfAppended - CR_MA_TEMP_STORE_DEPTH);
+
+	/* Find the first sample whose time stamp is not before the range */
+	lo = first;
+	hi = ring->nOfAppended;
+	while (lo < hi) {
+		mid = lo + (hi - lo)/2;
+		if (ring->sample[mid & CR_MA_TEMP_STORE_MASK].timeStamp < from)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+	for (; (lo < ring->nOfAppended) && (n < max); lo++) {
+		if (ring->sample[lo & CR_MA_TEMP_STORE_MASK].timeStamp > to)
+			break;
+		sample[n++] = ring->sample[lo & CR_MA_TEMP_STORE_MASK];
+	}
+	return n;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrMaTempStoreStop() {
+#if (CR_MA_TEMP_STORE_FILE == 1)
+	if (store == &memImage)
+		return;
+	msync(store, sizeof(CrMaTempStoreImage_t), MS_SYNC);
+	munmap(store, sizeof(CrMaTempStoreImage_t));
+	store = &memImage;
+#endif
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrMaTempStoreReport() {
+	unsigned int i, chan, nOfChannels = 0;
+
+	if ((nOfAppended == 0) && (nOfDropped == 0))
+		return;
+	for (i=0; i<CR_FW_NOF_INSTREAM; i++)
+		for (chan=0; chan<CR_MA_TEMP_STORE_N_OF_CHANNELS; chan++)
+			if (store->ring[i][chan].nOfAppended != 0)
+				nOfChannels++;
+	printf("MA: Time-series store: %llu violations stored, %llu not stored, %u channels with history (depth %d)%s\n",
+	       nOfAppended, nOfDropped, nOfChannels, CR_MA_TEMP_STORE_DEPTH,
+	       (store == &memImage ? "" : ", written through to CrMaTempStore.img"));
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static CrMaTempRing_t* tempStoreRing(CrFwDestSrc_t src, unsigned short chan) {
+	int i = CrDaStreamMapGetInStreamIndex(src);
+
+	if ((i < 0) || (chan >= CR_MA_TEMP_STORE_N_OF_CHANNELS))
+		return NULL;
+	return &store->ring[i][chan];
+}
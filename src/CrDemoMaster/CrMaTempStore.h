@@ -0,0 +1,125 @@
+/**
+ * @file
+ * @ingroup crDemoMaster
+ * Interface for the time-series store of the temperature violations of the Master
+ * Application of the CORDET Demo.
+ * The store keeps the most recent temperature violations which the slaves have reported
+ * so that they can be queried without scraping the log.
+ * It has one ring of <code>#CR_MA_TEMP_STORE_DEPTH</code> samples for each slave (i.e.
+ * for each InStream of the Master Application, see <code>CrDaStreamMap.h</code>) and
+ * each of the first <code>#CR_MA_TEMP_STORE_N_OF_CHANNELS</code> channels.
+ * A sample holds the time stamp, the sequence counter and the temperature of a violation.
+ *
+ * The Update Actions of the temperature violation reports append their violations to
+ * the store (<code>::CrMaTempStoreAppend</code>): an append takes a constant time and,
+ * when a ring is full, it overwrites its oldest sample.
+ * The store is statically allocated and it never allocates memory.
+ * The latest sample of a channel is returned by <code>::CrMaTempStoreGetLatest</code>
+ * and the samples of a range of time stamps by <code>::CrMaTempStoreGetRange</code>
+ * which finds the first sample of the range with a binary search (the samples of a
+ * channel are appended in the order of their time stamps).
+ *
+ * If the write-through is selected (see <code>#CR_MA_TEMP_STORE_FILE</code>), the rings
+ * are kept in the memory-mapped file <code>CrMaTempStore.img</code>: every append is
+ * then written to the file by the operating system and the history of a previous run is
+ * available again after a restart.
+ *
+ * The store is updated and queried by the thread which executes the InManagers.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRMA_TEMPSTORE_H_
+#define CRMA_TEMPSTORE_H_
+
+/* Include Framework Files */
+#include "CrFwConstants.h"
+/* Include Configuration Files */
+#include "CrFwUserConstants.h"
+#include "CrMaConstants.h"
+
+/** Type for a sample of the time-series store. */
+typedef struct {
+	/** The time stamp of the violation. */
+	CrFwTimeStamp_t timeStamp;
+	/** The sequence counter of the report which carried the violation. */
+	CrFwSeqCnt_t seqCnt;
+	/** The temperature of the violation. */
+	char temp;
+} CrMaTempSample_t;
+
+/**
+ * Start the time-series store.
+ * If the write-through is selected, the store file is mapped and, if it holds a store of
+ * the same layout, its history is kept; otherwise the store is cleared.
+ * If the file cannot be mapped, the store is kept in memory.
+ */
+void CrMaTempStoreStart();
+
+/**
+ * Append a temperature violation to the ring of its slave and channel.
+ * The violation is not stored (but it is counted) if there is no such ring.
+ * @param src the slave which reported the violation
+ * @param chan the channel of the violation
+ * @param timeStamp the time stamp of the violation
+ * @param seqCnt the sequence counter of the report which carried the violation
+ * @param temp the temperature of the violation
+ */
+void CrMaTempStoreAppend(CrFwDestSrc_t src, unsigned short chan, CrFwTimeStamp_t timeStamp, CrFwSeqCnt_t seqCnt,
+                         char temp);
+
+/**
+ * Return the number of samples which are kept for a slave and channel.
+ * @param src the slave
+ * @param chan the channel
+ * @return the number of samples (zero if there is no such ring)
+ */
+unsigned int CrMaTempStoreGetN(CrFwDestSrc_t src, unsigned short chan);
+
+/**
+ * Return the latest sample of a slave and channel.
+ * @param src the slave
+ * @param chan the channel
+ * @param sample the latest sample (output)
+ * @return 1 if a sample was returned; 0 if the ring is empty or if there is no such ring
+ */
+CrFwBool_t CrMaTempStoreGetLatest(CrFwDestSrc_t src, unsigned short chan, CrMaTempSample_t* sample);
+
+/**
+ * Return the samples of a slave and channel whose time stamps are in a range, from the
+ * oldest to the latest.
+ * @param src the slave
+ * @param chan the channel
+ * @param from the first time stamp of the range
+ * @param to the last time stamp of the range
+ * @param sample the samples (output)
+ * @param max the maximum number of samples to return
+ * @return the number of returned samples
+ */
+unsigned int CrMaTempStoreGetRange(CrFwDestSrc_t src, unsigned short chan, CrFwTimeStamp_t from,
+                                   CrFwTimeStamp_t to, CrMaTempSample_t* sample, unsigned int max);
+
+/**
+ * Stop the time-series store.
+ * If the write-through is selected, the store file is synchronized and unmapped.
+ */
+void CrMaTempStoreStop();
+
+/**
+ * Print the number of violations which have been appended to the store, the number which
+ * could not be stored and the number of channels which have a history.
+ * Nothing is printed if no violation has been appended.
+ */
+void CrMaTempStoreReport();
+
+#endif /* CRMA_TEMPSTORE_H_ */
@@ -0,0 +1,35 @@
+/**
+ * @file
+ * @ingroup crDemoMulti
+ * Header file to define constants and types for the single-process mode of the CORDET
+ * Demo.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRMU_CONSTANTS_H_
+#define CRMU_CONSTANTS_H_
+
+/** The number of demo applications which run in the process. */
+#define CR_MU_NOF_APPS 3
+
+/** The separator of the options of the demo applications on the command line. */
+#define CR_MU_OPTION_SEPARATOR "--"
+
+/**
+ * The period in milliseconds at which the main thread checks whether all demo
+ * applications have terminated while it waits for a termination signal.
+ */
+#define CR_MU_SIGNAL_POLL_MSEC 100
+
+#endif /* CRMU_CONSTANTS_H_ */
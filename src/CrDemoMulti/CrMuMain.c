@@ -0,0 +1,294 @@
+/**
+ * @file
+ * @ingroup crDemoMulti
+ * Main program for the single-process mode of the CORDET Demo.
+ * In the single-process mode, the Master, Slave 1 and Slave 2 Applications run as three
+ * threads of one process.
+ * Each thread runs the main program of its application with its own instance of the
+ * framework: the object files of each application are combined into one relocatable
+ * object in which all symbols are local except for the main program and for the function
+ * which stops the cycle scheduler of the application (see
+ * <code>CompileAndLinkMulti.sh</code>).
+ * The applications are built with the shared-memory transport (see
+ * <code>CrDaShm.h</code>) and exchange their packets through its lock-free rings: a
+ * packet from one application to another is copied into the ring between them by the
+ * Packet Hand-Over Operation of the sending OutStream and is taken out of it by the
+ * Packet Collect Operation of the receiving InStream: there is no system call unless the
+ * receiving application is waiting for packets.
+ *
+ * The command line holds the options of the three applications, separated by
+ * <code>#CR_MU_OPTION_SEPARATOR</code>:
+ * <pre>
+ *   cr_multi [Master options] [-- [Slave 1 options] [-- [Slave 2 options]]]
+ * </pre>
+ * The applications parse their options with <code>getopt</code>, whose state is shared
+ * by all threads of the process: the references to <code>getopt</code> of the
+ * applications are redirected to <code>::CrMuGetopt</code> and the applications are
+ * started one after the other, each one when the previous one has parsed its options.
+ *
+ * The termination signals (<code>SIGINT</code> and <code>SIGTERM</code>) are blocked in
+ * all threads and they are received by the main thread: on the first signal, the main
+ * thread stops the cycle schedulers of all applications (which then shut down in an
+ * orderly way as they do when they run as separate processes) and a second signal
+ * terminates the process.
+ * The main program returns when all applications have terminated.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <semaphore.h>
+/* Include Single-Process Mode Files */
+#include "CrMuConstants.h"
+
+/** The main program of the Master Application (its <code>main</code>). */
+int CrMaAppMain(int argc, char* argv[]);
+
+/** The main program of the Slave 1 Application (its <code>main</code>). */
+int CrS1AppMain(int argc, char* argv[]);
+
+/** The main program of the Slave 2 Application (its <code>main</code>). */
+int CrS2AppMain(int argc, char* argv[]);
+
+/** Stop the cycle scheduler of the Master Application (its <code>::CrDaCycleStop</code>). */
+void CrMaCycleStop();
+
+/** Stop the cycle scheduler of the Slave 1 Application (its <code>::CrDaCycleStop</code>). */
+void CrS1CycleStop();
+
+/** Stop the cycle scheduler of the Slave 2 Application (its <code>::CrDaCycleStop</code>). */
+void CrS2CycleStop();
+
+/**
+ * Parse the next option of an application.
+ * The references to <code>getopt</code> of the applications are redirected to this
+ * function: it calls <code>getopt</code> and, when the options of the calling
+ * application have been parsed, it signals the main thread that the next application
+ * can be started.
+ * @param argc the number of arguments of the application
+ * @param argv the arguments of the application
+ * @param optstring the options of the application
+ * @return the return value of <code>getopt</code>
+ */
+int CrMuGetopt(int argc, char* const argv[], const char* optstring);
+
+/** A demo application which runs in the process. */
+typedef struct {
+	/** The name of the application (e.g. "MA"). */
+	const char* name;
+	/** The main program of the application. */
+	int (*appMain)(int argc, char* argv[]);
+	/** The function which stops the cycle scheduler of the application. */
+	void (*cycleStop)();
+	/** The thread of the application. */
+	pthread_t thread;
+	/** Whether the thread of the application has been started. */
+	int isStarted;
+	/** The number of arguments of the application. */
+	int argc;
+	/** The arguments of the application (terminated by NULL). */
+	char** argv;
+	/** The return value of the main program of the application. */
+	int outcome;
+} CrMuApp_t;
+
+/** The applications in the order in which their options are given on the command line. */
+static CrMuApp_t app[CR_MU_NOF_APPS] = {
+	{"MA", &CrMaAppMain, &CrMaCycleStop, 0, 0, 0, NULL, 0},
+	{"S1", &CrS1AppMain, &CrS1CycleStop, 0, 0, 0, NULL, 0},
+	{"S2", &CrS2AppMain, &CrS2CycleStop, 0, 0, 0, NULL, 0}
+};
+
+/**
+ * The order in which the applications are started (indices into <code>app</code>): the
+ * Slave Applications are started before the Master Application which commands them.
+ */
+static const unsigned int startOrder[CR_MU_NOF_APPS] = {1, 2, 0};
+
+/** The semaphore which is posted when an application has parsed its options. */
+static sem_t argsParsed;
+
+/** Whether the application of the calling thread has parsed its options. */
+static __thread int isArgsParsed = 0;
+
+/** The number of applications which have terminated. */
+static unsigned int nOfAppsDone = 0;
+
+/**
+ * Body of the thread of an application: it runs the main program of the application.
+ * @param arg the application
+ * @return always NULL
+ */
+static void* appThreadRun(void* arg);
+
+/**
+ * Signal the main thread that the application of the calling thread has parsed its
+ * options (if this has not been signalled yet).
+ */
+static void appArgsParsed();
+
+/**
+ * Split the command line into the arguments of the applications.
+ * The first argument of each application is its name.
+ * @param argc the number of arguments of the command line
+ * @param argv the arguments of the command line
+ * @return 1 if the command line was split; 0 if there are too many option separators or
+ * if the arguments could not be allocated
+ */
+static int appSplitArgs(int argc, char* argv[]);
+
+/**
+ * Wait until all applications have terminated and stop their cycle schedulers on the
+ * first termination signal.
+ * @param sigSet the termination signals (which are blocked)
+ */
+static void appWaitDone(const sigset_t* sigSet);
+
+/* ---------------------------------------------------------------------------------------------*/
+int main(int argc, char* argv[]) {
+	sigset_t sigSet;
+	unsigned int i, k;
+	int err;
+
+	if (!appSplitArgs(argc, argv)) {
+		printf("Usage: %s [Master options] [%s [Slave 1 options] [%s [Slave 2 options]]]\n",
+		       argv[0], CR_MU_OPTION_SEPARATOR, CR_MU_OPTION_SEPARATOR);
+		return EXIT_FAILURE;
+	}
+
+	/* The termination signals are blocked in all threads and received by the main thread */
+	sigemptyset(&sigSet);
+	sigaddset(&sigSet, SIGINT);
+	sigaddset(&sigSet, SIGTERM);
+	pthread_sigmask(SIG_BLOCK, &sigSet, NULL);
+	sem_init(&argsParsed, 0, 0);
+
+	/* An application is started when the previous one has parsed its options */
+	for (k=0; k<CR_MU_NOF_APPS; k++) {
+		i = startOrder[k];
+		optind = 0;	/* the state of getopt is reinitialized for each application */
+		err = pthread_create(&app[i].thread, NULL, &appThreadRun, &app[i]);
+		if (err != 0) {
+			errno = err;
+			perror("CrMuMain, thread creation");
+			for (; k<CR_MU_NOF_APPS; k++)	/* an application which was not started is done */
+				__atomic_add_fetch(&nOfAppsDone, 1, __ATOMIC_RELEASE);
+			for (i=0; i<CR_MU_NOF_APPS; i++)
+				app[i].cycleStop();
+			break;
+		}
+		app[i].isStarted = 1;
+		printf("MU: %s started\n", app[i].name);
+		while ((sem_wait(&argsParsed) < 0) && (errno == EINTR))
+			;
+	}
+
+	appWaitDone(&sigSet);
+	for (i=0; i<CR_MU_NOF_APPS; i++) {
+		if (!app[i].isStarted)
+			continue;
+		pthread_join(app[i].thread, NULL);
+		printf("MU: %s terminated (%d)\n", app[i].name, app[i].outcome);
+	}
+	sem_destroy(&argsParsed);
+	return EXIT_SUCCESS;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+int CrMuGetopt(int argc, char* const argv[], const char* optstring) {
+	int opt = getopt(argc, argv, optstring);
+
+	if (opt == -1)
+		appArgsParsed();
+	return opt;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void* appThreadRun(void* arg) {
+	CrMuApp_t* a = (CrMuApp_t*)arg;
+
+	a->outcome = a->appMain(a->argc, a->argv);
+	appArgsParsed();	/* an application may terminate before it parses all its options */
+	__atomic_add_fetch(&nOfAppsDone, 1, __ATOMIC_RELEASE);
+	return NULL;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void appArgsParsed() {
+	if (isArgsParsed)
+		return;
+	isArgsParsed = 1;
+	sem_post(&argsParsed);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static int appSplitArgs(int argc, char* argv[]) {
+	unsigned int i = 0;
+	int first = 1, j;
+
+	for (j=1; j<=argc; j++) {
+		if ((j < argc) && (strcmp(argv[j], CR_MU_OPTION_SEPARATOR) != 0))
+			continue;
+		if (i == CR_MU_NOF_APPS)
+			return 0;
+		/* The arguments from first to j-1 are those of application i */
+		app[i].argc = j - first + 1;
+		app[i].argv = (char**)malloc((size_t)(app[i].argc + 1)*sizeof(char*));
+		if (app[i].argv == NULL)
+			return 0;
+		app[i].argv[0] = (char*)app[i].name;
+		memcpy(&app[i].argv[1], &argv[first], (size_t)(j - first)*sizeof(char*));
+		app[i].argv[app[i].argc] = NULL;
+		first = j + 1;
+		i++;
+	}
+	for (; i<CR_MU_NOF_APPS; i++) {
+		app[i].argc = 1;
+		app[i].argv = (char**)malloc(2*sizeof(char*));
+		if (app[i].argv == NULL)
+			return 0;
+		app[i].argv[0] = (char*)app[i].name;
+		app[i].argv[1] = NULL;
+	}
+	return 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void appWaitDone(const sigset_t* sigSet) {
+	struct timespec timeout;
+	unsigned int i;
+	int sig;
+
+	timeout.tv_sec = CR_MU_SIGNAL_POLL_MSEC/1000;
+	timeout.tv_nsec = (CR_MU_SIGNAL_POLL_MSEC%1000)*1000000L;
+	while (__atomic_load_n(&nOfAppsDone, __ATOMIC_ACQUIRE) < CR_MU_NOF_APPS) {
+		sig = sigtimedwait(sigSet, NULL, &timeout);
+		if (sig < 0)
+			continue;
+		printf("MU: Signal %d received, the applications are shut down\n", sig);
+		for (i=0; i<CR_MU_NOF_APPS; i++)
+			app[i].cycleStop();
+		/* A second signal terminates the process */
+		signal(SIGINT, SIG_DFL);
+		signal(SIGTERM, SIG_DFL);
+		pthread_sigmask(SIG_UNBLOCK, sigSet, NULL);
+		return;
+	}
+}
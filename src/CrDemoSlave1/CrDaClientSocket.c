@@ -18,6 +18,17 @@
 
 #include <stdlib.h>
 #include "CrDaClientSocket.h"
+#include "CrDaStreamMap.h"
+#include "CrDaLinkStats.h"
+#include "CrDaMetrics.h"
+#include "CrDaLatTrace.h"
+#include "CrDaCapture.h"
+#include "CrDaConstants.h"
+#include "CrDaRxRing.h"
+#include "CrDaTxQueue.h"
+#include "CrDaCrc.h"
+#include "CrDaHandshake.h"
+#include "CrDaSocketProfile.h"
 #include "CrFwConstants.h"
 /* Include FW Profile files */
 #include "FwSmConstants.h"
@@ -31,8 +42,11 @@
 #include "CrFwCmpData.h"
 /* Include framework files */
 #include "InStream/CrFwInStream.h"
+#include "OutStream/CrFwOutStream.h"
 #include "BaseCmp/CrFwBaseCmp.h"
 #include "Pckt/CrFwPckt.h"
+#include "CrFwPcktInline.h"
+#include "CrFwPcktPart.h"
 #include "CrFwTime.h"
 #include "CrFwRepErr.h"
 #include "UtilityFunctions/CrFwUtilityFunctions.h"
@@ -47,6 +61,51 @@
 #include <netdb.h>
 #include <fcntl.h>
 #include <errno.h>
+#include <time.h>
+#include <poll.h>
+#if (CR_DA_SOCKET_EPOLL == 1)
+#include <sys/epoll.h>
+#endif
+
+/** Type for a connection of the client socket to the server socket. */
+typedef struct {
+	/**
+	 * The file descriptor of the connection.
+	 * It is zero if the socket has not been initialized and it is -1 while the connection
+	 * is being re-established and no connection attempt is in progress.
+	 */
+	int fd;
+	/** Flag which is set when the application identifier has been announced on the connection. */
+	CrFwBool_t announced;
+	/**
+	 * The Pending Packet of the connection.
+	 * This is the packet of the packet pool into which the next complete packet has been
+	 * framed from the receive ring buffer or NULL if no complete packet is waiting to be
+	 * collected.
+	 */
+	CrFwPckt_t pendingPckt;
+	/** The receive ring buffer of the connection. */
+	CrDaRxRing_t rxRing;
+	/** The transmit queue of the connection. */
+	CrDaTxQueue_t txQueue;
+	/** The length of the trailer of the packets received on the connection (see <code>CrDaHandshake.h</code>). */
+	unsigned int trailerLength;
+#if (CR_DA_HANDSHAKE == 1)
+	/** Flag which is set when the hello of the server has been received on the connection. */
+	CrFwBool_t negotiated;
+#endif
+	/**
+	 * Flag which is set when data may be waiting to be read from the connection.
+	 * The flag is permanently set if the epoll backend is not used.
+	 * If the epoll backend is used, the flag is set when the epoll instance reports
+	 * new data on the connection and it is cleared when a read finds no further data.
+	 */
+	CrFwBool_t rxReady;
+#if (CR_DA_SOCKET_RECONNECT == 1)
+	/** Flag which is set while a non-blocking connection attempt is in progress on the connection. */
+	CrFwBool_t connPending;
+#endif
+} CrDaClientSocketConn_t;
 
 /** The port number */
 static int portno = 0;
@@ -54,23 +113,212 @@ static int portno = 0;
 /** The host name */
 static char* hostName = NULL;
 
-/** The file descriptor for the socket */
-static int sockfd = 0;
+/** The host name of the standby server (NULL if there is no standby server) */
+static char* standbyHostName = NULL;
+
+/** The port number of the standby server (zero if there is no standby server) */
+static int standbyPortno = 0;
+
+/**
+ * The connections of the socket.
+ * The packets of group g are sent on connection <code>#CR_DA_SOCKET_CONN_OF_GROUP</code>(g)
+ * (see <code>#CR_DA_SOCKET_N_OF_CONNS</code>).
+ */
+static CrDaClientSocketConn_t conn[CR_DA_SOCKET_N_OF_CONNS];
+
+/** Flag which is set while the connections are established */
+static CrFwBool_t linkUp = 0;
 
 /** The maximum size of an incoming packet */
 static int pcktMaxLength;
 
-/** The Read Buffer */
-static unsigned char* readBuffer;
+/**
+ * The number of packets which have been collected by the InStreams.
+ * The counter is used by <code>::CrDaClientSocketWait</code> to detect the arrival of packets.
+ */
+static unsigned int nOfCollected = 0;
+
+/**
+ * Signal the arrival of a packet from a source to the InStream associated to the source.
+ * This is the default Packet Available Function of the client socket.
+ * @param src the source of the packet
+ */
+static void clientSocketPcktAvail(CrFwDestSrc_t src);
+
+/** The Packet Available Function (see <code>::CrDaClientSocketSetPcktAvail</code>). */
+static void (*pcktAvail)(CrFwDestSrc_t src) = &clientSocketPcktAvail;
+
+/**
+ * Announce the application identifier of the host application to the server socket.
+ * If the capability handshake is selected, the hello of the host application is sent
+ * with the announcement (see <code>CrDaHandshake.h</code>).
+ * The announcement is only made once for each connection.
+ * If the connection is not yet established, the announcement is attempted again at
+ * the next call.
+ * @param i the index of the connection
+ * @return 1 if the announcement has been made; 0 otherwise
+ */
+static CrFwBool_t clientSocketAnnounce(int i);
+
+/**
+ * Write the transmit queue of a connection to its socket.
+ * @param i the index of the connection
+ */
+static void clientSocketFlush(int i);
+
+#if (CR_DA_SOCKET_EPOLL == 1)
+/** The epoll instance which monitors the connections */
+static int epfd = -1;
+
+/**
+ * Wait until new data arrive at the socket or until a timeout expires.
+ * If new data have arrived on a connection, its flag <code>rxReady</code> is set.
+ * @param timeout the timeout in milliseconds (zero to return immediately)
+ * @return 1 if new data have arrived, 0 if the timeout has expired, or -1 if the
+ * wait failed
+ */
+static int clientSocketWaitReady(int timeout);
+#endif
+
+/**
+ * Frame the next complete packet from a connection into its Pending Packet.
+ * The next complete packet is first searched in the receive ring buffer.
+ * If the receive ring buffer does not hold a complete packet, a non-blocking read
+ * is performed on the socket and the search is repeated.
+ * If there is already a Pending Packet, this function does nothing.
+ * @param i the index of the connection
+ */
+static void clientSocketFillBuffer(int i);
+
+/**
+ * Move the next complete packet (if any) from the receive ring buffer of a connection
+ * to a new packet of the packet pool which becomes the Pending Packet of the connection.
+ * The packet is charged to the partition of the InStream of its source.
+ * If no packet can be allocated, the packet is left in the receive ring buffer.
+ * If there is already a Pending Packet, this function does nothing.
+ * @param i the index of the connection
+ * @return 1 if there is a Pending Packet; 0 otherwise
+ */
+static CrFwBool_t clientSocketFrame(int i);
+
+#if (CR_DA_HANDSHAKE == 1)
+/**
+ * Read the hello of the server from the receive ring buffer of a connection and agree on
+ * the features of the connection (see <code>CrDaHandshake.h</code>).
+ * The hello of the server precedes the first packet which the server sends on the
+ * connection.
+ * @param i the index of the connection
+ * @return 1 if the features of the connection have been agreed; 0 if the hello has not
+ * yet arrived or if it is invalid
+ */
+static CrFwBool_t clientSocketNegotiate(int i);
+#endif
+
+/**
+ * Find the connection whose Pending Packet comes from a source.
+ * The connections of the lower groups are searched first.
+ * @param src the source
+ * @return the index of the connection or -1 if there is no such connection
+ */
+static int clientSocketFindConn(CrFwDestSrc_t src);
+
+/**
+ * Create a new non-blocking socket to which the tuning profile has been applied.
+ * @param report 1 if a profile which is only partially applied is to be reported
+ * @return the file descriptor of the socket or -1 if the socket could not be created
+ */
+static int clientSocketOpen(CrFwBool_t report);
+
+#if (CR_DA_SOCKET_RECONNECT == 1)
+/** The addresses of the primary server (index 0) and of the standby server (index 1) */
+static struct sockaddr_in servAddr[2];
+
+/** The number of servers (2 if a standby server has been set) */
+static unsigned int nOfServ = 1;
+
+/** The index of the server to which the socket is connected or is being reconnected */
+static unsigned int curServ = 0;
+
+/** The number of failed connection attempts in the current round (one attempt on each server) */
+static unsigned int nOfRoundFails = 0;
+
+/** The back-off delay in milliseconds before the next round of connection attempts */
+static unsigned int reconnectBackoff = CR_DA_SOCKET_CONNECT_BACKOFF_MSEC;
+
+/**
+ * The time at which the next connection attempt is started or, while an attempt is in
+ * progress, the time at which it is abandoned.
+ */
+static struct timespec attemptTime;
+
+/** The number of times the connection has failed */
+static unsigned int nOfLinkDowns = 0;
+
+/** The number of times the connection has been re-established on the standby server */
+static unsigned int nOfFailovers = 0;
+
+/**
+ * Close the connections after one of them has failed and prepare their re-establishment.
+ * Nothing is done if the socket is not connected.
+ * @param reason the reason of the failure (used in the message which reports it)
+ */
+static void clientSocketLinkDown(const char* reason);
+
+/**
+ * Advance the re-establishment of the connections after a failure.
+ * A connection attempt is started when it is due and an attempt in progress is completed
+ * or abandoned.
+ * Nothing is done if the socket is connected.
+ */
+static void clientSocketSupervise();
+
+/** Close the sockets of a failed connection attempt and schedule the next attempt. */
+static void clientSocketAttemptFailed();
+
+/** Complete the re-establishment of the connections. */
+static void clientSocketLinkUp();
+
+/**
+ * Set the time of the next connection attempt (or the time at which the attempt in
+ * progress is abandoned).
+ * @param msec the delay in milliseconds from the current time
+ */
+static void clientSocketSchedule(unsigned int msec);
+
+/**
+ * Resolve the address of a server.
+ * @param name the host name of the server
+ * @param port the port number of the server
+ * @param addr the location where the address is returned
+ * @return 1 if the address was resolved; 0 otherwise
+ */
+static CrFwBool_t clientSocketResolve(char* name, int port, struct sockaddr_in* addr);
+#endif
+
+/**
+ * Create a socket and connect it to the server.
+ * A new non-blocking socket is created for each connection attempt.
+ * If the server refuses the connection or cannot be reached, the attempt is repeated
+ * after a back-off delay which starts at <code>#CR_DA_SOCKET_CONNECT_BACKOFF_MSEC</code>
+ * and is doubled after each failed attempt up to <code>#CR_DA_SOCKET_CONNECT_BACKOFF_MAX_MSEC</code>.
+ * The attempts are abandoned when <code>#CR_DA_SOCKET_CONNECT_TIMEOUT_MSEC</code> milliseconds
+ * have elapsed.
+ * @param servAddr the address of the server
+ * @return the file descriptor of the connected socket or -1 if the socket could not be connected
+ */
+static int clientSocketConnect(struct sockaddr_in* servAddr);
 
 /* ---------------------------------------------------------------------------------------------*/
 void CrDaClientSocketInitAction(FwPrDesc_t prDesc) {
 	CrFwCmpData_t* streamData = (CrFwCmpData_t*)FwPrGetData(prDesc);
 	struct sockaddr_in serv_addr;
 	struct hostent* server;
-	int flags;
+	int i;
+#if (CR_DA_SOCKET_EPOLL == 1)
+	struct epoll_event ev;
+#endif
 
-	if (sockfd != 0) {	/* Check if socket is already initialized */
+	if (conn[0].fd != 0) {	/* Check if socket is already initialized */
 		if (streamData->typeId == CR_FW_INSTREAM_TYPE)
 			CrFwInStreamDefInitAction(prDesc);
 		else
@@ -78,27 +326,16 @@ void CrDaClientSocketInitAction(FwPrDesc_t prDesc) {
 		return;
 	}
 
-	/* Create the read buffer */
+	/* Create the receive ring buffers */
 	pcktMaxLength = (int)CrFwPcktGetMaxLength();
-	readBuffer = malloc(pcktMaxLength*sizeof(char));
-
-	sockfd = socket(AF_INET, SOCK_STREAM, 0);
-	if (sockfd < 0) {
-		perror("CrDaClientSocketInitAction, Socket Creation");
-		streamData->outcome = 0;
-		return;
-	}
-
-	/* Set the socket to non-blocking mode */
-	if ((flags = fcntl(sockfd, F_GETFL, 0)) < 0) {
-		perror("CrDaClientSocketInitAction, Set socket attributes");
-		streamData->outcome = 0;
-		return;
-	}
-	if (fcntl(sockfd, F_SETFL, flags | O_NONBLOCK) < 0) {
-		perror("CrDaClientSocketInitAction, Set socket attributes");
-		streamData->outcome = 0;
-		return;
+	for (i=0; i<CR_DA_SOCKET_N_OF_CONNS; i++) {
+		conn[i].pendingPckt = NULL;
+		CrDaTxQueueInit(&conn[i].txQueue);
+		if (!CrDaRxRingInit(&conn[i].rxRing, CR_DA_RX_RING_NOF_PCKTS*(pcktMaxLength+CR_DA_PCKT_CRC_LENGTH))) {
+			perror("CrDaClientSocketInitAction, Receive ring buffer creation");
+			streamData->outcome = 0;
+			return;
+		}
 	}
 
 	server = gethostbyname(hostName);
@@ -115,13 +352,55 @@ void CrDaClientSocketInitAction(FwPrDesc_t prDesc) {
 	      server->h_length);
 	serv_addr.sin_port = htons(portno);
 
-	if (connect(sockfd,(struct sockaddr*) &serv_addr,sizeof(serv_addr)) < 0) {
-		if (errno != EINPROGRESS) {
-			perror("CrDaClientSocketInitAction, Connect Socket");
+	/* The server is reachable once the first connection has been established */
+	for (i=0; i<CR_DA_SOCKET_N_OF_CONNS; i++) {
+		conn[i].fd = clientSocketConnect(&serv_addr);
+		if (conn[i].fd < 0) {
+			for (i--; i>=0; i--)
+				close(conn[i].fd);
+			for (i=0; i<CR_DA_SOCKET_N_OF_CONNS; i++)
+				conn[i].fd = 0;
 			streamData->outcome = 0;
 			return;
 		}
+		conn[i].rxReady = 1;
+		conn[i].announced = 0;
+		conn[i].trailerLength = CR_DA_PCKT_CRC_LENGTH;
+#if (CR_DA_HANDSHAKE == 1)
+		conn[i].negotiated = 0;
+#endif
 	}
+	linkUp = 1;
+#if (CR_DA_SOCKET_RECONNECT == 1)
+	servAddr[0] = serv_addr;
+	curServ = 0;
+	nOfServ = 1;
+	if ((standbyHostName != NULL) && (standbyPortno != 0) &&
+	        clientSocketResolve(standbyHostName, standbyPortno, &servAddr[1]))
+		nOfServ = 2;
+#endif
+	for (i=0; i<CR_DA_SOCKET_N_OF_CONNS; i++)
+		clientSocketAnnounce(i);
+
+#if (CR_DA_SOCKET_EPOLL == 1)
+	/* Register the connections with an edge-triggered epoll instance (EPOLLOUT signals
+	 * that a connection has become writable again after a full transmit buffer) */
+	epfd = epoll_create1(0);
+	if (epfd < 0) {
+		perror("CrDaClientSocketInitAction, epoll creation");
+		streamData->outcome = 0;
+		return;
+	}
+	for (i=0; i<CR_DA_SOCKET_N_OF_CONNS; i++) {
+		ev.events = EPOLLIN | EPOLLOUT | EPOLLET;
+		ev.data.u32 = (uint32_t)i;
+		if (epoll_ctl(epfd, EPOLL_CTL_ADD, conn[i].fd, &ev) < 0) {
+			perror("CrDaClientSocketInitAction, epoll registration");
+			streamData->outcome = 0;
+			return;
+		}
+	}
+#endif
 
 	/* Execute default initialization action for OutStream/InStream */
 	if (streamData->typeId == CR_FW_INSTREAM_TYPE)
@@ -130,27 +409,132 @@ void CrDaClientSocketInitAction(FwPrDesc_t prDesc) {
 		CrFwOutStreamDefInitAction(prDesc);
 }
 
+/* ---------------------------------------------------------------------------------------------*/
+static int clientSocketConnect(struct sockaddr_in* servAddr) {
+	struct timespec start, now, delay;
+	struct pollfd pfd;
+	unsigned int backoff = CR_DA_SOCKET_CONNECT_BACKOFF_MSEC;
+	long elapsed;
+	int fd, err;
+	socklen_t len;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (;;) {
+		fd = clientSocketOpen(backoff == CR_DA_SOCKET_CONNECT_BACKOFF_MSEC);
+		if (fd < 0)
+			return -1;
+
+		/* A connection which is in progress is waited for until the timeout expires */
+		err = 0;
+		if (connect(fd, (struct sockaddr*)servAddr, sizeof(*servAddr)) < 0) {
+			err = errno;
+			if (err == EINPROGRESS) {
+				clock_gettime(CLOCK_MONOTONIC, &now);
+				elapsed = (now.tv_sec - start.tv_sec)*1000L + (now.tv_nsec - start.tv_nsec)/1000000L;
+				pfd.fd = fd;
+				pfd.events = POLLOUT;
+				len = sizeof(err);
+				if (poll(&pfd, 1, (int)(CR_DA_SOCKET_CONNECT_TIMEOUT_MSEC - elapsed)) > 0)
+					getsockopt(fd, SOL_SOCKET, SO_ERROR, &err, &len);
+				else
+					err = ETIMEDOUT;
+			}
+		}
+		if (err == 0)
+			return fd;
+		close(fd);
+
+		/* Only a server which is not (yet) reachable is retried */
+		clock_gettime(CLOCK_MONOTONIC, &now);
+		elapsed = (now.tv_sec - start.tv_sec)*1000L + (now.tv_nsec - start.tv_nsec)/1000000L;
+		if (((err != ECONNREFUSED) && (err != ETIMEDOUT) && (err != EHOSTUNREACH) && (err != ENETUNREACH)) ||
+		        (elapsed + (long)backoff > CR_DA_SOCKET_CONNECT_TIMEOUT_MSEC)) {
+			errno = err;
+			perror("CrDaClientSocketInitAction, Connect Socket");
+			return -1;
+		}
+		if (backoff == CR_DA_SOCKET_CONNECT_BACKOFF_MSEC)
+			printf("CrDaClientSocketInitAction: server not reachable, retrying for up to %d ms\n",
+			       CR_DA_SOCKET_CONNECT_TIMEOUT_MSEC);
+		delay.tv_sec = (time_t)(backoff/1000);
+		delay.tv_nsec = (long)(backoff%1000)*1000000L;
+		while ((nanosleep(&delay, &delay) < 0) && (errno == EINTR))
+			;
+		backoff = 2*backoff;
+		if (backoff > CR_DA_SOCKET_CONNECT_BACKOFF_MAX_MSEC)
+			backoff = CR_DA_SOCKET_CONNECT_BACKOFF_MAX_MSEC;
+	}
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static int clientSocketOpen(CrFwBool_t report) {
+	CrDaSocketTuning_t tuning;
+	int fd, flags;
+
+	fd = socket(AF_INET, SOCK_STREAM, 0);
+	if (fd < 0) {
+		perror("CrDaClientSocketInitAction, Socket Creation");
+		return -1;
+	}
+
+	/* Apply the tuning profile before connecting so that the buffer sizes are negotiated */
+	if (!CrDaSocketApplyProfile(fd, &tuning) && report)
+		printf("CrDaClientSocketInitAction: socket profile %d partially applied (nodelay=%d, sndbuf=%d, rcvbuf=%d, busypoll=%d)\n",
+		       tuning.profile, tuning.noDelay, tuning.sndBuf, tuning.rcvBuf, tuning.busyPoll);
+
+	/* Set the socket to non-blocking mode */
+	if (((flags = fcntl(fd, F_GETFL, 0)) < 0) || (fcntl(fd, F_SETFL, flags | O_NONBLOCK) < 0)) {
+		perror("CrDaClientSocketInitAction, Set socket attributes");
+		close(fd);
+		return -1;
+	}
+	return fd;
+}
+
 /* ---------------------------------------------------------------------------------------------*/
 void CrDaClientSocketShutdownAction(FwSmDesc_t smDesc) {
 	CrFwCmpData_t* streamData = (CrFwCmpData_t*)FwSmGetData(smDesc);
+	int i;
 
 	if (streamData->typeId == CR_FW_INSTREAM_TYPE)
 		CrFwInStreamDefShutdownAction(smDesc);
 	else
 		CrFwOutStreamDefShutdownAction(smDesc);
 
-	if (sockfd == 0) 	/* Check if socket was already shutdown */
+	if (conn[0].fd == 0) 	/* Check if socket was already shutdown */
 		return;
-	free(readBuffer);
-	close(sockfd);
-	sockfd = 0;
+	CrDaClientSocketFlush();
+	for (i=0; i<CR_DA_SOCKET_N_OF_CONNS; i++) {
+		CrDaTxQueueClear(&conn[i].txQueue);
+		if (conn[i].pendingPckt != NULL) {
+			CrFwPcktRelease(conn[i].pendingPckt);
+			conn[i].pendingPckt = NULL;
+		}
+		CrDaRxRingFree(&conn[i].rxRing);
+		if (conn[i].fd > 0)
+			close(conn[i].fd);
+		conn[i].fd = 0;
+#if (CR_DA_SOCKET_RECONNECT == 1)
+		conn[i].connPending = 0;
+#endif
+	}
+#if (CR_DA_SOCKET_EPOLL == 1)
+	close(epfd);
+	epfd = -1;
+#endif
+	linkUp = 0;
+#if (CR_DA_SOCKET_RECONNECT == 1)
+	if (nOfLinkDowns > 0)
+		printf("CrDaClientSocketShutdownAction: the connection failed %u times (%u failovers to the standby server)\n",
+		       nOfLinkDowns, nOfFailovers);
+#endif
 }
 
 /* ---------------------------------------------------------------------------------------------*/
 void CrDaClientSocketInitCheck(FwPrDesc_t prDesc) {
 	CrFwCmpData_t* prData = (CrFwCmpData_t*)FwPrGetData(prDesc);
 
-	if (pcktMaxLength > 255) {
+	if (pcktMaxLength > CR_FW_PCKT_LENGTH_MAX) {
 		prData->outcome = 0;
 		return;
 	}
@@ -172,9 +556,18 @@ void CrDaClientSocketInitCheck(FwPrDesc_t prDesc) {
 /* ---------------------------------------------------------------------------------------------*/
 void CrDaClientSocketConfigAction(FwPrDesc_t prDesc) {
 	CrFwCmpData_t* streamData = (CrFwCmpData_t*)FwPrGetData(prDesc);
+	int i;
 
-	/* Clear Read Buffer */
-	readBuffer[0] = 0;
+	/* Clear Pending Packets and receive ring buffers */
+	for (i=0; i<CR_DA_SOCKET_N_OF_CONNS; i++) {
+		if (conn[i].pendingPckt != NULL) {
+			CrFwPcktRelease(conn[i].pendingPckt);
+			conn[i].pendingPckt = NULL;
+		}
+		CrDaRxRingClear(&conn[i].rxRing);
+		conn[i].rxReady = 1;
+		clientSocketAnnounce(i);
+	}
 
 	if (streamData->typeId == CR_FW_INSTREAM_TYPE)
 		CrFwInStreamDefConfigAction(prDesc);
@@ -188,104 +581,348 @@ void CrDaClientSocketConfigAction(FwPrDesc_t prDesc) {
 
 /* ---------------------------------------------------------------------------------------------*/
 void CrDaClientSocketPoll() {
+	int i;
+
+#if (CR_DA_SOCKET_RECONNECT == 1)
+	clientSocketSupervise();
+#endif
+#if (CR_DA_SOCKET_EPOLL == 1)
+	clientSocketWaitReady(0);
+#endif
+	for (i=0; i<CR_DA_SOCKET_N_OF_CONNS; i++) {
+		clientSocketAnnounce(i);
+		clientSocketFillBuffer(i);
+		if (conn[i].pendingPckt != NULL)
+			pcktAvail(CrFwPcktGetSrc(conn[i].pendingPckt));
+	}
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaClientSocketSetPcktAvail(void (*avail)(CrFwDestSrc_t src)) {
+	if (avail == NULL)
+		pcktAvail = &clientSocketPcktAvail;
+	else
+		pcktAvail = avail;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void clientSocketPcktAvail(CrFwDestSrc_t src) {
+	CrFwInStreamPcktAvail(CrDaStreamMapGetInStream(src));
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void clientSocketFillBuffer(int i) {
+	unsigned int nOfFree;
 	int n;
-	FwSmDesc_t inStream;
-	CrFwDestSrc_t src;
 
-	if (readBuffer[0] != 0) {
-		src = CrFwPcktGetSrc((CrFwPckt_t)readBuffer);
-		inStream = CrFwInStreamGet(src);
-		CrFwInStreamPcktAvail(inStream);
+	if (clientSocketFrame(i))
 		return;
-	}
 
-	n = read(sockfd, readBuffer, pcktMaxLength);
+	if (!conn[i].rxReady || !linkUp)	/* no new data have arrived since the last read */
+		return;
+
+	nOfFree = conn[i].rxRing.size - conn[i].rxRing.count;
+	n = CrDaRxRingFill(&conn[i].rxRing, conn[i].fd);
+#if (CR_DA_SOCKET_EPOLL == 1)
+	if ((n < (int)nOfFree) && (nOfFree > 0))	/* the socket has been drained */
+		conn[i].rxReady = 0;
+#else
+	(void)nOfFree;
+#endif
+#if (CR_DA_SOCKET_RECONNECT == 1)
+	if ((n < 0) && (nOfFree > 0) && (errno != EAGAIN) && (errno != EWOULDBLOCK) && (errno != EINTR)) {
+		clientSocketLinkDown("error reading from socket");
+		return;
+	}
+	if (n == 0) {
+		clientSocketLinkDown("connection closed by server");
+		return;
+	}
+#endif
 	if (n == -1)	/* no data are available from the socket */
 		return;
 	if (n == 0)	{
 		printf("CrDaClientSocketPoll: ERROR reading from socket\n");
 		return;
 	}
-	if (n == readBuffer[0]) {	/* a valid packet has arrived */
-		src = CrFwPcktGetSrc((CrFwPckt_t)readBuffer);
-		inStream = CrFwInStreamGet(src);
-		CrFwInStreamPcktAvail(inStream);
-		return;
-	}
-	if (n != readBuffer[0]) {
+	clientSocketFrame(i);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static CrFwBool_t clientSocketFrame(int i) {
+	unsigned char hdr[CR_FW_PCKT_HEADER_LENGTH];
+	unsigned int len;
+	CrFwPckt_t pckt;
+#if (CR_DA_PCKT_CRC == 1)
+	unsigned char crc[CR_DA_PCKT_CRC_LENGTH];
+#endif
+
+	if (conn[i].pendingPckt != NULL)
+		return 1;
+#if (CR_DA_HANDSHAKE == 1)
+	if (!conn[i].negotiated && !clientSocketNegotiate(i))
+		return 0;
+#endif
+
+	switch (CrDaRxRingPeekPckt(&conn[i].rxRing, hdr, CR_FW_PCKT_HEADER_LENGTH, (unsigned int)pcktMaxLength,
+	                           conn[i].trailerLength, &len)) {
+	case 1:		/* a valid packet has arrived */
+		break;
+	case -1:
 		printf("CrDaClientSocketPoll: invalid packet received from socket\n");
-		readBuffer[0] = 0;
-		return;
+		CrDaMetricsFramingError(CR_DA_SLAVE_1);
+		return 0;
+	default:	/* no complete packet has arrived yet */
+		return 0;
+	}
+
+	/* Frame the packet directly into the packet pool */
+	pckt = CrFwPcktMakeInPart(CrFwPcktGetInStreamPart(CrFwPcktGetSrc((CrFwPckt_t)hdr)), (CrFwPcktLength_t)len);
+	if (pckt == NULL)	/* retry when a packet becomes available */
+		return 0;
+	CrDaRxRingGet(&conn[i].rxRing, (unsigned char*)pckt, len);
+#if (CR_DA_PCKT_CRC == 1)
+	if (conn[i].trailerLength > 0) {
+		CrDaRxRingGet(&conn[i].rxRing, crc, CR_DA_PCKT_CRC_LENGTH);
+		if (!CrDaCrcCheck((unsigned char*)pckt, len, crc)) {
+			printf("CrDaClientSocketPoll: packet with invalid CRC received from socket\n");
+			CrDaMetricsCrcError(CR_DA_SLAVE_1);
+			CrFwPcktRelease(pckt);
+			return clientSocketFrame(i);	/* frame the next packet */
+		}
+	}
+#endif
+	conn[i].pendingPckt = pckt;
+	return 1;
+}
+
+#if (CR_DA_HANDSHAKE == 1)
+/* ---------------------------------------------------------------------------------------------*/
+static CrFwBool_t clientSocketNegotiate(int i) {
+	unsigned char hello[CR_DA_HANDSHAKE_LENGTH];
+	CrFwDestSrc_t peer;
+	uint32_t features;
+
+	if (conn[i].rxRing.count < CR_DA_HANDSHAKE_LENGTH)
+		return 0;
+	CrDaRxRingGet(&conn[i].rxRing, hello, CR_DA_HANDSHAKE_LENGTH);
+	if (!CrDaHandshakeAgree(hello, &peer, &features)) {
+		/* The connection carries no traffic: the server closes it */
+		printf("CrDaClientSocketPoll: handshake with the server failed on connection %d\n", i);
+		CrDaRxRingClear(&conn[i].rxRing);
+		return 0;
 	}
+
+	/* The packets which were queued before the answer of the server are sent in the agreed format */
+	CrDaTxQueueSetTrailer(&conn[i].txQueue, (features & CR_DA_HANDSHAKE_FEAT_PCKT_CRC) != 0);
+	conn[i].trailerLength = ((features & CR_DA_HANDSHAKE_FEAT_PCKT_CRC) != 0) ? CR_DA_PCKT_CRC_LENGTH : 0;
+	conn[i].negotiated = 1;
+	return 1;
+}
+#endif
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaClientSocketWait(unsigned int period) {
+	struct timespec req;
+#if (CR_DA_SOCKET_EPOLL == 1)
+	struct timespec now, end;
+	unsigned int collected = nOfCollected;
+	long timeout;
+	int n;
+#endif
+
+	CrDaClientSocketFlush();
+
+#if (CR_DA_SOCKET_EPOLL == 1)
+
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	end.tv_sec = end.tv_sec + (time_t)(period/1000);
+	end.tv_nsec = end.tv_nsec + (long)(period%1000)*1000000L;
+	if (end.tv_nsec >= 1000000000L) {
+		end.tv_sec++;
+		end.tv_nsec = end.tv_nsec - 1000000000L;
+	}
+
+	while (epfd >= 0) {
+		clock_gettime(CLOCK_MONOTONIC, &now);
+		timeout = (long)(end.tv_sec - now.tv_sec)*1000L + (end.tv_nsec - now.tv_nsec)/1000000L;
+		if (timeout <= 0)
+			return 0;
+		n = clientSocketWaitReady((int)timeout);
+		if (n > 0) {
+			CrDaClientSocketPoll();
+			CrDaClientSocketFlush();
+			if (nOfCollected != collected)
+				return 1;
+		}
+		else if (n < 0) {	/* sleep for the rest of the period */
+			period = (unsigned int)timeout;
+			break;
+		}
+	}
+#endif
+
+	req.tv_sec = (time_t)(period/1000);
+	req.tv_nsec = (long)(period%1000)*1000000L;
+	while ((nanosleep(&req, &req) < 0) && (errno == EINTR))
+		;
+	return 0;
+}
+
+#if (CR_DA_SOCKET_EPOLL == 1)
+/* ---------------------------------------------------------------------------------------------*/
+static int clientSocketWaitReady(int timeout) {
+	struct epoll_event ev[CR_DA_SOCKET_N_OF_CONNS];
+	int i, n;
+
+	n = epoll_wait(epfd, ev, CR_DA_SOCKET_N_OF_CONNS, timeout);
+	if (n < 0) {
+		if (errno == EINTR)
+			return 0;
+		perror("CrDaClientSocketPoll, epoll wait");
+		return -1;
+	}
+	for (i=0; i<n; i++)
+		if ((ev[i].events & ~EPOLLOUT) != 0)
+			conn[ev[i].data.u32].rxReady = 1;
+	return (n > 0);
+}
+#endif
+
+/* ---------------------------------------------------------------------------------------------*/
+static int clientSocketFindConn(CrFwDestSrc_t src) {
+	int i;
+
+	for (i=0; i<CR_DA_SOCKET_N_OF_CONNS; i++)
+		if ((conn[i].pendingPckt != NULL) && (CrFwPcktGetSrc(conn[i].pendingPckt) == src))
+			return i;
+	return -1;
 }
 
 /* ---------------------------------------------------------------------------------------------*/
 CrFwPckt_t CrDaClientSocketPcktCollect(CrFwDestSrc_t src) {
 	CrFwPckt_t pckt;
-	CrFwDestSrc_t pcktSrc;
-
-	if (readBuffer[0] != 0) {
-		pcktSrc = CrFwPcktGetSrc((CrFwPckt_t)readBuffer);
-		if (src == pcktSrc) {
-			pckt = CrFwPcktMake((CrFwPcktLength_t)readBuffer[0]);
-			memcpy(pckt, readBuffer, readBuffer[0]);
-			readBuffer[0] = 0;
-			return pckt;
-		} else
+	int i;
+
+	for (;;) {
+		i = clientSocketFindConn(src);
+		if (i < 0)
 			return NULL;
-	} else
-		return NULL;
+
+		pckt = conn[i].pendingPckt;
+		conn[i].pendingPckt = NULL;
+		nOfCollected++;
+		if (CrDaLinkStatsRx(pckt))
+			break;
+		/* Drop the duplicate or the heartbeat before it reaches the InStream */
+		CrFwPcktRelease(pckt);
+		clientSocketFrame(i);
+	}
+	CrDaMetricsIn(pckt);
+	CrDaCaptureRx(pckt);
+	clientSocketFrame(i);	/* prepare the next packet already received */
+	return pckt;
 }
 
 /* ---------------------------------------------------------------------------------------------*/
 CrFwBool_t CrDaClientSocketIsPcktAvail(CrFwDestSrc_t src) {
-	int n;
-	CrFwDestSrc_t pcktSrc;
+	int i;
 
-	if (readBuffer[0] != 0) {
-		return 1;
-	}
+	for (i=0; i<CR_DA_SOCKET_N_OF_CONNS; i++)
+		if (conn[i].pendingPckt != NULL)
+			return 1;
 
-	n = read(sockfd, readBuffer, pcktMaxLength);
-	if (n == -1)	/* no data are available from the socket */
-		return 0;
+#if (CR_DA_SOCKET_RX_PUSH == 0)
+	for (i=0; i<CR_DA_SOCKET_N_OF_CONNS; i++)
+		clientSocketFillBuffer(i);
+	return (clientSocketFindConn(src) >= 0);
+#else
+	(void)src;
+	return 0;	/* the socket is only read by the poll */
+#endif
+}
 
-	if (n == 0)	{
-		printf("CrDaClientSocketIsPcktAvail: ERROR reading from socket\n");
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaClientSocketPcktHandover(CrFwPckt_t pckt) {
+	int i = (int)CR_DA_SOCKET_CONN_OF_GROUP(CrFwPcktGetGroup(pckt));
+
+	CrDaLatTraceTx(pckt);
+	if (!clientSocketAnnounce(i)) {
+		CrDaMetricsHandoverFail(pckt);
 		return 0;
 	}
-	if (n == readBuffer[0]) {	/* a valid packet has arrived */
-		pcktSrc = CrFwPcktGetSrc((CrFwPckt_t)readBuffer);
-		if (src == pcktSrc)
-			return 1;
-		else
-			return 0;
-	}
 
-	if (n != readBuffer[0]) {
-		printf("CrDaClientSocketIsPcktAvail: invalid packet received from socket\n");
-		readBuffer[0] = 0;
-		return 0;
+	if (!CrDaTxQueueAdd(&conn[i].txQueue, pckt)) {
+		clientSocketFlush(i);	/* the transmit queue is full */
+		if (!CrDaTxQueueAdd(&conn[i].txQueue, pckt)) {
+			CrDaMetricsHandoverFail(pckt);
+			return 0;	/* the OutStream keeps the packet until the socket drains */
+		}
 	}
+	CrDaLinkStatsTx(pckt);
+	CrDaMetricsOut(pckt);
+	CrDaCaptureTx(pckt);
+#if (CR_DA_SOCKET_TX_BATCH == 1)
+	/* The packets of the cycle are written at its end unless they fill a write first */
+	if (CrDaTxQueueGetNOfBytes(&conn[i].txQueue) < CR_DA_TX_QUEUE_FLUSH_BYTES)
+		return 1;
+#endif
+	clientSocketFlush(i);
+	return 1;
+}
 
-	return 0;
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaClientSocketFlush() {
+	int i;
+
+	/* A connection which fails closes all connections */
+	for (i=0; (i<CR_DA_SOCKET_N_OF_CONNS) && linkUp; i++)
+		clientSocketFlush(i);
 }
 
 /* ---------------------------------------------------------------------------------------------*/
-CrFwBool_t CrDaClientSocketPcktHandover(CrFwPckt_t pckt) {
-	int len = (int)CrFwPcktGetLength(pckt);
-	int n;
+static void clientSocketFlush(int i) {
+	if (CrDaTxQueueIsEmpty(&conn[i].txQueue) || !clientSocketAnnounce(i))
+		return;
+#if (CR_DA_HANDSHAKE == 1)
+	/* The packets are sent when the format of the connection has been agreed */
+	if (!conn[i].negotiated)
+		return;
+#endif
 
-	n = write(sockfd, pckt, len);
+	if (CrDaTxQueueFlush(&conn[i].txQueue, conn[i].fd) < 0)
+		if ((errno != EAGAIN) && (errno != EWOULDBLOCK)) {
+#if (CR_DA_SOCKET_RECONNECT == 1)
+			clientSocketLinkDown("error writing to socket");
+#else
+			printf("CrDaClientSocketFlush: error writing to socket\n");
+#endif
+		}
+}
 
-	if (n < 0)
-		return 0;
+/* ---------------------------------------------------------------------------------------------*/
+static CrFwBool_t clientSocketAnnounce(int i) {
+	CrFwDestSrc_t appId = CR_FW_HOST_APP_ID;
+	char buf[sizeof(CrFwDestSrc_t)+CR_DA_SOCKET_CONN_ID_LENGTH+CR_DA_HANDSHAKE_LENGTH];
 
-	if (n != (int)CrFwPcktGetLength(pckt))  {
-		printf("CrDaClientSocketPcktHandover: error writing to socket\n");
+	if (conn[i].announced)
+		return 1;
+	if (!linkUp)	/* the connection is being re-established */
 		return 0;
-	}
 
+	/* The identifier is sent in the byte order of the packets */
+	CrFwPcktWireStore(buf, &appId, sizeof(CrFwDestSrc_t));
+#if (CR_DA_SOCKET_N_OF_CONNS > 1)
+	/* The server sends the packets of a group on the connection of the group */
+	buf[sizeof(CrFwDestSrc_t)] = (char)i;
+#endif
+#if (CR_DA_HANDSHAKE == 1)
+	CrDaHandshakeWrite((unsigned char*)buf + sizeof(CrFwDestSrc_t) + CR_DA_SOCKET_CONN_ID_LENGTH);
+#endif
+	if (write(conn[i].fd, buf, sizeof(buf)) != (ssize_t)sizeof(buf))
+		return 0;	/* the connection is not yet established */
+
+	conn[i].announced = 1;
 	return 1;
 }
 
@@ -298,3 +935,215 @@ void CrDaClientSocketSetPort(int n) {
 void CrDaClientSocketSetHost(char* name) {
 	hostName = name;
 }
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaClientSocketSetStandby(char* name, int n) {
+	standbyHostName = name;
+	standbyPortno = n;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaClientSocketLiveness(CrFwDestSrc_t peer, CrFwBool_t up) {
+	(void)peer;
+#if (CR_DA_SOCKET_RECONNECT == 1)
+	if (up || !linkUp)
+		return;
+	clientSocketLinkDown("the server is silent");
+	/* A silent server may still accept connections: the first attempt is made on the other server */
+	curServ = (curServ + 1) % nOfServ;
+#else
+	(void)up;
+#endif
+}
+
+#if (CR_DA_SOCKET_RECONNECT == 1)
+/* ---------------------------------------------------------------------------------------------*/
+static void clientSocketLinkDown(const char* reason) {
+	int i;
+
+	if (!linkUp)
+		return;
+
+	printf("CrDaClientSocketPoll: %s, reconnecting\n", reason);
+	nOfLinkDowns++;
+	linkUp = 0;
+	for (i=0; i<CR_DA_SOCKET_N_OF_CONNS; i++) {
+		conn[i].announced = 0;
+#if (CR_DA_HANDSHAKE == 1)
+		conn[i].negotiated = 0;
+#endif
+		/* Closing the socket also removes it from the epoll instance */
+		close(conn[i].fd);
+		conn[i].fd = -1;
+
+		/* The bytes of the old connection are discarded but the queued packets are kept */
+		if (conn[i].pendingPckt != NULL) {
+			CrFwPcktRelease(conn[i].pendingPckt);
+			conn[i].pendingPckt = NULL;
+		}
+		CrDaRxRingClear(&conn[i].rxRing);
+		CrDaTxQueueRewind(&conn[i].txQueue);
+	}
+
+	/* The first attempt is made at once on the same server */
+	nOfRoundFails = 0;
+	reconnectBackoff = CR_DA_SOCKET_CONNECT_BACKOFF_MSEC;
+	clientSocketSchedule(0);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void clientSocketSupervise() {
+	struct timespec now;
+	struct pollfd pfd;
+	CrFwBool_t pending = 0;
+	int i, err;
+	socklen_t len;
+
+	if (linkUp || (conn[0].fd == 0))
+		return;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	for (i=0; i<CR_DA_SOCKET_N_OF_CONNS; i++)
+		pending = pending || conn[i].connPending;
+	if (!pending) {
+		if ((now.tv_sec < attemptTime.tv_sec) ||
+		        ((now.tv_sec == attemptTime.tv_sec) && (now.tv_nsec < attemptTime.tv_nsec)))
+			return;	/* the next attempt is not yet due */
+		for (i=0; i<CR_DA_SOCKET_N_OF_CONNS; i++) {
+			conn[i].fd = clientSocketOpen(0);
+			if (conn[i].fd < 0) {
+				clientSocketAttemptFailed();
+				return;
+			}
+			if (connect(conn[i].fd, (struct sockaddr*)&servAddr[curServ], sizeof(servAddr[curServ])) == 0)
+				continue;
+			if (errno != EINPROGRESS) {
+				clientSocketAttemptFailed();
+				return;
+			}
+			conn[i].connPending = 1;
+		}
+		clientSocketSchedule(CR_DA_SOCKET_RECONNECT_ATTEMPT_MSEC);
+	}
+
+	/* Check whether the attempts in progress have completed */
+	pending = 0;
+	for (i=0; i<CR_DA_SOCKET_N_OF_CONNS; i++) {
+		if (!conn[i].connPending)
+			continue;
+		pfd.fd = conn[i].fd;
+		pfd.events = POLLOUT;
+		if (poll(&pfd, 1, 0) <= 0) {
+			pending = 1;
+			continue;
+		}
+		conn[i].connPending = 0;
+		err = 0;
+		len = sizeof(err);
+		getsockopt(conn[i].fd, SOL_SOCKET, SO_ERROR, &err, &len);
+		if (err != 0) {
+			clientSocketAttemptFailed();
+			return;
+		}
+	}
+	if (!pending) {
+		clientSocketLinkUp();
+		return;
+	}
+	if ((now.tv_sec > attemptTime.tv_sec) ||
+	        ((now.tv_sec == attemptTime.tv_sec) && (now.tv_nsec >= attemptTime.tv_nsec)))
+		clientSocketAttemptFailed();
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void clientSocketAttemptFailed() {
+	int i;
+
+	for (i=0; i<CR_DA_SOCKET_N_OF_CONNS; i++) {
+		if (conn[i].fd > 0)
+			close(conn[i].fd);
+		conn[i].fd = -1;
+		conn[i].connPending = 0;
+	}
+
+	/* A failed attempt on one server is followed at once by an attempt on the other one */
+	curServ = (curServ + 1) % nOfServ;
+	nOfRoundFails++;
+	if (nOfRoundFails < nOfServ) {
+		clientSocketSchedule(0);
+		return;
+	}
+	nOfRoundFails = 0;
+	clientSocketSchedule(reconnectBackoff);
+	reconnectBackoff = 2*reconnectBackoff;
+	if (reconnectBackoff > CR_DA_SOCKET_CONNECT_BACKOFF_MAX_MSEC)
+		reconnectBackoff = CR_DA_SOCKET_CONNECT_BACKOFF_MAX_MSEC;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void clientSocketLinkUp() {
+#if (CR_DA_SOCKET_EPOLL == 1)
+	struct epoll_event ev;
+#endif
+#if (CR_DA_IO_THREAD == 0)
+	FwSmDesc_t outStream;
+	unsigned int dest;
+#endif
+	int i;
+
+	linkUp = 1;
+	if (curServ != 0)
+		nOfFailovers++;
+	printf("CrDaClientSocketPoll: connection re-established with the %s server\n",
+	       (curServ == 0) ? "primary" : "standby");
+	for (i=0; i<CR_DA_SOCKET_N_OF_CONNS; i++) {
+		conn[i].rxReady = 1;
+#if (CR_DA_SOCKET_EPOLL == 1)
+		ev.events = EPOLLIN | EPOLLOUT | EPOLLET;
+		ev.data.u32 = (uint32_t)i;
+		if (epoll_ctl(epfd, EPOLL_CTL_ADD, conn[i].fd, &ev) < 0)
+			perror("CrDaClientSocketPoll, epoll registration");
+#endif
+		clientSocketAnnounce(i);
+	}
+	CrDaClientSocketFlush();
+
+#if (CR_DA_IO_THREAD == 0)
+	/* The packets which the OutStreams kept during the outage are handed over again
+	 * (with the I/O thread, they wait in its outgoing ring which it retries by itself) */
+	for (dest=0; dest<CR_DA_STREAM_MAP_N; dest++) {
+		if (CrDaStreamMapGetOutStreamIndex((CrFwDestSrc_t)dest) < 0)
+			continue;
+		outStream = CrDaStreamMapGetOutStream((CrFwDestSrc_t)dest);
+		if (CrFwOutStreamGetNOfPendingPckts(outStream) > 0)
+			CrFwOutStreamConnectionAvail(outStream);
+	}
+#endif
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void clientSocketSchedule(unsigned int msec) {
+	clock_gettime(CLOCK_MONOTONIC, &attemptTime);
+	attemptTime.tv_sec = attemptTime.tv_sec + (time_t)(msec/1000);
+	attemptTime.tv_nsec = attemptTime.tv_nsec + (long)(msec%1000)*1000000L;
+	if (attemptTime.tv_nsec >= 1000000000L) {
+		attemptTime.tv_sec++;
+		attemptTime.tv_nsec = attemptTime.tv_nsec - 1000000000L;
+	}
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static CrFwBool_t clientSocketResolve(char* name, int port, struct sockaddr_in* addr) {
+	struct hostent* server = gethostbyname(name);
+
+	if (server == NULL) {
+		perror("CrDaClientSocketInitAction, Get host name of standby server");
+		return 0;
+	}
+	bzero((char*)addr, sizeof(*addr));
+	addr->sin_family = AF_INET;
+	bcopy((char*)server->h_addr, (char*)&addr->sin_addr.s_addr, server->h_length);
+	addr->sin_port = htons(port);
+	return 1;
+}
+#endif
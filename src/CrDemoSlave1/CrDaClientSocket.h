@@ -34,6 +34,54 @@
  * its socket (these are defined through functions <code>::CrDaClientSocketSetPort</code> and
  * <code>::CrDaClientSocketSetHost</code>).
  *
+ * The connection is established when the socket is initialized.
+ * The server need not be listening yet: a refused or unreachable connection is retried
+ * with an exponential back-off (from <code>#CR_DA_SOCKET_CONNECT_BACKOFF_MSEC</code> up to
+ * <code>#CR_DA_SOCKET_CONNECT_BACKOFF_MAX_MSEC</code>) so that the client and server
+ * applications can be started in any order.
+ *
+ * If the supervision of the connection is selected (see <code>#CR_DA_SOCKET_RECONNECT</code>),
+ * a connection which is closed by the server or which fails while it is read or written is
+ * re-established without blocking the caller:
+ * - the socket is closed and the receive ring buffer and the Pending Packet are discarded
+ *   (a packet which had only partly arrived is sent again by the server);
+ * - the packets in the transmit queue are kept and the first one is rewound so that it is
+ *   written again from its start on the new connection;
+ * - while the connection is down, the hand-over of a packet fails so that the packets are
+ *   kept by the OutStreams (or by the OutStream backlog, see <code>CrDaOutBacklog.h</code>);
+ * - every poll advances the reconnection: a non-blocking connection attempt is started
+ *   (the first one as soon as the connection has failed) and it is completed by a later
+ *   poll or abandoned after <code>#CR_DA_SOCKET_RECONNECT_ATTEMPT_MSEC</code> milliseconds;
+ * - if a standby server has been set (<code>::CrDaClientSocketSetStandby</code>), a failed
+ *   attempt on one server is immediately followed by an attempt on the other one; after an
+ *   attempt on each server has failed, the next round waits for a back-off delay (from
+ *   <code>#CR_DA_SOCKET_CONNECT_BACKOFF_MSEC</code> up to
+ *   <code>#CR_DA_SOCKET_CONNECT_BACKOFF_MAX_MSEC</code>);
+ * - when the connection is up again, the application identifier is announced, the
+ *   transmit queue is flushed and the OutStreams which hold pending packets are signalled
+ *   that the connection is available so that their packets are handed over again.
+ * .
+ * The packets which were written to the old connection but were not delivered by it are
+ * lost (there is no acknowledgement of the packets at the level of the socket).
+ *
+ * After the connection has been established, the client socket announces the application
+ * identifier of its host application (<code>#CR_FW_HOST_APP_ID</code>) to the server socket
+ * by writing it (as one value of type <code>CrFwDestSrc_t</code>) ahead of any packet.
+ * The server socket uses the announcement to route packets to the client.
+ *
+ * If several connections are selected (see <code>#CR_DA_SOCKET_N_OF_CONNS</code>), the
+ * socket opens that many connections to the server and announces the index of each
+ * connection (one byte) after the application identifier.
+ * Each connection has its own receive ring buffer, Pending Packet and transmit queue and
+ * a packet is handed over to the connection of its group
+ * (<code>#CR_DA_SOCKET_CONN_OF_GROUP</code>): the urgent packets therefore do not queue
+ * behind the routine packets in the kernel buffers of a congested connection.
+ * The Pending Packets of the connections of the lower groups are collected first.
+ * The connections are established, supervised and re-established together: the failure
+ * of one of them closes all of them.
+ * The announcement is attempted when the socket is initialized and configured and,
+ * until it succeeds, whenever the socket is polled or a packet is handed over.
+ *
  * The socket assumes a polling approach for incoming packets: function
  * <code>::CrDaClientSocketPoll</code> should be called periodically
  * by an external scheduler.
@@ -45,31 +93,64 @@
  * This causes all pending packets from that source to be collected by the InStream and
  * stored in its Packet Queue.
  *
- * The implementation of this module assumes that, at each read operation, an entire
- * packet is received.
- * The situation where the packet is split into fragments during the transmission
- * process is not handled.
- * In practice, this socket is intended for the case where the socket is local
- * to the host platform (i.e. where the host name is "localhost" and both sender
- * and receiver of a packet are located on the same platform).
+ * If the epoll backend is selected (see <code>#CR_DA_SOCKET_EPOLL</code>), the
+ * socket connections are registered with an edge-triggered epoll instance and
+ * a connection is only read when the epoll instance has reported new data on it.
+ * Idle connections therefore cause no read operations.
+ * The epoll instance also allows the caller to sleep until data arrive through
+ * function <code>::CrDaClientSocketWait</code>.
+ *
+ * The bytes which are read from the socket are accumulated in a receive ring buffer
+ * (see <code>CrDaRxRing.h</code>) and packets are framed on the basis of the length
+ * field in their header.
+ * Hence, a single read operation may deliver several packets or only a fragment of
+ * a packet: the packets are extracted from the ring one at a time and a fragment is
+ * kept in the ring until the rest of the packet has been received.
+ * If the length field of a received packet is illegal, the content of the ring is
+ * discarded.
  *
- * Packets which are read from the socket are stored in a buffer (the <i>Read Buffer</i>).
- * This is an array of bytes whose size is equal to the maximum size of a
- * middleware packet.
- * The Read Buffer can be either "full" (if its first byte is different from zero)
- * or "empty" (if its first byte has been cleared).
+ * The packet at the head of the ring is framed directly into a packet of the packet
+ * pool (the <i>Pending Packet</i>) which is charged to the partition of the InStream
+ * of its source (see <code>CrFwPcktPart.h</code>).
+ * The packet collect operation hands the Pending Packet over to the InStream without
+ * copying it.
+ * If no packet can be allocated from the packet pool, the packet is left in the ring
+ * and framing is attempted again at the next poll.
  *
  * The packet hand-over operation for OutStreams is implemented in function
- * <code>::CrDaClientSocketPcktHandover</code> which performs a non-blocking write
- * to the socket.
+ * <code>::CrDaClientSocketPcktHandover</code> which retains the packet, adds it to
+ * the transmit queue and performs a non-blocking write of the queue to the socket.
+ * The transmit queue keeps the bytes which the socket does not accept (partial writes
+ * and writes which fail with <code>EAGAIN</code> because the kernel buffer is full).
+ * These bytes are written before any new packet when the queue is next flushed.
+ * The packets are released after they have been completely written to the socket.
+ * If the transmit queue is full and cannot be flushed, the hand-over operation fails.
+ * The OutStream then keeps the packet in its packet queue and retries at the next
+ * flush: a full kernel buffer causes backpressure rather than the loss of a packet.
+ * The transmit queue is also flushed by <code>::CrDaClientSocketFlush</code> (which is called
+ * at the start of <code>::CrDaClientSocketWait</code>) and, if the epoll backend is used,
+ * when the socket becomes writable again.
+ *
+ * If batched writes are selected (see <code>#CR_DA_SOCKET_TX_BATCH</code>), the
+ * hand-over operation only adds the packet to the transmit queue which is written
+ * to the socket with a single <code>sendmsg</code> call when it is flushed at the end
+ * of the control cycle, when it holds <code>#CR_DA_TX_QUEUE_FLUSH_BYTES</code> bytes or
+ * when it is full.
+ * The number of write operations therefore grows with the number of flushes
+ * rather than with the number of packets: normally, one write per connection and cycle.
+ * The transmit queue holds up to <code>#CR_DA_TX_QUEUE_NOF_PCKTS</code> packets.
  *
  * If an error is encountered while performing a system call, this module uses function
  * <code>perror</code> to print an error message and, if the error was encountered
  * in the initialization or configuration action, it sets the outcome of the action
  * to 0 ("failure") and returns.
  *
- * This module assumes that the maximum length of a packet is smaller than 256 bytes.
- * Compliance with this constraint is verified in the Initialization Check.
+ * The capacity of the receive ring buffer is <code>#CR_DA_RX_RING_NOF_PCKTS</code> times
+ * the maximum length of a packet.
+ *
+ * The socket options of the tuning profile selected with <code>::CrDaSocketSetProfile</code>
+ * (see <code>CrDaSocketProfile.h</code>) are applied to the socket before it is connected.
+ * A message is printed if some of them did not take effect.
  *
  * <b>Mode of Use of a Client Socket Module</b>
  *
@@ -126,8 +207,10 @@
  * If the client socket has already been initialized, this function calls the
  * Initialization Action of the base InStream/OutStream and then returns.
  * If the client socket has not yet been initialized, this action:
- * - creates the Read Buffer;
- * - creates and connects the socket as a non-blocking socket;
+ * - creates the receive ring buffer;
+ * - creates and connects the socket as a non-blocking socket (if the server is not yet
+ *   listening, the connection is retried with an exponential back-off for up to
+ *   <code>#CR_DA_SOCKET_CONNECT_TIMEOUT_MSEC</code> milliseconds);
  * - executes the Initialization Action of the base InStream/OutStream;
  * - sets the outcome to "success" if the previous operations are successful.
  * .
@@ -140,8 +223,8 @@ void CrDaClientSocketInitAction(FwPrDesc_t prDesc);
  * If the client socket has already been shut down, this function calls the
  * Shutdown Action of the base InStream/OutStream and then returns.
  * If the client socket has not yet been shut down, this action executes
- * the Shutdown Action of the base InStream/OutStream, releases the Read Buffer,
- * and closes the socket.
+ * the Shutdown Action of the base InStream/OutStream, releases the Pending Packet
+ * and the receive ring buffer, and closes the socket.
  * @param smDesc the InStream or OutStream State Machine descriptor.
  */
 void CrDaClientSocketShutdownAction(FwSmDesc_t smDesc);
@@ -149,7 +232,7 @@ void CrDaClientSocketShutdownAction(FwSmDesc_t smDesc);
 /**
  * Initialization check for the client socket.
  * The check is successful if: the maximum length of a packet (as retrieved from
- * <code>::CrFwPcktGetMaxLength</code>) is smaller than 256; and the port number
+ * <code>::CrFwPcktGetMaxLength</code>) does not exceed <code>#CR_FW_PCKT_LENGTH_MAX</code>; and the port number
  * and server host name have been set.
  * @param prDesc the initialization procedure descriptor.
  */
@@ -157,8 +240,8 @@ void CrDaClientSocketInitCheck(FwPrDesc_t prDesc);
 
 /**
  * Configuration action for the client socket.
- * This action clears the Read Buffer and executes the Configuration Action of
- * the base InStream (function <code>::CrFwInStreamDefConfigAction</code>)
+ * This action releases the Pending Packet, clears the receive ring buffer and executes the
+ * Configuration Action of the base InStream (function <code>::CrFwInStreamDefConfigAction</code>)
  * @param prDesc the configuration procedure descriptor.
  */
 void CrDaClientSocketConfigAction(FwPrDesc_t prDesc);
@@ -166,27 +249,57 @@ void CrDaClientSocketConfigAction(FwPrDesc_t prDesc);
 /**
  * Poll the client socket to check whether a new packet has arrived.
  * This function should be called periodically by an external scheduler.
- * It performs a non-blocking read on the socket to check whether a packet
- * is available at the socket.
- * If a packet is available, it is placed into the Read Buffer, its source
+ * It performs a non-blocking read on the socket to move any newly arrived bytes
+ * into the receive ring buffer.
+ * If the ring holds a complete packet, it is framed into the Pending Packet, its source
  * is determined, and then function <code>::CrFwInStreamPcktAvail</code> is
  * called on the InStream associated to that packet source.
  */
 void CrDaClientSocketPoll();
 
+/**
+ * Set the Packet Available Function of the client socket.
+ * The Packet Available Function is called by <code>::CrDaClientSocketPoll</code> with
+ * the source of the Pending Packet when a packet is available for collection.
+ * The default Packet Available Function calls <code>::CrFwInStreamPcktAvail</code> on
+ * the InStream associated to the source.
+ * Another function can be set to divert the incoming packets away from the InStreams
+ * (e.g. to the I/O thread of <code>CrDaIoThread.h</code>): it must then collect the
+ * packets itself through <code>::CrDaClientSocketPcktCollect</code>.
+ * @param avail the Packet Available Function or NULL to restore the default function
+ */
+void CrDaClientSocketSetPcktAvail(void (*avail)(CrFwDestSrc_t src));
+
+/**
+ * Wait for the argument period while servicing the client socket.
+ * If the epoll backend is used (see <code>#CR_DA_SOCKET_EPOLL</code>), the function
+ * sleeps until new data arrive at the socket or until the period has elapsed.
+ * When new data arrive, function <code>::CrDaClientSocketPoll</code> is called so that
+ * incoming packets are handed over to their InStream without waiting for the next cycle.
+ * If the epoll backend is not used, the function sleeps for the entire period.
+ * Before waiting, the function flushes the transmit queue (see
+ * <code>::CrDaClientSocketFlush</code>).
+ * If the epoll backend is used, the function returns as soon as one or more packets
+ * have been collected by their InStream so that the caller can process them
+ * immediately (see <code>CrDaCycle.h</code>).
+ * This function is intended to be called at the end of each cycle in place of
+ * a plain sleep.
+ * @param period the wait period in milliseconds
+ * @return 1 if the function returned before the end of the period because packets
+ * were collected by their InStream; 0 if the period has elapsed
+ */
+CrFwBool_t CrDaClientSocketWait(unsigned int period);
+
 /**
  * Function implementing the Packet Collect Operation for the client socket.
- * If the packet in the Read Buffer has a source attribute equal to
- * <code>packetSource</code>, this function:
- * - creates a packet instance through a call to <code>CrFwPcktMake</code>
- * - copies the content of the Read Buffer into the newly created packet instance
- * - clears the Read Buffer
- * - returns the packet instance
+ * If the Pending Packet has a source attribute equal to <code>packetSource</code>,
+ * this function:
+ * - hands the Pending Packet over to the caller
+ * - if the receive ring buffer holds another complete packet, frames it into
+ *   a new Pending Packet
  * .
- * If the Read Buffer holds a packet from a source other then
+ * If there is no Pending Packet or if it is a packet from a source other then
  * <code>packetSource</code>, this function returns NULL.
- * Note that the logic of the client socket module guarantees that the Read Buffer
- * will always be full when this function is called.
  * @param pcktSrc the source associated to the InStream
  * @return the packet
  */
@@ -195,18 +308,20 @@ CrFwPckt_t CrDaClientSocketPcktCollect(CrFwDestSrc_t pcktSrc);
 /**
  * Function implementing the Packet Available Check Operation for the client socket.
  * This function implements the following logic:
- * - The function begins by checking the Read Buffer.
- * - If it is full and the source attribute of the packet it contains is equal
- *   to <code>packetSource</code>, the function returns 1.
- * - If the Read Buffer is not full or it is full but the source attribute of the
- *   packet it contains is not equal to <code>packetSource</code>, the function
- *   performs a non-blocking read on the socket.
- * - If the read operation returns nothing or returns a packet with a source
+ * - The function begins by checking the Pending Packet.
+ * - If there is a Pending Packet, the function returns 1.
+ * - If there is no Pending Packet, the function performs a non-blocking read on the
+ *   socket into the receive ring buffer and frames the next complete packet from
+ *   the ring into a new Pending Packet.
+ * - If the ring holds no complete packet or if its next packet has a source
  *   attribute other than <code>packetSource</code>, the function returns 0.
- * - If the read operation returns a packet with a source attribute equal to
- *   <code>packetSource</code>, the function stores it in the
- *   Read Buffer and then returns 1.
+ * - If the next packet in the ring has a source attribute equal to
+ *   <code>packetSource</code>, the function returns 1.
  * .
+ * If the pushed packet arrivals are selected (see <code>#CR_DA_SOCKET_RX_PUSH</code>), the
+ * function does not read the socket and it returns 0 if there is no Pending Packet (the
+ * Pending Packets are framed by <code>::CrDaClientSocketPoll</code> and by the previous
+ * collections).
  * @param pcktSrc the source associated to the InStream
  * @return the value of a predefined flag
  */
@@ -214,13 +329,32 @@ CrFwBool_t CrDaClientSocketIsPcktAvail(CrFwDestSrc_t pcktSrc);
 
 /**
  * Function implementing the hand-over operation for the client socket.
- * This function performs a non-blocking write on the socket and, if it succeeds,
- * it returns 1; otherwise, it returns 0.
+ * This function adds the packet to the transmit queue and flushes the queue
+ * (see <code>::CrDaClientSocketFlush</code>).
+ * If batched writes are selected (see <code>#CR_DA_SOCKET_TX_BATCH</code>), the queue
+ * is only flushed when it is full or when it holds <code>#CR_DA_TX_QUEUE_FLUSH_BYTES</code>
+ * bytes.
+ * The function returns 1 if the packet was added to the transmit queue; the bytes which
+ * the socket does not accept immediately remain in the queue.
+ * If the transmit queue is full and cannot be flushed, the function returns 0 and the
+ * OutStream keeps the packet.
+ * If the application identifier has not yet been announced to the server socket,
+ * the announcement is made first and the function returns 0 if it fails.
  * @param pckt the packet to be written to the socket
- * @return 1 if the packet was successfully written to the socket; 0 otherwise.
+ * @return 1 if the packet was accepted by the transmit queue; 0 otherwise.
  */
 CrFwBool_t CrDaClientSocketPcktHandover(CrFwPckt_t pckt);
 
+/**
+ * Write the packets in the transmit queue to the socket.
+ * The function performs one non-blocking <code>sendmsg</code> call which covers all
+ * the packets in the transmit queue.
+ * Packets which could not be completely written remain in the queue and are written
+ * at the next flush.
+ * The function does nothing if the transmit queue is empty.
+ */
+void CrDaClientSocketFlush();
+
 /**
  * Set the port number for the socket.
  * The port number must be an integer greater than 2000.
@@ -236,4 +370,28 @@ void CrDaClientSocketSetPort(int n);
  */
 void CrDaClientSocketSetHost(char* name);
 
+/**
+ * Set the host name and the port number of the standby server.
+ * The standby server is only used if the supervision of the connection is selected
+ * (see <code>#CR_DA_SOCKET_RECONNECT</code>): it is tried when a connection to the
+ * primary server cannot be established and vice versa.
+ * @param name the host name of the standby server (NULL for no standby server)
+ * @param n the port number of the standby server (zero for no standby server)
+ */
+void CrDaClientSocketSetStandby(char* name, int n);
+
+/**
+ * Liveness Handler of the client socket (see <code>::CrDaHeartbeatSetHandler</code>).
+ * When the server is declared down by the heartbeats, the connection is treated as failed
+ * and it is re-established, first on the other server if a standby server has been set.
+ * This covers a server which falls silent but keeps its connection open (e.g. because
+ * it hangs) and which the supervision of the connection would otherwise not detect.
+ * Nothing is done if the supervision of the connection is not selected (see
+ * <code>#CR_DA_SOCKET_RECONNECT</code>) or if the server is declared up.
+ * This function must be called by the thread which owns the socket.
+ * @param peer the peer whose liveness has changed (the server is the only peer of a client)
+ * @param up 1 if the peer is up again; 0 if it has been declared down
+ */
+void CrDaClientSocketLiveness(CrFwDestSrc_t peer, CrFwBool_t up);
+
 #endif /* CRDA_CLIENTSOCKET_H_ */
@@ -0,0 +1,161 @@
+/**
+ * @file
+ * @ingroup crDemoSlave1
+ * Implementation of the runtime configuration of the demo applications of the CORDET Demo.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include "CrDaConfig.h"
+#include "CrDaCrc.h"
+#include "CrDaFrame.h"
+/* Include configuration files */
+#include "CrFwInStreamUserPar.h"
+#include "CrFwOutStreamUserPar.h"
+
+/** The entries of the configuration file which has been loaded. */
+static CrDaConfigEntry_t configEntry[CR_DA_CONFIG_MAX_N_OF_ENTRIES];
+
+/** The number of entries of the configuration file which has been loaded. */
+static unsigned int configN = 0;
+
+#if (CR_DA_RUNTIME_CONFIG == 1)
+/** The number of elements of each table (the packet pool has a small, a medium and a large size class). */
+static const unsigned int tableSize[CR_DA_CONFIG_N_OF_TABLES+1] = {
+	0, 3, CR_FW_NOF_INSTREAM, CR_FW_NOF_OUTSTREAM, CR_DA_FRAME_MAX_N_OF_SLOTS
+};
+
+/**
+ * Check the header and the entries of a configuration file.
+ * @param fileName the name of the file
+ * @param p the start of the mapping of the file
+ * @param size the size of the file
+ * @param appId the identifier of the application
+ * @return 1 if the file is valid; 0 otherwise
+ */
+static CrFwBool_t configCheck(const char* fileName, const unsigned char* p, size_t size, unsigned int appId);
+#endif
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaConfigLoad(const char* app, unsigned int appId) {
+#if (CR_DA_RUNTIME_CONFIG == 1)
+	const CrDaConfigHeader_t* header;
+	char defName[64];
+	const char* fileName;
+	struct stat st;
+	void* p;
+	int fd;
+
+	fileName = getenv("CR_DA_CONFIG_FILE");
+	if (fileName == NULL) {
+		snprintf(defName, sizeof(defName), "CrDaConfig_%s.cfg", app);
+		fileName = defName;
+	}
+
+	fd = open(fileName, O_RDONLY);
+	if (fd < 0) {
+		if ((errno == ENOENT) && (fileName == defName)) {
+			printf("%s: No configuration file %s: the compile-time configuration is used\n", app, fileName);
+			return 1;
+		}
+		perror("CrDaConfigLoad, Configuration file opening");
+		return 0;
+	}
+	if ((fstat(fd, &st) < 0) || ((size_t)st.st_size < sizeof(CrDaConfigHeader_t))) {
+		printf("CrDaConfigLoad: %s is not a configuration file\n", fileName);
+		close(fd);
+		return 0;
+	}
+	p = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (p == MAP_FAILED) {
+		perror("CrDaConfigLoad, Configuration file mapping");
+		return 0;
+	}
+
+	if (!configCheck(fileName, (const unsigned char*)p, (size_t)st.st_size, appId)) {
+		munmap(p, (size_t)st.st_size);
+		return 0;
+	}
+	header = (const CrDaConfigHeader_t*)p;
+	configN = header->nOfEntries;
+	memcpy(configEntry, (const unsigned char*)p + sizeof(CrDaConfigHeader_t), configN*sizeof(CrDaConfigEntry_t));
+	munmap(p, (size_t)st.st_size);
+	printf("%s: Loaded the configuration file %s (%u entries)\n", app, fileName, configN);
+	return 1;
+#else
+	(void)app;
+	(void)appId;
+	return 1;
+#endif
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+unsigned long CrDaConfigGet(CrDaConfigTable_t table, unsigned int index, unsigned long def) {
+	unsigned int i;
+
+	/* The last entry of an element takes effect */
+	for (i=configN; i>0; i--)
+		if ((configEntry[i-1].table == (uint16_t)table) && (configEntry[i-1].index == index))
+			return configEntry[i-1].value;
+	return def;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+unsigned int CrDaConfigGetNOfEntries() {
+	return configN;
+}
+
+#if (CR_DA_RUNTIME_CONFIG == 1)
+/* ---------------------------------------------------------------------------------------------*/
+static CrFwBool_t configCheck(const char* fileName, const unsigned char* p, size_t size, unsigned int appId) {
+	const CrDaConfigHeader_t* header = (const CrDaConfigHeader_t*)p;
+	const CrDaConfigEntry_t* entry = (const CrDaConfigEntry_t*)(p + sizeof(CrDaConfigHeader_t));
+	unsigned int i;
+
+	if ((header->magic != CR_DA_CONFIG_MAGIC) || (header->version != CR_DA_CONFIG_VERSION)) {
+		printf("CrDaConfigLoad: %s is not a configuration file of version %d\n", fileName, CR_DA_CONFIG_VERSION);
+		return 0;
+	}
+	if ((header->appId != 0) && (header->appId != appId)) {
+		printf("CrDaConfigLoad: %s is meant for application %u\n", fileName, header->appId);
+		return 0;
+	}
+	if ((header->nOfEntries > CR_DA_CONFIG_MAX_N_OF_ENTRIES) ||
+	        (size != sizeof(CrDaConfigHeader_t) + header->nOfEntries*sizeof(CrDaConfigEntry_t))) {
+		printf("CrDaConfigLoad: %s has an invalid length or more than %d entries\n", fileName,
+		       CR_DA_CONFIG_MAX_N_OF_ENTRIES);
+		return 0;
+	}
+	if (CrDaCrc32c((const unsigned char*)entry, header->nOfEntries*sizeof(CrDaConfigEntry_t)) != header->crc) {
+		printf("CrDaConfigLoad: %s is corrupted (CRC mismatch)\n", fileName);
+		return 0;
+	}
+	for (i=0; i<header->nOfEntries; i++)
+		if ((entry[i].table == 0) || (entry[i].table > CR_DA_CONFIG_N_OF_TABLES) ||
+		        (entry[i].index >= tableSize[entry[i].table])) {
+			printf("CrDaConfigLoad: entry %u of %s sets element %u of table %u which does not exist\n",
+			       i, fileName, entry[i].index, entry[i].table);
+			return 0;
+		}
+	return 1;
+}
+#endif
@@ -30,8 +30,1250 @@
 /** The identifier of the first Slave Application of the CORDET Demo */
 #define CR_DA_SLAVE_2 3
 
-/** The port number for the socket port */
+/**
+ * Generator of the item of a peer in a stream table: its identifier.
+ * The stream tables of an application can be generated from a list of its peers: the list
+ * is a macro which takes a generator and an argument and which applies the generator to
+ * the identifier of each peer and to the argument (see <code>#CR_MA_PEERS</code>).
+ */
+#define CR_DA_PEER_ID(id, arg) id,
+
+/** Generator of the item of a peer in a stream table: the argument of the generator. */
+#define CR_DA_PEER_ARG(id, arg) arg,
+
+/** Generator which counts the peers in a list of peers. */
+#define CR_DA_PEER_COUNT(id, arg) +1
+
+/**
+ * The port number for the socket port.
+ * A standby server is a Slave 1 Application built with the port number of the standby
+ * server (see <code>#CR_DA_SOCKET_STANDBY_PORT</code>).
+ */
+#ifndef CR_DA_SOCKET_PORT
 #define CR_DA_SOCKET_PORT 2002
+#endif
+
+/**
+ * The size of the receive ring buffer of a socket connection in number of packets
+ * of maximum length (see <code>CrDaRxRing.h</code>).
+ */
+#define CR_DA_RX_RING_NOF_PCKTS 4
+
+/**
+ * Switch which selects the epoll backend of the socket adapters.
+ * If this constant is set to 1, the socket adapters register their connections
+ * with an edge-triggered epoll instance: a connection is only read when new data
+ * have arrived on it and the functions <code>::CrDaClientSocketWait</code> and
+ * <code>::CrDaServerSocketWait</code> sleep until data arrive.
+ * If it is set to 0, every connection is read at every poll and the wait functions
+ * sleep for the entire period.
+ * The epoll backend is only available on Linux platforms.
+ */
+#ifndef CR_DA_SOCKET_EPOLL
+#define CR_DA_SOCKET_EPOLL 0
+#endif
+
+/**
+ * Switch which selects the batched packet hand-over of the socket adapters.
+ * The packets which are handed over to a socket connection are queued in a transmit
+ * queue (see <code>CrDaTxQueue.h</code>).
+ * If this constant is set to 1, the packets which the OutStreams hand over during a
+ * control cycle are collected in the transmit queue and written to the socket with one
+ * system call at the end of the cycle (the wait operation of the socket adapter flushes
+ * the transmit queues before it waits) or as soon as the queued bytes reach
+ * <code>#CR_DA_TX_QUEUE_FLUSH_BYTES</code>.
+ * If it is set to 0, the queue is flushed whenever a packet is handed over and it only
+ * holds the bytes which the socket could not accept.
+ */
+#ifndef CR_DA_SOCKET_TX_BATCH
+#define CR_DA_SOCKET_TX_BATCH 0
+#endif
+
+/**
+ * Switch which selects the pushed packet arrivals of the socket adapters.
+ * If this constant is set to 1, the sockets are only read by the poll functions of the
+ * socket adapters (<code>::CrDaClientSocketPoll</code> and <code>::CrDaServerSocketPoll</code>)
+ * which frame the packets that have arrived into the Pending Packets of the connections
+ * and signal the InStreams of the sources which have a Pending Packet.
+ * The Packet Available Check Operation then only tests whether a Pending Packet from its
+ * source is ready and it does not read the socket again.
+ * If it is set to 0, the Packet Available Check Operation reads the socket whenever
+ * no Pending Packet is ready.
+ */
+#ifndef CR_DA_SOCKET_RX_PUSH
+#define CR_DA_SOCKET_RX_PUSH 0
+#endif
+
+/**
+ * Switch which selects the cut-through forwarding of the server socket.
+ * If this constant is set to 1, a packet which the server socket receives from one of
+ * its clients and whose destination is another of its clients is added to the transmit
+ * queue of the connection of its destination as soon as it is framed: it is neither
+ * collected by an InStream nor rerouted by the InLoader.
+ * The packet is handled by the InLoader as before if the transmit queue of its
+ * destination is full or if its destination has not connected.
+ * If it is set to 0, all packets received by the server socket are collected by the
+ * InStreams.
+ */
+#ifndef CR_DA_SERVER_SOCKET_CUT_THROUGH
+#define CR_DA_SERVER_SOCKET_CUT_THROUGH 0
+#endif
+
+/**
+ * The size of the transmit queue of a socket connection in number of packets
+ * (see <code>CrDaTxQueue.h</code>).
+ * The queued packets are retained in the packet pool until they have been written.
+ * If batched writes are selected, the transmit queue collects the packets of a whole
+ * control cycle and it can hold all the packets of the packet pool.
+ */
+#if (CR_DA_SOCKET_TX_BATCH == 1)
+#define CR_DA_TX_QUEUE_NOF_PCKTS CR_FW_MAX_NOF_PCKTS
+#else
+#define CR_DA_TX_QUEUE_NOF_PCKTS 4
+#endif
+
+/**
+ * The number of queued bytes at which a transmit queue is flushed before the end of the
+ * control cycle if batched writes are selected (the payload of a TCP segment on Ethernet).
+ */
+#define CR_DA_TX_QUEUE_FLUSH_BYTES 1460
+
+/**
+ * Switch which selects the integrity check of the packets on the socket connections
+ * (see <code>CrDaCrc.h</code>).
+ * If this constant is set to 1, each packet is written to a socket connection with a
+ * trailer which holds its CRC-32C and a packet whose trailer does not match is discarded
+ * by the socket adapter which frames it.
+ * If it is set to 0, the packets are written without a trailer.
+ * All applications must be built with the same setting unless the capability handshake
+ * is selected (see <code>#CR_DA_HANDSHAKE</code>).
+ */
+#ifndef CR_DA_PCKT_CRC
+#define CR_DA_PCKT_CRC 0
+#endif
+
+/** The length of the trailer of a packet on a socket connection (see <code>#CR_DA_PCKT_CRC</code>). */
+#if (CR_DA_PCKT_CRC == 1)
+#define CR_DA_PCKT_CRC_LENGTH 4
+#else
+#define CR_DA_PCKT_CRC_LENGTH 0
+#endif
+
+/**
+ * Switch which selects the io_uring backend of the server socket (see <code>CrDaUring.h</code>).
+ * If this constant is set to 1, the server socket submits its receive, send and accept
+ * operations to an io_uring instance: data are received by multishot receive operations
+ * into a ring of provided buffers, the transmit queues of all connections are submitted
+ * together, and <code>::CrDaServerSocketWait</code> submits the pending operations and
+ * waits for their completions with one system call.
+ * If it is set to 1, the setting of <code>#CR_DA_SOCKET_EPOLL</code> is ignored by the
+ * server socket.
+ * The io_uring backend is only available on Linux platforms (kernel 6.0 or later).
+ */
+#ifndef CR_DA_SOCKET_URING
+#define CR_DA_SOCKET_URING 0
+#endif
+
+/** The number of entries of the submission queue of the io_uring backend. */
+#define CR_DA_URING_NOF_ENTRIES 64
+
+/**
+ * The number of buffers provided to the multishot receive operations of the io_uring backend.
+ * The number must be a power of two.
+ */
+#define CR_DA_URING_NOF_BUFS 64
+
+/** The size in bytes of the buffers provided to the receive operations of the io_uring backend. */
+#define CR_DA_URING_BUF_SIZE 4096
+
+/**
+ * Switch which selects the shared-memory transport (see <code>CrDaShm.h</code>).
+ * If this constant is set to 1, the InStreams and OutStreams of the demo applications
+ * exchange their packets through rings in a shared-memory segment instead of
+ * through the client and server sockets.
+ * This is only possible if all demo applications run on the same host.
+ */
+#ifndef CR_DA_SHM_TRANSPORT
+#define CR_DA_SHM_TRANSPORT 0
+#endif
+
+/** The name of the shared-memory segment of the shared-memory transport. */
+#define CR_DA_SHM_NAME "/CrDaShm"
+
+/**
+ * The size in bytes of each ring of the shared-memory transport.
+ * The size must be a power of two and it must be greater than the maximum length
+ * of a packet.
+ */
+#define CR_DA_SHM_RING_SIZE 16384
+
+/**
+ * The number of application identifiers which can be served by the shared-memory
+ * transport.
+ * Application identifiers range from 0 to this value minus one.
+ */
+#define CR_DA_SHM_NOF_APPS 4
+
+/**
+ * Switch which selects the I/O thread (see <code>CrDaIoThread.h</code>).
+ * If this constant is set to 1, the socket of a demo application is owned by a
+ * dedicated I/O thread and the InStreams and OutStreams exchange their packets with
+ * the I/O thread through lock-free single-producer single-consumer rings.
+ * The I/O thread requires the lock-free packet pool (<code>#CR_FW_PCKT_LOCK_FREE</code>)
+ * and it cannot be combined with the shared-memory transport.
+ */
+#ifndef CR_DA_IO_THREAD
+#define CR_DA_IO_THREAD 0
+#endif
+
+/**
+ * The number of packets which can be held by each ring between the I/O thread and
+ * the InStreams and OutStreams.
+ * The number must be a power of two.
+ */
+#define CR_DA_IO_THREAD_RING_SIZE 64
+
+/**
+ * The maximum time in milliseconds for which the I/O thread waits for incoming
+ * packets before it checks the ring of outgoing packets.
+ * This is the maximum latency of an outgoing packet in the I/O thread.
+ */
+#define CR_DA_IO_THREAD_WAIT_PERIOD 1
+
+/**
+ * Switch which selects the pipelined cycle of the I/O thread (see <code>CrDaIoThread.h</code>).
+ * If this constant is set to 1, the framework thread processes in each cycle the batch
+ * of packets which the I/O thread had received when the cycle started, and it passes the
+ * packets which it sends to the I/O thread as one batch at the end of the cycle.
+ * The I/O thread thereby receives the packets of the next cycle and sends those of the
+ * previous cycle while the framework thread processes the current one.
+ * The pipelined cycle requires the I/O thread (<code>#CR_DA_IO_THREAD</code>) and it
+ * cannot be combined with the event-driven cycle.
+ */
+#ifndef CR_DA_IO_THREAD_PIPELINE
+#define CR_DA_IO_THREAD_PIPELINE 0
+#endif
+
+/**
+ * The maximum number of IP multicast groups which can be joined by the UDP socket
+ * (see <code>CrDaUdpSocket.h</code>).
+ */
+#define CR_DA_UDP_SOCKET_MAX_NOF_GROUPS 4
+
+/**
+ * The time-to-live of the multicast datagrams sent by the UDP socket.
+ * A value of 1 restricts the multicast datagrams to the local network.
+ */
+#define CR_DA_UDP_SOCKET_MULTICAST_TTL 1
+
+/**
+ * The busy-poll time in microseconds of the sockets of the low-latency socket profile
+ * (see <code>CrDaSocketProfile.h</code>).
+ */
+#define CR_DA_SOCKET_BUSY_POLL_USEC 50
+
+/**
+ * The size in bytes of the send and receive buffers of the sockets of the high-throughput
+ * socket profile (see <code>CrDaSocketProfile.h</code>).
+ */
+#define CR_DA_SOCKET_BUF_SIZE 262144
+
+/**
+ * The maximum number of client connections which can be accepted by the server socket
+ * (see <code>CrDaServerSocket.h</code>).
+ */
+#define CR_DA_SERVER_SOCKET_MAX_NOF_CLIENTS 32
+
+/**
+ * The maximum number of Pending Packets which each client connection of the server
+ * socket holds (see <code>CrDaServerSocket.h</code>).
+ * The packets which arrive on a connection are framed until this number of them is
+ * waiting to be collected so that a packet which is not collected does not hold up the
+ * packets from the other sources of the connection.
+ */
+#define CR_DA_SERVER_SOCKET_RX_QUEUE_SIZE 8
+
+/**
+ * The maximum time in milliseconds for which a client socket tries to connect to its
+ * server (see <code>CrDaClientSocket.h</code>).
+ */
+#define CR_DA_SOCKET_CONNECT_TIMEOUT_MSEC 60000
+
+/**
+ * The delay in milliseconds after the first failed connection attempt of a client socket
+ * (see <code>CrDaClientSocket.h</code>).
+ * The delay is doubled after each further failed attempt.
+ */
+#define CR_DA_SOCKET_CONNECT_BACKOFF_MSEC 5
+
+/**
+ * The maximum delay in milliseconds between two connection attempts of a client socket
+ * (see <code>CrDaClientSocket.h</code>).
+ */
+#define CR_DA_SOCKET_CONNECT_BACKOFF_MAX_MSEC 250
+
+/**
+ * Switch which selects the supervision of the connection of the client socket
+ * (see <code>CrDaClientSocket.h</code>).
+ * If this constant is set to 1, a connection which is closed by the server or which
+ * fails is re-established by the polls of the client socket, on the standby server if
+ * the primary server cannot be reached.
+ * If it is set to 0, a connection which fails is not re-established.
+ */
+#ifndef CR_DA_SOCKET_RECONNECT
+#define CR_DA_SOCKET_RECONNECT 0
+#endif
+
+/**
+ * The maximum time in milliseconds for which a reconnection attempt of a client socket
+ * may be in progress before it is abandoned (see <code>#CR_DA_SOCKET_RECONNECT</code>).
+ */
+#define CR_DA_SOCKET_RECONNECT_ATTEMPT_MSEC 250
+
+/**
+ * The port number of the standby server of the client sockets (zero for no standby
+ * server, see <code>::CrDaClientSocketSetStandby</code>).
+ * The standby server runs on the same host as the primary server.
+ */
+#ifndef CR_DA_SOCKET_STANDBY_PORT
+#define CR_DA_SOCKET_STANDBY_PORT 0
+#endif
+
+/**
+ * The number of connections between a client socket and the server socket
+ * (see <code>CrDaClientSocket.h</code> and <code>CrDaServerSocket.h</code>).
+ * The packets of each group travel on the connection of the group (see
+ * <code>#CR_DA_SOCKET_CONN_OF_GROUP</code>) so that, if this constant is set to
+ * <code>#CR_DA_PCKT_N_OF_GROUPS</code>, the urgent packets never wait behind the routine
+ * packets in the byte stream of a congested connection.
+ * The client and server applications must be built with the same setting.
+ */
+#ifndef CR_DA_SOCKET_N_OF_CONNS
+#define CR_DA_SOCKET_N_OF_CONNS 1
+#endif
+
+/** The index of the connection on which the packets of a group travel (see <code>#CR_DA_SOCKET_N_OF_CONNS</code>). */
+#define CR_DA_SOCKET_CONN_OF_GROUP(group) ((unsigned int)(group) % CR_DA_SOCKET_N_OF_CONNS)
+
+/**
+ * The length of the index of the connection which a client socket announces after its
+ * application identifier (see <code>#CR_DA_SOCKET_N_OF_CONNS</code>).
+ */
+#if (CR_DA_SOCKET_N_OF_CONNS > 1)
+#define CR_DA_SOCKET_CONN_ID_LENGTH 1
+#else
+#define CR_DA_SOCKET_CONN_ID_LENGTH 0
+#endif
+
+/**
+ * Switch which selects the capability handshake of the socket connections (see
+ * <code>CrDaHandshake.h</code>).
+ * If this constant is set to 1, the client socket sends a hello with its application
+ * identifier and the wire-format features which it supports after its announcement and
+ * the server socket answers with its own hello: each connection then uses the features
+ * which both peers support.
+ * If it is set to 0, the wire format is fixed by the compile-time switches.
+ * All applications must be built with the same setting.
+ */
+#ifndef CR_DA_HANDSHAKE
+#define CR_DA_HANDSHAKE 0
+#endif
+
+/** The length of the hello of the capability handshake (see <code>#CR_DA_HANDSHAKE</code>). */
+#if (CR_DA_HANDSHAKE == 1)
+#define CR_DA_HANDSHAKE_LENGTH 16
+#else
+#define CR_DA_HANDSHAKE_LENGTH 0
+#endif
+
+/**
+ * The maximum time in milliseconds for which the server socket waits for its clients to
+ * connect (see <code>::CrDaServerSocketWaitClients</code>).
+ */
+#define CR_DA_SOCKET_READY_TIMEOUT_MSEC 60000
+
+/**
+ * The duration in microseconds of one cycle of the demo applications (see
+ * <code>CrDaCycle.h</code>).
+ * Periods shorter than one millisecond are supported.
+ */
+#ifndef CR_DA_CYCLE_PERIOD_USEC
+#define CR_DA_CYCLE_PERIOD_USEC 1000000
+#endif
+
+/**
+ * The execution mode of the demo applications (see <code>CrDaCycle.h</code>).
+ * If this constant is set to 1, the demo applications are event-driven: between two
+ * control cycles, the incoming packets are loaded and executed as soon as they arrive.
+ * If it is set to 0, the incoming packets are only loaded and executed in the control
+ * cycles.
+ */
+#ifndef CR_DA_CYCLE_EVENT_DRIVEN
+#define CR_DA_CYCLE_EVENT_DRIVEN 0
+#endif
+
+/**
+ * Switch which selects the simulation mode (see <code>CrDaSim.h</code>).
+ * If this constant is set to 1, the demo applications run on a virtual clock: their
+ * control cycles take turns in the order of their virtual deadlines and no time is
+ * spent sleeping.
+ * The simulation mode requires the shared-memory transport
+ * (<code>#CR_DA_SHM_TRANSPORT</code>) and it excludes the I/O thread and the manager
+ * pool.
+ */
+#ifndef CR_DA_SIM
+#define CR_DA_SIM 0
+#endif
+
+/** The name of the shared-memory segment through which the simulated applications take turns. */
+#define CR_DA_SIM_NAME "/CrDaSim"
+
+/** The number of applications which take part in a simulation. */
+#ifndef CR_DA_SIM_N_OF_APPS
+#define CR_DA_SIM_N_OF_APPS 3
+#endif
+
+/**
+ * The maximum time in milliseconds for which a simulated application waits for the
+ * other applications to join the simulation (see <code>::CrDaSimJoin</code>).
+ */
+#define CR_DA_SIM_JOIN_MSEC 10000
+
+/**
+ * The interval in milliseconds at which a simulated application which waits for its turn
+ * checks whether it has been requested to stop.
+ */
+#define CR_DA_SIM_POLL_MSEC 100
+
+/**
+ * Switch which selects the heartbeats and the link liveness detection (see
+ * <code>CrDaHeartbeat.h</code>).
+ * If this constant is set to 1, the demo applications send heartbeats on their idle links
+ * and declare a peer down when no packet has been collected from it for
+ * <code>#CR_DA_HEARTBEAT_MISS_COUNT</code> heartbeat periods.
+ * If it is set to 0, no heartbeat is sent and the liveness of the peers is not checked.
+ */
+#ifndef CR_DA_HEARTBEAT
+#define CR_DA_HEARTBEAT 0
+#endif
+
+/**
+ * The heartbeat period in cycles: a heartbeat is sent to a peer to which no packet has
+ * been handed over for this number of cycles (see <code>CrDaHeartbeat.h</code>).
+ */
+#ifndef CR_DA_HEARTBEAT_PERIOD
+#define CR_DA_HEARTBEAT_PERIOD 1
+#endif
+
+/**
+ * The number of heartbeat periods without any packet from a peer after which the peer
+ * is declared down (see <code>CrDaHeartbeat.h</code>).
+ */
+#ifndef CR_DA_HEARTBEAT_MISS_COUNT
+#define CR_DA_HEARTBEAT_MISS_COUNT 3
+#endif
+
+/** The service type of the heartbeats (the service type of the PUS test service). */
+#define CR_DA_HEARTBEAT_SERV_TYPE 17
+
+/** The service sub-type of the heartbeats (the sub-type of the PUS "are-you-alive" report). */
+#define CR_DA_HEARTBEAT_SERV_SUBTYPE 2
+
+/**
+ * Switch which selects the latency tracing (see <code>CrDaLatTrace.h</code>).
+ * If this constant is set to 1, the packets made by the demo applications carry a trailer
+ * of <code>#CR_DA_LAT_TRACE_LENGTH</code> bytes in which each hop of the packet records
+ * a time-stamped trace point and the applications print per-stage latency histograms.
+ * All applications must be built with the same value of this constant.
+ * If it is set to 0, the packets carry no trailer.
+ */
+#ifndef CR_DA_LAT_TRACE
+#define CR_DA_LAT_TRACE 0
+#endif
+
+/**
+ * The maximum number of trace points in the trailer of a packet (see
+ * <code>CrDaLatTrace.h</code>).
+ * A command which is routed through the Slave 1 Application takes up to six points (sent,
+ * received and sent again or forwarded, received, loaded and started); the points which
+ * do not fit are counted as overflows.
+ */
+#ifndef CR_DA_LAT_TRACE_MAX_POINTS
+#define CR_DA_LAT_TRACE_MAX_POINTS 8
+#endif
+
+/**
+ * The length in bytes of the latency trace trailer of a packet: 4 bytes of magic word and
+ * number of points followed by 8 bytes per point (zero if the latency tracing is not
+ * selected).
+ */
+#if (CR_DA_LAT_TRACE == 1)
+#define CR_DA_LAT_TRACE_LENGTH (4 + 8*CR_DA_LAT_TRACE_MAX_POINTS)
+#else
+#define CR_DA_LAT_TRACE_LENGTH 0
+#endif
+
+/**
+ * The number of bits of the linear sub-buckets of the latency trace histograms: each
+ * power-of-two range of latencies is divided into <code>2^CR_DA_LAT_TRACE_SUB_BITS</code>
+ * buckets of equal width.
+ */
+#define CR_DA_LAT_TRACE_SUB_BITS 3
+
+/**
+ * Switch which selects the InLoader drain (see <code>CrDaInLoad.h</code>).
+ * If this constant is set to 1, the demo applications execute the InLoader on their
+ * InStreams until the InStreams are empty or until the budget of the drain
+ * (<code>#CR_DA_IN_LOAD_MAX_PCKTS</code> and <code>#CR_DA_IN_LOAD_MAX_USEC</code>) is
+ * exhausted.
+ * If it is set to 0, the InLoader is executed once per InStream.
+ */
+#ifndef CR_DA_IN_LOAD_DRAIN
+#define CR_DA_IN_LOAD_DRAIN 0
+#endif
+
+/**
+ * The maximum number of packets which are loaded by one InLoader drain (see
+ * <code>CrDaInLoad.h</code>).
+ */
+#define CR_DA_IN_LOAD_MAX_PCKTS 8
+
+/**
+ * The maximum duration in microseconds of one InLoader drain (see
+ * <code>CrDaInLoad.h</code>).
+ * The budget is checked after each round-robin pass over the InStreams.
+ */
+#define CR_DA_IN_LOAD_MAX_USEC 500
+
+/**
+ * Switch which selects the spill InManagers (see <code>CrDaInManagerChain.h</code>).
+ * If this constant is set to 1, the demo applications have spill InManagers
+ * (<code>#CR_DA_INMANAGER_NOF_SPILL</code>) which extend the PCRL of an InManager when
+ * it is full and which are only executed while they hold pending components.
+ * If it is set to 0, a component which does not fit in the PCRL of its InManager is
+ * rejected by the InLoader.
+ */
+#ifndef CR_DA_INMANAGER_SPILL
+#define CR_DA_INMANAGER_SPILL 0
+#endif
+
+/**
+ * Switch which selects the batched execution of the InCommands (see
+ * <code>CrDaInCmdBatch.h</code>).
+ * If this constant is set to 1, the InCommands of the kinds which have a batch handler
+ * (<code>#CR_DA_INCMD_INIT_KIND_BATCH</code>) are collected into batches when they
+ * are executed by their InManager and each batch is executed by one call to its handler.
+ * If it is set to 0, each InCommand is executed by its own Progress Action.
+ */
+#ifndef CR_DA_INCMD_BATCH
+#define CR_DA_INCMD_BATCH 0
+#endif
+
+/** The maximum number of InCommands in a batch (see <code>CrDaInCmdBatch.h</code>). */
+#define CR_DA_INCMD_BATCH_MAX_N 16
+
+/**
+ * The number of bytes of the parameter area of an InCommand which are kept in its batch
+ * (see <code>CrDaInCmdBatch.h</code>).
+ */
+#define CR_DA_INCMD_BATCH_PAR_LENGTH 4
+
+/**
+ * Switch which selects the express lane of the InCommands (see
+ * <code>CrDaInCmdExpress.h</code>).
+ * If this constant is set to 1, the InCommands of the kinds which are marked as express
+ * (<code>#CR_DA_INCMD_INIT_KIND_EXPRESS</code>) are loaded into their own InManager which
+ * is executed as soon as the InLoader has loaded them (within the budget
+ * <code>#CR_DA_INCMD_EXPRESS_BUDGET</code>).
+ * If it is set to 0, they wait in their InManager like the other InCommands.
+ */
+#ifndef CR_DA_INCMD_EXPRESS
+#define CR_DA_INCMD_EXPRESS 0
+#endif
+
+/**
+ * The maximum number of express InCommands which are executed in one cycle as soon as
+ * they are loaded (see <code>CrDaInCmdExpress.h</code>).
+ */
+#define CR_DA_INCMD_EXPRESS_BUDGET 4
+
+/**
+ * The maximum number of InCommands whose Progress Action is a continuation and which are
+ * suspended at the same time (see <code>CrDaInCmdAsync.h</code>).
+ */
+#define CR_DA_INCMD_ASYNC_MAX_N 8
+
+/**
+ * The number of bytes of the local state which a continuation keeps across its
+ * suspensions (see <code>CrDaInCmdAsync.h</code>).
+ */
+#define CR_DA_INCMD_ASYNC_LOCAL_SIZE 32
+
+/**
+ * The failure code of the progress of an InCommand whose continuation could not be
+ * started because all <code>#CR_DA_INCMD_ASYNC_MAX_N</code> continuations were in use.
+ * It must differ from the outcomes "completed" (1) and "continue" (2) of a Progress Action.
+ */
+#define CR_DA_INCMD_ASYNC_FAIL_BUSY 3
+
+/**
+ * Switch which selects the manager pool (see <code>CrDaMgrPool.h</code>).
+ * If this constant is set to 1, the InManagers and OutManagers which are marked as
+ * independent (<code>#CR_FW_INMANAGER_INDEPENDENT</code> and
+ * <code>#CR_FW_OUTMANAGER_INDEPENDENT</code>) are executed concurrently by pinned worker
+ * threads.
+ * The manager pool requires the lock-free packet pool (<code>#CR_FW_PCKT_LOCK_FREE</code>).
+ */
+#ifndef CR_DA_MGR_POOL
+#define CR_DA_MGR_POOL 0
+#endif
+
+/**
+ * The core to which the first worker thread of the manager pool is pinned (see
+ * <code>CrDaMgrPool.h</code>).
+ * The following worker threads are pinned to the following cores.
+ */
+#define CR_DA_MGR_POOL_FIRST_CPU 1
+
+/**
+ * The resolution of the histograms of the phase timing (see <code>CrDaPhase.h</code>).
+ * Each power of two of the phase durations is divided into 2^CR_DA_PHASE_SUB_BUCKET_BITS
+ * buckets.
+ */
+#define CR_DA_PHASE_SUB_BUCKET_BITS 3
+
+/**
+ * The number of control cycles after which the demo applications print the summary
+ * line of the phase timing (see <code>CrDaPhase.h</code>).
+ */
+#define CR_DA_PHASE_REPORT_PERIOD 10
+
+/**
+ * The maximum time in milliseconds for which the shutdown sequence of the demo
+ * applications waits for the OutStreams to be flushed (see <code>CrDaShutdown.h</code>).
+ */
+#define CR_DA_SHUTDOWN_FLUSH_MSEC 1000
+
+/**
+ * The number of groups for which the link statistics track the continuity of the
+ * sequence counters (see <code>CrDaLinkStats.h</code>).
+ * The packets of the higher groups are not tracked.
+ */
+#define CR_DA_LINK_STATS_N_OF_GROUPS CR_DA_PCKT_N_OF_GROUPS
+
+/**
+ * The number of sequence counters below the highest received one for which the link
+ * statistics remember whether they have been received (it must be between 1 and 64).
+ */
+#define CR_DA_LINK_STATS_SEQ_WINDOW 64
+
+/**
+ * Switch which selects the dropping of the duplicate packets by the transports of the
+ * InStreams (see <code>CrDaLinkStats.h</code>).
+ * If this constant is set to 1, a packet whose sequence counter has already been received
+ * on its link and group within the last <code>#CR_DA_LINK_STATS_SEQ_WINDOW</code>
+ * sequence counters is released by the transport instead of being handed to its InStream.
+ * If it is set to 0, the duplicates are only counted.
+ */
+#ifndef CR_DA_INSTREAM_DEDUP
+#define CR_DA_INSTREAM_DEDUP 0
+#endif
+
+/**
+ * Switch which selects the binary event trace (see <code>CrDaTrace.h</code>).
+ * If this constant is set to 1, the error reports and the reports of the outcome of the
+ * InCommands are written as binary records to the ring buffer of the trace and the ring
+ * buffer is written to a file at the end of the run.
+ * If it is set to 0, they are printed to standard output.
+ */
+#ifndef CR_DA_TRACE
+#define CR_DA_TRACE 0
+#endif
+
+/** The number of records of the ring buffer of the binary event trace (it must be a power of two). */
+#define CR_DA_TRACE_N_OF_RECS 4096
+
+/**
+ * The compile-time level of the log messages (see <code>CrDaLog.h</code>).
+ * The log messages whose level is above this level are removed at compile time.
+ * The default (3) keeps all messages; set it to 2 to remove the debug messages (e.g. the
+ * message at the start of every control cycle).
+ */
+#ifndef CR_DA_LOG_LEVEL
+#define CR_DA_LOG_LEVEL 3
+#endif
+
+/** The size of the queue of the log messages in number of messages (see <code>CrDaLog.h</code>). */
+#define CR_DA_LOG_QUEUE_SIZE 256
+
+/** The maximum length of a log message including its terminating null character. */
+#define CR_DA_LOG_MSG_SIZE 256
+
+/**
+ * Switch which selects the live stream metrics and their server (see <code>CrDaMetrics.h</code>).
+ * If this constant is set to 1, the packets, bytes and errors of the streams are counted
+ * and a server thread serves them on the port <code>#CR_DA_METRICS_PORT</code> plus the
+ * application identifier.
+ * If it is set to 0, the metrics functions do nothing.
+ */
+#ifndef CR_DA_METRICS
+#define CR_DA_METRICS 0
+#endif
+
+/** The base of the TCP port of the metrics server (the application identifier is added to it). */
+#define CR_DA_METRICS_PORT 9100
+
+/** The maximum number of InStreams and of OutStreams whose packet queues are sampled by the metrics. */
+#define CR_DA_METRICS_MAX_NOF_STREAMS 4
+
+/**
+ * Switch which selects the packet capture (see <code>CrDaCapture.h</code>).
+ * If this constant is set to 1, the packets which the transports hand over to the
+ * middleware and collect from it are recorded in a capture file.
+ * If it is set to 0, the capture functions do nothing.
+ */
+#ifndef CR_DA_CAPTURE
+#define CR_DA_CAPTURE 0
+#endif
+
+/** The size in bytes by which the capture file is extended when it is full. */
+#define CR_DA_CAPTURE_CHUNK_SIZE (16*1024*1024)
+
+/**
+ * Switch which selects the persistent event log (see <code>CrDaEventLog.h</code>).
+ * If this constant is set to 1, the temperature violations are appended as binary records
+ * to memory-mapped log files which are synchronized with the disk by a flush thread.
+ * If it is set to 0, the event log functions do nothing.
+ */
+#ifndef CR_DA_EVENT_LOG
+#define CR_DA_EVENT_LOG 0
+#endif
+
+/** The number of records of one file of the event log (the log moves to the next file when a file is full). */
+#define CR_DA_EVENT_LOG_N_OF_RECS 16384
+
+/** The number of files of the event log (when the last file is full, the first one is overwritten). */
+#define CR_DA_EVENT_LOG_N_OF_FILES 4
+
+/** The period in milliseconds at which the flush thread synchronizes the event log with the disk. */
+#define CR_DA_EVENT_LOG_PERIOD 100
+
+/**
+ * Switch which selects the error event queue (see <code>CrDaErrQueue.h</code>).
+ * If this constant is set to 1, the application errors and the error reports are counted
+ * per code and recorded in a lock-free queue which the main loop drains to the log.
+ * If it is set to 0, the main loop only checks the sticky application error code.
+ */
+#ifndef CR_DA_ERR_QUEUE
+#define CR_DA_ERR_QUEUE 0
+#endif
+
+/** The number of events of the error event queue (must be a power of two). */
+#define CR_DA_ERR_QUEUE_N_OF_EVENTS 256
+
+/** The number of error codes which the error event queue counts separately (the higher codes share the last counter). */
+#define CR_DA_ERR_QUEUE_N_OF_CODES 64
+
+/** The maximum number of events which the monitor of the error event queue drains in one call. */
+#define CR_DA_ERR_QUEUE_BATCH 16
+
+/**
+ * Switch which selects the replay transport (see <code>CrDaReplay.h</code>).
+ * If this constant is set to 1, the InStreams and OutStreams of the demo applications
+ * use the replay transport instead of the sockets: the packets of a capture file are
+ * fed into the InStreams and the packets handed over by the OutStreams are discarded.
+ * The switch is ignored if the shared-memory transport is selected
+ * (see <code>#CR_DA_SHM_TRANSPORT</code>).
+ */
+#ifndef CR_DA_REPLAY
+#define CR_DA_REPLAY 0
+#endif
+
+/**
+ * Switch which selects the runtime configuration (see <code>CrDaConfig.h</code>).
+ * If this constant is set to 1, the demo applications load a configuration file at
+ * start-up whose entries override the compile-time sizes of their packet pools, the
+ * quotas of their partitions and the budgets of their cycle frames.
+ * If it is set to 0, the compile-time values are used.
+ */
+#ifndef CR_DA_RUNTIME_CONFIG
+#define CR_DA_RUNTIME_CONFIG 0
+#endif
+
+/** The maximum number of entries of a configuration file (see <code>CrDaConfig.h</code>). */
+#define CR_DA_CONFIG_MAX_N_OF_ENTRIES 64
+
+/**
+ * Switch which selects the OutStream backlog (see <code>CrDaOutBacklog.h</code>).
+ * If this constant is set to 1, the OutStreams hand their packets over to the backlog
+ * which hands them over to the transport and which absorbs the packets which the
+ * transport does not accept up to <code>#CR_DA_OUT_BACKLOG_MAX_NOF_PCKTS</code> packets per
+ * destination.
+ * If it is set to 0, the OutStreams hand their packets over to the transport directly.
+ */
+#ifndef CR_DA_OUT_BACKLOG
+#define CR_DA_OUT_BACKLOG 0
+#endif
+
+/** The number of packets of a chunk of the OutStream backlog. */
+#define CR_DA_OUT_BACKLOG_CHUNK_SIZE 32
+
+/** The number of chunks of the arena of the OutStream backlog (shared by all destinations). */
+#define CR_DA_OUT_BACKLOG_N_OF_CHUNKS 64
+
+/** The maximum number of packets in the OutStream backlog of a destination. */
+#define CR_DA_OUT_BACKLOG_MAX_NOF_PCKTS 1024
+
+/**
+ * The three thresholds of the number of packets of the OutStream backlog of a destination
+ * above which the time spent by the backlog is recorded.
+ */
+#define CR_DA_OUT_BACKLOG_THRESHOLDS {10, 100, 500}
+
+/** Admission policy which rejects a request whose OutComponent cannot be made (see <code>CrDaOutAdmit.h</code>). */
+#define CR_DA_OUT_ADMIT_REJECT 0
+
+/** Admission policy which defers a request whose OutComponent cannot be made (see <code>CrDaOutAdmit.h</code>). */
+#define CR_DA_OUT_ADMIT_DEFER 1
+
+/**
+ * Admission policy which defers a request whose OutComponent cannot be made and which
+ * drops the oldest deferred request of the same kind and destination when the deferred
+ * request queue is full (see <code>CrDaOutAdmit.h</code>).
+ */
+#define CR_DA_OUT_ADMIT_DROP_OLDEST 2
+
+/**
+ * The admission policy of the commands of the Master Application (see
+ * <code>CrMaCmdSched.h</code>): a command is never dropped in favour of another one.
+ */
+#ifndef CR_DA_OUT_ADMIT_CMD_POLICY
+#define CR_DA_OUT_ADMIT_CMD_POLICY CR_DA_OUT_ADMIT_DEFER
+#endif
+
+/**
+ * The admission policy of the command acknowledgements of the Slave Applications (see
+ * <code>CrDaOutCmpAck.h</code>).
+ */
+#ifndef CR_DA_OUT_ADMIT_ACK_POLICY
+#define CR_DA_OUT_ADMIT_ACK_POLICY CR_DA_OUT_ADMIT_DEFER
+#endif
+
+/**
+ * The admission policy of the temperature violation reports (see
+ * <code>CrDaTempMonitor.h</code>): the latest violations are the most relevant ones.
+ */
+#ifndef CR_DA_OUT_ADMIT_REP_POLICY
+#define CR_DA_OUT_ADMIT_REP_POLICY CR_DA_OUT_ADMIT_DROP_OLDEST
+#endif
+
+/** The number of requests which the deferred request queue can hold (see <code>CrDaOutAdmit.h</code>). */
+#define CR_DA_OUT_ADMIT_QUEUE_SIZE 64
+
+/** The maximum size in bytes of the argument of a deferred request (see <code>CrDaOutAdmit.h</code>). */
+#define CR_DA_OUT_ADMIT_ARG_SIZE 8
+
+/**
+ * The number of requests which the queue of the application threads can hold (see
+ * <code>CrDaOutLoadQueue.h</code>); it must be a power of two.
+ */
+#ifndef CR_DA_OUT_LOAD_QUEUE_SIZE
+#define CR_DA_OUT_LOAD_QUEUE_SIZE 256
+#endif
+
+/**
+ * Switch which selects the packet header templates (see <code>CrDaPcktTemplate.h</code>).
+ * If this constant is set to 1, the reports whose Serialize Operation is
+ * <code>::CrDaPcktTemplateSerialize</code> copy the header of their packet from a template
+ * of their kind and destination and only patch the fields which change from one report
+ * to the next.
+ * If it is set to 0, they use the default Serialize Operation.
+ */
+#ifndef CR_DA_PCKT_TEMPLATE
+#define CR_DA_PCKT_TEMPLATE 0
+#endif
+
+/** The maximum number of packet header templates (one per kind, destination and group). */
+#define CR_DA_PCKT_TEMPLATE_N 16
+
+/**
+ * The number of channels of the channel table of the temperature monitoring (see
+ * <code>CrDaTempMonitor.h</code>); it must be a multiple of 32.
+ */
+#define CR_DA_TEMP_N_OF_CHANNELS 1024
+
+/**
+ * The channel index which selects all channels in the commands of the temperature
+ * monitoring (see <code>CrDaTempMonitor.h</code>).
+ */
+#define CR_DA_TEMP_ALL_CHANNELS 0xFFFF
+
+/**
+ * The default hysteresis band of the channels of the temperature monitoring (see
+ * <code>CrDaTempMonitor.h</code>): the violation of a channel ends when its temperature
+ * drops to its limit minus the band.
+ */
+#define CR_DA_TEMP_HYSTERESIS 0
+
+/** The default rate of the synthetic temperature source in samples per second and channel (see <code>CrDaTempGen.h</code>). */
+#define CR_DA_TEMP_GEN_RATE 100
+
+/** The default number of channels of the synthetic temperature source. */
+#define CR_DA_TEMP_GEN_N_OF_CHANNELS 8
+
+/** The maximum number of channels of the synthetic temperature source. */
+#define CR_DA_TEMP_GEN_MAX_N_OF_CHANNELS CR_DA_TEMP_N_OF_CHANNELS
+
+/** The default percentage of the samples of the synthetic temperature source which violate the limit. */
+#define CR_DA_TEMP_GEN_VIOL_PERCENT 10
+
+/** The default duration of the synthetic temperature source in seconds. */
+#define CR_DA_TEMP_GEN_DURATION 10
+
+/** The period in microseconds of the control cycles of the Slave Applications when the synthetic temperature source is selected. */
+#define CR_DA_TEMP_GEN_PERIOD_USEC 1000
+
+/**
+ * Switch which selects the sampler of the Slave Applications (see <code>CrDaSampler.h</code>).
+ * If this constant is set to 1, the temperature samples are acquired at their own rate by
+ * a sampler thread and handed over to the control cycles through a lock-free ring.
+ * If it is set to 0, they are acquired by the control cycles.
+ */
+#ifndef CR_DA_SAMPLER
+#define CR_DA_SAMPLER 0
+#endif
+
+/** The number of rounds of samples of the ring of the sampler (it must be a power of two). */
+#define CR_DA_SAMPLER_N_OF_SLOTS 64
+
+/** The rate in rounds per second of the sampler when the synthetic temperature source is not selected. */
+#define CR_DA_SAMPLER_RATE 10
+
+/**
+ * The suppression policy of the reports of the temperature monitoring (see
+ * <code>CrDaTempMonitor.h</code>).
+ * While the temperature of a channel violates the limit, a report is made:
+ * - 0: for every sample of the channel (no suppression);
+ * - 1: for the first sample of each violation of the channel (report on edge only);
+ * - 2: at most once every <code>#CR_DA_TEMP_SUPPRESS_PERIOD</code> samples of the channel;
+ * - 3: for the first sample of each violation of the channel and then only when the
+ *   temperature of the channel differs from the last reported temperature by more than
+ *   <code>#CR_DA_TEMP_SUPPRESS_DEADBAND</code>.
+ * .
+ * The number of reports which a channel has suppressed is carried by its next report.
+ */
+#ifndef CR_DA_TEMP_SUPPRESS
+#define CR_DA_TEMP_SUPPRESS 0
+#endif
+
+/** The minimum number of samples of a channel between two of its reports if the report rate is limited. */
+#define CR_DA_TEMP_SUPPRESS_PERIOD 10
+
+/** The deadband of the temperature of a channel if only its changes are reported. */
+#define CR_DA_TEMP_SUPPRESS_DEADBAND 2
+
+/**
+ * Switch which selects the coalescing of the temperature violations (see
+ * <code>CrDaOutCmpTempBatch.h</code>).
+ * If this constant is set to 1, the Slave Applications report the temperature violations
+ * which they detect within a window of <code>#CR_DA_TEMP_BATCH_WINDOW</code> control cycles
+ * in batch reports of up to <code>#CR_DA_TEMP_BATCH_MAX_N</code> violations.
+ * If it is set to 0, they send one report for each temperature violation.
+ */
+#ifndef CR_DA_TEMP_BATCH
+#define CR_DA_TEMP_BATCH 0
+#endif
+
+/** The maximum number of temperature violations in one batch report. */
+#define CR_DA_TEMP_BATCH_MAX_N 8
+
+/** The number of control cycles over which the temperature violations are coalesced into a batch report. */
+#define CR_DA_TEMP_BATCH_WINDOW 1
+
+/**
+ * The length in number of bytes of the packet of a batch report (it must be the same as the
+ * length of the batch report kind in <code>#CR_FW_OUTCMP_INIT_KIND_DESC</code>).
+ */
+#define CR_DA_TEMP_BATCH_PCKT_LENGTH 128
+
+/**
+ * Switch which selects the batched acknowledgements (see <code>CrDaOutCmpAckBatch.h</code>).
+ * If this constant is set to 1, the Slave Applications report the outcomes of the
+ * InCommands of one control cycle in one acknowledgement batch report for each source of
+ * the InCommands.
+ * If it is set to 0, they send one acknowledgement report for each successful start
+ * which has been requested by the source of the InCommand.
+ */
+#ifndef CR_DA_ACK_BATCH
+#define CR_DA_ACK_BATCH 0
+#endif
+
+/** The maximum number of outcomes in one acknowledgement batch report. */
+#define CR_DA_ACK_BATCH_MAX_N 16
+
+/**
+ * The length in number of bytes of the packet of an acknowledgement batch report (it must
+ * be the same as the length of its kind in <code>#CR_FW_OUTCMP_INIT_KIND_DESC</code>).
+ */
+#define CR_DA_ACK_BATCH_PCKT_LENGTH 128
+
+/**
+ * Switch which selects the windowed statistics of the temperature monitoring (see
+ * <code>CrDaOutCmpTempStats.h</code>).
+ * If this constant is set to 1, the Slave Applications do not report the samples which
+ * violate the limit: they keep the number, the minimum, the maximum and the mean of the
+ * samples of each channel over a window of <code>#CR_DA_TEMP_STATS_WINDOW</code> control
+ * cycles and report them in statistics reports of up to <code>#CR_DA_TEMP_STATS_MAX_N</code>
+ * channels at the end of the window.
+ * If it is set to 0, they report the samples which violate the limit.
+ */
+#ifndef CR_DA_TEMP_STATS
+#define CR_DA_TEMP_STATS 0
+#endif
+
+/** The maximum number of channels in one statistics report. */
+#define CR_DA_TEMP_STATS_MAX_N 6
+
+/** The number of control cycles of the window of the statistics of the temperature monitoring. */
+#define CR_DA_TEMP_STATS_WINDOW 10
+
+/**
+ * The length in number of bytes of the packet of a statistics report (it must be the same
+ * as the length of its kind in <code>#CR_FW_OUTCMP_INIT_KIND_DESC</code>).
+ */
+#define CR_DA_TEMP_STATS_PCKT_LENGTH 128
+
+/**
+ * The switch for the delta encoding of the statistics reports (see
+ * <code>CrDaOutCmpTempStats.h</code>).
+ * If this constant is set to 1, the entries of a statistics report are encoded as the
+ * differences to the entries of the same channels in the previous statistics reports
+ * (as variable-length integers), one statistics report in
+ * <code>#CR_DA_TEMP_STATS_KEYFRAME</code> is a key frame whose entries are not encoded
+ * and the length of the packet of a statistics report is cut to the length of its entries.
+ * If it is set to 0, the entries are not encoded and the packets have their full length.
+ */
+#ifndef CR_DA_TEMP_STATS_ENCODING
+#define CR_DA_TEMP_STATS_ENCODING 0
+#endif
+
+/** The number of statistics reports from one key frame to the next when the delta encoding is selected. */
+#define CR_DA_TEMP_STATS_KEYFRAME 16
+
+/** The maximum number of channels whose limits are set by one Bulk Set Temperature Limit command. */
+#define CR_DA_TEMP_BULK_MAX_N 256
+
+/**
+ * The length in number of bytes of the packet of a Bulk Set Temperature Limit command
+ * (it must be the same as the length of its kind in <code>#CR_FW_OUTCMP_INIT_KIND_DESC</code>
+ * and it must be large enough for the header, the <code>LimitBlock</code> parameters and
+ * <code>#CR_DA_TEMP_BULK_MAX_N</code> limits).
+ */
+#define CR_DA_TEMP_BULK_PCKT_LENGTH 384
+
+/**
+ * The length in number of bytes of the packet of a Bulk Enable or Bulk Disable Temperature
+ * Monitoring command (it must be the same as the length of its kind in
+ * <code>#CR_FW_OUTCMP_INIT_KIND_DESC</code> and it must be large enough for the header,
+ * the <code>ChanMask</code> parameters and the mask of all
+ * <code>#CR_DA_TEMP_N_OF_CHANNELS</code> channels).
+ */
+#define CR_DA_TEMP_MASK_PCKT_LENGTH 256
+
+/**
+ * Switch which selects the static creation of the procedures of the configuration of the
+ * demo applications (the Application Start-Up, Reset and Shutdown Procedures).
+ * If this constant is set to 1, the descriptors of the procedures are statically allocated
+ * with the macros of <code>FwPrSCreate.h</code> and initialized when the procedures are
+ * first requested: their memory is fixed at compile time and no heap memory is allocated
+ * for them.
+ * If it is set to 0, the procedures are created dynamically with <code>::FwPrCreate</code>.
+ */
+#ifndef CR_DA_STATIC_CREATION
+#define CR_DA_STATIC_CREATION 0
+#endif
+
+/**
+ * Switch which selects the execution fast path of the InLoader and of the managers (see
+ * <code>CrDaSmExec.h</code>).
+ * If this constant is set to 1, the InLoader is not executed when its InStream holds no
+ * packets and a manager is not executed when it holds no components.
+ * If it is set to 0, they are executed in every cycle.
+ */
+#ifndef CR_DA_SM_FAST_PATH
+#define CR_DA_SM_FAST_PATH 0
+#endif
+
+/**
+ * Switch which selects the memory footprint report (see <code>CrDaFootprint.h</code>).
+ * If this constant is set to 1, the demo applications print the bytes used by each of their
+ * framework components when they terminate.
+ * If it is set to 0, nothing is printed.
+ */
+#ifndef CR_DA_FOOTPRINT
+#define CR_DA_FOOTPRINT 0
+#endif
+
+/**
+ * Switch which selects the snapshot of the application state (see
+ * <code>CrDaSnapshot.h</code>).
+ * If this constant is set to 1, the demo applications keep the state which must survive a
+ * restart in a memory-mapped snapshot file and restore it from that file when they start.
+ * If it is set to 0, a restarted application starts from its initial state.
+ */
+#ifndef CR_DA_SNAPSHOT
+#define CR_DA_SNAPSHOT 0
+#endif
+
+/**
+ * Switch which selects the parallel start-up of the demo applications (see
+ * <code>CrDaStartUp.h</code>).
+ * If this constant is set to 1, the demo applications set up their InStreams and
+ * OutStreams in a start-up thread while they configure their other framework components,
+ * and they report the duration of each start-up task.
+ * If it is set to 0, the start-up tasks are run one after the other.
+ */
+#ifndef CR_DA_STARTUP_PARALLEL
+#define CR_DA_STARTUP_PARALLEL 0
+#endif
+
+/**
+ * Switch which selects the execution profiler of the state machines and procedures (see
+ * <code>CrDaSmProf.h</code>).
+ * If this constant is set to 1, the demo applications count and time the executions and
+ * the transitions of the state machines and procedures which they execute and print their
+ * profile at the end of the run.
+ * If it is set to 0, the state machines and procedures are executed directly.
+ */
+#ifndef CR_DA_SM_PROF
+#define CR_DA_SM_PROF 0
+#endif
+
+/**
+ * Switch which selects the time-partitioned execution of the control cycles (see
+ * <code>CrDaFrame.h</code>).
+ * If this constant is set to 1, the work of a control cycle is executed as a frame of
+ * slots (the I/O, the InLoader, the InManagers, the OutManagers and the application
+ * functions) and each slot is given a time budget; the work which does not fit in its
+ * budget is deferred to the next frame.
+ * If it is set to 0, the work of a control cycle is executed in one go.
+ */
+#ifndef CR_DA_FRAME_SCHED
+#define CR_DA_FRAME_SCHED 0
+#endif
+
+/** The time budget in microseconds of the I/O slot of a frame (see <code>CrDaFrame.h</code>). */
+#define CR_DA_FRAME_BUDGET_IO_USEC 1000
+
+/** The time budget in microseconds of the InLoader slot of a frame. */
+#define CR_DA_FRAME_BUDGET_IN_LOADER_USEC 2000
+
+/** The time budget in microseconds of the InManager slot of a frame. */
+#define CR_DA_FRAME_BUDGET_IN_MANAGER_USEC 5000
+
+/** The time budget in microseconds of the OutManager slot of a frame. */
+#define CR_DA_FRAME_BUDGET_OUT_MANAGER_USEC 2000
+
+/** The time budget in microseconds of the slot of the application functions of a frame. */
+#define CR_DA_FRAME_BUDGET_APP_USEC 1000
+
+/**
+ * Switch which selects the placement of the threads of the demo applications (see
+ * <code>CrDaThread.h</code>).
+ * If this constant is set to 1, each thread of the demo applications is given the CPU
+ * affinity and the real-time priority of its role and the memory of the process is
+ * locked before the control cycles are started.
+ * If it is set to 0, the threads keep the placement and the scheduling policy which they
+ * inherit from the process.
+ */
+#ifndef CR_DA_THREAD_PLACEMENT
+#define CR_DA_THREAD_PLACEMENT 0
+#endif
+
+/**
+ * The CPU affinity mask of the thread which executes the control cycles (see
+ * <code>CrDaThread.h</code>): bit n selects core n and zero leaves the affinity unchanged.
+ */
+#ifndef CR_DA_THREAD_CPUS_CYCLE
+#define CR_DA_THREAD_CPUS_CYCLE 0x4UL
+#endif
+
+/** The CPU affinity mask of the I/O thread (see <code>CrDaIoThread.h</code>). */
+#ifndef CR_DA_THREAD_CPUS_IO
+#define CR_DA_THREAD_CPUS_IO 0x8UL
+#endif
+
+/**
+ * The CPU affinity mask of the worker threads of the manager pool (zero keeps the
+ * pinning of the worker threads from <code>#CR_DA_MGR_POOL_FIRST_CPU</code>).
+ */
+#ifndef CR_DA_THREAD_CPUS_MGR_POOL
+#define CR_DA_THREAD_CPUS_MGR_POOL 0x0UL
+#endif
+
+/** The CPU affinity mask of the auxiliary threads (the logging, metrics and start-up threads). */
+#ifndef CR_DA_THREAD_CPUS_AUX
+#define CR_DA_THREAD_CPUS_AUX 0x1UL
+#endif
+
+/**
+ * The SCHED_FIFO priority of the thread which executes the control cycles (zero selects
+ * the default time-sharing policy).
+ */
+#ifndef CR_DA_THREAD_PRIO_CYCLE
+#define CR_DA_THREAD_PRIO_CYCLE 80
+#endif
+
+/** The SCHED_FIFO priority of the I/O thread. */
+#ifndef CR_DA_THREAD_PRIO_IO
+#define CR_DA_THREAD_PRIO_IO 70
+#endif
+
+/** The SCHED_FIFO priority of the worker threads of the manager pool. */
+#ifndef CR_DA_THREAD_PRIO_MGR_POOL
+#define CR_DA_THREAD_PRIO_MGR_POOL 75
+#endif
+
+/** The SCHED_FIFO priority of the auxiliary threads. */
+#ifndef CR_DA_THREAD_PRIO_AUX
+#define CR_DA_THREAD_PRIO_AUX 0
+#endif
+
+/**
+ * Flag which selects the locking of the memory of the process (<code>mlockall</code>)
+ * when the placement of the threads is selected.
+ */
+#ifndef CR_DA_THREAD_MLOCK
+#define CR_DA_THREAD_MLOCK 1
+#endif
+
+/**
+ * The number of shards of the statistics counters which are updated by several threads
+ * (see <code>CrDaStatShard.h</code>).
+ * Each of the first <code>#CR_DA_STAT_N_OF_SHARDS</code> threads which update the counters
+ * has its own shard.
+ */
+#ifndef CR_DA_STAT_N_OF_SHARDS
+#define CR_DA_STAT_N_OF_SHARDS 8
+#endif
+
+/** The size of the cache lines to which the shards of the statistics counters are aligned. */
+#define CR_DA_STAT_CACHE_LINE 64
+
+/**
+ * The number of groups of the streams of the demo applications.
+ * The group of a packet is its priority class: the OutStream backlog (see
+ * <code>CrDaOutBacklog.h</code>) hands the packets of a group over to the transport before
+ * those of the groups which follow it.
+ * Each group of a stream also has its own sequence counter.
+ */
+#define CR_DA_PCKT_N_OF_GROUPS 2
+
+/** The group of the time-critical packets (the commands of the urgent lane and the acknowledgements). */
+#define CR_DA_PCKT_GROUP_URGENT 0
+
+/** The group of the routine packets (the commands of the bulk lane and the temperature reports). */
+#define CR_DA_PCKT_GROUP_ROUTINE 1
 
 /** The identifier of the service type supported by the demo application */
 #define CR_DA_SERV_TYPE 64
@@ -48,4 +1290,46 @@
 /** The identifier of the service sub-type to report a temperature violation */
 #define CR_DA_SERV_SUBTYPE_REP 4
 
+/**
+ * The identifier of the service sub-type to acknowledge the successful start of a command
+ * (see <code>CrDaOutCmpAck.h</code>).
+ */
+#define CR_DA_SERV_SUBTYPE_ACK 5
+
+/**
+ * The identifier of the service sub-type to report a batch of temperature violations
+ * (see <code>CrDaOutCmpTempBatch.h</code>).
+ */
+#define CR_DA_SERV_SUBTYPE_REP_BATCH 6
+
+/**
+ * The identifier of the service sub-type to report a batch of outcomes of commands
+ * (see <code>CrDaOutCmpAckBatch.h</code>).
+ */
+#define CR_DA_SERV_SUBTYPE_ACK_BATCH 7
+
+/**
+ * The identifier of the service sub-type to report the windowed statistics of the
+ * temperature monitoring (see <code>CrDaOutCmpTempStats.h</code>).
+ */
+#define CR_DA_SERV_SUBTYPE_REP_STATS 8
+
+/**
+ * The identifier of the service sub-type to set the temperature limits of a range of
+ * channels with one command (the Bulk Set Temperature Limit command).
+ */
+#define CR_DA_SERV_SUBTYPE_SET_BULK 9
+
+/**
+ * The identifier of the service sub-type to enable the temperature monitoring of a range
+ * or of a mask of channels with one command (the Bulk Enable Temperature Monitoring command).
+ */
+#define CR_DA_SERV_SUBTYPE_EN_MASK 10
+
+/**
+ * The identifier of the service sub-type to disable the temperature monitoring of a range
+ * or of a mask of channels with one command (the Bulk Disable Temperature Monitoring command).
+ */
+#define CR_DA_SERV_SUBTYPE_DIS_MASK 11
+
 #endif /* CRFW_USERCONSTANTS_H_ */
@@ -0,0 +1,202 @@
+/**
+ * @file
+ * @ingroup crDemoSlave1
+ * Interface for the cycle scheduler of the demo applications of the CORDET Demo.
+ * The cycle scheduler executes the control cycles of a demo application with a fixed
+ * period (see <code>::CrDaCycleSetPeriod</code>).
+ * The application registers the work which it performs in every cycle (the Cycle Work
+ * Function, see <code>::CrDaCycleSetWork</code>) and the function which services its
+ * transport while it waits for the next cycle (the Cycle Wait Function, see
+ * <code>::CrDaCycleSetWait</code>).
+ * The Cycle Wait Functions are the wait functions of the transports (e.g.
+ * <code>::CrDaServerSocketWait</code>).
+ *
+ * The cycles are started on absolute deadlines: the deadline of cycle n+1 is the
+ * deadline of cycle n plus one period, irrespective of the time taken by the work
+ * of cycle n.
+ * Hence, the time taken by the work and by the system calls of a cycle does not
+ * accumulate into a drift of the schedule.
+ * After the Cycle Work Function has returned, the Cycle Wait Function is called with
+ * the number of whole milliseconds which remain until the deadline of the next cycle
+ * (this may be zero) and the remainder, including the sub-millisecond part, is then
+ * slept with <code>clock_nanosleep</code> on the absolute deadline
+ * (<code>TIMER_ABSTIME</code>) of the monotonic clock.
+ *
+ * If the work of a cycle is still running when the deadline of the next cycle
+ * expires, the cycle has overrun.
+ * An overrun is counted and reported on the standard output.
+ * No catch-up burst of cycles is executed: the deadlines which have already expired
+ * are skipped and the next cycle is started on the first deadline of the schedule
+ * which lies in the future (the transport is serviced until then as usual).
+ *
+ * The jitter of a cycle is the time between its deadline and the moment when the
+ * thread which executes the cycles resumes after the sleep on the deadline.
+ * It measures the wake-up latency of the thread (and its preemption by other threads)
+ * and its mean and maximum are part of the statistics of the cycle scheduler: they
+ * show the effect of the placement of the threads (see <code>CrDaThread.h</code>).
+ *
+ * In the cyclic mode, the incoming packets are only processed by the Cycle Work
+ * Function and a packet may therefore wait for up to one period before it is executed.
+ * In the event-driven mode, the application also registers an Event Work Function
+ * (see <code>::CrDaCycleSetEvent</code>) which loads and executes the incoming packets.
+ * The Cycle Wait Function returns as soon as packets have been collected by their
+ * InStream and the cycle scheduler then calls the Event Work Function and resumes
+ * the wait until the deadline of the next cycle.
+ * The latency from the arrival of a packet to its execution is then determined by the
+ * wake-up of the process rather than by the period.
+ * The event-driven mode requires a transport whose wait function can wake up on
+ * incoming packets (the epoll or io_uring backend of the sockets or the shared-memory
+ * transport).
+ * Since the Cycle Wait Function only accepts whole milliseconds, packets which arrive
+ * in the last fraction of a millisecond before a deadline are processed in the
+ * next cycle.
+ *
+ * If the period is zero, the cycle scheduler is free-running: the cycles are executed
+ * back to back and, after each cycle, the transport is serviced without waiting (the
+ * Cycle Wait Function is called with a zero timeout).
+ * There are then no deadlines and no overruns.
+ * This mode is intended for throughput measurements which run the applications as fast
+ * as they can go.
+ *
+ * In the simulation mode (see <code>CrDaSim.h</code>), the deadlines are points in time of
+ * the virtual clock of the simulation: each cycle is executed when the application
+ * receives the turn, the transport is serviced without waiting at the start of each
+ * cycle (it then holds the packets which were sent while the application waited for
+ * its deadline) and the turn is then passed on with the deadline of the next cycle.
+ * There are no sleeps, no overruns and no jitter.
+ *
+ * The execution of the control cycles can be stopped before the given number of cycles
+ * has been executed with <code>::CrDaCycleStop</code>.
+ * This function may be called from a signal handler (see <code>CrDaShutdown.h</code>):
+ * the cycle scheduler returns at the latest at the end of the current cycle.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRDA_CYCLE_H_
+#define CRDA_CYCLE_H_
+
+/* Include Framework Files */
+#include "CrFwConstants.h"
+/* Include Configuration Files */
+#include "CrFwUserConstants.h"
+#include "CrDaConstants.h"
+
+/**
+ * Type for the Cycle Work Function.
+ * The argument is the number of the cycle (the first cycle has number 1).
+ */
+typedef void (*CrDaCycleWork_t)(unsigned int cycle);
+
+/**
+ * Type for the Cycle Wait Function.
+ * The argument is the maximum time in milliseconds for which the function may
+ * service the transport before returning.
+ * The function returns 1 if it returned early because packets were collected by
+ * their InStream and 0 if the time has elapsed.
+ */
+typedef CrFwBool_t (*CrDaCycleWait_t)(unsigned int period);
+
+/** Type for the Event Work Function. */
+typedef void (*CrDaCycleEvent_t)();
+
+/** Type for the statistics of the cycle scheduler. */
+typedef struct {
+	/** The number of cycles which have been executed. */
+	unsigned int nOfCycles;
+	/** The number of cycles whose work did not complete before the next deadline. */
+	unsigned int nOfOverruns;
+	/** The number of deadlines which were skipped because of overruns. */
+	unsigned int nOfSkipped;
+	/** The number of times the Event Work Function has been executed. */
+	unsigned int nOfEvents;
+	/** The largest amount in microseconds by which a deadline was missed. */
+	unsigned long maxOverrun;
+	/** The number of cycles which were started after a sleep until their deadline. */
+	unsigned int nOfWakeUps;
+	/** The largest jitter in nanoseconds of the start of a cycle after its deadline. */
+	unsigned long maxJitter;
+	/** The total jitter in nanoseconds of the starts of the cycles after their deadlines. */
+	unsigned long long totJitter;
+} CrDaCycleStats_t;
+
+/**
+ * Set the period of the control cycles.
+ * The default period is <code>#CR_DA_CYCLE_PERIOD_USEC</code>.
+ * @param period the period in microseconds (zero selects the free-running mode)
+ */
+void CrDaCycleSetPeriod(unsigned long period);
+
+/**
+ * Register the Cycle Work Function.
+ * @param work the Cycle Work Function
+ */
+void CrDaCycleSetWork(CrDaCycleWork_t work);
+
+/**
+ * Register the Cycle Wait Function.
+ * If no Cycle Wait Function is registered (or if NULL is registered), the cycle
+ * scheduler only sleeps until the next deadline.
+ * @param wait the Cycle Wait Function or NULL
+ */
+void CrDaCycleSetWait(CrDaCycleWait_t wait);
+
+/**
+ * Register the Event Work Function.
+ * If an Event Work Function is registered, the cycle scheduler operates in the
+ * event-driven mode; if no Event Work Function is registered (or if NULL is
+ * registered), it operates in the cyclic mode.
+ * @param event the Event Work Function or NULL
+ */
+void CrDaCycleSetEvent(CrDaCycleEvent_t event);
+
+/**
+ * Execute control cycles.
+ * The first cycle is started immediately and the following cycles are started on
+ * the deadlines of the schedule.
+ * The function returns when the given number of cycles has been executed and the
+ * wait of the last cycle has elapsed, or when the execution has been stopped with
+ * <code>::CrDaCycleStop</code>.
+ * @param nOfCycles the number of cycles to be executed
+ */
+void CrDaCycleRun(unsigned int nOfCycles);
+
+/**
+ * Request the cycle scheduler to stop executing control cycles.
+ * The request is served at the end of the Cycle Work Function, of the Event Work
+ * Function, or of the Cycle Wait Function which is running when it is made, and
+ * the sleep until the next deadline is interrupted if the request is made by a
+ * signal handler of the thread executing the cycles.
+ * This function is async-signal-safe.
+ */
+void CrDaCycleStop();
+
+/**
+ * Return true if the cycle scheduler has been requested to stop.
+ * @return 1 if <code>::CrDaCycleStop</code> has been called; 0 otherwise
+ */
+CrFwBool_t CrDaCycleIsStopped();
+
+/**
+ * Return the Cycle Wait Function.
+ * @return the Cycle Wait Function or NULL if no Cycle Wait Function is registered
+ */
+CrDaCycleWait_t CrDaCycleGetWait();
+
+/**
+ * Return the statistics of the cycle scheduler.
+ * @param stats the location where the statistics are returned
+ */
+void CrDaCycleGetStats(CrDaCycleStats_t* stats);
+
+#endif /* CRDA_CYCLE_H_ */
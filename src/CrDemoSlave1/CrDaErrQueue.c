@@ -0,0 +1,226 @@
+/**
+ * @file
+ * @ingroup crDemoSlave1
+ * Implementation of the error event queue of the demo applications of the CORDET Demo.
+ * The queue is the bounded multi-producer queue of D. Vyukov: slot i initially carries
+ * sequence number i; a producer which finds in the slot of head h the sequence number h
+ * may claim it and then sets it to h+1 (the event is published); the consumer which finds
+ * in the slot of tail t the sequence number t+1 reads the event and then sets it to
+ * t+<code>#CR_DA_ERR_QUEUE_N_OF_EVENTS</code> (the slot is free for the next round).
+ * The sequence number of a slot is stored as its distance from the index of the slot so
+ * that the zero-initialized slots already form an empty queue.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdio.h>
+#include "CrDaErrQueue.h"
+#include "CrDaLog.h"
+/* Include Framework Files */
+#include "UtilityFunctions/CrFwUtilityFunctions.h"
+
+#if ((CR_DA_ERR_QUEUE_N_OF_EVENTS & (CR_DA_ERR_QUEUE_N_OF_EVENTS-1)) != 0)
+#error "CR_DA_ERR_QUEUE_N_OF_EVENTS must be a power of two"
+#endif
+
+/** The number of kinds of the events. */
+#define CR_DA_ERR_QUEUE_N_OF_KINDS 2
+
+/** Type for a slot of the queue. */
+typedef struct {
+	/** The sequence number of the slot minus the index of the slot. */
+	unsigned long long seq;
+	/** The event of the slot. */
+	CrDaErrQueueEvent_t ev;
+} CrDaErrQueueSlot_t;
+
+/** The slots of the queue. */
+static CrDaErrQueueSlot_t errSlot[CR_DA_ERR_QUEUE_N_OF_EVENTS];
+
+/** The number of slots which have been claimed by the producers. */
+static unsigned long long errHead = 0;
+
+/** The number of slots which have been released by the consumer. */
+static unsigned long long errTail = 0;
+
+/** The number of errors of each kind and code (the last code also counts the higher codes). */
+static unsigned long long errCount[CR_DA_ERR_QUEUE_N_OF_KINDS][CR_DA_ERR_QUEUE_N_OF_CODES];
+
+#if (CR_DA_ERR_QUEUE == 1)
+/** The number of application errors of each code when the sticky code was last taken. */
+static unsigned long long errTaken[CR_DA_ERR_QUEUE_N_OF_CODES];
+#endif
+
+/** The number of events which were dropped because the queue was full. */
+static unsigned long long nOfDropped = 0;
+
+#if (CR_DA_ERR_QUEUE == 1)
+/**
+ * Count an error and record its event.
+ * @param kind the kind of the error
+ * @param code the error code
+ * @param typeId the type of the component which reported the error
+ * @param instanceId the instance of the component which reported the error
+ */
+static void errQueuePush(CrDaErrQueueKind_t kind, unsigned int code, CrFwTypeId_t typeId,
+                         CrFwInstanceId_t instanceId);
+#endif
+
+/**
+ * Return the counter index of an error code.
+ * @param code the error code
+ * @return the counter index
+ */
+static unsigned int errQueueBin(unsigned int code);
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaErrQueueSetAppErrCode(CrFwAppErrCode_t errCode) {
+#if (CR_DA_ERR_QUEUE == 1)
+	errQueuePush(crDaErrQueueAppErr, (unsigned int)errCode, 0, 0);
+#endif
+	CrFwSetAppErrCode(errCode);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaErrQueueRepErr(CrFwRepErrCode_t errCode, CrFwTypeId_t typeId, CrFwInstanceId_t instanceId) {
+#if (CR_DA_ERR_QUEUE == 1)
+	errQueuePush(crDaErrQueueRepErr, (unsigned int)errCode, typeId, instanceId);
+#else
+	(void)errCode;
+	(void)typeId;
+	(void)instanceId;
+#endif
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaErrQueueTakeAppErr() {
+#if (CR_DA_ERR_QUEUE == 1)
+	CrFwAppErrCode_t errCode = CrFwGetAppErrCode();
+	unsigned int bin;
+
+	if (errCode == crNoAppErr)
+		return;
+	bin = errQueueBin((unsigned int)errCode);
+	/* An error which was set inside the framework has not been counted */
+	if (__atomic_load_n(&errCount[crDaErrQueueAppErr][bin], __ATOMIC_RELAXED) == errTaken[bin])
+		errQueuePush(crDaErrQueueAppErr, (unsigned int)errCode, 0, 0);
+	errTaken[bin] = __atomic_load_n(&errCount[crDaErrQueueAppErr][bin], __ATOMIC_RELAXED);
+	CrFwSetAppErrCode(crNoAppErr);
+#endif
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+unsigned int CrDaErrQueueDrain(CrDaErrQueueEvent_t* ev, unsigned int max) {
+	CrDaErrQueueSlot_t* slot;
+	unsigned long long idx;
+	unsigned int n;
+
+	for (n=0; n<max; n++) {
+		idx = errTail % CR_DA_ERR_QUEUE_N_OF_EVENTS;
+		slot = &errSlot[idx];
+		if (__atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) + idx != errTail+1)
+			break;	/* the slot has not been published yet */
+		ev[n] = slot->ev;
+		/* The slot may be claimed again in the next round */
+		__atomic_store_n(&slot->seq, errTail+CR_DA_ERR_QUEUE_N_OF_EVENTS-idx, __ATOMIC_RELEASE);
+		errTail++;
+	}
+	return n;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaErrQueueMonitor(const char* app) {
+#if (CR_DA_ERR_QUEUE == 1)
+	CrDaErrQueueEvent_t ev[CR_DA_ERR_QUEUE_BATCH];
+	unsigned int i, n;
+
+	CrDaErrQueueTakeAppErr();
+	n = CrDaErrQueueDrain(ev, CR_DA_ERR_QUEUE_BATCH);
+	for (i=0; i<n; i++) {
+		if (ev[i].kind == crDaErrQueueAppErr)
+			CR_DA_LOG(crDaLogError, "%s: Application error %u\n", app, ev[i].code);
+		else
+			CR_DA_LOG(crDaLogError, "%s: Error report %u from component %u of type %u\n", app,
+			          ev[i].code, (unsigned int)ev[i].instanceId, (unsigned int)ev[i].typeId);
+	}
+#else
+	(void)app;
+#endif
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+unsigned long long CrDaErrQueueGetCount(CrDaErrQueueKind_t kind, unsigned int code) {
+	return __atomic_load_n(&errCount[kind][errQueueBin(code)], __ATOMIC_RELAXED);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaErrQueueReport(const char* app) {
+#if (CR_DA_ERR_QUEUE == 1)
+	static const char* kindName[CR_DA_ERR_QUEUE_N_OF_KINDS] = {"application errors", "error reports"};
+	unsigned long long count;
+	unsigned int k, code;
+
+	for (k=0; k<CR_DA_ERR_QUEUE_N_OF_KINDS; k++)
+		for (code=0; code<CR_DA_ERR_QUEUE_N_OF_CODES; code++) {
+			count = CrDaErrQueueGetCount((CrDaErrQueueKind_t)k, code);
+			if (count > 0)
+				printf("%s: Error queue: %llu %s with code %u%s\n", app, count, kindName[k], code,
+				       (code == CR_DA_ERR_QUEUE_N_OF_CODES-1) ? " or higher" : "");
+		}
+	if (nOfDropped > 0)
+		printf("%s: Error queue: %llu events dropped (queue full, %d events)\n", app, nOfDropped,
+		       CR_DA_ERR_QUEUE_N_OF_EVENTS);
+#else
+	(void)app;
+#endif
+}
+
+#if (CR_DA_ERR_QUEUE == 1)
+/* ---------------------------------------------------------------------------------------------*/
+static void errQueuePush(CrDaErrQueueKind_t kind, unsigned int code, CrFwTypeId_t typeId,
+                         CrFwInstanceId_t instanceId) {
+	unsigned long long head, seq, idx;
+	CrDaErrQueueSlot_t* slot;
+
+	__atomic_fetch_add(&errCount[kind][errQueueBin(code)], 1, __ATOMIC_RELAXED);
+
+	head = __atomic_load_n(&errHead, __ATOMIC_RELAXED);
+	for (;;) {
+		idx = head % CR_DA_ERR_QUEUE_N_OF_EVENTS;
+		slot = &errSlot[idx];
+		seq = __atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) + idx;
+		if (seq == head) {
+			if (__atomic_compare_exchange_n(&errHead, &head, head+1, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+				break;	/* the slot has been claimed */
+		} else if (seq < head) {
+			/* The slot still holds the event of the previous round: the queue is full */
+			__atomic_fetch_add(&nOfDropped, 1, __ATOMIC_RELAXED);
+			return;
+		} else
+			head = __atomic_load_n(&errHead, __ATOMIC_RELAXED);
+	}
+	slot->ev.kind = kind;
+	slot->ev.code = code;
+	slot->ev.typeId = typeId;
+	slot->ev.instanceId = instanceId;
+	/* The event is complete before it is published */
+	__atomic_store_n(&slot->seq, head+1-idx, __ATOMIC_RELEASE);
+}
+#endif
+
+/* ---------------------------------------------------------------------------------------------*/
+static unsigned int errQueueBin(unsigned int code) {
+	if (code >= CR_DA_ERR_QUEUE_N_OF_CODES)
+		return CR_DA_ERR_QUEUE_N_OF_CODES-1;
+	return code;
+}
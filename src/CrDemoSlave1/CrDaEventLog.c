@@ -0,0 +1,319 @@
+/**
+ * @file
+ * @ingroup crDemoSlave1
+ * Implementation of the persistent event log of the demo applications.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <time.h>
+#include <sched.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include "CrDaEventLog.h"
+#include "CrDaThread.h"
+
+#if (CR_DA_EVENT_LOG_N_OF_FILES < 2)
+#error "CR_DA_EVENT_LOG_N_OF_FILES must be at least 2"
+#endif
+
+/** The index of a mapping which holds no file. */
+#define CR_DA_EVENT_LOG_NO_FILE UINT64_MAX
+
+/** Type for an event log file as it is mapped. */
+typedef struct {
+	/** The header of the file. */
+	CrDaEventLogHeader_t header;
+	/** The records of the file. */
+	CrDaEventLogRec_t rec[CR_DA_EVENT_LOG_N_OF_RECS];
+} CrDaEventLogFile_t;
+
+/** Type for a mapping of an event log file. */
+typedef struct {
+	/** The mapped file (NULL if no file is mapped). */
+	CrDaEventLogFile_t* file;
+	/** The index of the mapped file since the start of the log (<code>#CR_DA_EVENT_LOG_NO_FILE</code> if none). */
+	uint64_t index;
+	/** The number of writers which are writing a record to the mapped file. */
+	unsigned int nOfBusy;
+} CrDaEventLogMap_t;
+
+/**
+ * The two mappings of the log: the file with index <code>k</code> is mapped by mapping
+ * <code>k%2</code> (the current file and the next one are therefore in different mappings).
+ */
+static CrDaEventLogMap_t logMap[2] = {{NULL, CR_DA_EVENT_LOG_NO_FILE, 0}, {NULL, CR_DA_EVENT_LOG_NO_FILE, 0}};
+
+/** The number of records reserved since the start (the file of record n is n/CR_DA_EVENT_LOG_N_OF_RECS). */
+static uint64_t logHead = 0;
+
+/** The number of records which were lost because their file was not mapped. */
+static uint64_t logNOfLost = 0;
+
+/** Flag which is set while the event log is running. */
+static CrFwBool_t logIsRunning = 0;
+
+/** Flag which is set to stop the flush thread. */
+static CrFwBool_t logStop = 0;
+
+/** The flush thread. */
+static pthread_t logThread;
+
+/** The name of the application. */
+static const char* logApp = "";
+
+/** The identifier of the application. */
+static unsigned int logAppId = 0;
+
+/**
+ * Create an event log file and map it into a mapping.
+ * The file is created with its full size and it is therefore zero-filled.
+ * If the file cannot be created or mapped, the mapping is left without a file.
+ * @param m the mapping (it must hold no file)
+ * @param index the index of the file since the start of the log
+ */
+static void eventLogMap(CrDaEventLogMap_t* m, uint64_t index);
+
+/**
+ * Synchronize the file of a mapping with the disk and unmap it.
+ * The file is first withdrawn from the writers and it is only unmapped when the writers
+ * which were writing to it are done.
+ * @param m the mapping
+ */
+static void eventLogUnmap(CrDaEventLogMap_t* m);
+
+/**
+ * Synchronize the mapped files with the disk and replace the files which are full.
+ */
+static void eventLogFlush();
+
+/**
+ * The function executed by the flush thread.
+ * @param arg unused
+ * @return always NULL
+ */
+static void* eventLogThreadRun(void* arg);
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaEventLogStart(const char* app, unsigned int appId) {
+#if (CR_DA_EVENT_LOG == 1)
+	int err;
+
+	if (logIsRunning)
+		return 0;
+
+	logApp = app;
+	logAppId = appId;
+	eventLogMap(&logMap[0], 0);
+	if (logMap[0].file == NULL)
+		return 0;
+	eventLogMap(&logMap[1], 1);
+
+	logStop = 0;
+	err = pthread_create(&logThread, NULL, &eventLogThreadRun, NULL);
+	if (err != 0) {
+		errno = err;
+		perror("CrDaEventLogStart, thread creation");
+		eventLogUnmap(&logMap[0]);
+		eventLogUnmap(&logMap[1]);
+		return 0;
+	}
+	__atomic_store_n(&logIsRunning, 1, __ATOMIC_RELEASE);
+	printf("%s: Event log written to CrDaEventLog_%s_<k>.bin\n", app, app);
+	return 1;
+#else
+	(void)app;
+	(void)appId;
+	return 0;
+#endif
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaEventLogWrite(CrDaEventLogKind_t kind, unsigned int src, unsigned int chan, char temp, unsigned int arg) {
+#if (CR_DA_EVENT_LOG == 1)
+	CrDaEventLogMap_t* m;
+	CrDaEventLogRec_t* rec;
+	struct timespec now;
+	uint64_t seqNo, index;
+
+	if (!__atomic_load_n(&logIsRunning, __ATOMIC_ACQUIRE))
+		return;
+
+	seqNo = __atomic_fetch_add(&logHead, 1, __ATOMIC_RELAXED);
+	index = seqNo / CR_DA_EVENT_LOG_N_OF_RECS;
+	m = &logMap[index % 2];
+	/* The announcement of the writer and the check of the file pair with the withdrawal
+	 * of the file and the check of the writers by the flush thread */
+	__atomic_fetch_add(&m->nOfBusy, 1, __ATOMIC_SEQ_CST);
+	if (__atomic_load_n(&m->index, __ATOMIC_SEQ_CST) != index) {
+		__atomic_fetch_sub(&m->nOfBusy, 1, __ATOMIC_RELEASE);
+		__atomic_fetch_add(&logNOfLost, 1, __ATOMIC_RELAXED);
+		return;
+	}
+
+	rec = &m->file->rec[seqNo % CR_DA_EVENT_LOG_N_OF_RECS];
+	clock_gettime(CLOCK_REALTIME, &now);
+	rec->time = (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+	rec->seqNo = seqNo;
+	rec->arg = (uint32_t)arg;
+	rec->src = (uint16_t)src;
+	rec->chan = (uint16_t)chan;
+	rec->temp = (int8_t)temp;
+	/* The kind is written last: a record with a kind is complete */
+	__atomic_store_n(&rec->kind, (uint16_t)kind, __ATOMIC_RELEASE);
+	__atomic_fetch_sub(&m->nOfBusy, 1, __ATOMIC_RELEASE);
+#else
+	(void)kind;
+	(void)src;
+	(void)chan;
+	(void)temp;
+	(void)arg;
+#endif
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaEventLogStop() {
+	if (!logIsRunning)
+		return;
+
+	__atomic_store_n(&logIsRunning, 0, __ATOMIC_RELEASE);
+	__atomic_store_n(&logStop, 1, __ATOMIC_RELEASE);
+	pthread_join(logThread, NULL);
+	eventLogUnmap(&logMap[0]);
+	eventLogUnmap(&logMap[1]);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaEventLogReport(const char* app) {
+#if (CR_DA_EVENT_LOG == 1)
+	if (logHead == 0)
+		return;
+	printf("%s: Event log: %llu records written to %llu files (%d files of %d records kept), %llu lost\n", app,
+	       (unsigned long long)(logHead - logNOfLost),
+	       (unsigned long long)((logHead + CR_DA_EVENT_LOG_N_OF_RECS - 1) / CR_DA_EVENT_LOG_N_OF_RECS),
+	       CR_DA_EVENT_LOG_N_OF_FILES, CR_DA_EVENT_LOG_N_OF_RECS, (unsigned long long)logNOfLost);
+#else
+	(void)app;
+#endif
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void eventLogMap(CrDaEventLogMap_t* m, uint64_t index) {
+	CrDaEventLogFile_t* file;
+	char fileName[64];
+	void* p;
+	int fd;
+
+	snprintf(fileName, sizeof(fileName), "CrDaEventLog_%s_%u.bin", logApp,
+	         (unsigned int)(index % CR_DA_EVENT_LOG_N_OF_FILES));
+	fd = open(fileName, O_RDWR | O_CREAT | O_TRUNC, 0644);
+	if (fd < 0) {
+		perror("CrDaEventLog, Event log file creation");
+		return;
+	}
+	if (ftruncate(fd, (off_t)sizeof(CrDaEventLogFile_t)) < 0) {
+		perror("CrDaEventLog, Event log file sizing");
+		close(fd);
+		return;
+	}
+	p = mmap(NULL, sizeof(CrDaEventLogFile_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	if (p == MAP_FAILED) {
+		perror("CrDaEventLog, Event log file mapping");
+		return;
+	}
+
+	file = (CrDaEventLogFile_t*)p;
+	file->header.magic = CR_DA_EVENT_LOG_MAGIC;
+	file->header.version = CR_DA_EVENT_LOG_VERSION;
+	file->header.recSize = sizeof(CrDaEventLogRec_t);
+	file->header.nOfRecs = CR_DA_EVENT_LOG_N_OF_RECS;
+	file->header.appId = (uint16_t)logAppId;
+	file->header.firstSeqNo = index * CR_DA_EVENT_LOG_N_OF_RECS;
+	file->header.nOfUsed = 0;
+	m->file = file;
+	__atomic_store_n(&m->index, index, __ATOMIC_SEQ_CST);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void eventLogUnmap(CrDaEventLogMap_t* m) {
+	uint64_t head, nOfUsed;
+
+	if (m->file == NULL)
+		return;
+
+	__atomic_store_n(&m->index, CR_DA_EVENT_LOG_NO_FILE, __ATOMIC_SEQ_CST);
+	while (__atomic_load_n(&m->nOfBusy, __ATOMIC_SEQ_CST) != 0)
+		sched_yield();
+
+	head = __atomic_load_n(&logHead, __ATOMIC_ACQUIRE);
+	nOfUsed = (head > m->file->header.firstSeqNo ? head - m->file->header.firstSeqNo : 0);
+	m->file->header.nOfUsed = (nOfUsed > CR_DA_EVENT_LOG_N_OF_RECS ? CR_DA_EVENT_LOG_N_OF_RECS : nOfUsed);
+	if (msync(m->file, sizeof(CrDaEventLogFile_t), MS_SYNC) < 0)
+		perror("CrDaEventLog, Event log file synchronization");
+	munmap(m->file, sizeof(CrDaEventLogFile_t));
+	m->file = NULL;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void eventLogFlush() {
+	uint64_t head = __atomic_load_n(&logHead, __ATOMIC_ACQUIRE);
+	uint64_t current = head / CR_DA_EVENT_LOG_N_OF_RECS;
+	uint64_t index, nOfUsed;
+	CrDaEventLogMap_t* m;
+	unsigned int i;
+
+	for (i=0; i<2; i++) {
+		m = &logMap[i];
+		index = __atomic_load_n(&m->index, __ATOMIC_ACQUIRE);
+		if ((m->file != NULL) && (index >= current)) {
+			/* The file is still being filled (or will be filled next) */
+			nOfUsed = (head > m->file->header.firstSeqNo ? head - m->file->header.firstSeqNo : 0);
+			m->file->header.nOfUsed = (nOfUsed > CR_DA_EVENT_LOG_N_OF_RECS ? CR_DA_EVENT_LOG_N_OF_RECS : nOfUsed);
+			if (msync(m->file, sizeof(CrDaEventLogFile_t), MS_SYNC) < 0)
+				perror("CrDaEventLog, Event log file synchronization");
+			continue;
+		}
+
+		/* The file is full (or could not be mapped): map the first file of its mapping
+		 * which is not yet full */
+		if (m->file != NULL)
+			index = m->file->header.firstSeqNo / CR_DA_EVENT_LOG_N_OF_RECS;
+		else
+			index = i;
+		eventLogUnmap(m);
+		while (index < current)
+			index = index + 2;
+		eventLogMap(m, index);
+	}
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void* eventLogThreadRun(void* arg) {
+	struct timespec period;
+	(void)arg;
+
+	CrDaThreadPlace(crDaThreadAux);
+	period.tv_sec = CR_DA_EVENT_LOG_PERIOD / 1000;
+	period.tv_nsec = (CR_DA_EVENT_LOG_PERIOD % 1000) * 1000000L;
+	while (!__atomic_load_n(&logStop, __ATOMIC_ACQUIRE)) {
+		nanosleep(&period, NULL);
+		eventLogFlush();
+	}
+	return NULL;
+}
@@ -0,0 +1,72 @@
+/**
+ * @file
+ * @ingroup crDemoSlave1
+ * Interface for the memory footprint report of the demo applications of the CORDET Demo.
+ * The memory used by the framework components of an application is fixed by the
+ * parameters of its configuration (the <code>*UserPar.h</code> files).
+ * If the footprint report is selected (see <code>#CR_DA_FOOTPRINT</code>),
+ * <code>::CrDaFootprintReport</code> prints the bytes which each framework component uses
+ * at the current configuration:
+ * - the packet pool (the slabs of the three size classes of packets);
+ * - the InFactory and the OutFactory (the component data of the InCommands, InReports and
+ *   OutComponents which they can make);
+ * - the InManagers and the OutManagers (their PCRLs and POCLs);
+ * - the InStreams and the OutStreams (their packet queues);
+ * - the InRegistry and the OutRegistry (their entries); and
+ * - the heap which has been allocated while the framework components were created and
+ *   configured (between <code>::CrDaFootprintStart</code> and
+ *   <code>::CrDaFootprintStop</code>): these are mainly the descriptors of the state
+ *   machines and procedures of the components which are created dynamically.
+ * .
+ * The sizes of the pools, queues and registries are computed from the configuration
+ * parameters and from the size of their elements; they do not include the fixed data of
+ * each component.
+ * The sizes of all static data and code of an application (including those of the demo
+ * modules) are given by the footprint build profile (see <code>FootprintReport.sh</code>).
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRDA_FOOTPRINT_H_
+#define CRDA_FOOTPRINT_H_
+
+/* Include Framework Files */
+#include "CrFwConstants.h"
+/* Include Configuration Files */
+#include "CrFwUserConstants.h"
+#include "CrDaConstants.h"
+
+/**
+ * Record the heap in use before the framework components are created.
+ * This function must be called by the demo applications before they create their first
+ * framework component.
+ * Nothing is done if the footprint report is not selected.
+ */
+void CrDaFootprintStart();
+
+/**
+ * Record the heap in use after the framework components have been configured.
+ * Nothing is done if the footprint report is not selected.
+ */
+void CrDaFootprintStop();
+
+/**
+ * Print the bytes used by each framework component at the current configuration and the
+ * heap which has been allocated between <code>::CrDaFootprintStart</code> and
+ * <code>::CrDaFootprintStop</code>.
+ * Nothing is printed if the footprint report is not selected.
+ * @param app the name of the application (e.g. "MA")
+ */
+void CrDaFootprintReport(const char* app);
+
+#endif /* CRDA_FOOTPRINT_H_ */
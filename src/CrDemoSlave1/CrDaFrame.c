@@ -0,0 +1,133 @@
+/**
+ * @file
+ * @ingroup crDemoSlave1
+ * Implementation of the time-partitioned frame of the control cycles of the demo
+ * applications.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "CrDaFrame.h"
+#include "CrDaConfig.h"
+
+/** Type for a slot of the frame. */
+typedef struct {
+	/** The name of the slot. */
+	const char* name;
+	/** The Slot Step Function. */
+	CrDaFrameStep_t step;
+	/** The time budget of the slot in microseconds. */
+	unsigned long budget;
+	/** Whether work of the slot was deferred at the end of the last frame. */
+	CrFwBool_t isDeferred;
+	/** The statistics of the slot. */
+	CrDaFrameSlotStats_t stats;
+} CrDaFrameSlot_t;
+
+/** The slot table. */
+static CrDaFrameSlot_t slot[CR_DA_FRAME_MAX_N_OF_SLOTS];
+
+/** The number of slots. */
+static unsigned int nOfSlots = 0;
+
+/**
+ * Return the number of microseconds between two times.
+ * @param start the first time
+ * @param end the second time
+ * @return the number of microseconds between the two times
+ */
+static unsigned long frameUsecBetween(const struct timespec* start, const struct timespec* end);
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaFrameAddSlot(const char* name, CrDaFrameStep_t step, unsigned long budget) {
+	if (nOfSlots == CR_DA_FRAME_MAX_N_OF_SLOTS) {
+		printf("CrDaFrameAddSlot: more than %d slots, slot %s not added\n", CR_DA_FRAME_MAX_N_OF_SLOTS, name);
+		return;
+	}
+	memset(&slot[nOfSlots], 0, sizeof(CrDaFrameSlot_t));
+	slot[nOfSlots].name = name;
+	slot[nOfSlots].step = step;
+	slot[nOfSlots].budget = CrDaConfigGet(crDaConfigFrameBudget, nOfSlots, budget);
+	nOfSlots++;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaFrameRun() {
+	struct timespec start, now;
+	unsigned long used;
+	CrFwBool_t isDone;
+	CrDaFrameSlot_t* s;
+	unsigned int i;
+
+	for (i=0; i<nOfSlots; i++) {
+		s = &slot[i];
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		/* The first step is always executed and a further step only if budget remains */
+		do {
+			isDone = s->step();
+			s->stats.nOfSteps++;
+			clock_gettime(CLOCK_MONOTONIC, &now);
+			used = frameUsecBetween(&start, &now);
+		} while (!isDone && (used < s->budget));
+
+		/* The leftover work is carried into the next frame */
+		s->isDeferred = !isDone;
+		if (s->isDeferred)
+			s->stats.nOfDeferred++;
+		if (used > s->budget) {
+			s->stats.nOfOverruns++;
+			if ((used - s->budget) > s->stats.maxOverrun)
+				s->stats.maxOverrun = used - s->budget;
+		}
+		s->stats.nOfFrames++;
+		s->stats.totUsec += used;
+		if (used > s->stats.maxUsec)
+			s->stats.maxUsec = used;
+	}
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaFrameGetSlotStats(unsigned int i, CrDaFrameSlotStats_t* stats) {
+	if (i >= nOfSlots) {
+		memset(stats, 0, sizeof(CrDaFrameSlotStats_t));
+		return;
+	}
+	*stats = slot[i].stats;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaFrameReport(const char* app) {
+#if (CR_DA_FRAME_SCHED == 1)
+	CrDaFrameSlotStats_t* st;
+	unsigned int i;
+
+	for (i=0; i<nOfSlots; i++) {
+		st = &slot[i].stats;
+		printf("%s: Frame slot %s: budget %lu us, %u frames, %lu steps, mean %.1f us, max %lu us, "
+		       "%u deferred, %u overruns (worst %lu us)%s\n",
+		       app, slot[i].name, slot[i].budget, st->nOfFrames, st->nOfSteps,
+		       (st->nOfFrames == 0 ? 0.0 : (double)st->totUsec/st->nOfFrames), st->maxUsec,
+		       st->nOfDeferred, st->nOfOverruns, st->maxOverrun, (slot[i].isDeferred ? ", work pending" : ""));
+	}
+#else
+	(void)app;
+#endif
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static unsigned long frameUsecBetween(const struct timespec* start, const struct timespec* end) {
+	return (unsigned long)((end->tv_sec - start->tv_sec)*1000000L + (end->tv_nsec - start->tv_nsec)/1000);
+}
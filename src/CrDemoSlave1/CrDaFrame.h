@@ -0,0 +1,119 @@
+/**
+ * @file
+ * @ingroup crDemoSlave1
+ * Interface for the time-partitioned frame of the control cycles of the demo applications
+ * of the CORDET Demo.
+ * If the time-partitioned execution is selected (see <code>#CR_DA_FRAME_SCHED</code>),
+ * the work of a control cycle is executed as a frame made up of slots (e.g. the I/O, the
+ * InLoader, the InManagers, the OutManagers and the application functions such as the
+ * temperature monitoring).
+ * The slot table is configured by the application with <code>::CrDaFrameAddSlot</code>:
+ * each slot has a Slot Step Function and a time budget.
+ * <code>::CrDaFrameRun</code> executes the slots in the order in which they were added.
+ *
+ * The work of a slot is divided into steps (e.g. the InLoader slot loads the packets of
+ * one InStream in each step).
+ * A step is never interrupted: a slot is only left between two steps, when the framework
+ * components which it executes have completed their execution.
+ * The Slot Step Function executes the next step of the work of its slot and returns 1
+ * when the work of the slot is done.
+ * A slot executes its steps while its budget is not exhausted: the first step is always
+ * executed (so that each slot makes progress in every frame) and a further step is only
+ * started if time remains in the budget.
+ * If the budget is exhausted before the work is done, the slot is deferred: the leftover
+ * work is carried into the next frame, in which the Slot Step Function continues where
+ * it stopped, and the frame goes on with the next slot instead of stretching the cycle.
+ * The unused budget of a slot is not given to the other slots: the time of a slot does
+ * not depend on the load of the other slots.
+ *
+ * If a step ends after the budget of its slot, the slot has overrun.
+ * The overruns, the deferrals and the time used by each slot are counted and printed by
+ * <code>::CrDaFrameReport</code>.
+ *
+ * This module is not thread-safe: the frame must be executed by the thread which
+ * executes the framework components.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRDA_FRAME_H_
+#define CRDA_FRAME_H_
+
+/* Include Framework Files */
+#include "CrFwConstants.h"
+/* Include Configuration Files */
+#include "CrFwUserConstants.h"
+#include "CrDaConstants.h"
+
+/** The maximum number of slots in a frame. */
+#define CR_DA_FRAME_MAX_N_OF_SLOTS 16
+
+/**
+ * Type for the Slot Step Function.
+ * The function executes the next step of the work of its slot.
+ * It returns 1 if the work of the slot is done and 0 if work remains.
+ */
+typedef CrFwBool_t (*CrDaFrameStep_t)();
+
+/** Type for the statistics of a slot (all times are in microseconds). */
+typedef struct {
+	/** The number of frames in which the slot was executed. */
+	unsigned int nOfFrames;
+	/** The number of steps which were executed. */
+	unsigned long nOfSteps;
+	/** The number of frames at the end of which work of the slot was deferred. */
+	unsigned int nOfDeferred;
+	/** The number of frames in which the slot exceeded its budget. */
+	unsigned int nOfOverruns;
+	/** The largest amount by which the slot exceeded its budget. */
+	unsigned long maxOverrun;
+	/** The total time used by the slot. */
+	unsigned long long totUsec;
+	/** The largest time used by the slot in one frame. */
+	unsigned long maxUsec;
+} CrDaFrameSlotStats_t;
+
+/**
+ * Add a slot at the end of the frame.
+ * If there are already <code>#CR_DA_FRAME_MAX_N_OF_SLOTS</code> slots, the slot is not
+ * added and an error message is printed.
+ * @param name the name of the slot (used in the report)
+ * @param step the Slot Step Function
+ * @param budget the time budget of the slot in microseconds (the runtime configuration may
+ * override it, see <code>CrDaConfig.h</code>)
+ */
+void CrDaFrameAddSlot(const char* name, CrDaFrameStep_t step, unsigned long budget);
+
+/**
+ * Execute a frame.
+ * The slots are executed in the order in which they were added, each one within its
+ * budget.
+ */
+void CrDaFrameRun();
+
+/**
+ * Return the statistics of a slot.
+ * If there is no such slot, all statistics are zero.
+ * @param slot the index of the slot (in the order in which the slots were added)
+ * @param stats the location where the statistics are returned
+ */
+void CrDaFrameGetSlotStats(unsigned int slot, CrDaFrameSlotStats_t* stats);
+
+/**
+ * Print the budget and the statistics of each slot.
+ * Nothing is printed if the time-partitioned execution is not selected.
+ * @param app the prefix of the printed lines (e.g. "MA")
+ */
+void CrDaFrameReport(const char* app);
+
+#endif /* CRDA_FRAME_H_ */
@@ -0,0 +1,138 @@
+/**
+ * @file
+ * @ingroup crDemoSlave1
+ * Interface for the heartbeats and the link liveness detection of the demo applications
+ * of the CORDET Demo.
+ * If the heartbeats are selected (see <code>#CR_DA_HEARTBEAT</code>), each application
+ * supervises the peers at the other end of its links (<code>::CrDaHeartbeatAddPeer</code>):
+ * - Every packet which the transport collects from a peer shows that the peer is alive
+ *   (the transports report the packets through <code>CrDaLinkStats.h</code>): a busy link
+ *   needs no heartbeats since its traffic carries the liveness of the peer.
+ * - A heartbeat is only sent to a peer if no packet has been handed over to it during
+ *   <code>#CR_DA_HEARTBEAT_PERIOD</code> cycles.
+ *   It is a packet of <code>#CR_FW_PCKT_HEADER_LENGTH</code> bytes with service type
+ *   <code>#CR_DA_HEARTBEAT_SERV_TYPE</code> and sub-type
+ *   <code>#CR_DA_HEARTBEAT_SERV_SUBTYPE</code> which is handed over directly to the
+ *   transport (<code>::CrDaHeartbeatSetHandover</code>): it does not go through the
+ *   OutStreams and does not take a sequence counter.
+ * - The transport which collects a heartbeat drops it after it has been accounted: the
+ *   heartbeats reach neither the InStreams nor the InFactory.
+ * - A peer from which no packet has been collected for
+ *   <code>#CR_DA_HEARTBEAT_MISS_COUNT</code> heartbeat periods is declared down and it is
+ *   declared up again when its next packet is collected.
+ *   Each change is logged and it is signalled to the Liveness Handler
+ *   (<code>::CrDaHeartbeatSetHandler</code>) on which the failover of the client sockets
+ *   relies (see <code>::CrDaClientSocketLiveness</code>).
+ *   A peer is only supervised after its first packet has been collected so that the
+ *   start-up of the applications in any order raises no false alarm.
+ * .
+ * Since the heartbeats are not routed, the peers of an application are its direct
+ * neighbours: all other applications with the shared-memory transport and the server
+ * (for the client applications) or the clients (for the server application) with the
+ * socket transport.
+ *
+ * For each application from which packets are collected, the module also records the
+ * cycle in which the last packet was collected and the one-way delay of the packets,
+ * i.e. the age of their time stamp when they are collected.
+ * The applications of the demo run on the same host and read the same monotonic clock
+ * (or the same virtual clock in the simulation mode) so that the delay needs no clock
+ * synchronization; it includes the time for which a packet waited at its source after
+ * its time stamp was set.
+ * Delays above half the wrap-around period of the time stamps are ignored.
+ *
+ * The packet hooks (<code>::CrDaHeartbeatRx</code> and <code>::CrDaHeartbeatTx</code>)
+ * are executed by the thread which owns the transport and the counters which they share
+ * with <code>::CrDaHeartbeatCycle</code> are accessed atomically.
+ * The delays are only reported when the I/O thread has been stopped.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRDA_HEARTBEAT_H_
+#define CRDA_HEARTBEAT_H_
+
+/* Include Framework Files */
+#include "CrFwConstants.h"
+/* Include Configuration Files */
+#include "CrFwUserConstants.h"
+#include "CrDaConstants.h"
+
+/**
+ * Type for the Liveness Handler.
+ * @param peer the peer whose liveness has changed
+ * @param up 1 if the peer is up again; 0 if it has been declared down
+ */
+typedef void (*CrDaHeartbeatHandler_t)(CrFwDestSrc_t peer, CrFwBool_t up);
+
+/**
+ * Set the function to which the heartbeats are handed over.
+ * This is normally the packet hand-over function of the transport of the OutStreams.
+ * @param handover the packet hand-over function
+ */
+void CrDaHeartbeatSetHandover(CrFwPcktHandover_t handover);
+
+/**
+ * Set the Liveness Handler which is called when a peer is declared down or up.
+ * @param handler the Liveness Handler (NULL for no handler)
+ */
+void CrDaHeartbeatSetHandler(CrDaHeartbeatHandler_t handler);
+
+/**
+ * Supervise a peer: send it heartbeats and declare it down when it falls silent.
+ * Peers which are not applications of the demo are ignored.
+ * @param peer the application identifier of the peer
+ */
+void CrDaHeartbeatAddPeer(CrFwDestSrc_t peer);
+
+/**
+ * Account a packet collected from the middleware.
+ * This function is called by <code>::CrDaLinkStatsRx</code>.
+ * @param pckt the packet
+ * @return 1 if the packet is a heartbeat (which must be dropped); 0 otherwise
+ */
+CrFwBool_t CrDaHeartbeatRx(CrFwPckt_t pckt);
+
+/**
+ * Account a packet handed over to the middleware.
+ * This function is called by <code>::CrDaLinkStatsTx</code>.
+ * @param pckt the packet
+ */
+void CrDaHeartbeatTx(CrFwPckt_t pckt);
+
+/**
+ * Send the heartbeats which are due and check the liveness of the peers.
+ * This function is called once at the end of each cycle by the Cycle Work Function.
+ * Nothing is done if the heartbeats are not selected.
+ */
+void CrDaHeartbeatCycle();
+
+/**
+ * Return whether a peer has been heard from within the last
+ * <code>#CR_DA_HEARTBEAT_MISS_COUNT</code> heartbeat periods.
+ * @param peer the application identifier of the peer
+ * @return 1 if the peer is up; 0 if it is down or if it is not supervised or has not
+ * yet been heard from
+ */
+CrFwBool_t CrDaHeartbeatIsUp(CrFwDestSrc_t peer);
+
+/**
+ * Print, for each supervised peer, its state, the cycle in which its last packet was
+ * collected, the number of times it was declared down and the numbers of heartbeats sent
+ * to it and received from it and, for each application from which packets were collected,
+ * the minimum, mean and maximum one-way delay of its packets.
+ * Nothing is printed if the heartbeats are not selected.
+ * @param app the name of the application
+ */
+void CrDaHeartbeatReport(const char* app);
+
+#endif /* CRDA_HEARTBEAT_H_ */
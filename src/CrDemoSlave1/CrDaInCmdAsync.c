@@ -0,0 +1,185 @@
+/**
+ * @file
+ * @ingroup crDemoSlave1
+ * Implementation of the continuations of the long-running InCommands of the demo
+ * applications of the CORDET Demo.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "CrDaInCmdAsync.h"
+/* Include configuration files */
+#include "CrFwCmpData.h"
+/* Include FW Profile files */
+#include "FwSmConfig.h"
+
+/** The outcome of a Progress Action which must be executed again. */
+#define CR_DA_INCMD_ASYNC_CONTINUE 2
+
+/** The continuations. */
+static CrDaInCmdAsync_t asyncCont[CR_DA_INCMD_ASYNC_MAX_N];
+
+/** The number of continuations in use. */
+static unsigned int nOfInUse = 0;
+
+/** The peak number of continuations in use. */
+static unsigned int nOfInUsePeak = 0;
+
+/** The number of continuations which have been started. */
+static unsigned long long nOfStarted = 0;
+
+/** The number of continuations which have completed their InCommand. */
+static unsigned long long nOfCompleted = 0;
+
+/** The number of continuations which have failed their InCommand. */
+static unsigned long long nOfFailed = 0;
+
+/** The number of continuations which have been released by the abort of their InCommand. */
+static unsigned long long nOfAborted = 0;
+
+/** The number of Progress Actions which failed because no continuation was free. */
+static unsigned long long nOfBusy = 0;
+
+/** The number of yields of the continuations. */
+static unsigned long long nOfYields = 0;
+
+/**
+ * Get the continuation of an InCommand.
+ * @param inCmd the InCommand
+ * @return the continuation of the InCommand or NULL if it has none
+ */
+static CrDaInCmdAsync_t* asyncFind(FwSmDesc_t inCmd);
+
+/**
+ * Free a continuation.
+ * @param async the continuation
+ */
+static void asyncFree(CrDaInCmdAsync_t* async);
+
+/**
+ * Set the outcome of an InCommand.
+ * @param inCmd the InCommand
+ * @param outcome the outcome
+ */
+static void asyncSetOutcome(FwSmDesc_t inCmd, CrFwOutcome_t outcome);
+
+/* ---------------------------------------------------------------------------------------------*/
+CrDaInCmdAsync_t* CrDaInCmdAsyncBind(FwSmDesc_t inCmd) {
+	CrDaInCmdAsync_t* async = asyncFind(inCmd);
+	FwSmDesc_t free;
+	unsigned int i, n, peak;
+
+	if (async != NULL)
+		return async;
+
+	for (i=0; i<CR_DA_INCMD_ASYNC_MAX_N; i++) {
+		free = NULL;
+		if (__atomic_compare_exchange_n(&asyncCont[i].inCmd, &free, inCmd, 0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+			break;
+	}
+	if (i == CR_DA_INCMD_ASYNC_MAX_N) {
+		__atomic_fetch_add(&nOfBusy, 1, __ATOMIC_RELAXED);
+		asyncSetOutcome(inCmd, CR_DA_INCMD_ASYNC_FAIL_BUSY);
+		return NULL;
+	}
+
+	async = &asyncCont[i];
+	async->resume = 0;
+	async->step = 0;
+	async->wake = 0;
+	async->isWaiting = 0;
+	memset(async->local, 0, CR_DA_INCMD_ASYNC_LOCAL_SIZE);
+
+	__atomic_fetch_add(&nOfStarted, 1, __ATOMIC_RELAXED);
+	n = __atomic_add_fetch(&nOfInUse, 1, __ATOMIC_RELAXED);
+	peak = __atomic_load_n(&nOfInUsePeak, __ATOMIC_RELAXED);
+	while ((n > peak) &&
+	        !__atomic_compare_exchange_n(&nOfInUsePeak, &peak, n, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+		;
+	return async;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaInCmdAsyncSuspend(CrDaInCmdAsync_t* async, CrFwBool_t isWaiting) {
+	async->isWaiting = isWaiting;
+	if (!isWaiting)
+		__atomic_fetch_add(&nOfYields, 1, __ATOMIC_RELAXED);
+	asyncSetOutcome(async->inCmd, CR_DA_INCMD_ASYNC_CONTINUE);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaInCmdAsyncIsDue(const CrDaInCmdAsync_t* async) {
+	/* The cycle time wraps around: the sleep has elapsed when the wake time is not ahead */
+	return ((int)(CrFwGetCurrentCycTime() - async->wake) >= 0);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaInCmdAsyncRelease(CrDaInCmdAsync_t* async, CrFwOutcome_t outcome) {
+	asyncSetOutcome(async->inCmd, outcome);
+	if (outcome == 1)
+		__atomic_fetch_add(&nOfCompleted, 1, __ATOMIC_RELAXED);
+	else
+		__atomic_fetch_add(&nOfFailed, 1, __ATOMIC_RELAXED);
+	asyncFree(async);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaInCmdAsyncIsWaiting(FwSmDesc_t inCmd) {
+	CrDaInCmdAsync_t* async = asyncFind(inCmd);
+
+	return ((async != NULL) && async->isWaiting);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaInCmdAsyncAbort(FwSmDesc_t smDesc) {
+	CrDaInCmdAsync_t* async = asyncFind(smDesc);
+
+	if (async == NULL)
+		return;
+	__atomic_fetch_add(&nOfAborted, 1, __ATOMIC_RELAXED);
+	asyncFree(async);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaInCmdAsyncReport(const char* app) {
+	if (nOfStarted == 0 && nOfBusy == 0)
+		return;
+	printf("%s: InCommand continuations: %llu started, %llu completed, %llu failed, %llu aborted, %llu yields, "
+	       "%llu refused (all in use), peak %u of %d in use\n", app, nOfStarted, nOfCompleted, nOfFailed, nOfAborted,
+	       nOfYields, nOfBusy, nOfInUsePeak, CR_DA_INCMD_ASYNC_MAX_N);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static CrDaInCmdAsync_t* asyncFind(FwSmDesc_t inCmd) {
+	unsigned int i;
+
+	for (i=0; i<CR_DA_INCMD_ASYNC_MAX_N; i++)
+		if (__atomic_load_n(&asyncCont[i].inCmd, __ATOMIC_ACQUIRE) == inCmd)
+			return &asyncCont[i];
+	return NULL;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void asyncFree(CrDaInCmdAsync_t* async) {
+	__atomic_fetch_sub(&nOfInUse, 1, __ATOMIC_RELAXED);
+	__atomic_store_n(&async->inCmd, NULL, __ATOMIC_RELEASE);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void asyncSetOutcome(FwSmDesc_t inCmd, CrFwOutcome_t outcome) {
+	CrFwCmpData_t* cmpData = (CrFwCmpData_t*)FwSmGetData(inCmd);
+
+	cmpData->outcome = outcome;
+}
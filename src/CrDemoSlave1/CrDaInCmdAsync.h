@@ -0,0 +1,203 @@
+/**
+ * @file
+ * @ingroup crDemoSlave1
+ * Interface for the continuations of the long-running InCommands of the demo applications
+ * of the CORDET Demo.
+ * An InManager executes the Progress Action of an InCommand once in each of its
+ * executions until the Progress Action sets its outcome to "completed" (1) or to a
+ * failure code: a long-running InCommand sets its outcome to "continue" (2) and must keep
+ * in its own data how far it has progressed.
+ *
+ * This module lets the Progress Action of such an InCommand be written as one function
+ * which runs from its start to its end and which suspends itself where it must wait:
+ * - The body of the Progress Action is enclosed in <code>#CR_DA_ASYNC_BEGIN</code> and
+ *   <code>#CR_DA_ASYNC_END</code>.
+ *   The first execution of the Progress Action binds a continuation (one of
+ *   <code>#CR_DA_INCMD_ASYNC_MAX_N</code>) to the InCommand; each later execution resumes
+ *   the body where it was suspended.
+ * - <code>#CR_DA_ASYNC_YIELD</code> suspends the body until the next execution of the
+ *   InManager: the step counter of the continuation is incremented and the outcome is
+ *   "continue" so that the framework reports the progress of the InCommand (the progress
+ *   acknowledgement is sent if the source of the InCommand requested it).
+ * - <code>#CR_DA_ASYNC_AWAIT</code> suspends the body until its condition is true (e.g.
+ *   until a transport has received the awaited data) and
+ *   <code>#CR_DA_ASYNC_SLEEP</code> suspends it for a number of cycles (see
+ *   <code>::CrFwGetCurrentCycTime</code>).
+ *   The executions in which the body is still waiting report no progress (see
+ *   <code>::CrDaInCmdAsyncIsWaiting</code>).
+ * - <code>#CR_DA_ASYNC_FAIL</code> terminates the body with a failure code and the end of
+ *   the body completes the InCommand.
+ *   In both cases the continuation is released.
+ * .
+ * The continuations are stackless: the local variables of the Progress Action do not
+ * survive a suspension and the state which the body needs across its suspensions must be
+ * kept in the <code>#CR_DA_INCMD_ASYNC_LOCAL_SIZE</code> bytes of the local state of its
+ * continuation (<code>#CR_DA_ASYNC_LOCAL</code>).
+ * The suspension points are identified by their line numbers: a body may not hold two
+ * suspension points on one line and it may not suspend inside a <code>switch</code>
+ * statement of its own.
+ *
+ * A Progress Action which finds all continuations in use fails with the failure code
+ * <code>#CR_DA_INCMD_ASYNC_FAIL_BUSY</code>.
+ * An InCommand which is aborted while it is suspended must release its continuation:
+ * <code>::CrDaInCmdAsyncAbort</code> is the Abort Action of the kinds of InCommands
+ * whose Progress Action is a continuation.
+ * The continuations are bound and released atomically so that the InCommands may be
+ * executed by the workers of the manager pool (see <code>CrDaMgrPool.h</code>); a
+ * continuation is only used by the InManager of its InCommand.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRDA_INCMDASYNC_H_
+#define CRDA_INCMDASYNC_H_
+
+#include <stddef.h>
+
+/* Include Framework Files */
+#include "CrFwConstants.h"
+#include "CrFwTime.h"
+/* Include Configuration Files */
+#include "CrFwUserConstants.h"
+#include "CrDaConstants.h"
+/* Include FW Profile files */
+#include "FwSmConstants.h"
+
+/** The continuation of an InCommand. */
+typedef struct {
+	/** The InCommand to which the continuation is bound (NULL if it is free). */
+	FwSmDesc_t inCmd;
+	/** The line of the suspension point at which the body resumes (0 at its start). */
+	unsigned int resume;
+	/** The number of times the body has yielded. */
+	unsigned int step;
+	/** The cycle time until which the body sleeps. */
+	CrFwTimeCyc_t wake;
+	/** Flag which is set while the body waits at an await or a sleep. */
+	CrFwBool_t isWaiting;
+	/** The local state of the body. */
+	unsigned char local[CR_DA_INCMD_ASYNC_LOCAL_SIZE];
+} CrDaInCmdAsync_t;
+
+/**
+ * Start or resume the body of the continuation of the InCommand of a Progress Action.
+ * If the continuation cannot be bound, the Progress Action fails with
+ * <code>#CR_DA_INCMD_ASYNC_FAIL_BUSY</code>.
+ * @param smDesc the InCommand (the argument of the Progress Action)
+ */
+#define CR_DA_ASYNC_BEGIN(smDesc) \
+	{ CrDaInCmdAsync_t* crDaAsync = CrDaInCmdAsyncBind(smDesc); \
+	  if (crDaAsync == NULL) return; \
+	  switch (crDaAsync->resume) { case 0:
+
+/** Suspend the body until the next execution of the InManager and report its progress. */
+#define CR_DA_ASYNC_YIELD() \
+	do { crDaAsync->step++; crDaAsync->resume = __LINE__; \
+	     CrDaInCmdAsyncSuspend(crDaAsync, 0); return; case __LINE__:; } while (0)
+
+/**
+ * Suspend the body until a condition is true.
+ * The condition is evaluated in each execution of the InManager.
+ * @param cond the condition
+ */
+#define CR_DA_ASYNC_AWAIT(cond) \
+	do { crDaAsync->resume = __LINE__; case __LINE__: \
+	     if (!(cond)) { CrDaInCmdAsyncSuspend(crDaAsync, 1); return; } \
+	     crDaAsync->isWaiting = 0; } while (0)
+
+/**
+ * Suspend the body for a number of cycles.
+ * @param nOfCycles the number of cycles
+ */
+#define CR_DA_ASYNC_SLEEP(nOfCycles) \
+	do { crDaAsync->wake = CrFwGetCurrentCycTime() + (CrFwTimeCyc_t)(nOfCycles); \
+	     CR_DA_ASYNC_AWAIT(CrDaInCmdAsyncIsDue(crDaAsync)); } while (0)
+
+/**
+ * Terminate the body with a failure code and release its continuation.
+ * @param failCode the failure code (not 1 or 2)
+ */
+#define CR_DA_ASYNC_FAIL(failCode) \
+	do { CrDaInCmdAsyncRelease(crDaAsync, (failCode)); return; } while (0)
+
+/** The local state of the body (a pointer to <code>#CR_DA_INCMD_ASYNC_LOCAL_SIZE</code> bytes). */
+#define CR_DA_ASYNC_LOCAL ((void*)crDaAsync->local)
+
+/** The number of times the body has yielded. */
+#define CR_DA_ASYNC_STEP (crDaAsync->step)
+
+/** End the body: the InCommand is completed and its continuation is released. */
+#define CR_DA_ASYNC_END() \
+	} CrDaInCmdAsyncRelease(crDaAsync, 1); }
+
+/**
+ * Get the continuation of an InCommand and bind a free continuation to it if it has none.
+ * The continuation of an InCommand which starts its body is cleared.
+ * If no continuation is free, the outcome of the InCommand is set to
+ * <code>#CR_DA_INCMD_ASYNC_FAIL_BUSY</code>.
+ * This function is used by <code>#CR_DA_ASYNC_BEGIN</code>.
+ * @param inCmd the InCommand
+ * @return the continuation of the InCommand or NULL if no continuation is free
+ */
+CrDaInCmdAsync_t* CrDaInCmdAsyncBind(FwSmDesc_t inCmd);
+
+/**
+ * Suspend the body of a continuation: the outcome of its InCommand is set to "continue".
+ * This function is used by the suspension points.
+ * @param async the continuation
+ * @param isWaiting 1 if the body waits at an await or a sleep; 0 if it yields
+ */
+void CrDaInCmdAsyncSuspend(CrDaInCmdAsync_t* async, CrFwBool_t isWaiting);
+
+/**
+ * Check whether the sleep of the body of a continuation has elapsed.
+ * This function is used by <code>#CR_DA_ASYNC_SLEEP</code>.
+ * @param async the continuation
+ * @return 1 if the sleep has elapsed; 0 otherwise
+ */
+CrFwBool_t CrDaInCmdAsyncIsDue(const CrDaInCmdAsync_t* async);
+
+/**
+ * Terminate the body of a continuation: the outcome of its InCommand is set to the
+ * argument outcome and the continuation is released.
+ * This function is used by <code>#CR_DA_ASYNC_END</code> and <code>#CR_DA_ASYNC_FAIL</code>.
+ * @param async the continuation
+ * @param outcome the outcome ("completed" or a failure code)
+ */
+void CrDaInCmdAsyncRelease(CrDaInCmdAsync_t* async, CrFwOutcome_t outcome);
+
+/**
+ * Check whether an InCommand is suspended at an await or a sleep.
+ * This function is used by <code>::CrFwRepInCmdOutcome</code> so that the executions of a
+ * waiting InCommand report no progress.
+ * @param inCmd the InCommand
+ * @return 1 if the InCommand is waiting; 0 otherwise
+ */
+CrFwBool_t CrDaInCmdAsyncIsWaiting(FwSmDesc_t inCmd);
+
+/**
+ * Abort Action of the kinds of InCommands whose Progress Action is a continuation: the
+ * continuation of the InCommand is released.
+ * @param smDesc the InCommand
+ */
+void CrDaInCmdAsyncAbort(FwSmDesc_t smDesc);
+
+/**
+ * Print the number of continuations which have been started, completed, failed and
+ * aborted, the number of yields and the peak number of continuations in use.
+ * Nothing is printed if no continuation has been started.
+ * @param app the name of the application (e.g. "MA")
+ */
+void CrDaInCmdAsyncReport(const char* app);
+
+#endif /* CRDA_INCMDASYNC_H_ */
@@ -0,0 +1,126 @@
+/**
+ * @file
+ * @ingroup crDemoSlave1
+ * Interface for the express lane of the InCommands of the demo applications of the
+ * CORDET Demo.
+ * An InCommand waits in the PCRL of its InManager behind the components loaded before it
+ * and it is only executed when the InManagers are executed later in the cycle.
+ *
+ * If the express lane is selected (see <code>#CR_DA_INCMD_EXPRESS</code>), the kinds of
+ * InCommands which are marked as express in the table
+ * <code>#CR_DA_INCMD_INIT_KIND_EXPRESS</code> (e.g. the safety command which disables
+ * the temperature monitoring) bypass the queues of the InManagers:
+ * - The InLoader loads them into the express InManager
+ *   (<code>#CR_DA_INMANAGER_EXPRESS</code>) which holds no other components
+ *   (<code>::CrDaInCmdExpressSelect</code> is the InManager Selection Operation of the
+ *   InLoader).
+ *   If the express InManager is full, an express InCommand is loaded into its normal
+ *   InManager.
+ * - The express InManager is executed as soon as the InLoader has loaded them
+ *   (<code>::CrDaInCmdExpressHandOff</code> is called after each execution of the
+ *   InLoader).
+ *   Hence, the latency of an express InCommand does not depend on the number of
+ *   components which wait in the other InManagers.
+ * - At most <code>#CR_DA_INCMD_EXPRESS_BUDGET</code> express InCommands are executed by
+ *   the hand-offs of a cycle.
+ *   The express InCommands which exceed the budget are executed with the other
+ *   InManagers (<code>::CrDaInCmdExpressExecute</code>).
+ * .
+ * The express InCommands which are batched (see <code>CrDaInCmdBatch.h</code>) are
+ * executed by the hand-off too: the batch is flushed after the express InManager has
+ * been executed.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRDA_INCMDEXPRESS_H_
+#define CRDA_INCMDEXPRESS_H_
+
+/* Include Framework Files */
+#include "CrFwConstants.h"
+/* Include Configuration Files */
+#include "CrFwUserConstants.h"
+#include "CrDaConstants.h"
+
+/** Type for a line of the express table (<code>#CR_DA_INCMD_INIT_KIND_EXPRESS</code>). */
+typedef struct {
+	/** The service type. */
+	CrFwServType_t servType;
+	/** The service sub-type. */
+	CrFwServSubType_t servSubType;
+	/** The discriminant value. */
+	CrFwDiscriminant_t discriminant;
+	/** 1 if the InCommands of the kind are express; 0 otherwise. */
+	CrFwBool_t isExpress;
+} CrDaInCmdExpressKind_t;
+
+/**
+ * Initialize and configure the express InManager.
+ * This function must be called when the application starts after the other InManagers
+ * have been configured.
+ * Nothing is done if the express lane is not selected.
+ * @return 1 if the express InManager is configured; 0 otherwise
+ */
+CrFwBool_t CrDaInCmdExpressInit();
+
+/**
+ * InManager Selection Operation of the InLoader.
+ * The function returns the express InManager for the InCommands of the express kinds
+ * unless it is full.
+ * The InManager of the other components is selected by the InManager chains (see
+ * <code>::CrDaInManagerChainSelect</code>).
+ * @param servType the service type of the component
+ * @param servSubType the service sub-type of the component
+ * @param discriminant the discriminant of the component
+ * @param cmdRepFlag the type of the component (command or report)
+ * @return the identifier of the InManager into which the component is loaded
+ */
+CrFwInstanceId_t CrDaInCmdExpressSelect(CrFwServType_t servType, CrFwServSubType_t servSubType,
+                                        CrFwDiscriminant_t discriminant, CrFwCmdRepType_t cmdRepFlag);
+
+/**
+ * Execute the express InManager if it holds InCommands and the budget of the cycle
+ * allows their execution.
+ * This function must be called after each execution of the InLoader.
+ * Nothing is done if the express lane is not selected.
+ */
+void CrDaInCmdExpressHandOff();
+
+/**
+ * Execute the express InManager if it holds InCommands and restore the budget of the
+ * hand-offs for the next cycle.
+ * This function must be called by the demo applications with the execution of their
+ * other InManagers.
+ * Nothing is done if the express lane is not selected.
+ */
+void CrDaInCmdExpressExecute();
+
+/**
+ * Restore the budget of the hand-offs for the next cycle.
+ * This function must be called after the InManagers (including the express InManager)
+ * have been executed by other means than <code>::CrDaInCmdExpressExecute</code> (e.g. by
+ * the manager pool).
+ * Nothing is done if the express lane is not selected.
+ */
+void CrDaInCmdExpressRelease();
+
+/**
+ * Print the number of express InCommands, the number of them which have been executed
+ * by the hand-offs and the number of cycles in which the budget of the hand-offs has
+ * been exhausted.
+ * Nothing is printed if the express lane is not selected.
+ * @param app the name of the application (e.g. "S1")
+ */
+void CrDaInCmdExpressReport(const char* app);
+
+#endif /* CRDA_INCMDEXPRESS_H_ */
@@ -0,0 +1,102 @@
+/**
+ * @file
+ * @ingroup crDemoSlave1
+ * Implementation of the InLoader drain of the demo applications.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <time.h>
+#include "CrDaInLoad.h"
+#include "CrDaInCmdExpress.h"
+#include "CrDaSmProf.h"
+/* Include FW Profile files */
+#include "FwSmConfig.h"
+#include "FwSmCore.h"
+/* Include framework files */
+#include "InLoader/CrFwInLoader.h"
+#include "InStream/CrFwInStream.h"
+/* Include configuration files */
+#include "CrFwInStreamUserPar.h"
+
+/** The InStream which is served first by the next drain. */
+static unsigned int firstInStream = 0;
+
+/** The InStreams of the application (in the order of their identifiers). */
+static FwSmDesc_t inStreamAll[CR_FW_NOF_INSTREAM];
+
+/** The weights of the InStreams of the application. */
+static const unsigned int inStreamWeight[CR_FW_NOF_INSTREAM] = CR_DA_INSTREAM_LOAD_WEIGHT;
+
+/** The quotas of the InStreams of the application. */
+static const unsigned int inStreamQuota[CR_FW_NOF_INSTREAM] = CR_DA_INSTREAM_LOAD_QUOTA;
+
+/* ---------------------------------------------------------------------------------------------*/
+unsigned int CrDaInLoadDrain(FwSmDesc_t* inStreams, const unsigned int* weight, const unsigned int* quota,
+                             unsigned int nOfInStreams) {
+	struct timespec start, now;
+	unsigned int nOfExec = 0;
+	unsigned int nOfServed, i, k, n;
+	unsigned int nOfLoaded[CR_FW_NOF_INSTREAM];
+	CrFwCounterU1_t nOfPending;
+	CrFwBool_t stuck[CR_FW_NOF_INSTREAM];
+
+	if (nOfInStreams == 0)
+		return 0;
+	if (nOfInStreams > CR_FW_NOF_INSTREAM)
+		nOfInStreams = CR_FW_NOF_INSTREAM;
+	for (i=0; i<nOfInStreams; i++) {
+		stuck[i] = 0;
+		nOfLoaded[i] = 0;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	do {
+		/* One round-robin pass: up to its weight of packets from each non-empty InStream */
+		nOfServed = 0;
+		for (k=0; (k<nOfInStreams) && (nOfExec<CR_DA_IN_LOAD_MAX_PCKTS); k++) {
+			i = (firstInStream + k) % nOfInStreams;
+			for (n=0; (n<weight[i]) && !stuck[i] && (nOfLoaded[i]<quota[i]) && (nOfExec<CR_DA_IN_LOAD_MAX_PCKTS); n++) {
+				nOfPending = CrFwInStreamGetNOfPendingPckts(inStreams[i]);
+				if (nOfPending == 0)
+					break;
+				CrFwInLoaderSetInStream(inStreams[i]);
+				CR_DA_SM_EXECUTE(CrFwInLoaderMake());
+				CrDaInCmdExpressHandOff();
+				nOfExec++;
+				nOfServed++;
+				nOfLoaded[i]++;
+				if (CrFwInStreamGetNOfPendingPckts(inStreams[i]) >= nOfPending)
+					stuck[i] = 1;
+			}
+		}
+
+		/* Check the time budget */
+		clock_gettime(CLOCK_MONOTONIC, &now);
+		if ((now.tv_sec - start.tv_sec) * 1000000L + (now.tv_nsec - start.tv_nsec) / 1000 >= CR_DA_IN_LOAD_MAX_USEC)
+			break;
+	} while ((nOfServed > 0) && (nOfExec < CR_DA_IN_LOAD_MAX_PCKTS));
+
+	firstInStream = (firstInStream + 1) % nOfInStreams;
+	return nOfExec;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+unsigned int CrDaInLoadAll() {
+	CrFwInstanceId_t i;
+
+	if (inStreamAll[0] == NULL)
+		for (i=0; i<CR_FW_NOF_INSTREAM; i++)
+			inStreamAll[i] = CrFwInStreamMake(i);
+	return CrDaInLoadDrain(inStreamAll, inStreamWeight, inStreamQuota, CR_FW_NOF_INSTREAM);
+}
@@ -0,0 +1,85 @@
+/**
+ * @file
+ * @ingroup crDemoSlave1
+ * Interface for the InLoader drain of the demo applications of the CORDET Demo.
+ * An execution of the InLoader loads at most one packet from its InStream.
+ * If the InLoader is executed once per InStream in every control cycle, a demo
+ * application therefore takes at most one packet per InStream and per cycle and a
+ * backlog of packets which has accumulated in an InStream is only cleared over many
+ * cycles.
+ *
+ * The InLoader drain (<code>::CrDaInLoadDrain</code>) instead executes the InLoader on
+ * a set of InStreams until all InStreams are empty or until the budget of the drain is
+ * exhausted.
+ * The budget is defined by a maximum number of packets
+ * (<code>#CR_DA_IN_LOAD_MAX_PCKTS</code>) and a maximum duration
+ * (<code>#CR_DA_IN_LOAD_MAX_USEC</code>).
+ * The InStreams are served in weighted round-robin: in each pass of the drain, up to
+ * its weight of packets is loaded from each non-empty InStream in turn and the InStream
+ * which is served first is rotated from one drain to the next one.
+ * An InStream is not served any more by a drain once it has loaded its quota of packets
+ * in the drain.
+ * Hence, an InStream with a large backlog cannot starve the other InStreams.
+ *
+ * The demo applications drain all their InStreams with <code>::CrDaInLoadAll</code>
+ * which takes the weights and quotas of the InStreams from the InStream configuration
+ * (<code>#CR_DA_INSTREAM_LOAD_WEIGHT</code> and <code>#CR_DA_INSTREAM_LOAD_QUOTA</code>).
+ * An InStream which is added to the configuration of an application is therefore served
+ * without changes to the application code.
+ *
+ * The packets loaded by the InLoader are held by the InManagers until their next
+ * execution.
+ * The packet budget should therefore not be larger than the size of the Pending
+ * Command/Report Lists of the InManagers (<code>#CR_FW_INMANAGER_PCRLSIZE</code>)
+ * since the InLoader rejects the packets which cannot be loaded into a full list.
+ * The express InCommands are handed off after each execution of the InLoader (see
+ * <code>CrDaInCmdExpress.h</code>).
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRDA_INLOAD_H_
+#define CRDA_INLOAD_H_
+
+/* Include FW Profile files */
+#include "FwSmConstants.h"
+/* Include Framework Files */
+#include "CrFwConstants.h"
+/* Include Configuration Files */
+#include "CrFwUserConstants.h"
+#include "CrDaConstants.h"
+
+/**
+ * Execute the InLoader on a set of InStreams until they are empty, until they have
+ * loaded their quotas or until the budget of the drain is exhausted.
+ * An InStream whose number of pending packets is not decreased by an execution of the
+ * InLoader is not served again in the same drain.
+ * @param inStreams the InStreams
+ * @param weight the maximum number of packets loaded from each InStream in one pass
+ * of the drain (each weight must be positive)
+ * @param quota the maximum number of packets loaded from each InStream in the drain
+ * @param nOfInStreams the number of InStreams (at most <code>#CR_FW_NOF_INSTREAM</code>)
+ * @return the number of executions of the InLoader
+ */
+unsigned int CrDaInLoadDrain(FwSmDesc_t* inStreams, const unsigned int* weight, const unsigned int* quota,
+                             unsigned int nOfInStreams);
+
+/**
+ * Execute the InLoader drain on all the InStreams of the application with the weights
+ * and quotas of their configuration.
+ * The InStreams must have been created before this function is called.
+ * @return the number of executions of the InLoader
+ */
+unsigned int CrDaInLoadAll();
+
+#endif /* CRDA_INLOAD_H_ */
@@ -0,0 +1,211 @@
+/**
+ * @file
+ * @ingroup crDemoSlave1
+ * Implementation of the InManager chains of the demo applications.
+ * The spill InManager k is the InManager with identifier
+ * <code>#CR_DA_INMANAGER_NOF_PRIMARY</code>+k.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdio.h>
+#include "CrDaInManagerChain.h"
+#include "CrDaSmExec.h"
+#include "CrDaSmProf.h"
+/* Include FW Profile files */
+#include "FwSmConfig.h"
+#include "FwSmCore.h"
+/* Include framework files */
+#include "BaseCmp/CrFwBaseCmp.h"
+#include "InLoader/CrFwInLoader.h"
+#include "InManager/CrFwInManager.h"
+
+#if (CR_DA_INMANAGER_SPILL == 1)
+/** The index which marks the end of a list of spill InManagers. */
+#define CR_DA_INMANAGER_CHAIN_END (-1)
+
+/** The next spill InManager in the chain or in the free list of each spill InManager. */
+static int spillNext[CR_DA_INMANAGER_NOF_SPILL];
+
+/** The first spill InManager of the free list. */
+static int freeHead = CR_DA_INMANAGER_CHAIN_END;
+
+/** The first spill InManager of the chain of each primary InManager. */
+static int chainHead[CR_DA_INMANAGER_NOF_PRIMARY];
+
+/** The last spill InManager of the chain of each primary InManager. */
+static int chainTail[CR_DA_INMANAGER_NOF_PRIMARY];
+
+/** The number of spill InManagers in use. */
+static unsigned int nOfInUse = 0;
+
+/** The largest number of spill InManagers in use at the same time. */
+static unsigned int maxInUse = 0;
+
+/** The number of spill InManagers which have been taken from the free list. */
+static unsigned long long nOfTaken = 0;
+
+/** The number of components which have been directed to spill InManagers. */
+static unsigned long long nOfSpilled = 0;
+
+/**
+ * Return a spill InManager.
+ * @param k the index of the spill InManager
+ * @return the spill InManager
+ */
+static FwSmDesc_t spillInManager(int k);
+
+/**
+ * Walk the chain of a primary InManager and return the spill InManagers which no longer
+ * hold pending components to the free list.
+ * @param primary the identifier of the primary InManager
+ * @param execute 1 if the spill InManagers must be executed before they are checked
+ */
+static void chainWalk(CrFwInstanceId_t primary, CrFwBool_t execute);
+#endif
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaInManagerChainInit() {
+#if (CR_DA_INMANAGER_SPILL == 1)
+	FwSmDesc_t inManager;
+	int k;
+
+	for (k=0; k<CR_DA_INMANAGER_NOF_SPILL; k++) {
+		inManager = spillInManager(k);
+		CrFwCmpInit(inManager);
+		if (!CrFwCmpIsInInitialized(inManager))
+			return 0;
+		CrFwCmpReset(inManager);
+		if (!CrFwCmpIsInConfigured(inManager))
+			return 0;
+		spillNext[k] = (k+1 < CR_DA_INMANAGER_NOF_SPILL) ? k+1 : CR_DA_INMANAGER_CHAIN_END;
+	}
+	freeHead = (CR_DA_INMANAGER_NOF_SPILL > 0) ? 0 : CR_DA_INMANAGER_CHAIN_END;
+	for (k=0; k<CR_DA_INMANAGER_NOF_PRIMARY; k++) {
+		chainHead[k] = CR_DA_INMANAGER_CHAIN_END;
+		chainTail[k] = CR_DA_INMANAGER_CHAIN_END;
+	}
+	nOfInUse = 0;
+#endif
+	return 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwInstanceId_t CrDaInManagerChainSelect(CrFwServType_t servType, CrFwServSubType_t servSubType,
+        CrFwDiscriminant_t discriminant, CrFwCmdRepType_t cmdRepFlag) {
+	CrFwInstanceId_t primary = CrFwInLoaderDefGetInManager(servType, servSubType, discriminant, cmdRepFlag);
+#if (CR_DA_INMANAGER_SPILL == 1)
+	FwSmDesc_t last;
+	int k, tail;
+
+	if (primary >= CR_DA_INMANAGER_NOF_PRIMARY)
+		return primary;
+
+	/* The last InManager of the chain receives the component unless it is full */
+	tail = chainTail[primary];
+	last = (tail == CR_DA_INMANAGER_CHAIN_END) ? CrFwInManagerMake(primary) : spillInManager(tail);
+	if ((CrFwInManagerGetNOfPendingInCmp(last) < CrFwInManagerGetPCRLSize(last)) ||
+	        (freeHead == CR_DA_INMANAGER_CHAIN_END)) {
+		if (tail == CR_DA_INMANAGER_CHAIN_END)
+			return primary;
+		nOfSpilled++;
+		return (CrFwInstanceId_t)(CR_DA_INMANAGER_NOF_PRIMARY + tail);
+	}
+
+	/* Append a spill InManager from the free list to the chain */
+	k = freeHead;
+	freeHead = spillNext[k];
+	spillNext[k] = CR_DA_INMANAGER_CHAIN_END;
+	if (tail == CR_DA_INMANAGER_CHAIN_END)
+		chainHead[primary] = k;
+	else
+		spillNext[tail] = k;
+	chainTail[primary] = k;
+	nOfTaken++;
+	nOfInUse++;
+	if (nOfInUse > maxInUse)
+		maxInUse = nOfInUse;
+	nOfSpilled++;
+	return (CrFwInstanceId_t)(CR_DA_INMANAGER_NOF_PRIMARY + k);
+#else
+	return primary;
+#endif
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaInManagerChainExecute(CrFwInstanceId_t primary) {
+	CrDaSmExecInManager(CrFwInManagerMake(primary));
+#if (CR_DA_INMANAGER_SPILL == 1)
+	if (primary < CR_DA_INMANAGER_NOF_PRIMARY)
+		chainWalk(primary, 1);
+#endif
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaInManagerChainRelease() {
+#if (CR_DA_INMANAGER_SPILL == 1)
+	CrFwInstanceId_t primary;
+
+	for (primary=0; primary<CR_DA_INMANAGER_NOF_PRIMARY; primary++)
+		chainWalk(primary, 0);
+#endif
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaInManagerChainReport(const char* app) {
+#if (CR_DA_INMANAGER_SPILL == 1)
+	printf("%s: InManager chains: %llu components spilled, %llu spill InManagers taken, %u of %d in use at most\n",
+	       app, nOfSpilled, nOfTaken, maxInUse, CR_DA_INMANAGER_NOF_SPILL);
+#else
+	(void)app;
+#endif
+}
+
+#if (CR_DA_INMANAGER_SPILL == 1)
+/* ---------------------------------------------------------------------------------------------*/
+static FwSmDesc_t spillInManager(int k) {
+	return CrFwInManagerMake((CrFwInstanceId_t)(CR_DA_INMANAGER_NOF_PRIMARY + k));
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void chainWalk(CrFwInstanceId_t primary, CrFwBool_t execute) {
+	int prev = CR_DA_INMANAGER_CHAIN_END;
+	int k = chainHead[primary];
+	int next;
+	FwSmDesc_t inManager;
+
+	while (k != CR_DA_INMANAGER_CHAIN_END) {
+		next = spillNext[k];
+		inManager = spillInManager(k);
+		if (execute)
+			CR_DA_SM_EXECUTE(inManager);
+		if (CrFwInManagerGetNOfPendingInCmp(inManager) > 0) {
+			prev = k;
+			k = next;
+			continue;
+		}
+
+		/* Unlink the empty spill InManager and return it to the free list */
+		if (prev == CR_DA_INMANAGER_CHAIN_END)
+			chainHead[primary] = next;
+		else
+			spillNext[prev] = next;
+		if (chainTail[primary] == k)
+			chainTail[primary] = prev;
+		spillNext[k] = freeHead;
+		freeHead = k;
+		nOfInUse--;
+		k = next;
+	}
+}
+#endif
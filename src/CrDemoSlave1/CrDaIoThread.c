@@ -0,0 +1,492 @@
+/**
+ * @file
+ * @ingroup crDemoSlave1
+ * Implementation of the I/O thread of the demo applications.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include "CrDaIoThread.h"
+#include "CrDaLatTrace.h"
+#include "CrDaStreamMap.h"
+#include "CrDaThread.h"
+
+#if (CR_DA_IO_THREAD == 1)
+
+#if (CR_FW_PCKT_LOCK_FREE == 0)
+#error "The I/O thread requires the lock-free packet pool (CR_FW_PCKT_LOCK_FREE)"
+#endif
+#if (CR_DA_SHM_TRANSPORT == 1)
+#error "The I/O thread cannot be combined with the shared-memory transport"
+#endif
+#if (CR_DA_IO_THREAD_PIPELINE == 1) && (CR_DA_CYCLE_EVENT_DRIVEN == 1)
+#error "The pipelined cycle cannot be combined with the event-driven cycle"
+#endif
+
+#include <stdio.h>
+#include <errno.h>
+#include <time.h>
+#include <limits.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+/* Include FW Profile files */
+#include "FwSmConstants.h"
+#include "FwSmConfig.h"
+#include "FwSmCore.h"
+/* Include framework files */
+#include "InStream/CrFwInStream.h"
+#include "Pckt/CrFwPckt.h"
+#include "CrFwPcktRefCnt.h"
+
+/** The size of a cache line (the head and tail of a ring are kept in different cache lines). */
+#define CR_DA_IO_THREAD_CACHE_LINE 64
+
+/** Type for a lock-free single-producer single-consumer ring of packets. */
+typedef struct {
+	/** The head counter of the ring (only written by the producer). */
+	unsigned int head;
+	/** Padding which places the tail in a different cache line than the head. */
+	unsigned char pad1[CR_DA_IO_THREAD_CACHE_LINE-sizeof(unsigned int)];
+	/** The tail counter of the ring (only written by the consumer). */
+	unsigned int tail;
+	/** Padding which places the slots in a different cache line than the tail. */
+	unsigned char pad2[CR_DA_IO_THREAD_CACHE_LINE-sizeof(unsigned int)];
+	/** The slots of the ring. */
+	CrFwPckt_t slot[CR_DA_IO_THREAD_RING_SIZE];
+} CrDaIoThreadRing_t;
+
+/** The incoming ring (produced by the I/O thread and consumed by the framework thread). */
+static CrDaIoThreadRing_t inRing;
+
+/** The outgoing ring (produced by the framework thread and consumed by the I/O thread). */
+static CrDaIoThreadRing_t outRing;
+
+/** The futex word which is incremented whenever the I/O thread pushes packets into the incoming ring. */
+static int wakeSeq = 0;
+
+/** Flag which is set while the framework thread is waiting on the futex. */
+static int wakeWaiting = 0;
+
+/** The transport of the I/O thread (NULL if the I/O thread is not running). */
+static const CrDaIoTransport_t* ioTransport = NULL;
+
+/** The I/O thread. */
+static pthread_t ioThread;
+
+/** Flag which is set to request the termination of the I/O thread. */
+static int ioStop = 0;
+
+/**
+ * Flag which is set by the I/O thread when it has left packets in the transport
+ * because the incoming ring was full.
+ */
+static CrFwBool_t inBlocked = 0;
+
+/**
+ * The number of packets which have been collected by the InStreams.
+ * The counter is used by <code>::CrDaIoThreadWait</code> to detect the arrival of packets.
+ */
+static unsigned int nOfCollected = 0;
+
+#if (CR_DA_IO_THREAD_PIPELINE == 1)
+/**
+ * The end of the batch of incoming packets of the current cycle (the head of the
+ * incoming ring when the cycle polled it).
+ */
+static unsigned int inBatchEnd = 0;
+
+/**
+ * The head of the batch of outgoing packets of the current cycle.
+ * The packets between the head of the outgoing ring and this counter have been written
+ * into the ring but they are not yet visible to the I/O thread.
+ */
+static unsigned int outBatchHead = 0;
+
+/** The number of batches of the pipelined cycle. */
+static unsigned long long nOfBatches = 0;
+
+/** The total number of packets of the incoming batches. */
+static unsigned long long nOfInBatchPckts = 0;
+
+/** The total number of packets of the outgoing batches. */
+static unsigned long long nOfOutBatchPckts = 0;
+
+/** The peak number of packets of an incoming batch. */
+static unsigned int inBatchPeak = 0;
+
+/** The peak number of packets of an outgoing batch. */
+static unsigned int outBatchPeak = 0;
+#endif
+
+/**
+ * Push a packet into a ring.
+ * This function must only be called by the producer of the ring.
+ * @param ring the ring
+ * @param pckt the packet
+ * @return 1 if the packet was pushed; 0 if the ring is full
+ */
+static CrFwBool_t ioRingPush(CrDaIoThreadRing_t* ring, CrFwPckt_t pckt);
+
+/**
+ * Check whether a ring is full.
+ * This function must only be called by the producer of the ring.
+ * @param ring the ring
+ * @return 1 if the ring is full; 0 otherwise
+ */
+static CrFwBool_t ioRingIsFull(CrDaIoThreadRing_t* ring);
+
+/**
+ * Return the packet at the head of a ring without removing it.
+ * This function must only be called by the consumer of the ring.
+ * @param ring the ring
+ * @return the packet or NULL if the ring is empty
+ */
+static CrFwPckt_t ioRingPeek(CrDaIoThreadRing_t* ring);
+
+/**
+ * Remove the packet at the head of a ring.
+ * This function must only be called by the consumer of the ring and only if the
+ * ring is not empty.
+ * @param ring the ring
+ */
+static void ioRingPop(CrDaIoThreadRing_t* ring);
+
+/**
+ * Return the packet at the head of the incoming ring without removing it.
+ * If the pipelined cycle is selected, only the packets of the batch of the current
+ * cycle are returned.
+ * This function must only be called by the framework thread.
+ * @return the packet or NULL if the ring (or the batch) is empty
+ */
+static CrFwPckt_t ioInPeek();
+
+/**
+ * Packet Available Function which the I/O thread sets on its transport.
+ * The function collects the packets from the source and pushes them into the incoming
+ * ring until the transport holds no further packet from the source or the ring is full.
+ * @param src the source of the packets
+ */
+static void ioThreadPcktAvail(CrFwDestSrc_t src);
+
+/**
+ * The body of the I/O thread.
+ * @param arg unused
+ * @return always NULL
+ */
+static void* ioThreadRun(void* arg);
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaIoThreadStart(const CrDaIoTransport_t* transport) {
+	int err;
+
+	if (ioTransport != NULL)
+		return 0;
+
+	inRing.head = 0;
+	inRing.tail = 0;
+	outRing.head = 0;
+	outRing.tail = 0;
+	inBlocked = 0;
+#if (CR_DA_IO_THREAD_PIPELINE == 1)
+	inBatchEnd = 0;
+	outBatchHead = 0;
+#endif
+	__atomic_store_n(&ioStop, 0, __ATOMIC_RELAXED);
+
+	ioTransport = transport;
+	ioTransport->setPcktAvail(&ioThreadPcktAvail);
+	err = pthread_create(&ioThread, NULL, &ioThreadRun, NULL);
+	if (err != 0) {
+		errno = err;
+		perror("CrDaIoThreadStart, thread creation");
+		ioTransport->setPcktAvail(NULL);
+		ioTransport = NULL;
+		return 0;
+	}
+	return 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaIoThreadStop() {
+	CrFwPckt_t pckt;
+
+	if (ioTransport == NULL)
+		return;
+
+	__atomic_store_n(&ioStop, 1, __ATOMIC_RELEASE);
+	pthread_join(ioThread, NULL);
+	ioTransport->setPcktAvail(NULL);
+	ioTransport = NULL;
+
+	/* The rings are now only accessed by this thread */
+	while ((pckt = ioRingPeek(&inRing)) != NULL) {
+		ioRingPop(&inRing);
+		CrFwPcktRelease(pckt);
+	}
+	while ((pckt = ioRingPeek(&outRing)) != NULL) {
+		ioRingPop(&outRing);
+		CrFwPcktRelease(pckt);
+	}
+#if (CR_DA_IO_THREAD_PIPELINE == 1)
+	/* The batch of the last cycle was never passed to the I/O thread */
+	for (; outRing.head != outBatchHead; outRing.head++)
+		CrFwPcktRelease(outRing.slot[outRing.head & (CR_DA_IO_THREAD_RING_SIZE-1)]);
+#endif
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaIoThreadPoll() {
+	CrFwPckt_t pckt;
+	unsigned int tail;
+
+#if (CR_DA_IO_THREAD_PIPELINE == 1)
+	/* The batch of the cycle: the packets pushed from now on belong to the next cycle */
+	inBatchEnd = __atomic_load_n(&inRing.head, __ATOMIC_ACQUIRE);
+	nOfInBatchPckts += inBatchEnd - inRing.tail;
+	if (inBatchEnd - inRing.tail > inBatchPeak)
+		inBatchPeak = inBatchEnd - inRing.tail;
+#endif
+	while ((pckt = ioInPeek()) != NULL) {
+		tail = inRing.tail;
+		CrFwInStreamPcktAvail(CrDaStreamMapGetInStream(CrFwPcktGetSrc(pckt)));
+		if (inRing.tail == tail)	/* the InStream has not collected the packet */
+			return;
+	}
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaIoThreadWait(unsigned int period) {
+#if (CR_DA_IO_THREAD_PIPELINE == 1)
+	struct timespec req;
+	unsigned int n = outBatchHead - outRing.head;
+
+	/* End the cycle: its outgoing packets are passed to the I/O thread as one batch */
+	__atomic_store_n(&outRing.head, outBatchHead, __ATOMIC_RELEASE);
+	nOfBatches++;
+	nOfOutBatchPckts += n;
+	if (n > outBatchPeak)
+		outBatchPeak = n;
+
+	req.tv_sec = (time_t)(period/1000);
+	req.tv_nsec = (long)(period%1000)*1000000L;
+	if (period > 0)
+		while (nanosleep(&req, &req) == EINTR)
+			;
+	return 0;
+#else
+	struct timespec req, now, end;
+	unsigned int collected = nOfCollected;
+	long timeout;
+	int seen;
+
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	end.tv_sec = end.tv_sec + (time_t)(period/1000);
+	end.tv_nsec = end.tv_nsec + (long)(period%1000)*1000000L;
+	if (end.tv_nsec >= 1000000000L) {
+		end.tv_sec++;
+		end.tv_nsec = end.tv_nsec - 1000000000L;
+	}
+
+	/* Packets pushed after this point change the futex word and end the wait */
+	seen = __atomic_load_n(&wakeSeq, __ATOMIC_SEQ_CST);
+	CrDaIoThreadPoll();
+
+	for (;;) {
+		clock_gettime(CLOCK_MONOTONIC, &now);
+		timeout = (long)(end.tv_sec - now.tv_sec)*1000000000L + (end.tv_nsec - now.tv_nsec);
+		if (timeout <= 0)
+			return 0;
+		if (nOfCollected != collected)
+			return 1;
+		req.tv_sec = (time_t)(timeout/1000000000L);
+		req.tv_nsec = timeout%1000000000L;
+
+		__atomic_store_n(&wakeWaiting, 1, __ATOMIC_SEQ_CST);
+		syscall(SYS_futex, &wakeSeq, FUTEX_WAIT_PRIVATE, seen, &req, NULL, 0);
+		__atomic_store_n(&wakeWaiting, 0, __ATOMIC_SEQ_CST);
+
+		if (__atomic_load_n(&wakeSeq, __ATOMIC_SEQ_CST) != seen) {
+			seen = __atomic_load_n(&wakeSeq, __ATOMIC_SEQ_CST);
+			CrDaIoThreadPoll();
+		}
+	}
+#endif
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwPckt_t CrDaIoThreadPcktCollect(CrFwDestSrc_t src) {
+	CrFwPckt_t pckt;
+
+	pckt = ioInPeek();
+	if ((pckt == NULL) || (CrFwPcktGetSrc(pckt) != src))
+		return NULL;
+
+	ioRingPop(&inRing);
+	nOfCollected++;
+	return pckt;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaIoThreadIsPcktAvail(CrFwDestSrc_t src) {
+	CrFwPckt_t pckt;
+
+	pckt = ioInPeek();
+	return ((pckt != NULL) && (CrFwPcktGetSrc(pckt) == src));
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaIoThreadPcktHandover(CrFwPckt_t pckt) {
+#if (CR_DA_IO_THREAD_PIPELINE == 1)
+	/* The batch of the cycle and the batch which the I/O thread is sending share the ring */
+	if (outBatchHead - __atomic_load_n(&outRing.tail, __ATOMIC_ACQUIRE) == CR_DA_IO_THREAD_RING_SIZE)
+		return 0;
+
+	CrDaLatTraceTx(pckt);
+	CrFwPcktRetain(pckt);
+	outRing.slot[outBatchHead & (CR_DA_IO_THREAD_RING_SIZE-1)] = pckt;
+	outBatchHead++;
+	return 1;
+#else
+	if (ioRingIsFull(&outRing))
+		return 0;
+
+	/* The reference of the OutStream is released when the hand-over succeeds */
+	CrDaLatTraceTx(pckt);
+	CrFwPcktRetain(pckt);
+	return ioRingPush(&outRing, pckt);
+#endif
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaIoThreadIsOutEmpty() {
+#if (CR_DA_IO_THREAD_PIPELINE == 1)
+	return (__atomic_load_n(&outRing.tail, __ATOMIC_ACQUIRE) == outBatchHead);
+#else
+	return (__atomic_load_n(&outRing.tail, __ATOMIC_ACQUIRE) == outRing.head);
+#endif
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaIoThreadReport(const char* app) {
+#if (CR_DA_IO_THREAD_PIPELINE == 1)
+	if (nOfBatches == 0)
+		return;
+	printf("%s: Pipelined cycle: %llu batches, %.1f incoming packets per batch (peak %u), "
+	       "%.1f outgoing packets per batch (peak %u)\n", app, nOfBatches,
+	       (double)nOfInBatchPckts/(double)nOfBatches, inBatchPeak,
+	       (double)nOfOutBatchPckts/(double)nOfBatches, outBatchPeak);
+#else
+	(void)app;
+#endif
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void* ioThreadRun(void* arg) {
+	CrFwPckt_t pckt;
+
+	(void)arg;
+	CrDaThreadPlace(crDaThreadIo);
+	while (!__atomic_load_n(&ioStop, __ATOMIC_ACQUIRE)) {
+		/* Hand the outgoing packets over to the transport (a full transport is retried later) */
+		while ((pckt = ioRingPeek(&outRing)) != NULL) {
+			if (!ioTransport->pcktHandover(pckt))
+				break;
+			ioRingPop(&outRing);
+			CrFwPcktRelease(pckt);
+		}
+
+		/* Collect the packets which were left in the transport while the incoming ring was full */
+		if (inBlocked) {
+			inBlocked = 0;
+			ioTransport->poll();
+		}
+
+		ioTransport->wait(CR_DA_IO_THREAD_WAIT_PERIOD);
+	}
+	return NULL;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void ioThreadPcktAvail(CrFwDestSrc_t src) {
+	CrFwPckt_t pckt;
+	CrFwBool_t pushed = 0;
+
+	for (;;) {
+		if (ioRingIsFull(&inRing)) {
+			inBlocked = 1;
+			break;
+		}
+		pckt = ioTransport->pcktCollect(src);
+		if (pckt == NULL)
+			break;
+		ioRingPush(&inRing, pckt);
+		pushed = 1;
+	}
+
+	/* Wake up the framework thread only if it is sleeping in CrDaIoThreadWait */
+	if (pushed) {
+		__atomic_add_fetch(&wakeSeq, 1, __ATOMIC_SEQ_CST);
+		if (__atomic_load_n(&wakeWaiting, __ATOMIC_SEQ_CST))
+			syscall(SYS_futex, &wakeSeq, FUTEX_WAKE_PRIVATE, INT_MAX, NULL, NULL, 0);
+	}
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static CrFwBool_t ioRingPush(CrDaIoThreadRing_t* ring, CrFwPckt_t pckt) {
+	unsigned int head = ring->head;
+
+	if (head - __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE) == CR_DA_IO_THREAD_RING_SIZE)
+		return 0;
+	ring->slot[head & (CR_DA_IO_THREAD_RING_SIZE-1)] = pckt;
+	__atomic_store_n(&ring->head, head + 1, __ATOMIC_RELEASE);
+	return 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static CrFwBool_t ioRingIsFull(CrDaIoThreadRing_t* ring) {
+	return (ring->head - __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE) == CR_DA_IO_THREAD_RING_SIZE);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static CrFwPckt_t ioRingPeek(CrDaIoThreadRing_t* ring) {
+	unsigned int tail = ring->tail;
+
+	if (__atomic_load_n(&ring->head, __ATOMIC_ACQUIRE) == tail)
+		return NULL;
+	return ring->slot[tail & (CR_DA_IO_THREAD_RING_SIZE-1)];
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void ioRingPop(CrDaIoThreadRing_t* ring) {
+	__atomic_store_n(&ring->tail, ring->tail + 1, __ATOMIC_RELEASE);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static CrFwPckt_t ioInPeek() {
+#if (CR_DA_IO_THREAD_PIPELINE == 1)
+	if (inRing.tail == inBatchEnd)
+		return NULL;
+#endif
+	return ioRingPeek(&inRing);
+}
+
+#else
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaIoThreadReport(const char* app) {
+	(void)app;
+}
+
+#endif /* CR_DA_IO_THREAD */
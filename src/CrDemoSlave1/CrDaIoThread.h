@@ -0,0 +1,206 @@
+/**
+ * @file
+ * @ingroup crDemoSlave1
+ * Interface for the I/O thread of the demo applications of the CORDET Demo.
+ * The I/O thread owns the socket of a demo application (the transport of the I/O
+ * thread, see <code>::CrDaIoTransport_t</code>): it is the only thread which reads
+ * from and writes to the socket and which frames the incoming packets into the packet
+ * pool.
+ * The framework components of the application (InStreams, OutStreams, InLoader,
+ * Managers) are executed by another thread (the framework thread).
+ * The two threads exchange packets through two lock-free single-producer
+ * single-consumer rings of <code>#CR_DA_IO_THREAD_RING_SIZE</code> packets each:
+ * - The incoming ring carries the packets received by the I/O thread to the InStreams.
+ *   The I/O thread diverts the packets away from the InStreams by setting its own
+ *   Packet Available Function on the transport, collects them from the transport and
+ *   pushes them into the ring.
+ *   The InStreams pop them from the ring in their Packet Collect and Packet Available
+ *   Check Operations (<code>::CrDaIoThreadPcktCollect</code> and
+ *   <code>::CrDaIoThreadIsPcktAvail</code>).
+ * - The outgoing ring carries the packets handed over by the OutStreams
+ *   (<code>::CrDaIoThreadPcktHandover</code>) to the I/O thread which hands them over
+ *   to the transport.
+ *   The packets are not copied: the OutStream's reference to a packet is taken over by
+ *   the ring through <code>::CrFwPcktRetain</code> and the packet is released by the
+ *   I/O thread when the transport has accepted it.
+ * .
+ * Since the packets are made and released by both threads, the I/O thread requires
+ * the lock-free packet pool (<code>#CR_FW_PCKT_LOCK_FREE</code>).
+ *
+ * The slow parts of the I/O (system calls, framing, partial writes) are thereby moved
+ * out of the control cycle and they can be executed on another core.
+ * The framework thread polls the incoming ring with <code>::CrDaIoThreadPoll</code>
+ * and waits for incoming packets with <code>::CrDaIoThreadWait</code> which sleeps on
+ * a futex which is woken by the I/O thread when it pushes packets.
+ *
+ * If an incoming ring is full, the I/O thread leaves the packets in the transport
+ * which in turn stops reading from the socket (backpressure towards the sender).
+ * If the outgoing ring is full, the Packet Hand-Over Operation fails and the packet
+ * remains in the packet queue of its OutStream.
+ *
+ * If the pipelined cycle is selected (<code>#CR_DA_IO_THREAD_PIPELINE</code>), the stages
+ * of the control cycles overlap: while the framework thread processes the packets of
+ * cycle n, the I/O thread receives the packets of cycle n+1 and sends those of cycle n-1.
+ * Each ring then holds two batches:
+ * - The batch of the incoming packets of a cycle is fixed when the cycle polls the
+ *   incoming ring (<code>::CrDaIoThreadPoll</code>): only the packets which the I/O
+ *   thread had pushed at that point are passed to the InStreams and the packets which
+ *   arrive while the cycle is processed form the batch of the next cycle.
+ * - The packets handed over by the OutStreams during a cycle are written into the
+ *   outgoing ring but they are only made visible to the I/O thread as one batch at the
+ *   end of the cycle (<code>::CrDaIoThreadWait</code>).
+ * .
+ * The time taken by the framework thread for a cycle is then bounded by its own
+ * stage: the arrival of a burst does not extend the input of a cycle and the sending of
+ * its output is not interleaved with its processing.
+ * The throughput of the free-running cycles approaches that of the slowest of the I/O
+ * thread and the framework thread rather than that of both stages in sequence.
+ * The other stages of the packets are unchanged: a packet of a batch is still retained
+ * by the outgoing ring until the transport has accepted it; a packet which arrives
+ * during cycle n is executed in cycle n+1 (as it is in the cyclic mode without the I/O
+ * thread) and the packets of the outgoing batch of a cycle wait for at most
+ * <code>#CR_DA_IO_THREAD_WAIT_PERIOD</code> until the I/O thread starts sending them.
+ * The statistics of the batches are printed by <code>::CrDaIoThreadReport</code>.
+ *
+ * The InStreams and OutStreams are initialized and configured by the framework thread
+ * through the initialization and configuration actions of the transport before the
+ * I/O thread is started (<code>::CrDaIoThreadStart</code>), and they must not be
+ * reset or shut down while the I/O thread is running.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRDA_IOTHREAD_H_
+#define CRDA_IOTHREAD_H_
+
+/* Include Framework Files */
+#include "CrFwConstants.h"
+/* Include Configuration Files */
+#include "CrFwUserConstants.h"
+#include "CrDaConstants.h"
+
+/**
+ * Type for the transport of the I/O thread.
+ * The transport is described by the functions of a socket module
+ * (e.g. <code>::CrDaClientSocketPoll</code>, <code>::CrDaClientSocketWait</code>, ...).
+ */
+typedef struct {
+	/** The function which sets the Packet Available Function of the transport. */
+	void (*setPcktAvail)(void (*avail)(CrFwDestSrc_t src));
+	/** The function which polls the transport. */
+	void (*poll)();
+	/** The function which waits for incoming packets while servicing the transport. */
+	CrFwBool_t (*wait)(unsigned int period);
+	/** The Packet Collect Operation of the transport. */
+	CrFwPckt_t (*pcktCollect)(CrFwDestSrc_t src);
+	/** The Packet Hand-Over Operation of the transport. */
+	CrFwBool_t (*pcktHandover)(CrFwPckt_t pckt);
+} CrDaIoTransport_t;
+
+/**
+ * Start the I/O thread.
+ * From this point on, the transport must only be accessed by the I/O thread;
+ * the framework thread accesses the packets through the functions of this module.
+ * @param transport the transport of the I/O thread (it must remain valid until the
+ * I/O thread is stopped)
+ * @return 1 if the I/O thread was started; 0 otherwise
+ */
+CrFwBool_t CrDaIoThreadStart(const CrDaIoTransport_t* transport);
+
+/**
+ * Stop the I/O thread.
+ * The function waits until the I/O thread has terminated, restores the default
+ * Packet Available Function of the transport, and releases the packets which are
+ * still held by the rings.
+ */
+void CrDaIoThreadStop();
+
+/**
+ * Poll the incoming ring.
+ * For each packet at the head of the incoming ring, function
+ * <code>::CrFwInStreamPcktAvail</code> is called on the InStream associated to the
+ * packet source.
+ * The function returns when the incoming ring is empty or when the InStream of the
+ * packet at its head has not collected it (e.g. because its packet queue is full).
+ * If the pipelined cycle is selected, only the packets which had been pushed into the
+ * incoming ring when the function was called are passed to the InStreams (the batch of
+ * the cycle).
+ * This function must be called by the framework thread once in each cycle.
+ */
+void CrDaIoThreadPoll();
+
+/**
+ * Wait for the argument period while polling the incoming ring.
+ * The function sleeps until the I/O thread pushes packets into the incoming ring or
+ * until the period has elapsed.
+ * When packets are pushed, function <code>::CrDaIoThreadPoll</code> is called and the
+ * function returns as soon as one or more packets have been collected by their
+ * InStream (see <code>CrDaCycle.h</code>).
+ * This function must be called by the framework thread.
+ * If the pipelined cycle is selected, the function ends the cycle instead: the batch of
+ * outgoing packets of the cycle is passed to the I/O thread and the function sleeps for
+ * the period without polling the incoming ring (the packets which arrive in the
+ * meantime belong to the batch of the next cycle).
+ * @param period the wait period in milliseconds
+ * @return 1 if the function returned before the end of the period because packets
+ * were collected by their InStream; 0 if the period has elapsed (always 0 if the
+ * pipelined cycle is selected)
+ */
+CrFwBool_t CrDaIoThreadWait(unsigned int period);
+
+/**
+ * Function implementing the Packet Collect Operation for the I/O thread.
+ * If the packet at the head of the incoming ring has a source attribute equal to
+ * <code>src</code>, it is removed from the ring and handed over to the caller.
+ * Otherwise, the function returns NULL.
+ * @param src the source associated to the InStream
+ * @return the packet or NULL
+ */
+CrFwPckt_t CrDaIoThreadPcktCollect(CrFwDestSrc_t src);
+
+/**
+ * Function implementing the Packet Available Check Operation for the I/O thread.
+ * @param src the source associated to the InStream
+ * @return 1 if the packet at the head of the incoming ring has a source attribute equal
+ * to <code>src</code>; 0 otherwise
+ */
+CrFwBool_t CrDaIoThreadIsPcktAvail(CrFwDestSrc_t src);
+
+/**
+ * Function implementing the Packet Hand-Over Operation for the I/O thread.
+ * The packet is retained and pushed into the outgoing ring.
+ * The function returns 0 if the outgoing ring is full.
+ * @param pckt the packet to be handed over
+ * @return 1 if the packet was pushed into the outgoing ring; 0 otherwise.
+ */
+CrFwBool_t CrDaIoThreadPcktHandover(CrFwPckt_t pckt);
+
+/**
+ * Check whether the outgoing ring is empty.
+ * The outgoing ring is empty when the I/O thread has handed over all packets of the
+ * OutStreams to the transport.
+ * If the pipelined cycle is selected, the packets of the batch of the current cycle
+ * are also counted.
+ * This function must be called by the framework thread.
+ * @return 1 if the outgoing ring is empty; 0 otherwise
+ */
+CrFwBool_t CrDaIoThreadIsOutEmpty();
+
+/**
+ * Print the number of batches of the pipelined cycle and their mean and peak sizes.
+ * Nothing is printed if the pipelined cycle is not selected.
+ * @param app the name of the application (e.g. "MA")
+ */
+void CrDaIoThreadReport(const char* app);
+
+#endif /* CRDA_IOTHREAD_H_ */
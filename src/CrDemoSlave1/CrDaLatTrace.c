@@ -0,0 +1,385 @@
+/**
+ * @file
+ * @ingroup crDemoSlave1
+ * Implementation of the latency tracing of the demo applications of the CORDET Demo.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include "CrDaLatTrace.h"
+/* Include configuration files */
+#include "CrFwCmpData.h"
+#include "CrFwTime.h"
+#include "CrFwPcktRefCnt.h"
+#include "CrFwPcktInline.h"
+/* Include framework files */
+#include "Pckt/CrFwPckt.h"
+/* Include FW Profile files */
+#include "FwSmConfig.h"
+
+#if (CR_DA_LAT_TRACE == 1)
+/** The first byte of the magic word of a trace trailer. */
+#define CR_DA_LAT_TRACE_MAGIC_0 0x4C
+
+/** The second byte of the magic word of a trace trailer. */
+#define CR_DA_LAT_TRACE_MAGIC_1 0x54
+
+/** The length of a trace point in a trace trailer. */
+#define CR_DA_LAT_TRACE_POINT_LENGTH 8
+
+/**
+ * The number of applications whose stages are recorded (the applications are indexed by
+ * their identifier and the first entry is shared by the other applications).
+ */
+#define CR_DA_LAT_TRACE_N_OF_APPS (CR_DA_SLAVE_2+1)
+
+/** The number of linear sub-buckets in each power-of-two range of a histogram. */
+#define CR_DA_LAT_TRACE_N_OF_SUB (1U << CR_DA_LAT_TRACE_SUB_BITS)
+
+/** The number of buckets of a histogram (it covers the full range of a 64-bit latency). */
+#define CR_DA_LAT_TRACE_N_OF_BUCKETS ((64 - CR_DA_LAT_TRACE_SUB_BITS + 1) * CR_DA_LAT_TRACE_N_OF_SUB)
+
+/** A latency histogram (its counters are incremented atomically). */
+typedef struct {
+	/** The number of latencies in each bucket. */
+	unsigned int bucket[CR_DA_LAT_TRACE_N_OF_BUCKETS];
+	/** The number of latencies in the histogram. */
+	unsigned long long nOfLat;
+	/** The maximum latency in nanoseconds. */
+	unsigned long long max;
+} CrDaLatTraceHist_t;
+
+/** The histograms of the stages for each stage and application which performed it. */
+static CrDaLatTraceHist_t stageHist[CR_DA_LAT_TRACE_N_OF_STAGES][CR_DA_LAT_TRACE_N_OF_APPS];
+
+/** The end-to-end histograms for each source of the packets. */
+static CrDaLatTraceHist_t endHist[CR_DA_LAT_TRACE_N_OF_APPS];
+
+/** The number of completed packets. */
+static unsigned long long nOfDone = 0;
+
+/** The number of trace points which did not fit in their trailer. */
+static unsigned long long nOfOverflows = 0;
+
+/** The number of stages which were ignored because they were longer than half the wrap-around period. */
+static unsigned long long nOfIgnored = 0;
+
+/** The names of the stages in the report. */
+static const char* stageName[CR_DA_LAT_TRACE_N_OF_STAGES] = {
+	"sent", "forwarded", "received", "loaded", "started", "completed"
+};
+
+/**
+ * Return the trace trailer of a packet.
+ * @param pckt the packet
+ * @return the trailer or NULL if the packet has no trailer
+ */
+static unsigned char* latTraceGetTrailer(CrFwPckt_t pckt);
+
+/**
+ * Record a trace point in the trailer of a packet.
+ * If the last point of the trailer is one of the same stage and application, its time is
+ * updated; otherwise the point is appended.
+ * Nothing is done if the packet has no trailer or if it is shared.
+ * @param pckt the packet
+ * @param stage the stage of the point
+ */
+static void latTraceMark(CrFwPckt_t pckt, CrDaLatTraceStage_t stage);
+
+/**
+ * Return the index of an application in the per-application arrays.
+ * @param app the application identifier
+ * @return the index
+ */
+static unsigned int latTraceAppIndex(unsigned int app);
+
+/**
+ * Add a latency to a histogram.
+ * @param hist the histogram
+ * @param delta the latency in units of the time stamps (modulo 2^32)
+ */
+static void latTraceAdd(CrDaLatTraceHist_t* hist, uint32_t delta);
+
+/**
+ * Return the bucket of a latency.
+ * @param lat the latency in nanoseconds
+ * @return the bucket
+ */
+static unsigned int latTraceGetBucket(unsigned long long lat);
+
+/**
+ * Return the largest latency of a bucket.
+ * @param bucket the bucket
+ * @return the largest latency in nanoseconds
+ */
+static unsigned long long latTraceGetBucketMax(unsigned int bucket);
+
+/**
+ * Return a percentile of the latencies of a histogram.
+ * @param hist the histogram
+ * @param perMille the percentile in per mille
+ * @return the percentile in nanoseconds
+ */
+static unsigned long long latTraceGetPercentile(const CrDaLatTraceHist_t* hist, unsigned int perMille);
+
+/**
+ * Print the percentiles of a histogram.
+ * @param app the name of the application
+ * @param what the name of the histogram (the name of a stage or "end-to-end")
+ * @param prep the preposition which links the name to the application ("by" or "from")
+ * @param id the application identifier to which the histogram belongs
+ * @param hist the histogram
+ */
+static void latTracePrint(const char* app, const char* what, const char* prep, unsigned int id,
+                          const CrDaLatTraceHist_t* hist);
+#endif
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaLatTraceInit(CrFwPckt_t pckt) {
+#if (CR_DA_LAT_TRACE == 1)
+	unsigned char* t;
+
+	if (CrFwPcktGetLength(pckt) < CR_FW_PCKT_HEADER_LENGTH + CR_DA_LAT_TRACE_LENGTH)
+		return;
+	t = (unsigned char*)pckt + CrFwPcktGetLength(pckt) - CR_DA_LAT_TRACE_LENGTH;
+	t[0] = CR_DA_LAT_TRACE_MAGIC_0;
+	t[1] = CR_DA_LAT_TRACE_MAGIC_1;
+	t[2] = 0;
+	t[3] = 0;
+#else
+	(void)pckt;
+#endif
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaLatTraceTx(CrFwPckt_t pckt) {
+#if (CR_DA_LAT_TRACE == 1)
+	latTraceMark(pckt, crDaLatTraceSent);
+#else
+	(void)pckt;
+#endif
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaLatTraceFwd(CrFwPckt_t pckt) {
+#if (CR_DA_LAT_TRACE == 1)
+	latTraceMark(pckt, crDaLatTraceForwarded);
+#else
+	(void)pckt;
+#endif
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaLatTraceRx(CrFwPckt_t pckt) {
+#if (CR_DA_LAT_TRACE == 1)
+	latTraceMark(pckt, crDaLatTraceReceived);
+#else
+	(void)pckt;
+#endif
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaLatTraceInCmd(CrFwRepInCmdOutcome_t outcome, FwSmDesc_t inCmd) {
+#if (CR_DA_LAT_TRACE == 1)
+	CrFwCmpData_t* cmpData = (CrFwCmpData_t*)FwSmGetData(inCmd);
+	CrFwPckt_t pckt = ((CrFwInCmdData_t*)(cmpData->cmpSpecificData))->pckt;
+
+	switch (outcome) {
+	case crCmdAckAccSucc:
+		latTraceMark(pckt, crDaLatTraceLoaded);
+		break;
+	case crCmdAckStrSucc:
+		latTraceMark(pckt, crDaLatTraceStarted);
+		break;
+	case crCmdAckPrgSucc:
+		break;
+	default:	/* the termination and the failures complete the InCommand */
+		CrDaLatTraceDone(pckt);
+		break;
+	}
+#else
+	(void)outcome;
+	(void)inCmd;
+#endif
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaLatTraceDone(CrFwPckt_t pckt) {
+#if (CR_DA_LAT_TRACE == 1)
+	unsigned char* t = latTraceGetTrailer(pckt);
+	unsigned char* p;
+	uint32_t prev, time;
+	unsigned int k;
+
+	if (t == NULL)
+		return;
+	__atomic_fetch_add(&nOfDone, 1, __ATOMIC_RELAXED);
+
+	/* Each stage ends at its point and starts at the previous point or at the origin */
+	prev = (uint32_t)CrFwPcktGetTimeStamp(pckt);
+	for (k=0; k<t[2]; k++) {
+		p = t + 4 + k*CR_DA_LAT_TRACE_POINT_LENGTH;
+		memcpy(&time, p+4, sizeof(time));
+		if (p[0] < CR_DA_LAT_TRACE_N_OF_STAGES)
+			latTraceAdd(&stageHist[p[0]][latTraceAppIndex(p[1])], time - prev);
+		prev = time;
+	}
+	time = (uint32_t)CrFwGetCurrentTimeStamp();
+	latTraceAdd(&stageHist[crDaLatTraceCompleted][latTraceAppIndex(CR_FW_HOST_APP_ID)], time - prev);
+	latTraceAdd(&endHist[latTraceAppIndex(CrFwPcktGetSrc(pckt))], time - (uint32_t)CrFwPcktGetTimeStamp(pckt));
+#else
+	(void)pckt;
+#endif
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaLatTraceReport(const char* app) {
+#if (CR_DA_LAT_TRACE == 1)
+	unsigned int s, i;
+
+	if (nOfDone == 0)
+		return;
+	printf("%s: Latency trace: %llu packets completed, %llu trace points lost to full trailers, %llu stages ignored\n",
+	       app, nOfDone, nOfOverflows, nOfIgnored);
+	for (s=0; s<CR_DA_LAT_TRACE_N_OF_STAGES; s++)
+		for (i=0; i<CR_DA_LAT_TRACE_N_OF_APPS; i++)
+			latTracePrint(app, stageName[s], "by", i, &stageHist[s][i]);
+	for (i=0; i<CR_DA_LAT_TRACE_N_OF_APPS; i++)
+		latTracePrint(app, "end-to-end", "from", i, &endHist[i]);
+#else
+	(void)app;
+#endif
+}
+
+#if (CR_DA_LAT_TRACE == 1)
+/* ---------------------------------------------------------------------------------------------*/
+static unsigned char* latTraceGetTrailer(CrFwPckt_t pckt) {
+	unsigned char* t;
+
+	if (CrFwPcktGetLength(pckt) < CR_FW_PCKT_HEADER_LENGTH + CR_DA_LAT_TRACE_LENGTH)
+		return NULL;
+	t = (unsigned char*)pckt + CrFwPcktGetLength(pckt) - CR_DA_LAT_TRACE_LENGTH;
+	if ((t[0] != CR_DA_LAT_TRACE_MAGIC_0) || (t[1] != CR_DA_LAT_TRACE_MAGIC_1) ||
+	        (t[2] > CR_DA_LAT_TRACE_MAX_POINTS))
+		return NULL;	/* the packet was made by an application without the latency tracing */
+	return t;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void latTraceMark(CrFwPckt_t pckt, CrDaLatTraceStage_t stage) {
+	unsigned char* t = latTraceGetTrailer(pckt);
+	uint32_t time = (uint32_t)CrFwGetCurrentTimeStamp();
+	unsigned char* p;
+
+	if ((t == NULL) || (CrFwPcktGetRefCnt(pckt) > 1))
+		return;	/* a shared packet may be held by a transmit queue */
+
+	p = (t[2] == 0) ? NULL : t + 4 + (t[2]-1)*CR_DA_LAT_TRACE_POINT_LENGTH;
+	if ((p == NULL) || (p[0] != stage) || (p[1] != CR_FW_HOST_APP_ID)) {
+		if (t[2] == CR_DA_LAT_TRACE_MAX_POINTS) {
+			__atomic_fetch_add(&nOfOverflows, 1, __ATOMIC_RELAXED);
+			return;
+		}
+		p = t + 4 + t[2]*CR_DA_LAT_TRACE_POINT_LENGTH;
+		p[0] = (unsigned char)stage;
+		p[1] = CR_FW_HOST_APP_ID;
+		p[2] = 0;
+		p[3] = 0;
+		t[2]++;
+	}
+	memcpy(p+4, &time, sizeof(time));	/* the applications share the host and its byte order */
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static unsigned int latTraceAppIndex(unsigned int app) {
+	return (app < CR_DA_LAT_TRACE_N_OF_APPS) ? app : 0;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void latTraceAdd(CrDaLatTraceHist_t* hist, uint32_t delta) {
+	unsigned long long lat, max;
+
+	if (delta > (UINT32_MAX >> 1)) {
+		__atomic_fetch_add(&nOfIgnored, 1, __ATOMIC_RELAXED);
+		return;
+	}
+	lat = (unsigned long long)delta << CR_FW_TIME_STAMP_SHIFT;
+	__atomic_fetch_add(&hist->bucket[latTraceGetBucket(lat)], 1, __ATOMIC_RELAXED);
+	__atomic_fetch_add(&hist->nOfLat, 1, __ATOMIC_RELAXED);
+	max = __atomic_load_n(&hist->max, __ATOMIC_RELAXED);
+	while ((lat > max) &&
+	        !__atomic_compare_exchange_n(&hist->max, &max, lat, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+		;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static unsigned int latTraceGetBucket(unsigned long long lat) {
+	unsigned int msb;
+
+	if (lat < CR_DA_LAT_TRACE_N_OF_SUB)
+		return (unsigned int)lat;
+	msb = 63 - (unsigned int)__builtin_clzll(lat);
+	return (msb - CR_DA_LAT_TRACE_SUB_BITS + 1) * CR_DA_LAT_TRACE_N_OF_SUB +
+	       (unsigned int)(lat >> (msb - CR_DA_LAT_TRACE_SUB_BITS)) - CR_DA_LAT_TRACE_N_OF_SUB;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static unsigned long long latTraceGetBucketMax(unsigned int bucket) {
+	unsigned int shift;
+
+	if (bucket < CR_DA_LAT_TRACE_N_OF_SUB)
+		return bucket;
+	shift = bucket / CR_DA_LAT_TRACE_N_OF_SUB - 1;
+	return (((unsigned long long)(bucket % CR_DA_LAT_TRACE_N_OF_SUB + CR_DA_LAT_TRACE_N_OF_SUB) + 1) << shift) - 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static unsigned long long latTraceGetPercentile(const CrDaLatTraceHist_t* hist, unsigned int perMille) {
+	unsigned long long rank, count = 0;
+	unsigned long long val;
+	unsigned int i;
+
+	/* The rank of the percentile (rounded up) in the ordered latencies */
+	rank = (hist->nOfLat * perMille + 999) / 1000;
+	if (rank == 0)
+		rank = 1;
+	for (i=0; i<CR_DA_LAT_TRACE_N_OF_BUCKETS; i++) {
+		count += hist->bucket[i];
+		if (count >= rank) {
+			val = latTraceGetBucketMax(i);
+			return (val < hist->max) ? val : hist->max;
+		}
+	}
+	return hist->max;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void latTracePrint(const char* app, const char* what, const char* prep, unsigned int id,
+                          const CrDaLatTraceHist_t* hist) {
+	char who[32];
+
+	if (hist->nOfLat == 0)
+		return;
+	if (id == 0)
+		snprintf(who, sizeof(who), "other applications");
+	else
+		snprintf(who, sizeof(who), "application %u", id);
+	printf("%s: Latency trace: %s %s %s: %llu packets, p50 %.1f us, p99 %.1f us, p99.9 %.1f us, max %.1f us\n",
+	       app, what, prep, who, hist->nOfLat,
+	       latTraceGetPercentile(hist, 500) / 1e3, latTraceGetPercentile(hist, 990) / 1e3,
+	       latTraceGetPercentile(hist, 999) / 1e3, hist->max / 1e3);
+}
+#endif
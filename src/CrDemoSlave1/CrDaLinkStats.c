@@ -0,0 +1,227 @@
+/**
+ * @file
+ * @ingroup crDemoSlave1
+ * Implementation of the link statistics of the demo applications.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <sys/resource.h>
+#include "CrDaLinkStats.h"
+#include "CrDaHeartbeat.h"
+#include "CrDaLatTrace.h"
+/* Include framework files */
+#include "Pckt/CrFwPckt.h"
+/* Include configuration files */
+#include "CrFwPcktInline.h"
+
+/** The number of application identifiers covered by the link statistics (identifier 0 is not used). */
+#define CR_DA_LINK_STATS_N_OF_APPS (CR_DA_SLAVE_2+1)
+
+/** The statistics of one link in one direction. */
+typedef struct {
+	/** The number of packets. */
+	unsigned long long nOfPckts;
+	/** The number of bytes. */
+	unsigned long long nOfBytes;
+	/** The time of the first packet. */
+	struct timespec first;
+	/** The time of the last packet. */
+	struct timespec last;
+} CrDaLinkStats_t;
+
+#if ((CR_DA_LINK_STATS_SEQ_WINDOW < 1) || (CR_DA_LINK_STATS_SEQ_WINDOW > 64))
+#error "CR_DA_LINK_STATS_SEQ_WINDOW must be between 1 and 64"
+#endif
+
+/** The tracking of the sequence counters of one link and group. */
+typedef struct {
+	/** The statistics. */
+	CrDaLinkSeqStats_t stats;
+	/** The highest sequence counter received. */
+	CrFwSeqCnt_t highest;
+	/** The sequence counters received below the highest one (bit k stands for the highest minus k). */
+	uint64_t window;
+} CrDaLinkSeq_t;
+
+/** The statistics of the packets handed over to the middleware indexed by source and destination. */
+static CrDaLinkStats_t txStats[CR_DA_LINK_STATS_N_OF_APPS][CR_DA_LINK_STATS_N_OF_APPS];
+
+/** The statistics of the packets collected from the middleware indexed by source and destination. */
+static CrDaLinkStats_t rxStats[CR_DA_LINK_STATS_N_OF_APPS][CR_DA_LINK_STATS_N_OF_APPS];
+
+/** The tracking of the sequence counters of the packets collected from the middleware indexed by source, destination and group. */
+static CrDaLinkSeq_t rxSeq[CR_DA_LINK_STATS_N_OF_APPS][CR_DA_LINK_STATS_N_OF_APPS][CR_DA_LINK_STATS_N_OF_GROUPS];
+
+/**
+ * Count a packet in the statistics of its link.
+ * Packets whose source or destination is not an application of the demo are ignored.
+ * @param stats the statistics of one direction
+ * @param pckt the packet
+ */
+static void linkStatsCount(CrDaLinkStats_t stats[][CR_DA_LINK_STATS_N_OF_APPS], CrFwPckt_t pckt);
+
+/**
+ * Track the sequence counter of a packet collected from the middleware.
+ * Packets whose source or destination is not an application of the demo or whose group
+ * is not tracked are ignored.
+ * @param pckt the packet
+ * @return 0 if the packet is a duplicate; 1 otherwise
+ */
+static CrFwBool_t linkStatsSeq(CrFwPckt_t pckt);
+
+/**
+ * Print the statistics of one direction.
+ * @param app the name of the application
+ * @param dir the name of the direction
+ * @param stats the statistics of the direction
+ * @param usage the resource usage of the process
+ */
+static void linkStatsPrint(const char* app, const char* dir, CrDaLinkStats_t stats[][CR_DA_LINK_STATS_N_OF_APPS],
+                           const struct rusage* usage);
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaLinkStatsTx(CrFwPckt_t pckt) {
+	linkStatsCount(txStats, pckt);
+#if (CR_DA_HEARTBEAT == 1)
+	CrDaHeartbeatTx(pckt);
+#endif
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaLinkStatsRx(CrFwPckt_t pckt) {
+	CrDaLatTraceRx(pckt);
+	linkStatsCount(rxStats, pckt);
+#if (CR_DA_HEARTBEAT == 1)
+	if (CrDaHeartbeatRx(pckt))
+		return 0;	/* the heartbeats have no sequence counter and end at the transport */
+#endif
+	return (linkStatsSeq(pckt) || (CR_DA_INSTREAM_DEDUP == 0));
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaLinkStatsGetSeq(CrFwDestSrc_t src, CrFwDestSrc_t dest, CrFwGroup_t group, CrDaLinkSeqStats_t* stats) {
+	if ((src >= CR_DA_LINK_STATS_N_OF_APPS) || (dest >= CR_DA_LINK_STATS_N_OF_APPS) ||
+	        (group >= CR_DA_LINK_STATS_N_OF_GROUPS)) {
+		memset(stats, 0, sizeof(CrDaLinkSeqStats_t));
+		return 0;
+	}
+	(*stats) = rxSeq[src][dest][group].stats;
+	return (stats->nOfPckts > 0);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaLinkStatsReport(const char* app) {
+	struct rusage usage;
+	CrDaLinkSeqStats_t seq;
+	unsigned int src, dest, group;
+
+	getrusage(RUSAGE_SELF, &usage);
+	linkStatsPrint(app, "tx", txStats, &usage);
+	linkStatsPrint(app, "rx", rxStats, &usage);
+
+	for (src=0; src<CR_DA_LINK_STATS_N_OF_APPS; src++)
+		for (dest=0; dest<CR_DA_LINK_STATS_N_OF_APPS; dest++)
+			for (group=0; group<CR_DA_LINK_STATS_N_OF_GROUPS; group++) {
+				if (!CrDaLinkStatsGetSeq(src, dest, group, &seq))
+					continue;
+				printf("SQ,%s,%u,%u,%u,%llu,%llu,%llu,%llu,%llu\n", app, src, dest, group, seq.nOfPckts,
+				       seq.nOfGaps, seq.nOfLost, seq.nOfDuplicates, seq.nOfReorders);
+			}
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void linkStatsCount(CrDaLinkStats_t stats[][CR_DA_LINK_STATS_N_OF_APPS], CrFwPckt_t pckt) {
+	CrFwDestSrc_t src = CrFwPcktGetSrc(pckt);
+	CrFwDestSrc_t dest = CrFwPcktGetDest(pckt);
+	CrDaLinkStats_t* link;
+
+	if ((src >= CR_DA_LINK_STATS_N_OF_APPS) || (dest >= CR_DA_LINK_STATS_N_OF_APPS))
+		return;
+	link = &stats[src][dest];
+	clock_gettime(CLOCK_MONOTONIC, &link->last);
+	if (link->nOfPckts == 0)
+		link->first = link->last;
+	link->nOfPckts++;
+	link->nOfBytes += CrFwPcktGetLength(pckt);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static CrFwBool_t linkStatsSeq(CrFwPckt_t pckt) {
+	CrFwDestSrc_t src = CrFwPcktGetSrc(pckt);
+	CrFwDestSrc_t dest = CrFwPcktGetDest(pckt);
+	CrFwGroup_t group = CrFwPcktGetGroup(pckt);
+	CrFwSeqCnt_t seqCnt = CrFwPcktGetSeqCnt(pckt);
+	CrDaLinkSeq_t* seq;
+	int diff;
+
+	if ((src >= CR_DA_LINK_STATS_N_OF_APPS) || (dest >= CR_DA_LINK_STATS_N_OF_APPS) ||
+	        (group >= CR_DA_LINK_STATS_N_OF_GROUPS))
+		return 1;
+	seq = &rxSeq[src][dest][group];
+	if (seq->stats.nOfPckts++ == 0) {	/* the first packet sets the start of the sequence */
+		seq->highest = seqCnt;
+		seq->window = 1;
+		return 1;
+	}
+
+	/* The difference is computed modulo the range of the sequence counter */
+	diff = (int)(seqCnt - seq->highest);
+	if (diff > 0) {
+		if (diff > 1) {
+			seq->stats.nOfGaps++;
+			seq->stats.nOfLost += (unsigned int)(diff - 1);
+		}
+		seq->window = (diff < CR_DA_LINK_STATS_SEQ_WINDOW) ? ((seq->window << diff) | 1) : 1;
+		seq->highest = seqCnt;
+		return 1;
+	}
+
+	diff = -diff;
+	if ((diff < CR_DA_LINK_STATS_SEQ_WINDOW) && ((seq->window & ((uint64_t)1 << diff)) != 0)) {
+		seq->stats.nOfDuplicates++;
+		return 0;
+	}
+	if (diff < CR_DA_LINK_STATS_SEQ_WINDOW)
+		seq->window |= (uint64_t)1 << diff;
+	seq->stats.nOfReorders++;
+	if (seq->stats.nOfLost > 0)
+		seq->stats.nOfLost--;
+	return 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void linkStatsPrint(const char* app, const char* dir, CrDaLinkStats_t stats[][CR_DA_LINK_STATS_N_OF_APPS],
+                           const struct rusage* usage) {
+	const CrDaLinkStats_t* link;
+	double duration, user, sys;
+	unsigned int src, dest;
+
+	user = usage->ru_utime.tv_sec + usage->ru_utime.tv_usec / 1e6;
+	sys = usage->ru_stime.tv_sec + usage->ru_stime.tv_usec / 1e6;
+	for (src=0; src<CR_DA_LINK_STATS_N_OF_APPS; src++)
+		for (dest=0; dest<CR_DA_LINK_STATS_N_OF_APPS; dest++) {
+			link = &stats[src][dest];
+			if (link->nOfPckts == 0)
+				continue;
+			duration = (double)(link->last.tv_sec - link->first.tv_sec) +
+			           (link->last.tv_nsec - link->first.tv_nsec) / 1e9;
+			printf("TP,%s,%s,%u,%u,%llu,%llu,%.6f,%.1f,%.1f,%.3f,%.3f\n", app, dir, src, dest, link->nOfPckts,
+			       link->nOfBytes, duration, (duration > 0) ? link->nOfPckts / duration : 0.0,
+			       (duration > 0) ? link->nOfBytes / duration : 0.0, user, sys);
+		}
+}
@@ -0,0 +1,195 @@
+/**
+ * @file
+ * @ingroup crDemoSlave1
+ * Implementation of the asynchronous leveled logging of the demo applications of the CORDET Demo.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <errno.h>
+#include <pthread.h>
+#include "CrDaLog.h"
+#include "CrDaThread.h"
+
+/** A queued log message. */
+typedef struct {
+	/** The length of the message. */
+	unsigned int len;
+	/** The message (it is truncated to <code>#CR_DA_LOG_MSG_SIZE</code>-1 characters). */
+	char text[CR_DA_LOG_MSG_SIZE];
+} CrDaLogMsg_t;
+
+/** The queue of the log messages. */
+static CrDaLogMsg_t logQueue[CR_DA_LOG_QUEUE_SIZE];
+
+/** The number of messages put into the queue (the slot of the next message modulo the size of the queue). */
+static unsigned long logHead = 0;
+
+/** The number of messages taken from the queue by the logging thread. */
+static unsigned long logTail = 0;
+
+/** The number of messages discarded because the queue was full. */
+static unsigned long nOfDropped = 0;
+
+/** The lock of the queue. */
+static pthread_mutex_t logLock = PTHREAD_MUTEX_INITIALIZER;
+
+/** The condition on which the logging thread waits for messages. */
+static pthread_cond_t logCond = PTHREAD_COND_INITIALIZER;
+
+/** The logging thread. */
+static pthread_t logThread;
+
+/** Flag which is set while the logging thread is running. */
+static CrFwBool_t logRunning = 0;
+
+/** Flag which is set to stop the logging thread. */
+static CrFwBool_t logStop = 0;
+
+/** The run-time level of the log messages. */
+static CrDaLogLevel_t logLevel = (CrDaLogLevel_t)CR_DA_LOG_LEVEL;
+
+/**
+ * Thread function of the logging thread.
+ * It writes the queued messages to standard output until it is stopped and the queue
+ * is empty.
+ * The messages are copied out of the queue under the lock and written without it.
+ * @param arg unused
+ * @return always NULL
+ */
+static void* logThreadRun(void* arg);
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaLogWrite(CrDaLogLevel_t level, const char* format, ...) {
+	CrDaLogMsg_t msg;
+	va_list args;
+	int len;
+
+	if (level > __atomic_load_n(&logLevel, __ATOMIC_RELAXED))
+		return;
+
+	va_start(args, format);
+	if (!__atomic_load_n(&logRunning, __ATOMIC_ACQUIRE)) {
+		vprintf(format, args);
+		va_end(args);
+		return;
+	}
+	len = vsnprintf(msg.text, CR_DA_LOG_MSG_SIZE, format, args);
+	va_end(args);
+	if (len < 0)
+		return;
+	msg.len = (len < CR_DA_LOG_MSG_SIZE) ? (unsigned int)len : CR_DA_LOG_MSG_SIZE - 1;
+
+	pthread_mutex_lock(&logLock);
+	if (!logRunning) {
+		/* The logging thread has been stopped in the meantime */
+		pthread_mutex_unlock(&logLock);
+		fwrite(msg.text, 1, msg.len, stdout);
+		return;
+	}
+	if (logHead - logTail == CR_DA_LOG_QUEUE_SIZE) {
+		nOfDropped++;
+		pthread_mutex_unlock(&logLock);
+		return;
+	}
+	memcpy(&logQueue[logHead % CR_DA_LOG_QUEUE_SIZE], &msg, sizeof(msg.len) + msg.len);
+	logHead++;
+	pthread_cond_signal(&logCond);
+	pthread_mutex_unlock(&logLock);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaLogSetLevel(CrDaLogLevel_t level) {
+	__atomic_store_n(&logLevel, level, __ATOMIC_RELAXED);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrDaLogLevel_t CrDaLogGetLevel() {
+	return __atomic_load_n(&logLevel, __ATOMIC_RELAXED);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaLogStart() {
+	const char* env;
+	int err;
+
+	if (logRunning)
+		return 0;
+
+	env = getenv("CR_DA_LOG_LEVEL");
+	if ((env != NULL) && (env[0] >= '0') && (env[0] <= '3') && (env[1] == '\0'))
+		CrDaLogSetLevel((CrDaLogLevel_t)(env[0] - '0'));
+
+	/* The messages printed before the start must precede the queued messages */
+	fflush(stdout);
+	logStop = 0;
+	err = pthread_create(&logThread, NULL, &logThreadRun, NULL);
+	if (err != 0) {
+		errno = err;
+		perror("CrDaLogStart, thread creation");
+		return 0;
+	}
+	__atomic_store_n(&logRunning, 1, __ATOMIC_RELEASE);
+	return 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaLogStop() {
+	if (!logRunning)
+		return;
+
+	pthread_mutex_lock(&logLock);
+	__atomic_store_n(&logRunning, 0, __ATOMIC_RELEASE);
+	logStop = 1;
+	pthread_cond_signal(&logCond);
+	pthread_mutex_unlock(&logLock);
+	pthread_join(logThread, NULL);
+
+	if (nOfDropped > 0)
+		printf("Log: %lu messages discarded because the log queue was full\n", nOfDropped);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void* logThreadRun(void* arg) {
+	CrDaLogMsg_t msg;
+
+	(void)arg;
+	CrDaThreadPlace(crDaThreadAux);
+	pthread_mutex_lock(&logLock);
+	for (;;) {
+		while ((logHead == logTail) && !logStop)
+			pthread_cond_wait(&logCond, &logLock);
+		if (logHead == logTail)
+			break;
+		msg.len = logQueue[logTail % CR_DA_LOG_QUEUE_SIZE].len;
+		memcpy(msg.text, logQueue[logTail % CR_DA_LOG_QUEUE_SIZE].text, msg.len);
+		logTail++;
+		pthread_mutex_unlock(&logLock);
+
+		fwrite(msg.text, 1, msg.len, stdout);
+		pthread_mutex_lock(&logLock);
+		/* Flush when the queue has been drained so that the output is not delayed */
+		if (logHead == logTail) {
+			pthread_mutex_unlock(&logLock);
+			fflush(stdout);
+			pthread_mutex_lock(&logLock);
+		}
+	}
+	pthread_mutex_unlock(&logLock);
+	fflush(stdout);
+	return NULL;
+}
@@ -0,0 +1,475 @@
+/**
+ * @file
+ * @ingroup crDemoSlave1
+ * Implementation of the live stream metrics of the demo applications of the CORDET Demo.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include "CrDaMetrics.h"
+#include "CrDaThread.h"
+#include "CrDaStatShard.h"
+/* Include framework files */
+#include "Pckt/CrFwPckt.h"
+#include "InStream/CrFwInStream.h"
+#include "OutStream/CrFwOutStream.h"
+/* Include configuration files */
+#include "CrFwPcktInline.h"
+#include "CrFwPcktStats.h"
+
+/** The number of application identifiers covered by the metrics (identifier 0 stands for an unknown peer). */
+#define CR_DA_METRICS_N_OF_APPS (CR_DA_SLAVE_2+1)
+
+/** The size of the cache lines which separate the counters written by different threads. */
+#define CR_DA_METRICS_CACHE_LINE CR_DA_STAT_CACHE_LINE
+
+#if (CR_DA_METRICS == 1)
+/** The number of shards of the transport counters (one per thread which uses the transport, see <code>CrDaStatShard.h</code>). */
+#define CR_DA_METRICS_N_OF_SHARDS CR_DA_STAT_N_OF_SHARDS
+#else
+/** The number of shards of the transport counters (the counters are not updated). */
+#define CR_DA_METRICS_N_OF_SHARDS 1
+#endif
+
+/** The size of the buffer in which a response of the metrics server is built. */
+#define CR_DA_METRICS_RESP_SIZE 16384
+
+/** The time in milliseconds after which the metrics server checks whether it must stop. */
+#define CR_DA_METRICS_POLL_MSEC 200
+
+/** The counters of the packets which cross the transport in one direction, indexed by application identifier. */
+typedef struct {
+	/** The number of packets. */
+	unsigned long long nOfPckts[CR_DA_METRICS_N_OF_APPS];
+	/** The number of bytes. */
+	unsigned long long nOfBytes[CR_DA_METRICS_N_OF_APPS];
+} __attribute__((aligned(CR_DA_METRICS_CACHE_LINE))) CrDaMetricsTraffic_t;
+
+/** The counters of the packets which could not cross the transport, indexed by application identifier. */
+typedef struct {
+	/** The number of packets discarded because they could not be framed (by peer). */
+	unsigned long long nOfFramingErrors[CR_DA_METRICS_N_OF_APPS];
+	/** The number of packets discarded because their CRC did not match (by peer). */
+	unsigned long long nOfCrcErrors[CR_DA_METRICS_N_OF_APPS];
+	/** The number of failed hand-over attempts (by destination). */
+	unsigned long long nOfHandoverFails[CR_DA_METRICS_N_OF_APPS];
+} __attribute__((aligned(CR_DA_METRICS_CACHE_LINE))) CrDaMetricsErrors_t;
+
+/** The samples of the packet queues of the streams of one kind. */
+typedef struct {
+	/** The number of sampled streams. */
+	int nOfStreams;
+	/** The streams. */
+	FwSmDesc_t stream[CR_DA_METRICS_MAX_NOF_STREAMS];
+	/** The source of the InStreams or the destination of the OutStreams. */
+	CrFwDestSrc_t id[CR_DA_METRICS_MAX_NOF_STREAMS];
+	/** The size of the packet queue. */
+	unsigned int size[CR_DA_METRICS_MAX_NOF_STREAMS];
+	/** The number of pending packets at the last sample. */
+	unsigned int depth[CR_DA_METRICS_MAX_NOF_STREAMS];
+	/** The largest number of pending packets sampled. */
+	unsigned int maxDepth[CR_DA_METRICS_MAX_NOF_STREAMS];
+} __attribute__((aligned(CR_DA_METRICS_CACHE_LINE))) CrDaMetricsQueues_t;
+
+/** The failed allocations of the packet pool for each size class at the last sample. */
+typedef struct {
+	/** The number of failed allocations. */
+	unsigned int nOfMakeFail[CR_FW_PCKT_STATS_NOF_FAIL_BINS];
+} __attribute__((aligned(CR_DA_METRICS_CACHE_LINE))) CrDaMetricsPool_t;
+
+/** The transport counters which are updated by one thread. */
+typedef struct {
+	/** The packets collected from the transport, indexed by source. */
+	CrDaMetricsTraffic_t in;
+	/** The packets handed over to the transport, indexed by destination. */
+	CrDaMetricsTraffic_t out;
+	/** The packets which could not cross the transport. */
+	CrDaMetricsErrors_t errors;
+} CrDaMetricsShard_t;
+
+/** The shards of the transport counters (the reader sums them). */
+static CrDaMetricsShard_t metricsShard[CR_DA_METRICS_N_OF_SHARDS];
+
+/** The packet queues of the InStreams. */
+static CrDaMetricsQueues_t inQueues;
+
+/** The packet queues of the OutStreams. */
+static CrDaMetricsQueues_t outQueues;
+
+/** The failed allocations of the packet pool. */
+static CrDaMetricsPool_t pool;
+
+/** The name of the application in the metrics. */
+static const char* metricsApp = "";
+
+/** The server socket of the metrics server. */
+static int metricsFd = -1;
+
+/** The thread of the metrics server. */
+static pthread_t metricsThread;
+
+/** Flag which is set to stop the metrics server thread. */
+static CrFwBool_t metricsStop = 0;
+
+/**
+ * Add a value to a counter.
+ * @param counter the counter
+ * @param n the value
+ */
+static void metricsAdd(unsigned long long* counter, unsigned long long n);
+
+/**
+ * Return the shard of the transport counters of the calling thread.
+ * @return the shard
+ */
+static CrDaMetricsShard_t* metricsShardOf();
+
+#if (CR_DA_METRICS == 1)
+/**
+ * Sample the packet queues of the streams of one kind.
+ * @param queues the streams
+ * @param getDepth the function which returns the number of pending packets of a stream
+ */
+static void metricsSampleQueues(CrDaMetricsQueues_t* queues, CrFwCounterU1_t (*getDepth)(FwSmDesc_t));
+
+/**
+ * Build the response of the metrics server.
+ * @param buf the buffer of the response
+ * @param size the size of the buffer
+ * @return the length of the response
+ */
+static int metricsFormat(char* buf, int size);
+
+/**
+ * Sum the transport counters over the shards.
+ * @param total the location where the sums are returned
+ */
+static void metricsSum(CrDaMetricsShard_t* total);
+
+/**
+ * Thread function of the metrics server.
+ * It answers the connections to the server socket until it is stopped.
+ * @param arg unused
+ * @return always NULL
+ */
+static void* metricsThreadRun(void* arg);
+#endif
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaMetricsIn(CrFwPckt_t pckt) {
+	CrFwDestSrc_t src = CrFwPcktGetSrc(pckt);
+	CrDaMetricsShard_t* shard;
+
+	if (src >= CR_DA_METRICS_N_OF_APPS)
+		return;
+	shard = metricsShardOf();
+	metricsAdd(&shard->in.nOfPckts[src], 1);
+	metricsAdd(&shard->in.nOfBytes[src], CrFwPcktGetLength(pckt));
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaMetricsOut(CrFwPckt_t pckt) {
+	CrFwDestSrc_t dest = CrFwPcktGetDest(pckt);
+	CrDaMetricsShard_t* shard;
+
+	if (dest >= CR_DA_METRICS_N_OF_APPS)
+		return;
+	shard = metricsShardOf();
+	metricsAdd(&shard->out.nOfPckts[dest], 1);
+	metricsAdd(&shard->out.nOfBytes[dest], CrFwPcktGetLength(pckt));
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaMetricsFramingError(CrFwDestSrc_t peer) {
+	if (peer >= CR_DA_METRICS_N_OF_APPS)
+		peer = 0;
+	metricsAdd(&metricsShardOf()->errors.nOfFramingErrors[peer], 1);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaMetricsCrcError(CrFwDestSrc_t peer) {
+	if (peer >= CR_DA_METRICS_N_OF_APPS)
+		peer = 0;
+	metricsAdd(&metricsShardOf()->errors.nOfCrcErrors[peer], 1);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaMetricsHandoverFail(CrFwPckt_t pckt) {
+	CrFwDestSrc_t dest = CrFwPcktGetDest(pckt);
+
+	if (dest >= CR_DA_METRICS_N_OF_APPS)
+		dest = 0;
+	metricsAdd(&metricsShardOf()->errors.nOfHandoverFails[dest], 1);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaMetricsSetStreams(FwSmDesc_t* inStreams, int nOfInStreams, FwSmDesc_t* outStreams, int nOfOutStreams) {
+	int i;
+
+	if (nOfInStreams > CR_DA_METRICS_MAX_NOF_STREAMS)
+		nOfInStreams = CR_DA_METRICS_MAX_NOF_STREAMS;
+	if (nOfOutStreams > CR_DA_METRICS_MAX_NOF_STREAMS)
+		nOfOutStreams = CR_DA_METRICS_MAX_NOF_STREAMS;
+
+	for (i=0; i<nOfInStreams; i++) {
+		inQueues.stream[i] = inStreams[i];
+		inQueues.id[i] = CrFwInStreamGetSrc(inStreams[i]);
+		inQueues.size[i] = CrFwInStreamGetPcktQueueSize(inStreams[i]);
+	}
+	for (i=0; i<nOfOutStreams; i++) {
+		outQueues.stream[i] = outStreams[i];
+		outQueues.id[i] = CrFwOutStreamGetDest(outStreams[i]);
+		outQueues.size[i] = CrFwOutStreamGetPcktQueueSize(outStreams[i]);
+	}
+	/* The streams are set before the metrics server is started */
+	inQueues.nOfStreams = nOfInStreams;
+	outQueues.nOfStreams = nOfOutStreams;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaMetricsSample() {
+	CrFwPcktStats_t pcktStats;
+#if (CR_DA_METRICS == 1)
+	int k;
+#endif
+
+	/* The snapshot also raises the high-water mark of the packet pool (see CrFwPcktStats.h) */
+	CrFwPcktGetStats(&pcktStats);
+#if (CR_DA_METRICS == 1)
+	metricsSampleQueues(&inQueues, &CrFwInStreamGetNOfPendingPckts);
+	metricsSampleQueues(&outQueues, &CrFwOutStreamGetNOfPendingPckts);
+	for (k=0; k<CR_FW_PCKT_STATS_NOF_FAIL_BINS; k++)
+		__atomic_store_n(&pool.nOfMakeFail[k], pcktStats.nOfMakeFail[k], __ATOMIC_RELAXED);
+#endif
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaMetricsStart(const char* app) {
+#if (CR_DA_METRICS == 1)
+	struct sockaddr_in addr;
+	int opt = 1;
+	int err;
+
+	if (metricsFd >= 0)
+		return 0;
+
+	metricsApp = app;
+	metricsFd = socket(AF_INET, SOCK_STREAM, 0);
+	if (metricsFd < 0) {
+		perror("CrDaMetricsStart, Open metrics socket");
+		return 0;
+	}
+	setsockopt(metricsFd, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
+	memset(&addr, 0, sizeof(addr));
+	addr.sin_family = AF_INET;
+	addr.sin_addr.s_addr = htonl(INADDR_ANY);
+	addr.sin_port = htons(CR_DA_METRICS_PORT + CR_FW_HOST_APP_ID);
+	if ((bind(metricsFd, (struct sockaddr*)&addr, sizeof(addr)) < 0) || (listen(metricsFd, 4) < 0)) {
+		perror("CrDaMetricsStart, Bind metrics socket");
+		close(metricsFd);
+		metricsFd = -1;
+		return 0;
+	}
+
+	metricsStop = 0;
+	err = pthread_create(&metricsThread, NULL, &metricsThreadRun, NULL);
+	if (err != 0) {
+		errno = err;
+		perror("CrDaMetricsStart, thread creation");
+		close(metricsFd);
+		metricsFd = -1;
+		return 0;
+	}
+	printf("%s: Metrics served on port %d\n", app, CR_DA_METRICS_PORT + CR_FW_HOST_APP_ID);
+	return 1;
+#else
+	(void)app;
+	return 0;
+#endif
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaMetricsStop() {
+	if (metricsFd < 0)
+		return;
+
+	__atomic_store_n(&metricsStop, 1, __ATOMIC_RELEASE);
+	pthread_join(metricsThread, NULL);
+	close(metricsFd);
+	metricsFd = -1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void metricsAdd(unsigned long long* counter, unsigned long long n) {
+#if (CR_DA_METRICS == 1)
+	__atomic_fetch_add(counter, n, __ATOMIC_RELAXED);
+#else
+	(void)counter;
+	(void)n;
+#endif
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static CrDaMetricsShard_t* metricsShardOf() {
+#if (CR_DA_METRICS == 1)
+	return &metricsShard[CrDaStatShardId()];
+#else
+	return &metricsShard[0];
+#endif
+}
+
+#if (CR_DA_METRICS == 1)
+/* ---------------------------------------------------------------------------------------------*/
+static void metricsSampleQueues(CrDaMetricsQueues_t* queues, CrFwCounterU1_t (*getDepth)(FwSmDesc_t)) {
+	unsigned int depth;
+	int i;
+
+	for (i=0; i<queues->nOfStreams; i++) {
+		depth = getDepth(queues->stream[i]);
+		__atomic_store_n(&queues->depth[i], depth, __ATOMIC_RELAXED);
+		if (depth > queues->maxDepth[i])
+			__atomic_store_n(&queues->maxDepth[i], depth, __ATOMIC_RELAXED);
+	}
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void metricsSum(CrDaMetricsShard_t* total) {
+	CrDaMetricsShard_t* shard;
+	int k, i;
+
+	memset(total, 0, sizeof(CrDaMetricsShard_t));
+	for (k=0; k<CR_DA_METRICS_N_OF_SHARDS; k++) {
+		shard = &metricsShard[k];
+		for (i=0; i<CR_DA_METRICS_N_OF_APPS; i++) {
+			total->in.nOfPckts[i] += __atomic_load_n(&shard->in.nOfPckts[i], __ATOMIC_RELAXED);
+			total->in.nOfBytes[i] += __atomic_load_n(&shard->in.nOfBytes[i], __ATOMIC_RELAXED);
+			total->out.nOfPckts[i] += __atomic_load_n(&shard->out.nOfPckts[i], __ATOMIC_RELAXED);
+			total->out.nOfBytes[i] += __atomic_load_n(&shard->out.nOfBytes[i], __ATOMIC_RELAXED);
+			total->errors.nOfFramingErrors[i] += __atomic_load_n(&shard->errors.nOfFramingErrors[i], __ATOMIC_RELAXED);
+			total->errors.nOfCrcErrors[i] += __atomic_load_n(&shard->errors.nOfCrcErrors[i], __ATOMIC_RELAXED);
+			total->errors.nOfHandoverFails[i] += __atomic_load_n(&shard->errors.nOfHandoverFails[i], __ATOMIC_RELAXED);
+		}
+	}
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static int metricsFormat(char* buf, int size) {
+	CrDaMetricsShard_t total;
+	const CrDaMetricsTraffic_t* traffic[2] = {&total.in, &total.out};
+	const CrDaMetricsQueues_t* queues[2] = {&inQueues, &outQueues};
+	const char* dir[2] = {"in", "out"};
+	/* The last size class of the packet pool stands for illegal lengths */
+	const char* poolSizeName[CR_FW_PCKT_STATS_NOF_FAIL_BINS] = {"small", "medium", "large", "illegal"};
+	int len = 0;
+	int d, i;
+
+	metricsSum(&total);
+
+/** Append to the response (the response is truncated if the buffer is full). */
+#define METRICS_PRINT(...) \
+	do { \
+		if (len < size) \
+			len += snprintf(buf + len, size - len, __VA_ARGS__); \
+	} while (0)
+
+	METRICS_PRINT("# TYPE cr_da_stream_pckts_total counter\n");
+	for (d=0; d<2; d++)
+		for (i=1; i<CR_DA_METRICS_N_OF_APPS; i++)
+			METRICS_PRINT("cr_da_stream_pckts_total{app=\"%s\",stream=\"%s\",id=\"%d\"} %llu\n", metricsApp, dir[d], i,
+			              traffic[d]->nOfPckts[i]);
+	METRICS_PRINT("# TYPE cr_da_stream_bytes_total counter\n");
+	for (d=0; d<2; d++)
+		for (i=1; i<CR_DA_METRICS_N_OF_APPS; i++)
+			METRICS_PRINT("cr_da_stream_bytes_total{app=\"%s\",stream=\"%s\",id=\"%d\"} %llu\n", metricsApp, dir[d], i,
+			              traffic[d]->nOfBytes[i]);
+	METRICS_PRINT("# TYPE cr_da_stream_framing_errors_total counter\n");
+	for (i=0; i<CR_DA_METRICS_N_OF_APPS; i++)
+		METRICS_PRINT("cr_da_stream_framing_errors_total{app=\"%s\",peer=\"%d\"} %llu\n", metricsApp, i,
+		              total.errors.nOfFramingErrors[i]);
+	METRICS_PRINT("# TYPE cr_da_stream_crc_errors_total counter\n");
+	for (i=0; i<CR_DA_METRICS_N_OF_APPS; i++)
+		METRICS_PRINT("cr_da_stream_crc_errors_total{app=\"%s\",peer=\"%d\"} %llu\n", metricsApp, i,
+		              total.errors.nOfCrcErrors[i]);
+	METRICS_PRINT("# TYPE cr_da_stream_handover_fails_total counter\n");
+	for (i=1; i<CR_DA_METRICS_N_OF_APPS; i++)
+		METRICS_PRINT("cr_da_stream_handover_fails_total{app=\"%s\",stream=\"out\",id=\"%d\"} %llu\n", metricsApp, i,
+		              total.errors.nOfHandoverFails[i]);
+
+	METRICS_PRINT("# TYPE cr_da_stream_queue_depth gauge\n");
+	for (d=0; d<2; d++)
+		for (i=0; i<queues[d]->nOfStreams; i++)
+			METRICS_PRINT("cr_da_stream_queue_depth{app=\"%s\",stream=\"%s\",id=\"%d\"} %u\n", metricsApp, dir[d],
+			              queues[d]->id[i], __atomic_load_n(&queues[d]->depth[i], __ATOMIC_RELAXED));
+	METRICS_PRINT("# TYPE cr_da_stream_queue_depth_max gauge\n");
+	for (d=0; d<2; d++)
+		for (i=0; i<queues[d]->nOfStreams; i++)
+			METRICS_PRINT("cr_da_stream_queue_depth_max{app=\"%s\",stream=\"%s\",id=\"%d\"} %u\n", metricsApp, dir[d],
+			              queues[d]->id[i], __atomic_load_n(&queues[d]->maxDepth[i], __ATOMIC_RELAXED));
+	METRICS_PRINT("# TYPE cr_da_stream_queue_size gauge\n");
+	for (d=0; d<2; d++)
+		for (i=0; i<queues[d]->nOfStreams; i++)
+			METRICS_PRINT("cr_da_stream_queue_size{app=\"%s\",stream=\"%s\",id=\"%d\"} %u\n", metricsApp, dir[d],
+			              queues[d]->id[i], queues[d]->size[i]);
+
+	METRICS_PRINT("# TYPE cr_da_pckt_pool_alloc_fails_total counter\n");
+	for (i=0; i<CR_FW_PCKT_STATS_NOF_FAIL_BINS; i++)
+		METRICS_PRINT("cr_da_pckt_pool_alloc_fails_total{app=\"%s\",size=\"%s\"} %u\n", metricsApp, poolSizeName[i],
+		              __atomic_load_n(&pool.nOfMakeFail[i], __ATOMIC_RELAXED));
+#undef METRICS_PRINT
+
+	return (len < size) ? len : size - 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void* metricsThreadRun(void* arg) {
+	static char body[CR_DA_METRICS_RESP_SIZE];
+	char header[128];
+	char request[512];
+	struct pollfd pfd;
+	int fd, bodyLen, headerLen;
+
+	(void)arg;
+	CrDaThreadPlace(crDaThreadAux);
+	pfd.fd = metricsFd;
+	pfd.events = POLLIN;
+	while (!__atomic_load_n(&metricsStop, __ATOMIC_ACQUIRE)) {
+		if (poll(&pfd, 1, CR_DA_METRICS_POLL_MSEC) <= 0)
+			continue;
+		fd = accept(metricsFd, NULL, NULL);
+		if (fd < 0)
+			continue;
+
+		/* The request is not interpreted: every request receives all metrics */
+		pfd.fd = fd;
+		if (poll(&pfd, 1, CR_DA_METRICS_POLL_MSEC) > 0)
+			(void)recv(fd, request, sizeof(request), MSG_DONTWAIT);
+		pfd.fd = metricsFd;
+
+		bodyLen = metricsFormat(body, sizeof(body));
+		headerLen = snprintf(header, sizeof(header), "HTTP/1.0 200 OK\r\nContent-Type: text/plain; version=0.0.4\r\n"
+		                     "Content-Length: %d\r\n\r\n", bodyLen);
+		if (send(fd, header, headerLen, MSG_NOSIGNAL) == headerLen)
+			(void)send(fd, body, bodyLen, MSG_NOSIGNAL);
+		close(fd);
+	}
+	return NULL;
+}
+#endif
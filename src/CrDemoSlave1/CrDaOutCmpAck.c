@@ -0,0 +1,79 @@
+/**
+ * @file
+ * @ingroup crDemoSlave1
+ * Implementation of the Command Acknowledgement OutComponent.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdlib.h>
+#include "CrDaConstants.h"
+#include "CrDaOutCmpAck.h"
+#include "CrDaOutAdmit.h"
+#include "CrDaPar.h"
+#include "CrDaPcktTemplate.h"
+/* Include configuration files */
+#include "CrFwCmpData.h"
+/* Include framework files */
+#include "CrFwConstants.h"
+#include "OutCmp/CrFwOutCmp.h"
+#include "OutFactory/CrFwOutFactory.h"
+#include "OutLoader/CrFwOutLoader.h"
+#include "Pckt/CrFwPckt.h"
+#include "UtilityFunctions/CrFwUtilityFunctions.h"
+/* Include FW Profile files */
+#include "FwSmConfig.h"
+
+/** The identifier of the acknowledged command */
+static CrFwInstanceId_t ackCmdId = 0;
+
+/**
+ * Issue Function of the acknowledgements (see <code>CrDaOutAdmit.h</code>): set the
+ * identifier of the acknowledged command and load the acknowledgement.
+ * @param ack the acknowledgement
+ * @param dest the source of the acknowledged command
+ * @param arg the identifier of the acknowledged command
+ */
+static void ackIssue(FwSmDesc_t ack, CrFwDestSrc_t dest, const void* arg);
+
+/*-----------------------------------------------------------------------------------------*/
+void CrDaOutCmpAckSerialize(FwSmDesc_t smDesc) {
+	char* pcktPar = CrFwOutCmpGetParStart(smDesc);
+	CrDaPcktTemplateSerialize(smDesc);
+	CrDaParAckSetCmdId(pcktPar, ackCmdId);
+}
+
+/*-----------------------------------------------------------------------------------------*/
+void CrDaOutCmpAckSend(FwSmDesc_t inCmd) {
+	CrFwCmpData_t* cmpData = (CrFwCmpData_t*)FwSmGetData(inCmd);
+	CrFwInCmdData_t* cmpSpecificData = (CrFwInCmdData_t*)(cmpData->cmpSpecificData);
+	CrFwPckt_t pckt = cmpSpecificData->pckt; /* the packet of the InCommand */
+	CrFwInstanceId_t cmdId;
+	CrDaOutAdmitReq_t req = {CR_DA_SERV_TYPE, CR_DA_SERV_SUBTYPE_ACK, 0, 0, 0, CR_DA_OUT_ADMIT_ACK_POLICY, &ackIssue};
+
+	if (!CrFwPcktIsStartAck(pckt))
+		return;
+	cmdId = CrFwPcktGetCmdRepId(pckt);
+	req.dest = CrFwPcktGetSrc(pckt);
+
+	/* A rejected acknowledgement is counted by the source of the command as missing */
+	(void)CrDaOutAdmitIssue(&req, &cmdId, sizeof(cmdId));
+}
+
+/*-----------------------------------------------------------------------------------------*/
+static void ackIssue(FwSmDesc_t ack, CrFwDestSrc_t dest, const void* arg) {
+	ackCmdId = *(const CrFwInstanceId_t*)arg;
+	CrFwOutCmpSetDest(ack,dest);
+	CrFwOutCmpSetGroup(ack,CR_DA_PCKT_GROUP_URGENT);
+	CrFwOutLoaderLoad(ack);
+}
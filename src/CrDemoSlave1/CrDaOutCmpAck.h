@@ -0,0 +1,66 @@
+/**
+ * @file
+ * @ingroup crDemoSlave1
+ * Command Acknowledgement OutComponent.
+ * The Command Acknowledgement OutComponent is the report which a Slave Application sends
+ * to the source of a command to acknowledge its successful start.
+ * It is sent only for the commands whose start acknowledge flag is set (see
+ * <code>::CrFwPcktIsStartAck</code>) and it is used by the latency benchmark of the
+ * Master Application (see <code>CrMaLatency.h</code>).
+ * The parameter area of the report holds the command identifier of the acknowledged
+ * command (see <code>::CrFwPcktGetCmdRepId</code>).
+ * It belongs to the group of the time-critical packets (<code>#CR_DA_PCKT_GROUP_URGENT</code>)
+ * so that it is not delayed by the temperature reports.
+ * If the batched acknowledgements are selected (see <code>#CR_DA_ACK_BATCH</code>), the
+ * acknowledgements are instead carried by the acknowledgement batch reports (see
+ * <code>CrDaOutCmpAckBatch.h</code>).
+ *
+ * The Command Acknowledgement OutComponent uses the default implementation of all its
+ * adaptation points except for its Serialize Operation which writes the command
+ * identifier to the parameter area of the report.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRDA_OUTCMP_ACK_H_
+#define CRDA_OUTCMP_ACK_H_
+
+/* Include FW Profile files */
+#include "FwSmConstants.h"
+/* Include Framework Files */
+#include "CrFwConstants.h"
+/* Include Configuration Files */
+#include "CrFwUserConstants.h"
+
+/**
+ * Implementation of the Serialize Operation for the Command Acknowledgement OutComponent.
+ * This function serializes the header of the report packet with
+ * <code>::CrDaPcktTemplateSerialize</code> and then writes the identifier of
+ * the acknowledged command (as set by the last call to <code>::CrDaOutCmpAckSend</code>)
+ * to the parameter area of the report.
+ * @param smDesc the descriptor of the OutComponent state machine
+ */
+void CrDaOutCmpAckSerialize(FwSmDesc_t smDesc);
+
+/**
+ * Send the acknowledgement of the successful start of an InCommand.
+ * If the start acknowledge flag of the InCommand is set, this function makes a Command
+ * Acknowledgement OutComponent, sets its destination to the source of the InCommand and
+ * loads it into the OutLoader.
+ * Otherwise, it does nothing.
+ * If no OutComponent can be made, the acknowledgement is not sent.
+ * @param inCmd the InCommand
+ */
+void CrDaOutCmpAckSend(FwSmDesc_t inCmd);
+
+#endif /* CRDA_OUTCMP_ACK_H_ */
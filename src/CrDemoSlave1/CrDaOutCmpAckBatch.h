@@ -0,0 +1,115 @@
+/**
+ * @file
+ * @ingroup crDemoSlave1
+ * Interface for the acknowledgement batch report of the CORDET Demo.
+ * When the batched acknowledgements are selected (see <code>#CR_DA_ACK_BATCH</code>), a
+ * Slave Application does not send one Command Acknowledgement report (see
+ * <code>CrDaOutCmpAck.h</code>) for each InCommand.
+ * It instead adds the outcomes of its InCommands (<code>::CrDaOutCmpAckBatchAdd</code>)
+ * to the pending batch of the source of the InCommand:
+ * - the failures of the acceptance, start, progress or termination and the load failures
+ *   are always added;
+ * - the successful acceptance, start, progress or termination is added if the source has
+ *   requested its acknowledgement (see <code>::CrFwPcktIsStartAck</code>).
+ * .
+ * The pending batch of each source is sent to it as one report:
+ * - at the end of the control cycle (<code>::CrDaOutCmpAckBatchFlush</code>) if it holds
+ *   at least one outcome; or
+ * - as soon as it holds <code>#CR_DA_ACK_BATCH_MAX_N</code> outcomes.
+ * .
+ * As the batch report of temperature violations (see <code>CrDaOutCmpTempBatch.h</code>),
+ * the batch is written into the parameter area of the packet of the report when the
+ * report is made.
+ * The parameter area of an acknowledgement batch report holds the number of outcomes in
+ * its first byte, followed by one entry of <code>#CR_DA_ACK_BATCH_ENTRY_LENGTH</code>
+ * bytes for each outcome:
+ * - the command identifier of the InCommand (<code>::CrFwInstanceId_t</code>, see
+ *   <code>::CrFwPcktGetCmdRepId</code>);
+ * - the outcome (<code>::CrFwRepInCmdOutcome_t</code> in one byte);
+ * - the failure code (<code>::CrFwOutcome_t</code>).
+ * .
+ * The layout of the entries is the parameter kind <code>AckEntry</code> of the schema
+ * <code>#CR_DA_PAR_SCHEMA</code>.
+ * The Master Application reads an acknowledgement batch report with
+ * <code>::CrDaOutCmpAckBatchGetN</code> and <code>::CrDaOutCmpAckBatchGetEntry</code>.
+ * The report belongs to the group of the time-critical packets
+ * (<code>#CR_DA_PCKT_GROUP_URGENT</code>).
+ *
+ * If an acknowledgement batch report cannot be made because the OutFactory or the packet
+ * pool is exhausted, the outcomes of the batch are lost.
+ * The number of batch reports and of lost outcomes is printed by
+ * <code>::CrDaOutCmpAckBatchReport</code>.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRDA_OUTCMP_ACK_BATCH_H_
+#define CRDA_OUTCMP_ACK_BATCH_H_
+
+/* Include framework components */
+#include "CrFwConstants.h"
+/* Include configuration files */
+#include "CrFwUserConstants.h"
+#include "CrDaPar.h"
+
+/** The length in number of bytes of the entry of one outcome in an acknowledgement batch report. */
+#define CR_DA_ACK_BATCH_ENTRY_LENGTH CR_DA_PAR_LENGTH(AckEntry)
+
+/**
+ * Add the outcome of an InCommand to the pending batch of its source.
+ * Nothing is done if the outcome is a success whose acknowledgement has not been
+ * requested.
+ * The batch report is made and loaded if the batch is full.
+ * @param pckt the packet of the InCommand
+ * @param outcome the outcome
+ * @param failCode the failure code (it is only meaningful for the failures)
+ */
+void CrDaOutCmpAckBatchAdd(CrFwPckt_t pckt, CrFwRepInCmdOutcome_t outcome, CrFwOutcome_t failCode);
+
+/**
+ * Make and load the report of the pending batch of each source which holds at least one
+ * outcome.
+ * This function must be called by the Slave Applications at the end of the execution of
+ * their InManagers in each control cycle.
+ * Nothing is done if the batched acknowledgements are not selected (the batches are then
+ * always empty).
+ */
+void CrDaOutCmpAckBatchFlush();
+
+/**
+ * Get the number of outcomes of an acknowledgement batch report.
+ * @param pcktPar the parameter area of the report
+ * @return the number of outcomes
+ */
+unsigned int CrDaOutCmpAckBatchGetN(const char* pcktPar);
+
+/**
+ * Get one outcome of an acknowledgement batch report.
+ * @param pcktPar the parameter area of the report
+ * @param i the index of the outcome (it must be smaller than the number of outcomes)
+ * @param cmdId the location where the command identifier of the InCommand is returned
+ * @param outcome the location where the outcome is returned
+ * @param failCode the location where the failure code is returned
+ */
+void CrDaOutCmpAckBatchGetEntry(const char* pcktPar, unsigned int i, CrFwInstanceId_t* cmdId,
+                                CrFwRepInCmdOutcome_t* outcome, CrFwOutcome_t* failCode);
+
+/**
+ * Print the number of acknowledgement batch reports, the average number of outcomes
+ * which they carried and the number of lost outcomes.
+ * Nothing is printed if the batched acknowledgements are not selected.
+ * @param app the name of the application (e.g. "S1")
+ */
+void CrDaOutCmpAckBatchReport(const char* app);
+
+#endif /* CRDA_OUTCMP_ACK_BATCH_H_ */
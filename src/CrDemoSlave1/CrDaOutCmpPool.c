@@ -0,0 +1,55 @@
+/**
+ * @file
+ * @ingroup crDemoSlave1
+ * Implementation of the OutComponent pool of the demo applications of the CORDET Demo.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdio.h>
+#include "CrDaOutCmpPool.h"
+/* Include configuration files */
+#include "CrFwOutFactoryUserPar.h"
+/* Include framework files */
+#include "OutFactory/CrFwOutFactory.h"
+
+/** The statistics of the OutComponent pool. */
+static CrDaOutCmpPoolStats_t poolStats;
+
+/* ---------------------------------------------------------------------------------------------*/
+FwSmDesc_t CrDaOutCmpPoolMake(CrFwServType_t type, CrFwServSubType_t subType, CrFwDiscriminant_t discriminant,
+                              CrFwPcktLength_t length) {
+	FwSmDesc_t outCmp = CrFwOutFactoryMakeOutCmp(type, subType, discriminant, length);
+	unsigned int nOfAllocated;
+
+	if (outCmp == NULL) {
+		poolStats.nOfMakeFail++;
+		return NULL;
+	}
+	poolStats.nOfMake++;
+	nOfAllocated = CrFwOutFactoryGetNOfAllocatedOutCmp();
+	if (nOfAllocated > poolStats.highWaterMark)
+		poolStats.highWaterMark = nOfAllocated;
+	return outCmp;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaOutCmpPoolGetStats(CrDaOutCmpPoolStats_t* stats) {
+	*stats = poolStats;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaOutCmpPoolReport(const char* app) {
+	printf("%s: OutComponent pool: high-water mark %u of %d, %llu allocations, %llu failed allocations\n", app,
+	       poolStats.highWaterMark, CR_FW_OUTFACTORY_MAX_NOF_OUTCMP, poolStats.nOfMake, poolStats.nOfMakeFail);
+}
@@ -0,0 +1,139 @@
+/**
+ * @file
+ * @ingroup crDemoSlave1
+ * Implementation of the queue through which the application threads of the demo
+ * applications of the CORDET Demo issue OutComponents.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "CrDaOutLoadQueue.h"
+
+#if ((CR_DA_OUT_LOAD_QUEUE_SIZE & (CR_DA_OUT_LOAD_QUEUE_SIZE-1)) != 0)
+#error "CR_DA_OUT_LOAD_QUEUE_SIZE must be a power of two"
+#endif
+
+/** Type for a slot of the queue. */
+typedef struct {
+	/** The sequence number of the slot minus the index of the slot. */
+	unsigned long long seq;
+	/** The request of the slot. */
+	CrDaOutAdmitReq_t req;
+	/** The length of the argument of the request. */
+	unsigned int argLength;
+	/** The argument of the Issue Function of the request. */
+	unsigned char arg[CR_DA_OUT_ADMIT_ARG_SIZE];
+} CrDaOutLoadQueueSlot_t;
+
+/** The slots of the queue. */
+static CrDaOutLoadQueueSlot_t loadSlot[CR_DA_OUT_LOAD_QUEUE_SIZE];
+
+/** The number of slots which have been claimed by the producers. */
+static unsigned long long loadHead = 0;
+
+/** The number of slots which have been released by the consumer. */
+static unsigned long long loadTail = 0;
+
+/** The statistics of the queue (the counters of the producers are incremented atomically). */
+static CrDaOutLoadQueueStats_t stats;
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaOutLoadQueuePush(const CrDaOutAdmitReq_t* req, const void* arg, unsigned int argLength) {
+	unsigned long long head, seq, idx;
+	CrDaOutLoadQueueSlot_t* slot;
+	unsigned int depth, max;
+
+	if (argLength > CR_DA_OUT_ADMIT_ARG_SIZE) {
+		__atomic_fetch_add(&stats.nOfFull, 1, __ATOMIC_RELAXED);
+		return 0;
+	}
+
+	head = __atomic_load_n(&loadHead, __ATOMIC_RELAXED);
+	for (;;) {
+		idx = head % CR_DA_OUT_LOAD_QUEUE_SIZE;
+		slot = &loadSlot[idx];
+		seq = __atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) + idx;
+		if (seq == head) {
+			if (__atomic_compare_exchange_n(&loadHead, &head, head+1, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+				break;	/* the slot has been claimed */
+		} else if (seq < head) {
+			/* The slot still holds the request of the previous round: the queue is full */
+			__atomic_fetch_add(&stats.nOfFull, 1, __ATOMIC_RELAXED);
+			return 0;
+		} else
+			head = __atomic_load_n(&loadHead, __ATOMIC_RELAXED);
+	}
+	slot->req = *req;
+	slot->argLength = argLength;
+	memcpy(slot->arg, arg, argLength);
+	/* The request is complete before it is published */
+	__atomic_store_n(&slot->seq, head+1-idx, __ATOMIC_RELEASE);
+
+	__atomic_fetch_add(&stats.nOfPushed, 1, __ATOMIC_RELAXED);
+	depth = (unsigned int)(head + 1 - __atomic_load_n(&loadTail, __ATOMIC_RELAXED));
+	max = __atomic_load_n(&stats.highWaterMark, __ATOMIC_RELAXED);
+	while ((depth > max) &&
+	        !__atomic_compare_exchange_n(&stats.highWaterMark, &max, depth, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+		;
+	return 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+unsigned int CrDaOutLoadQueueDrain() {
+	unsigned long long end = __atomic_load_n(&loadHead, __ATOMIC_RELAXED);
+	CrDaOutLoadQueueSlot_t* slot;
+	CrDaOutAdmitReq_t req;
+	unsigned char arg[CR_DA_OUT_ADMIT_ARG_SIZE];
+	unsigned int argLength;
+	unsigned long long idx;
+	unsigned int n;
+
+	for (n=0; loadTail<end; n++) {
+		idx = loadTail % CR_DA_OUT_LOAD_QUEUE_SIZE;
+		slot = &loadSlot[idx];
+		if (__atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) + idx != loadTail+1)
+			break;	/* the slot has been claimed but it has not been published yet */
+		req = slot->req;
+		argLength = slot->argLength;
+		memcpy(arg, slot->arg, argLength);
+		/* The slot is released before the request is issued so that the producers can reuse it */
+		__atomic_store_n(&slot->seq, loadTail+CR_DA_OUT_LOAD_QUEUE_SIZE-idx, __ATOMIC_RELEASE);
+		__atomic_store_n(&loadTail, loadTail+1, __ATOMIC_RELAXED);
+		if (!CrDaOutAdmitIssue(&req, arg, argLength))
+			stats.nOfRejected++;
+	}
+	stats.nOfDrained += n;
+	return n;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaOutLoadQueueGetStats(CrDaOutLoadQueueStats_t* s) {
+	s->nOfPushed = __atomic_load_n(&stats.nOfPushed, __ATOMIC_RELAXED);
+	s->nOfFull = __atomic_load_n(&stats.nOfFull, __ATOMIC_RELAXED);
+	s->nOfDrained = stats.nOfDrained;
+	s->nOfRejected = stats.nOfRejected;
+	s->highWaterMark = __atomic_load_n(&stats.highWaterMark, __ATOMIC_RELAXED);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaOutLoadQueueReport(const char* app) {
+	CrDaOutLoadQueueStats_t s;
+
+	CrDaOutLoadQueueGetStats(&s);
+	if ((s.nOfPushed == 0) && (s.nOfFull == 0))
+		return;
+	printf("%s: OutLoader queue of the application threads: %llu requests pushed, %llu rejected (queue full), %llu issued (%llu rejected by the admission control), high-water mark %u of %d\n",
+	       app, s.nOfPushed, s.nOfFull, s.nOfDrained, s.nOfRejected, s.highWaterMark, CR_DA_OUT_LOAD_QUEUE_SIZE);
+}
@@ -0,0 +1,106 @@
+/**
+ * @file
+ * @ingroup crDemoSlave1
+ * Interface for the queue through which the application threads of the demo applications
+ * of the CORDET Demo issue OutComponents.
+ * The OutFactory, the OutLoader and the OutManagers are only used by the thread of the
+ * control cycles (and, with the manager pool, by the threads to which it hands them):
+ * a thread of the application logic (e.g. a sampler thread) may not make or load an
+ * OutComponent.
+ *
+ * Such a thread instead pushes the request to make, configure and load an OutComponent
+ * (a <code>::CrDaOutAdmitReq_t</code> with the argument of its Issue Function, see
+ * <code>CrDaOutAdmit.h</code>) into this queue (<code>::CrDaOutLoadQueuePush</code>).
+ * The thread of the control cycles drains the queue at the start of the execution of the
+ * OutManagers (<code>::CrDaOutLoadQueueDrain</code>): it issues each request through the
+ * admission control, which makes the OutComponent and calls the Issue Function, so that
+ * a request which finds no OutComponent is handled according to its policy.
+ * The Issue Functions of the requests are therefore called by the thread of the control
+ * cycles: they must only use their argument and the state which that thread owns.
+ *
+ * The queue has several producers (the application threads) and one consumer (the
+ * thread of the control cycles) and it works as the error event queue (see
+ * <code>CrDaErrQueue.h</code>): each of its <code>#CR_DA_OUT_LOAD_QUEUE_SIZE</code> slots
+ * carries a sequence number which tells whether it is free or holds a request, a producer
+ * claims the next slot with a compare-and-swap of the head and publishes its request with
+ * a release store of the sequence number, and the consumer releases a slot with a release
+ * store of its sequence number after it has issued the request.
+ * A producer never takes a lock, never waits and never touches the state of the
+ * framework: a request which finds the queue full is rejected and counted.
+ * The requests of one producer are issued in the order in which they were pushed.
+ *
+ * A drain issues at most the requests which were published when it started so that
+ * producers which push faster than the OutManagers send cannot keep the thread of the
+ * control cycles in the drain.
+ * The statistics of the queue are printed by <code>::CrDaOutLoadQueueReport</code>.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRDA_OUTLOADQUEUE_H_
+#define CRDA_OUTLOADQUEUE_H_
+
+/* Include Framework Files */
+#include "CrFwConstants.h"
+/* Include Configuration Files */
+#include "CrFwUserConstants.h"
+#include "CrDaConstants.h"
+#include "CrDaOutAdmit.h"
+
+/** The statistics of the queue of the application threads. */
+typedef struct {
+	/** The number of requests which have been pushed into the queue. */
+	unsigned long long nOfPushed;
+	/** The number of requests which were rejected because the queue was full (or their argument too large). */
+	unsigned long long nOfFull;
+	/** The number of requests which have been drained and issued. */
+	unsigned long long nOfDrained;
+	/** The number of drained requests which the admission control rejected. */
+	unsigned long long nOfRejected;
+	/** The largest number of requests which were in the queue when a request was pushed. */
+	unsigned int highWaterMark;
+} CrDaOutLoadQueueStats_t;
+
+/**
+ * Push a request into the queue.
+ * This function may be called by any thread: it never waits.
+ * @param req the request
+ * @param arg the argument of the Issue Function of the request
+ * @param argLength the length in bytes of the argument (at most
+ * <code>#CR_DA_OUT_ADMIT_ARG_SIZE</code>)
+ * @return 1 if the request was queued; 0 if it was rejected
+ */
+CrFwBool_t CrDaOutLoadQueuePush(const CrDaOutAdmitReq_t* req, const void* arg, unsigned int argLength);
+
+/**
+ * Issue the requests which have been published in the queue.
+ * This function must only be called by the thread of the control cycles: it is called
+ * by the Cycle Work Function before it executes the OutManagers.
+ * @return the number of requests which have been issued
+ */
+unsigned int CrDaOutLoadQueueDrain();
+
+/**
+ * Get the statistics of the queue.
+ * @param stats the statistics (output)
+ */
+void CrDaOutLoadQueueGetStats(CrDaOutLoadQueueStats_t* stats);
+
+/**
+ * Print the statistics of the queue.
+ * Nothing is printed if no request has been pushed.
+ * @param app the name of the application (e.g. "MA")
+ */
+void CrDaOutLoadQueueReport(const char* app);
+
+#endif /* CRDA_OUTLOADQUEUE_H_ */
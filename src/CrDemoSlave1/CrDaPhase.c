@@ -0,0 +1,161 @@
+/**
+ * @file
+ * @ingroup crDemoSlave1
+ * Implementation of the phase timing of the control cycles of the demo applications.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "CrDaPhase.h"
+#include "CrDaLog.h"
+
+/** The number of linear buckets into which each power of two is divided. */
+#define CR_DA_PHASE_N_OF_SUB_BUCKETS (1U << CR_DA_PHASE_SUB_BUCKET_BITS)
+
+/** The number of buckets of the histogram of a phase (covering all 64-bit durations). */
+#define CR_DA_PHASE_N_OF_BUCKETS ((65U - CR_DA_PHASE_SUB_BUCKET_BITS) * CR_DA_PHASE_N_OF_SUB_BUCKETS)
+
+/** Type for the timing data of a phase. */
+typedef struct {
+	/** The time at which the phase was last started. */
+	struct timespec start;
+	/** The number of recorded durations. */
+	unsigned int nOfSamples;
+	/** The sum of the recorded durations. */
+	unsigned long long sum;
+	/** The shortest recorded duration. */
+	unsigned long long min;
+	/** The longest recorded duration. */
+	unsigned long long max;
+	/** The histogram of the recorded durations. */
+	unsigned int hist[CR_DA_PHASE_N_OF_BUCKETS];
+} CrDaPhaseData_t;
+
+/** The timing data of the phases. */
+static CrDaPhaseData_t phaseData[CR_DA_PHASE_N_OF_PHASES];
+
+/** The names of the phases in the summary line. */
+static const char* phaseName[CR_DA_PHASE_N_OF_PHASES] = {"poll", "inLoader", "inManager", "outManager"};
+
+/**
+ * Return the bucket of the histogram which holds a duration.
+ * @param d the duration in nanoseconds
+ * @return the bucket
+ */
+static unsigned int phaseBucket(unsigned long long d);
+
+/**
+ * Return the largest duration held by a bucket of the histogram.
+ * @param bucket the bucket
+ * @return the largest duration in nanoseconds
+ */
+static unsigned long long phaseBucketMax(unsigned int bucket);
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaPhaseStart(CrDaPhase_t phase) {
+	clock_gettime(CLOCK_MONOTONIC, &phaseData[phase].start);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaPhaseStop(CrDaPhase_t phase) {
+	CrDaPhaseData_t* data = &phaseData[phase];
+	struct timespec now;
+	unsigned long long d;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	d = (unsigned long long)((long long)(now.tv_sec - data->start.tv_sec) * 1000000000LL +
+	                         (now.tv_nsec - data->start.tv_nsec));
+	if ((data->nOfSamples == 0) || (d < data->min))
+		data->min = d;
+	if (d > data->max)
+		data->max = d;
+	data->sum += d;
+	data->nOfSamples++;
+	data->hist[phaseBucket(d)]++;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaPhaseGetStats(CrDaPhase_t phase, CrDaPhaseStats_t* stats) {
+	CrDaPhaseData_t* data = &phaseData[phase];
+	unsigned int rank, count, bucket;
+
+	memset(stats, 0, sizeof(CrDaPhaseStats_t));
+	if (data->nOfSamples == 0)
+		return;
+	stats->nOfSamples = data->nOfSamples;
+	stats->min = data->min;
+	stats->mean = data->sum / data->nOfSamples;
+	stats->max = data->max;
+
+	/* The 99th percentile is the smallest duration which is not exceeded by 99% of the samples */
+	rank = (unsigned int)(((unsigned long long)data->nOfSamples * 99 + 99) / 100);
+	count = 0;
+	for (bucket=0; bucket<CR_DA_PHASE_N_OF_BUCKETS; bucket++) {
+		count += data->hist[bucket];
+		if (count >= rank)
+			break;
+	}
+	stats->p99 = phaseBucketMax(bucket);
+	if (stats->p99 > data->max)
+		stats->p99 = data->max;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaPhaseReport(const char* app) {
+	CrDaPhaseStats_t stats;
+	char line[CR_DA_LOG_MSG_SIZE];
+	int phase, len;
+
+	/* The summary is written as one log message (see CrDaLog.h) */
+	len = snprintf(line, sizeof(line), "%s: Phase timing in us (min/mean/max/p99):", app);
+	for (phase=0; phase<CR_DA_PHASE_N_OF_PHASES; phase++) {
+		CrDaPhaseGetStats((CrDaPhase_t)phase, &stats);
+		if ((len > 0) && (len < (int)sizeof(line)))
+			len += snprintf(line + len, sizeof(line) - len, " %s %.1f/%.1f/%.1f/%.1f", phaseName[phase],
+			                stats.min / 1000.0, stats.mean / 1000.0, stats.max / 1000.0, stats.p99 / 1000.0);
+	}
+	CR_DA_LOG(crDaLogInfo, "%s\n", line);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaPhaseReset() {
+	memset(phaseData, 0, sizeof(phaseData));
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static unsigned int phaseBucket(unsigned long long d) {
+	unsigned int e;
+
+	/* The durations below two powers of the sub-buckets have one bucket each */
+	if (d < 2 * CR_DA_PHASE_N_OF_SUB_BUCKETS)
+		return (unsigned int)d;
+	e = 63U - (unsigned int)__builtin_clzll(d);
+	return (e - CR_DA_PHASE_SUB_BUCKET_BITS + 1) * CR_DA_PHASE_N_OF_SUB_BUCKETS +
+	       (unsigned int)(d >> (e - CR_DA_PHASE_SUB_BUCKET_BITS)) - CR_DA_PHASE_N_OF_SUB_BUCKETS;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static unsigned long long phaseBucketMax(unsigned int bucket) {
+	unsigned int e, shift;
+	unsigned long long lower;
+
+	if (bucket < 2 * CR_DA_PHASE_N_OF_SUB_BUCKETS)
+		return bucket;
+	e = bucket / CR_DA_PHASE_N_OF_SUB_BUCKETS + CR_DA_PHASE_SUB_BUCKET_BITS - 1;
+	shift = e - CR_DA_PHASE_SUB_BUCKET_BITS;
+	lower = (unsigned long long)(bucket % CR_DA_PHASE_N_OF_SUB_BUCKETS + CR_DA_PHASE_N_OF_SUB_BUCKETS) << shift;
+	return lower + ((1ULL << shift) - 1);
+}
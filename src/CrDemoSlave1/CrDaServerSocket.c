@@ -20,7 +20,20 @@
 #include <stdio.h>
 #include <errno.h>
 #include "CrDaServerSocket.h"
+#include "CrDaStreamMap.h"
+#include "CrDaLinkStats.h"
+#include "CrDaMetrics.h"
+#include "CrDaLatTrace.h"
+#include "CrDaCapture.h"
 #include "CrDaConstants.h"
+#include "CrDaRxRing.h"
+#include "CrDaTxQueue.h"
+#include "CrDaCrc.h"
+#include "CrDaHandshake.h"
+#include "CrDaSocketProfile.h"
+#if (CR_DA_SOCKET_URING == 1)
+#include "CrDaUring.h"
+#endif
 /* Include FW Profile files */
 #include "FwSmConstants.h"
 #include "FwSmConfig.h"
@@ -35,21 +48,35 @@
 #include "OutStream/CrFwOutStream.h"
 #include "BaseCmp/CrFwBaseCmp.h"
 #include "Pckt/CrFwPckt.h"
+#include "CrFwPcktInline.h"
+#include "CrFwPcktPart.h"
+#include "CrFwPcktRefCnt.h"
 #include "CrFwTime.h"
 #include "CrFwRepErr.h"
 #include "UtilityFunctions/CrFwUtilityFunctions.h"
+/** The server socket uses the epoll backend unless the io_uring backend is selected */
+#if (CR_DA_SOCKET_EPOLL == 1) && (CR_DA_SOCKET_URING == 0)
+#define CR_DA_SERVER_SOCKET_EPOLL 1
+#else
+#define CR_DA_SERVER_SOCKET_EPOLL 0
+#endif
 /* Include file for socket implementation */
 #include <stdio.h>
 #include <stdlib.h>
 #include <unistd.h>
 #include <string.h>
+#include <stdint.h>
 #include <sys/types.h>
 #include <sys/socket.h>
 #include <netinet/in.h>
 #include <netdb.h>
 #include <fcntl.h>
 #include <errno.h>
-#include <pthread.h>
+#include <time.h>
+#include <poll.h>
+#if (CR_DA_SERVER_SOCKET_EPOLL == 1)
+#include <sys/epoll.h>
+#endif
 
 /** Set the port number (must be same as the port number specified in <code>CrDaServerSocket.c</code> */
 static int portno = 0;
@@ -57,57 +84,391 @@ static int portno = 0;
 /** The file descriptors for the socket */
 static int sockfd = 0;
 
-/** The file descriptors for the client sockets */
-static int newsockfd[2];
-
+#if (CR_DA_SOCKET_URING == 0)
 /** Socket variable */
 static struct sockaddr_in cli_addr;
 
 /** Socket variable */
 static socklen_t clilen;
+#endif
 
 /** The maximum size of an incoming packet */
 static int pcktMaxLength;
 
-/** The Read Buffers */
-static unsigned char* readBuffer[2];
+/** The number of values of a destination or source identifier */
+#define CR_DA_SERVER_SOCKET_NOF_DEST_SRC (1 << (8*sizeof(CrFwDestSrc_t)))
+
+/** The number of words of the bit mask of the connections whose transmit queue is full */
+#define CR_DA_SERVER_SOCKET_NOF_BLOCKED_WORDS ((CR_DA_SERVER_SOCKET_MAX_NOF_CLIENTS+31)/32)
+
+#if (CR_DA_SOCKET_URING == 1)
+/** Type for a buffer received by the io_uring backend which has not yet been moved to a receive ring buffer. */
+typedef struct {
+	/** The identifier of the provided buffer. */
+	unsigned int bid;
+	/** The number of bytes received into the buffer. */
+	unsigned int len;
+} CrDaServerSocketBuf_t;
+#endif
+
+/** Type for a client connection of the server socket. */
+typedef struct {
+	/** The file descriptor of the connection or -1 if the connection is not in use. */
+	int fd;
+	/** Flag which is set when the client has announced its application identifier. */
+	CrFwBool_t announced;
+	/** The application identifier announced by the client. */
+	CrFwDestSrc_t appId;
+	/** The index of the connection among the connections of its client (see <code>#CR_DA_SOCKET_N_OF_CONNS</code>). */
+	unsigned char connId;
+	/** The Pending Packets of the connection in the order in which they have arrived. */
+	CrFwPckt_t pendingPckt[CR_DA_SERVER_SOCKET_RX_QUEUE_SIZE];
+	/** The number of Pending Packets of the connection. */
+	unsigned int nOfPending;
+	/** The receive ring buffer of the connection. */
+	CrDaRxRing_t rxRing;
+	/** The transmit queue of the connection. */
+	CrDaTxQueue_t txQueue;
+	/** The length of the trailer of the packets received on the connection (see <code>CrDaHandshake.h</code>). */
+	unsigned int trailerLength;
+	/**
+	 * Flag which is set when data may be waiting to be read from the connection.
+	 * The flag is permanently set if the epoll backend is not used.
+	 * If the epoll backend is used, the flag is set when the epoll instance reports
+	 * new data on the connection and it is cleared when a read finds no further data.
+	 */
+	CrFwBool_t rxReady;
+#if (CR_DA_SOCKET_URING == 1)
+	/** The generation of the connection (it identifies the completions which belong to the current client). */
+	unsigned int gen;
+	/** Flag which is set while a multishot receive operation is armed on the connection. */
+	CrFwBool_t recvArmed;
+	/** Flag which is set when the client has closed the connection. */
+	CrFwBool_t eof;
+	/** Flag which is set while a send operation of the transmit queue is in flight. */
+	CrFwBool_t sending;
+	/** The message header of the send operation in flight. */
+	struct msghdr msg;
+	/** The I/O vector of the send operation in flight. */
+	struct iovec iov[CR_DA_TX_QUEUE_NOF_IOV];
+	/** The received buffers which have not yet been moved to the receive ring buffer. */
+	CrDaServerSocketBuf_t rxBuf[CR_DA_URING_NOF_BUFS];
+	/** The index of the first received buffer. */
+	unsigned int rxBufHead;
+	/** The number of received buffers. */
+	unsigned int rxBufCount;
+	/** The number of bytes of the first received buffer which have already been moved. */
+	unsigned int rxBufOffset;
+#endif
+} CrDaServerSocketConn_t;
+
+/** The client connections */
+static CrDaServerSocketConn_t conn[CR_DA_SERVER_SOCKET_MAX_NOF_CLIENTS];
+
+/** The number of client connections in use */
+static int nOfConn = 0;
+
+/** The number of client connections which must be accepted before the socket can be configured */
+static int nOfClients = 0;
+
+/**
+ * The routing table of the server socket.
+ * Entry [i][k] holds the index of the k-th connection of the client which has announced
+ * application identifier i or -1 if no such connection is established.
+ */
+static int connOfApp[CR_DA_SERVER_SOCKET_NOF_DEST_SRC][CR_DA_SOCKET_N_OF_CONNS];
+
+/**
+ * The index of the connection whose packet is being signalled to its InStream by
+ * <code>::CrDaServerSocketPoll</code> or -1 if no packet is being signalled.
+ * This allows packets whose source is not the application identifier of their
+ * connection (e.g. packets which are forwarded by the client) to be collected.
+ */
+static int pollConn = -1;
+
+/**
+ * The number of packets which have been collected by the InStreams.
+ * The counter is used by <code>::CrDaServerSocketWait</code> to detect the arrival of packets.
+ */
+static unsigned int nOfCollected = 0;
+
+/**
+ * Signal the arrival of a packet from a source to the InStream associated to the source.
+ * This is the default Packet Available Function of the server socket.
+ * @param src the source of the packet
+ */
+static void serverSocketPcktAvail(CrFwDestSrc_t src);
+
+/** The Packet Available Function (see <code>::CrDaServerSocketSetPcktAvail</code>). */
+static void (*pcktAvail)(CrFwDestSrc_t src) = &serverSocketPcktAvail;
+
+/**
+ * Flag which is set when connection requests may be waiting to be accepted.
+ * The flag is permanently set if the epoll backend is not used.
+ */
+static CrFwBool_t acceptReady;
+
+#if (CR_DA_SERVER_SOCKET_EPOLL == 1)
+/** The epoll instance which monitors the socket and the client connections */
+static int epfd = -1;
+
+/**
+ * Wait until new data or connection requests arrive or until a timeout expires.
+ * The flags <code>::acceptReady</code> and <code>rxReady</code> of the connections
+ * on which new data have arrived are set.
+ * @param timeout the timeout in milliseconds (zero to return immediately)
+ * @return the number of events which have arrived, 0 if the timeout has expired,
+ * or -1 if the wait failed
+ */
+static int serverSocketWaitReady(int timeout);
+#endif
+
+#if (CR_DA_SOCKET_URING == 1)
+/** The io_uring instance which performs the operations on the socket and the client connections */
+static CrDaUring_t uring = {-1};
+
+/** Flag which is set while the multishot accept operation is armed on the socket */
+static CrFwBool_t acceptArmed = 0;
+
+/** The number of provided buffers which are held by the connections */
+static unsigned int nOfHeldBufs = 0;
+
+/** The operation which accepts the connection requests */
+#define CR_DA_SERVER_SOCKET_OP_ACCEPT 0
+/** The operation which receives data on a connection */
+#define CR_DA_SERVER_SOCKET_OP_RECV 1
+/** The operation which sends the transmit queue of a connection */
+#define CR_DA_SERVER_SOCKET_OP_SEND 2
+/** The operation which cancels the operations on a connection */
+#define CR_DA_SERVER_SOCKET_OP_CANCEL 3
+
+/** Encode an operation, the index of its connection and the generation of its connection as user data */
+#define CR_DA_SERVER_SOCKET_USER_DATA(op, i, gen) \
+	(((uint64_t)(gen) << 32) | ((uint64_t)(op) << 16) | (uint64_t)(i))
+
+/**
+ * Submit the pending operations and wait until new data or connection requests arrive
+ * or until a timeout expires.
+ * The pending operations are placed in the submission queue (see <code>::serverSocketPrep</code>)
+ * and they are submitted with the same system call which waits for the completions.
+ * The send operations normally complete during the submission: the wait therefore
+ * only ends when one more completion than the number of submitted send operations
+ * has arrived.
+ * The completions which have arrived are then processed (see <code>::serverSocketReap</code>).
+ * @param timeout the timeout in milliseconds (zero to return immediately)
+ * @return the number of completions which have arrived, 0 if the timeout has expired,
+ * or -1 if the wait failed
+ */
+static int serverSocketWaitReady(int timeout);
+
+/**
+ * Place the pending operations in the submission queue of the io_uring instance.
+ * The multishot accept and receive operations which have terminated are armed
+ * again (a receive operation is only armed if provided buffers are available) and
+ * the transmit queues of the connections are placed in the submission queue.
+ * @return the number of send operations placed in the submission queue
+ */
+static int serverSocketPrep();
+
+/**
+ * Place a send operation for the transmit queue of a client connection in the submission queue.
+ * Nothing is done if the transmit queue is empty or if a send operation is already in flight.
+ * @param i the index of the connection
+ * @return 1 if a send operation was placed in the submission queue; 0 otherwise
+ */
+static CrFwBool_t serverSocketPrepSend(int i);
+
+/**
+ * Give the buffers received on a client connection back to the kernel without
+ * moving them to the receive ring buffer.
+ * @param i the index of the connection
+ */
+static void serverSocketReleaseBufs(int i);
+
+/**
+ * Process the completions in the completion queue of the io_uring instance.
+ * This function does not make any system call.
+ * Accepted connections are added to the connection table, the buffers received on
+ * a connection are queued until they can be moved to its receive ring buffer, and
+ * the bytes which have been sent are removed from the transmit queues.
+ * @return the number of completions processed
+ */
+static int serverSocketReap();
+
+/**
+ * Process one completion of the io_uring instance.
+ * Completions which belong to a previous client of a connection are discarded.
+ * @param cqe the completion
+ */
+static void serverSocketComplete(struct io_uring_cqe* cqe);
+#else
+/**
+ * Accept all pending connection requests from client sockets.
+ * Connection requests in excess of <code>#CR_DA_SERVER_SOCKET_MAX_NOF_CLIENTS</code>
+ * are rejected.
+ */
+static void serverSocketAccept();
+#endif
+
+/**
+ * Add an accepted connection to the connection table.
+ * The connection is set to non-blocking mode and is allocated a receive ring buffer
+ * and a transmit queue.
+ * If the connection table is full, the connection is closed.
+ * @param nsockfd the file descriptor of the connection
+ */
+static void serverSocketAdd(int nsockfd);
+
+/**
+ * Close a client connection and release its resources.
+ * @param i the index of the connection
+ */
+static void serverSocketClose(int i);
+
+/**
+ * Write the packets in the transmit queue of a client connection to the socket.
+ * If the write operation finds that the client has closed its connection, the
+ * connection is closed.
+ * @param i the index of the connection
+ */
+static void serverSocketFlush(int i);
 
 /**
- * Entry point for the thread which waits for the incoming connection from the client socket.
- * @param ptr unused argument (required with compatibility with pthread create function)
+ * Poll a client connection for data.
+ * @param i the index of the connection
  */
-static void* acceptThreadEntry(void* ptr);
+static void serverSocketPoll(int i);
 
 /**
- * Poll the socket for data from one of the two clients.
- * @param nsockfd the socket which is to be polled
- * @param buffer the Read Buffer associated to the client which is to be polled
+ * Collect the first Pending Packet from the argument source from a client connection.
+ * @param src the source
+ * @param i the index of the connection
+ * @return the packet collected from the argument source or NULL if no Pending Packet
+ * of the connection is a packet from the argument source
  */
-static void serverSocketPoll(int nsockfd, unsigned char* buffer);
+static CrFwPckt_t serverSocketPcktCollect(CrFwDestSrc_t src, int i);
 
 /**
- * Check whether a packet from the argument source is available.
+ * Return the position of the first Pending Packet from a source in the Pending Packets of
+ * a client connection.
+ * @param i the index of the connection
  * @param src the source
- * @param nsockfd the socket which is to be polled
- * @param buffer the Read Buffer associated to the client which is to be polled
- * @return 1 if a packet is avaiable; 0 otherwise
+ * @return the position of the packet or -1 if no Pending Packet is a packet from the source
  */
-static CrFwBool_t serverSocketIsPcktAvail(CrFwDestSrc_t src, int nsockfd, unsigned char* buffer);
+static int serverSocketFindPckt(int i, CrFwDestSrc_t src);
 
 /**
- * Collect a packet from the argument source.
+ * Remove a Pending Packet from a client connection.
+ * The later Pending Packets keep their order.
+ * @param i the index of the connection
+ * @param k the position of the packet in the Pending Packets
+ * @return the packet
+ */
+static CrFwPckt_t serverSocketTakePckt(int i, unsigned int k);
+
+/**
+ * Release the Pending Packets of a client connection.
+ * @param i the index of the connection
+ */
+static void serverSocketReleasePckts(int i);
+
+/**
+ * Return the connection which holds a Pending Packet from the argument source.
+ * The connections of the client which has announced the argument source are checked first
+ * and the connection whose packet is being signalled by <code>::CrDaServerSocketPoll</code>
+ * is checked next.
  * @param src the source
- * @param buffer the Read Buffer associated to the client from which the packet is read
- * @return the packet collected from the argument source
+ * @return the index of the connection or -1 if no such connection exists
+ */
+static int serverSocketFindConn(CrFwDestSrc_t src);
+
+/**
+ * Return the connection on which a packet is sent to its destination.
+ * This is the connection of the group of the packet (see <code>#CR_DA_SOCKET_CONN_OF_GROUP</code>)
+ * or, if the destination has not established it, its first connection.
+ * @param pckt the packet
+ * @return the index of the connection or -1 if the destination is not connected
+ */
+static int serverSocketConnOfPckt(CrFwPckt_t pckt);
+
+/**
+ * Frame the complete packets from a client into the Pending Packets of its connection.
+ * The complete packets are first framed from the receive ring buffer.
+ * As long as data may be waiting on the socket and the Pending Packets are not full,
+ * non-blocking reads are then performed on the socket and the packets which they
+ * complete are framed: all packets which are ready in the kernel are drained in one call
+ * unless the Pending Packets or the receive ring buffer fill up.
+ * If the Pending Packets are full, this function does nothing.
+ * If the client has closed the connection, the connection is closed.
+ * @param i the index of the connection
+ */
+static void serverSocketFillBuffer(int i);
+
+/**
+ * Move the complete packets from the receive ring buffer of a connection to new packets
+ * of the packet pool which are appended to the Pending Packets of the connection.
+ * Each packet is charged to the partition of the InStream of its source.
+ * If no packet can be allocated, the packet is left in the receive ring buffer.
+ * If the client has not yet announced its application identifier, the announcement
+ * is first read from the receive ring buffer.
+ * If the cut-through forwarding is selected, the Pending Packets which can be forwarded
+ * (see <code>::serverSocketForward</code>) are removed from the Pending Packets: those
+ * which could not be forwarded before are tried again first.
+ * @param i the index of the connection
+ * @return 1 if the Pending Packets are full; 0 otherwise
+ */
+static CrFwBool_t serverSocketFrame(int i);
+
+/**
+ * Frame the next complete packet of the receive ring buffer of a connection into a new
+ * Pending Packet (see <code>::serverSocketFrame</code>) without forwarding it.
+ * @param i the index of the connection
+ * @return 1 if a packet has been framed; 0 if the Pending Packets are full or no packet
+ * could be framed
+ */
+static CrFwBool_t serverSocketFrameNext(int i);
+
+#if (CR_DA_HANDSHAKE == 1)
+/**
+ * Read the hello of the client of a connection from its receive ring buffer, agree on the
+ * features of the connection and answer with the hello of the server (see
+ * <code>CrDaHandshake.h</code>).
+ * This function is called when the announcement of the client has arrived and before any
+ * packet has been sent on the connection.
+ * @param i the index of the connection
+ * @return 1 if the features have been agreed; 0 if the hello of the client is invalid
+ * or if the answer could not be written
+ */
+static CrFwBool_t serverSocketNegotiate(int i);
+#endif
+
+/**
+ * Forward a Pending Packet of a connection if its destination is another client of the
+ * server socket (see <code>#CR_DA_SERVER_SOCKET_CUT_THROUGH</code>).
+ * The packet is added to the transmit queue of the connection of its destination and
+ * it is removed from the Pending Packets of its connection.
+ * The packet is not forwarded if its destination is the host application, if its
+ * destination has not (yet) connected or if the transmit queue of its destination is full.
+ * The connections whose transmit queue has been found full are recorded so that the later
+ * packets to their clients do not overtake the packets which could not be forwarded.
+ * @param i the index of the connection
+ * @param k the position of the packet in the Pending Packets
+ * @param blocked the bit mask of the connections whose transmit queue is full
+ * (<code>#CR_DA_SERVER_SOCKET_NOF_BLOCKED_WORDS</code> words, updated)
+ * @return 1 if the packet has been forwarded; 0 otherwise
  */
-static CrFwPckt_t serverSocketPcktCollect(CrFwDestSrc_t src, unsigned char* buffer);
+static CrFwBool_t serverSocketForward(int i, unsigned int k, uint32_t* blocked);
 
 /* ---------------------------------------------------------------------------------------------*/
 void CrDaServerSocketInitAction(FwPrDesc_t prDesc) {
 	CrFwCmpData_t* streamData = (CrFwCmpData_t*)FwPrGetData(prDesc);
-	struct sockaddr_in serv_addr, cli_addr;
-	pthread_t acceptThread;
-	pthread_attr_t attr;
+	struct sockaddr_in serv_addr;
+	CrDaSocketTuning_t tuning;
+	int flags, yes = 1;
+	int i, j;
+#if (CR_DA_SERVER_SOCKET_EPOLL == 1)
+	struct epoll_event ev;
+#endif
 
 	/* Check if server socket has already been initialized */
 	if (sockfd != 0) {
@@ -118,10 +479,15 @@ void CrDaServerSocketInitAction(FwPrDesc_t prDesc) {
 		return;
 	}
 
-	/* Create the read buffer */
+	/* Clear the connection and routing tables (the ring buffers are created when a client connects) */
 	pcktMaxLength = (int)CrFwPcktGetMaxLength();
-	readBuffer[0] = malloc(pcktMaxLength*sizeof(char));
-	readBuffer[1] = malloc(pcktMaxLength*sizeof(char));
+	for (i=0; i<CR_DA_SERVER_SOCKET_MAX_NOF_CLIENTS; i++)
+		conn[i].fd = -1;
+	for (i=0; i<CR_DA_SERVER_SOCKET_NOF_DEST_SRC; i++)
+		for (j=0; j<CR_DA_SOCKET_N_OF_CONNS; j++)
+			connOfApp[i][j] = -1;
+	nOfConn = 0;
+	acceptReady = 1;
 
 	/* Create the socket */
 	sockfd = socket(AF_INET, SOCK_STREAM, 0);
@@ -131,6 +497,16 @@ void CrDaServerSocketInitAction(FwPrDesc_t prDesc) {
 		return;
 	}
 
+	/* Allow the server to be restarted while connections of its previous run are in TIME_WAIT */
+	if (setsockopt(sockfd, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes)) < 0) {
+		perror("CrDaServerSocketInitAction, Set socket attributes");
+		streamData->outcome = 0;
+		return;
+	}
+
+	/* The buffer sizes of the listening socket are inherited by the accepted connections */
+	CrDaSocketApplyProfile(sockfd, &tuning);
+
 	bzero((char*) &serv_addr, sizeof(serv_addr));
 	serv_addr.sin_family = AF_INET;
 	serv_addr.sin_addr.s_addr = INADDR_ANY;
@@ -140,20 +516,46 @@ void CrDaServerSocketInitAction(FwPrDesc_t prDesc) {
 		streamData->outcome = 0;
 		return;
 	}
-	listen(sockfd,5);
-	clilen = sizeof(cli_addr);
+	listen(sockfd,CR_DA_SERVER_SOCKET_MAX_NOF_CLIENTS);
+
+	/* Set the socket to non-blocking mode (connection requests are accepted when polling) */
+	if ((flags = fcntl(sockfd, F_GETFL, 0)) < 0) {
+		perror("CrDaServerSocketInitAction, Set socket attributes");
+		streamData->outcome = 0;
+		return;
+	}
+	if (fcntl(sockfd, F_SETFL, flags | O_NONBLOCK) < 0) {
+		perror("CrDaServerSocketInitAction, Set socket attributes");
+		streamData->outcome = 0;
+		return;
+	}
 
-	/* Create thread which will accept the connection call from the client sockets */
-	pthread_attr_init(&attr);
-	if (pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED) != 0) {
-		perror("CrDaServerSocketInitAction, set detached state");
+#if (CR_DA_SERVER_SOCKET_EPOLL == 1)
+	/* Create the epoll instance (the client connections are registered when accepted) */
+	epfd = epoll_create1(0);
+	if (epfd < 0) {
+		perror("CrDaServerSocketInitAction, epoll creation");
 		streamData->outcome = 0;
 		return;
 	}
-	if (pthread_create(&acceptThread, NULL, acceptThreadEntry, NULL) < 0) {
+	ev.events = EPOLLIN | EPOLLET;
+	ev.data.u32 = CR_DA_SERVER_SOCKET_MAX_NOF_CLIENTS;
+	if (epoll_ctl(epfd, EPOLL_CTL_ADD, sockfd, &ev) < 0) {
+		perror("CrDaServerSocketInitAction, epoll registration");
 		streamData->outcome = 0;
 		return;
-	};
+	}
+#endif
+#if (CR_DA_SOCKET_URING == 1)
+	/* Create the io_uring instance (the accept operation is submitted with the next wait) */
+	if (!CrDaUringInit(&uring, CR_DA_URING_NOF_ENTRIES, CR_DA_URING_NOF_BUFS, CR_DA_URING_BUF_SIZE)) {
+		perror("CrDaServerSocketInitAction, io_uring creation");
+		streamData->outcome = 0;
+		return;
+	}
+	acceptArmed = 0;
+	nOfHeldBufs = 0;
+#endif
 
 	/* Execute default initialization action for OutStream/InStream */
 	if (streamData->typeId == CR_FW_INSTREAM_TYPE)
@@ -165,6 +567,7 @@ void CrDaServerSocketInitAction(FwPrDesc_t prDesc) {
 /* ---------------------------------------------------------------------------------------------*/
 void CrDaServerSocketShutdownAction(FwSmDesc_t smDesc) {
 	CrFwCmpData_t* streamData = (CrFwCmpData_t*)FwSmGetData(smDesc);
+	int i;
 
 	if (streamData->typeId == CR_FW_INSTREAM_TYPE)
 		CrFwInStreamDefShutdownAction(smDesc);
@@ -172,10 +575,18 @@ void CrDaServerSocketShutdownAction(FwSmDesc_t smDesc) {
 		CrFwOutStreamDefShutdownAction(smDesc);
 
 	if (sockfd != 0) {
-		free(readBuffer[0]);
-		free(readBuffer[1]);
-		close(newsockfd[0]);
-		close(newsockfd[1]);
+		CrDaServerSocketFlush();
+		for (i=0; i<CR_DA_SERVER_SOCKET_MAX_NOF_CLIENTS; i++)
+			if (conn[i].fd >= 0)
+				serverSocketClose(i);
+#if (CR_DA_SERVER_SOCKET_EPOLL == 1)
+		close(epfd);
+		epfd = -1;
+#endif
+#if (CR_DA_SOCKET_URING == 1)
+		CrDaUringFree(&uring);
+		acceptArmed = 0;
+#endif
 		close(sockfd);
 		sockfd = 0;
 	}
@@ -184,10 +595,19 @@ void CrDaServerSocketShutdownAction(FwSmDesc_t smDesc) {
 /* ---------------------------------------------------------------------------------------------*/
 void CrDaServerSocketConfigAction(FwPrDesc_t prDesc) {
 	CrFwCmpData_t* streamData = (CrFwCmpData_t*)FwPrGetData(prDesc);
+	int i;
 
-	/* Clear Read Buffers */
-	readBuffer[0][0] = 0;
-	readBuffer[1][0] = 0;
+	/* Clear Pending Packets and receive ring buffers (a pending announcement is preserved) */
+	for (i=0; i<CR_DA_SERVER_SOCKET_MAX_NOF_CLIENTS; i++) {
+		if ((conn[i].fd < 0) || !conn[i].announced)
+			continue;
+		serverSocketReleasePckts(i);
+		CrDaRxRingClear(&conn[i].rxRing);
+#if (CR_DA_SOCKET_URING == 1)
+		serverSocketReleaseBufs(i);
+#endif
+		conn[i].rxReady = 1;
+	}
 
 	if (streamData->typeId == CR_FW_INSTREAM_TYPE)
 		CrFwInStreamDefConfigAction(prDesc);
@@ -197,183 +617,767 @@ void CrDaServerSocketConfigAction(FwPrDesc_t prDesc) {
 
 /* ---------------------------------------------------------------------------------------------*/
 void CrDaServerSocketPoll() {
-	serverSocketPoll(newsockfd[0], readBuffer[0]);
-	serverSocketPoll(newsockfd[1], readBuffer[1]);
+	int i;
+
+#if (CR_DA_SERVER_SOCKET_EPOLL == 1)
+	serverSocketWaitReady(0);
+#endif
+#if (CR_DA_SOCKET_URING == 1)
+	serverSocketReap();	/* the completions are read without system call */
+#else
+	serverSocketAccept();
+#endif
+	for (i=0; i<CR_DA_SERVER_SOCKET_MAX_NOF_CLIENTS; i++)
+		if (conn[i].fd >= 0)
+			serverSocketPoll(i);
 }
 
 /* ---------------------------------------------------------------------------------------------*/
-static void serverSocketPoll(int nsockfd, unsigned char* buffer) {
-	int n;
-	FwSmDesc_t inStream;
-	CrFwDestSrc_t src;
+static void serverSocketPoll(int i) {
+	CrFwDestSrc_t src[CR_DA_SERVER_SOCKET_RX_QUEUE_SIZE];
+	unsigned int k, n, nOfSrc = 0;
 
-	if (buffer[0] != 0) {
-		src = CrFwPcktGetSrc((CrFwPckt_t)buffer);
-		inStream = CrFwInStreamGet(src);
-		CrFwInStreamPcktAvail(inStream);
+	serverSocketFillBuffer(i);
+	if (conn[i].fd < 0)	/* the connection has been closed by the client */
 		return;
+
+	/* The sources are taken first since their InStreams collect the packets while they are signalled */
+	for (k=0; k<conn[i].nOfPending; k++) {
+		src[nOfSrc] = CrFwPcktGetSrc(conn[i].pendingPckt[k]);
+		for (n=0; src[n]!=src[nOfSrc]; n++)
+			;
+		if (n == nOfSrc)
+			nOfSrc++;
+	}
+	pollConn = i;
+	for (n=0; (n<nOfSrc) && (conn[i].fd >= 0); n++)
+		pcktAvail(src[n]);
+	pollConn = -1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaServerSocketSetPcktAvail(void (*avail)(CrFwDestSrc_t src)) {
+	if (avail == NULL)
+		pcktAvail = &serverSocketPcktAvail;
+	else
+		pcktAvail = avail;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void serverSocketPcktAvail(CrFwDestSrc_t src) {
+	CrFwInStreamPcktAvail(CrDaStreamMapGetInStream(src));
+}
+
+#if (CR_DA_SOCKET_URING == 0)
+/* ---------------------------------------------------------------------------------------------*/
+static void serverSocketAccept() {
+	int nsockfd;
+
+	while (acceptReady) {
+		clilen = sizeof(cli_addr);
+		nsockfd = accept(sockfd, (struct sockaddr*) &cli_addr, &clilen);
+		if (nsockfd < 0) {
+			if ((errno != EAGAIN) && (errno != EWOULDBLOCK))
+				perror("CrDaServerSocketPoll, Socket Accept");
+#if (CR_DA_SERVER_SOCKET_EPOLL == 1)
+			acceptReady = 0;
+#endif
+			return;
+		}
+		serverSocketAdd(nsockfd);
 	}
+}
+#endif
 
-	n = read(nsockfd, buffer, pcktMaxLength);
-	if (n == -1)	/* no data are available from the socket */
+/* ---------------------------------------------------------------------------------------------*/
+static void serverSocketAdd(int nsockfd) {
+	CrDaSocketTuning_t tuning;
+	int flags;
+	int i;
+#if (CR_DA_SERVER_SOCKET_EPOLL == 1)
+	struct epoll_event ev;
+#endif
+
+	for (i=0; i<CR_DA_SERVER_SOCKET_MAX_NOF_CLIENTS; i++)
+		if (conn[i].fd < 0)
+			break;
+	if (i == CR_DA_SERVER_SOCKET_MAX_NOF_CLIENTS) {
+		printf("CrDaServerSocketPoll: too many client connections, connection rejected\n");
+		close(nsockfd);
 		return;
-	if (n == 0)	{
-		printf("CrDaServerSocketPoll: Error reading from socket\n");
+	}
+
+	/* Set the socket to non-blocking mode */
+	if (((flags = fcntl(nsockfd, F_GETFL, 0)) < 0) || (fcntl(nsockfd, F_SETFL, flags | O_NONBLOCK) < 0)) {
+		perror("CrDaServerSocketPoll, Set socket attributes");
+		close(nsockfd);
 		return;
 	}
-	if (n == buffer[0]) {	/* a valid packet has arrived */
-		src = CrFwPcktGetSrc((CrFwPckt_t)buffer);
-		inStream = CrFwInStreamGet(src);
-		CrFwInStreamPcktAvail(inStream);
+	if (!CrDaSocketApplyProfile(nsockfd, &tuning))
+		printf("CrDaServerSocketPoll: socket profile %d partially applied to connection %d (nodelay=%d, sndbuf=%d, rcvbuf=%d, busypoll=%d)\n",
+		       tuning.profile, i, tuning.noDelay, tuning.sndBuf, tuning.rcvBuf, tuning.busyPoll);
+
+	/* Create the receive ring buffer */
+	if (!CrDaRxRingInit(&conn[i].rxRing, CR_DA_RX_RING_NOF_PCKTS*(pcktMaxLength+CR_DA_PCKT_CRC_LENGTH))) {
+		perror("CrDaServerSocketPoll, Receive ring buffer creation");
+		close(nsockfd);
 		return;
 	}
-	if (n != buffer[0]) {
-		printf("CrDaServerSocketPoll: invalid packet received from socket\n");
-		buffer[0] = 0;
+	conn[i].nOfPending = 0;
+	CrDaTxQueueInit(&conn[i].txQueue);
+	conn[i].trailerLength = CR_DA_PCKT_CRC_LENGTH;
+
+#if (CR_DA_SERVER_SOCKET_EPOLL == 1)
+	ev.events = EPOLLIN | EPOLLOUT | EPOLLET;
+	ev.data.u32 = (uint32_t)i;
+	if (epoll_ctl(epfd, EPOLL_CTL_ADD, nsockfd, &ev) < 0) {
+		perror("CrDaServerSocketPoll, epoll registration");
+		CrDaRxRingFree(&conn[i].rxRing);
+		close(nsockfd);
 		return;
 	}
+#endif
+#if (CR_DA_SOCKET_URING == 1)
+	/* The receive operation is armed with the next submission */
+	conn[i].recvArmed = 0;
+	conn[i].eof = 0;
+	conn[i].sending = 0;
+	conn[i].rxBufHead = 0;
+	conn[i].rxBufCount = 0;
+	conn[i].rxBufOffset = 0;
+#endif
+	conn[i].fd = nsockfd;
+	conn[i].announced = 0;
+	conn[i].rxReady = 1;
+	nOfConn++;
+	printf("CrDaServerSocketPoll: connection %d accepted\n", i);
 }
 
 /* ---------------------------------------------------------------------------------------------*/
-CrFwPckt_t CrDaServerSocketPcktCollect(CrFwDestSrc_t src) {
-	CrFwPckt_t pckt;
+static void serverSocketClose(int i) {
+	if (conn[i].announced && (connOfApp[conn[i].appId][conn[i].connId] == i))
+		connOfApp[conn[i].appId][conn[i].connId] = -1;
+	serverSocketReleasePckts(i);
+#if (CR_DA_SOCKET_URING == 1)
+	/* The kernel must drop the operations on the connection before its packets and buffers are released */
+	if ((conn[i].recvArmed || conn[i].sending) &&
+	        CrDaUringPrepCancel(&uring, conn[i].fd, CR_DA_SERVER_SOCKET_USER_DATA(CR_DA_SERVER_SOCKET_OP_CANCEL, i, conn[i].gen)))
+		CrDaUringEnter(&uring, 0, 0);
+	serverSocketReleaseBufs(i);
+	conn[i].recvArmed = 0;
+	conn[i].sending = 0;
+	conn[i].gen++;	/* the completions of the cancelled operations are discarded */
+#endif
+	CrDaTxQueueClear(&conn[i].txQueue);
+	CrDaRxRingFree(&conn[i].rxRing);
+	close(conn[i].fd);
+	conn[i].fd = -1;
+	nOfConn--;
+}
 
-	pckt = serverSocketPcktCollect(src, readBuffer[0]);
-	if (pckt != NULL)
-		return pckt;
-	pckt = serverSocketPcktCollect(src, readBuffer[1]);
-	if (pckt != NULL)
-		return pckt;
+/* ---------------------------------------------------------------------------------------------*/
+static void serverSocketFillBuffer(int i) {
+#if (CR_DA_SOCKET_URING == 1)
+	CrDaServerSocketBuf_t* rxBuf;
+	unsigned int n, nOfMoved;
+#else
+	unsigned int nOfFree;
+	int n;
+#endif
+
+	if (serverSocketFrame(i))
+		return;
 
-	return NULL;
+#if (CR_DA_SOCKET_URING == 1)
+	/* Move the buffers received by the kernel into the receive ring buffer and give them
+	 * back until all of them have been framed or the Pending Packets are full */
+	do {
+		nOfMoved = 0;
+		while (conn[i].rxBufCount > 0) {
+			rxBuf = &conn[i].rxBuf[conn[i].rxBufHead];
+			n = CrDaRxRingPut(&conn[i].rxRing, CrDaUringGetBuf(&uring, rxBuf->bid) + conn[i].rxBufOffset,
+			                  rxBuf->len - conn[i].rxBufOffset);
+			conn[i].rxBufOffset = conn[i].rxBufOffset + n;
+			nOfMoved = nOfMoved + n;
+			if (conn[i].rxBufOffset < rxBuf->len)	/* the receive ring buffer is full */
+				break;
+			CrDaUringPutBuf(&uring, rxBuf->bid);
+			nOfHeldBufs--;
+			conn[i].rxBufHead = (conn[i].rxBufHead + 1) % CR_DA_URING_NOF_BUFS;
+			conn[i].rxBufCount--;
+			conn[i].rxBufOffset = 0;
+		}
+		if (serverSocketFrame(i))
+			return;
+	} while ((nOfMoved > 0) && (conn[i].rxBufCount > 0) && (conn[i].fd >= 0));
+	if ((conn[i].fd >= 0) && conn[i].eof && (conn[i].rxBufCount == 0)) {
+		printf("CrDaServerSocketPoll: connection %d closed by client\n", i);
+		serverSocketClose(i);
+	}
+#else
+	/* Read until the socket is drained, the receive ring buffer is full or the Pending Packets are full */
+	while (conn[i].rxReady) {	/* no new data have arrived since the last read if the flag is clear */
+		nOfFree = conn[i].rxRing.size - conn[i].rxRing.count;
+		if (nOfFree == 0)	/* the packets of the ring cannot be framed (no packet is available) */
+			return;
+		n = CrDaRxRingFill(&conn[i].rxRing, conn[i].fd);
+#if (CR_DA_SERVER_SOCKET_EPOLL == 1)
+		if (n < (int)nOfFree)	/* the socket has been drained */
+			conn[i].rxReady = 0;
+#endif
+		if (n == -1)	/* no data are available from the socket (EAGAIN) */
+			return;
+		if (n == 0)	{
+			printf("CrDaServerSocketPoll: connection %d closed by client\n", i);
+			serverSocketClose(i);
+			return;
+		}
+		if (serverSocketFrame(i) || (conn[i].fd < 0) || (n < (int)nOfFree))
+			return;
+	}
+#endif
 }
 
 /* ---------------------------------------------------------------------------------------------*/
-static  CrFwPckt_t serverSocketPcktCollect(CrFwDestSrc_t src, unsigned char* buffer) {
+static CrFwBool_t serverSocketFrame(int i) {
+	uint32_t blocked[CR_DA_SERVER_SOCKET_NOF_BLOCKED_WORDS] = {0};
+	unsigned int k;
+
+	/* The Pending Packets which could not be forwarded are tried again in the order of their arrival */
+	for (k=0; (k<conn[i].nOfPending) && (conn[i].fd >= 0); )
+		if (!serverSocketForward(i, k, blocked))
+			k++;
+	/* A flush of a forwarded packet may close the connections (including this one) */
+	while ((conn[i].fd >= 0) && serverSocketFrameNext(i))
+		(void)serverSocketForward(i, conn[i].nOfPending-1, blocked);
+	return (conn[i].fd >= 0) && (conn[i].nOfPending == CR_DA_SERVER_SOCKET_RX_QUEUE_SIZE);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static CrFwBool_t serverSocketFrameNext(int i) {
+	unsigned char hdr[CR_FW_PCKT_HEADER_LENGTH];
+	unsigned int len;
 	CrFwPckt_t pckt;
-	CrFwDestSrc_t pcktSrc;
-
-	if (buffer[0] != 0) {
-		pcktSrc = CrFwPcktGetSrc((CrFwPckt_t)buffer);
-		if (src == pcktSrc) {
-			pckt = CrFwPcktMake((CrFwPcktLength_t)buffer[0]);
-			memcpy(pckt, buffer, buffer[0]);
-			buffer[0] = 0;
-			return pckt;
-		} else
-			return NULL;
-	} else
-		return NULL;
+#if (CR_DA_PCKT_CRC == 1)
+	unsigned char crc[CR_DA_PCKT_CRC_LENGTH];
+#endif
+
+	if (conn[i].nOfPending == CR_DA_SERVER_SOCKET_RX_QUEUE_SIZE)
+		return 0;
+
+	if (!conn[i].announced) {
+		if (conn[i].rxRing.count < sizeof(CrFwDestSrc_t)+CR_DA_SOCKET_CONN_ID_LENGTH+CR_DA_HANDSHAKE_LENGTH)
+			return 0;
+		CrDaRxRingGet(&conn[i].rxRing, (unsigned char*)&conn[i].appId, sizeof(CrFwDestSrc_t));
+		CrFwPcktWireSwap(&conn[i].appId, sizeof(CrFwDestSrc_t));
+		conn[i].connId = 0;
+#if (CR_DA_SOCKET_N_OF_CONNS > 1)
+		CrDaRxRingGet(&conn[i].rxRing, &conn[i].connId, CR_DA_SOCKET_CONN_ID_LENGTH);
+		if (conn[i].connId >= CR_DA_SOCKET_N_OF_CONNS) {
+			printf("CrDaServerSocketPoll: application %d announced illegal connection %d\n",
+			       conn[i].appId, conn[i].connId);
+			conn[i].connId = 0;
+		}
+#endif
+#if (CR_DA_HANDSHAKE == 1)
+		if (!serverSocketNegotiate(i)) {
+			printf("CrDaServerSocketPoll: handshake with application %d failed, connection %d closed\n",
+			       conn[i].appId, i);
+			serverSocketClose(i);
+			return 0;
+		}
+#endif
+		if (connOfApp[conn[i].appId][conn[i].connId] >= 0)
+			printf("CrDaServerSocketPoll: application %d announced on more than one connection\n",
+			       conn[i].appId);
+		connOfApp[conn[i].appId][conn[i].connId] = i;
+		conn[i].announced = 1;
+	}
+
+	switch (CrDaRxRingPeekPckt(&conn[i].rxRing, hdr, CR_FW_PCKT_HEADER_LENGTH, (unsigned int)pcktMaxLength,
+	                           conn[i].trailerLength, &len)) {
+	case 1:		/* a valid packet has arrived */
+		break;
+	case -1:
+		printf("CrDaServerSocketPoll: invalid packet received from socket\n");
+		CrDaMetricsFramingError(conn[i].appId);
+		return 0;
+	default:	/* no complete packet has arrived yet */
+		return 0;
+	}
+
+	/* Frame the packet directly into the packet pool */
+	pckt = CrFwPcktMakeInPart(CrFwPcktGetInStreamPart(CrFwPcktGetSrc((CrFwPckt_t)hdr)), (CrFwPcktLength_t)len);
+	if (pckt == NULL)	/* retry when a packet becomes available */
+		return 0;
+	CrDaRxRingGet(&conn[i].rxRing, (unsigned char*)pckt, len);
+#if (CR_DA_PCKT_CRC == 1)
+	if (conn[i].trailerLength > 0) {
+		CrDaRxRingGet(&conn[i].rxRing, crc, CR_DA_PCKT_CRC_LENGTH);
+		if (!CrDaCrcCheck((unsigned char*)pckt, len, crc)) {
+			printf("CrDaServerSocketPoll: packet with invalid CRC received from socket\n");
+			CrDaMetricsCrcError(conn[i].appId);
+			CrFwPcktRelease(pckt);
+			return serverSocketFrameNext(i);	/* frame the next packet */
+		}
+	}
+#endif
+	conn[i].pendingPckt[conn[i].nOfPending] = pckt;
+	conn[i].nOfPending++;
+	return 1;
 }
 
+#if (CR_DA_HANDSHAKE == 1)
 /* ---------------------------------------------------------------------------------------------*/
-CrFwBool_t CrDaServerSocketIsPcktAvail(CrFwDestSrc_t src) {
-	if (serverSocketIsPcktAvail(src, newsockfd[0], readBuffer[0]))
-		return 1;
+static CrFwBool_t serverSocketNegotiate(int i) {
+	unsigned char hello[CR_DA_HANDSHAKE_LENGTH];
+	CrFwDestSrc_t peer;
+	uint32_t features;
 
-	if (serverSocketIsPcktAvail(src, newsockfd[1], readBuffer[1]))
-		return 1;
+	CrDaRxRingGet(&conn[i].rxRing, hello, CR_DA_HANDSHAKE_LENGTH);
+	if (!CrDaHandshakeAgree(hello, &peer, &features))
+		return 0;
+	if (peer != conn[i].appId)
+		printf("CrDaServerSocketPoll: application %d sent the hello of application %d\n", conn[i].appId, peer);
 
-	return 0;
+	/* The transmit queue is still empty: the answer is the first data on the connection */
+	CrDaHandshakeWrite(hello);
+	if (send(conn[i].fd, hello, CR_DA_HANDSHAKE_LENGTH, MSG_NOSIGNAL) != (ssize_t)CR_DA_HANDSHAKE_LENGTH)
+		return 0;
+	CrDaTxQueueSetTrailer(&conn[i].txQueue, (features & CR_DA_HANDSHAKE_FEAT_PCKT_CRC) != 0);
+	conn[i].trailerLength = ((features & CR_DA_HANDSHAKE_FEAT_PCKT_CRC) != 0) ? CR_DA_PCKT_CRC_LENGTH : 0;
+	return 1;
 }
+#endif
 
 /* ---------------------------------------------------------------------------------------------*/
-static CrFwBool_t serverSocketIsPcktAvail(CrFwDestSrc_t src, int nsockfd, unsigned char* buffer) {
-	int n;
-	CrFwDestSrc_t pcktSrc;
+static CrFwBool_t serverSocketForward(int i, unsigned int k, uint32_t* blocked) {
+#if (CR_DA_SERVER_SOCKET_CUT_THROUGH == 1)
+	CrFwPckt_t pckt = conn[i].pendingPckt[k];
+	CrFwDestSrc_t dest = CrFwPcktGetDest(pckt);
+	int j;
+
+	if (dest == CR_FW_HOST_APP_ID)
+		return 0;
+	j = serverSocketConnOfPckt(pckt);
+	if ((j < 0) || (j == i) || (conn[j].fd < 0))
+		return 0;	/* the InLoader handles the packet */
+	CrDaLatTraceFwd(pckt);
+	if (((blocked[j/32] & ((uint32_t)1 << (j%32))) != 0) || !CrDaTxQueueAdd(&conn[j].txQueue, pckt)) {
+		blocked[j/32] |= (uint32_t)1 << (j%32);	/* the later packets to the destination must not overtake this one */
+		return 0;	/* the packet is forwarded when the transmit queue drains */
+	}
 
-	if (buffer[0] != 0) {
+	/* The transmit queue has retained the packet */
+	(void)serverSocketTakePckt(i, k);
+	CrDaLinkStatsRx(pckt);
+	CrDaMetricsIn(pckt);
+	CrDaCaptureRx(pckt);
+	CrDaLinkStatsTx(pckt);
+	CrDaMetricsOut(pckt);
+	CrDaCaptureTx(pckt);
+	CrFwPcktRelease(pckt);
+#if (CR_DA_SOCKET_TX_BATCH == 1)
+	if (CrDaTxQueueGetNOfBytes(&conn[j].txQueue) < CR_DA_TX_QUEUE_FLUSH_BYTES)
 		return 1;
+#endif
+	serverSocketFlush(j);
+	return 1;
+#else
+	(void)i;
+	(void)k;
+	(void)blocked;
+	return 0;
+#endif
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static int serverSocketFindPckt(int i, CrFwDestSrc_t src) {
+	unsigned int k;
+
+	for (k=0; k<conn[i].nOfPending; k++)
+		if (CrFwPcktGetSrc(conn[i].pendingPckt[k]) == src)
+			return (int)k;
+	return -1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static CrFwPckt_t serverSocketTakePckt(int i, unsigned int k) {
+	CrFwPckt_t pckt = conn[i].pendingPckt[k];
+
+	conn[i].nOfPending--;
+	memmove(&conn[i].pendingPckt[k], &conn[i].pendingPckt[k+1], (conn[i].nOfPending-k)*sizeof(CrFwPckt_t));
+	return pckt;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void serverSocketReleasePckts(int i) {
+	while (conn[i].nOfPending > 0)
+		CrFwPcktRelease(serverSocketTakePckt(i, conn[i].nOfPending-1));
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static int serverSocketFindConn(CrFwDestSrc_t src) {
+	int i, k;
+
+	for (k=0; k<CR_DA_SOCKET_N_OF_CONNS; k++) {
+		i = connOfApp[src][k];
+		if ((i >= 0) && (serverSocketFindPckt(i, src) >= 0))
+			return i;
 	}
 
-	n = read(nsockfd, buffer, pcktMaxLength);
-	if (n == -1)	/* no data are available from the socket (EAGAIN) */
-		return 0;
-	if (n == 0)	{
-		printf("CrDaServerSocketPoll: Error reading from socket\n");
-		return 0;
+	i = pollConn;
+	if ((i >= 0) && (conn[i].fd >= 0) && (serverSocketFindPckt(i, src) >= 0))
+		return i;
+
+	return -1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static int serverSocketConnOfPckt(CrFwPckt_t pckt) {
+	int* connOfDest = connOfApp[CrFwPcktGetDest(pckt)];
+	int i;
+
+	i = connOfDest[CR_DA_SOCKET_CONN_OF_GROUP(CrFwPcktGetGroup(pckt))];
+	if (i >= 0)
+		return i;
+	return connOfDest[0];
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwPckt_t CrDaServerSocketPcktCollect(CrFwDestSrc_t src) {
+	int i;
+
+	i = serverSocketFindConn(src);
+	if (i < 0)
+		return NULL;
+
+	return serverSocketPcktCollect(src, i);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static  CrFwPckt_t serverSocketPcktCollect(CrFwDestSrc_t src, int i) {
+	CrFwPckt_t pckt;
+	int k;
+
+	for (;;) {
+		k = serverSocketFindPckt(i, src);
+		if (k < 0)
+			return NULL;
+
+		pckt = serverSocketTakePckt(i, (unsigned int)k);
+		nOfCollected++;
+		if (CrDaLinkStatsRx(pckt))
+			break;
+		/* Drop the duplicate or the heartbeat before it reaches the InStream */
+		CrFwPcktRelease(pckt);
+		serverSocketFrame(i);
 	}
+	CrDaMetricsIn(pckt);
+	CrDaCaptureRx(pckt);
+	serverSocketFrame(i);	/* prepare the next packet already received */
+	return pckt;
+}
 
-	if (n == buffer[0]) {	/* a valid packet has arrived */
-		pcktSrc = CrFwPcktGetSrc((CrFwPckt_t)buffer);
-		if (src == pcktSrc)
-			return 1;
-		else
-			return 0;
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaServerSocketIsPcktAvail(CrFwDestSrc_t src) {
+#if (CR_DA_SOCKET_RX_PUSH == 0)
+	int i, k;
+
+	/* Read new data from the connections of the client which has announced the argument source */
+	for (k=0; k<CR_DA_SOCKET_N_OF_CONNS; k++) {
+		i = connOfApp[src][k];
+		if (i >= 0)
+			serverSocketFillBuffer(i);
 	}
+#endif
+
+	return (serverSocketFindConn(src) >= 0);
+}
 
-	if (n != buffer[0]) {
-		printf("CrDaServerSocketIsPcktAvail: invalid packet received from socket");
-		buffer[0] = 0;
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaServerSocketPcktHandover(CrFwPckt_t pckt) {
+	int i;
+
+	CrDaLatTraceTx(pckt);
+	i = serverSocketConnOfPckt(pckt);
+	if (i < 0) {	/* the destination has not (yet) connected */
+		CrDaMetricsHandoverFail(pckt);
 		return 0;
 	}
 
-	return 0;
+	if (!CrDaTxQueueAdd(&conn[i].txQueue, pckt)) {
+		serverSocketFlush(i);	/* the transmit queue is full */
+		if ((conn[i].fd < 0) || !CrDaTxQueueAdd(&conn[i].txQueue, pckt)) {
+			CrDaMetricsHandoverFail(pckt);
+			return 0;	/* the OutStream keeps the packet until the socket drains */
+		}
+	}
+	CrDaLinkStatsTx(pckt);
+	CrDaMetricsOut(pckt);
+	CrDaCaptureTx(pckt);
+#if (CR_DA_SOCKET_TX_BATCH == 1)
+	/* The packets of the cycle are written at its end unless they fill a write first */
+	if (CrDaTxQueueGetNOfBytes(&conn[i].txQueue) < CR_DA_TX_QUEUE_FLUSH_BYTES)
+		return 1;
+#endif
+	serverSocketFlush(i);
+	if (conn[i].fd < 0)
+		return 0;
+	return 1;
 }
 
 /* ---------------------------------------------------------------------------------------------*/
-CrFwBool_t CrDaServerSocketPcktHandover(CrFwPckt_t pckt) {
-	int len = (int)CrFwPcktGetLength(pckt);
+void CrDaServerSocketFlush() {
+#if (CR_DA_SOCKET_URING == 1)
+	/* The transmit queues of all connections are submitted with one system call */
+	if (uring.fd >= 0)
+		serverSocketWaitReady(0);
+#else
+	int i;
+
+	for (i=0; i<CR_DA_SERVER_SOCKET_MAX_NOF_CLIENTS; i++)
+		if (conn[i].fd >= 0)
+			serverSocketFlush(i);
+#endif
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void serverSocketFlush(int i) {
+#if (CR_DA_SOCKET_URING == 1)
+	/* The completion is normally available on return because the kernel first attempts the send inline */
+	serverSocketPrepSend(i);
+	if (CrDaUringEnter(&uring, 0, 0) < 0)
+		perror("CrDaServerSocketFlush, io_uring enter");
+	serverSocketReap();
+#else
+	if (CrDaTxQueueFlush(&conn[i].txQueue, conn[i].fd) >= 0)
+		return;
+
+	/* A client which has closed its connection must not raise SIGPIPE in the server */
+	if ((errno == EPIPE) || (errno == ECONNRESET)) {
+		printf("CrDaServerSocketFlush: connection %d closed by client\n", i);
+		serverSocketClose(i);
+	} else if ((errno != EAGAIN) && (errno != EWOULDBLOCK))
+		printf("CrDaServerSocketFlush: error writing to socket\n");
+#endif
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaServerSocketWait(unsigned int period) {
+	struct timespec req;
+#if (CR_DA_SERVER_SOCKET_EPOLL == 1) || (CR_DA_SOCKET_URING == 1)
+	struct timespec now, end;
+	unsigned int collected = nOfCollected;
+	long timeout;
 	int n;
-	CrFwDestSrc_t dest;
+#endif
 
-	dest = CrFwPcktGetDest(pckt);
-	if (dest == CR_DA_MASTER)
-		n = write(newsockfd[0], pckt, len);
-	else
-		n = write(newsockfd[1], pckt, len);
+	/* The io_uring backend submits the transmit queues with the system call which waits */
+#if (CR_DA_SOCKET_URING == 0)
+	CrDaServerSocketFlush();
+#endif
 
-	if (n < 0)
-		return 0;
+#if (CR_DA_SERVER_SOCKET_EPOLL == 1) || (CR_DA_SOCKET_URING == 1)
 
-	if (n != (int)CrFwPcktGetLength(pckt))  {
-		printf("CrDaServerSocketPcktHandover: error writing to socket\n");
-		return 0;
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	end.tv_sec = end.tv_sec + (time_t)(period/1000);
+	end.tv_nsec = end.tv_nsec + (long)(period%1000)*1000000L;
+	if (end.tv_nsec >= 1000000000L) {
+		end.tv_sec++;
+		end.tv_nsec = end.tv_nsec - 1000000000L;
 	}
 
-	return 1;
+#if (CR_DA_SOCKET_URING == 1)
+	while (uring.fd >= 0) {
+#else
+	while (epfd >= 0) {
+#endif
+		clock_gettime(CLOCK_MONOTONIC, &now);
+		timeout = (long)(end.tv_sec - now.tv_sec)*1000L + (end.tv_nsec - now.tv_nsec)/1000000L;
+		if (timeout <= 0) {
+#if (CR_DA_SOCKET_URING == 1)
+			CrDaServerSocketFlush();	/* submit the operations re-armed by the last poll */
+#endif
+			return 0;
+		}
+		n = serverSocketWaitReady((int)timeout);
+		if (n > 0) {
+			CrDaServerSocketPoll();
+#if (CR_DA_SOCKET_URING == 0)
+			CrDaServerSocketFlush();
+#endif
+			if (nOfCollected != collected)
+				return 1;	/* the io_uring operations are submitted by the next wait or flush */
+		}
+		else if (n < 0) {	/* sleep for the rest of the period */
+			period = (unsigned int)timeout;
+			break;
+		}
+	}
+#endif
+
+	req.tv_sec = (time_t)(period/1000);
+	req.tv_nsec = (long)(period%1000)*1000000L;
+	while ((nanosleep(&req, &req) < 0) && (errno == EINTR))
+		;
+	return 0;
 }
 
+#if (CR_DA_SERVER_SOCKET_EPOLL == 1)
 /* ---------------------------------------------------------------------------------------------*/
-static void* acceptThreadEntry(void* ptr) {
-	int flags;
+static int serverSocketWaitReady(int timeout) {
+	struct epoll_event ev[CR_DA_SERVER_SOCKET_MAX_NOF_CLIENTS+1];
+	int i, n;
 
-	printf("S1: Waiting for client socket in Master Application to connect ...\n");
-	newsockfd[0] = accept(sockfd, (struct sockaddr*) &cli_addr, &clilen);
-	if (newsockfd < 0) {
-		perror("CrDaServerSocketInitAction, Socket Accept");
+	n = epoll_wait(epfd, ev, CR_DA_SERVER_SOCKET_MAX_NOF_CLIENTS+1, timeout);
+	if (n < 0) {
+		if (errno == EINTR)
+			return 0;
+		perror("CrDaServerSocketPoll, epoll wait");
+		return -1;
 	}
+	for (i=0; i<n; i++) {
+		if (ev[i].data.u32 == CR_DA_SERVER_SOCKET_MAX_NOF_CLIENTS)
+			acceptReady = 1;
+		else if ((ev[i].events & ~EPOLLOUT) != 0)
+			conn[ev[i].data.u32].rxReady = 1;
+	}
+	return n;
+}
+#endif
 
-	/* Set the socket to non-blocking mode */
-	if ((flags = fcntl(newsockfd[0], F_GETFL, 0)) < 0) {
-		perror("CrDaServerSocketInitAction, Set socket attributes");
-		return NULL;
+#if (CR_DA_SOCKET_URING == 1)
+/* ---------------------------------------------------------------------------------------------*/
+static int serverSocketWaitReady(int timeout) {
+	int nOfSends;
+
+	nOfSends = serverSocketPrep();
+	if (CrDaUringEnter(&uring, (unsigned int)nOfSends+1, timeout) < 0) {
+		perror("CrDaServerSocketPoll, io_uring enter");
+		return -1;
 	}
-	if (fcntl(newsockfd[0], F_SETFL, flags | O_NONBLOCK) < 0) {
-		perror("CrDaServerSocketInitAction, Set socket attributes");
-		return NULL;
+	return serverSocketReap();
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static int serverSocketPrep() {
+	int nOfSends = 0;
+	int i;
+
+	if (!acceptArmed)
+		acceptArmed = CrDaUringPrepAccept(&uring, sockfd,
+		                                  CR_DA_SERVER_SOCKET_USER_DATA(CR_DA_SERVER_SOCKET_OP_ACCEPT, 0, 0));
+
+	for (i=0; i<CR_DA_SERVER_SOCKET_MAX_NOF_CLIENTS; i++) {
+		if (conn[i].fd < 0)
+			continue;
+		/* A receive operation armed without provided buffers would terminate at once */
+		if (!conn[i].recvArmed && !conn[i].eof && (nOfHeldBufs < CR_DA_URING_NOF_BUFS))
+			conn[i].recvArmed = CrDaUringPrepRecv(&uring, conn[i].fd,
+			                                      CR_DA_SERVER_SOCKET_USER_DATA(CR_DA_SERVER_SOCKET_OP_RECV, i, conn[i].gen));
+		if (serverSocketPrepSend(i))
+			nOfSends++;
 	}
-	printf("S1: Client socket in Master Application successfully connected.\n");
+	return nOfSends;
+}
 
-	printf("S1: Waiting for client socket in Slave 2 Application to connect ...\n");
-	newsockfd[1] = accept(sockfd, (struct sockaddr*) &cli_addr, &clilen);
-	if (newsockfd < 0) {
-		perror("CrDaServerSocketInitAction, Socket Accept");
+/* ---------------------------------------------------------------------------------------------*/
+static CrFwBool_t serverSocketPrepSend(int i) {
+	if (conn[i].sending || CrDaTxQueueIsEmpty(&conn[i].txQueue))
+		return 0;
+
+	memset(&conn[i].msg, 0, sizeof(struct msghdr));
+	conn[i].msg.msg_iov = conn[i].iov;
+	conn[i].msg.msg_iovlen = CrDaTxQueueGetIov(&conn[i].txQueue, conn[i].iov);
+	conn[i].sending = CrDaUringPrepSendmsg(&uring, conn[i].fd, &conn[i].msg,
+	                                       CR_DA_SERVER_SOCKET_USER_DATA(CR_DA_SERVER_SOCKET_OP_SEND, i, conn[i].gen));
+	return conn[i].sending;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void serverSocketReleaseBufs(int i) {
+	while (conn[i].rxBufCount > 0) {
+		CrDaUringPutBuf(&uring, conn[i].rxBuf[conn[i].rxBufHead].bid);
+		nOfHeldBufs--;
+		conn[i].rxBufHead = (conn[i].rxBufHead + 1) % CR_DA_URING_NOF_BUFS;
+		conn[i].rxBufCount--;
 	}
+	conn[i].rxBufHead = 0;
+	conn[i].rxBufOffset = 0;
+}
 
-	/* Set the socket to non-blocking mode */
-	if ((flags = fcntl(newsockfd[1], F_GETFL, 0)) < 0) {
-		perror("CrDaServerSocketInitAction, Set socket attributes");
-		return NULL;
+/* ---------------------------------------------------------------------------------------------*/
+static int serverSocketReap() {
+	struct io_uring_cqe* cqe;
+	int n = 0;
+
+	while ((cqe = CrDaUringPeekCqe(&uring)) != NULL) {
+		serverSocketComplete(cqe);
+		CrDaUringCqeSeen(&uring);
+		n++;
 	}
-	if (fcntl(newsockfd[1], F_SETFL, flags | O_NONBLOCK) < 0) {
-		perror("CrDaServerSocketInitAction, Set socket attributes");
-		return NULL;
+	return n;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void serverSocketComplete(struct io_uring_cqe* cqe) {
+	unsigned int op = (unsigned int)((cqe->user_data >> 16) & 0xFFFF);
+	unsigned int gen = (unsigned int)(cqe->user_data >> 32);
+	int i = (int)(cqe->user_data & 0xFFFF);
+	CrFwBool_t more = ((cqe->flags & IORING_CQE_F_MORE) != 0);
+	CrDaServerSocketBuf_t* rxBuf;
+
+	if (op == CR_DA_SERVER_SOCKET_OP_ACCEPT) {
+		if (!more)
+			acceptArmed = 0;
+		if (cqe->res >= 0)
+			serverSocketAdd(cqe->res);
+		else if (cqe->res != -ECANCELED) {
+			errno = -cqe->res;
+			perror("CrDaServerSocketPoll, Socket Accept");
+		}
+		return;
 	}
-	printf("S1: Client socket in Slave 2 Application successfully connected.\n");
 
-	return NULL;
+	if ((conn[i].fd < 0) || (conn[i].gen != gen)) {	/* the completion belongs to a closed connection */
+		if ((cqe->flags & IORING_CQE_F_BUFFER) != 0)
+			CrDaUringPutBuf(&uring, cqe->flags >> IORING_CQE_BUFFER_SHIFT);
+		return;
+	}
+
+	switch (op) {
+	case CR_DA_SERVER_SOCKET_OP_RECV:
+		if (!more)
+			conn[i].recvArmed = 0;
+		if ((cqe->res > 0) && ((cqe->flags & IORING_CQE_F_BUFFER) != 0)) {
+			rxBuf = &conn[i].rxBuf[(conn[i].rxBufHead + conn[i].rxBufCount) % CR_DA_URING_NOF_BUFS];
+			rxBuf->bid = cqe->flags >> IORING_CQE_BUFFER_SHIFT;
+			rxBuf->len = (unsigned int)cqe->res;
+			conn[i].rxBufCount++;
+			nOfHeldBufs++;
+			break;
+		}
+		if ((cqe->flags & IORING_CQE_F_BUFFER) != 0)
+			CrDaUringPutBuf(&uring, cqe->flags >> IORING_CQE_BUFFER_SHIFT);
+		if (cqe->res != -ENOBUFS)	/* the client has closed the connection or the connection has failed */
+			conn[i].eof = 1;
+		break;
+	case CR_DA_SERVER_SOCKET_OP_SEND:
+		conn[i].sending = 0;
+		if (cqe->res >= 0)
+			CrDaTxQueueConsume(&conn[i].txQueue, (unsigned int)cqe->res);
+		else if ((cqe->res == -EPIPE) || (cqe->res == -ECONNRESET)) {
+			printf("CrDaServerSocketFlush: connection %d closed by client\n", i);
+			serverSocketClose(i);
+		} else if (cqe->res != -EAGAIN)
+			printf("CrDaServerSocketFlush: error writing to socket\n");
+		break;
+	default:	/* the cancellation of the operations of a connection */
+		break;
+	}
 }
+#endif
 
 /* ---------------------------------------------------------------------------------------------*/
 void CrDaServerSocketInitCheck(FwPrDesc_t prDesc) {
@@ -391,18 +1395,65 @@ void CrDaServerSocketInitCheck(FwPrDesc_t prDesc) {
 void CrDaServerSocketConfigCheck(FwPrDesc_t prDesc) {
 	CrFwCmpData_t* outStreamData = (CrFwCmpData_t*)FwPrGetData(prDesc);
 
-	if (newsockfd[0] > 0) {
-		if (newsockfd[1] > 0)
-			outStreamData->outcome = 1;
-		else
-			outStreamData->outcome = 0;
-	} else
+	/* Accept the connection requests which have arrived since the last poll */
+#if (CR_DA_SERVER_SOCKET_EPOLL == 1) || (CR_DA_SOCKET_URING == 1)
+	serverSocketWaitReady(0);
+#endif
+#if (CR_DA_SOCKET_URING == 0)
+	serverSocketAccept();
+#endif
+
+	if (nOfConn >= nOfClients)
+		outStreamData->outcome = 1;
+	else
 		outStreamData->outcome = 0;
 
 	return;
 }
 
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaServerSocketWaitClients(unsigned int timeout) {
+	struct timespec start, now;
+	long remaining;
+#if (CR_DA_SERVER_SOCKET_EPOLL == 0) && (CR_DA_SOCKET_URING == 0)
+	struct pollfd pfd;
+#endif
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (;;) {
+		/* Accept the connection requests which have arrived since the last wait */
+#if (CR_DA_SOCKET_URING == 0)
+		serverSocketAccept();
+#endif
+		if (nOfConn >= nOfClients)
+			return 1;
+
+		clock_gettime(CLOCK_MONOTONIC, &now);
+		remaining = (long)timeout - ((now.tv_sec - start.tv_sec)*1000L + (now.tv_nsec - start.tv_nsec)/1000000L);
+		if (remaining <= 0)
+			return 0;
+
+		/* Wait for the next connection request */
+#if (CR_DA_SERVER_SOCKET_EPOLL == 1) || (CR_DA_SOCKET_URING == 1)
+		if (serverSocketWaitReady((int)remaining) < 0)
+			return 0;
+#else
+		pfd.fd = sockfd;
+		pfd.events = POLLIN;
+		if ((poll(&pfd, 1, (int)remaining) < 0) && (errno != EINTR)) {
+			perror("CrDaServerSocketWaitClients, poll");
+			return 0;
+		}
+#endif
+	}
+}
+
 /* ---------------------------------------------------------------------------------------------*/
 void CrDaServerSocketSetPort(int n) {
 	portno = n;
 }
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaServerSocketSetNOfClients(int n) {
+	nOfClients = n;
+}
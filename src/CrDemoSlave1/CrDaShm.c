@@ -0,0 +1,479 @@
+/**
+ * @file
+ * @ingroup crDemoSlave1
+ * Implementation of the shared-memory transport.
+ * The head and tail counters of the rings are free-running: the number of bytes in a
+ * ring is the difference between its head and its tail and the position of a byte
+ * in the ring is its counter modulo <code>#CR_DA_SHM_RING_SIZE</code>.
+ * The counters are accessed through the <code>__atomic</code> built-ins of the GCC
+ * compiler: a producer publishes a packet by advancing the head with release semantics
+ * after the packet has been copied into the ring and the consumer reads the head with
+ * acquire semantics before it reads the packet (and vice versa for the tail).
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdlib.h>
+#include "CrDaShm.h"
+#include "CrDaStreamMap.h"
+#include "CrDaLinkStats.h"
+#include "CrDaMetrics.h"
+#include "CrDaLatTrace.h"
+#include "CrDaCapture.h"
+#include "CrDaConstants.h"
+#include "CrFwConstants.h"
+/* Include FW Profile files */
+#include "FwSmConstants.h"
+#include "FwSmConfig.h"
+#include "FwSmCore.h"
+#include "FwPrConfig.h"
+#include "FwPrCore.h"
+#include "FwPrConstants.h"
+/* Include configuration files */
+#include "CrFwInStreamUserPar.h"
+#include "CrFwCmpData.h"
+/* Include framework files */
+#include "InStream/CrFwInStream.h"
+#include "OutStream/CrFwOutStream.h"
+#include "BaseCmp/CrFwBaseCmp.h"
+#include "Pckt/CrFwPckt.h"
+#include "CrFwPcktInline.h"
+#include "CrFwPcktPart.h"
+#include "CrFwTime.h"
+#include "CrFwRepErr.h"
+#include "UtilityFunctions/CrFwUtilityFunctions.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <time.h>
+#include <limits.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+/** The size of a cache line (the head and tail of a ring are kept in different cache lines). */
+#define CR_DA_SHM_CACHE_LINE 64
+
+/** Type for a ring of the shared-memory segment. */
+typedef struct {
+	/** The head counter of the ring (only written by the producer). */
+	unsigned int head;
+	/** Padding which places the tail in a different cache line than the head. */
+	unsigned char pad1[CR_DA_SHM_CACHE_LINE-sizeof(unsigned int)];
+	/** The tail counter of the ring (only written by the consumer). */
+	unsigned int tail;
+	/** Padding which places the buffer in a different cache line than the tail. */
+	unsigned char pad2[CR_DA_SHM_CACHE_LINE-sizeof(unsigned int)];
+	/** The buffer of the ring. */
+	unsigned char buf[CR_DA_SHM_RING_SIZE];
+} CrDaShmRing_t;
+
+/** Type for the wake-up data of an application in the shared-memory segment. */
+typedef struct {
+	/** The futex word which is incremented whenever a packet is handed over to the application. */
+	int seq;
+	/** Flag which is set while the application is waiting on the futex. */
+	int waiting;
+	/** Padding which places the wake-up data of different applications in different cache lines. */
+	unsigned char pad[CR_DA_SHM_CACHE_LINE-2*sizeof(int)];
+} CrDaShmWake_t;
+
+/** Type for the shared-memory segment. */
+typedef struct {
+	/** The wake-up data of the applications. */
+	CrDaShmWake_t wake[CR_DA_SHM_NOF_APPS];
+	/** The rings: <code>ring[a][b]</code> carries the packets from application a to application b. */
+	CrDaShmRing_t ring[CR_DA_SHM_NOF_APPS][CR_DA_SHM_NOF_APPS];
+} CrDaShmSeg_t;
+
+/** The shared-memory segment (NULL if it has not been mapped). */
+static CrDaShmSeg_t* seg = NULL;
+
+/** The maximum size of an incoming packet */
+static int pcktMaxLength;
+
+/**
+ * The Pending Packets.
+ * The i-th Pending Packet is the packet of the packet pool into which the next complete
+ * packet has been framed from the ring from application i to the host application or
+ * NULL if no complete packet is waiting to be collected.
+ */
+static CrFwPckt_t pendingPckt[CR_DA_SHM_NOF_APPS];
+
+/**
+ * The number of packets which have been collected by the InStreams.
+ * The counter is used by <code>::CrDaShmWait</code> to detect the arrival of packets.
+ */
+static unsigned int nOfCollected = 0;
+
+/**
+ * Discard the content of the rings towards the host application and release the
+ * Pending Packets.
+ */
+static void shmClear();
+
+/**
+ * Move the next complete packet (if any) from the ring from application i to the host
+ * application to a new packet of the packet pool which becomes the i-th Pending Packet.
+ * The packet is charged to the partition of the InStream of its source.
+ * If no packet can be allocated, the packet is left in the ring.
+ * If there is already a Pending Packet, this function does nothing.
+ * @param i the application at the producer end of the ring
+ * @return 1 if there is a Pending Packet; 0 otherwise
+ */
+static CrFwBool_t shmFrame(int i);
+
+/**
+ * Copy bytes out of a ring.
+ * @param ring the ring
+ * @param pos the counter of the first byte to be copied
+ * @param dest the location to which the bytes are copied
+ * @param n the number of bytes to be copied
+ */
+static void shmRingRead(CrDaShmRing_t* ring, unsigned int pos, unsigned char* dest, unsigned int n);
+
+/**
+ * Copy bytes into a ring.
+ * @param ring the ring
+ * @param pos the counter of the first byte to be written
+ * @param src the location from which the bytes are copied
+ * @param n the number of bytes to be copied
+ */
+static void shmRingWrite(CrDaShmRing_t* ring, unsigned int pos, unsigned char* src, unsigned int n);
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaShmInitAction(FwPrDesc_t prDesc) {
+	CrFwCmpData_t* streamData = (CrFwCmpData_t*)FwPrGetData(prDesc);
+	void* p;
+	int fd, i;
+
+	if (seg == NULL) {	/* Check if the segment is already mapped */
+		pcktMaxLength = (int)CrFwPcktGetMaxLength();
+
+		fd = shm_open(CR_DA_SHM_NAME, O_RDWR | O_CREAT, 0600);
+		if (fd < 0) {
+			perror("CrDaShmInitAction, Shared-memory segment creation");
+			streamData->outcome = 0;
+			return;
+		}
+		/* A new segment is zero-filled which leaves all its rings empty */
+		if (ftruncate(fd, (off_t)sizeof(CrDaShmSeg_t)) < 0) {
+			perror("CrDaShmInitAction, Shared-memory segment sizing");
+			close(fd);
+			streamData->outcome = 0;
+			return;
+		}
+		p = mmap(NULL, sizeof(CrDaShmSeg_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+		close(fd);
+		if (p == MAP_FAILED) {
+			perror("CrDaShmInitAction, Shared-memory segment mapping");
+			streamData->outcome = 0;
+			return;
+		}
+
+		seg = (CrDaShmSeg_t*)p;
+		for (i=0; i<CR_DA_SHM_NOF_APPS; i++)
+			pendingPckt[i] = NULL;
+		shmClear();		/* discard packets left over from a previous run */
+	}
+
+	/* Execute default initialization action for OutStream/InStream */
+	if (streamData->typeId == CR_FW_INSTREAM_TYPE)
+		CrFwInStreamDefInitAction(prDesc);
+	else
+		CrFwOutStreamDefInitAction(prDesc);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaShmShutdownAction(FwSmDesc_t smDesc) {
+	CrFwCmpData_t* streamData = (CrFwCmpData_t*)FwSmGetData(smDesc);
+	int i;
+
+	if (streamData->typeId == CR_FW_INSTREAM_TYPE)
+		CrFwInStreamDefShutdownAction(smDesc);
+	else
+		CrFwOutStreamDefShutdownAction(smDesc);
+
+	if (seg == NULL) 	/* Check if the segment was already unmapped */
+		return;
+	for (i=0; i<CR_DA_SHM_NOF_APPS; i++)
+		if (pendingPckt[i] != NULL) {
+			CrFwPcktRelease(pendingPckt[i]);
+			pendingPckt[i] = NULL;
+		}
+	munmap(seg, sizeof(CrDaShmSeg_t));
+	seg = NULL;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaShmInitCheck(FwPrDesc_t prDesc) {
+	CrFwCmpData_t* prData = (CrFwCmpData_t*)FwPrGetData(prDesc);
+
+	if (CrFwPcktGetMaxLength() >= CR_DA_SHM_RING_SIZE) {
+		prData->outcome = 0;
+		return;
+	}
+
+	if (CR_FW_HOST_APP_ID >= CR_DA_SHM_NOF_APPS) {
+		prData->outcome = 0;
+		return;
+	}
+
+	prData->outcome = 1;
+	return;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaShmConfigAction(FwPrDesc_t prDesc) {
+	CrFwCmpData_t* streamData = (CrFwCmpData_t*)FwPrGetData(prDesc);
+
+	shmClear();
+
+	if (streamData->typeId == CR_FW_INSTREAM_TYPE)
+		CrFwInStreamDefConfigAction(prDesc);
+	else if (streamData->typeId == CR_FW_OUTSTREAM_TYPE)
+		CrFwOutStreamDefConfigAction(prDesc);
+	else {
+		perror("CrDaShmConfigAction, Incorrect caller type");
+		return;
+	}
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaShmPoll() {
+	FwSmDesc_t inStream;
+	CrFwDestSrc_t src;
+	int i;
+
+	if (seg == NULL)
+		return;
+
+	for (i=0; i<CR_DA_SHM_NOF_APPS; i++) {
+		if (!shmFrame(i))
+			continue;
+		src = CrFwPcktGetSrc(pendingPckt[i]);
+		inStream = CrDaStreamMapGetInStream(src);
+		CrFwInStreamPcktAvail(inStream);
+	}
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaShmWait(unsigned int period) {
+	struct timespec req, now, end;
+	CrDaShmWake_t* wake;
+	unsigned int collected = nOfCollected;
+	long timeout;
+	int seen;
+
+	if (seg == NULL) {
+		req.tv_sec = (time_t)(period/1000);
+		req.tv_nsec = (long)(period%1000)*1000000L;
+		while ((nanosleep(&req, &req) < 0) && (errno == EINTR))
+			;
+		return 0;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	end.tv_sec = end.tv_sec + (time_t)(period/1000);
+	end.tv_nsec = end.tv_nsec + (long)(period%1000)*1000000L;
+	if (end.tv_nsec >= 1000000000L) {
+		end.tv_sec++;
+		end.tv_nsec = end.tv_nsec - 1000000000L;
+	}
+
+	/* Packets handed over after this point change the futex word and end the wait */
+	wake = &seg->wake[CR_FW_HOST_APP_ID];
+	seen = __atomic_load_n(&wake->seq, __ATOMIC_SEQ_CST);
+	CrDaShmPoll();
+
+	for (;;) {
+		clock_gettime(CLOCK_MONOTONIC, &now);
+		timeout = (long)(end.tv_sec - now.tv_sec)*1000000000L + (end.tv_nsec - now.tv_nsec);
+		if (timeout <= 0)
+			return 0;
+		if (nOfCollected != collected)
+			return 1;
+		req.tv_sec = (time_t)(timeout/1000000000L);
+		req.tv_nsec = timeout%1000000000L;
+
+		__atomic_store_n(&wake->waiting, 1, __ATOMIC_SEQ_CST);
+		syscall(SYS_futex, &wake->seq, FUTEX_WAIT, seen, &req, NULL, 0);
+		__atomic_store_n(&wake->waiting, 0, __ATOMIC_SEQ_CST);
+
+		if (__atomic_load_n(&wake->seq, __ATOMIC_SEQ_CST) != seen) {
+			seen = __atomic_load_n(&wake->seq, __ATOMIC_SEQ_CST);
+			CrDaShmPoll();
+		}
+	}
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwPckt_t CrDaShmPcktCollect(CrFwDestSrc_t src) {
+	CrFwPckt_t pckt;
+	int i;
+
+	if (seg == NULL)
+		return NULL;
+
+	for (i=0; i<CR_DA_SHM_NOF_APPS; i++) {
+		pckt = NULL;
+		while ((pendingPckt[i] != NULL) && (CrFwPcktGetSrc(pendingPckt[i]) == src)) {
+			pckt = pendingPckt[i];
+			pendingPckt[i] = NULL;
+			nOfCollected++;
+			if (CrDaLinkStatsRx(pckt))
+				break;
+			/* Drop the duplicate or the heartbeat before it reaches the InStream */
+			CrFwPcktRelease(pckt);
+			shmFrame(i);
+			pckt = NULL;
+		}
+		if (pckt == NULL)
+			continue;
+		CrDaMetricsIn(pckt);
+		CrDaCaptureRx(pckt);
+		shmFrame(i);	/* prepare the next packet already received */
+		return pckt;
+	}
+
+	return NULL;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaShmIsPcktAvail(CrFwDestSrc_t src) {
+	int i;
+
+	if (seg == NULL)
+		return 0;
+
+	for (i=0; i<CR_DA_SHM_NOF_APPS; i++)
+		if (shmFrame(i) && (CrFwPcktGetSrc(pendingPckt[i]) == src))
+			return 1;
+
+	return 0;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaShmPcktHandover(CrFwPckt_t pckt) {
+	unsigned int len = CrFwPcktGetLength(pckt);
+	CrFwDestSrc_t dest = CrFwPcktGetDest(pckt);
+	CrDaShmRing_t* ring;
+	CrDaShmWake_t* wake;
+	unsigned int head, tail;
+
+	CrDaLatTraceTx(pckt);
+	if ((seg == NULL) || (dest >= CR_DA_SHM_NOF_APPS)) {
+		CrDaMetricsHandoverFail(pckt);
+		return 0;
+	}
+
+	ring = &seg->ring[CR_FW_HOST_APP_ID][dest];
+	head = ring->head;
+	tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+	if (CR_DA_SHM_RING_SIZE - (head - tail) < len) {	/* the OutStream keeps the packet */
+		CrDaMetricsHandoverFail(pckt);
+		return 0;
+	}
+
+	shmRingWrite(ring, head, (unsigned char*)pckt, len);
+	__atomic_store_n(&ring->head, head + len, __ATOMIC_RELEASE);
+	CrDaLinkStatsTx(pckt);
+	CrDaMetricsOut(pckt);
+	CrDaCaptureTx(pckt);
+
+	/* Wake up the destination only if it is sleeping in CrDaShmWait */
+	wake = &seg->wake[dest];
+	__atomic_add_fetch(&wake->seq, 1, __ATOMIC_SEQ_CST);
+	if (__atomic_load_n(&wake->waiting, __ATOMIC_SEQ_CST))
+		syscall(SYS_futex, &wake->seq, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+
+	return 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void shmClear() {
+	CrDaShmRing_t* ring;
+	int i;
+
+	for (i=0; i<CR_DA_SHM_NOF_APPS; i++) {
+		if (pendingPckt[i] != NULL) {
+			CrFwPcktRelease(pendingPckt[i]);
+			pendingPckt[i] = NULL;
+		}
+		if ((seg == NULL) || (CR_FW_HOST_APP_ID >= CR_DA_SHM_NOF_APPS))
+			continue;
+		ring = &seg->ring[i][CR_FW_HOST_APP_ID];
+		__atomic_store_n(&ring->tail, __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE), __ATOMIC_RELEASE);
+	}
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static CrFwBool_t shmFrame(int i) {
+	unsigned char hdr[CR_FW_PCKT_HEADER_LENGTH];
+	CrDaShmRing_t* ring = &seg->ring[i][CR_FW_HOST_APP_ID];
+	unsigned int head, tail, len;
+	CrFwPckt_t pckt;
+
+	if (pendingPckt[i] != NULL)
+		return 1;
+
+	head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+	tail = ring->tail;
+	if (head - tail < CR_FW_PCKT_HEADER_LENGTH)	/* the ring is empty */
+		return 0;
+
+	/* A producer only publishes complete packets */
+	shmRingRead(ring, tail, hdr, CR_FW_PCKT_HEADER_LENGTH);
+	len = CrFwPcktGetLength((CrFwPckt_t)hdr);
+	if ((len < CR_FW_PCKT_HEADER_LENGTH) || (len > (unsigned int)pcktMaxLength) || (len > head - tail)) {
+		printf("CrDaShmPoll: invalid packet received from application %d\n", i);
+		CrDaMetricsFramingError((CrFwDestSrc_t)i);
+		__atomic_store_n(&ring->tail, head, __ATOMIC_RELEASE);
+		return 0;
+	}
+
+	/* Frame the packet directly into the packet pool */
+	pckt = CrFwPcktMakeInPart(CrFwPcktGetInStreamPart(CrFwPcktGetSrc((CrFwPckt_t)hdr)), (CrFwPcktLength_t)len);
+	if (pckt == NULL)	/* retry when a packet becomes available */
+		return 0;
+	shmRingRead(ring, tail, (unsigned char*)pckt, len);
+	__atomic_store_n(&ring->tail, tail + len, __ATOMIC_RELEASE);
+	pendingPckt[i] = pckt;
+	return 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void shmRingRead(CrDaShmRing_t* ring, unsigned int pos, unsigned char* dest, unsigned int n) {
+	unsigned int start = pos % CR_DA_SHM_RING_SIZE;
+	unsigned int first = CR_DA_SHM_RING_SIZE - start;
+
+	if (first > n)
+		first = n;
+	memcpy(dest, ring->buf + start, first);
+	memcpy(dest + first, ring->buf, n - first);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void shmRingWrite(CrDaShmRing_t* ring, unsigned int pos, unsigned char* src, unsigned int n) {
+	unsigned int start = pos % CR_DA_SHM_RING_SIZE;
+	unsigned int first = CR_DA_SHM_RING_SIZE - start;
+
+	if (first > n)
+		first = n;
+	memcpy(ring->buf + start, src, first);
+	memcpy(ring->buf, src + first, n - first);
+}
@@ -0,0 +1,114 @@
+/**
+ * @file
+ * @ingroup crDemoSlave1
+ * Implementation of the orderly shutdown of the demo applications.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <signal.h>
+#include <time.h>
+#include "CrDaShutdown.h"
+#include "CrDaOutBacklog.h"
+#include "CrDaCycle.h"
+#include "CrDaIoThread.h"
+/* Include FW Profile files */
+#include "FwSmConfig.h"
+#include "FwSmCore.h"
+/* Include framework files */
+#include "BaseCmp/CrFwBaseCmp.h"
+#include "OutStream/CrFwOutStream.h"
+
+/**
+ * Handler of the termination signals.
+ * The default action of the signal is restored on entry to the handler
+ * (<code>SA_RESETHAND</code>).
+ * @param sig the signal
+ */
+static void shutdownHandler(int sig);
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaShutdownSetSignals() {
+	struct sigaction act;
+
+	memset(&act, 0, sizeof(act));
+	act.sa_handler = &shutdownHandler;
+	act.sa_flags = SA_RESETHAND;	/* no SA_RESTART: the blocking calls of the cycle are interrupted */
+	sigemptyset(&act.sa_mask);
+	if (sigaction(SIGINT, &act, NULL) < 0) {
+		perror("CrDaShutdownSetSignals, sigaction");
+		return 0;
+	}
+	if (sigaction(SIGTERM, &act, NULL) < 0) {
+		perror("CrDaShutdownSetSignals, sigaction");
+		return 0;
+	}
+	return 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaShutdownFlush(FwSmDesc_t* outStreams, unsigned int nOfOutStreams) {
+	struct timespec start, now, pause = {0, 1000000};
+	CrDaCycleWait_t wait = CrDaCycleGetWait();
+	unsigned int nOfPending, i;
+	long elapsed;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (;;) {
+		/* Retry the hand-over of the packets which are buffered by the OutStream backlog and by the OutStreams */
+		nOfPending = CrDaOutBacklogFlush();
+		for (i=0; i<nOfOutStreams; i++) {
+			if (CrFwOutStreamGetNOfPendingPckts(outStreams[i]) == 0)
+				continue;
+			CrFwOutStreamConnectionAvail(outStreams[i]);
+			nOfPending += CrFwOutStreamGetNOfPendingPckts(outStreams[i]);
+		}
+#if (CR_DA_IO_THREAD == 1)
+		if ((nOfPending == 0) && CrDaIoThreadIsOutEmpty())
+			return 1;
+#else
+		if (nOfPending == 0)
+			return 1;
+#endif
+
+		clock_gettime(CLOCK_MONOTONIC, &now);
+		elapsed = (now.tv_sec - start.tv_sec) * 1000L + (now.tv_nsec - start.tv_nsec) / 1000000;
+		if (elapsed >= CR_DA_SHUTDOWN_FLUSH_MSEC) {
+			printf("CrDaShutdownFlush: %u packets could not be flushed\n", nOfPending);
+			CrDaOutBacklogClear();
+			return 0;
+		}
+
+		/* Service the transport while it sends the packets */
+		if (wait != NULL)
+			wait(1);
+		else
+			nanosleep(&pause, NULL);
+	}
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaShutdownCmp(FwSmDesc_t* cmp, unsigned int nOfCmp) {
+	unsigned int i;
+
+	for (i=0; i<nOfCmp; i++)
+		CrFwCmpShutdown(cmp[i]);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void shutdownHandler(int sig) {
+	(void)sig;
+	CrDaCycleStop();
+}
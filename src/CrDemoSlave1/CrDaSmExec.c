@@ -0,0 +1,77 @@
+/**
+ * @file
+ * @ingroup crDemoSlave1
+ * Implementation of the execution fast path of the framework components of the demo
+ * applications.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdio.h>
+#include "CrDaSmExec.h"
+#include "CrDaSmProf.h"
+/* Include FW Profile files */
+#include "FwSmConfig.h"
+#include "FwSmCore.h"
+/* Include framework files */
+#include "InLoader/CrFwInLoader.h"
+#include "InManager/CrFwInManager.h"
+#include "InStream/CrFwInStream.h"
+#include "OutManager/CrFwOutManager.h"
+
+/** The number of executions of the InLoader and of the managers. */
+static unsigned long long nOfExec = 0;
+
+/** The number of executions of the InLoader and of the managers which have been skipped. */
+static unsigned long long nOfSkipped = 0;
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaSmExecInLoader(FwSmDesc_t inStream) {
+	CrFwInLoaderSetInStream(inStream);
+	if ((CR_DA_SM_FAST_PATH == 1) && (CrFwInStreamGetNOfPendingPckts(inStream) == 0)) {
+		nOfSkipped++;
+		return;
+	}
+	CR_DA_SM_EXECUTE(CrFwInLoaderMake());
+	nOfExec++;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaSmExecInManager(FwSmDesc_t inManager) {
+	if ((CR_DA_SM_FAST_PATH == 1) && (CrFwInManagerGetNOfPendingInCmp(inManager) == 0)) {
+		nOfSkipped++;
+		return;
+	}
+	CR_DA_SM_EXECUTE(inManager);
+	nOfExec++;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaSmExecOutManager(FwSmDesc_t outManager) {
+	if ((CR_DA_SM_FAST_PATH == 1) && (CrFwOutManagerGetNOfPendingOutCmp(outManager) == 0)) {
+		nOfSkipped++;
+		return;
+	}
+	CR_DA_SM_EXECUTE(outManager);
+	nOfExec++;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaSmExecReport(const char* app) {
+#if (CR_DA_SM_FAST_PATH == 1)
+	printf("%s: Fast path: %llu executions, %llu skipped (%.1f%%)\n", app, nOfExec, nOfSkipped,
+	       ((nOfExec + nOfSkipped) == 0 ? 0.0 : 100.0 * nOfSkipped / (nOfExec + nOfSkipped)));
+#else
+	(void)app;
+#endif
+}
@@ -0,0 +1,106 @@
+/**
+ * @file
+ * @ingroup crDemoSlave1
+ * Implementation of the tuning profiles of the sockets.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include "CrDaSocketProfile.h"
+
+/** The selected tuning profile. */
+static CrDaSocketProfile_t socketProfile = crDaSocketDefault;
+
+/**
+ * Read back an integer socket option.
+ * @param fd the file descriptor of the socket
+ * @param level the level of the option
+ * @param name the name of the option
+ * @return the value of the option or 0 if it cannot be read
+ */
+static int socketGetOpt(int fd, int level, int name);
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaSocketSetProfile(CrDaSocketProfile_t profile) {
+	socketProfile = profile;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrDaSocketProfile_t CrDaSocketGetProfile() {
+	return socketProfile;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaSocketApplyProfile(int fd, CrDaSocketTuning_t* tuning) {
+	CrFwBool_t ok = 1;
+	int on = 1, off = 0;
+	int bufSize = CR_DA_SOCKET_BUF_SIZE;
+#ifdef SO_BUSY_POLL
+	int busyPoll = CR_DA_SOCKET_BUSY_POLL_USEC;
+#endif
+
+	switch (socketProfile) {
+	case crDaSocketLowLatency:
+		if (setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on)) < 0)
+			ok = 0;
+#ifdef SO_BUSY_POLL
+		if (setsockopt(fd, SOL_SOCKET, SO_BUSY_POLL, &busyPoll, sizeof(busyPoll)) < 0)
+			ok = 0;
+#else
+		ok = 0;
+#endif
+		break;
+	case crDaSocketHighThroughput:
+		if (setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &off, sizeof(off)) < 0)
+			ok = 0;
+		if (setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &bufSize, sizeof(bufSize)) < 0)
+			ok = 0;
+		if (setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &bufSize, sizeof(bufSize)) < 0)
+			ok = 0;
+		break;
+	default:
+		break;
+	}
+
+	/* Report what actually took effect (the kernel may cap or adjust the values) */
+	tuning->profile = socketProfile;
+	tuning->noDelay = socketGetOpt(fd, IPPROTO_TCP, TCP_NODELAY);
+	tuning->sndBuf = socketGetOpt(fd, SOL_SOCKET, SO_SNDBUF);
+	tuning->rcvBuf = socketGetOpt(fd, SOL_SOCKET, SO_RCVBUF);
+#ifdef SO_BUSY_POLL
+	tuning->busyPoll = socketGetOpt(fd, SOL_SOCKET, SO_BUSY_POLL);
+#else
+	tuning->busyPoll = 0;
+#endif
+
+	if (socketProfile == crDaSocketLowLatency)
+		ok = ok && (tuning->noDelay != 0) && (tuning->busyPoll == CR_DA_SOCKET_BUSY_POLL_USEC);
+	else if (socketProfile == crDaSocketHighThroughput)
+		ok = ok && (tuning->noDelay == 0) &&
+		     (tuning->sndBuf >= CR_DA_SOCKET_BUF_SIZE) && (tuning->rcvBuf >= CR_DA_SOCKET_BUF_SIZE);
+	return ok;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static int socketGetOpt(int fd, int level, int name) {
+	int val = 0;
+	socklen_t len = sizeof(val);
+
+	if (getsockopt(fd, level, name, &val, &len) < 0)
+		return 0;
+	return val;
+}
@@ -0,0 +1,232 @@
+/**
+ * @file
+ * @ingroup crDemoSlave1
+ * Implementation of the synthetic temperature source of the Slave Applications of the CORDET Demo.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "CrDaTempGen.h"
+#include "CrDaTempMonitor.h"
+#include "CrDaSampler.h"
+
+/** Flag which is set if the synthetic temperature source is selected. */
+static CrFwBool_t genSelected = 0;
+
+/** The rate of the source in samples per second and channel. */
+static unsigned int genRate = CR_DA_TEMP_GEN_RATE;
+
+/** The number of channels of the source. */
+static unsigned int genNOfChannels = CR_DA_TEMP_GEN_N_OF_CHANNELS;
+
+/** The percentage of the samples which violate the limit. */
+static unsigned int genViolPercent = CR_DA_TEMP_GEN_VIOL_PERCENT;
+
+/** The duration of the source in seconds. */
+static unsigned int genDuration = CR_DA_TEMP_GEN_DURATION;
+
+/** Flag which is set when the schedule of the source has started. */
+static CrFwBool_t genStarted = 0;
+
+/** The time at which the schedule of the source started. */
+static struct timespec genStart;
+
+/**
+ * The violation accumulators of the channels.
+ * The accumulator of a channel is incremented by the violation percentage at every
+ * sample and the sample violates the limit when the accumulator reaches 100.
+ */
+static unsigned char genAcc[CR_DA_TEMP_GEN_MAX_N_OF_CHANNELS];
+
+#if (CR_DA_SAMPLER == 0)
+/** The samples of the channels in the current round. */
+static char genTemp[CR_DA_TEMP_GEN_MAX_N_OF_CHANNELS];
+#else
+/** The value of the samples which do not violate the limit. */
+static char genLowTemp;
+
+/** The value of the samples which violate the limit. */
+static char genHighTemp;
+#endif
+
+/** The number of samples which have been generated on each channel. */
+static unsigned long long nOfRounds = 0;
+
+/** The number of samples which violated the limit. */
+static unsigned long long nOfViolations = 0;
+
+/** The number of reports which could not be made. */
+static unsigned long long nOfRepFail = 0;
+
+/**
+ * Generate the samples of the next round.
+ * @param temp the samples of the round (output)
+ * @param lowTemp the value of the samples which do not violate the limit
+ * @param highTemp the value of the samples which violate the limit
+ */
+static void tempGenRound(char* temp, char lowTemp, char highTemp);
+
+#if (CR_DA_SAMPLER == 1)
+/**
+ * The acquisition function of the sampler (see <code>CrDaSampler.h</code>): generate the
+ * samples of the next round.
+ * @param round the number of the round (unused: the rounds are generated in sequence)
+ * @param temp the samples of the round (output)
+ * @return the number of channels of the source
+ */
+static unsigned int tempGenAcquire(unsigned long long round, char* temp);
+#endif
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaTempGenParseOpt(int opt, const char* arg) {
+	long val;
+	char* end;
+
+	if (opt == 'g') {
+		genSelected = 1;
+		return 1;
+	}
+	if (arg == NULL)
+		return 0;
+	val = strtol(arg, &end, 10);
+	if ((*end != '\0') || (val < 0))
+		return 0;
+	if (opt == 'v') {
+		if (val > 100)
+			return 0;
+		genViolPercent = (unsigned int)val;
+		return 1;
+	}
+	if (val == 0)
+		return 0;
+	if (opt == 'r')
+		genRate = (unsigned int)val;
+	else if (opt == 'n') {
+		if (val > CR_DA_TEMP_GEN_MAX_N_OF_CHANNELS)
+			return 0;
+		genNOfChannels = (unsigned int)val;
+	} else if (opt == 't')
+		genDuration = (unsigned int)val;
+	else
+		return 0;
+	return 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaTempGenUsage() {
+	printf("  -g           drive the temperature monitoring from the synthetic source\n");
+	printf("  -r rate      samples per second and channel (default: %d)\n", CR_DA_TEMP_GEN_RATE);
+	printf("  -n nOfChan   number of channels, at most %d (default: %d)\n", CR_DA_TEMP_GEN_MAX_N_OF_CHANNELS,
+	       CR_DA_TEMP_GEN_N_OF_CHANNELS);
+	printf("  -v percent   percentage of the samples which violate the limit (default: %d)\n",
+	       CR_DA_TEMP_GEN_VIOL_PERCENT);
+	printf("  -t duration  duration in seconds (default: %d)\n", CR_DA_TEMP_GEN_DURATION);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaTempGenIsSelected() {
+	return genSelected;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+unsigned int CrDaTempGenGetNOfCycles() {
+	return (unsigned int)((genDuration * 1000000ULL) / CR_DA_TEMP_GEN_PERIOD_USEC);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaTempGenCycle(char lowTemp, char highTemp) {
+#if (CR_DA_SAMPLER == 0)
+	struct timespec now;
+	unsigned long long elapsed, due;
+#endif
+	unsigned int chan;
+
+	if (!genStarted) {
+		clock_gettime(CLOCK_MONOTONIC, &genStart);
+		/* Stagger the violations across the channels */
+		for (chan=0; chan<genNOfChannels; chan++)
+			genAcc[chan] = (unsigned char)((chan * 100) / genNOfChannels);
+		CrDaTempMonitoringSetUp((char)((lowTemp + highTemp) / 2));
+		genStarted = 1;
+#if (CR_DA_SAMPLER == 1)
+		/* The rounds are generated by the sampler thread on the same schedule */
+		genLowTemp = lowTemp;
+		genHighTemp = highTemp;
+		CrDaSamplerStart(&tempGenAcquire, genRate, (unsigned long long)genDuration * genRate + 1);
+#endif
+	}
+
+#if (CR_DA_SAMPLER == 1)
+	nOfRepFail += CrDaSamplerConsume(CR_FW_HOST_APP_ID);
+#else
+	/* Number of samples per channel which are due by now */
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	elapsed = (unsigned long long)(now.tv_sec - genStart.tv_sec) * 1000000000ULL + now.tv_nsec - genStart.tv_nsec;
+	if (elapsed > genDuration * 1000000000ULL)
+		elapsed = genDuration * 1000000000ULL;
+	due = (elapsed * genRate) / 1000000000ULL + 1;
+
+	while (nOfRounds < due) {
+		tempGenRound(genTemp, lowTemp, highTemp);
+		/* Monitor all channels of the round at once */
+		nOfRepFail += CrDaTempMonitoringExecMulti(genTemp, genNOfChannels, CR_FW_HOST_APP_ID);
+	}
+#endif
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaTempGenReport(const char* app) {
+	struct timespec now;
+	double elapsed;
+	unsigned long long nOfSamples = nOfRounds * genNOfChannels;
+
+	if (!genStarted)
+		return;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	elapsed = (double)(now.tv_sec - genStart.tv_sec) + (now.tv_nsec - genStart.tv_nsec) / 1e9;
+	if (elapsed > genDuration)
+		elapsed = genDuration;	/* no samples are generated after the end of the schedule */
+
+	printf("%s: Synthetic source: %u samples/s on %u channel(s) with %u%% violations during %.3f s\n", app,
+	       genRate, genNOfChannels, genViolPercent, elapsed);
+	printf("%s: Synthetic source: %llu samples (%.1f/s), %llu violations (%.1f/s), %llu reports not made\n", app,
+	       nOfSamples, nOfSamples / elapsed, nOfViolations, nOfViolations / elapsed, nOfRepFail);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void tempGenRound(char* temp, char lowTemp, char highTemp) {
+	unsigned int chan;
+
+	for (chan=0; chan<genNOfChannels; chan++) {
+		genAcc[chan] = (unsigned char)(genAcc[chan] + genViolPercent);
+		if (genAcc[chan] >= 100) {
+			genAcc[chan] = (unsigned char)(genAcc[chan] - 100);
+			temp[chan] = highTemp;
+			nOfViolations++;
+		} else
+			temp[chan] = lowTemp;
+	}
+	nOfRounds++;
+}
+
+#if (CR_DA_SAMPLER == 1)
+/* ---------------------------------------------------------------------------------------------*/
+static unsigned int tempGenAcquire(unsigned long long round, char* temp) {
+	(void)round;
+	tempGenRound(temp, genLowTemp, genHighTemp);
+	return genNOfChannels;
+}
+#endif
@@ -0,0 +1,119 @@
+/**
+ * @file
+ * @ingroup crDemoSlave1
+ * Interface for the synthetic temperature source of the Slave Applications of the CORDET Demo.
+ * By default, the Slave Applications acquire one temperature sample per control cycle
+ * and their control cycles have a period of one second.
+ * The synthetic temperature source replaces this sample with a programmable stream of
+ * samples over many channels so that the OutFactory, the OutManager and the transport
+ * can be stressed at realistic report rates.
+ *
+ * The source samples each of its channels at a constant rate for a given duration and
+ * passes the samples of all channels of a round to
+ * <code>::CrDaTempMonitoringExecMulti</code> which compares them with the limits of the
+ * channel table in one pass of its vectorized kernel (source channel i is channel i of
+ * the table).
+ * A given percentage of the samples of each channel are "high" samples which violate the
+ * temperature limit and which therefore generate a report to the Master Application;
+ * the other samples are "low" samples.
+ * The violations are evenly spread over the samples of a channel and they are staggered
+ * across the channels.
+ * When the source starts, it enables the monitoring of all channels with a limit halfway
+ * between the "low" and the "high" samples (see <code>::CrDaTempMonitoringSetUp</code>):
+ * the commands of the Master Application can still change the limit of a channel or
+ * disable its monitoring.
+ *
+ * The synthetic temperature source is selected on the command line of the Slave
+ * Applications (see <code>::CrDaTempGenParseOpt</code>):
+ * - <code>-g</code> selects the synthetic temperature source;
+ * - <code>-r rate</code> sets the rate in samples per second and channel
+ *   (default: <code>#CR_DA_TEMP_GEN_RATE</code>);
+ * - <code>-n nOfChannels</code> sets the number of channels
+ *   (default: <code>#CR_DA_TEMP_GEN_N_OF_CHANNELS</code>);
+ * - <code>-v percent</code> sets the percentage of the samples which violate the limit
+ *   (default: <code>#CR_DA_TEMP_GEN_VIOL_PERCENT</code>);
+ * - <code>-t duration</code> sets the duration in seconds
+ *   (default: <code>#CR_DA_TEMP_GEN_DURATION</code>).
+ * .
+ * If the source is selected, the control cycles have a period of
+ * <code>#CR_DA_TEMP_GEN_PERIOD_USEC</code> and, in each cycle, the source generates the
+ * samples which are due at this point of the schedule.
+ * If the sampler is selected (see <code>CrDaSampler.h</code>), the samples are instead
+ * generated on the same schedule by the sampler thread and, in each cycle, the source
+ * monitors the rounds which the sampler has generated since the previous cycle.
+ *
+ * When the run has finished, the source reports:
+ * - the number and rate of the generated samples;
+ * - the number and rate of the violations (i.e. of the reports requested from the
+ *   OutFactory);
+ * - the number of reports which could not be made because the OutFactory or the packet
+ *   pool was exhausted.
+ * .
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRDA_TEMPGEN_H_
+#define CRDA_TEMPGEN_H_
+
+/* Include Framework Files */
+#include "CrFwConstants.h"
+/* Include Configuration Files */
+#include "CrFwUserConstants.h"
+#include "CrDaConstants.h"
+
+/** The command line options of the synthetic temperature source (in the format of <code>getopt</code>). */
+#define CR_DA_TEMP_GEN_OPTIONS "gr:n:v:t:"
+
+/**
+ * Process a command line option of the synthetic temperature source.
+ * @param opt the option (one of the options of <code>#CR_DA_TEMP_GEN_OPTIONS</code>)
+ * @param arg the argument of the option (NULL for option <code>-g</code>)
+ * @return 1 if the option is valid; 0 otherwise
+ */
+CrFwBool_t CrDaTempGenParseOpt(int opt, const char* arg);
+
+/**
+ * Print the usage of the command line options of the synthetic temperature source.
+ */
+void CrDaTempGenUsage();
+
+/**
+ * Return true if the synthetic temperature source has been selected on the command line.
+ * @return 1 if the synthetic temperature source is selected; 0 otherwise
+ */
+CrFwBool_t CrDaTempGenIsSelected();
+
+/**
+ * Return the number of control cycles of the synthetic temperature source.
+ * @return the number of control cycles
+ */
+unsigned int CrDaTempGenGetNOfCycles();
+
+/**
+ * Generate the samples which are due in the current control cycle and pass them to
+ * <code>::CrDaTempMonitoringExecMulti</code>.
+ * The schedule of the source starts with the first call to this function (which, if the
+ * sampler is selected, starts the sampler).
+ * @param lowTemp the value of the samples which do not violate the limit
+ * @param highTemp the value of the samples which violate the limit
+ */
+void CrDaTempGenCycle(char lowTemp, char highTemp);
+
+/**
+ * Print the sample and report rates and the failure count of the synthetic temperature source.
+ * @param app the name of the application (e.g. "S1")
+ */
+void CrDaTempGenReport(const char* app);
+
+#endif /* CRDA_TEMPGEN_H_ */
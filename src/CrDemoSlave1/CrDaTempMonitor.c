@@ -19,7 +19,15 @@
 #include <stdio.h>
 #include "CrDaServerSocket.h"
 #include "CrDaConstants.h"
+#include "CrDaTempMonitor.h"
 #include "CrDaOutCmpTempViolation.h"
+#include "CrDaInCmdBatch.h"
+#include "CrDaOutCmpTempBatch.h"
+#include "CrDaOutCmpTempStats.h"
+#include "CrDaOutAdmit.h"
+#include "CrDaEventLog.h"
+#include "CrDaPar.h"
+#include "CrDaLog.h"
 /* Include FW Profile files */
 #include "FwSmConstants.h"
 #include "FwSmConfig.h"
@@ -51,45 +59,612 @@
 #include <fcntl.h>
 #include <errno.h>
 #include <pthread.h>
+/* Include file for the vectorized kernel of the multi-channel monitoring */
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
 
-/** The temperature limit */
-static int tempLimit = 0;
+/** The number of words of 32 channels of the channel table. */
+#define CR_DA_TEMP_N_OF_WORDS (CR_DA_TEMP_N_OF_CHANNELS/32)
 
-/** The enable status of temperature monitoring */
-static CrFwBool_t isTempMonitoringEnabled = 0;
+#if ((CR_DA_TEMP_N_OF_CHANNELS % 32) != 0)
+#error "The number of channels of the temperature monitoring must be a multiple of 32"
+#endif
+
+/** The channel table (see <code>CrDaTempMonitor.h</code>), one array for each attribute of the channels. */
+typedef struct {
+	/** The limits of the channels. */
+	char limit[CR_DA_TEMP_N_OF_CHANNELS];
+	/** The release temperatures of the channels (their limits minus their hysteresis bands). */
+	char release[CR_DA_TEMP_N_OF_CHANNELS];
+	/** The hysteresis bands of the channels. */
+	char hyst[CR_DA_TEMP_N_OF_CHANNELS];
+	/** The enable bits of the channels. */
+	uint32_t isEnabled[CR_DA_TEMP_N_OF_WORDS];
+	/** The violation bits of the channels (the channels which are in violation). */
+	uint32_t isViolated[CR_DA_TEMP_N_OF_WORDS];
+	/** The number of violations which each channel has entered. */
+	unsigned int nOfViolations[CR_DA_TEMP_N_OF_CHANNELS];
+} CrDaTempChanTable_t;
+
+/** The channel table. */
+static CrDaTempChanTable_t chanTable;
+
+#if (CR_DA_TEMP_SUPPRESS != 0)
+/** The suppression state of a channel. */
+typedef struct {
+	/** Whether the current violation of the channel has been reported. */
+	CrFwBool_t isReported;
+	/** The last reported temperature of the channel. */
+	char lastTemp;
+	/** The number of reports which the channel has suppressed since its last report. */
+	unsigned char nOfSuppressed;
+	/** The number of samples of the channel since its last report. */
+	unsigned short nOfSamples;
+} CrDaTempChanState_t;
+
+/** The suppression state of the channels. */
+static CrDaTempChanState_t chanState[CR_DA_TEMP_N_OF_CHANNELS];
+
+/** The total number of suppressed reports. */
+static unsigned long long nOfSuppressedReps = 0;
+#endif
+
+/** The argument of a temperature violation report which is issued through the admission control. */
+typedef struct {
+	/** The temperature of the violation. */
+	char temp;
+	/** The channel of the violation. */
+	unsigned short chan;
+} CrDaTempReportArg_t;
+
+/**
+ * Set the enable bit of the channel of an InCommand (or of all channels).
+ * @param par the parameter area of the InCommand
+ * @param isEnabled the value of the enable bit
+ */
+static void tempMonitoringSetEnabled(const char* par, CrFwBool_t isEnabled);
+
+/**
+ * Set or clear the enable bits of the range (or of the mask) of the parameters of a Bulk
+ * Enable or Bulk Disable Temperature Monitoring command.
+ * The violation bits of the channels which are disabled are cleared too.
+ * @param par the parameters of the command (a <code>ChanMask</code>, followed by the
+ * mask if the command carries one)
+ * @param isEnabled the value of the enable bits
+ */
+static void tempMonitoringSetEnabledMask(const char* par, CrFwBool_t isEnabled);
+
+/**
+ * Set the limit and the hysteresis band of the channel of an InCommand (or of all channels).
+ * @param par the parameter area of the InCommand
+ */
+static void tempMonitoringSetLimit(const char* par);
+
+/**
+ * Set the limit and the hysteresis band of a channel.
+ * @param chan the channel
+ * @param limit the limit
+ * @param hyst the hysteresis band
+ */
+static void tempMonitoringSetChanLimit(unsigned int chan, char limit, char hyst);
+
+/**
+ * Update the violation bits of a word of 32 channels with their samples.
+ * @param w the index of the word
+ * @param temp the samples of the channels of the word
+ * @param n the number of channels of the word which have a sample
+ * @return the mask of the enabled channels of the word whose sample exceeds the limit
+ */
+static uint32_t tempMonitoringCheckChan(unsigned int w, const char* temp, unsigned int n);
+
+/**
+ * Update the suppression state of a channel with one of its samples and decide whether
+ * the report of the sample is suppressed (see <code>#CR_DA_TEMP_SUPPRESS</code>).
+ * The reports of a channel are re-armed when its violation ends.
+ * @param chan the channel of the sample
+ * @param temp the temperature of the sample
+ * @param isViolated whether the channel is in violation after the sample
+ * @param isAbove whether the sample exceeds the limit of the channel
+ * @return 1 if the sample exceeds the limit and its report is suppressed; 0 otherwise
+ */
+static CrFwBool_t tempMonitoringIsSuppressed(unsigned short chan, char temp, CrFwBool_t isViolated, CrFwBool_t isAbove);
+
+/**
+ * Report a violation of the limit of a channel (or add it to the pending batch report if
+ * the coalescing of the temperature violations is selected).
+ * @param temp the temperature of the violation
+ * @param chan the channel of the violation
+ * @param appId the identifier of the application which is performing the monitoring
+ * @return 0 if the report was rejected (see <code>CrDaOutAdmit.h</code>); 1 otherwise
+ */
+static CrFwBool_t tempMonitoringReport(char temp, unsigned short chan, CrFwDestSrc_t appId);
+
+/**
+ * Issue Function of the temperature violation reports (see <code>CrDaOutAdmit.h</code>):
+ * set the parameters of the report, record that its channel has reported and load it.
+ * A deferred report records its channel when it is issued.
+ * @param rep the report
+ * @param dest the destination of the report
+ * @param arg the violation (a <code>::CrDaTempReportArg_t</code>)
+ */
+static void tempMonitoringIssue(FwSmDesc_t rep, CrFwDestSrc_t dest, const void* arg);
+
+/**
+ * Record that a channel has reported a violation and return the number of reports which
+ * it has suppressed since its previous report.
+ * @param chan the channel
+ * @param temp the reported temperature
+ * @return the number of suppressed reports (saturated at 255)
+ */
+static unsigned char tempMonitoringReported(unsigned short chan, char temp);
+
+/**
+ * Compare the samples of up to 32 channels with their limits.
+ * @param temp the samples of the channels
+ * @param limit the limits of the channels
+ * @param n the number of channels (at most 32)
+ * @return the violation mask of the channels (bit i is set if sample i exceeds limit i)
+ */
+static uint32_t tempMonitoringCheckWord(const char* temp, const char* limit, unsigned int n);
 
 /* ---------------------------------------------------------------------- */
 void CrDaTempMonitoringEnable(FwSmDesc_t smDesc) {
-	isTempMonitoringEnabled = 1;
+	tempMonitoringSetEnabled(CrFwInCmdGetParStart(smDesc), 1);
 }
 
 /* ---------------------------------------------------------------------- */
 void CrDaTempMonitoringDisable(FwSmDesc_t smDesc) {
-	isTempMonitoringEnabled = 0;
+	tempMonitoringSetEnabled(CrFwInCmdGetParStart(smDesc), 0);
 }
 
 /* ---------------------------------------------------------------------- */
 void CrDaTempMonitoringSetTempLimit(FwSmDesc_t smDesc) {
-	char* pcktPar = CrFwInCmdGetParStart(smDesc);
-	tempLimit = pcktPar[0];
-}
-
-/* ---------------------------------------------------------------------- */
-void CrDaTempMonitoringExec(char temp, CrFwDestSrc_t appId) {
-	FwSmDesc_t rep;
-	if (isTempMonitoringEnabled == 1) {
-		if (temp > tempLimit) {
-			if (appId == CR_DA_SLAVE_1)
-				printf("S1: Temperature violation detected -- Sending report to Master Application\n");
-			else
-				printf("S2: Temperature violation detected -- Sending report to Master Application\n");
-			/* Create outReport reporting temperature violation */
-			rep = CrFwOutFactoryMakeOutCmp(CR_DA_SERV_TYPE,CR_DA_SERV_SUBTYPE_REP,0,0);
-			CrDaOutCmpTempViolationSetTemp(temp);
-			CrFwOutCmpSetDest(rep,CR_DA_MASTER);
-			/* Request outReport to be sent out */
-			CrFwOutLoaderLoad(rep);
+	tempMonitoringSetLimit(CrFwInCmdGetParStart(smDesc));
+}
+
+/* ---------------------------------------------------------------------- */
+CrFwBool_t CrDaTempMonitoringSetTempLimitsValidityCheck(FwPrDesc_t prDesc) {
+	CrFwCmpData_t* cmpData = (CrFwCmpData_t*)FwPrGetData(prDesc);
+	CrFwInCmdData_t* cmpSpecificData = (CrFwInCmdData_t*)(cmpData->cmpSpecificData);
+	CrFwPckt_t pckt = cmpSpecificData->pckt; /* the packet of the InCommand */
+	char* par = CrFwPcktGetParStart(pckt);
+	unsigned int first = CrDaParLimitBlockGetFirst(par);
+	unsigned int n = CrDaParLimitBlockGetN(par);
+
+	if ((n > CR_DA_TEMP_BULK_MAX_N) || (first + n > CR_DA_TEMP_N_OF_CHANNELS))
+		return 0;
+	return (CR_DA_PAR_LENGTH(LimitBlock) + n <= CrFwPcktGetParLength(pckt));
+}
+
+/* ---------------------------------------------------------------------- */
+void CrDaTempMonitoringSetTempLimits(FwSmDesc_t smDesc) {
+	const char* par = CrFwInCmdGetParStart(smDesc);
+	unsigned int first = CrDaParLimitBlockGetFirst(par);
+	unsigned int n = CrDaParLimitBlockGetN(par);
+	unsigned int i;
+
+	memcpy(&chanTable.limit[first], par + CR_DA_PAR_LENGTH(LimitBlock), n);
+	for (i=first; i<first+n; i++)
+		chanTable.release[i] = (char)(chanTable.limit[i] - chanTable.hyst[i]);
+}
+
+/* ---------------------------------------------------------------------- */
+CrFwBool_t CrDaTempMonitoringSetEnabledMaskValidityCheck(FwPrDesc_t prDesc) {
+	CrFwCmpData_t* cmpData = (CrFwCmpData_t*)FwPrGetData(prDesc);
+	CrFwInCmdData_t* cmpSpecificData = (CrFwInCmdData_t*)(cmpData->cmpSpecificData);
+	CrFwPckt_t pckt = cmpSpecificData->pckt; /* the packet of the InCommand */
+	char* par = CrFwPcktGetParStart(pckt);
+	unsigned int first = CrDaParChanMaskGetFirst(par);
+	unsigned int n = CrDaParChanMaskGetN(par);
+
+	if ((n == 0) || (first + n > CR_DA_TEMP_N_OF_CHANNELS))
+		return 0;
+	if (!CrDaParChanMaskGetIsMasked(par))
+		return (CR_DA_PAR_LENGTH(ChanMask) <= CrFwPcktGetParLength(pckt));
+	return (CR_DA_PAR_LENGTH(ChanMask) + (n+7)/8 <= CrFwPcktGetParLength(pckt));
+}
+
+/* ---------------------------------------------------------------------- */
+void CrDaTempMonitoringEnableMask(FwSmDesc_t smDesc) {
+	tempMonitoringSetEnabledMask(CrFwInCmdGetParStart(smDesc), 1);
+}
+
+/* ---------------------------------------------------------------------- */
+void CrDaTempMonitoringDisableMask(FwSmDesc_t smDesc) {
+	tempMonitoringSetEnabledMask(CrFwInCmdGetParStart(smDesc), 0);
+}
+
+/* ---------------------------------------------------------------------- */
+void CrDaTempMonitoringEnableBatch(const CrDaInCmdBatchEntry_t* entry, unsigned int n) {
+	unsigned int i;
+
+	for (i=0; i<n; i++)
+		tempMonitoringSetEnabled(entry[i].par, 1);
+}
+
+/* ---------------------------------------------------------------------- */
+void CrDaTempMonitoringDisableBatch(const CrDaInCmdBatchEntry_t* entry, unsigned int n) {
+	unsigned int i;
+
+	for (i=0; i<n; i++)
+		tempMonitoringSetEnabled(entry[i].par, 0);
+}
+
+/* ---------------------------------------------------------------------- */
+void CrDaTempMonitoringSetTempLimitBatch(const CrDaInCmdBatchEntry_t* entry, unsigned int n) {
+	unsigned int i;
+
+	for (i=0; i<n; i++)
+		tempMonitoringSetLimit(entry[i].par);
+}
+
+/* ---------------------------------------------------------------------- */
+void CrDaTempMonitoringSetUp(char limit) {
+	unsigned int i;
+
+	for (i=0; i<CR_DA_TEMP_N_OF_CHANNELS; i++)
+		tempMonitoringSetChanLimit(i, limit, CR_DA_TEMP_HYSTERESIS);
+	memset(chanTable.isEnabled, 0xFF, sizeof(chanTable.isEnabled));
+}
+
+/* ---------------------------------------------------------------------- */
+void CrDaTempMonitoringGetState(CrDaTempChanConfig_t* config) {
+	memcpy(config->limit, chanTable.limit, sizeof(config->limit));
+	memcpy(config->hyst, chanTable.hyst, sizeof(config->hyst));
+	memcpy(config->isEnabled, chanTable.isEnabled, sizeof(config->isEnabled));
+}
+
+/* ---------------------------------------------------------------------- */
+void CrDaTempMonitoringSetState(const CrDaTempChanConfig_t* config) {
+	unsigned int i;
+
+	for (i=0; i<CR_DA_TEMP_N_OF_CHANNELS; i++)
+		tempMonitoringSetChanLimit(i, config->limit[i], config->hyst[i]);
+	memcpy(chanTable.isEnabled, config->isEnabled, sizeof(chanTable.isEnabled));
+	memset(chanTable.isViolated, 0, sizeof(chanTable.isViolated));
+}
+
+/* ---------------------------------------------------------------------- */
+unsigned int CrDaTempMonitoringGetNOfViolations(unsigned short chan) {
+	if (chan >= CR_DA_TEMP_N_OF_CHANNELS)
+		return 0;
+	return chanTable.nOfViolations[chan];
+}
+
+/* ---------------------------------------------------------------------- */
+CrFwBool_t CrDaTempMonitoringExec(char temp, unsigned short chan, CrFwDestSrc_t appId) {
+	CrFwBool_t isAbove;
+	uint32_t bit;
+
+	if (chan >= CR_DA_TEMP_N_OF_CHANNELS)
+		return 1;
+	bit = (uint32_t)1 << (chan % 32);
+	if ((chanTable.isEnabled[chan/32] & bit) == 0)
+		return 1;
+
+	/* A violation starts above the limit and ends at the release temperature */
+	isAbove = (temp > chanTable.limit[chan]);
+	if (isAbove) {
+		if ((chanTable.isViolated[chan/32] & bit) == 0)
+			chanTable.nOfViolations[chan]++;
+		chanTable.isViolated[chan/32] |= bit;
+	} else if (temp <= chanTable.release[chan])
+		chanTable.isViolated[chan/32] &= ~bit;
+
+#if (CR_DA_TEMP_STATS == 1)
+	/* The temperature goes into the statistics of the window instead of a report */
+	CrDaOutCmpTempStatsAdd(chan, temp, isAbove);
+	return 1;
+#else
+	if (tempMonitoringIsSuppressed(chan, temp, ((chanTable.isViolated[chan/32] & bit) != 0), isAbove))
+		return 1;
+	if (isAbove)
+		return tempMonitoringReport(temp, chan, appId);
+	return 1;
+#endif
+}
+
+/* ---------------------------------------------------------------------- */
+unsigned int CrDaTempMonitoringCheck(const char* temp, const char* limit, unsigned int n, uint32_t* viol) {
+	unsigned int base, nOfViol = 0;
+
+	for (base=0; base<n; base+=32) {
+		viol[base/32] = tempMonitoringCheckWord(&temp[base], &limit[base], (n-base < 32 ? n-base : 32));
+		nOfViol += (unsigned int)__builtin_popcount(viol[base/32]);
+	}
+	return nOfViol;
+}
+
+/* ---------------------------------------------------------------------- */
+unsigned int CrDaTempMonitoringExecMulti(const char* temp, unsigned int n, CrFwDestSrc_t appId) {
+	unsigned int w, base, i, nOfFail = 0;
+	unsigned short chan;
+	uint32_t above;
+#if (CR_DA_TEMP_STATS == 1) || (CR_DA_TEMP_SUPPRESS != 0)
+	uint32_t enabled, bit;
+#endif
+
+	if (n > CR_DA_TEMP_N_OF_CHANNELS)
+		n = CR_DA_TEMP_N_OF_CHANNELS;
+	for (w=0, base=0; base<n; w++, base+=32) {
+		above = tempMonitoringCheckChan(w, &temp[base], (n-base < 32 ? n-base : 32));
+#if (CR_DA_TEMP_STATS == 1)
+		/* The samples of every enabled channel go into the statistics of the window */
+		for (enabled=chanTable.isEnabled[w]; enabled!=0; enabled&=(enabled-1)) {
+			i = (unsigned int)__builtin_ctz(enabled);
+			if (base+i >= n)
+				break;
+			chan = (unsigned short)(base + i);
+			bit = (uint32_t)1 << i;
+			CrDaOutCmpTempStatsAdd(chan, temp[chan], ((above & bit) != 0));
+		}
+#elif (CR_DA_TEMP_SUPPRESS != 0)
+		/* The suppression state of every enabled channel follows its samples */
+		for (enabled=chanTable.isEnabled[w]; enabled!=0; enabled&=(enabled-1)) {
+			i = (unsigned int)__builtin_ctz(enabled);
+			if (base+i >= n)
+				break;
+			chan = (unsigned short)(base + i);
+			bit = (uint32_t)1 << i;
+			if (tempMonitoringIsSuppressed(chan, temp[chan], ((chanTable.isViolated[w] & bit) != 0),
+			                               ((above & bit) != 0)))
+				continue;
+			if (((above & bit) != 0) && !tempMonitoringReport(temp[chan], chan, appId))
+				nOfFail++;
+		}
+#else
+		/* Only the channels which exceed their limit are visited */
+		for (; above!=0; above&=(above-1)) {
+			i = (unsigned int)__builtin_ctz(above);
+			chan = (unsigned short)(base + i);
+			if (!tempMonitoringReport(temp[chan], chan, appId))
+				nOfFail++;
+		}
+#endif
+	}
+	return nOfFail;
+}
+
+/* ---------------------------------------------------------------------- */
+void CrDaTempMonitoringReport(const char* app) {
+	unsigned int w, nOfEnabled = 0, nOfViolated = 0;
+	unsigned long long nOfViolations = 0;
+	unsigned int i;
+
+	for (w=0; w<CR_DA_TEMP_N_OF_WORDS; w++) {
+		nOfEnabled += (unsigned int)__builtin_popcount(chanTable.isEnabled[w]);
+		nOfViolated += (unsigned int)__builtin_popcount(chanTable.isViolated[w]);
+	}
+	for (i=0; i<CR_DA_TEMP_N_OF_CHANNELS; i++)
+		nOfViolations += chanTable.nOfViolations[i];
+	if (nOfViolations == 0)
+		return;
+	printf("%s: Temperature monitoring: %u channels enabled, %u in violation, %llu violations entered\n", app,
+	       nOfEnabled, nOfViolated, nOfViolations);
+#if (CR_DA_TEMP_SUPPRESS != 0)
+	printf("%s: Temperature monitoring: %llu reports suppressed (policy %d)\n", app, nOfSuppressedReps,
+	       CR_DA_TEMP_SUPPRESS);
+#endif
+}
+
+/* ---------------------------------------------------------------------- */
+static void tempMonitoringSetEnabled(const char* par, CrFwBool_t isEnabled) {
+	unsigned short chan = CrDaParChanGetChan(par);
+
+	if (chan == CR_DA_TEMP_ALL_CHANNELS) {
+		memset(chanTable.isEnabled, (isEnabled ? 0xFF : 0), sizeof(chanTable.isEnabled));
+		if (!isEnabled)
+			memset(chanTable.isViolated, 0, sizeof(chanTable.isViolated));
+		return;
+	}
+	if (chan >= CR_DA_TEMP_N_OF_CHANNELS)
+		return;
+	if (isEnabled)
+		chanTable.isEnabled[chan/32] |= ((uint32_t)1 << (chan % 32));
+	else {
+		chanTable.isEnabled[chan/32] &= ~((uint32_t)1 << (chan % 32));
+		chanTable.isViolated[chan/32] &= ~((uint32_t)1 << (chan % 32));
+	}
+}
+
+/* ---------------------------------------------------------------------- */
+static void tempMonitoringSetEnabledMask(const char* par, CrFwBool_t isEnabled) {
+	const unsigned char* mask = (const unsigned char*)par + CR_DA_PAR_LENGTH(ChanMask);
+	unsigned int first = CrDaParChanMaskGetFirst(par);
+	unsigned int n = CrDaParChanMaskGetN(par);
+	unsigned int nOfBytes = (n+7)/8;
+	unsigned int i, b, w, shift;
+	uint32_t bits, word[2];
+
+	for (i=0; i<n; i+=32) {
+		/* The bits of channels first+i to first+i+31 */
+		if (CrDaParChanMaskGetIsMasked(par))
+			for (b=0, bits=0; (b<4) && (i/8+b<nOfBytes); b++)
+				bits |= (uint32_t)mask[i/8+b] << (8*b);
+		else
+			bits = 0xFFFFFFFF;
+		if (n-i < 32)
+			bits &= ((uint32_t)1 << (n-i)) - 1;
+		/* They straddle two words of the channel table unless the range starts on a word */
+		w = (first+i)/32;
+		shift = (first+i)%32;
+		word[0] = bits << shift;
+		word[1] = (shift == 0 ? 0 : bits >> (32-shift));
+		for (b=0; (b<2) && (w+b<CR_DA_TEMP_N_OF_WORDS); b++) {
+			if (isEnabled)
+				chanTable.isEnabled[w+b] |= word[b];
+			else {
+				chanTable.isEnabled[w+b] &= ~word[b];
+				chanTable.isViolated[w+b] &= ~word[b];
+			}
 		}
 	}
-	return;
+}
+
+/* ---------------------------------------------------------------------- */
+static void tempMonitoringSetLimit(const char* par) {
+	unsigned short chan = CrDaParLimitGetChan(par);
+	char limit = CrDaParLimitGetTemp(par);
+	char hyst = CrDaParLimitGetHyst(par);
+	unsigned int i;
+
+	if (chan == CR_DA_TEMP_ALL_CHANNELS) {
+		for (i=0; i<CR_DA_TEMP_N_OF_CHANNELS; i++)
+			tempMonitoringSetChanLimit(i, limit, hyst);
+	} else if (chan < CR_DA_TEMP_N_OF_CHANNELS)
+		tempMonitoringSetChanLimit(chan, limit, hyst);
+}
+
+/* ---------------------------------------------------------------------- */
+static void tempMonitoringSetChanLimit(unsigned int chan, char limit, char hyst) {
+	chanTable.limit[chan] = limit;
+	chanTable.hyst[chan] = hyst;
+	chanTable.release[chan] = (char)(limit - hyst);
+}
+
+/* ---------------------------------------------------------------------- */
+static uint32_t tempMonitoringCheckChan(unsigned int w, const char* temp, unsigned int n) {
+	uint32_t enabled = chanTable.isEnabled[w];
+	uint32_t old = chanTable.isViolated[w];
+	uint32_t above, aboveRelease, violated, entered;
+
+	if (enabled == 0)
+		return 0;
+	above = tempMonitoringCheckWord(temp, &chanTable.limit[w*32], n) & enabled;
+	aboveRelease = tempMonitoringCheckWord(temp, &chanTable.release[w*32], n);
+	/* The channels beyond the last sample keep their state */
+	if (n < 32)
+		aboveRelease |= ~(((uint32_t)1 << n) - 1);
+	/* A violation starts above the limit and ends at the release temperature */
+	violated = above | (old & aboveRelease);
+	chanTable.isViolated[w] = violated;
+	for (entered=(violated & ~old); entered!=0; entered&=(entered-1))
+		chanTable.nOfViolations[w*32 + (unsigned int)__builtin_ctz(entered)]++;
+	return above;
+}
+
+/* ---------------------------------------------------------------------- */
+static CrFwBool_t tempMonitoringIsSuppressed(unsigned short chan, char temp, CrFwBool_t isViolated, CrFwBool_t isAbove) {
+#if (CR_DA_TEMP_SUPPRESS != 0)
+	CrDaTempChanState_t* state;
+	CrFwBool_t isSuppressed;
+
+	state = &chanState[chan];
+	if (state->nOfSamples < CR_DA_TEMP_SUPPRESS_PERIOD)
+		state->nOfSamples++;
+	if (!isViolated) {
+		/* The next violation is reported (unless the report rate is limited) */
+		if (CR_DA_TEMP_SUPPRESS != 2)
+			state->isReported = 0;
+		return 0;
+	}
+	if (!isAbove)
+		return 0;	/* within the hysteresis band: there is nothing to report */
+
+#if (CR_DA_TEMP_SUPPRESS == 1)
+	isSuppressed = state->isReported;
+#elif (CR_DA_TEMP_SUPPRESS == 2)
+	isSuppressed = (state->isReported && (state->nOfSamples < CR_DA_TEMP_SUPPRESS_PERIOD));
+#else
+	isSuppressed = (state->isReported && (abs(temp - state->lastTemp) <= CR_DA_TEMP_SUPPRESS_DEADBAND));
+#endif
+	if (isSuppressed) {
+		if (state->nOfSuppressed < 255)
+			state->nOfSuppressed++;
+		nOfSuppressedReps++;
+	}
+	return isSuppressed;
+#else
+	return 0;
+#endif
+}
+
+/* ---------------------------------------------------------------------- */
+static unsigned char tempMonitoringReported(unsigned short chan, char temp) {
+#if (CR_DA_TEMP_SUPPRESS != 0)
+	CrDaTempChanState_t* state;
+	unsigned char nOfSuppressed;
+
+	state = &chanState[chan];
+	nOfSuppressed = state->nOfSuppressed;
+	state->isReported = 1;
+	state->lastTemp = temp;
+	state->nOfSuppressed = 0;
+	state->nOfSamples = 0;
+	return nOfSuppressed;
+#else
+	return 0;
+#endif
+}
+
+/* ---------------------------------------------------------------------- */
+static CrFwBool_t tempMonitoringReport(char temp, unsigned short chan, CrFwDestSrc_t appId) {
+	CrDaOutAdmitReq_t req = {CR_DA_SERV_TYPE, CR_DA_SERV_SUBTYPE_REP, 0, 0, CR_DA_MASTER, CR_DA_OUT_ADMIT_REP_POLICY,
+	                         &tempMonitoringIssue};
+	CrDaTempReportArg_t arg;
+
+	/* Append the violation to the persistent event log (if selected) */
+	CrDaEventLogWrite(crDaEventLogViolation, appId, chan, temp, 0);
+#if (CR_DA_TEMP_BATCH == 1)
+	/* Add the violation to the pending batch report */
+	return CrDaOutCmpTempBatchAdd(chan, temp, tempMonitoringReported(chan, temp));
+#endif
+	if (appId == CR_DA_SLAVE_1)
+		CR_DA_LOG(crDaLogInfo, "S1: Temperature violation detected -- Sending report to Master Application\n");
+	else
+		CR_DA_LOG(crDaLogInfo, "S2: Temperature violation detected -- Sending report to Master Application\n");
+	/* Create outReport reporting temperature violation (the failure must not be reported for every sample) */
+	arg.temp = temp;
+	arg.chan = chan;
+	return CrDaOutAdmitIssue(&req, &arg, sizeof(arg));
+}
+
+/* ---------------------------------------------------------------------- */
+static void tempMonitoringIssue(FwSmDesc_t rep, CrFwDestSrc_t dest, const void* arg) {
+	const CrDaTempReportArg_t* a = (const CrDaTempReportArg_t*)arg;
+
+	CrDaOutCmpTempViolationSetTemp(a->temp);
+	CrDaOutCmpTempViolationSetNOfSuppressed(tempMonitoringReported(a->chan, a->temp));
+	CrFwOutCmpSetDest(rep,dest);
+	CrFwOutCmpSetGroup(rep,CR_DA_PCKT_GROUP_ROUTINE);
+	/* Request outReport to be sent out */
+	CrFwOutLoaderLoad(rep);
+}
+
+/* ---------------------------------------------------------------------- */
+static uint32_t tempMonitoringCheckWord(const char* temp, const char* limit, unsigned int n) {
+	uint32_t word = 0;
+	unsigned int i = 0;
+#if defined(__aarch64__) && defined(__ARM_NEON) && !defined(__SSE2__)
+	/* The weight of each lane in the violation mask of its half */
+	static const uint8_t laneBit[16] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+	uint8x16_t gt;
+#endif
+
+#if defined(__AVX2__)
+	if (n == 32)
+		return (uint32_t)_mm256_movemask_epi8(_mm256_cmpgt_epi8(_mm256_loadu_si256((const __m256i*)temp),
+		                                                        _mm256_loadu_si256((const __m256i*)limit)));
+#endif
+#if defined(__SSE2__)
+	for (; i+16<=n; i+=16)
+		word |= (uint32_t)_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_loadu_si128((const __m128i*)&temp[i]),
+		                                                   _mm_loadu_si128((const __m128i*)&limit[i]))) << i;
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+	for (; i+16<=n; i+=16) {
+		gt = vandq_u8(vcgtq_s8(vld1q_s8((const int8_t*)&temp[i]), vld1q_s8((const int8_t*)&limit[i])),
+		              vld1q_u8(laneBit));
+		word |= ((uint32_t)vaddv_u8(vget_low_u8(gt)) | ((uint32_t)vaddv_u8(vget_high_u8(gt)) << 8)) << i;
+	}
+#endif
+	/* The channels which do not fill a vector */
+	for (; i<n; i++)
+		if ((signed char)temp[i] > (signed char)limit[i])
+			word |= (uint32_t)1 << i;
+	return word;
 }
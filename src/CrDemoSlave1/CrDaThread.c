@@ -0,0 +1,139 @@
+/**
+ * @file
+ * @ingroup crDemoSlave1
+ * Implementation of the placement of the threads of the demo applications.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include "CrDaThread.h"
+
+/** Type for the placement of a role. */
+typedef struct {
+	/** The name of the role (used in the report). */
+	const char* name;
+	/** The CPU affinity mask. */
+	unsigned long cpus;
+	/** The SCHED_FIFO priority. */
+	int prio;
+	/** The number of threads to which the placement was applied. */
+	unsigned int nOfPlaced;
+	/** The number of threads to which the placement could not be applied. */
+	unsigned int nOfFailed;
+} CrDaThreadPlacement_t;
+
+/** The placement of the roles. */
+static CrDaThreadPlacement_t placement[CR_DA_THREAD_N_OF_ROLES] = {
+	{"cycle", CR_DA_THREAD_CPUS_CYCLE, CR_DA_THREAD_PRIO_CYCLE, 0, 0},
+	{"I/O", CR_DA_THREAD_CPUS_IO, CR_DA_THREAD_PRIO_IO, 0, 0},
+	{"manager pool", CR_DA_THREAD_CPUS_MGR_POOL, CR_DA_THREAD_PRIO_MGR_POOL, 0, 0},
+	{"auxiliary", CR_DA_THREAD_CPUS_AUX, CR_DA_THREAD_PRIO_AUX, 0, 0}
+};
+
+#if (CR_DA_THREAD_PLACEMENT == 1)
+/** Flag which is set if the memory of the process has been locked. */
+static CrFwBool_t isLocked = 0;
+#endif
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaThreadSetPlacement(CrDaThreadRole_t role, unsigned long cpus, int prio) {
+	placement[role].cpus = cpus;
+	placement[role].prio = prio;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaThreadPlace(CrDaThreadRole_t role) {
+#if (CR_DA_THREAD_PLACEMENT == 1)
+	CrDaThreadPlacement_t* p = &placement[role];
+	struct sched_param param;
+	cpu_set_t cpuSet;
+	unsigned int i;
+	int err;
+	CrFwBool_t isPlaced = 1;
+
+	if (p->cpus != 0) {
+		CPU_ZERO(&cpuSet);
+		for (i=0; (i<8*sizeof(p->cpus)) && (i<CPU_SETSIZE); i++)
+			if ((p->cpus & (1UL << i)) != 0)
+				CPU_SET(i, &cpuSet);
+		err = pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet);
+		if (err != 0) {
+			if (__atomic_load_n(&p->nOfFailed, __ATOMIC_RELAXED) == 0)
+				printf("CrDaThreadPlace: affinity 0x%lx of the %s thread: %s\n", p->cpus, p->name, strerror(err));
+			isPlaced = 0;
+		}
+	}
+	if (p->prio != 0) {
+		memset(&param, 0, sizeof(param));
+		param.sched_priority = p->prio;
+		err = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+		if (err != 0) {
+			if (__atomic_load_n(&p->nOfFailed, __ATOMIC_RELAXED) == 0)
+				printf("CrDaThreadPlace: SCHED_FIFO priority %d of the %s thread: %s\n", p->prio, p->name, strerror(err));
+			isPlaced = 0;
+		}
+	}
+	if (isPlaced)
+		__atomic_fetch_add(&p->nOfPlaced, 1, __ATOMIC_RELAXED);
+	else
+		__atomic_fetch_add(&p->nOfFailed, 1, __ATOMIC_RELAXED);
+	return isPlaced;
+#else
+	(void)role;
+	return 1;
+#endif
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaThreadLockMemory() {
+#if (CR_DA_THREAD_PLACEMENT == 1) && (CR_DA_THREAD_MLOCK == 1)
+	if (isLocked)
+		return 1;
+	if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+		perror("CrDaThreadLockMemory, mlockall");
+		return 0;
+	}
+	isLocked = 1;
+#endif
+	return 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaThreadReport(const char* app) {
+#if (CR_DA_THREAD_PLACEMENT == 1)
+	CrDaThreadPlacement_t* p;
+	unsigned int i;
+
+	for (i=0; i<CR_DA_THREAD_N_OF_ROLES; i++) {
+		p = &placement[i];
+		if ((p->nOfPlaced == 0) && (p->nOfFailed == 0))
+			continue;
+		printf("%s: Thread placement %s: CPU mask 0x%lx, %s %d, %u threads placed, %u failed\n", app, p->name,
+		       p->cpus, (p->prio == 0 ? "default policy, priority" : "SCHED_FIFO priority"), p->prio,
+		       p->nOfPlaced, p->nOfFailed);
+	}
+	printf("%s: Thread placement: memory %s\n", app, (isLocked ? "locked" : "not locked"));
+#else
+	(void)app;
+#endif
+}
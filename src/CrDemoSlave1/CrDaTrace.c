@@ -0,0 +1,83 @@
+/**
+ * @file
+ * @ingroup crDemoSlave1
+ * Implementation of the binary event trace of the demo applications of the CORDET Demo.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdio.h>
+#include <time.h>
+#include "CrDaTrace.h"
+#include "CrDaConstants.h"
+
+#if ((CR_DA_TRACE_N_OF_RECS & (CR_DA_TRACE_N_OF_RECS - 1)) != 0)
+#error "CR_DA_TRACE_N_OF_RECS must be a power of two"
+#endif
+
+/** The ring buffer of the trace. */
+static CrDaTraceRec_t traceRing[CR_DA_TRACE_N_OF_RECS];
+
+/** The number of records written since the start (the slot of the next record is this value modulo the size of the ring). */
+static uint64_t traceHead = 0;
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaTraceWrite(CrDaTraceKind_t kind, unsigned int code, unsigned int typeId, unsigned int instanceId,
+                    unsigned int arg0, unsigned int arg1, unsigned int arg2) {
+	CrDaTraceRec_t* rec;
+	struct timespec now;
+
+	rec = &traceRing[__atomic_fetch_add(&traceHead, 1, __ATOMIC_RELAXED) & (CR_DA_TRACE_N_OF_RECS - 1)];
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	rec->time = (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+	rec->instanceId = (uint32_t)instanceId;
+	rec->arg[0] = (uint32_t)arg0;
+	rec->arg[1] = (uint32_t)arg1;
+	rec->arg[2] = (uint32_t)arg2;
+	rec->code = (uint16_t)code;
+	rec->typeId = (uint16_t)typeId;
+	rec->kind = (uint8_t)kind;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+uint64_t CrDaTraceGetNOfWritten() {
+	return __atomic_load_n(&traceHead, __ATOMIC_ACQUIRE);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaTraceDump(const char* app, unsigned int appId) {
+	CrDaTraceHeader_t header;
+	char fileName[64];
+	FILE* file;
+
+	header.nOfWritten = CrDaTraceGetNOfWritten();
+	if (header.nOfWritten == 0)
+		return;
+	header.magic = CR_DA_TRACE_MAGIC;
+	header.version = CR_DA_TRACE_VERSION;
+	header.recSize = sizeof(CrDaTraceRec_t);
+	header.nOfRecs = CR_DA_TRACE_N_OF_RECS;
+	header.appId = appId;
+
+	snprintf(fileName, sizeof(fileName), "CrDaTrace_%s.bin", app);
+	file = fopen(fileName, "wb");
+	if (file == NULL) {
+		perror("CrDaTraceDump()");
+		return;
+	}
+	if ((fwrite(&header, sizeof(header), 1, file) != 1) ||
+	        (fwrite(traceRing, sizeof(CrDaTraceRec_t), CR_DA_TRACE_N_OF_RECS, file) != CR_DA_TRACE_N_OF_RECS))
+		perror("CrDaTraceDump()");
+	fclose(file);
+	printf("%s: Trace: %llu records written to %s\n", app, (unsigned long long)header.nOfWritten, fileName);
+}
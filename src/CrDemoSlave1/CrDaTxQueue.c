@@ -0,0 +1,173 @@
+/**
+ * @file
+ * @ingroup crDemoSlave1
+ * Implementation of the transmit queue for the socket connections.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <string.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include "CrDaTxQueue.h"
+#include "CrDaCrc.h"
+/* Include framework files */
+#include "Pckt/CrFwPckt.h"
+#include "CrFwPcktInline.h"
+#include "CrFwPcktRefCnt.h"
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaTxQueueInit(CrDaTxQueue_t* queue) {
+	queue->head = 0;
+	queue->count = 0;
+	queue->offset = 0;
+	queue->nOfBytes = 0;
+	queue->trailerLength = CR_DA_PCKT_CRC_LENGTH;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaTxQueueSetTrailer(CrDaTxQueue_t* queue, CrFwBool_t isCrc) {
+#if (CR_DA_PCKT_CRC == 1)
+	unsigned int i, j, len = (isCrc ? CR_DA_PCKT_CRC_LENGTH : 0);
+
+	if (len == queue->trailerLength)
+		return;
+	if (len > 0)
+		for (i=0; i<queue->count; i++) {
+			j = (queue->head + i) % CR_DA_TX_QUEUE_NOF_PCKTS;
+			CrDaCrcWrite((unsigned char*)queue->pckt[j], CrFwPcktGetLength(queue->pckt[j]), queue->crc[j]);
+		}
+	queue->nOfBytes = queue->nOfBytes + queue->count*len - queue->count*queue->trailerLength;
+	queue->trailerLength = len;
+#else
+	(void)queue;
+	(void)isCrc;
+#endif
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaTxQueueClear(CrDaTxQueue_t* queue) {
+	while (queue->count > 0) {
+		CrFwPcktRelease(queue->pckt[queue->head]);
+		queue->head = (queue->head + 1) % CR_DA_TX_QUEUE_NOF_PCKTS;
+		queue->count--;
+	}
+	CrDaTxQueueInit(queue);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaTxQueueAdd(CrDaTxQueue_t* queue, CrFwPckt_t pckt) {
+	unsigned int i;
+
+	if (queue->count == CR_DA_TX_QUEUE_NOF_PCKTS)
+		return 0;
+
+	CrFwPcktRetain(pckt);
+	i = (queue->head + queue->count) % CR_DA_TX_QUEUE_NOF_PCKTS;
+	queue->pckt[i] = pckt;
+#if (CR_DA_PCKT_CRC == 1)
+	if (queue->trailerLength > 0)
+		CrDaCrcWrite((unsigned char*)pckt, CrFwPcktGetLength(pckt), queue->crc[i]);
+#endif
+	queue->count++;
+	queue->nOfBytes += CrFwPcktGetLength(pckt) + queue->trailerLength;
+	return 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+int CrDaTxQueueFlush(CrDaTxQueue_t* queue, int fd) {
+	struct iovec iov[CR_DA_TX_QUEUE_NOF_IOV];
+	struct msghdr msg;
+	int n;
+
+	if (queue->count == 0)
+		return 0;
+
+	memset(&msg, 0, sizeof(msg));
+	msg.msg_iov = iov;
+	msg.msg_iovlen = CrDaTxQueueGetIov(queue, iov);
+	n = sendmsg(fd, &msg, MSG_NOSIGNAL);
+	if (n < 0)
+		return -1;
+
+	CrDaTxQueueConsume(queue, (unsigned int)n);
+	return n;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+unsigned int CrDaTxQueueGetIov(CrDaTxQueue_t* queue, struct iovec* iov) {
+	unsigned int i, j, len, n = 0;
+	unsigned int skip = queue->offset;
+
+	/* Gather the queued packets (the first one may have been partially written) */
+	for (i=0; i<queue->count; i++) {
+		j = (queue->head + i) % CR_DA_TX_QUEUE_NOF_PCKTS;
+		len = CrFwPcktGetLength(queue->pckt[j]);
+		if (skip < len) {
+			iov[n].iov_base = (char*)queue->pckt[j] + skip;
+			iov[n].iov_len = len - skip;
+			n++;
+			skip = 0;
+		} else {
+			skip = skip - len;
+		}
+#if (CR_DA_PCKT_CRC == 1)
+		if (queue->trailerLength > 0) {
+			iov[n].iov_base = queue->crc[j] + skip;
+			iov[n].iov_len = CR_DA_PCKT_CRC_LENGTH - skip;
+			n++;
+			skip = 0;
+		}
+#endif
+	}
+	return n;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaTxQueueConsume(CrDaTxQueue_t* queue, unsigned int n) {
+	unsigned int len;
+
+	queue->nOfBytes = (n < queue->nOfBytes) ? (queue->nOfBytes - n) : 0;
+	/* Release the packets which have been completely written */
+	while ((queue->count > 0) && (n > 0)) {
+		len = CrFwPcktGetLength(queue->pckt[queue->head]) + queue->trailerLength - queue->offset;
+		if (n < len) {
+			queue->offset = queue->offset + n;
+			break;
+		}
+		n = n - len;
+		CrFwPcktRelease(queue->pckt[queue->head]);
+		queue->head = (queue->head + 1) % CR_DA_TX_QUEUE_NOF_PCKTS;
+		queue->count--;
+		queue->offset = 0;
+	}
+	if (queue->count == 0)
+		queue->head = 0;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaTxQueueRewind(CrDaTxQueue_t* queue) {
+	queue->nOfBytes = queue->nOfBytes + queue->offset;
+	queue->offset = 0;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+unsigned int CrDaTxQueueGetNOfBytes(CrDaTxQueue_t* queue) {
+	return queue->nOfBytes;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaTxQueueIsEmpty(CrDaTxQueue_t* queue) {
+	return (queue->count == 0);
+}
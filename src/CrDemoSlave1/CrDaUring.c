@@ -0,0 +1,338 @@
+/**
+ * @file
+ * @ingroup crDemoSlave1
+ * Implementation of the minimal interface to an io_uring instance.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include "CrDaConstants.h"
+
+/* The module is only built if the io_uring backend is selected (it needs the Linux io_uring headers) */
+#if (CR_DA_SOCKET_URING == 1)
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include "CrDaUring.h"
+
+/** The identifier of the group of provided buffers */
+#define CR_DA_URING_BUF_GROUP 0
+
+/**
+ * Map the submission and completion queues of an io_uring instance.
+ * @param ring the io_uring instance
+ * @param p the parameters returned by the creation of the io_uring instance
+ * @return 1 if the queues were mapped; 0 otherwise
+ */
+static CrFwBool_t uringMap(CrDaUring_t* ring, struct io_uring_params* p);
+
+/**
+ * Create the ring of provided buffers of an io_uring instance, register it with the
+ * kernel and give all buffers to the kernel.
+ * @param ring the io_uring instance
+ * @param nOfBufs the number of provided buffers
+ * @param bufSize the size in bytes of each provided buffer
+ * @return 1 if the ring of provided buffers was registered; 0 otherwise
+ */
+static CrFwBool_t uringRegisterBufs(CrDaUring_t* ring, unsigned int nOfBufs, unsigned int bufSize);
+
+/**
+ * Return a cleared entry of the submission queue.
+ * The entry is only handed over to the kernel when <code>::uringPushSqe</code> is called.
+ * @param ring the io_uring instance
+ * @return the entry or NULL if the submission queue is full
+ */
+static struct io_uring_sqe* uringGetSqe(CrDaUring_t* ring);
+
+/**
+ * Make the entry returned by the last call to <code>::uringGetSqe</code> visible to the kernel.
+ * @param ring the io_uring instance
+ */
+static void uringPushSqe(CrDaUring_t* ring);
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaUringInit(CrDaUring_t* ring, unsigned int nOfEntries, unsigned int nOfBufs,
+                         unsigned int bufSize) {
+	struct io_uring_params p;
+	int err;
+
+	memset(ring, 0, sizeof(CrDaUring_t));
+	memset(&p, 0, sizeof(p));
+	ring->fd = (int)syscall(__NR_io_uring_setup, nOfEntries, &p);
+	if (ring->fd < 0)
+		return 0;
+	if ((p.features & IORING_FEAT_EXT_ARG) == 0) {	/* the timeout of the wait is not supported */
+		CrDaUringFree(ring);
+		errno = ENOSYS;
+		return 0;
+	}
+
+	if (!uringMap(ring, &p) || !uringRegisterBufs(ring, nOfBufs, bufSize)) {
+		err = errno;
+		CrDaUringFree(ring);
+		errno = err;
+		return 0;
+	}
+	return 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static CrFwBool_t uringMap(CrDaUring_t* ring, struct io_uring_params* p) {
+	unsigned int* sqArray;
+	unsigned int i;
+
+	/* Map the submission and completion queues (a single mapping on recent kernels) */
+	ring->sqRingSize = p->sq_off.array + p->sq_entries*sizeof(unsigned int);
+	ring->cqRingSize = p->cq_off.cqes + p->cq_entries*sizeof(struct io_uring_cqe);
+	if ((p->features & IORING_FEAT_SINGLE_MMAP) != 0) {
+		if (ring->cqRingSize > ring->sqRingSize)
+			ring->sqRingSize = ring->cqRingSize;
+		ring->cqRingSize = 0;
+	}
+	ring->sqRing = mmap(NULL, ring->sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+	                    ring->fd, IORING_OFF_SQ_RING);
+	if (ring->sqRing == MAP_FAILED) {
+		ring->sqRing = NULL;
+		return 0;
+	}
+	if (ring->cqRingSize == 0)
+		ring->cqRing = ring->sqRing;
+	else {
+		ring->cqRing = mmap(NULL, ring->cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+		                    ring->fd, IORING_OFF_CQ_RING);
+		if (ring->cqRing == MAP_FAILED) {
+			ring->cqRing = NULL;
+			return 0;
+		}
+	}
+	ring->sqesSize = p->sq_entries*sizeof(struct io_uring_sqe);
+	ring->sqes = mmap(NULL, ring->sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+	                  ring->fd, IORING_OFF_SQES);
+	if (ring->sqes == MAP_FAILED) {
+		ring->sqes = NULL;
+		return 0;
+	}
+
+	ring->sqHead = (unsigned int*)((char*)ring->sqRing + p->sq_off.head);
+	ring->sqTail = (unsigned int*)((char*)ring->sqRing + p->sq_off.tail);
+	ring->sqFlags = (unsigned int*)((char*)ring->sqRing + p->sq_off.flags);
+	ring->sqMask = *(unsigned int*)((char*)ring->sqRing + p->sq_off.ring_mask);
+	ring->cqHead = (unsigned int*)((char*)ring->cqRing + p->cq_off.head);
+	ring->cqTail = (unsigned int*)((char*)ring->cqRing + p->cq_off.tail);
+	ring->cqMask = *(unsigned int*)((char*)ring->cqRing + p->cq_off.ring_mask);
+	ring->cqes = (struct io_uring_cqe*)((char*)ring->cqRing + p->cq_off.cqes);
+
+	/* The i-th slot of the submission queue always holds the i-th entry */
+	sqArray = (unsigned int*)((char*)ring->sqRing + p->sq_off.array);
+	for (i=0; i<p->sq_entries; i++)
+		sqArray[i] = i;
+	return 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static CrFwBool_t uringRegisterBufs(CrDaUring_t* ring, unsigned int nOfBufs, unsigned int bufSize) {
+	struct io_uring_buf_reg reg;
+	unsigned int i;
+
+	ring->nOfBufs = nOfBufs;
+	ring->bufSize = bufSize;
+	ring->bufs = malloc(nOfBufs*bufSize);
+	if (ring->bufs == NULL)
+		return 0;
+	ring->bufRingSize = nOfBufs*sizeof(struct io_uring_buf);
+	ring->bufRing = mmap(NULL, ring->bufRingSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (ring->bufRing == MAP_FAILED) {
+		ring->bufRing = NULL;
+		return 0;
+	}
+
+	memset(&reg, 0, sizeof(reg));
+	reg.ring_addr = (uint64_t)(uintptr_t)ring->bufRing;
+	reg.ring_entries = nOfBufs;
+	reg.bgid = CR_DA_URING_BUF_GROUP;
+	if (syscall(__NR_io_uring_register, ring->fd, IORING_REGISTER_PBUF_RING, &reg, 1) < 0)
+		return 0;
+	for (i=0; i<nOfBufs; i++)
+		CrDaUringPutBuf(ring, i);
+	return 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaUringFree(CrDaUring_t* ring) {
+	if (ring->fd >= 0)
+		close(ring->fd);
+	ring->fd = -1;
+	if (ring->bufRing != NULL)
+		munmap(ring->bufRing, ring->bufRingSize);
+	ring->bufRing = NULL;
+	free(ring->bufs);
+	ring->bufs = NULL;
+	if (ring->sqes != NULL)
+		munmap(ring->sqes, ring->sqesSize);
+	ring->sqes = NULL;
+	if ((ring->cqRing != NULL) && (ring->cqRing != ring->sqRing))
+		munmap(ring->cqRing, ring->cqRingSize);
+	ring->cqRing = NULL;
+	if (ring->sqRing != NULL)
+		munmap(ring->sqRing, ring->sqRingSize);
+	ring->sqRing = NULL;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaUringPrepAccept(CrDaUring_t* ring, int fd, uint64_t userData) {
+	struct io_uring_sqe* sqe = uringGetSqe(ring);
+
+	if (sqe == NULL)
+		return 0;
+	sqe->opcode = IORING_OP_ACCEPT;
+	sqe->fd = fd;
+	sqe->ioprio = IORING_ACCEPT_MULTISHOT;
+	sqe->user_data = userData;
+	uringPushSqe(ring);
+	return 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaUringPrepRecv(CrDaUring_t* ring, int fd, uint64_t userData) {
+	struct io_uring_sqe* sqe = uringGetSqe(ring);
+
+	if (sqe == NULL)
+		return 0;
+	sqe->opcode = IORING_OP_RECV;
+	sqe->fd = fd;
+	sqe->ioprio = IORING_RECV_MULTISHOT;
+	sqe->flags = IOSQE_BUFFER_SELECT;
+	sqe->buf_group = CR_DA_URING_BUF_GROUP;
+	sqe->user_data = userData;
+	uringPushSqe(ring);
+	return 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaUringPrepSendmsg(CrDaUring_t* ring, int fd, struct msghdr* msg, uint64_t userData) {
+	struct io_uring_sqe* sqe = uringGetSqe(ring);
+
+	if (sqe == NULL)
+		return 0;
+	sqe->opcode = IORING_OP_SENDMSG;
+	sqe->fd = fd;
+	sqe->addr = (uint64_t)(uintptr_t)msg;
+	sqe->len = 1;
+	sqe->msg_flags = MSG_NOSIGNAL;
+	sqe->user_data = userData;
+	uringPushSqe(ring);
+	return 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaUringPrepCancel(CrDaUring_t* ring, int fd, uint64_t userData) {
+	struct io_uring_sqe* sqe = uringGetSqe(ring);
+
+	if (sqe == NULL)
+		return 0;
+	sqe->opcode = IORING_OP_ASYNC_CANCEL;
+	sqe->fd = fd;
+	sqe->cancel_flags = IORING_ASYNC_CANCEL_FD | IORING_ASYNC_CANCEL_ALL;
+	sqe->user_data = userData;
+	uringPushSqe(ring);
+	return 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+int CrDaUringEnter(CrDaUring_t* ring, unsigned int minComplete, int timeout) {
+	struct io_uring_getevents_arg arg;
+	struct __kernel_timespec ts;
+	unsigned int toSubmit, flags = 0;
+	int n;
+
+	toSubmit = *ring->sqTail - __atomic_load_n(ring->sqHead, __ATOMIC_ACQUIRE);
+	memset(&arg, 0, sizeof(arg));
+	if ((timeout > 0) && (minComplete > 0)) {
+		ts.tv_sec = timeout/1000;
+		ts.tv_nsec = (long long)(timeout%1000)*1000000LL;
+		arg.sigmask_sz = _NSIG/8;
+		arg.ts = (uint64_t)(uintptr_t)&ts;
+		flags = IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG;
+	} else {
+		minComplete = 0;
+		if ((__atomic_load_n(ring->sqFlags, __ATOMIC_RELAXED) & IORING_SQ_CQ_OVERFLOW) != 0)
+			flags = IORING_ENTER_GETEVENTS;	/* move the completions held by the kernel into the queue */
+		else if (toSubmit == 0)
+			return 0;
+	}
+
+	n = (int)syscall(__NR_io_uring_enter, ring->fd, toSubmit, minComplete, flags,
+	                 ((flags & IORING_ENTER_EXT_ARG) != 0) ? &arg : NULL, sizeof(arg));
+	if (n < 0) {
+		/* The timeout has expired, a signal has arrived, or the completion queue is full */
+		if ((errno == ETIME) || (errno == EINTR) || (errno == EAGAIN) || (errno == EBUSY))
+			return 0;
+		return -1;
+	}
+	return n;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+struct io_uring_cqe* CrDaUringPeekCqe(CrDaUring_t* ring) {
+	unsigned int head = *ring->cqHead;
+
+	if (head == __atomic_load_n(ring->cqTail, __ATOMIC_ACQUIRE))
+		return NULL;
+	return &ring->cqes[head & ring->cqMask];
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaUringCqeSeen(CrDaUring_t* ring) {
+	__atomic_store_n(ring->cqHead, *ring->cqHead + 1, __ATOMIC_RELEASE);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+unsigned char* CrDaUringGetBuf(CrDaUring_t* ring, unsigned int bid) {
+	return ring->bufs + bid*ring->bufSize;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaUringPutBuf(CrDaUring_t* ring, unsigned int bid) {
+	struct io_uring_buf* buf = &ring->bufRing->bufs[ring->bufTail & (ring->nOfBufs - 1)];
+
+	/* The tail of the ring overlays a reserved field of the first buffer which is therefore not written */
+	buf->addr = (uint64_t)(uintptr_t)CrDaUringGetBuf(ring, bid);
+	buf->len = ring->bufSize;
+	buf->bid = (unsigned short)bid;
+	ring->bufTail++;
+	__atomic_store_n(&ring->bufRing->tail, ring->bufTail, __ATOMIC_RELEASE);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static struct io_uring_sqe* uringGetSqe(CrDaUring_t* ring) {
+	struct io_uring_sqe* sqe;
+	unsigned int tail = *ring->sqTail;
+
+	if (tail - __atomic_load_n(ring->sqHead, __ATOMIC_ACQUIRE) > ring->sqMask)
+		return NULL;
+	sqe = &ring->sqes[tail & ring->sqMask];
+	memset(sqe, 0, sizeof(struct io_uring_sqe));
+	return sqe;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void uringPushSqe(CrDaUring_t* ring) {
+	__atomic_store_n(ring->sqTail, *ring->sqTail + 1, __ATOMIC_RELEASE);
+}
+
+#endif
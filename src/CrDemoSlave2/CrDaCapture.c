@@ -0,0 +1,167 @@
+/**
+ * @file
+ * @ingroup crDemoSlave2
+ * Implementation of the packet capture of the demo applications of the CORDET Demo.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE	/* for mremap */
+#endif
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <time.h>
+#include <sys/mman.h>
+#include "CrDaCapture.h"
+/* Include framework files */
+#include "Pckt/CrFwPckt.h"
+/* Include configuration files */
+#include "CrFwPcktInline.h"
+
+/** The mapping of the capture file (NULL if the capture is not running). */
+static unsigned char* capBase = NULL;
+
+/** The size of the mapping of the capture file. */
+static size_t capSize = 0;
+
+/** The offset of the next record in the capture file. */
+static size_t capPos = 0;
+
+/** The number of records written. */
+static uint64_t capNOfRecs = 0;
+
+/** The file descriptor of the capture file. */
+static int capFd = -1;
+
+/** The time of the start of the capture. */
+static struct timespec capStart;
+
+/**
+ * Append a record to the capture file.
+ * The capture is stopped if the capture file cannot be extended.
+ * @param dir the direction of the packet
+ * @param pckt the packet
+ */
+static void captureWrite(CrDaCaptureDir_t dir, CrFwPckt_t pckt);
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaCaptureStart(const char* app, unsigned int appId) {
+#if (CR_DA_CAPTURE == 1)
+	CrDaCaptureHeader_t* header;
+	char fileName[64];
+	void* p;
+
+	if (capBase != NULL)
+		return 0;
+
+	snprintf(fileName, sizeof(fileName), "CrDaCapture_%s.cap", app);
+	capFd = open(fileName, O_RDWR | O_CREAT | O_TRUNC, 0644);
+	if (capFd < 0) {
+		perror("CrDaCaptureStart, Capture file creation");
+		return 0;
+	}
+	if (ftruncate(capFd, (off_t)CR_DA_CAPTURE_CHUNK_SIZE) < 0) {
+		perror("CrDaCaptureStart, Capture file sizing");
+		close(capFd);
+		capFd = -1;
+		return 0;
+	}
+	p = mmap(NULL, CR_DA_CAPTURE_CHUNK_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, capFd, 0);
+	if (p == MAP_FAILED) {
+		perror("CrDaCaptureStart, Capture file mapping");
+		close(capFd);
+		capFd = -1;
+		return 0;
+	}
+
+	/* The file is zero-filled: the unused part of the mapping ends the capture */
+	capBase = (unsigned char*)p;
+	capSize = CR_DA_CAPTURE_CHUNK_SIZE;
+	capPos = sizeof(CrDaCaptureHeader_t);
+	capNOfRecs = 0;
+	header = (CrDaCaptureHeader_t*)capBase;
+	header->magic = CR_DA_CAPTURE_MAGIC;
+	header->version = CR_DA_CAPTURE_VERSION;
+	header->appId = (uint16_t)appId;
+	header->nOfRecs = 0;
+	clock_gettime(CLOCK_MONOTONIC, &capStart);
+	printf("%s: Capturing packets to %s\n", app, fileName);
+	return 1;
+#else
+	(void)app;
+	(void)appId;
+	return 0;
+#endif
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaCaptureRx(CrFwPckt_t pckt) {
+	if (capBase != NULL)
+		captureWrite(crDaCaptureRx, pckt);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaCaptureTx(CrFwPckt_t pckt) {
+	if (capBase != NULL)
+		captureWrite(crDaCaptureTx, pckt);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaCaptureStop() {
+	if (capBase == NULL)
+		return;
+
+	((CrDaCaptureHeader_t*)capBase)->nOfRecs = capNOfRecs;
+	munmap(capBase, capSize);
+	capBase = NULL;
+	if (ftruncate(capFd, (off_t)capPos) < 0)
+		perror("CrDaCaptureStop, Capture file truncation");
+	close(capFd);
+	capFd = -1;
+	printf("Capture: %llu packets captured\n", (unsigned long long)capNOfRecs);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void captureWrite(CrDaCaptureDir_t dir, CrFwPckt_t pckt) {
+	unsigned int len = CrFwPcktGetLength(pckt);
+	size_t recSize = sizeof(CrDaCaptureRec_t) + ((len + 7) & ~7u);
+	CrDaCaptureRec_t* rec;
+	struct timespec now;
+	void* p;
+
+	/* Keep room for the record of length zero which ends the capture */
+	if (capPos + recSize + sizeof(CrDaCaptureRec_t) > capSize) {
+		if ((ftruncate(capFd, (off_t)(capSize + CR_DA_CAPTURE_CHUNK_SIZE)) < 0) ||
+		        ((p = mremap(capBase, capSize, capSize + CR_DA_CAPTURE_CHUNK_SIZE, MREMAP_MAYMOVE)) == MAP_FAILED)) {
+			perror("CrDaCapture, Capture file extension");
+			CrDaCaptureStop();
+			return;
+		}
+		capBase = (unsigned char*)p;
+		capSize = capSize + CR_DA_CAPTURE_CHUNK_SIZE;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	rec = (CrDaCaptureRec_t*)(capBase + capPos);
+	rec->time = (uint64_t)(now.tv_sec - capStart.tv_sec) * 1000000000ULL + (uint64_t)now.tv_nsec -
+	            (uint64_t)capStart.tv_nsec;
+	rec->len = len;
+	rec->dir = (uint8_t)dir;
+	memcpy(capBase + capPos + sizeof(CrDaCaptureRec_t), pckt, len);
+	capPos = capPos + recSize;
+	capNOfRecs++;
+}
@@ -0,0 +1,139 @@
+/**
+ * @file
+ * @ingroup crDemoSlave2
+ * Interface for the runtime configuration of the demo applications of the CORDET Demo.
+ * The sizes and the tables of the demo applications are compile-time constants of the
+ * configuration files (<code>CrFwUserConstants.h</code> and the <code>*UserPar.h</code>
+ * files) and a change of one of them requires the rebuild of the applications.
+ *
+ * If the runtime configuration is selected (see <code>#CR_DA_RUNTIME_CONFIG</code>), an
+ * application loads a configuration file at start-up (<code>::CrDaConfigLoad</code>)
+ * whose entries override the compile-time values of the parameters which it holds:
+ * - The number of packets of each size class of the packet pool
+ *   (<code>::crDaConfigNOfPckts</code>, see <code>::CrFwPcktArenaConfigure</code>).
+ * - The reserved quotas of the InStream and OutStream partitions of the packet pool
+ *   (<code>::crDaConfigInStreamQuota</code> and <code>::crDaConfigOutStreamQuota</code>,
+ *   see <code>CrFwPcktPart.h</code>).
+ * - The budgets of the slots of the cycle frame (<code>::crDaConfigFrameBudget</code>,
+ *   see <code>CrDaFrame.h</code>).
+ * .
+ * The compile-time values remain the defaults of the parameters and the storage of the
+ * applications is still sized by them: a configuration file may shrink the packet pool
+ * but it cannot make it larger than the packet array.
+ * The sizes and the tables which are held by the framework components (e.g. the sizes of
+ * the packet queues of the OutStreams, the size of the OutRegistry and the kind
+ * descriptors of the factories) are used to initialize the storage of the framework
+ * and they are not covered by the runtime configuration.
+ *
+ * The configuration file is <code>CrDaConfig_&lt;app&gt;.cfg</code> in the working
+ * directory or the file named by the environment variable <code>CR_DA_CONFIG_FILE</code>.
+ * It is a binary file in the byte order of the host which is mapped into memory when it
+ * is loaded: a header (<code>::CrDaConfigHeader_t</code>) is followed by its entries
+ * (<code>::CrDaConfigEntry_t</code>), each of which sets one element of one table.
+ * The file is rejected if its header or its length is invalid, if the CRC-32C of its
+ * entries (see <code>::CrDaCrc32c</code>) does not match the header, if it is meant for
+ * another application or if an entry has an unknown table or an element outside its
+ * table.
+ * The consistency of the values (e.g. the sum of the quotas against the number of packets
+ * of the pool) is checked by the components which use them.
+ * A missing default file is not an error: the compile-time values are used.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRDA_CONFIG_H_
+#define CRDA_CONFIG_H_
+
+#include <stdint.h>
+/* Include Framework Files */
+#include "CrFwConstants.h"
+/* Include Configuration Files */
+#include "CrFwUserConstants.h"
+#include "CrDaConstants.h"
+
+/** The identifier of the configuration files ("CRCF"). */
+#define CR_DA_CONFIG_MAGIC 0x43524346
+
+/** The version of the format of the configuration files. */
+#define CR_DA_CONFIG_VERSION 1
+
+/** The tables of the runtime configuration. */
+typedef enum {
+	/** The number of packets of a size class of the packet pool (element: the size class). */
+	crDaConfigNOfPckts = 1,
+	/** The reserved quota of an InStream partition (element: the InStream). */
+	crDaConfigInStreamQuota = 2,
+	/** The reserved quota of an OutStream partition (element: the OutStream). */
+	crDaConfigOutStreamQuota = 3,
+	/** The budget in microseconds of a slot of the cycle frame (element: the slot). */
+	crDaConfigFrameBudget = 4
+} CrDaConfigTable_t;
+
+/** The number of tables of the runtime configuration (the tables are numbered from 1). */
+#define CR_DA_CONFIG_N_OF_TABLES 4
+
+/** The header of a configuration file. */
+typedef struct {
+	/** The identifier of the configuration files (<code>#CR_DA_CONFIG_MAGIC</code>). */
+	uint32_t magic;
+	/** The version of the format (<code>#CR_DA_CONFIG_VERSION</code>). */
+	uint16_t version;
+	/** The identifier of the application for which the file is meant (0 for any application). */
+	uint16_t appId;
+	/** The number of entries of the file. */
+	uint32_t nOfEntries;
+	/** The CRC-32C of the entries of the file. */
+	uint32_t crc;
+} CrDaConfigHeader_t;
+
+/** An entry of a configuration file. */
+typedef struct {
+	/** The table of the entry (see <code>::CrDaConfigTable_t</code>). */
+	uint16_t table;
+	/** The element of the table which the entry sets. */
+	uint16_t index;
+	/** The value of the element. */
+	uint32_t value;
+} CrDaConfigEntry_t;
+
+/**
+ * Load the configuration file of an application.
+ * If the file is valid, its entries replace those of the configuration which was
+ * previously loaded.
+ * This function must be called at start-up before the components which use the runtime
+ * configuration are configured.
+ * Nothing is done if the runtime configuration is not selected.
+ * @param app the name of the application (e.g. "MA")
+ * @param appId the identifier of the application
+ * @return 1 if the file was loaded or if there is no default file; 0 if the file is
+ * invalid or if the file named by <code>CR_DA_CONFIG_FILE</code> cannot be read
+ */
+CrFwBool_t CrDaConfigLoad(const char* app, unsigned int appId);
+
+/**
+ * Get the value of an element of a table of the runtime configuration.
+ * @param table the table
+ * @param index the element of the table
+ * @param def the compile-time value of the element
+ * @return the value of the last entry of the configuration file which sets the element
+ * or the compile-time value if there is none
+ */
+unsigned long CrDaConfigGet(CrDaConfigTable_t table, unsigned int index, unsigned long def);
+
+/**
+ * Get the number of entries of the runtime configuration.
+ * @return the number of entries (0 if no configuration file has been loaded)
+ */
+unsigned int CrDaConfigGetNOfEntries();
+
+#endif /* CRDA_CONFIG_H_ */
@@ -0,0 +1,155 @@
+/**
+ * @file
+ * @ingroup crDemoSlave2
+ * Interface for the persistent event log of the demo applications of the CORDET Demo.
+ * If the event log is selected (see <code>#CR_DA_EVENT_LOG</code>), the events of an
+ * application (the temperature violations which a Slave Application detects and those
+ * which the Master Application receives) are appended to a log on disk
+ * (<code>::CrDaEventLogWrite</code>).
+ *
+ * The log is a sequence of files <code>CrDaEventLog_<app>_<k>.bin</code> of
+ * <code>#CR_DA_EVENT_LOG_N_OF_RECS</code> fixed-size records each.
+ * When a file is full, the log moves to the next one and, after the last of the
+ * <code>#CR_DA_EVENT_LOG_N_OF_FILES</code> files, it starts again with the first one
+ * (which then holds the newest records): the log holds at least the last
+ * <code>(#CR_DA_EVENT_LOG_N_OF_FILES-1)*#CR_DA_EVENT_LOG_N_OF_RECS</code> records.
+ * Each file starts with a header (<code>::CrDaEventLogHeader_t</code>) which is followed
+ * by its records (<code>::CrDaEventLogRec_t</code>).
+ * A record whose kind is zero is unused: the files are zero-filled when they are created
+ * and the kind is the last field of a record to be written.
+ *
+ * The files are written through shared memory mappings: writing a record reserves its
+ * slot with an atomic increment and then fills it with plain stores; it takes no lock and
+ * makes no system call (the time stamp is read from the real-time clock which, on Linux,
+ * is read without a system call).
+ * The records may therefore be written concurrently by the thread of the cycle scheduler,
+ * by the I/O thread and by the threads of the manager pool.
+ * The formatting of the records is left to the tools which read the files.
+ *
+ * The system calls are made by a flush thread which runs every
+ * <code>#CR_DA_EVENT_LOG_PERIOD</code> milliseconds: it synchronizes the mapped files
+ * with the disk (<code>msync</code>) and, when a file is full, it unmaps it and maps the
+ * file after the next one.
+ * The current file and the next one are always mapped so that the writers never wait for
+ * a file to be created.
+ * A record is lost (and counted) if the writers fill the next file before the flush
+ * thread has mapped it, i.e. if more than <code>#CR_DA_EVENT_LOG_N_OF_RECS</code> records
+ * are written within one period.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRDA_EVENTLOG_H_
+#define CRDA_EVENTLOG_H_
+
+#include <stdint.h>
+/* Include Framework Files */
+#include "CrFwConstants.h"
+/* Include Configuration Files */
+#include "CrFwUserConstants.h"
+#include "CrDaConstants.h"
+
+/** The magic number at the start of an event log file ("CREL"). */
+#define CR_DA_EVENT_LOG_MAGIC 0x4352454C
+
+/** The version of the format of the event log files. */
+#define CR_DA_EVENT_LOG_VERSION 1
+
+/**
+ * The kinds of event log records.
+ * The value zero is reserved for the unused records.
+ */
+typedef enum {
+	/** A temperature violation detected by the temperature monitoring of a Slave Application
+	 * (the source is the Slave Application and the argument is zero). */
+	crDaEventLogViolation = 1,
+	/** A temperature violation received by the Master Application (the source is the Slave
+	 * Application and the argument is the sequence counter of the report). */
+	crDaEventLogViolationRep = 2
+} CrDaEventLogKind_t;
+
+/** An event log record (32 bytes). */
+typedef struct {
+	/** The time of the record in nanoseconds of the real-time clock. */
+	uint64_t time;
+	/** The number of the record since the start of the log. */
+	uint64_t seqNo;
+	/** The argument (its meaning depends on the kind of the record). */
+	uint32_t arg;
+	/** The application identifier of the source of the event. */
+	uint16_t src;
+	/** The channel. */
+	uint16_t chan;
+	/** The temperature. */
+	int8_t temp;
+	/** Unused. */
+	uint8_t spare[5];
+	/** The kind of the record (a <code>::CrDaEventLogKind_t</code> or zero if the record is unused). */
+	uint16_t kind;
+} CrDaEventLogRec_t;
+
+/** The header of an event log file (32 bytes). */
+typedef struct {
+	/** The magic number <code>#CR_DA_EVENT_LOG_MAGIC</code>. */
+	uint32_t magic;
+	/** The version <code>#CR_DA_EVENT_LOG_VERSION</code> of the format. */
+	uint16_t version;
+	/** The size of a record in bytes. */
+	uint16_t recSize;
+	/** The number of records of the file. */
+	uint32_t nOfRecs;
+	/** The identifier of the application which wrote the file. */
+	uint16_t appId;
+	/** Unused. */
+	uint16_t spare;
+	/** The number of the first record of the file since the start of the log. */
+	uint64_t firstSeqNo;
+	/** The number of records of the file which had been used when the file was last synchronized. */
+	uint64_t nOfUsed;
+} CrDaEventLogHeader_t;
+
+/**
+ * Start the event log: create and map the first two files and start the flush thread.
+ * Nothing is done if the event log is not selected.
+ * @param app the name of the application (e.g. "MA")
+ * @param appId the identifier of the application
+ * @return 1 if the event log was started; 0 otherwise
+ */
+CrFwBool_t CrDaEventLogStart(const char* app, unsigned int appId);
+
+/**
+ * Append a record to the event log.
+ * Nothing is done if the event log is not selected or has not been started.
+ * @param kind the kind of the record
+ * @param src the application identifier of the source of the event
+ * @param chan the channel
+ * @param temp the temperature
+ * @param arg the argument
+ */
+void CrDaEventLogWrite(CrDaEventLogKind_t kind, unsigned int src, unsigned int chan, char temp, unsigned int arg);
+
+/**
+ * Stop the event log: stop the flush thread and synchronize and unmap the files.
+ * This function must only be called when no more records are being written.
+ */
+void CrDaEventLogStop();
+
+/**
+ * Print the number of records written to the event log, the number of files which they
+ * fill and the number of records which were lost.
+ * Nothing is printed if no record was written.
+ * @param app the prefix of the printed lines (e.g. "MA")
+ */
+void CrDaEventLogReport(const char* app);
+
+#endif /* CRDA_EVENTLOG_H_ */
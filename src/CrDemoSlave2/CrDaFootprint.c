@@ -0,0 +1,147 @@
+/**
+ * @file
+ * @ingroup crDemoSlave2
+ * Implementation of the memory footprint report of the demo applications.
+ * The heap in use is taken from the statistics of the allocator of the C library.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdio.h>
+#include <stddef.h>
+#include <malloc.h>
+#include "CrDaFootprint.h"
+/* Include configuration files */
+#include "CrFwCmpData.h"
+#include "CrFwInFactoryUserPar.h"
+#include "CrFwInManagerUserPar.h"
+#include "CrFwInRegistryUserPar.h"
+#include "CrFwInStreamUserPar.h"
+#include "CrFwOutFactoryUserPar.h"
+#include "CrFwOutManagerUserPar.h"
+#include "CrFwOutRegistryUserPar.h"
+#include "CrFwOutStreamUserPar.h"
+/* Include FW Profile files */
+#include "FwSmConstants.h"
+
+#if (CR_DA_FOOTPRINT == 1)
+/** The sizes of the PCRLs of the InManagers. */
+static const CrFwCounterU1_t pcrlSize[CR_FW_NOF_INMANAGER] = CR_FW_INMANAGER_PCRLSIZE;
+
+/** The sizes of the POCLs of the OutManagers. */
+static const CrFwCounterU1_t poclSize[CR_FW_NOF_OUTMANAGER] = CR_FW_OUTMANAGER_POCLSIZE;
+
+/** The sizes of the packet queues of the InStreams. */
+static const CrFwCounterU1_t inStreamPqSize[CR_FW_NOF_INSTREAM] = CR_FW_INSTREAM_PQSIZE;
+
+/** The sizes of the packet queues of the OutStreams. */
+static const CrFwCounterU1_t outStreamPqSize[CR_FW_NOF_OUTSTREAM] = CR_FW_OUTSTREAM_PQSIZE;
+
+/** The heap in use when <code>::CrDaFootprintStart</code> was called. */
+static size_t heapAtStart = 0;
+
+/** The heap in use when <code>::CrDaFootprintStop</code> was called. */
+static size_t heapAtStop = 0;
+
+/**
+ * Return the number of bytes of the heap which are in use.
+ * @return the number of bytes of the heap which are in use
+ */
+static size_t heapInUse();
+
+/**
+ * Return the sum of the sizes of a list of PCRLs, POCLs or packet queues.
+ * @param size the sizes
+ * @param n the number of sizes
+ * @return the sum of the sizes
+ */
+static unsigned int sizeSum(const CrFwCounterU1_t* size, unsigned int n);
+#endif
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaFootprintStart() {
+#if (CR_DA_FOOTPRINT == 1)
+	heapAtStart = heapInUse();
+	heapAtStop = heapAtStart;
+#endif
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaFootprintStop() {
+#if (CR_DA_FOOTPRINT == 1)
+	heapAtStop = heapInUse();
+#endif
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaFootprintReport(const char* app) {
+#if (CR_DA_FOOTPRINT == 1)
+	unsigned int nOfPcrl = sizeSum(pcrlSize, CR_FW_NOF_INMANAGER);
+	unsigned int nOfPocl = sizeSum(poclSize, CR_FW_NOF_OUTMANAGER);
+	unsigned int nOfInPq = sizeSum(inStreamPqSize, CR_FW_NOF_INSTREAM);
+	unsigned int nOfOutPq = sizeSum(outStreamPqSize, CR_FW_NOF_OUTSTREAM);
+	size_t pcktPool = (size_t)CR_FW_SMALL_PCKT_LENGTH*CR_FW_NOF_SMALL_PCKTS +
+	                  (size_t)CR_FW_MEDIUM_PCKT_LENGTH*CR_FW_NOF_MEDIUM_PCKTS +
+	                  (size_t)CR_FW_LARGE_PCKT_LENGTH*CR_FW_NOF_LARGE_PCKTS;
+	size_t inFactory = CR_FW_INFACTORY_MAX_NOF_INCMD*(sizeof(CrFwCmpData_t)+sizeof(CrFwInCmdData_t)) +
+	                   CR_FW_INFACTORY_MAX_NOF_INREP*(sizeof(CrFwCmpData_t)+sizeof(CrFwInRepData_t));
+	size_t outFactory = CR_FW_OUTFACTORY_MAX_NOF_OUTCMP*(sizeof(CrFwCmpData_t)+sizeof(CrFwOutCmpData_t));
+	/* A registry entry holds the identifier of a command or report and its state */
+	size_t registryEntry = sizeof(CrFwInstanceId_t)+sizeof(int);
+	size_t total;
+
+	total = pcktPool + inFactory + outFactory + (nOfPcrl+nOfPocl)*sizeof(FwSmDesc_t) +
+	        (nOfInPq+nOfOutPq)*sizeof(CrFwPckt_t) + (CR_FW_INREGISTRY_N+CR_FW_OUTREGISTRY_N)*registryEntry;
+	printf("%s: Footprint: packet pool %zu bytes (%d packets)\n", app, pcktPool, CR_FW_MAX_NOF_PCKTS);
+	printf("%s: Footprint: InFactory %zu bytes (%d InCommands, %d InReports)\n", app, inFactory,
+	       CR_FW_INFACTORY_MAX_NOF_INCMD, CR_FW_INFACTORY_MAX_NOF_INREP);
+	printf("%s: Footprint: OutFactory %zu bytes (%d OutComponents)\n", app, outFactory,
+	       CR_FW_OUTFACTORY_MAX_NOF_OUTCMP);
+	printf("%s: Footprint: InManagers %zu bytes (%u PCRL entries in %d InManagers)\n", app,
+	       nOfPcrl*sizeof(FwSmDesc_t), nOfPcrl, CR_FW_NOF_INMANAGER);
+	printf("%s: Footprint: OutManagers %zu bytes (%u POCL entries in %d OutManagers)\n", app,
+	       nOfPocl*sizeof(FwSmDesc_t), nOfPocl, CR_FW_NOF_OUTMANAGER);
+	printf("%s: Footprint: InStreams %zu bytes (%u packet queue entries in %d InStreams)\n", app,
+	       nOfInPq*sizeof(CrFwPckt_t), nOfInPq, CR_FW_NOF_INSTREAM);
+	printf("%s: Footprint: OutStreams %zu bytes (%u packet queue entries in %d OutStreams)\n", app,
+	       nOfOutPq*sizeof(CrFwPckt_t), nOfOutPq, CR_FW_NOF_OUTSTREAM);
+	printf("%s: Footprint: InRegistry %zu bytes (%d entries), OutRegistry %zu bytes (%d entries)\n", app,
+	       CR_FW_INREGISTRY_N*registryEntry, CR_FW_INREGISTRY_N, CR_FW_OUTREGISTRY_N*registryEntry, CR_FW_OUTREGISTRY_N);
+	printf("%s: Footprint: %zu bytes of pools, queues and registries, %zu bytes of heap allocated at start-up\n",
+	       app, total, (heapAtStop > heapAtStart ? heapAtStop - heapAtStart : 0));
+#else
+	(void)app;
+#endif
+}
+
+#if (CR_DA_FOOTPRINT == 1)
+/* ---------------------------------------------------------------------------------------------*/
+static size_t heapInUse() {
+#if defined(__GLIBC__) && ((__GLIBC__ > 2) || ((__GLIBC__ == 2) && (__GLIBC_MINOR__ >= 33)))
+	struct mallinfo2 info = mallinfo2();
+	return info.uordblks;
+#else
+	struct mallinfo info = mallinfo();
+	return (size_t)(unsigned int)info.uordblks;
+#endif
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static unsigned int sizeSum(const CrFwCounterU1_t* size, unsigned int n) {
+	unsigned int i, sum = 0;
+
+	for (i=0; i<n; i++)
+		sum += size[i];
+	return sum;
+}
+#endif
@@ -0,0 +1,117 @@
+/**
+ * @file
+ * @ingroup crDemoSlave2
+ * Implementation of the capability handshake of the socket connections of the CORDET Demo.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdio.h>
+#include "CrDaHandshake.h"
+#include "CrDaStreamMap.h"
+
+/** The features which were agreed with each application. */
+static uint32_t agreedFeatures[CR_DA_STREAM_MAP_N];
+
+/** Flag which is set for the applications with which a handshake has been made. */
+static CrFwBool_t isAgreed[CR_DA_STREAM_MAP_N];
+
+/** The number of handshakes. */
+static unsigned long nOfHandshakes = 0;
+
+/** The number of invalid hellos. */
+static unsigned long nOfInvalid = 0;
+
+/**
+ * Write a 32-bit field of a hello (most significant byte first).
+ * @param buf the location of the field
+ * @param val the value of the field
+ */
+static void handshakePut32(unsigned char* buf, uint32_t val);
+
+/**
+ * Read a 32-bit field of a hello (most significant byte first).
+ * @param buf the location of the field
+ * @return the value of the field
+ */
+static uint32_t handshakeGet32(const unsigned char* buf);
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaHandshakeWrite(unsigned char* hello) {
+	handshakePut32(hello, CR_DA_HANDSHAKE_MAGIC);
+	hello[4] = (unsigned char)(CR_DA_HANDSHAKE_VERSION >> 8);
+	hello[5] = (unsigned char)(CR_DA_HANDSHAKE_VERSION & 0xFF);
+	hello[6] = (unsigned char)(CR_FW_HOST_APP_ID >> 8);
+	hello[7] = (unsigned char)(CR_FW_HOST_APP_ID & 0xFF);
+	handshakePut32(hello+8, CR_DA_HANDSHAKE_FEATURES);
+	handshakePut32(hello+12, 0);	/* reserved */
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaHandshakeAgree(const unsigned char* hello, CrFwDestSrc_t* peer, uint32_t* features) {
+	unsigned int version = ((unsigned int)hello[4] << 8) | hello[5];
+	unsigned int appId = ((unsigned int)hello[6] << 8) | hello[7];
+
+	if ((handshakeGet32(hello) != CR_DA_HANDSHAKE_MAGIC) || (version == 0) || (appId >= CR_DA_STREAM_MAP_N)) {
+		printf("CrDaHandshakeAgree: invalid hello received\n");
+		nOfInvalid++;
+		return 0;
+	}
+
+	/* The features which are unknown to this version are not supported by it */
+	*peer = (CrFwDestSrc_t)appId;
+	*features = handshakeGet32(hello+8) & CR_DA_HANDSHAKE_FEATURES;
+	if (!isAgreed[appId] || (agreedFeatures[appId] != *features))
+		printf("CrDaHandshakeAgree: application %u (version %u) agreed on features 0x%08x\n",
+		       appId, version, (unsigned int)*features);
+	agreedFeatures[appId] = *features;
+	isAgreed[appId] = 1;
+	nOfHandshakes++;
+	return 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+uint32_t CrDaHandshakeGetFeatures(CrFwDestSrc_t appId) {
+	if (appId >= CR_DA_STREAM_MAP_N)
+		return 0;
+	return agreedFeatures[appId];
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaHandshakeReport(const char* app) {
+#if (CR_DA_HANDSHAKE == 1)
+	unsigned int i;
+
+	printf("%s: Capability handshake: %lu handshakes, %lu invalid hellos, features 0x%08x supported\n",
+	       app, nOfHandshakes, nOfInvalid, (unsigned int)CR_DA_HANDSHAKE_FEATURES);
+	for (i=0; i<CR_DA_STREAM_MAP_N; i++)
+		if (isAgreed[i])
+			printf("%s: Capability handshake: features 0x%08x agreed with application %u\n",
+			       app, (unsigned int)agreedFeatures[i], i);
+#else
+	(void)app;
+#endif
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void handshakePut32(unsigned char* buf, uint32_t val) {
+	buf[0] = (unsigned char)(val >> 24);
+	buf[1] = (unsigned char)(val >> 16);
+	buf[2] = (unsigned char)(val >> 8);
+	buf[3] = (unsigned char)val;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static uint32_t handshakeGet32(const unsigned char* buf) {
+	return ((uint32_t)buf[0] << 24) | ((uint32_t)buf[1] << 16) | ((uint32_t)buf[2] << 8) | (uint32_t)buf[3];
+}
@@ -0,0 +1,115 @@
+/**
+ * @file
+ * @ingroup crDemoSlave2
+ * Interface for the capability handshake of the socket connections of the CORDET Demo.
+ * The wire format of the socket connections is otherwise fixed by compile-time switches
+ * (e.g. <code>#CR_DA_PCKT_CRC</code>) and all applications must be built with the same
+ * settings: a new feature of the wire format can only be deployed by rebuilding and
+ * restarting all applications at once.
+ *
+ * If the capability handshake is selected (see <code>#CR_DA_HANDSHAKE</code>), the peers
+ * of a connection exchange a hello of <code>#CR_DA_HANDSHAKE_LENGTH</code> bytes before
+ * their first packet:
+ * - The client socket sends its hello after the announcement of its application
+ *   identifier (see <code>::CrDaClientSocketInitAction</code>).
+ * - The server socket reads the hello of the client together with its announcement and
+ *   answers with its own hello before it sends the first packet on the connection.
+ *   The client socket does not send its packets before it has received this answer.
+ * .
+ * A hello holds the identifier of the hello (<code>#CR_DA_HANDSHAKE_MAGIC</code>), the
+ * version of its format, the application identifier of its sender and the features of
+ * the wire format which its sender supports (the <code>CR_DA_HANDSHAKE_FEAT_*</code> bits),
+ * each field most significant byte first.
+ * Each connection uses the features which are supported by both peers
+ * (<code>::CrDaHandshakeAgree</code>): an application which is built with a new feature
+ * uses it on the connections to the peers which already support it and the previous wire
+ * format on the others.
+ * A peer of a later version may announce features which are not known to this version:
+ * they are not supported by this version and they are therefore never agreed.
+ * A connection whose hello is invalid is closed by the server socket.
+ *
+ * The features which are covered by the handshake are those which are processed by the
+ * socket adapters at the two ends of a connection.
+ * At present, this is the trailer of the integrity check
+ * (<code>#CR_DA_HANDSHAKE_FEAT_PCKT_CRC</code>).
+ * The encodings of the reports (e.g. the batched acknowledgements or the delta encoding
+ * of the statistics reports) travel from a Slave Application to the Master Application
+ * through the forwarding of the server socket: they are an agreement between the two
+ * ends of the route rather than of a connection and they remain fixed by their
+ * compile-time switches.
+ * The handshake itself changes the wire format: all applications must be built with the
+ * same setting of <code>#CR_DA_HANDSHAKE</code>.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRDA_HANDSHAKE_H_
+#define CRDA_HANDSHAKE_H_
+
+#include <stdint.h>
+/* Include Framework Files */
+#include "CrFwConstants.h"
+/* Include Configuration Files */
+#include "CrFwUserConstants.h"
+#include "CrDaConstants.h"
+
+/** The identifier of the hellos ("CRHS"). */
+#define CR_DA_HANDSHAKE_MAGIC 0x43524853
+
+/** The version of the format of the hellos. */
+#define CR_DA_HANDSHAKE_VERSION 1
+
+/** The feature of the trailer of the integrity check (see <code>#CR_DA_PCKT_CRC</code>). */
+#define CR_DA_HANDSHAKE_FEAT_PCKT_CRC 0x00000001
+
+/** The features of the wire format which are supported by this application. */
+#if (CR_DA_PCKT_CRC == 1)
+#define CR_DA_HANDSHAKE_FEATURES CR_DA_HANDSHAKE_FEAT_PCKT_CRC
+#else
+#define CR_DA_HANDSHAKE_FEATURES 0
+#endif
+
+/**
+ * Write the hello of this application.
+ * @param hello the location of the hello (<code>#CR_DA_HANDSHAKE_LENGTH</code> bytes)
+ */
+void CrDaHandshakeWrite(unsigned char* hello);
+
+/**
+ * Check the hello of the peer of a connection and agree on the features of the
+ * connection.
+ * The agreed features are recorded for the application of the peer (see
+ * <code>::CrDaHandshakeGetFeatures</code>).
+ * @param hello the hello of the peer (<code>#CR_DA_HANDSHAKE_LENGTH</code> bytes)
+ * @param peer the location where the application identifier of the peer is returned
+ * @param features the location where the agreed features are returned
+ * @return 1 if the hello is valid; 0 otherwise
+ */
+CrFwBool_t CrDaHandshakeAgree(const unsigned char* hello, CrFwDestSrc_t* peer, uint32_t* features);
+
+/**
+ * Get the features which were agreed with an application by the last handshake with it.
+ * @param appId the application identifier of the peer
+ * @return the agreed features (0 if no handshake has been made with the application)
+ */
+uint32_t CrDaHandshakeGetFeatures(CrFwDestSrc_t appId);
+
+/**
+ * Print the number of handshakes, the number of invalid hellos and the features which
+ * were agreed with each peer.
+ * Nothing is printed if the capability handshake is not selected.
+ * @param app the name of the application (e.g. "MA")
+ */
+void CrDaHandshakeReport(const char* app);
+
+#endif /* CRDA_HANDSHAKE_H_ */
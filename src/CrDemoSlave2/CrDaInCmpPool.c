@@ -0,0 +1,66 @@
+/**
+ * @file
+ * @ingroup crDemoSlave2
+ * Implementation of the InCommand and InReport pools of the demo applications of the CORDET Demo.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdio.h>
+#include "CrDaInCmpPool.h"
+/* Include configuration files */
+#include "CrFwInFactoryUserPar.h"
+/* Include framework files */
+#include "InFactory/CrFwInFactory.h"
+
+/** The statistics of the InCommand pool. */
+static CrDaInCmpPoolStats_t inCmdStats;
+
+/** The statistics of the InReport pool. */
+static CrDaInCmpPoolStats_t inRepStats;
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaInCmpPoolSample() {
+	unsigned int nOfAllocated;
+
+	nOfAllocated = CrFwInFactoryGetNOfAllocatedInCmd();
+	if (nOfAllocated > inCmdStats.highWaterMark)
+		inCmdStats.highWaterMark = nOfAllocated;
+	nOfAllocated = CrFwInFactoryGetNOfAllocatedInRep();
+	if (nOfAllocated > inRepStats.highWaterMark)
+		inRepStats.highWaterMark = nOfAllocated;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaInCmpPoolInCmdCreFail() {
+	inCmdStats.nOfCreFail++;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaInCmpPoolInRepCreFail() {
+	inRepStats.nOfCreFail++;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaInCmpPoolGetStats(CrDaInCmpPoolStats_t* cmdStats, CrDaInCmpPoolStats_t* repStats) {
+	*cmdStats = inCmdStats;
+	*repStats = inRepStats;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaInCmpPoolReport(const char* app) {
+	printf("%s: InCommand pool: high-water mark %u of %d, %llu creation failures\n", app,
+	       inCmdStats.highWaterMark, CR_FW_INFACTORY_MAX_NOF_INCMD, inCmdStats.nOfCreFail);
+	printf("%s: InReport pool: high-water mark %u of %d, %llu creation failures\n", app,
+	       inRepStats.highWaterMark, CR_FW_INFACTORY_MAX_NOF_INREP, inRepStats.nOfCreFail);
+}
@@ -0,0 +1,161 @@
+/**
+ * @file
+ * @ingroup crDemoSlave2
+ * Interface for the latency tracing of the demo applications of the CORDET Demo.
+ * The round-trip latency of the commands (see <code>CrMaLatency.h</code>) and the one-way
+ * delay of the packets (see <code>CrDaHeartbeat.h</code>) show how long a packet takes
+ * but not where it waits.
+ * If the latency tracing is selected (see <code>#CR_DA_LAT_TRACE</code>), each packet
+ * carries the time stamps of its hops so that the application which completes it can
+ * split its end-to-end latency into stages:
+ * - The packets made through <code>::CrFwPcktMake</code> (i.e. the packets of the
+ *   OutComponents and the heartbeats) are <code>#CR_DA_LAT_TRACE_LENGTH</code> bytes longer
+ *   than requested and their last <code>#CR_DA_LAT_TRACE_LENGTH</code> bytes are the trace
+ *   trailer (<code>::CrDaLatTraceInit</code>).
+ *   The parameter area of a packet does not include the trailer.
+ * - The origin of a packet is its time stamp: this is the time at which its OutComponent
+ *   was made, read from the monotonic clock (see <code>CrFwTime.c</code>).
+ * - Each hop of the packet appends a trace point which holds the stage of the hop, the
+ *   application which performed it and the time at which it was performed: the sent
+ *   point when a transport hands the packet over to the middleware
+ *   (<code>::CrDaLatTraceTx</code>), the forwarded point when the socket server forwards
+ *   it to another client (<code>::CrDaLatTraceFwd</code>), the received point when a
+ *   transport collects it (<code>::CrDaLatTraceRx</code>) and, for the InCommands, the
+ *   loaded and started points when the InLoader accepts it and when its InManager starts
+ *   it (<code>::CrDaLatTraceInCmd</code>).
+ *   A hop which is repeated (e.g. a hand-over which is retried when the middleware is
+ *   busy) updates its point instead of appending a new one.
+ * - The application which completes the packet (at the termination of its InCommand or
+ *   at the update of its InReport, see <code>::CrDaLatTraceDone</code>) adds the latency
+ *   of each stage, i.e. the time from the previous point (or from the origin) to the point
+ *   of the stage, to the histogram of the stage and of the application which performed it,
+ *   and the time from the origin to the completion to the end-to-end histogram of the
+ *   source of the packet.
+ * .
+ * The applications of the demo run on the same host and read the same monotonic clock
+ * (or the same virtual clock in the simulation mode) so that the stages of a packet
+ * which is routed from the Master Application through the Slave 1 Application to the
+ * Slave 2 Application need no clock synchronization.
+ * The times of the points are the low 32 bits of the time stamps: a stage must take less
+ * than half their wrap-around period and the longer stages are ignored.
+ *
+ * The trace points are written before the packet is copied or protected by its CRC (see
+ * <code>CrDaCrc.h</code>) and a packet which is shared (its reference count is larger
+ * than one) is not updated since a transmit queue may still hold it.
+ * The packets from an application which was built without the latency tracing are
+ * recognized by the magic word of their trailer and they are not traced.
+ * The histograms are updated atomically so that the packets may be completed by the
+ * workers of the manager pool (see <code>CrDaMgrPool.h</code>).
+ *
+ * The trailer moves the small packets of the standard layout into the medium packet class
+ * (see <code>CrFwUserConstants.h</code>): the latency tracing is a diagnostic mode and
+ * its packet pool figures are not those of the production configuration.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRDA_LATTRACE_H_
+#define CRDA_LATTRACE_H_
+
+/* Include FW Profile Files */
+#include "FwSmConstants.h"
+/* Include Framework Files */
+#include "CrFwConstants.h"
+#include "CrFwRepInCmdOutcome.h"
+/* Include Configuration Files */
+#include "CrFwUserConstants.h"
+#include "CrDaConstants.h"
+
+/** The stages of a packet (the stages of its trace points). */
+typedef enum {
+	/** The packet has been handed over to the middleware. */
+	crDaLatTraceSent = 0,
+	/** The packet has been forwarded by the socket server. */
+	crDaLatTraceForwarded = 1,
+	/** The packet has been collected from the middleware. */
+	crDaLatTraceReceived = 2,
+	/** The InCommand of the packet has been loaded into its InManager. */
+	crDaLatTraceLoaded = 3,
+	/** The InCommand of the packet has been started by its InManager. */
+	crDaLatTraceStarted = 4,
+	/** The packet has been completed (this stage ends at the completion and has no point). */
+	crDaLatTraceCompleted = 5
+} CrDaLatTraceStage_t;
+
+/** The number of stages of a packet. */
+#define CR_DA_LAT_TRACE_N_OF_STAGES 6
+
+/**
+ * Write the empty trace trailer of a packet which has just been made.
+ * This function is called by <code>::CrFwPcktMake</code>.
+ * Nothing is done if the latency tracing is not selected.
+ * @param pckt the packet
+ */
+void CrDaLatTraceInit(CrFwPckt_t pckt);
+
+/**
+ * Record the sent point of a packet.
+ * This function is called by the transports before they copy a packet to the middleware
+ * or to a transmit queue.
+ * Nothing is done if the latency tracing is not selected.
+ * @param pckt the packet
+ */
+void CrDaLatTraceTx(CrFwPckt_t pckt);
+
+/**
+ * Record the forwarded point of a packet.
+ * This function is called by the socket server before it adds a packet to the transmit
+ * queue of the client to which it forwards it.
+ * Nothing is done if the latency tracing is not selected.
+ * @param pckt the packet
+ */
+void CrDaLatTraceFwd(CrFwPckt_t pckt);
+
+/**
+ * Record the received point of a packet.
+ * This function is called by <code>::CrDaLinkStatsRx</code>.
+ * Nothing is done if the latency tracing is not selected.
+ * @param pckt the packet
+ */
+void CrDaLatTraceRx(CrFwPckt_t pckt);
+
+/**
+ * Record the outcome of an InCommand: its acceptance and its start add the loaded and the
+ * started points to its packet and its termination or its failure completes its packet.
+ * This function is called by <code>::CrFwRepInCmdOutcome</code>.
+ * Nothing is done if the latency tracing is not selected.
+ * @param outcome the outcome of the InCommand
+ * @param inCmd the InCommand
+ */
+void CrDaLatTraceInCmd(CrFwRepInCmdOutcome_t outcome, FwSmDesc_t inCmd);
+
+/**
+ * Complete a packet: add the latencies of its stages to the histograms.
+ * This function is called when an InCommand terminates (through
+ * <code>::CrDaLatTraceInCmd</code>) and by the Update Actions of the InReports.
+ * Nothing is done if the latency tracing is not selected.
+ * @param pckt the packet
+ */
+void CrDaLatTraceDone(CrFwPckt_t pckt);
+
+/**
+ * Print the number of completed packets and, for each stage and application which
+ * performed it and for each source of the packets, the number of latencies and their
+ * 50th, 99th and 99.9th percentile and their maximum.
+ * Nothing is printed if the latency tracing is not selected or no packet has been
+ * completed.
+ * @param app the name of the application (e.g. "MA")
+ */
+void CrDaLatTraceReport(const char* app);
+
+#endif /* CRDA_LATTRACE_H_ */
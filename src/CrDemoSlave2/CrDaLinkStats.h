@@ -0,0 +1,131 @@
+/**
+ * @file
+ * @ingroup crDemoSlave2
+ * Interface for the link statistics of the demo applications of the CORDET Demo.
+ * The transports of the demo applications count the packets and bytes which they hand
+ * over to the middleware (<code>::CrDaLinkStatsTx</code>) and which they collect from it
+ * (<code>::CrDaLinkStatsRx</code>).
+ * The packets are counted for each link, i.e. for each pair of source and destination
+ * of the packets, and the link statistics therefore also show the packets which an
+ * application routes between two other applications.
+ * The time of the first and of the last packet of each link and direction is recorded
+ * so that the rates of a link are computed over the interval in which it carried
+ * traffic.
+ *
+ * The link statistics are updated by the thread which owns the transport: the thread
+ * of the cycle scheduler or the I/O thread (see <code>CrDaIoThread.h</code>).
+ * They must only be reported when the I/O thread has been stopped.
+ *
+ * <code>::CrDaLinkStatsReport</code> prints one line for each link and direction which
+ * has carried packets.
+ * The lines are machine-readable: they start with <code>TP,</code> which is followed
+ * by these comma-separated fields (see <code>RunThroughput.sh</code>):
+ * application, direction (<code>tx</code> or <code>rx</code>), source, destination,
+ * packets, bytes, duration in seconds, packets per second, bytes per second, user CPU
+ * time and system CPU time in seconds of the process.
+ *
+ * The packets collected from the middleware are also checked for the continuity of
+ * their sequence counters.
+ * The sequence counters are kept by the OutStreams of the source for each destination
+ * and each group and the continuity is therefore tracked for each link and each group
+ * (up to <code>#CR_DA_LINK_STATS_N_OF_GROUPS</code> groups).
+ * The tracking does O(1) work per packet: it keeps the highest sequence counter received
+ * and a bitmap of the <code>#CR_DA_LINK_STATS_SEQ_WINDOW</code> sequence counters below
+ * it, and it counts (see <code>::CrDaLinkSeqStats_t</code>):
+ * - the gaps, i.e. the packets whose sequence counter is higher than the next expected
+ *   one, and the sequence counters skipped by them (the lost packets);
+ * - the duplicates, i.e. the packets whose sequence counter has already been received;
+ * - the reorders, i.e. the packets which arrive after a packet with a higher sequence
+ *   counter and which fill a gap (they are then no longer counted as lost).
+ * .
+ * A packet whose sequence counter is older than the window cannot be told from a
+ * duplicate and it is counted as a reorder.
+ * If the dropping of the duplicates is selected (see <code>#CR_DA_INSTREAM_DEDUP</code>),
+ * the transports release the duplicates which <code>::CrDaLinkStatsRx</code> reports
+ * instead of handing them to their InStreams.
+ * A retransmitted packet then costs one bit test and it reaches neither the sequence
+ * counter check of the InStream nor the InFactory.
+ * Since a packet older than the window is not a duplicate, a source which restarts its
+ * sequence counters is only affected while the highest sequence counter received from it
+ * is within the window.
+ * The first packet of a link and group only sets the start of its sequence.
+ * The statistics of a link and group are returned by <code>::CrDaLinkStatsGetSeq</code>
+ * and <code>::CrDaLinkStatsReport</code> prints one more line for each of them which
+ * has received packets: it starts with <code>SQ,</code> which is followed by these
+ * comma-separated fields: application, source, destination, group, packets, gaps, lost
+ * packets, duplicates and reorders.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRDA_LINKSTATS_H_
+#define CRDA_LINKSTATS_H_
+
+/* Include Framework Files */
+#include "CrFwConstants.h"
+/* Include Configuration Files */
+#include "CrFwUserConstants.h"
+#include "CrDaConstants.h"
+
+/** The sequence counter statistics of the packets received on one link in one group. */
+typedef struct {
+	/** The number of packets received. */
+	unsigned long long nOfPckts;
+	/** The number of packets which skipped one or more sequence counters. */
+	unsigned long long nOfGaps;
+	/** The number of skipped sequence counters which have not been received later. */
+	unsigned long long nOfLost;
+	/** The number of packets whose sequence counter had already been received. */
+	unsigned long long nOfDuplicates;
+	/** The number of packets received after a packet with a higher sequence counter. */
+	unsigned long long nOfReorders;
+} CrDaLinkSeqStats_t;
+
+/**
+ * Count a packet which has been handed over to the middleware.
+ * If the heartbeats are selected (see <code>#CR_DA_HEARTBEAT</code>), the packet is also
+ * accounted for the idleness of the link to its destination (see
+ * <code>::CrDaHeartbeatTx</code>).
+ * @param pckt the packet
+ */
+void CrDaLinkStatsTx(CrFwPckt_t pckt);
+
+/**
+ * Count a packet which has been collected from the middleware.
+ * If the heartbeats are selected (see <code>#CR_DA_HEARTBEAT</code>), the packet is also
+ * accounted for the liveness of its source (see <code>::CrDaHeartbeatRx</code>).
+ * @param pckt the packet
+ * @return 0 if the transport must drop the packet, i.e. if it is a heartbeat or if the
+ * dropping of the duplicates is selected and the sequence counter of the packet has
+ * already been received on its link and group; 1 otherwise
+ */
+CrFwBool_t CrDaLinkStatsRx(CrFwPckt_t pckt);
+
+/**
+ * Get the sequence counter statistics of one link and group.
+ * @param src the source of the packets
+ * @param dest the destination of the packets
+ * @param group the group of the packets
+ * @param stats the location where the statistics are returned (they are cleared if the
+ * link and group have not received packets)
+ * @return 1 if the link and group have received packets; 0 otherwise
+ */
+CrFwBool_t CrDaLinkStatsGetSeq(CrFwDestSrc_t src, CrFwDestSrc_t dest, CrFwGroup_t group, CrDaLinkSeqStats_t* stats);
+
+/**
+ * Print the link statistics and the CPU time of the process.
+ * @param app the name of the application (e.g. "MA")
+ */
+void CrDaLinkStatsReport(const char* app);
+
+#endif /* CRDA_LINKSTATS_H_ */
@@ -0,0 +1,127 @@
+/**
+ * @file
+ * @ingroup crDemoSlave2
+ * Interface for the live stream metrics of the demo applications of the CORDET Demo.
+ * The metrics are counters which are kept for each InStream and each OutStream of an
+ * application while it runs:
+ * - the packets and bytes collected from the transport for each InStream (i.e. for each
+ *   source) and handed over to the transport for each OutStream (i.e. for each
+ *   destination);
+ * - the packets which are discarded by the transport because they cannot be framed
+ *   (<code>::CrDaMetricsFramingError</code>), for each peer application of the
+ *   connection on which they arrived;
+ * - the packets which are discarded by the transport because their CRC does not match
+ *   (<code>::CrDaMetricsCrcError</code>, see <code>CrDaCrc.h</code>), for each peer
+ *   application of the connection on which they arrived;
+ * - the failed hand-over attempts of each OutStream (<code>::CrDaMetricsHandoverFail</code>);
+ * - the number of packets pending in the packet queue of each InStream and OutStream, its
+ *   maximum and the size of the queue (i.e. <code>CR_FW_INSTREAM_PQSIZE</code> and
+ *   <code>CR_FW_OUTSTREAM_PQSIZE</code>);
+ * - the failed allocations of the packet pool for each size class.
+ * .
+ * The transport counters are updated by the threads which use the transport (the thread
+ * of the control cycles, the I/O thread and the threads of the manager pool) and the
+ * queue depths and pool counters are sampled once per control cycle by the thread of
+ * the cycle scheduler (<code>::CrDaMetricsSample</code>).
+ * Each thread updates the transport counters of its own shard (see
+ * <code>CrDaStatShard.h</code>) and the metrics server sums the shards when it answers
+ * a connection; the sampled counters are kept in their own cache lines.
+ * Hence, the updates of one thread and the reads of the metrics server do not make the
+ * cache lines of another thread bounce between cores.
+ *
+ * If the metrics server is selected (see <code>#CR_DA_METRICS</code>), a server thread
+ * listens on a side TCP port (<code>#CR_DA_METRICS_PORT</code> plus the application
+ * identifier) and answers every connection with a snapshot of the counters in the
+ * Prometheus text exposition format (as an HTTP/1.0 response, so that the port can be
+ * scraped by Prometheus or read with <code>curl</code>).
+ * The server thread only reads the counters: the control cycles never wait for it.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRDA_METRICS_H_
+#define CRDA_METRICS_H_
+
+/* Include FW Profile Files */
+#include "FwSmConstants.h"
+/* Include Framework Files */
+#include "CrFwConstants.h"
+/* Include Configuration Files */
+#include "CrFwUserConstants.h"
+#include "CrDaConstants.h"
+
+/**
+ * Count a packet which an InStream has collected from the transport.
+ * @param pckt the packet
+ */
+void CrDaMetricsIn(CrFwPckt_t pckt);
+
+/**
+ * Count a packet which an OutStream has handed over to the transport.
+ * @param pckt the packet
+ */
+void CrDaMetricsOut(CrFwPckt_t pckt);
+
+/**
+ * Count a packet which the transport has discarded because it could not be framed.
+ * @param peer the identifier of the application at the other end of the connection on
+ * which the packet arrived (zero if it is not known)
+ */
+void CrDaMetricsFramingError(CrFwDestSrc_t peer);
+
+/**
+ * Count a packet which the transport has discarded because its CRC did not match.
+ * @param peer the identifier of the application at the other end of the connection on
+ * which the packet arrived (zero if it is not known)
+ */
+void CrDaMetricsCrcError(CrFwDestSrc_t peer);
+
+/**
+ * Count a failed attempt to hand over a packet to the transport.
+ * @param pckt the packet
+ */
+void CrDaMetricsHandoverFail(CrFwPckt_t pckt);
+
+/**
+ * Set the InStreams and OutStreams whose packet queues are sampled.
+ * The streams must have been configured.
+ * At most <code>#CR_DA_METRICS_MAX_NOF_STREAMS</code> InStreams and OutStreams are
+ * sampled.
+ * @param inStreams the InStreams
+ * @param nOfInStreams the number of InStreams
+ * @param outStreams the OutStreams
+ * @param nOfOutStreams the number of OutStreams
+ */
+void CrDaMetricsSetStreams(FwSmDesc_t* inStreams, int nOfInStreams, FwSmDesc_t* outStreams, int nOfOutStreams);
+
+/**
+ * Sample the packet queues of the streams and the failed allocations of the packet pool.
+ * This function is called once per control cycle by the thread of the cycle scheduler.
+ */
+void CrDaMetricsSample();
+
+/**
+ * Start the metrics server thread.
+ * Nothing is done if the metrics server is not selected (see <code>#CR_DA_METRICS</code>).
+ * @param app the name of the application in the metrics (e.g. "MA")
+ * @return 1 if the metrics server was started; 0 otherwise
+ */
+CrFwBool_t CrDaMetricsStart(const char* app);
+
+/**
+ * Stop the metrics server thread and close its socket.
+ * Nothing is done if the metrics server is not running.
+ */
+void CrDaMetricsStop();
+
+#endif /* CRDA_METRICS_H_ */
@@ -0,0 +1,160 @@
+/**
+ * @file
+ * @ingroup crDemoSlave2
+ * Interface for the admission control of the OutComponents of the demo applications of
+ * the CORDET Demo.
+ * An OutComponent cannot be made when the OutComponent pool of the OutFactory or the
+ * packet pool (or the partition of the packet pool of its destination) is exhausted.
+ * The demo applications make their OutComponents through this module which makes a
+ * failure measurable and which lets each producer choose what happens to a request
+ * which cannot be admitted:
+ * - <code>#CR_DA_OUT_ADMIT_REJECT</code>: the request is rejected and the producer is told
+ *   so (this is what <code>::CrDaOutAdmitMake</code> does for the producers which handle
+ *   the failure themselves, e.g. by counting the lost entries of a batch report);
+ * - <code>#CR_DA_OUT_ADMIT_DEFER</code>: the request is kept in the deferred request queue
+ *   and it is issued when the resources have been freed;
+ * - <code>#CR_DA_OUT_ADMIT_DROP_OLDEST</code>: as for the deferral but, when the queue is
+ *   full, the oldest deferred request of the same kind and destination is dropped to make
+ *   room for the new one (the producers of periodic data prefer the latest data).
+ * .
+ * A deferrable request (<code>::CrDaOutAdmitIssue</code>) is described by the kind and the
+ * destination of its OutComponent and by an Issue Function which configures the
+ * OutComponent from a small argument and loads it into the OutLoader.
+ * The argument is copied into the queue when the request is deferred so that the Issue
+ * Function can be called later with the same argument.
+ *
+ * OutComponents are released when they have been sent by the OutManagers.
+ * The deferred requests are therefore retried once per cycle
+ * (<code>::CrDaOutAdmitCycle</code>), at the start of the cycle before the producers make
+ * new OutComponents: they are retried in the order in which they were deferred and a
+ * request which fails again keeps its place in the queue.
+ * The requests for one destination keep their order: after a request for a destination
+ * has failed, the later requests for it are not retried in the same cycle.
+ * While the queue holds requests, a new deferrable request is queued behind them instead
+ * of overtaking them.
+ *
+ * The allocation failure of an admitted, deferred, rejected or dropped request does not
+ * leave the application error code set: the failures are counted by this module and they
+ * are printed by <code>::CrDaOutAdmitReport</code>.
+ * The queue is protected by a mutex so that the requests may be made by the workers of
+ * the manager pool (see <code>CrDaMgrPool.h</code>); the mutex is only taken when a request
+ * fails or when the queue is not empty.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRDA_OUTADMIT_H_
+#define CRDA_OUTADMIT_H_
+
+/* Include FW Profile Files */
+#include "FwSmConstants.h"
+/* Include Framework Files */
+#include "CrFwConstants.h"
+/* Include Configuration Files */
+#include "CrFwUserConstants.h"
+#include "CrDaConstants.h"
+
+/**
+ * Type for the Issue Function of a request.
+ * The function is called with an OutComponent which has just been made: it configures
+ * the OutComponent (its parameters, its destination and its group) and loads it into the
+ * OutLoader.
+ * @param outCmp the OutComponent
+ * @param dest the destination of the request
+ * @param arg the argument of the request
+ */
+typedef void (*CrDaOutAdmitIssue_t)(FwSmDesc_t outCmp, CrFwDestSrc_t dest, const void* arg);
+
+/** A request to make, configure and load an OutComponent. */
+typedef struct {
+	/** The service type of the OutComponent. */
+	CrFwServType_t servType;
+	/** The service sub-type of the OutComponent. */
+	CrFwServSubType_t servSubType;
+	/** The discriminant of the OutComponent. */
+	CrFwDiscriminant_t discriminant;
+	/** The length of the packet of the OutComponent (zero for the default length). */
+	CrFwPcktLength_t length;
+	/** The destination of the OutComponent. */
+	CrFwDestSrc_t dest;
+	/** The admission policy of the request (<code>#CR_DA_OUT_ADMIT_REJECT</code>, ...). */
+	unsigned int policy;
+	/** The Issue Function of the request. */
+	CrDaOutAdmitIssue_t issue;
+} CrDaOutAdmitReq_t;
+
+/** The statistics of the admission control. */
+typedef struct {
+	/** The number of requests which were admitted when they were made. */
+	unsigned long long nOfAdmitted;
+	/** The number of requests which were deferred. */
+	unsigned long long nOfDeferred;
+	/** The number of deferred requests which were admitted when they were retried. */
+	unsigned long long nOfRetried;
+	/** The number of requests which were rejected (including those which found the queue full). */
+	unsigned long long nOfRejected;
+	/** The number of deferred requests which were dropped to make room for newer ones. */
+	unsigned long long nOfDropped;
+	/** The number of requests which are deferred. */
+	unsigned int nOfQueued;
+	/** The largest number of requests which were deferred at the same time. */
+	unsigned int highWaterMark;
+} CrDaOutAdmitStats_t;
+
+/**
+ * Make an OutComponent for a destination or reject the request.
+ * The packet of the OutComponent is taken from the partition of the packet pool of the
+ * destination (see <code>CrFwPcktPart.h</code>).
+ * If the OutComponent cannot be made, the rejection is counted and the allocation failure
+ * is cleared from the application error code.
+ * @param type the service type of the OutComponent
+ * @param subType the service sub-type of the OutComponent
+ * @param discriminant the discriminant of the OutComponent
+ * @param length the length of the packet of the OutComponent (zero for the default length)
+ * @param dest the destination of the OutComponent
+ * @return the OutComponent or NULL if the request was rejected
+ */
+FwSmDesc_t CrDaOutAdmitMake(CrFwServType_t type, CrFwServSubType_t subType, CrFwDiscriminant_t discriminant,
+                            CrFwPcktLength_t length, CrFwDestSrc_t dest);
+
+/**
+ * Issue a request: make its OutComponent and call its Issue Function or, if the
+ * OutComponent cannot be made, handle the request according to its policy.
+ * @param req the request
+ * @param arg the argument of the Issue Function
+ * @param argLength the length in bytes of the argument (at most
+ * <code>#CR_DA_OUT_ADMIT_ARG_SIZE</code>)
+ * @return 1 if the request was admitted or deferred; 0 if it was rejected
+ */
+CrFwBool_t CrDaOutAdmitIssue(const CrDaOutAdmitReq_t* req, const void* arg, unsigned int argLength);
+
+/**
+ * Retry the deferred requests.
+ * This function is called once at the start of each cycle by the Cycle Work Function.
+ */
+void CrDaOutAdmitCycle();
+
+/**
+ * Get the statistics of the admission control.
+ * @param stats the statistics (output)
+ */
+void CrDaOutAdmitGetStats(CrDaOutAdmitStats_t* stats);
+
+/**
+ * Print the statistics of the admission control.
+ * Nothing is printed if no request has failed.
+ * @param app the name of the application (e.g. "MA")
+ */
+void CrDaOutAdmitReport(const char* app);
+
+#endif /* CRDA_OUTADMIT_H_ */
@@ -0,0 +1,136 @@
+/**
+ * @file
+ * @ingroup crDemoSlave2
+ * Interface for the OutStream backlog of the demo applications of the CORDET Demo.
+ * The packet queue of an OutStream has a fixed size (<code>CR_FW_OUTSTREAM_PQSIZE</code>):
+ * when the destination of the OutStream is unreachable for longer than it takes to fill
+ * it, the further packets are lost.
+ * If the OutStream backlog is selected (see <code>#CR_DA_OUT_BACKLOG</code>), the
+ * OutStreams hand their packets over to the backlog which absorbs such bursts:
+ * - The backlog of a destination has one queue for each group of the packets (see
+ *   <code>#CR_DA_PCKT_N_OF_GROUPS</code>): the group of a packet is its priority class.
+ * - If the queues of the group of a packet and of the groups before it are empty, the
+ *   packet is handed over to the transport directly (also when packets of the groups
+ *   after it are backlogged: the time-critical packets bypass the routine backlog).
+ * - If the transport does not accept the packet or if it would overtake packets of its
+ *   group or of a group before it, the packet is appended to the queue of its group (it
+ *   is retained, see <code>CrFwPcktRefCnt.h</code>, and it is therefore not copied).
+ * - The hand-over to the OutStream only fails (and the packet is buffered in the packet
+ *   queue of the OutStream) if the backlog of its destination holds
+ *   <code>#CR_DA_OUT_BACKLOG_MAX_NOF_PCKTS</code> packets or if the arena is exhausted.
+ * .
+ * The backlogs of the destinations grow and shrink in chunks of
+ * <code>#CR_DA_OUT_BACKLOG_CHUNK_SIZE</code> packets which are taken from an arena of
+ * <code>#CR_DA_OUT_BACKLOG_N_OF_CHUNKS</code> chunks which is reserved at build time.
+ * Hence, a burst towards one destination can use most of the arena while the backlog of
+ * a destination never takes more than its hard cap.
+ *
+ * The backlogs are handed over to the transport by <code>::CrDaOutBacklogFlush</code>
+ * which the demo applications call in every control cycle: the queues of a destination
+ * are handed over in the order of their groups.
+ * The packets of one group are therefore never reordered (each group has its own sequence
+ * counter) but a packet may overtake the packets of the groups after its own.
+ * When the backlog of a destination has been emptied, the packets which its OutStream
+ * may have buffered in its own packet queue are handed over next
+ * (see <code>::CrFwOutStreamConnectionAvail</code>) so that the order of the packets is
+ * preserved.
+ *
+ * For each destination, the backlog records the number of backlogged and rejected
+ * packets, the high-water mark of the backlog and the time which the backlog has spent
+ * above each of the thresholds of <code>#CR_DA_OUT_BACKLOG_THRESHOLDS</code>, so that the
+ * packet queues can be sized from real traffic.
+ * They are printed by <code>::CrDaOutBacklogReport</code>.
+ *
+ * The hand-over and the flush of the backlog of a destination must be called by one
+ * thread at a time (the OutStream of a destination is only executed by one manager at
+ * a time, see <code>CrDaMgrPool.h</code>); the arena is shared by all destinations and is
+ * protected by a mutex.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRDA_OUTBACKLOG_H_
+#define CRDA_OUTBACKLOG_H_
+
+/* Include Framework Files */
+#include "CrFwConstants.h"
+/* Include Configuration Files */
+#include "CrFwUserConstants.h"
+#include "CrDaConstants.h"
+
+/** The number of thresholds of <code>#CR_DA_OUT_BACKLOG_THRESHOLDS</code>. */
+#define CR_DA_OUT_BACKLOG_N_OF_THRESHOLDS 3
+
+/** The statistics of the backlog of a destination. */
+typedef struct {
+	/** The number of packets in the backlog. */
+	unsigned int nOfPckts;
+	/** The high-water mark of the backlog. */
+	unsigned int highWaterMark;
+	/** The number of packets which have been appended to the backlog. */
+	unsigned long long nOfBacklogged;
+	/** The number of packets which have been rejected because the backlog was full. */
+	unsigned long long nOfRejected;
+	/** The number of packets which have been handed over ahead of the packets of lower-priority groups. */
+	unsigned long long nOfBypassed;
+	/** The time in nanoseconds which the backlog has spent above each threshold. */
+	unsigned long long timeAbove[CR_DA_OUT_BACKLOG_N_OF_THRESHOLDS];
+} CrDaOutBacklogStats_t;
+
+/**
+ * Set the hand-over operation of the transport.
+ * This function must be called before the OutStreams send their first packet.
+ * @param handover the hand-over operation of the transport (e.g.
+ * <code>::CrDaClientSocketPcktHandover</code>)
+ */
+void CrDaOutBacklogSetHandover(CrFwBool_t (*handover)(CrFwPckt_t pckt));
+
+/**
+ * Function implementing the hand-over operation of the OutStreams for the backlog.
+ * @param pckt the packet to be handed over
+ * @return 1 if the packet was handed over to the transport or appended to the backlog of
+ * its destination; 0 if the backlog of its destination is full
+ */
+CrFwBool_t CrDaOutBacklogPcktHandover(CrFwPckt_t pckt);
+
+/**
+ * Hand the backlogs over to the transport.
+ * For each destination, the queues of the groups are handed over in the order of the
+ * groups and the packets of each queue in order until the transport does not accept a
+ * packet.
+ * If the backlog of a destination has been emptied and its OutStream has pending packets,
+ * they are handed over next (see <code>::CrFwOutStreamConnectionAvail</code>).
+ * @return the number of packets which remain in the backlogs
+ */
+unsigned int CrDaOutBacklogFlush();
+
+/**
+ * Release the packets in the backlogs and empty the backlogs.
+ * The packets are discarded without being handed over.
+ */
+void CrDaOutBacklogClear();
+
+/**
+ * Get the statistics of the backlog of a destination.
+ * @param dest the destination
+ * @param stats the statistics (output)
+ */
+void CrDaOutBacklogGetStats(CrFwDestSrc_t dest, CrDaOutBacklogStats_t* stats);
+
+/**
+ * Print the statistics of the backlogs of the destinations which have had a backlog.
+ * @param app the name of the application (e.g. "MA")
+ */
+void CrDaOutBacklogReport(const char* app);
+
+#endif /* CRDA_OUTBACKLOG_H_ */
@@ -0,0 +1,126 @@
+/**
+ * @file
+ * @ingroup crDemoSlave2
+ * Implementation of the batch report of temperature violations of the CORDET Demo.
+ * With the default sizes, a batch report of <code>#CR_DA_TEMP_BATCH_MAX_N</code> violations
+ * needs 1+8*8 bytes of parameters which, with the largest packet header (60 bytes), fit
+ * in the <code>#CR_DA_TEMP_BATCH_PCKT_LENGTH</code> bytes of its packet.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdio.h>
+#include "CrDaConstants.h"
+#include "CrDaOutCmpTempBatch.h"
+#include "CrDaOutAdmit.h"
+/* Include configuration files */
+#include "CrFwTime.h"
+/* Include framework files */
+#include "OutCmp/CrFwOutCmp.h"
+#include "OutLoader/CrFwOutLoader.h"
+#include "UtilityFunctions/CrFwUtilityFunctions.h"
+
+/** The violations of the pending batch (in the layout of the entries of a batch report). */
+static CrDaParViolationEntry_t batchEntry[CR_DA_TEMP_BATCH_MAX_N];
+
+/** The number of violations of the pending batch. */
+static unsigned int batchN = 0;
+
+/** The number of control cycles of the current window. */
+static unsigned int nOfWindowCycles = 0;
+
+/** The number of batch reports which have been made. */
+static unsigned long long nOfBatches = 0;
+
+/** The number of violations which have been carried by the batch reports. */
+static unsigned long long nOfSent = 0;
+
+/** The number of violations which have been lost because their batch report could not be made. */
+static unsigned long long nOfLost = 0;
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaOutCmpTempBatchAdd(unsigned short chan, char temp, unsigned char nOfSuppressed) {
+	batchEntry[batchN].chan = chan;
+	batchEntry[batchN].temp = temp;
+	batchEntry[batchN].nOfSuppressed = nOfSuppressed;
+	batchEntry[batchN].timeStamp = CrFwGetCurrentTimeStamp();
+	batchN++;
+	if (batchN < CR_DA_TEMP_BATCH_MAX_N)
+		return 1;
+	return CrDaOutCmpTempBatchFlush();
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaOutCmpTempBatchFlush() {
+	FwSmDesc_t rep;
+	char* pcktPar;
+
+	if (batchN == 0)
+		return 1;
+
+	rep = CrDaOutAdmitMake(CR_DA_SERV_TYPE,CR_DA_SERV_SUBTYPE_REP_BATCH,0,0,CR_DA_MASTER);
+	if (rep == NULL) {
+		/* The entries of the batch are lost (the rejection is counted by the admission control) */
+		nOfLost += batchN;
+		batchN = 0;
+		return 0;
+	}
+
+	pcktPar = CrFwOutCmpGetParStart(rep);
+	pcktPar[0] = (char)batchN;
+	CrDaParViolationEntryWrite(pcktPar+1, batchEntry, batchN);
+	nOfBatches++;
+	nOfSent += batchN;
+	batchN = 0;
+
+	CrFwOutCmpSetDest(rep,CR_DA_MASTER);
+	CrFwOutCmpSetGroup(rep,CR_DA_PCKT_GROUP_ROUTINE);
+	/* Request the batch report to be sent out */
+	CrFwOutLoaderLoad(rep);
+	return 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaOutCmpTempBatchCycle() {
+#if (CR_DA_TEMP_BATCH == 1)
+	nOfWindowCycles++;
+	if (nOfWindowCycles < CR_DA_TEMP_BATCH_WINDOW)
+		return;
+	nOfWindowCycles = 0;
+	CrDaOutCmpTempBatchFlush();
+#endif
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+unsigned int CrDaOutCmpTempBatchGetN(const char* pcktPar) {
+	return (unsigned char)pcktPar[0];
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaOutCmpTempBatchGetEntry(const char* pcktPar, unsigned int i, unsigned short* chan, char* temp,
+                                 unsigned char* nOfSuppressed, CrFwTimeStamp_t* timeStamp) {
+	const char* entry = pcktPar + 1 + i*CR_DA_TEMP_BATCH_ENTRY_LENGTH;
+
+	*chan = CrDaParViolationEntryGetChan(entry);
+	*temp = CrDaParViolationEntryGetTemp(entry);
+	*nOfSuppressed = CrDaParViolationEntryGetNOfSuppressed(entry);
+	*timeStamp = CrDaParViolationEntryGetTimeStamp(entry);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaOutCmpTempBatchReport(const char* app) {
+#if (CR_DA_TEMP_BATCH == 1)
+	printf("%s: Batch reports: %llu reports of up to %d violations (%.1f on average), %llu violations lost\n", app,
+	       nOfBatches, CR_DA_TEMP_BATCH_MAX_N, (nOfBatches == 0 ? 0.0 : (double)nOfSent / nOfBatches), nOfLost);
+#endif
+}
@@ -18,6 +18,8 @@
 
 #include <stdlib.h>
 #include "CrDaConstants.h"
+#include "CrDaPar.h"
+#include "CrDaPcktTemplate.h"
 /* Include configuration files */
 #include "CrFwCmpData.h"
 /* Include framework files */
@@ -39,14 +41,23 @@
 /** The limit violating temperature */
 static char limitViolatingTemp = 0;
 
+/** The number of reports which the channel of the violation has suppressed since its previous report */
+static unsigned char nOfSuppressedReps = 0;
+
 /*-----------------------------------------------------------------------------------------*/
 void CrDaOutCmpTempViolationSerialize(FwSmDesc_t smDesc) {
 	char* pcktPar = CrFwOutCmpGetParStart(smDesc);
-	CrFwOutCmpDefSerialize(smDesc);
-	pcktPar[0] = limitViolatingTemp;
+	CrDaPcktTemplateSerialize(smDesc);
+	CrDaParViolationSetTemp(pcktPar, limitViolatingTemp);
+	CrDaParViolationSetNOfSuppressed(pcktPar, nOfSuppressedReps);
 }
 
 /*-----------------------------------------------------------------------------------------*/
 void CrDaOutCmpTempViolationSetTemp(char temp) {
 	limitViolatingTemp = temp;
 }
+
+/*-----------------------------------------------------------------------------------------*/
+void CrDaOutCmpTempViolationSetNOfSuppressed(unsigned char nOfSuppressed) {
+	nOfSuppressedReps = nOfSuppressed;
+}
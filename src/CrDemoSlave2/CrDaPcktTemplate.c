@@ -0,0 +1,139 @@
+/**
+ * @file
+ * @ingroup crDemoSlave2
+ * Implementation of the packet header templates of the demo applications.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "CrDaPcktTemplate.h"
+#include "CrDaStatShard.h"
+/* Include configuration files */
+#include "CrFwCmpData.h"
+#include "CrFwPcktInline.h"
+/* Include framework files */
+#include "OutCmp/CrFwOutCmp.h"
+#include "BaseCmp/CrFwBaseCmp.h"
+#include "Pckt/CrFwPckt.h"
+/* Include FW Profile files */
+#include "FwSmConfig.h"
+
+/** Type for a packet header template. */
+typedef struct {
+	/** The service type. */
+	CrFwServType_t servType;
+	/** The service sub-type. */
+	CrFwServSubType_t servSubType;
+	/** The discriminant. */
+	CrFwDiscriminant_t discriminant;
+	/** The destination. */
+	CrFwDestSrc_t dest;
+	/** The group. */
+	CrFwGroup_t group;
+	/** The header. */
+	char header[CR_FW_PCKT_HEADER_LENGTH];
+} CrDaPcktTemplate_t;
+
+/** The templates (only the first <code>nOfTemplates</code> ones are complete). */
+static CrDaPcktTemplate_t pcktTemplate[CR_DA_PCKT_TEMPLATE_N];
+
+/** The number of complete templates. */
+static unsigned int nOfTemplates = 0;
+
+/** The number of templates which have been claimed (they are complete once <code>nOfTemplates</code> has reached them). */
+static unsigned int nOfClaimed = 0;
+
+/** The counters of the headers which are updated by one thread. */
+typedef struct {
+	/** The number of headers which were copied from a template. */
+	unsigned long long nOfHits;
+	/** The number of headers which were serialized by the default Serialize Operation. */
+	unsigned long long nOfMisses;
+} __attribute__((aligned(CR_DA_STAT_CACHE_LINE))) CrDaPcktTemplateShard_t;
+
+/** The shards of the counters of the headers (the OutComponents are serialized by several threads, see <code>CrDaStatShard.h</code>). */
+static CrDaPcktTemplateShard_t templateShard[CR_DA_STAT_N_OF_SHARDS];
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaPcktTemplateSerialize(FwSmDesc_t smDesc) {
+#if (CR_DA_PCKT_TEMPLATE == 1)
+	CrFwCmpData_t* cmpData = (CrFwCmpData_t*)FwSmGetData(smDesc);
+	CrFwOutCmpData_t* cmpSpecificData = (CrFwOutCmpData_t*)(cmpData->cmpSpecificData);
+	CrFwPckt_t pckt = cmpSpecificData->pckt;
+	CrFwServType_t servType = CrFwOutCmpGetServType(smDesc);
+	CrFwServSubType_t servSubType = CrFwOutCmpGetServSubType(smDesc);
+	CrFwDiscriminant_t discriminant = CrFwOutCmpGetDiscriminant(smDesc);
+	CrFwDestSrc_t dest = CrFwOutCmpGetDest(smDesc);
+	CrFwGroup_t group = CrFwOutCmpGetGroup(smDesc);
+	CrFwPcktLength_t length = CrFwPcktInlGetLength(pckt);
+	unsigned int n = __atomic_load_n(&nOfTemplates, __ATOMIC_ACQUIRE);
+	CrDaPcktTemplate_t* t;
+	unsigned int i;
+
+	for (i=0; i<n; i++) {
+		t = &pcktTemplate[i];
+		if ((t->servType == servType) && (t->servSubType == servSubType) && (t->discriminant == discriminant) &&
+		        (t->dest == dest) && (t->group == group)) {
+			/* Only the fields which change from one report to the next are patched */
+			memcpy(pckt, t->header, CR_FW_PCKT_HEADER_LENGTH);
+			CrFwPcktInlSetLength(pckt, length);
+			CrFwPcktInlSetCmdRepId(pckt, CrFwCmpGetInstanceId(smDesc));
+			CrFwPcktInlSetTimeStamp(pckt, CrFwOutCmpGetTimeStamp(smDesc));
+			__atomic_fetch_add(&templateShard[CrDaStatShardId()].nOfHits, 1, __ATOMIC_RELAXED);
+			return;
+		}
+	}
+
+	CrFwOutCmpDefSerialize(smDesc);
+	__atomic_fetch_add(&templateShard[CrDaStatShardId()].nOfMisses, 1, __ATOMIC_RELAXED);
+	/* The header becomes the template of its kind, destination and group */
+	i = __atomic_fetch_add(&nOfClaimed, 1, __ATOMIC_RELAXED);
+	if (i >= CR_DA_PCKT_TEMPLATE_N)
+		return;
+	t = &pcktTemplate[i];
+	t->servType = servType;
+	t->servSubType = servSubType;
+	t->discriminant = discriminant;
+	t->dest = dest;
+	t->group = group;
+	memcpy(t->header, pckt, CR_FW_PCKT_HEADER_LENGTH);
+	/* The templates are completed in the order in which they were claimed */
+	while (__atomic_load_n(&nOfTemplates, __ATOMIC_ACQUIRE) != i)
+		;
+	__atomic_store_n(&nOfTemplates, i+1, __ATOMIC_RELEASE);
+#else
+	CrFwOutCmpDefSerialize(smDesc);
+#endif
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaPcktTemplateReport(const char* app) {
+#if (CR_DA_PCKT_TEMPLATE == 1)
+	unsigned long long nOfHits = 0;
+	unsigned long long nOfMisses = 0;
+	int k;
+
+	for (k=0; k<CR_DA_STAT_N_OF_SHARDS; k++) {
+		nOfHits += __atomic_load_n(&templateShard[k].nOfHits, __ATOMIC_RELAXED);
+		nOfMisses += __atomic_load_n(&templateShard[k].nOfMisses, __ATOMIC_RELAXED);
+	}
+	if ((nOfHits == 0) && (nOfMisses == 0))
+		return;
+	printf("%s: Packet header templates: %u of %d templates, %llu headers copied, %llu serialized\n", app,
+	       nOfTemplates, CR_DA_PCKT_TEMPLATE_N, nOfHits, nOfMisses);
+#else
+	(void)app;
+#endif
+}
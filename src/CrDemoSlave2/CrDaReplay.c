@@ -0,0 +1,339 @@
+/**
+ * @file
+ * @ingroup crDemoSlave2
+ * Implementation of the replay transport of the demo applications of the CORDET Demo.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <time.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "CrDaReplay.h"
+#include "CrDaStreamMap.h"
+#include "CrDaCapture.h"
+/* Include FW Profile files */
+#include "FwSmConfig.h"
+#include "FwSmCore.h"
+#include "FwPrConfig.h"
+#include "FwPrCore.h"
+/* Include configuration files */
+#include "CrFwCmpData.h"
+/* Include framework files */
+#include "InStream/CrFwInStream.h"
+#include "OutStream/CrFwOutStream.h"
+#include "BaseCmp/CrFwBaseCmp.h"
+#include "Pckt/CrFwPckt.h"
+#include "CrFwPcktInline.h"
+#include "CrFwPcktPart.h"
+
+/** The name of the capture file. */
+static const char* replayFileName = "CrDaCapture.cap";
+
+/** Flag which is set if the capture is replayed at its original pacing. */
+static CrFwBool_t replayPaced = 1;
+
+/** The mapping of the capture file (NULL if it is not mapped). */
+static const unsigned char* replayBase = NULL;
+
+/** The size of the capture file. */
+static size_t replaySize = 0;
+
+/** The offset of the next record of the capture. */
+static size_t replayPos = 0;
+
+/** The time in the capture of the first replayed packet (UINT64_MAX until it is known). */
+static uint64_t replayFirst = UINT64_MAX;
+
+/** The time at which the first packet was replayed. */
+static struct timespec replayStart;
+
+/** The packet which has been framed and not yet collected. */
+static CrFwPckt_t pendingPckt = NULL;
+
+/** The number of replayed packets. */
+static unsigned long long nOfReplayed = 0;
+
+/** The number of packets discarded by the Packet Hand-Over Operation. */
+static unsigned long long nOfDiscarded = 0;
+
+/** The default Packet Available Function of the replay transport. */
+static void replayPcktAvail(CrFwDestSrc_t src);
+
+/** The Packet Available Function of the replay transport. */
+static void (*pcktAvail)(CrFwDestSrc_t src) = &replayPcktAvail;
+
+/**
+ * Frame the next packet of the capture into the Pending Packet if it is due.
+ * The records of the packets handed over by the capturing application are skipped.
+ * @param delay the location where the time in nanoseconds until the next packet is due
+ * is returned (it is not changed if the next packet is due or the capture has ended)
+ * @return 1 if there is a Pending Packet; 0 otherwise
+ */
+static CrFwBool_t replayFrame(long* delay);
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaReplaySetFile(const char* fileName) {
+	replayFileName = fileName;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaReplaySetPaced(CrFwBool_t paced) {
+	replayPaced = paced;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaReplayInitAction(FwPrDesc_t prDesc) {
+	CrFwCmpData_t* streamData = (CrFwCmpData_t*)FwPrGetData(prDesc);
+	const CrDaCaptureHeader_t* header;
+	const char* env;
+	struct stat st;
+	void* p;
+	int fd;
+
+	if (replayBase == NULL) {
+		env = getenv("CR_DA_REPLAY_FILE");
+		if (env != NULL)
+			replayFileName = env;
+		env = getenv("CR_DA_REPLAY_SPEED");
+		if (env != NULL)
+			replayPaced = (strcmp(env, "full") != 0);
+
+		fd = open(replayFileName, O_RDONLY);
+		if ((fd < 0) || (fstat(fd, &st) < 0)) {
+			perror("CrDaReplayInitAction, Capture file opening");
+			if (fd >= 0)
+				close(fd);
+			streamData->outcome = 0;
+			return;
+		}
+		if ((size_t)st.st_size < sizeof(CrDaCaptureHeader_t)) {
+			printf("CrDaReplayInitAction: %s is not a capture file\n", replayFileName);
+			close(fd);
+			streamData->outcome = 0;
+			return;
+		}
+		p = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		close(fd);
+		if (p == MAP_FAILED) {
+			perror("CrDaReplayInitAction, Capture file mapping");
+			streamData->outcome = 0;
+			return;
+		}
+		header = (const CrDaCaptureHeader_t*)p;
+		if ((header->magic != CR_DA_CAPTURE_MAGIC) || (header->version != CR_DA_CAPTURE_VERSION)) {
+			printf("CrDaReplayInitAction: %s is not a capture file of version %d\n", replayFileName,
+			       CR_DA_CAPTURE_VERSION);
+			munmap(p, (size_t)st.st_size);
+			streamData->outcome = 0;
+			return;
+		}
+
+		replayBase = (const unsigned char*)p;
+		replaySize = (size_t)st.st_size;
+		replayPos = sizeof(CrDaCaptureHeader_t);
+		replayFirst = UINT64_MAX;
+		pendingPckt = NULL;
+		printf("CrDaReplayInitAction: replaying %s (%s)\n", replayFileName, replayPaced ? "paced" : "full speed");
+	}
+
+	/* Execute default initialization action for OutStream/InStream */
+	if (streamData->typeId == CR_FW_INSTREAM_TYPE)
+		CrFwInStreamDefInitAction(prDesc);
+	else
+		CrFwOutStreamDefInitAction(prDesc);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaReplayConfigAction(FwPrDesc_t prDesc) {
+	CrFwCmpData_t* streamData = (CrFwCmpData_t*)FwPrGetData(prDesc);
+
+	if (pendingPckt != NULL) {
+		CrFwPcktRelease(pendingPckt);
+		pendingPckt = NULL;
+	}
+	replayPos = sizeof(CrDaCaptureHeader_t);
+	replayFirst = UINT64_MAX;
+
+	if (streamData->typeId == CR_FW_INSTREAM_TYPE)
+		CrFwInStreamDefConfigAction(prDesc);
+	else if (streamData->typeId == CR_FW_OUTSTREAM_TYPE)
+		CrFwOutStreamDefConfigAction(prDesc);
+	else {
+		perror("CrDaReplayConfigAction, Incorrect caller type");
+		return;
+	}
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaReplayShutdownAction(FwSmDesc_t smDesc) {
+	CrFwCmpData_t* streamData = (CrFwCmpData_t*)FwSmGetData(smDesc);
+
+	if (streamData->typeId == CR_FW_INSTREAM_TYPE)
+		CrFwInStreamDefShutdownAction(smDesc);
+	else
+		CrFwOutStreamDefShutdownAction(smDesc);
+
+	if (replayBase == NULL) 	/* Check if the capture file was already unmapped */
+		return;
+	if (pendingPckt != NULL) {
+		CrFwPcktRelease(pendingPckt);
+		pendingPckt = NULL;
+	}
+	printf("Replay: %llu packets replayed, %llu packets handed over and discarded\n", nOfReplayed, nOfDiscarded);
+	munmap((void*)replayBase, replaySize);
+	replayBase = NULL;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaReplayPoll() {
+	long delay;
+
+	if ((replayBase != NULL) && replayFrame(&delay))
+		pcktAvail(CrFwPcktGetSrc(pendingPckt));
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaReplayWait(unsigned int period) {
+	struct timespec req, now, end;
+	unsigned long long replayed = nOfReplayed;
+	long timeout, delay;
+
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	end.tv_sec = end.tv_sec + (time_t)(period/1000);
+	end.tv_nsec = end.tv_nsec + (long)(period%1000)*1000000L;
+	if (end.tv_nsec >= 1000000000L) {
+		end.tv_sec++;
+		end.tv_nsec = end.tv_nsec - 1000000000L;
+	}
+
+	for (;;) {
+		delay = -1;
+		if ((replayBase != NULL) && replayFrame(&delay))
+			pcktAvail(CrFwPcktGetSrc(pendingPckt));
+		if (nOfReplayed != replayed)
+			return 1;
+
+		clock_gettime(CLOCK_MONOTONIC, &now);
+		timeout = (long)(end.tv_sec - now.tv_sec)*1000000000L + (end.tv_nsec - now.tv_nsec);
+		if (timeout <= 0)
+			return 0;
+		/* Sleep until the next packet is due (a packet whose InStream is full is retried after 1 ms) */
+		if (delay < 0)
+			delay = (pendingPckt != NULL) ? 1000000L : timeout;
+		if (delay < timeout)
+			timeout = delay;
+		req.tv_sec = (time_t)(timeout/1000000000L);
+		req.tv_nsec = timeout%1000000000L;
+		while ((nanosleep(&req, &req) < 0) && (errno == EINTR))
+			;
+	}
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaReplaySetPcktAvail(void (*avail)(CrFwDestSrc_t src)) {
+	if (avail == NULL)
+		pcktAvail = &replayPcktAvail;
+	else
+		pcktAvail = avail;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwPckt_t CrDaReplayPcktCollect(CrFwDestSrc_t src) {
+	CrFwPckt_t pckt;
+	long delay;
+
+	if ((pendingPckt == NULL) || (CrFwPcktGetSrc(pendingPckt) != src))
+		return NULL;
+
+	pckt = pendingPckt;
+	pendingPckt = NULL;
+	nOfReplayed++;
+	replayFrame(&delay);	/* prepare the next packet if it is already due */
+	return pckt;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaReplayIsPcktAvail(CrFwDestSrc_t src) {
+	long delay;
+
+	if ((replayBase == NULL) || !replayFrame(&delay))
+		return 0;
+
+	return (CrFwPcktGetSrc(pendingPckt) == src);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaReplayPcktHandover(CrFwPckt_t pckt) {
+	(void)pckt;
+	nOfDiscarded++;
+	return 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void replayPcktAvail(CrFwDestSrc_t src) {
+	CrFwInStreamPcktAvail(CrDaStreamMapGetInStream(src));
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static CrFwBool_t replayFrame(long* delay) {
+	const CrDaCaptureRec_t* rec;
+	struct timespec now;
+	uint64_t elapsed;
+	CrFwPckt_t pckt;
+
+	if (pendingPckt != NULL)
+		return 1;
+
+	for (;;) {
+		if (replayPos + sizeof(CrDaCaptureRec_t) > replaySize)
+			return 0;	/* the capture has ended */
+		rec = (const CrDaCaptureRec_t*)(replayBase + replayPos);
+		if ((rec->len == 0) || (replayPos + sizeof(CrDaCaptureRec_t) + rec->len > replaySize))
+			return 0;
+		if (rec->dir == crDaCaptureRx)
+			break;
+		replayPos = replayPos + sizeof(CrDaCaptureRec_t) + ((rec->len + 7) & ~7u);
+	}
+
+	/* At the original pacing, the packet is due at the same time after the first packet as in the capture */
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	if (replayFirst == UINT64_MAX) {
+		replayFirst = rec->time;
+		replayStart = now;
+	}
+	if (replayPaced) {
+		elapsed = (uint64_t)(now.tv_sec - replayStart.tv_sec) * 1000000000ULL + (uint64_t)now.tv_nsec -
+		          (uint64_t)replayStart.tv_nsec;
+		if (rec->time - replayFirst > elapsed) {
+			*delay = (long)(rec->time - replayFirst - elapsed);
+			return 0;
+		}
+	}
+
+	/* Frame the packet directly into the packet pool */
+	pckt = CrFwPcktMakeInPart(CrFwPcktGetInStreamPart(CrFwPcktGetSrc((CrFwPckt_t)(rec + 1))),
+	                          (CrFwPcktLength_t)rec->len);
+	if (pckt == NULL)	/* retry when a packet becomes available */
+		return 0;
+	memcpy(pckt, rec + 1, rec->len);
+	replayPos = replayPos + sizeof(CrDaCaptureRec_t) + ((rec->len + 7) & ~7u);
+	pendingPckt = pckt;
+	return 1;
+}
@@ -0,0 +1,163 @@
+/**
+ * @file
+ * @ingroup crDemoSlave2
+ * Interface for the replay transport of the demo applications of the CORDET Demo.
+ * The replay transport feeds the packets of a capture file (see <code>CrDaCapture.h</code>)
+ * back into the InStreams of an application so that recorded traffic can be profiled
+ * offline against a new build without the other applications.
+ * It is selected through the switch <code>#CR_DA_REPLAY</code> and it customizes the
+ * InStreams and OutStreams in the same way as the socket modules:
+ * - Function <code>::CrDaReplayInitAction</code> should be used as the Initialization
+ *   Action of the InStreams and OutStreams.
+ * - Function <code>::CrDaReplayConfigAction</code> should be used as the Configuration
+ *   Action of the InStreams and OutStreams.
+ * - Function <code>::CrDaReplayShutdownAction</code> should be used as the Shutdown Action
+ *   of the InStreams and OutStreams.
+ * - Function <code>::CrDaReplayPcktCollect</code> should be used as the Packet Collect
+ *   Operation of the InStreams.
+ * - Function <code>::CrDaReplayIsPcktAvail</code> should be used as the Packet Available
+ *   Check Operation of the InStreams.
+ * - Function <code>::CrDaReplayPcktHandover</code> should be used as the Packet Hand-Over
+ *   Operation of the OutStreams.
+ * .
+ * The replay transport can also be used as the transport of the I/O thread (see
+ * <code>CrDaIoThread.h</code>).
+ *
+ * Only the packets which the capturing application collected from the middleware are
+ * replayed, in the order in which they were captured.
+ * The packets which the application hands over to the replay transport are counted and
+ * discarded.
+ * The capture is replayed either at its original pacing (the default: each packet
+ * becomes available at the same time after the first packet as in the capture) or at
+ * full speed (each packet becomes available as soon as its predecessor has been
+ * collected).
+ * The capture file and the pacing are set with <code>::CrDaReplaySetFile</code> and
+ * <code>::CrDaReplaySetPaced</code> and they can be overridden through the environment
+ * variables <code>CR_DA_REPLAY_FILE</code> and <code>CR_DA_REPLAY_SPEED</code> (set to
+ * <code>full</code> or <code>paced</code>).
+ *
+ * The capture file is mapped into memory when the first InStream or OutStream is
+ * initialized and the replay restarts from its first packet when the streams are reset.
+ *
+ * The functions in this module should be accessed in mutual exclusion.
+ * Compliance with this constraint is not enforced and is therefore under the responsibility
+ * of the caller.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRDA_REPLAY_H_
+#define CRDA_REPLAY_H_
+
+/* Include Framework Files */
+#include "CrFwConstants.h"
+/* Include Configuration Files */
+#include "CrFwUserConstants.h"
+#include "CrDaConstants.h"
+/* Include FW Profile files */
+#include "FwSmConstants.h"
+#include "FwPrConstants.h"
+
+/**
+ * Set the capture file which is replayed.
+ * This function must be called before the InStreams and OutStreams are initialized.
+ * @param fileName the name of the capture file (it must remain valid)
+ */
+void CrDaReplaySetFile(const char* fileName);
+
+/**
+ * Set the pacing of the replay.
+ * @param paced 1 to replay the capture at its original pacing; 0 to replay it at full
+ * speed
+ */
+void CrDaReplaySetPaced(CrFwBool_t paced);
+
+/**
+ * Initialization action for the replay transport.
+ * If the capture file has not yet been mapped, it is mapped and its header is checked.
+ * The action then executes the Initialization Action of the base InStream/OutStream.
+ * If the capture file cannot be mapped or is not a capture file, the outcome of the
+ * action is set to 0.
+ * @param prDesc the initialization procedure descriptor
+ */
+void CrDaReplayInitAction(FwPrDesc_t prDesc);
+
+/**
+ * Configuration action for the replay transport.
+ * This action releases the Pending Packet, restarts the replay from the first packet
+ * of the capture and executes the Configuration Action of the base InStream/OutStream.
+ * @param prDesc the configuration procedure descriptor
+ */
+void CrDaReplayConfigAction(FwPrDesc_t prDesc);
+
+/**
+ * Shutdown action for the replay transport.
+ * This action executes the Shutdown Action of the base InStream/OutStream and, if the
+ * capture file is still mapped, it releases the Pending Packet, prints the number of
+ * replayed and discarded packets and unmaps the capture file.
+ * @param smDesc the state machine descriptor
+ */
+void CrDaReplayShutdownAction(FwSmDesc_t smDesc);
+
+/**
+ * Poll the capture for the next packet.
+ * If the next packet of the capture is due, it is framed into the Pending Packet and
+ * the Packet Available Function is called with its source (by default, the function
+ * calls <code>::CrFwInStreamPcktAvail</code> on the InStream associated to the source).
+ */
+void CrDaReplayPoll();
+
+/**
+ * Wait for the argument period while replaying the capture.
+ * The function sleeps until the next packet of the capture is due or until the period
+ * has elapsed and it returns as soon as one or more packets have been collected by their
+ * InStream (see <code>CrDaCycle.h</code>).
+ * @param period the wait period in milliseconds
+ * @return 1 if the function returned before the end of the period because packets
+ * were collected by their InStream; 0 if the period has elapsed
+ */
+CrFwBool_t CrDaReplayWait(unsigned int period);
+
+/**
+ * Set the Packet Available Function of the replay transport.
+ * @param avail the Packet Available Function or NULL to restore the default function
+ */
+void CrDaReplaySetPcktAvail(void (*avail)(CrFwDestSrc_t src));
+
+/**
+ * Function implementing the Packet Collect Operation for the replay transport.
+ * If the Pending Packet has a source attribute equal to <code>src</code>, it is handed
+ * over to the caller and the next packet of the capture is framed if it is due.
+ * Otherwise, the function returns NULL.
+ * @param src the source associated to the InStream
+ * @return the packet or NULL
+ */
+CrFwPckt_t CrDaReplayPcktCollect(CrFwDestSrc_t src);
+
+/**
+ * Function implementing the Packet Available Check Operation for the replay transport.
+ * @param src the source associated to the InStream
+ * @return 1 if the next packet of the capture is due and has the argument source; 0
+ * otherwise
+ */
+CrFwBool_t CrDaReplayIsPcktAvail(CrFwDestSrc_t src);
+
+/**
+ * Function implementing the hand-over operation for the replay transport.
+ * The packet is counted and discarded.
+ * @param pckt the packet to be handed over
+ * @return always 1
+ */
+CrFwBool_t CrDaReplayPcktHandover(CrFwPckt_t pckt);
+
+#endif /* CRDA_REPLAY_H_ */
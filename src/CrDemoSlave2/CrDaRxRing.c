@@ -0,0 +1,150 @@
+/**
+ * @file
+ * @ingroup crDemoSlave2
+ * Implementation of the receive ring buffer for the socket connections.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <sys/uio.h>
+#include "CrDaRxRing.h"
+/* Include framework files */
+#include "Pckt/CrFwPckt.h"
+#include "CrFwPcktInline.h"
+
+/**
+ * Copy bytes out of a ring buffer without removing them.
+ * @param ring the ring buffer
+ * @param dest the destination of the copy
+ * @param n the number of bytes to be copied (must not exceed the number of bytes in the ring buffer)
+ */
+static void rxRingPeek(CrDaRxRing_t* ring, unsigned char* dest, unsigned int n) {
+	unsigned int first = ring->size - ring->head;
+
+	if (n <= first) {
+		memcpy(dest, ring->buf+ring->head, n);
+		return;
+	}
+	memcpy(dest, ring->buf+ring->head, first);
+	memcpy(dest+first, ring->buf, n-first);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaRxRingInit(CrDaRxRing_t* ring, unsigned int size) {
+	ring->buf = malloc(size*sizeof(unsigned char));
+	ring->size = size;
+	ring->head = 0;
+	ring->count = 0;
+	return (ring->buf != NULL);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaRxRingFree(CrDaRxRing_t* ring) {
+	free(ring->buf);
+	ring->buf = NULL;
+	ring->size = 0;
+	ring->count = 0;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaRxRingClear(CrDaRxRing_t* ring) {
+	ring->head = 0;
+	ring->count = 0;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+int CrDaRxRingFill(CrDaRxRing_t* ring, int fd) {
+	struct iovec iov[2];
+	unsigned int tail;
+	int nOfIov;
+	int n;
+
+	if (ring->count == ring->size)	/* the ring buffer is full */
+		return -1;
+
+	/* The free space may be split in two segments by the end of the storage area */
+	tail = (ring->head + ring->count) % ring->size;
+	iov[0].iov_base = ring->buf + tail;
+	if (tail >= ring->head) {
+		iov[0].iov_len = ring->size - tail;
+		iov[1].iov_base = ring->buf;
+		iov[1].iov_len = ring->head;
+		nOfIov = (ring->head > 0) ? 2 : 1;
+	} else {
+		iov[0].iov_len = ring->head - tail;
+		nOfIov = 1;
+	}
+
+	n = readv(fd, iov, nOfIov);
+	if (n > 0)
+		ring->count = ring->count + (unsigned int)n;
+	return n;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+unsigned int CrDaRxRingPut(CrDaRxRing_t* ring, const unsigned char* src, unsigned int n) {
+	unsigned int tail, first;
+
+	if (n > ring->size - ring->count)
+		n = ring->size - ring->count;
+
+	/* The free space may be split in two segments by the end of the storage area */
+	tail = (ring->head + ring->count) % ring->size;
+	first = ring->size - tail;
+	if (n <= first)
+		memcpy(ring->buf+tail, src, n);
+	else {
+		memcpy(ring->buf+tail, src, first);
+		memcpy(ring->buf, src+first, n-first);
+	}
+	ring->count = ring->count + n;
+	return n;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaRxRingGet(CrDaRxRing_t* ring, unsigned char* dest, unsigned int n) {
+	if (ring->count < n)
+		return 0;
+
+	rxRingPeek(ring, dest, n);
+	ring->head = (ring->head + n) % ring->size;
+	ring->count = ring->count - n;
+	if (ring->count == 0)
+		ring->head = 0;
+	return 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+int CrDaRxRingPeekPckt(CrDaRxRing_t* ring, unsigned char* hdr, unsigned int hdrLength,
+                       unsigned int maxLength, unsigned int trailerLength, unsigned int* len) {
+	CrFwPcktLength_t lengthField;
+
+	if (ring->count < sizeof(CrFwPcktLength_t))
+		return 0;
+
+	/* Read the length field through the packet interface */
+	rxRingPeek(ring, (unsigned char*)&lengthField, sizeof(CrFwPcktLength_t));
+	*len = CrFwPcktGetLength((CrFwPckt_t)&lengthField);
+	if ((*len < hdrLength) || (*len > maxLength)) {
+		CrDaRxRingClear(ring);
+		return -1;
+	}
+
+	if (ring->count < *len + trailerLength)	/* the packet is not yet complete */
+		return 0;
+
+	rxRingPeek(ring, hdr, hdrLength);
+	return 1;
+}
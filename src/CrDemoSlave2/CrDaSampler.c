@@ -0,0 +1,192 @@
+/**
+ * @file
+ * @ingroup crDemoSlave2
+ * Implementation of the sampler of the Slave Applications of the CORDET Demo.
+ * The head and the tail of the ring count the rounds which have been published and
+ * released since the start of the sampler: the head is only written by the sampler thread
+ * and the tail only by the thread of the control cycles.
+ * A round is published with a release store of the head after its samples have been
+ * written and its slot is released with a release store of the tail after its samples
+ * have been read.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdio.h>
+#include <errno.h>
+#include <time.h>
+#include <pthread.h>
+#include "CrDaSampler.h"
+#include "CrDaTempMonitor.h"
+#include "CrDaThread.h"
+
+#if ((CR_DA_SAMPLER_N_OF_SLOTS & (CR_DA_SAMPLER_N_OF_SLOTS-1)) != 0)
+#error "CR_DA_SAMPLER_N_OF_SLOTS must be a power of two"
+#endif
+
+/** Type for a slot of the ring of the sampler. */
+typedef struct {
+	/** The number of channels of the round. */
+	unsigned int nOfChannels;
+	/** The samples of the round. */
+	char temp[CR_DA_TEMP_N_OF_CHANNELS];
+} CrDaSamplerSlot_t;
+
+/** The slots of the ring. */
+static CrDaSamplerSlot_t samplerSlot[CR_DA_SAMPLER_N_OF_SLOTS];
+
+/** The number of rounds which have been published (written by the sampler thread). */
+static unsigned long long samplerHead = 0;
+
+/** The number of rounds which have been released (written by the thread of the control cycles). */
+static unsigned long long samplerTail = 0;
+
+/** The acquisition function. */
+static CrDaSamplerAcquire_t samplerAcquire = NULL;
+
+/** The rate of the sampler in rounds per second. */
+static unsigned int samplerRate = 0;
+
+/** The number of rounds after which the sampler stops acquiring (zero for no limit). */
+static unsigned long long samplerNOfRounds = 0;
+
+/** The number of rounds which were due but could not be acquired because the ring was full. */
+static unsigned long long nOfDropped = 0;
+
+/** The maximum number of published rounds which were waiting to be consumed. */
+static unsigned int maxBacklog = 0;
+
+/** Flag which is set while the sampler thread is running. */
+static CrFwBool_t samplerIsRunning = 0;
+
+/** Flag which is set when the sampler has been started. */
+static CrFwBool_t samplerStarted = 0;
+
+/** Flag which requests the sampler thread to stop. */
+static CrFwBool_t samplerStop = 0;
+
+/** The sampler thread. */
+static pthread_t samplerThread;
+
+/**
+ * The function executed by the sampler thread.
+ * @param arg unused
+ * @return always NULL
+ */
+static void* samplerThreadRun(void* arg);
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaSamplerStart(CrDaSamplerAcquire_t acquire, unsigned int rate, unsigned long long nOfRounds) {
+#if (CR_DA_SAMPLER == 1)
+	int err;
+
+	if (samplerIsRunning || (rate == 0))
+		return 0;
+
+	samplerAcquire = acquire;
+	samplerRate = rate;
+	samplerNOfRounds = nOfRounds;
+	samplerStop = 0;
+	err = pthread_create(&samplerThread, NULL, &samplerThreadRun, NULL);
+	if (err != 0) {
+		errno = err;
+		perror("CrDaSamplerStart, thread creation");
+		return 0;
+	}
+	samplerIsRunning = 1;
+	samplerStarted = 1;
+	return 1;
+#else
+	(void)acquire;
+	(void)rate;
+	(void)nOfRounds;
+	return 0;
+#endif
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+unsigned int CrDaSamplerConsume(CrFwDestSrc_t appId) {
+	unsigned long long head = __atomic_load_n(&samplerHead, __ATOMIC_ACQUIRE);
+	unsigned long long tail = samplerTail;
+	CrDaSamplerSlot_t* slot;
+	unsigned int nOfFail = 0;
+
+	if (head - tail > maxBacklog)
+		maxBacklog = (unsigned int)(head - tail);
+	for (; tail<head; tail++) {
+		slot = &samplerSlot[tail % CR_DA_SAMPLER_N_OF_SLOTS];
+		nOfFail += CrDaTempMonitoringExecMulti(slot->temp, slot->nOfChannels, appId);
+		/* The slot may be written again by the sampler */
+		__atomic_store_n(&samplerTail, tail+1, __ATOMIC_RELEASE);
+	}
+	return nOfFail;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaSamplerStop() {
+	if (!samplerIsRunning)
+		return;
+	__atomic_store_n(&samplerStop, 1, __ATOMIC_RELEASE);
+	pthread_join(samplerThread, NULL);
+	samplerIsRunning = 0;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaSamplerReport(const char* app) {
+#if (CR_DA_SAMPLER == 1)
+	if (!samplerStarted)
+		return;
+	printf("%s: Sampler: %llu rounds acquired at %u/s, %llu consumed, %llu dropped (ring full), backlog max %u of %d\n",
+	       app, samplerHead, samplerRate, samplerTail, nOfDropped, maxBacklog, CR_DA_SAMPLER_N_OF_SLOTS);
+#else
+	(void)app;
+#endif
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void* samplerThreadRun(void* arg) {
+	struct timespec start, due;
+	unsigned long long round, offset, head;
+	CrDaSamplerSlot_t* slot;
+	(void)arg;
+
+	CrDaThreadPlace(crDaThreadAux);
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	head = samplerHead;
+	for (round=0; (samplerNOfRounds == 0) || (round < samplerNOfRounds); round++) {
+		/* Wait for the time of the round on the schedule anchored at the start */
+		offset = (round * 1000000000ULL) / samplerRate;
+		due.tv_sec = start.tv_sec + (time_t)(offset / 1000000000ULL);
+		due.tv_nsec = start.tv_nsec + (long)(offset % 1000000000ULL);
+		if (due.tv_nsec >= 1000000000L) {
+			due.tv_sec++;
+			due.tv_nsec -= 1000000000L;
+		}
+		while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &due, NULL) == EINTR)
+			;
+		if (__atomic_load_n(&samplerStop, __ATOMIC_ACQUIRE))
+			break;
+
+		if (head - __atomic_load_n(&samplerTail, __ATOMIC_ACQUIRE) >= CR_DA_SAMPLER_N_OF_SLOTS) {
+			/* The control cycles have fallen behind by a full ring */
+			__atomic_fetch_add(&nOfDropped, 1, __ATOMIC_RELAXED);
+			continue;
+		}
+		slot = &samplerSlot[head % CR_DA_SAMPLER_N_OF_SLOTS];
+		slot->nOfChannels = samplerAcquire(round, slot->temp);
+		head++;
+		/* The round is complete before it is published */
+		__atomic_store_n(&samplerHead, head, __ATOMIC_RELEASE);
+	}
+	return NULL;
+}
@@ -0,0 +1,97 @@
+/**
+ * @file
+ * @ingroup crDemoSlave2
+ * Interface for the sampler of the Slave Applications of the CORDET Demo.
+ * By default, the temperature samples are acquired by the control cycles: the acquisition
+ * rate is then tied to the period of the cycles and a cycle which overruns delays the
+ * acquisition.
+ * If the sampler is selected (see <code>#CR_DA_SAMPLER</code>), the samples are instead
+ * acquired by a sampler thread at their own rate (<code>::CrDaSamplerStart</code>) and the
+ * control cycles consume the rounds of samples which have been acquired since the previous
+ * cycle (<code>::CrDaSamplerConsume</code>).
+ *
+ * A round holds the samples of all channels at one point of the schedule of the sampler.
+ * The rounds are handed over through a ring of <code>#CR_DA_SAMPLER_N_OF_SLOTS</code>
+ * slots with one producer (the sampler thread) and one consumer (the thread of the
+ * control cycles): the sampler thread acquires a round directly in the next free slot
+ * and then publishes it by advancing the head of the ring; the control cycle passes the
+ * published rounds to <code>::CrDaTempMonitoringExecMulti</code> in the order in which
+ * they were acquired and then releases their slots by advancing the tail of the ring.
+ * Neither side takes a lock or waits for the other: a slot is only written while it is
+ * free and only read while it is published, so that a round is never torn.
+ * If the control cycles fall behind by a full ring, the sampler does not acquire the
+ * rounds which are due until a slot is released: these rounds are dropped and counted.
+ *
+ * The rounds are acquired by an acquisition function of the application (a function of
+ * type <code>::CrDaSamplerAcquire_t</code>) on a schedule of a given rate which is
+ * anchored at the start of the sampler: a round which is late is acquired as soon as
+ * possible so that the rounds are not lost to the jitter of the sampler thread.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRDA_SAMPLER_H_
+#define CRDA_SAMPLER_H_
+
+/* Include Framework Files */
+#include "CrFwConstants.h"
+/* Include Configuration Files */
+#include "CrFwUserConstants.h"
+#include "CrDaConstants.h"
+
+/**
+ * Type for the acquisition function of the sampler.
+ * The function is called by the sampler thread.
+ * @param round the number of the round since the start of the sampler
+ * @param temp the samples of the round (output, room for <code>#CR_DA_TEMP_N_OF_CHANNELS</code>
+ * samples): sample i is the sample of channel i
+ * @return the number of channels of the round
+ */
+typedef unsigned int (*CrDaSamplerAcquire_t)(unsigned long long round, char* temp);
+
+/**
+ * Start the sampler thread.
+ * Nothing is done if the sampler is not selected or if it is already running.
+ * @param acquire the acquisition function
+ * @param rate the rate in rounds per second
+ * @param nOfRounds the number of rounds after which the sampler stops acquiring (zero for
+ * no limit)
+ * @return 1 if the sampler was started; 0 otherwise
+ */
+CrFwBool_t CrDaSamplerStart(CrDaSamplerAcquire_t acquire, unsigned int rate, unsigned long long nOfRounds);
+
+/**
+ * Pass the rounds which have been acquired since the previous call to the temperature
+ * monitoring (<code>::CrDaTempMonitoringExecMulti</code>) and release their slots.
+ * This function must only be called by the thread of the control cycles.
+ * It never waits for the sampler thread.
+ * @param appId the application identifier of the host application
+ * @return the number of reports which could not be made
+ */
+unsigned int CrDaSamplerConsume(CrFwDestSrc_t appId);
+
+/**
+ * Stop the sampler thread.
+ * Nothing is done if the sampler is not running.
+ */
+void CrDaSamplerStop();
+
+/**
+ * Print the number of rounds which have been acquired, consumed and dropped and the
+ * maximum number of rounds which were waiting in the ring.
+ * Nothing is printed if the sampler has not been started.
+ * @param app the name of the application (e.g. "S1")
+ */
+void CrDaSamplerReport(const char* app);
+
+#endif /* CRDA_SAMPLER_H_ */
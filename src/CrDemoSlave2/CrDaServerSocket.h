@@ -34,53 +34,138 @@
  * The socket controlled by this module is built as a server socket using the Internet domain
  * and the TCP protocol.
  * It is designed to work with the client socket of <code>CrDaClientSocket.h</code>.
- * The socket expects two client connections.
+ * The socket accepts up to <code>#CR_DA_SERVER_SOCKET_MAX_NOF_CLIENTS</code> client connections.
  *
  * The socket must be initialized with the port number for its socket (this is defined through
  * functions <code>::CrDaClientSocketSetPort</code>.
  *
- * In the initialization process of this module, a socket is bound and listening starts on it.
- * A thread is then spawned which waits for incoming connections from its two client sockets.
- * When the incoming connections have been accepted, the socket is ready to complete
- * its configuration.
+ * In the initialization process of this module, a non-blocking socket is bound and listening
+ * starts on it.
+ * Incoming connection requests are accepted whenever the socket is polled and whenever
+ * its configuration check is executed.
+ * The socket is ready to complete its configuration when the number of client
+ * connections set with <code>::CrDaServerSocketSetNOfClients</code> have been accepted.
+ * Function <code>::CrDaServerSocketWaitClients</code> waits until this is the case: an
+ * application can therefore configure its InStreams and OutStreams as soon as its last
+ * client has connected, irrespective of the order in which the applications are started.
+ *
+ * The first data which a client sends on its connection is its application identifier
+ * (one value of type <code>CrFwDestSrc_t</code>).
+ * The server socket maintains a routing table which maps an application identifier
+ * to the connection of the client which has announced it.
+ * The table is used to select in constant time the connection on which a packet
+ * is handed over (on the basis of its destination) and the connection from which
+ * a packet is collected (on the basis of its source).
+ * Packets cannot be sent to a client before it has announced its application identifier.
+ *
+ * If a client has several connections (see <code>#CR_DA_SOCKET_N_OF_CONNS</code>), it
+ * announces the index of each connection (one byte) after its application identifier and
+ * the routing table maps the application identifier to all its connections.
+ * A packet is then sent on the connection of its group
+ * (<code>#CR_DA_SOCKET_CONN_OF_GROUP</code>) or, until the client has established that
+ * connection, on its first connection.
+ * The packets of one group therefore stay in order while the groups do not wait for
+ * each other.
+ * A connection which is closed by its client is released and its entry is removed
+ * from the routing table.
  *
  * The socket assumes a polling approach for incoming packets: function
  * <code>::CrDaServerSocketPoll</code> should be called periodically
  * by an external scheduler.
  * This function performs a non-blocking read on the socket to check whether a packet
- * is available at the socket from either of its clients.
+ * is available at the socket from any of its clients.
  * If a packet is available, the function retrieves its source and forwards it to
  * the associated InStream by calling function <code>::CrFwInStreamPcktAvail</code>
  * on the InStream to signal the arrival of a new packet.
  * This causes all pending packets from that source to be collected by the InStream and
  * stored in its Packet Queue.
  *
- * The implementation of this module assumes that, at each read operation, an entire
- * packet is received.
- * The situation where the packet is split into fragments during the transmission
- * process is not handled.
- * In practice, this socket is intended for the case where the socket is local
- * to the host platform (i.e. where the host name is "localhost" and both sender
- * and receiver of a packet are located on the same platform).
+ * If the epoll backend is selected (see <code>#CR_DA_SOCKET_EPOLL</code>), the
+ * socket connections are registered with an edge-triggered epoll instance and
+ * a connection is only read when the epoll instance has reported new data on it.
+ * Idle connections therefore cause no read operations.
+ * The epoll instance also allows the caller to sleep until data arrive through
+ * function <code>::CrDaServerSocketWait</code>.
+ *
+ * The bytes which are read from the socket are accumulated in a receive ring buffer
+ * (see <code>CrDaRxRing.h</code>) and packets are framed on the basis of the length
+ * field in their header.
+ * Hence, a single read operation may deliver several packets or only a fragment of
+ * a packet: the packets are extracted from the ring one at a time and a fragment is
+ * kept in the ring until the rest of the packet has been received.
+ * If the length field of a received packet is illegal, the content of the ring is
+ * discarded.
  *
- * Packets which are read from the socket are stored in a buffer (the <i>Read Buffer</i>).
- * This is an array of bytes whose size is equal to the maximum size of a
- * middleware packet.
- * The Read Buffer can be either "full" (if its first byte is different from zero)
- * or "empty" (if its first byte has been cleared).
- * Two Read Buffers are instantiated, one for each client.
+ * The complete packets of the ring are framed directly into packets of the packet
+ * pool (the <i>Pending Packets</i>) which are charged to the partition of the InStream
+ * of their source (see <code>CrFwPcktPart.h</code>).
+ * The packet collect operation hands the first Pending Packet from its source over to
+ * the InStream without copying it: the packets from one source are collected in the
+ * order of their arrival but a packet which is not collected (e.g. because the InStream
+ * of its source is full) does not hold up the packets from the other sources of its
+ * connection.
+ * If no packet can be allocated from the packet pool, the packet is left in the ring
+ * and framing is attempted again at the next poll.
+ * One receive ring buffer and up to <code>#CR_DA_SERVER_SOCKET_RX_QUEUE_SIZE</code> Pending
+ * Packets are held for each client connection.
+ * The connection is read until the kernel has no more data for it, its ring is full or
+ * its Pending Packets are full.
  *
  * The packet hand-over operation for OutStreams is implemented in function
- * <code>::CrDaServerSocketPcktHandover</code> which performs a non-blocking write
- * to the socket.
+ * <code>::CrDaServerSocketPcktHandover</code> which retains the packet, adds it to
+ * the transmit queue of a client connection and performs a non-blocking write of the queue to the socket.
+ * The transmit queue keeps the bytes which the socket does not accept (partial writes
+ * and writes which fail with <code>EAGAIN</code> because the kernel buffer is full).
+ * These bytes are written before any new packet when the queue is next flushed.
+ * The packets are released after they have been completely written to the socket.
+ * If the transmit queue is full and cannot be flushed, the hand-over operation fails.
+ * The OutStream then keeps the packet in its packet queue and retries at the next
+ * flush: a full kernel buffer causes backpressure rather than the loss of a packet.
+ * The transmit queue is also flushed by <code>::CrDaServerSocketFlush</code> (which is called
+ * at the start of <code>::CrDaServerSocketWait</code>) and, if the epoll backend is used,
+ * when the socket becomes writable again.
+ *
+ * If the io_uring backend is selected (see <code>#CR_DA_SOCKET_URING</code>), the
+ * socket operations are performed by an io_uring instance (see <code>CrDaUring.h</code>):
+ * - Connection requests are accepted by a multishot accept operation.
+ * - Each connection has a multishot receive operation which stores the received bytes
+ *   in buffers provided to the kernel; these buffers are moved into the receive ring
+ *   buffer of the connection when it is polled and are then given back to the kernel.
+ *   If all provided buffers are held by the connections, the receive operations
+ *   terminate and they are armed again when buffers are given back.
+ * - The transmit queue of each connection is sent by one gather send operation
+ *   which refers to the packets in the packet pool without copying them.
+ * .
+ * Function <code>::CrDaServerSocketPoll</code> then only reads the completion queue
+ * and makes no system call, the hand-over operation (with batched writes) only adds
+ * the packet to the transmit queue, and function <code>::CrDaServerSocketWait</code>
+ * submits the send operations of all connections and waits for new data with one
+ * system call.
+ * A cycle of an idle application therefore makes one system call.
+ *
+ * If batched writes are selected (see <code>#CR_DA_SOCKET_TX_BATCH</code>), the
+ * hand-over operation only adds the packet to the transmit queue which is written
+ * to the socket with a single <code>sendmsg</code> call when it is flushed at the end
+ * of the control cycle, when it holds <code>#CR_DA_TX_QUEUE_FLUSH_BYTES</code> bytes or
+ * when it is full.
+ * The number of write operations therefore grows with the number of flushes
+ * rather than with the number of packets: normally, one write per connection and cycle.
+ * The transmit queue holds up to <code>#CR_DA_TX_QUEUE_NOF_PCKTS</code> packets.
  *
  * If an error is encountered while performing a system call, this module uses function
  * <code>perror</code> to print an error message and, if the error was encountered
  * in the initialization or configuration action, it sets the outcome of the action
  * to 0 ("failure") and returns.
  *
- * This module assumes that the maximum length of a packet is smaller than 256 bytes.
- * Compliance with this constraint is verified in the Initialization Check.
+ * The capacity of the receive ring buffer is <code>#CR_DA_RX_RING_NOF_PCKTS</code> times
+ * the maximum length of a packet.
+ *
+ * The listening socket is created with <code>SO_REUSEADDR</code> so that the server can be
+ * restarted while the connections of its previous run are in <code>TIME_WAIT</code>.
+ * The socket options of the tuning profile selected with <code>::CrDaSocketSetProfile</code>
+ * (see <code>CrDaSocketProfile.h</code>) are applied to the listening socket and to each
+ * client connection when it is accepted.
+ * A message is printed if some of them did not take effect on a client connection.
  *
  * <b>Mode of Use of a Server Socket Module</b>
  *
@@ -91,13 +176,14 @@
  * The socket is shut down whenever one of the InStreams/OutStreams is shut down
  * (the shutdown of the other InStreams/OutStreams has no effect).
  *
- * After creation, the user must define the port number for the socket.
- * This is done through function <code>::CrDaServerSocketSetPort</code>.
+ * After creation, the user must define the port number for the socket and the number
+ * of client connections which are required for its configuration.
+ * This is done through functions <code>::CrDaServerSocketSetPort</code> and
+ * <code>::CrDaServerSocketSetNOfClients</code>.
  * After this is done, the socket can be initialized and configured.
- * During the initialization process, a thread is spawned which waits for a client socket
- * to be connected to it.
- * The server socket can only be successfully configured after this thread has accepted the
- * connection from the client socket.
+ * The server socket can only be successfully configured after the required number of
+ * client sockets have connected to it.
+ * Further client sockets may connect at any time after the configuration.
  *
  * @image html DA_PhysicalLinks.png
  * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
@@ -133,10 +219,9 @@
  * If the server socket has already been initialized, this function calls the
  * Initialization Action of the base InStream/OutStream and then returns.
  * If the server socket has not yet been initialized, this action:
+ * - clears the connection and routing tables
  * - creates and binds the socket
- * - start listening on the socket
- * - spawns a thread which waits for an incoming connection from, first, the client socket
- *   of the Master Application and, then, the client socket of the Slave 2 Application
+ * - start listening on the socket in non-blocking mode
  * - execute the Initialization Action of the base InStream/OutStream
  * .
  * The function sets the outcome to "success" if all these operations are successful.
@@ -153,8 +238,9 @@ void CrDaServerSocketInitCheck(FwPrDesc_t prDesc);
 
 /**
  * Configuration check for the server socket.
- * The check is successful if the connection from the matching client socket has been successfully
- * accepted.
+ * The check accepts any pending connection requests and is successful if the number of
+ * accepted client connections is not smaller than the number set with
+ * <code>::CrDaServerSocketSetNOfClients</code>.
  * @param prDesc the initialization procedure descriptor.
  */
 void CrDaServerSocketConfigCheck(FwPrDesc_t prDesc);
@@ -164,7 +250,8 @@ void CrDaServerSocketConfigCheck(FwPrDesc_t prDesc);
  * If the server socket has already been shut down, this function calls the
  * Shutdown Action of the base InStream/OutStream and then returns.
  * If the client socket has not yet been shut down, this action executes
- * the Shutdown Action of the base OutStream/InStream and then closes the socket.
+ * the Shutdown Action of the base OutStream/InStream, closes the client connections,
+ * releases their Pending Packets and receive ring buffers and then closes the socket.
  * @param smDesc the OutStream State Machine descriptor (this parameter
  * is not used).
  */
@@ -172,52 +259,117 @@ void CrDaServerSocketShutdownAction(FwSmDesc_t smDesc);
 
 /**
  * Function implementing the hand-over operation for the server socket.
- * This function performs a non-blocking write on the socket and, if it succeeds,
- * it returns 1; otherwise, it returns 0.
- * the client socket to which the write operation is made depends on the
- * destination of the argument packet.
+ * This function adds the packet to the transmit queue of a client connection and
+ * flushes the queue.
+ * If batched writes are selected (see <code>#CR_DA_SOCKET_TX_BATCH</code>), the queue
+ * is only flushed when it is full or when it holds <code>#CR_DA_TX_QUEUE_FLUSH_BYTES</code>
+ * bytes.
+ * The client connection is retrieved from the routing table on the basis of the
+ * destination and of the group of the argument packet.
+ * If no client has announced the destination, the function returns 0.
+ * If the write operation finds that the client has closed its connection, the
+ * connection is released and the function returns 0.
+ * Otherwise, the function returns 1 if the packet was added to the transmit queue;
+ * the bytes which the socket does not accept immediately remain in the queue.
+ * If the transmit queue is full and cannot be flushed, the function returns 0 and the
+ * OutStream keeps the packet.
  * @param pckt the packet to be written to the socket
- * @return 1 if the packet was successfully written to the socket; 0 otherwise.
+ * @return 1 if the packet was accepted by the transmit queue; 0 otherwise.
  */
 CrFwBool_t CrDaServerSocketPcktHandover(CrFwPckt_t pckt);
 
+/**
+ * Write the packets in the transmit queues of the client connections to their sockets.
+ * The function performs one non-blocking <code>sendmsg</code> call for each client
+ * connection whose transmit queue is not empty.
+ * Packets which could not be completely written remain in their queue and are written
+ * at the next flush.
+ * If the write operation finds that a client has closed its connection, the
+ * connection is released.
+ * If the io_uring backend is used, the send operations of all connections are
+ * submitted with one system call.
+ */
+void CrDaServerSocketFlush();
+
 /**
  * Configuration action for the server socket.
- * This action clears the Read Buffer and executes the Configuration Action of
- * the base InStream/OutStream.
+ * This action releases the Pending Packets and clears the receive ring buffers of the client
+ * connections which have announced their application identifier and executes the
+ * Configuration Action of the base InStream/OutStream.
  * @param prDesc the configuration procedure descriptor.
  */
 void CrDaServerSocketConfigAction(FwPrDesc_t prDesc);
 
 /**
- * Poll the server socket to check whether a new packet has arrived from either
+ * Poll the server socket to check whether a new packet has arrived from any
  * client.
  * This function should be called periodically by an external scheduler.
- * If there is a pending packet (i.e. if a Read Buffer is full), its source
- * is determined, and then function <code>::CrFwInStreamPcktAvail</code> is
- * called on the InStream associated to that packet source.
- * If there is no pending packet, a non-blocking read is performed from each
- * client to check whether a packet is available from that client.
- * If a packet is available, it is placed into the Read Buffer, its source
- * is determined, and then function <code>::CrFwInStreamPcktAvail</code> is
- * called on the InStream associated to that packet source.
+ * The function first accepts any pending connection requests.
+ * Then, for each client connection whose Pending Packets are not full, non-blocking
+ * reads are performed on the connection to move the newly arrived bytes into its
+ * receive ring buffer and the complete packets of the ring are framed into Pending
+ * Packets until the socket is drained.
+ * Function <code>::CrFwInStreamPcktAvail</code> is then called on the InStream
+ * associated to each source which has a Pending Packet on the connection.
+ * If the io_uring backend is used (see <code>#CR_DA_SOCKET_URING</code>), the connection
+ * requests and the newly arrived bytes are taken from the completion queue of the
+ * io_uring instance and no system call is made.
  */
 void CrDaServerSocketPoll();
 
+/**
+ * Set the Packet Available Function of the server socket.
+ * The Packet Available Function is called by <code>::CrDaServerSocketPoll</code> with
+ * each source which has a Pending Packet on a connection when packets are available for
+ * collection on that connection.
+ * The default Packet Available Function calls <code>::CrFwInStreamPcktAvail</code> on
+ * the InStream associated to the source.
+ * Another function can be set to divert the incoming packets away from the InStreams
+ * (e.g. to the I/O thread of <code>CrDaIoThread.h</code>): it must then collect the
+ * packets itself through <code>::CrDaServerSocketPcktCollect</code>.
+ * @param avail the Packet Available Function or NULL to restore the default function
+ */
+void CrDaServerSocketSetPcktAvail(void (*avail)(CrFwDestSrc_t src));
+
+/**
+ * Wait for the argument period while servicing the server socket.
+ * If the epoll backend is used (see <code>#CR_DA_SOCKET_EPOLL</code>), the function
+ * sleeps until new data arrive at the socket or until the period has elapsed.
+ * When new data arrive, function <code>::CrDaServerSocketPoll</code> is called so that
+ * incoming packets are handed over to their InStream without waiting for the next cycle.
+ * If the epoll backend is not used, the function sleeps for the entire period.
+ * Before waiting, the function flushes the transmit queues (see
+ * <code>::CrDaServerSocketFlush</code>).
+ * If the io_uring backend is used (see <code>#CR_DA_SOCKET_URING</code>), the function
+ * behaves as with the epoll backend but the transmit queues are submitted with the
+ * same system call which waits for new data.
+ * If the epoll or io_uring backend is used, the function returns as soon as one or
+ * more packets have been collected by their InStream so that the caller can process
+ * them immediately (see <code>CrDaCycle.h</code>).
+ * This function is intended to be called at the end of each cycle in place of
+ * a plain sleep.
+ * @param period the wait period in milliseconds
+ * @return 1 if the function returned before the end of the period because packets
+ * were collected by their InStream; 0 if the period has elapsed
+ */
+CrFwBool_t CrDaServerSocketWait(unsigned int period);
+
 /**
  * Function implementing the Packet Collect Operation for the server socket.
- * If the packet in the first Read Buffer has a source attribute equal to
- * <code>pcktSrc</code>, this function:
- * - creates a packet instance through a call to <code>CrFwPcktMake</code>
- * - copies the content of the Read Buffer into the newly created packet instance
- * - clears the Read Buffer
- * - returns the packet instance
+ * The function looks for the first Pending Packet with a source attribute equal to
+ * <code>pcktSrc</code>.
+ * The Pending Packets of the client connections which the routing table associates to
+ * <code>pcktSrc</code> are checked first.
+ * If the function is called while <code>::CrDaServerSocketPoll</code> signals the
+ * packets of a client connection, the Pending Packets of that connection are checked next
+ * (this covers the packets whose source is not the application identifier of their
+ * connection).
+ * If such a Pending Packet is found, this function:
+ * - hands the Pending Packet over to the caller
+ * - frames the complete packets which the receive ring buffer of the same client holds
+ *   into new Pending Packets
  * .
- * If the packet in the first Read Buffer has a source attribute different from
- * <code>pcktSrc</code>, the same logic as above is applied to the second Read Buffer.
- * If neither Read Buffer holds a packet from <code>pcktSrc</code>, this function returns NULL.
- * Note that the logic of the server socket module guarantees that at least one Read Buffer
- * will always be full when this function is called.
+ * If no Pending Packet is a packet from <code>pcktSrc</code>, this function returns NULL.
  * @param pcktSrc the source associated to the InStream
  * @return the packet collected from the argument source
  */
@@ -225,22 +377,15 @@ CrFwPckt_t CrDaServerSocketPcktCollect(CrFwDestSrc_t pcktSrc);
 
 /**
  * Function implementing the Packet Available Check Operation for the server socket.
- * This function implements the following logic:
- * - The function begins by checking the first Read Buffer.
- * - If it is full and the source attribute of the packet it contains is equal
- *   to <code>pcktSrc</code>, the function returns 1.
- * - If the Read Buffer is not full or it is full but the source attribute of the
- *   packet it contains is not equal to <code>pcktSrc</code>, the function
- *   performs a non-blocking read on the socket.
- * - If the read operation returns a packet with a source attribute equal to
- *   <code>pcktSrc</code>, the function stores it in the Read Buffer and then
- *   returns 1.
- * - If the read operation returns nothing or returns a packet with a source
- *   attribute other than <code>pcktSrc</code>, the above logic is applied to
- *   the second Read Buffer.
- * - If no packet for the argument destination is found from either Read Buffer,
- *   the function returns 0.
- * .
+ * The function reads the client connections which the routing table associates to
+ * <code>pcktSrc</code> into their receive ring buffers and frames their complete packets
+ * (as <code>::CrDaServerSocketPoll</code> does).
+ * The function then returns 1 if there is a Pending Packet with a source attribute
+ * equal to <code>pcktSrc</code> (the Pending Packets are searched as in
+ * <code>::CrDaServerSocketPcktCollect</code>) and 0 otherwise.
+ * If the pushed packet arrivals are selected (see <code>#CR_DA_SOCKET_RX_PUSH</code>), the
+ * function does not read the connection and it only searches the Pending Packets which
+ * have been framed by <code>::CrDaServerSocketPoll</code> or by the previous collections.
  * @param pcktSrc the source associated to the InStream
  * @return the value of a predefined flag
  */
@@ -253,4 +398,24 @@ CrFwBool_t CrDaServerSocketIsPcktAvail(CrFwDestSrc_t pcktSrc);
  */
 void CrDaServerSocketSetPort(int n);
 
+/**
+ * Set the number of client connections which must have been accepted before
+ * the server socket can be configured.
+ * The default value is zero.
+ * @param n the number of client connections
+ */
+void CrDaServerSocketSetNOfClients(int n);
+
+/**
+ * Wait until the number of client connections set with
+ * <code>::CrDaServerSocketSetNOfClients</code> have been accepted.
+ * The function accepts the incoming connection requests as they arrive on the listening
+ * socket and returns as soon as the number of accepted client connections is reached
+ * or when the timeout has expired.
+ * The socket must have been initialized.
+ * @param timeout the timeout in milliseconds
+ * @return 1 if the client connections have been accepted; 0 if the timeout has expired
+ */
+CrFwBool_t CrDaServerSocketWaitClients(unsigned int timeout);
+
 #endif /* CRDA_SERVERSOCKET_H_ */
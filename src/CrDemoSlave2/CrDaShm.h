@@ -0,0 +1,207 @@
+/**
+ * @file
+ * @ingroup crDemoSlave2
+ * Interface for the shared-memory transport used in the CORDET Demo.
+ * The shared-memory transport is an alternative to the client and server sockets of
+ * <code>CrDaClientSocket.h</code> and <code>CrDaServerSocket.h</code> for demo
+ * applications which run on the same host.
+ * It is selected through the switch <code>#CR_DA_SHM_TRANSPORT</code>.
+ * This module defines the functions through which the InStreams and OutStreams of the
+ * Master and Slave Applications exchange packets through the shared-memory transport.
+ * These functions are used to customize the InStreams and OutStreams in the same way as
+ * the functions of the socket modules:
+ * - Function <code>::CrDaShmInitAction</code> should be used as the Initialization Action
+ *   of the InStreams and OutStreams.
+ * - Function <code>::CrDaShmInitCheck</code> should be used as the Initialization Check
+ *   of the InStreams and OutStreams.
+ * - Function <code>::CrDaShmConfigAction</code> should be used as the Configuration Action
+ *   of the InStreams.
+ * - Function <code>::CrDaShmShutdownAction</code> should be used as the Shutdown Action
+ *   of the InStreams and OutStreams.
+ * - Function <code>::CrDaShmPcktCollect</code> should be used as the Packet Collect
+ *   Operation of the InStreams.
+ * - Function <code>::CrDaShmIsPcktAvail</code> should be used as the Packet Available
+ *   Check Operation of the InStreams.
+ * - Function <code>::CrDaShmPcktHandover</code> should be used as the Packet Hand-Over
+ *   Operation of the OutStreams.
+ * .
+ * The functions in this module should be accessed in mutual exclusion.
+ * Compliance with this constraint is not enforced and is therefore under the responsibility
+ * of the caller.
+ *
+ * The shared-memory segment is created with <code>shm_open</code> under the name
+ * <code>#CR_DA_SHM_NAME</code> by the first application which initializes the module
+ * and it is mapped by all other applications.
+ * The segment holds one ring for each ordered pair of applications: the ring from
+ * application A to application B carries the packets which are handed over by
+ * application A for destination B.
+ * Each ring has one producer and one consumer and is therefore accessed without locks:
+ * the producer only advances the head of the ring and the consumer only advances its
+ * tail.
+ * Packets are delivered directly to their destination: there is no forwarding through
+ * the Slave 1 Application as in the socket-based configuration.
+ *
+ * The packet hand-over operation copies the packet into the ring towards its
+ * destination.
+ * If the ring is full, the hand-over fails and the OutStream keeps the packet.
+ * The consumer is woken up through a futex in the shared-memory segment.
+ * The futex is only signalled if the consumer is waiting on it in
+ * <code>::CrDaShmWait</code>: a consumer which is busy does not cost the producer
+ * a system call.
+ *
+ * The module assumes a polling approach for incoming packets in the same way as the
+ * socket modules: function <code>::CrDaShmPoll</code> checks the rings towards the
+ * host application and, for each packet which it finds, it calls
+ * <code>::CrFwInStreamPcktAvail</code> on the InStream associated to the packet
+ * source.
+ * The packet at the head of each incoming ring is framed directly into a packet of the
+ * packet pool (the Pending Packet of the ring) which is then handed over to the InStream
+ * by the packet collect operation.
+ *
+ * The segment is not removed when the module is shut down because the other
+ * applications may still be using it.
+ * A segment left over from a previous run is reused: each application discards the
+ * content of its incoming rings when it is initialized.
+ *
+ * <b>Mode of Use of the Shared-Memory Transport Module</b>
+ *
+ * This module may be controlled jointly by multiple InStreams and/or OutStreams.
+ * The segment is mapped when the first of these components is initialized
+ * and it is unmapped when the first of these components is shut down.
+ * The incoming rings are cleared whenever one of the InStreams is reset.
+ * Users should periodically call <code>::CrDaShmPoll</code> (or
+ * <code>::CrDaShmWait</code>) to check whether packets have arrived.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRDA_SHM_H_
+#define CRDA_SHM_H_
+
+/* Include Framework Files */
+#include "CrFwConstants.h"
+/* Include Configuration Files */
+#include "CrFwUserConstants.h"
+/* Include FW Profile files */
+#include "FwSmConstants.h"
+#include "FwSmConfig.h"
+#include "FwSmCore.h"
+#include "FwPrConfig.h"
+#include "FwPrCore.h"
+#include "FwPrConstants.h"
+
+/**
+ * Initialization action for the shared-memory transport.
+ * If the shared-memory segment has already been mapped, this function calls the
+ * Initialization Action of the base InStream/OutStream and then returns.
+ * Otherwise, this action:
+ * - opens (and, if necessary, creates) the shared-memory segment and maps it
+ * - discards the content of the rings towards the host application
+ * - executes the Initialization Action of the base InStream/OutStream
+ * .
+ * If any of these operations fails, the outcome of the action is set to 0.
+ * @param prDesc the initialization procedure descriptor
+ */
+void CrDaShmInitAction(FwPrDesc_t prDesc);
+
+/**
+ * Initialization check for the shared-memory transport.
+ * The check is successful if the maximum length of a packet (as retrieved from
+ * <code>::CrFwPcktGetMaxLength</code>) is smaller than the size of a ring
+ * and if the host application identifier is smaller than <code>#CR_DA_SHM_NOF_APPS</code>.
+ * @param prDesc the initialization procedure descriptor
+ */
+void CrDaShmInitCheck(FwPrDesc_t prDesc);
+
+/**
+ * Configuration action for the shared-memory transport.
+ * This action releases the Pending Packets, discards the content of the rings towards
+ * the host application and executes the Configuration Action of the base
+ * InStream/OutStream.
+ * @param prDesc the configuration procedure descriptor
+ */
+void CrDaShmConfigAction(FwPrDesc_t prDesc);
+
+/**
+ * Shutdown action for the shared-memory transport.
+ * This action executes the Shutdown Action of the base InStream/OutStream and, if the
+ * segment is still mapped, it releases the Pending Packets and unmaps the segment.
+ * @param smDesc the state machine descriptor
+ */
+void CrDaShmShutdownAction(FwSmDesc_t smDesc);
+
+/**
+ * Poll the rings towards the host application to check whether new packets have arrived.
+ * This function should be called periodically by an external scheduler.
+ * For each incoming ring which holds a complete packet, the packet is framed into
+ * the Pending Packet of the ring, its source is determined, and then function
+ * <code>::CrFwInStreamPcktAvail</code> is called on the InStream associated to that
+ * packet source.
+ */
+void CrDaShmPoll();
+
+/**
+ * Wait for the argument period while servicing the shared-memory transport.
+ * The function sleeps on the futex of the host application until a packet is handed
+ * over to the host application or until the period has elapsed.
+ * When a packet arrives, function <code>::CrDaShmPoll</code> is called so that
+ * it is handed over to its InStream without waiting for the next cycle.
+ * The function returns as soon as one or more packets have been collected by their
+ * InStream so that the caller can process them immediately (see <code>CrDaCycle.h</code>).
+ * This function is intended to be called at the end of each cycle in place of
+ * a plain sleep.
+ * @param period the wait period in milliseconds
+ * @return 1 if the function returned before the end of the period because packets
+ * were collected by their InStream; 0 if the period has elapsed
+ */
+CrFwBool_t CrDaShmWait(unsigned int period);
+
+/**
+ * Function implementing the Packet Collect Operation for the shared-memory transport.
+ * The function looks for a Pending Packet with a source attribute equal to
+ * <code>pcktSrc</code>.
+ * If such a Pending Packet is found, this function:
+ * - hands the Pending Packet over to the caller
+ * - if the ring of the Pending Packet holds another complete packet, frames it into
+ *   a new Pending Packet
+ * .
+ * If no such Pending Packet is found, this function returns NULL.
+ * @param pcktSrc the source associated to the InStream
+ * @return the packet
+ */
+CrFwPckt_t CrDaShmPcktCollect(CrFwDestSrc_t pcktSrc);
+
+/**
+ * Function implementing the Packet Available Check Operation for the shared-memory
+ * transport.
+ * The function frames the next complete packet of each incoming ring which has no
+ * Pending Packet and it returns 1 if one of the Pending Packets has a source attribute
+ * equal to <code>pcktSrc</code>.
+ * @param pcktSrc the source associated to the InStream
+ * @return 1 if a packet from the argument source is available; 0 otherwise
+ */
+CrFwBool_t CrDaShmIsPcktAvail(CrFwDestSrc_t pcktSrc);
+
+/**
+ * Function implementing the hand-over operation for the shared-memory transport.
+ * This function copies the packet into the ring from the host application to
+ * the destination of the packet and wakes up the destination application if it
+ * is waiting in <code>::CrDaShmWait</code>.
+ * The function returns 0 if the destination is not served by the shared-memory
+ * transport or if its ring has not enough free space for the packet.
+ * @param pckt the packet to be handed over
+ * @return 1 if the packet was copied into the ring; 0 otherwise.
+ */
+CrFwBool_t CrDaShmPcktHandover(CrFwPckt_t pckt);
+
+#endif /* CRDA_SHM_H_ */
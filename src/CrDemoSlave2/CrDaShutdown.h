@@ -0,0 +1,87 @@
+/**
+ * @file
+ * @ingroup crDemoSlave2
+ * Interface for the orderly shutdown of the demo applications of the CORDET Demo.
+ * A demo application is shut down when its control cycles have been executed or when
+ * it receives a termination signal (<code>SIGINT</code> or <code>SIGTERM</code>).
+ * The termination signals are caught by a handler installed with
+ * <code>::CrDaShutdownSetSignals</code> which stops the cycle scheduler (see
+ * <code>::CrDaCycleStop</code>) and the application then executes the same shutdown
+ * sequence as at the end of a normal run:
+ * - The OutStreams are flushed (<code>::CrDaShutdownFlush</code>): the packets which
+ *   are still buffered in their packet queues are handed over to the transport and the
+ *   transport is serviced until it has sent them or until
+ *   <code>#CR_DA_SHUTDOWN_FLUSH_MSEC</code> milliseconds have elapsed.
+ * - The I/O thread and the manager pool (if they are used) are stopped.
+ * - The framework components are shut down (<code>::CrDaShutdownCmp</code>): the
+ *   Shutdown Actions of the managers, factories and registries release the components
+ *   which they still hold and the Shutdown Actions of the InStreams and OutStreams
+ *   release their packet queues and close the connections of the transport.
+ * .
+ * A second termination signal received during the shutdown sequence terminates the
+ * application immediately.
+ *
+ * The server socket binds its port with <code>SO_REUSEADDR</code> (see
+ * <code>CrDaServerSocket.h</code>) and a demo application can therefore be restarted
+ * immediately after it has been shut down even if its connections are still in the
+ * <code>TIME_WAIT</code> state.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRDA_SHUTDOWN_H_
+#define CRDA_SHUTDOWN_H_
+
+/* Include FW Profile files */
+#include "FwSmConstants.h"
+/* Include Framework Files */
+#include "CrFwConstants.h"
+/* Include Configuration Files */
+#include "CrFwUserConstants.h"
+#include "CrDaConstants.h"
+
+/**
+ * Install the handler of the termination signals (<code>SIGINT</code> and
+ * <code>SIGTERM</code>).
+ * The handler stops the cycle scheduler on the first signal and restores the default
+ * action of the signals so that a second signal terminates the application.
+ * @return 1 if the handler was installed; 0 otherwise
+ */
+CrFwBool_t CrDaShutdownSetSignals();
+
+/**
+ * Flush a set of OutStreams.
+ * The OutStreams which hold pending packets are notified that their connection is
+ * available (<code>::CrFwOutStreamConnectionAvail</code>) and the transport is serviced
+ * through the Cycle Wait Function of the cycle scheduler (see
+ * <code>::CrDaCycleGetWait</code>) until the OutStreams and the outgoing ring of the I/O
+ * thread are empty or until <code>#CR_DA_SHUTDOWN_FLUSH_MSEC</code> milliseconds have
+ * elapsed.
+ * The packets of the OutStream backlog (see <code>CrDaOutBacklog.h</code>) are handed over
+ * first and those which cannot be flushed are discarded.
+ * This function must be called before the I/O thread is stopped.
+ * @param outStreams the OutStreams
+ * @param nOfOutStreams the number of OutStreams
+ * @return 1 if all packets have been flushed; 0 otherwise
+ */
+CrFwBool_t CrDaShutdownFlush(FwSmDesc_t* outStreams, unsigned int nOfOutStreams);
+
+/**
+ * Shut down a set of framework components.
+ * The components are shut down in the order of the array.
+ * @param cmp the components
+ * @param nOfCmp the number of components
+ */
+void CrDaShutdownCmp(FwSmDesc_t* cmp, unsigned int nOfCmp);
+
+#endif /* CRDA_SHUTDOWN_H_ */
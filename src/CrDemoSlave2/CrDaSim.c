@@ -0,0 +1,290 @@
+/**
+ * @file
+ * @ingroup crDemoSlave2
+ * Implementation of the simulation mode of the demo applications.
+ * The shared-memory segment of the simulation holds the set of the applications which
+ * have joined and left the simulation, the virtual deadlines of the applications, the
+ * virtual clock and the turn.
+ * The turn is a futex word which holds the identifier of the application which holds
+ * the turn (or a negative value before the simulation has started).
+ * Only the application which holds the turn writes the deadlines and the virtual clock:
+ * it publishes them with a release store of the turn and the application which receives
+ * the turn reads them after an acquire load of the turn.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdio.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sched.h>
+#include <time.h>
+#include <limits.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#include "CrDaSim.h"
+#include "CrDaCycle.h"
+
+#if (CR_DA_SIM == 1) && (CR_DA_SHM_TRANSPORT == 0)
+#error "The simulation mode (CR_DA_SIM) requires the shared-memory transport (CR_DA_SHM_TRANSPORT)"
+#endif
+
+#if (CR_DA_SIM == 1) && ((CR_DA_IO_THREAD == 1) || (CR_DA_MGR_POOL == 1))
+#error "The simulation mode (CR_DA_SIM) excludes the I/O thread and the manager pool"
+#endif
+
+/** The simulation has not been started or it has ended. */
+#define CR_DA_SIM_IDLE 0
+
+/** The first application of a simulation is resetting the segment. */
+#define CR_DA_SIM_RESETTING 1
+
+/** The simulation is running. */
+#define CR_DA_SIM_RUNNING 2
+
+/** The value of the turn before the simulation has started. */
+#define CR_DA_SIM_NOT_STARTED (-1)
+
+/** The value of the turn while the first turn is being assigned. */
+#define CR_DA_SIM_STARTING (-2)
+
+/** Type for the shared-memory segment of the simulation. */
+typedef struct {
+	/** The state of the simulation. */
+	int state;
+	/** The futex word which holds the identifier of the application which holds the turn. */
+	int turn;
+	/** The applications which have joined the simulation (bit i stands for application i). */
+	unsigned int joined;
+	/** The applications which have left the simulation (bit i stands for application i). */
+	unsigned int left;
+	/** The virtual clock in nanoseconds. */
+	unsigned long long now;
+	/** The virtual deadlines in nanoseconds of the next turns of the applications. */
+	unsigned long long deadline[CR_DA_SHM_NOF_APPS];
+} CrDaSimSeg_t;
+
+/** The shared-memory segment of the simulation (NULL if the host application has not joined it). */
+static CrDaSimSeg_t* seg = NULL;
+
+#if (CR_DA_SIM == 1)
+/**
+ * Return the application which receives the turn after an application: the application
+ * with the earliest deadline among those which have joined and not left the simulation.
+ * Applications with the same deadline are taken in the order of their identifiers,
+ * starting after the given application.
+ * @param app the application after which the search starts (-1 to start from zero)
+ * @return the application which receives the turn or -1 if all applications have left
+ */
+static int simNext(int app);
+
+/**
+ * Pass the turn to an application.
+ * The virtual clock is advanced to the deadline of the application.
+ * @param app the application which receives the turn
+ */
+static void simPass(int app);
+
+/**
+ * Wait until the host application holds the turn.
+ * @param stoppable 1 if the wait is abandoned when the cycle scheduler is requested to stop
+ * @param maxMsec the maximum time in milliseconds of the wait (-1 for no limit)
+ * @return 1 if the host application holds the turn; 0 if the wait was abandoned
+ */
+static CrFwBool_t simWait(CrFwBool_t stoppable, long maxMsec);
+
+/**
+ * Return the number of milliseconds which have elapsed since a point in time of the
+ * monotonic clock.
+ * @param start the point in time
+ * @return the number of milliseconds
+ */
+static long simElapsedMsec(const struct timespec* start);
+#endif
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaSimJoin() {
+#if (CR_DA_SIM == 1)
+	struct timespec start, req = {CR_DA_SIM_POLL_MSEC/1000, (CR_DA_SIM_POLL_MSEC%1000)*1000000L};
+	int state = CR_DA_SIM_IDLE;
+	int turn = CR_DA_SIM_NOT_STARTED;
+	void* p;
+	int fd;
+
+	fd = shm_open(CR_DA_SIM_NAME, O_RDWR | O_CREAT, 0600);
+	if (fd < 0) {
+		perror("CrDaSimJoin, Shared-memory segment creation");
+		return 0;
+	}
+	if (ftruncate(fd, (off_t)sizeof(CrDaSimSeg_t)) < 0) {
+		perror("CrDaSimJoin, Shared-memory segment sizing");
+		close(fd);
+		return 0;
+	}
+	p = mmap(NULL, sizeof(CrDaSimSeg_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	if (p == MAP_FAILED) {
+		perror("CrDaSimJoin, Shared-memory segment mapping");
+		return 0;
+	}
+	seg = (CrDaSimSeg_t*)p;
+
+	/* The first application of a simulation resets the segment (the others wait until it is done) */
+	if (__atomic_compare_exchange_n(&seg->state, &state, CR_DA_SIM_RESETTING, 0,
+	                                __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE)) {
+		seg->joined = 0;
+		seg->left = 0;
+		seg->now = 0;
+		seg->turn = CR_DA_SIM_NOT_STARTED;
+		__atomic_store_n(&seg->state, CR_DA_SIM_RUNNING, __ATOMIC_RELEASE);
+	} else {
+		while (__atomic_load_n(&seg->state, __ATOMIC_ACQUIRE) == CR_DA_SIM_RESETTING)
+			sched_yield();
+	}
+
+	/* The first cycle of the host application is due now */
+	seg->deadline[CR_FW_HOST_APP_ID] = __atomic_load_n(&seg->now, __ATOMIC_RELAXED);
+	__atomic_fetch_or(&seg->joined, 1U << CR_FW_HOST_APP_ID, __ATOMIC_RELEASE);
+
+	/* The application which completes the simulation (or which waits too long for it) starts it */
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	while (__atomic_load_n(&seg->turn, __ATOMIC_ACQUIRE) == CR_DA_SIM_NOT_STARTED) {
+		if ((__builtin_popcount(__atomic_load_n(&seg->joined, __ATOMIC_ACQUIRE)) >= CR_DA_SIM_N_OF_APPS) ||
+		        (simElapsedMsec(&start) >= CR_DA_SIM_JOIN_MSEC)) {
+			turn = CR_DA_SIM_NOT_STARTED;
+			if (__atomic_compare_exchange_n(&seg->turn, &turn, CR_DA_SIM_STARTING, 0,
+			                                __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE))
+				simPass(simNext(-1));
+			break;
+		}
+		syscall(SYS_futex, &seg->turn, FUTEX_WAIT, CR_DA_SIM_NOT_STARTED, &req, NULL, 0);
+	}
+#endif
+	return 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaSimWaitTurn() {
+#if (CR_DA_SIM == 1)
+	if (seg == NULL)
+		return 1;
+	return simWait(1, -1);
+#else
+	return 1;
+#endif
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaSimEndTurn(unsigned long long deadline) {
+#if (CR_DA_SIM == 1)
+	if (seg == NULL)
+		return;
+	seg->deadline[CR_FW_HOST_APP_ID] = deadline;
+	simPass(simNext(CR_FW_HOST_APP_ID));
+#else
+	(void)deadline;
+#endif
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaSimLeave() {
+#if (CR_DA_SIM == 1)
+	CrFwBool_t hasTurn;
+	int next;
+
+	if (seg == NULL)
+		return;
+	hasTurn = simWait(0, CR_DA_SIM_JOIN_MSEC);
+	if (!hasTurn)
+		printf("CrDaSimLeave: the turn was not received within %d ms\n", CR_DA_SIM_JOIN_MSEC);
+	__atomic_fetch_or(&seg->left, 1U << CR_FW_HOST_APP_ID, __ATOMIC_ACQ_REL);
+
+	if (hasTurn) {
+		next = simNext(CR_FW_HOST_APP_ID);
+		if (next >= 0)
+			simPass(next);
+		else {
+			/* The last application ends the simulation */
+			__atomic_store_n(&seg->turn, CR_DA_SIM_NOT_STARTED, __ATOMIC_RELEASE);
+			__atomic_store_n(&seg->state, CR_DA_SIM_IDLE, __ATOMIC_RELEASE);
+		}
+	}
+	munmap(seg, sizeof(CrDaSimSeg_t));
+	seg = NULL;
+#endif
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+unsigned long long CrDaSimGetTime() {
+	if (seg == NULL)
+		return 0;
+	return __atomic_load_n(&seg->now, __ATOMIC_RELAXED);
+}
+
+#if (CR_DA_SIM == 1)
+/* ---------------------------------------------------------------------------------------------*/
+static int simNext(int app) {
+	unsigned int active;
+	int best = -1;
+	int k, i;
+
+	active = __atomic_load_n(&seg->joined, __ATOMIC_ACQUIRE) & ~__atomic_load_n(&seg->left, __ATOMIC_ACQUIRE);
+	for (k=1; k<=CR_DA_SHM_NOF_APPS; k++) {
+		i = (app + k + CR_DA_SHM_NOF_APPS) % CR_DA_SHM_NOF_APPS;
+		if ((active & (1U << i)) == 0)
+			continue;
+		/* A later application only wins with a strictly earlier deadline */
+		if ((best < 0) || (seg->deadline[i] < seg->deadline[best]))
+			best = i;
+	}
+	return best;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void simPass(int app) {
+	if (seg->deadline[app] > seg->now)
+		__atomic_store_n(&seg->now, seg->deadline[app], __ATOMIC_RELAXED);
+	__atomic_store_n(&seg->turn, app, __ATOMIC_RELEASE);
+	if (app != CR_FW_HOST_APP_ID)
+		syscall(SYS_futex, &seg->turn, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static CrFwBool_t simWait(CrFwBool_t stoppable, long maxMsec) {
+	struct timespec start, req = {CR_DA_SIM_POLL_MSEC/1000, (CR_DA_SIM_POLL_MSEC%1000)*1000000L};
+	int turn;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (;;) {
+		turn = __atomic_load_n(&seg->turn, __ATOMIC_ACQUIRE);
+		if (turn == CR_FW_HOST_APP_ID)
+			return 1;
+		if (stoppable && CrDaCycleIsStopped())
+			return 0;
+		if ((maxMsec >= 0) && (simElapsedMsec(&start) >= maxMsec))
+			return 0;
+		/* The wait ends when the turn changes, on a signal, or after the poll interval */
+		syscall(SYS_futex, &seg->turn, FUTEX_WAIT, turn, &req, NULL, 0);
+	}
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static long simElapsedMsec(const struct timespec* start) {
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (long)(now.tv_sec - start->tv_sec) * 1000L + (now.tv_nsec - start->tv_nsec) / 1000000L;
+}
+#endif
@@ -0,0 +1,103 @@
+/**
+ * @file
+ * @ingroup crDemoSlave2
+ * Interface for the simulation mode of the demo applications of the CORDET Demo.
+ * In the normal mode, the demo applications run on the monotonic clock of the host and
+ * a run of the demo scenario lasts as long as its control cycles (about 100 seconds with
+ * the default period of one second) although the applications are idle for most of the
+ * time.
+ *
+ * If the simulation mode is selected (see <code>#CR_DA_SIM</code>), the applications
+ * run on a virtual clock which is kept in a shared-memory segment
+ * (<code>#CR_DA_SIM_NAME</code>) and which only advances when all applications are
+ * waiting for their next deadline:
+ * - The applications take turns: at any time, only the application which holds the turn
+ *   executes its control cycle and the other applications wait on a futex of the segment.
+ * - Each application publishes the virtual deadline of its next cycle when it ends its
+ *   turn (<code>::CrDaSimEndTurn</code>) and the turn is passed to the application with
+ *   the earliest deadline; applications with the same deadline take turns in the order of
+ *   their application identifiers.
+ * - The virtual clock jumps to the deadline of the application which receives the turn.
+ * - The time interface of the applications (<code>CrFwTime.c</code>) returns the
+ *   virtual clock (<code>::CrDaSimGetTime</code>) and the cycle scheduler
+ *   (<code>CrDaCycle.h</code>) does not sleep.
+ * .
+ * Since the applications never run concurrently and since they exchange their packets
+ * through the shared-memory transport (which does not depend on the timing of the host),
+ * the sequence of the packets, their time stamps and the outputs of the applications are
+ * the same in every run and a run of the demo scenario takes only as long as the work
+ * of its cycles.
+ *
+ * A simulation starts when <code>#CR_DA_SIM_N_OF_APPS</code> applications have joined it
+ * (<code>::CrDaSimJoin</code>) or when the first of them has waited for
+ * <code>#CR_DA_SIM_JOIN_MSEC</code> milliseconds.
+ * It ends when all applications which joined it have left it (<code>::CrDaSimLeave</code>).
+ * The simulation mode works both with the applications in separate processes and with the
+ * applications in one process (see <code>CompileAndLinkMulti.sh</code>).
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRDA_SIM_H_
+#define CRDA_SIM_H_
+
+/* Include Framework Files */
+#include "CrFwConstants.h"
+/* Include Configuration Files */
+#include "CrFwUserConstants.h"
+#include "CrDaConstants.h"
+
+/**
+ * Join the simulation and wait until it starts.
+ * The deadline of the first cycle of the host application is the current virtual time.
+ * Nothing is done if the simulation mode is not selected.
+ * @return 1 if the host application has joined the simulation; 0 if the shared-memory
+ * segment of the simulation could not be mapped
+ */
+CrFwBool_t CrDaSimJoin();
+
+/**
+ * Wait until the host application holds the turn.
+ * The wait is abandoned if the cycle scheduler is requested to stop (see
+ * <code>::CrDaCycleStop</code>).
+ * @return 1 if the host application holds the turn; 0 if the wait was abandoned
+ */
+CrFwBool_t CrDaSimWaitTurn();
+
+/**
+ * End the turn of the host application and pass the turn to the application with the
+ * earliest deadline (this may be the host application itself).
+ * This function must only be called while the host application holds the turn.
+ * @param deadline the virtual deadline in nanoseconds of the next turn of the host
+ * application
+ */
+void CrDaSimEndTurn(unsigned long long deadline);
+
+/**
+ * Leave the simulation.
+ * The function waits for the turn (the wait is bounded by <code>#CR_DA_SIM_JOIN_MSEC</code>
+ * if the cycle scheduler has been requested to stop), removes the host application from
+ * the simulation and passes the turn to the remaining applications.
+ * The last application which leaves the simulation ends it.
+ * Nothing is done if the host application has not joined the simulation.
+ */
+void CrDaSimLeave();
+
+/**
+ * Return the current virtual time.
+ * @return the virtual time in nanoseconds (zero before the host application has joined
+ * the simulation)
+ */
+unsigned long long CrDaSimGetTime();
+
+#endif /* CRDA_SIM_H_ */
@@ -0,0 +1,248 @@
+/**
+ * @file
+ * @ingroup crDemoSlave2
+ * Implementation of the execution profiler of the state machines and procedures of the
+ * demo applications.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdio.h>
+#include <time.h>
+#include <pthread.h>
+#include "CrDaSmProf.h"
+/* Include FW Profile files */
+#include "FwSmConfig.h"
+#include "FwPrConfig.h"
+/* Include configuration files */
+#include "CrFwCmpData.h"
+
+#if (CR_DA_SM_PROF == 1)
+/** The profile of a state machine or procedure. */
+typedef struct {
+	/** The descriptor of the state machine or procedure. */
+	const void* desc;
+	/** Whether the entry is that of a procedure. */
+	CrFwBool_t isPr;
+	/** The type identifier of the component. */
+	CrFwTypeId_t typeId;
+	/** The instance identifier of the component. */
+	CrFwInstanceId_t instanceId;
+	/** The number of executions. */
+	unsigned long long nOfExec;
+	/** The number of executions after which the current state or node has changed. */
+	unsigned long long nOfTrans;
+	/** The total time of the executions in nanoseconds. */
+	unsigned long long totNsec;
+	/** The maximum time of an execution in nanoseconds. */
+	unsigned long long maxNsec;
+	/** The source state or node of the transitions which are counted separately. */
+	int transFrom[CR_DA_SM_PROF_N_OF_TRANS];
+	/** The target state or node of the transitions which are counted separately. */
+	int transTo[CR_DA_SM_PROF_N_OF_TRANS];
+	/** The number of each transition which is counted separately. */
+	unsigned long long transCnt[CR_DA_SM_PROF_N_OF_TRANS];
+	/** The number of transitions which are counted separately. */
+	unsigned int nOfTransKinds;
+	/** The number of the other transitions. */
+	unsigned long long nOfOtherTrans;
+} CrDaSmProfEntry_t;
+
+/** The profiles. */
+static CrDaSmProfEntry_t entry[CR_DA_SM_PROF_N_OF_ENTRIES];
+
+/** The number of profiles (an entry is published when this counter is incremented). */
+static unsigned int nOfEntries = 0;
+
+/** The lock which serializes the creation of the entries. */
+static pthread_mutex_t entryLock = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+ * Return the entry of a state machine or procedure and create it if it does not exist.
+ * @param desc the descriptor of the state machine or procedure
+ * @param isPr whether the descriptor is that of a procedure
+ * @return the entry or NULL if there are already <code>#CR_DA_SM_PROF_N_OF_ENTRIES</code>
+ * entries
+ */
+static CrDaSmProfEntry_t* smProfGetEntry(const void* desc, CrFwBool_t isPr);
+
+/**
+ * Record an execution in an entry.
+ * @param e the entry
+ * @param from the current state or node before the execution
+ * @param to the current state or node after the execution
+ * @param nsec the time of the execution in nanoseconds
+ */
+static void smProfRecord(CrDaSmProfEntry_t* e, int from, int to, unsigned long long nsec);
+
+/**
+ * Return the number of nanoseconds between two times.
+ * @param start the first time
+ * @param end the second time
+ * @return the number of nanoseconds between the two times
+ */
+static unsigned long long smProfNsecBetween(const struct timespec* start, const struct timespec* end);
+#endif
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaSmProfSmExecute(FwSmDesc_t smDesc) {
+#if (CR_DA_SM_PROF == 1)
+	CrDaSmProfEntry_t* e = smProfGetEntry(smDesc, 0);
+	struct timespec start, end;
+	int from;
+
+	if (e == NULL) {
+		FwSmExecute(smDesc);
+		return;
+	}
+	from = FwSmGetCurState(smDesc);
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	FwSmExecute(smDesc);
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	smProfRecord(e, from, FwSmGetCurState(smDesc), smProfNsecBetween(&start, &end));
+#else
+	FwSmExecute(smDesc);
+#endif
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaSmProfPrExecute(FwPrDesc_t prDesc) {
+#if (CR_DA_SM_PROF == 1)
+	CrDaSmProfEntry_t* e = smProfGetEntry(prDesc, 1);
+	struct timespec start, end;
+	int from;
+
+	if (e == NULL) {
+		FwPrExecute(prDesc);
+		return;
+	}
+	from = FwPrGetCurNode(prDesc);
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	FwPrExecute(prDesc);
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	smProfRecord(e, from, FwPrGetCurNode(prDesc), smProfNsecBetween(&start, &end));
+#else
+	FwPrExecute(prDesc);
+#endif
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaSmProfDump(const char* app) {
+#if (CR_DA_SM_PROF == 1)
+	unsigned int order[CR_DA_SM_PROF_N_OF_ENTRIES];
+	unsigned int hot[CR_DA_SM_PROF_N_OF_TRANS];
+	unsigned int n = __atomic_load_n(&nOfEntries, __ATOMIC_ACQUIRE);
+	unsigned int i, j, k, t;
+	CrDaSmProfEntry_t* e;
+
+	/* Sort the entries by decreasing total time */
+	for (i=0; i<n; i++) {
+		for (j=i; (j > 0) && (entry[order[j-1]].totNsec < entry[i].totNsec); j--)
+			order[j] = order[j-1];
+		order[j] = i;
+	}
+
+	for (i=0; i<n; i++) {
+		e = &entry[order[i]];
+		printf("%s: Profile: %s type %u instance %u: %llu executions, %llu transitions, %.3f ms (mean %.2f us, max %.2f us)\n",
+		       app, (e->isPr ? "PR" : "SM"), e->typeId, e->instanceId, e->nOfExec, e->nOfTrans, e->totNsec/1e6,
+		       (e->nOfExec == 0 ? 0.0 : e->totNsec/1e3/e->nOfExec), e->maxNsec/1e3);
+
+		/* Sort the transitions by decreasing count and print the hottest ones */
+		for (j=0; j<e->nOfTransKinds; j++) {
+			for (k=j; (k > 0) && (e->transCnt[hot[k-1]] < e->transCnt[j]); k--)
+				hot[k] = hot[k-1];
+			hot[k] = j;
+		}
+		for (j=0; (j<e->nOfTransKinds) && (j<CR_DA_SM_PROF_N_OF_HOT_TRANS); j++) {
+			t = hot[j];
+			printf("%s: Profile:   %d -> %d: %llu\n", app, e->transFrom[t], e->transTo[t], e->transCnt[t]);
+		}
+		if (e->nOfOtherTrans > 0)
+			printf("%s: Profile:   other transitions: %llu\n", app, e->nOfOtherTrans);
+	}
+	if (n == CR_DA_SM_PROF_N_OF_ENTRIES)
+		printf("%s: Profile: the state machines and procedures beyond the first %d were not profiled\n",
+		       app, CR_DA_SM_PROF_N_OF_ENTRIES);
+#else
+	(void)app;
+#endif
+}
+
+#if (CR_DA_SM_PROF == 1)
+/* ---------------------------------------------------------------------------------------------*/
+static CrDaSmProfEntry_t* smProfGetEntry(const void* desc, CrFwBool_t isPr) {
+	unsigned int n = __atomic_load_n(&nOfEntries, __ATOMIC_ACQUIRE);
+	CrFwCmpData_t* cmpData;
+	CrDaSmProfEntry_t* e;
+	unsigned int i;
+
+	for (i=0; i<n; i++)
+		if (entry[i].desc == desc)
+			return &entry[i];
+
+	/* The entry is created under the lock and published by the increment of the counter */
+	pthread_mutex_lock(&entryLock);
+	n = nOfEntries;
+	for (; i<n; i++)
+		if (entry[i].desc == desc) {
+			pthread_mutex_unlock(&entryLock);
+			return &entry[i];
+		}
+	if (n == CR_DA_SM_PROF_N_OF_ENTRIES) {
+		pthread_mutex_unlock(&entryLock);
+		return NULL;
+	}
+	e = &entry[n];
+	e->desc = desc;
+	e->isPr = isPr;
+	cmpData = (CrFwCmpData_t*)(isPr ? FwPrGetData((FwPrDesc_t)desc) : FwSmGetData((FwSmDesc_t)desc));
+	e->typeId = (cmpData == NULL ? 0 : cmpData->typeId);
+	e->instanceId = (cmpData == NULL ? 0 : cmpData->instanceId);
+	__atomic_store_n(&nOfEntries, n+1, __ATOMIC_RELEASE);
+	pthread_mutex_unlock(&entryLock);
+	return e;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void smProfRecord(CrDaSmProfEntry_t* e, int from, int to, unsigned long long nsec) {
+	unsigned int i;
+
+	e->nOfExec++;
+	e->totNsec += nsec;
+	if (nsec > e->maxNsec)
+		e->maxNsec = nsec;
+	if (from == to)
+		return;
+
+	e->nOfTrans++;
+	for (i=0; i<e->nOfTransKinds; i++)
+		if ((e->transFrom[i] == from) && (e->transTo[i] == to)) {
+			e->transCnt[i]++;
+			return;
+		}
+	if (e->nOfTransKinds == CR_DA_SM_PROF_N_OF_TRANS) {
+		e->nOfOtherTrans++;
+		return;
+	}
+	e->transFrom[i] = from;
+	e->transTo[i] = to;
+	e->transCnt[i] = 1;
+	e->nOfTransKinds++;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static unsigned long long smProfNsecBetween(const struct timespec* start, const struct timespec* end) {
+	return (unsigned long long)((end->tv_sec - start->tv_sec)*1000000000LL + (end->tv_nsec - start->tv_nsec));
+}
+#endif
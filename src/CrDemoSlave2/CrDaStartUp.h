@@ -0,0 +1,119 @@
+/**
+ * @file
+ * @ingroup crDemoSlave2
+ * Interface for the start-up orchestrator of the demo applications of the CORDET Demo.
+ * At start-up, a demo application initializes and configures its InStreams and OutStreams
+ * and its framework components (the factories, the loaders, the managers and the
+ * registries).
+ * The InStreams and OutStreams depend on each other through the sockets: a server socket
+ * application waits for its client socket applications to connect before it configures
+ * its streams, and a client socket application retries its connection until its server
+ * socket application is up.
+ * The framework components do not depend on the streams and they can be configured while
+ * the sockets are set up.
+ *
+ * The start-up of an application is described by a list of tasks.
+ * Each task initializes and/or configures one component or runs one action (e.g. waiting
+ * for the client socket applications to connect) and belongs to one of two lanes:
+ * - the tasks of lane 0 are run by the calling thread; and
+ * - the tasks of lane 1 are run by a start-up thread if the parallel start-up is selected
+ *   (see <code>#CR_DA_STARTUP_PARALLEL</code>), or by the calling thread after the tasks of
+ *   lane 0 otherwise.
+ * .
+ * The tasks of a lane are run in the order in which they were added and a task is only run
+ * if the tasks before it in its lane were successful.
+ * Dependent tasks must therefore be in the same lane: the time to the first cycle of an
+ * application is then bounded by the slower of its two lanes rather than by the sum of
+ * all tasks.
+ *
+ * The duration of each task is recorded and <code>::CrDaStartUpReport</code> prints it
+ * together with the duration of the start-up.
+ *
+ * The factories are initialized with the other framework components: the InLoader needs
+ * the InFactory for the first packet it loads and the OutFactory is needed by the first
+ * command or report which an application sends, so their initialization cannot be
+ * deferred beyond the start-up.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRDA_STARTUP_H_
+#define CRDA_STARTUP_H_
+
+/* Include FW Profile files */
+#include "FwSmConstants.h"
+/* Include Framework Files */
+#include "CrFwConstants.h"
+/* Include Configuration Files */
+#include "CrFwUserConstants.h"
+#include "CrFwInStreamUserPar.h"
+#include "CrFwOutStreamUserPar.h"
+#include "CrDaConstants.h"
+
+/**
+ * The maximum number of tasks in the start-up of an application: the initialization and
+ * the configuration of each stream and the tasks of the other components.
+ */
+#define CR_DA_STARTUP_MAX_N_OF_TASKS (24+2*(CR_FW_NOF_INSTREAM+CR_FW_NOF_OUTSTREAM))
+
+/** The kinds of start-up tasks. */
+typedef enum {
+	/** Initialize a component (<code>CrFwCmpInit</code>). */
+	crDaStartUpInit = 0,
+	/** Configure a component (<code>CrFwCmpReset</code>). */
+	crDaStartUpReset = 1,
+	/** Initialize and configure a component. */
+	crDaStartUpInitReset = 2,
+	/** Run an action. */
+	crDaStartUpAction = 3
+} CrDaStartUpKind_t;
+
+/**
+ * Add the initialization and/or the configuration of a component to the start-up tasks.
+ * If there are already <code>#CR_DA_STARTUP_MAX_N_OF_TASKS</code> tasks, the task is not
+ * added and the next start-up fails.
+ * @param name the name of the task (e.g. "InFactory")
+ * @param lane the lane of the task (0 or 1)
+ * @param kind the kind of the task (<code>::crDaStartUpInit</code>,
+ * <code>::crDaStartUpReset</code> or <code>::crDaStartUpInitReset</code>)
+ * @param cmp the component
+ */
+void CrDaStartUpAddCmp(const char* name, unsigned int lane, CrDaStartUpKind_t kind, FwSmDesc_t cmp);
+
+/**
+ * Add an action to the start-up tasks.
+ * If there are already <code>#CR_DA_STARTUP_MAX_N_OF_TASKS</code> tasks, the task is not
+ * added and the next start-up fails.
+ * @param name the name of the task (e.g. "Wait for clients")
+ * @param lane the lane of the task (0 or 1)
+ * @param action the action: it returns 1 if it was successful
+ */
+void CrDaStartUpAddAction(const char* name, unsigned int lane, CrFwBool_t (*action)());
+
+/**
+ * Run the start-up tasks which have been added.
+ * The function returns when the tasks of both lanes have been run.
+ * If the start-up thread cannot be created, the tasks of lane 1 are run by the calling
+ * thread after the tasks of lane 0.
+ * @return 1 if all tasks were added and were successful; 0 otherwise
+ */
+CrFwBool_t CrDaStartUpRun();
+
+/**
+ * Print the duration of each task of the start-up and the duration of the start-up.
+ * Nothing is printed if the parallel start-up is not selected.
+ * @param app the name of the application (e.g. "MA")
+ */
+void CrDaStartUpReport(const char* app);
+
+#endif /* CRDA_STARTUP_H_ */
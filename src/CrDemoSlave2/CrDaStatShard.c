@@ -0,0 +1,38 @@
+/**
+ * @file
+ * @ingroup crDemoSlave2
+ * Implementation of the shards of the statistics counters of the demo applications of
+ * the CORDET Demo.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include "CrDaStatShard.h"
+
+/** The number of threads which have been given a shard. */
+static unsigned int nOfThreads = 0;
+
+/** The shard of the calling thread plus one (zero until the thread is given a shard). */
+static __thread unsigned int threadShard = 0;
+
+/* ---------------------------------------------------------------------------------------------*/
+unsigned int CrDaStatShardId() {
+	if (threadShard == 0)
+		threadShard = (__atomic_fetch_add(&nOfThreads, 1, __ATOMIC_RELAXED) % CR_DA_STAT_N_OF_SHARDS) + 1;
+	return threadShard-1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+unsigned int CrDaStatShardGetNOfThreads() {
+	return __atomic_load_n(&nOfThreads, __ATOMIC_RELAXED);
+}
@@ -0,0 +1,97 @@
+/**
+ * @file
+ * @ingroup crDemoSlave2
+ * Interface for the stream map of the demo applications of the CORDET Demo.
+ * The stream map returns the InStream of a packet source and the OutStream of a packet
+ * destination in constant time: it holds a table which is indexed by the application
+ * identifier and which gives the index of the InStream and of the OutStream of each
+ * application.
+ * The framework functions <code>CrFwInStreamGet</code> and <code>CrFwOutStreamGet</code>
+ * search the sources and destinations of the streams and their cost grows with the
+ * number of streams; the demo modules which route packets use the stream map instead
+ * (e.g. the packet collect notifications of the transports and the selection of the
+ * packet pool partition of a packet in <code>CrFwPckt.c</code>).
+ *
+ * The table is built by <code>::CrDaStreamMapInit</code> from the stream tables of the
+ * application (see <code>CrFwInStreamUserPar.h</code> and
+ * <code>CrFwOutStreamUserPar.h</code>) after the streams have been created.
+ * Before it is built, or for an identifier which does not fit in the table (see
+ * <code>#CR_DA_STREAM_MAP_N</code>), the functions of this module behave as those of the
+ * framework (i.e. the framework functions are called).
+ * The table is only written by <code>::CrDaStreamMapInit</code>, which must be called
+ * before the threads which route packets are started.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRDA_STREAMMAP_H_
+#define CRDA_STREAMMAP_H_
+
+/* Include FW Profile files */
+#include "FwSmConstants.h"
+/* Include Framework Files */
+#include "CrFwConstants.h"
+/* Include Configuration Files */
+#include "CrFwUserConstants.h"
+#include "CrDaConstants.h"
+
+/**
+ * The number of application identifiers in the table of the stream map: it is the
+ * number of applications which can be addressed (see <code>#CR_FW_NBITS_APP_ID</code>).
+ */
+#define CR_DA_STREAM_MAP_N (1 << CR_FW_NBITS_APP_ID)
+
+/**
+ * Build the table of the stream map.
+ * The streams of the application must have been created (their initialization is not
+ * required).
+ */
+void CrDaStreamMapInit();
+
+/**
+ * Return the InStream of a packet source.
+ * If the source has no InStream, <code>CrFwInStreamGet</code> is called, which reports
+ * the error and returns NULL.
+ * @param src the packet source
+ * @return the InStream of the packet source or NULL if there is none
+ */
+FwSmDesc_t CrDaStreamMapGetInStream(CrFwDestSrc_t src);
+
+/**
+ * Return the OutStream of a packet destination.
+ * If the destination has no OutStream, <code>CrFwOutStreamGet</code> is called, which
+ * reports the error and returns NULL.
+ * @param dest the packet destination
+ * @return the OutStream of the packet destination or NULL if there is none
+ */
+FwSmDesc_t CrDaStreamMapGetOutStream(CrFwDestSrc_t dest);
+
+/**
+ * Return the index of the InStream of a packet source in the stream tables of the
+ * application.
+ * @param src the packet source
+ * @return the index of the InStream or -1 if the source has no InStream or if the table
+ * has not yet been built
+ */
+int CrDaStreamMapGetInStreamIndex(CrFwDestSrc_t src);
+
+/**
+ * Return the index of the OutStream of a packet destination in the stream tables of the
+ * application.
+ * @param dest the packet destination
+ * @return the index of the OutStream or -1 if the destination has no OutStream or if the
+ * table has not yet been built
+ */
+int CrDaStreamMapGetOutStreamIndex(CrFwDestSrc_t dest);
+
+#endif /* CRDA_STREAMMAP_H_ */
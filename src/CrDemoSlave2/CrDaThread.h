@@ -0,0 +1,105 @@
+/**
+ * @file
+ * @ingroup crDemoSlave2
+ * Interface for the placement of the threads of the demo applications of the CORDET Demo.
+ * Each thread of a demo application has a role (e.g. the thread which executes the
+ * control cycles or the I/O thread, see <code>::CrDaThreadRole_t</code>) and each role
+ * has a placement: a CPU affinity mask and a SCHED_FIFO priority.
+ * The placement of the roles is configured by the constants
+ * <code>CR_DA_THREAD_CPUS_*</code> and <code>CR_DA_THREAD_PRIO_*</code> of
+ * <code>CrDaConstants.h</code> and it can be changed at run-time with
+ * <code>::CrDaThreadSetPlacement</code> before the threads are started.
+ *
+ * If the placement of the threads is selected (see <code>#CR_DA_THREAD_PLACEMENT</code>),
+ * each thread calls <code>::CrDaThreadPlace</code> with its role when it starts and the
+ * thread which executes the control cycles calls it before the first cycle.
+ * An affinity mask of zero leaves the affinity of the thread unchanged and a priority of
+ * zero leaves its scheduling policy unchanged.
+ * Before the control cycles are started, <code>::CrDaThreadLockMemory</code> locks the
+ * current and future pages of the process in memory (if <code>#CR_DA_THREAD_MLOCK</code>
+ * is set) so that the cycles do not take page faults.
+ * The control loop can then be kept on an isolated core (e.g. a core reserved with the
+ * <code>isolcpus</code> kernel parameter) while the I/O and the auxiliary threads run on
+ * other cores.
+ *
+ * Real-time priorities and memory locking require privileges (e.g. the
+ * <code>CAP_SYS_NICE</code> and <code>CAP_IPC_LOCK</code> capabilities or suitable
+ * resource limits).
+ * A placement which cannot be applied is reported once per role and the thread then
+ * runs with the placement which it inherited.
+ * <code>::CrDaThreadReport</code> prints the placement of each role and whether it was
+ * applied; together with the jitter of the control cycles (see
+ * <code>CrDaCycle.h</code>), it allows runs with and without placement to be compared.
+ * If the placement is not selected, the functions of this module do nothing.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRDA_THREAD_H_
+#define CRDA_THREAD_H_
+
+/* Include Framework Files */
+#include "CrFwConstants.h"
+/* Include Configuration Files */
+#include "CrFwUserConstants.h"
+#include "CrDaConstants.h"
+
+/** Type for the roles of the threads of a demo application. */
+typedef enum {
+	/** The thread which executes the control cycles. */
+	crDaThreadCycle = 0,
+	/** The I/O thread (see <code>CrDaIoThread.h</code>). */
+	crDaThreadIo = 1,
+	/** The worker threads of the manager pool (see <code>CrDaMgrPool.h</code>). */
+	crDaThreadMgrPool = 2,
+	/** The logging, metrics and start-up threads. */
+	crDaThreadAux = 3
+} CrDaThreadRole_t;
+
+/** The number of roles of the threads of a demo application. */
+#define CR_DA_THREAD_N_OF_ROLES 4
+
+/**
+ * Set the placement of a role.
+ * The placement applies to the threads which call <code>::CrDaThreadPlace</code>
+ * afterwards.
+ * @param role the role
+ * @param cpus the CPU affinity mask (bit n selects core n; zero leaves the affinity unchanged)
+ * @param prio the SCHED_FIFO priority (zero leaves the scheduling policy unchanged)
+ */
+void CrDaThreadSetPlacement(CrDaThreadRole_t role, unsigned long cpus, int prio);
+
+/**
+ * Apply the placement of a role to the calling thread.
+ * This function may be called concurrently by several threads.
+ * @param role the role of the calling thread
+ * @return 1 if the placement was applied (or if there is nothing to apply); 0 otherwise
+ */
+CrFwBool_t CrDaThreadPlace(CrDaThreadRole_t role);
+
+/**
+ * Lock the current and future pages of the process in memory.
+ * Nothing is done if <code>#CR_DA_THREAD_MLOCK</code> is not set.
+ * @return 1 if the memory was locked (or if there is nothing to do); 0 otherwise
+ */
+CrFwBool_t CrDaThreadLockMemory();
+
+/**
+ * Print the placement of each role, the number of threads to which it was applied and
+ * the number of threads to which it could not be applied.
+ * Nothing is printed if the placement of the threads is not selected.
+ * @param app the prefix of the printed lines (e.g. "MA")
+ */
+void CrDaThreadReport(const char* app);
+
+#endif /* CRDA_THREAD_H_ */
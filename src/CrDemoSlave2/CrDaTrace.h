@@ -0,0 +1,158 @@
+/**
+ * @file
+ * @ingroup crDemoSlave2
+ * Interface for the binary event trace of the demo applications of the CORDET Demo.
+ * If the binary trace is selected (see <code>#CR_DA_TRACE</code>), the error reporting
+ * interface (<code>CrFwRepErr.h</code>) and the InCommand outcome reporting interface
+ * (<code>CrFwRepInCmdOutcome.h</code>) do not print their reports: they write them as
+ * compact binary records to a ring buffer in memory (<code>::CrDaTraceWrite</code>).
+ * The ring buffer holds the last <code>#CR_DA_TRACE_N_OF_RECS</code> records.
+ *
+ * Writing a record only reserves its slot with an atomic increment of the head of the
+ * ring and then fills it: it takes no lock and makes no system call (the time stamp is
+ * read from the monotonic clock which, on Linux, is read without a system call).
+ * The records may therefore be written concurrently by the thread of the cycle scheduler,
+ * by the I/O thread and by the threads of the manager pool.
+ *
+ * At the end of the run, the ring buffer is written to a file
+ * (<code>::CrDaTraceDump</code>) which is rendered by the trace decoder
+ * <code>cr_trace</code> (see <code>CrTrMain.c</code>).
+ * The file holds a header (<code>::CrDaTraceHeader_t</code>) followed by the records
+ * of the ring buffer (<code>::CrDaTraceRec_t</code>) in the order of their slots.
+ *
+ * This header file only depends on the standard integer types so that the trace decoder
+ * can be built without the framework.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRDA_TRACE_H_
+#define CRDA_TRACE_H_
+
+#include <stdint.h>
+
+/** The magic number at the start of a trace file ("CRTR"). */
+#define CR_DA_TRACE_MAGIC 0x43525452
+
+/** The version of the format of the trace file. */
+#define CR_DA_TRACE_VERSION 1
+
+/**
+ * The kinds of trace records.
+ * The kind determines the meaning of the fields of a record: for the error reports,
+ * the code is the error code, the type and instance identifiers are those of the
+ * component which reports the error and the arguments are the further parameters of
+ * the error report in the order of the error reporting function.
+ */
+typedef enum {
+	/** An error report of <code>::CrFwRepErr</code> (no arguments). */
+	crDaTraceRepErr = 0,
+	/** An error report of <code>::CrFwRepErrDestSrc</code> (argument: destination or source). */
+	crDaTraceRepErrDestSrc = 1,
+	/** An error report of <code>::CrFwRepErrInstanceIdAndDest</code> (arguments: secondary
+	 * instance identifier and destination). */
+	crDaTraceRepErrInstanceIdAndDest = 2,
+	/** An error report of <code>::CrFwRepErrSeqCnt</code> (arguments: expected and actual
+	 * sequence counter). */
+	crDaTraceRepErrSeqCnt = 3,
+	/** An error report of <code>::CrFwRepErrGroup</code> (argument: group). */
+	crDaTraceRepErrGroup = 4,
+	/** An error report of <code>::CrFwRepErrInstanceIdAndOutcome</code> (arguments: secondary
+	 * instance identifier and outcome). */
+	crDaTraceRepErrInstanceIdAndOutcome = 5,
+	/** An error report of <code>::CrFwRepErrPckt</code> (arguments: first two bytes of the packet). */
+	crDaTraceRepErrPckt = 6,
+	/** An error report of <code>::CrFwRepErrRep</code> (no arguments). */
+	crDaTraceRepErrRep = 7,
+	/** An error report of <code>::CrFwRepErrCmd</code> (no arguments). */
+	crDaTraceRepErrCmd = 8,
+	/** An error report of <code>::CrFwRepErrKind</code> (arguments: service type, service
+	 * sub-type and discriminant). */
+	crDaTraceRepErrKind = 9,
+	/** An outcome report of <code>::CrFwRepInCmdOutcome</code>: the code is the outcome, the
+	 * type identifier is the failure code, the instance identifier is that of the InCommand
+	 * and the arguments are its service type, service sub-type and discriminant. */
+	crDaTraceInCmdOutcome = 10,
+	/** An outcome report of <code>::CrFwRepInCmdOutcomeCreFail</code>: the code is the outcome
+	 * and the type identifier is the failure code (no arguments). */
+	crDaTraceInCmdOutcomeCreFail = 11
+} CrDaTraceKind_t;
+
+/** The number of kinds of trace records. */
+#define CR_DA_TRACE_N_OF_KINDS 12
+
+/** A trace record (32 bytes). */
+typedef struct {
+	/** The time of the record in nanoseconds of the monotonic clock. */
+	uint64_t time;
+	/** The instance identifier. */
+	uint32_t instanceId;
+	/** The arguments (their meaning depends on the kind of the record). */
+	uint32_t arg[3];
+	/** The error or outcome code. */
+	uint16_t code;
+	/** The type identifier. */
+	uint16_t typeId;
+	/** The kind of the record (a <code>::CrDaTraceKind_t</code>). */
+	uint8_t kind;
+	/** Unused. */
+	uint8_t spare[3];
+} CrDaTraceRec_t;
+
+/** The header of a trace file. */
+typedef struct {
+	/** The magic number <code>#CR_DA_TRACE_MAGIC</code>. */
+	uint32_t magic;
+	/** The version <code>#CR_DA_TRACE_VERSION</code> of the format. */
+	uint16_t version;
+	/** The size of a record in bytes. */
+	uint16_t recSize;
+	/** The number of records of the ring buffer. */
+	uint32_t nOfRecs;
+	/** The identifier of the application which wrote the trace. */
+	uint32_t appId;
+	/** The number of records written since the start (the head of the ring buffer). */
+	uint64_t nOfWritten;
+} CrDaTraceHeader_t;
+
+/**
+ * Write a record to the ring buffer of the trace.
+ * When the ring buffer is full, the oldest record is overwritten.
+ * @param kind the kind of the record
+ * @param code the error or outcome code
+ * @param typeId the type identifier
+ * @param instanceId the instance identifier
+ * @param arg0 the first argument
+ * @param arg1 the second argument
+ * @param arg2 the third argument
+ */
+void CrDaTraceWrite(CrDaTraceKind_t kind, unsigned int code, unsigned int typeId, unsigned int instanceId,
+                    unsigned int arg0, unsigned int arg1, unsigned int arg2);
+
+/**
+ * Return the number of records written to the ring buffer since the start.
+ * @return the number of records
+ */
+uint64_t CrDaTraceGetNOfWritten();
+
+/**
+ * Write the ring buffer of the trace to the file <code>CrDaTrace_<app>.bin</code> in the
+ * working directory.
+ * Nothing is written if no record has been written to the ring buffer.
+ * This function must only be called when no more records are being written.
+ * @param app the name of the application (e.g. "MA")
+ * @param appId the identifier of the application
+ */
+void CrDaTraceDump(const char* app, unsigned int appId);
+
+#endif /* CRDA_TRACE_H_ */
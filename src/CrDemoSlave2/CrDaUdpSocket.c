@@ -0,0 +1,384 @@
+/**
+ * @file
+ * @ingroup crDemoSlave2
+ * Implementation of interface to control the UDP socket.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdlib.h>
+#include "CrDaUdpSocket.h"
+#include "CrDaStreamMap.h"
+#include "CrDaLinkStats.h"
+#include "CrDaMetrics.h"
+#include "CrDaLatTrace.h"
+#include "CrDaCapture.h"
+#include "CrDaConstants.h"
+#include "CrFwConstants.h"
+/* Include FW Profile files */
+#include "FwSmConstants.h"
+#include "FwSmConfig.h"
+#include "FwSmCore.h"
+#include "FwPrConfig.h"
+#include "FwPrCore.h"
+#include "FwPrConstants.h"
+/* Include configuration files */
+#include "CrFwUserConstants.h"
+#include "CrFwInStreamUserPar.h"
+#include "CrFwCmpData.h"
+/* Include framework files */
+#include "InStream/CrFwInStream.h"
+#include "OutStream/CrFwOutStream.h"
+#include "BaseCmp/CrFwBaseCmp.h"
+#include "Pckt/CrFwPckt.h"
+#include "CrFwPcktInline.h"
+#include "CrFwPcktPart.h"
+#include "CrFwTime.h"
+#include "CrFwRepErr.h"
+#include "UtilityFunctions/CrFwUtilityFunctions.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <errno.h>
+
+/** The number of values of a destination or source identifier */
+#define CR_DA_UDP_SOCKET_NOF_DEST_SRC (1 << (8*sizeof(CrFwDestSrc_t)))
+
+/** The largest payload of a UDP datagram over IPv4 (65535 minus the IPv4 and UDP headers) */
+#define CR_DA_UDP_SOCKET_MAX_PAYLOAD 65507
+
+/* Each packet is sent as one datagram (see <code>::CrFwPcktGetMaxLength</code>) */
+#if (CR_FW_LARGE_PCKT_LENGTH > CR_DA_UDP_SOCKET_MAX_PAYLOAD)
+#error "The largest packet does not fit in one UDP datagram"
+#endif
+
+/** The port number */
+static int portno = 0;
+
+/** The file descriptor for the socket */
+static int sockfd = 0;
+
+/** The maximum size of an incoming packet */
+static int pcktMaxLength;
+
+/**
+ * The Pending Packet.
+ * This is the packet of the packet pool into which the last datagram has been received
+ * or NULL if no datagram is waiting to be collected.
+ */
+static CrFwPckt_t pendingPckt = NULL;
+
+/** The addresses to which the packets of each destination are sent. */
+static struct sockaddr_in destAddr[CR_DA_UDP_SOCKET_NOF_DEST_SRC];
+
+/** Flags which are set for the destinations whose address has been set. */
+static CrFwBool_t destSet[CR_DA_UDP_SOCKET_NOF_DEST_SRC];
+
+/** The multicast groups to be joined by the socket. */
+static struct in_addr groupAddr[CR_DA_UDP_SOCKET_MAX_NOF_GROUPS];
+
+/** The number of multicast groups to be joined by the socket. */
+static int nOfGroups = 0;
+
+/**
+ * Receive the next datagram from the socket into the Pending Packet.
+ * The length of the datagram is determined before it is received so that the datagram
+ * can be received directly into a packet of the packet pool.
+ * The packet is charged to the partition of the InStream of its source.
+ * Datagrams which do not hold exactly one packet are discarded.
+ * If no packet can be allocated, the datagram is left in the socket.
+ * If there is already a Pending Packet, this function does nothing.
+ * @return 1 if there is a Pending Packet; 0 otherwise
+ */
+static CrFwBool_t udpSocketFrame();
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaUdpSocketInitAction(FwPrDesc_t prDesc) {
+	CrFwCmpData_t* streamData = (CrFwCmpData_t*)FwPrGetData(prDesc);
+	struct sockaddr_in serv_addr;
+	struct ip_mreq mreq;
+	unsigned char ttl = CR_DA_UDP_SOCKET_MULTICAST_TTL;
+	int flags, yes = 1;
+	int i;
+
+	if (sockfd != 0) {	/* Check if socket is already initialized */
+		if (streamData->typeId == CR_FW_INSTREAM_TYPE)
+			CrFwInStreamDefInitAction(prDesc);
+		else
+			CrFwOutStreamDefInitAction(prDesc);
+		return;
+	}
+
+	pcktMaxLength = (int)CrFwPcktGetMaxLength();
+	pendingPckt = NULL;
+
+	sockfd = socket(AF_INET, SOCK_DGRAM, 0);
+	if (sockfd < 0) {
+		perror("CrDaUdpSocketInitAction, Socket Creation");
+		sockfd = 0;
+		streamData->outcome = 0;
+		return;
+	}
+
+	/* Set the socket to non-blocking mode */
+	if ((flags = fcntl(sockfd, F_GETFL, 0)) < 0) {
+		perror("CrDaUdpSocketInitAction, Set socket attributes");
+		streamData->outcome = 0;
+		return;
+	}
+	if (fcntl(sockfd, F_SETFL, flags | O_NONBLOCK) < 0) {
+		perror("CrDaUdpSocketInitAction, Set socket attributes");
+		streamData->outcome = 0;
+		return;
+	}
+
+	/* Several consumers on the same host may bind the same port */
+	if (setsockopt(sockfd, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes)) < 0) {
+		perror("CrDaUdpSocketInitAction, Set socket attributes");
+		streamData->outcome = 0;
+		return;
+	}
+	if (setsockopt(sockfd, IPPROTO_IP, IP_MULTICAST_TTL, &ttl, sizeof(ttl)) < 0) {
+		perror("CrDaUdpSocketInitAction, Set socket attributes");
+		streamData->outcome = 0;
+		return;
+	}
+
+	bzero((char*) &serv_addr, sizeof(serv_addr));
+	serv_addr.sin_family = AF_INET;
+	serv_addr.sin_addr.s_addr = htonl(INADDR_ANY);
+	serv_addr.sin_port = htons(portno);
+	if (bind(sockfd, (struct sockaddr*) &serv_addr, sizeof(serv_addr)) < 0) {
+		perror("CrDaUdpSocketInitAction, Bind Socket");
+		streamData->outcome = 0;
+		return;
+	}
+
+	for (i=0; i<nOfGroups; i++) {
+		mreq.imr_multiaddr = groupAddr[i];
+		mreq.imr_interface.s_addr = htonl(INADDR_ANY);
+		if (setsockopt(sockfd, IPPROTO_IP, IP_ADD_MEMBERSHIP, &mreq, sizeof(mreq)) < 0) {
+			perror("CrDaUdpSocketInitAction, Join multicast group");
+			streamData->outcome = 0;
+			return;
+		}
+	}
+
+	/* Execute default initialization action for OutStream/InStream */
+	if (streamData->typeId == CR_FW_INSTREAM_TYPE)
+		CrFwInStreamDefInitAction(prDesc);
+	else
+		CrFwOutStreamDefInitAction(prDesc);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaUdpSocketShutdownAction(FwSmDesc_t smDesc) {
+	CrFwCmpData_t* streamData = (CrFwCmpData_t*)FwSmGetData(smDesc);
+
+	if (streamData->typeId == CR_FW_INSTREAM_TYPE)
+		CrFwInStreamDefShutdownAction(smDesc);
+	else
+		CrFwOutStreamDefShutdownAction(smDesc);
+
+	if (sockfd == 0) 	/* Check if socket was already shutdown */
+		return;
+	if (pendingPckt != NULL) {
+		CrFwPcktRelease(pendingPckt);
+		pendingPckt = NULL;
+	}
+	close(sockfd);
+	sockfd = 0;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaUdpSocketInitCheck(FwPrDesc_t prDesc) {
+	CrFwCmpData_t* prData = (CrFwCmpData_t*)FwPrGetData(prDesc);
+
+	if (portno == 0) {
+		prData->outcome = 0;
+		return;
+	}
+
+	prData->outcome = 1;
+	return;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaUdpSocketConfigAction(FwPrDesc_t prDesc) {
+	CrFwCmpData_t* streamData = (CrFwCmpData_t*)FwPrGetData(prDesc);
+
+	if (pendingPckt != NULL) {
+		CrFwPcktRelease(pendingPckt);
+		pendingPckt = NULL;
+	}
+
+	if (streamData->typeId == CR_FW_INSTREAM_TYPE)
+		CrFwInStreamDefConfigAction(prDesc);
+	else if (streamData->typeId == CR_FW_OUTSTREAM_TYPE)
+		CrFwOutStreamDefConfigAction(prDesc);
+	else {
+		perror("CrDaUdpSocketConfigAction, Incorrect caller type");
+		return;
+	}
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaUdpSocketPoll() {
+	FwSmDesc_t inStream;
+	CrFwDestSrc_t src;
+
+	if (sockfd == 0)
+		return;
+
+	if (udpSocketFrame()) {
+		src = CrFwPcktGetSrc(pendingPckt);
+		inStream = CrDaStreamMapGetInStream(src);
+		CrFwInStreamPcktAvail(inStream);
+	}
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwPckt_t CrDaUdpSocketPcktCollect(CrFwDestSrc_t src) {
+	CrFwPckt_t pckt;
+
+	for (;;) {
+		if (pendingPckt == NULL)
+			return NULL;
+
+		if (CrFwPcktGetSrc(pendingPckt) != src)
+			return NULL;
+
+		pckt = pendingPckt;
+		pendingPckt = NULL;
+		if (CrDaLinkStatsRx(pckt))
+			break;
+		/* Drop the duplicate or the heartbeat before it reaches the InStream */
+		CrFwPcktRelease(pckt);
+		udpSocketFrame();
+	}
+	CrDaMetricsIn(pckt);
+	CrDaCaptureRx(pckt);
+	udpSocketFrame();	/* prepare the next datagram already received */
+	return pckt;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaUdpSocketIsPcktAvail(CrFwDestSrc_t src) {
+	if ((sockfd == 0) || !udpSocketFrame())
+		return 0;
+
+	return (CrFwPcktGetSrc(pendingPckt) == src);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaUdpSocketPcktHandover(CrFwPckt_t pckt) {
+	int len = (int)CrFwPcktGetLength(pckt);
+	CrFwDestSrc_t dest = CrFwPcktGetDest(pckt);
+	int n;
+
+	CrDaLatTraceTx(pckt);
+	if ((sockfd == 0) || !destSet[dest]) {
+		CrDaMetricsHandoverFail(pckt);
+		return 0;
+	}
+
+	n = sendto(sockfd, pckt, len, 0, (struct sockaddr*)&destAddr[dest], sizeof(struct sockaddr_in));
+	if (n < 0) {
+		if ((errno != EAGAIN) && (errno != EWOULDBLOCK))
+			perror("CrDaUdpSocketPcktHandover, Send datagram");
+		CrDaMetricsHandoverFail(pckt);
+		return 0;
+	}
+	if (n != len) {
+		CrDaMetricsHandoverFail(pckt);
+		return 0;
+	}
+
+	CrDaLinkStatsTx(pckt);
+	CrDaMetricsOut(pckt);
+	CrDaCaptureTx(pckt);
+	return 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static CrFwBool_t udpSocketFrame() {
+	unsigned char hdr[CR_FW_PCKT_HEADER_LENGTH];
+	CrFwPckt_t pckt;
+	int n;
+
+	while (pendingPckt == NULL) {
+		/* With MSG_TRUNC, the length of the whole datagram is returned */
+		n = recv(sockfd, hdr, CR_FW_PCKT_HEADER_LENGTH, MSG_PEEK | MSG_TRUNC);
+		if (n < 0) {
+			if ((errno != EAGAIN) && (errno != EWOULDBLOCK))
+				perror("CrDaUdpSocketPoll, Receive datagram");
+			return 0;
+		}
+
+		if ((n < CR_FW_PCKT_HEADER_LENGTH) || (n > pcktMaxLength) ||
+		        ((int)CrFwPcktGetLength((CrFwPckt_t)hdr) != n)) {
+			printf("CrDaUdpSocketPoll: invalid datagram received from socket\n");
+			CrDaMetricsFramingError(0);
+			recv(sockfd, hdr, 0, 0);	/* discard the datagram */
+			continue;
+		}
+
+		/* Receive the datagram directly into the packet pool */
+		pckt = CrFwPcktMakeInPart(CrFwPcktGetInStreamPart(CrFwPcktGetSrc((CrFwPckt_t)hdr)), (CrFwPcktLength_t)n);
+		if (pckt == NULL)	/* retry when a packet becomes available */
+			return 0;
+		if (recv(sockfd, pckt, n, 0) != n) {
+			CrFwPcktRelease(pckt);
+			return 0;
+		}
+		pendingPckt = pckt;
+	}
+
+	return 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaUdpSocketSetPort(int n) {
+	portno = n;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaUdpSocketSetDest(CrFwDestSrc_t dest, char* addr, int port) {
+	struct sockaddr_in* sa = &destAddr[dest];
+
+	bzero((char*)sa, sizeof(struct sockaddr_in));
+	sa->sin_family = AF_INET;
+	sa->sin_port = htons(port);
+	destSet[dest] = (inet_pton(AF_INET, addr, &sa->sin_addr) == 1);
+	return destSet[dest];
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaUdpSocketJoinGroup(char* group) {
+	if (nOfGroups == CR_DA_UDP_SOCKET_MAX_NOF_GROUPS)
+		return 0;
+
+	if (inet_pton(AF_INET, group, &groupAddr[nOfGroups]) != 1)
+		return 0;
+	if (!IN_MULTICAST(ntohl(groupAddr[nOfGroups].s_addr)))
+		return 0;
+
+	nOfGroups++;
+	return 1;
+}
@@ -0,0 +1,201 @@
+/**
+ * @file
+ * @ingroup crDemoSlave2
+ * Interface for the UDP socket used in the CORDET Demo.
+ * The UDP socket is a datagram transport which can be used alongside, or instead of,
+ * the stream transport of <code>CrDaServerSocket.h</code> and <code>CrDaClientSocket.h</code>.
+ * It is intended for the distribution of reports to several consumers: an OutStream
+ * destination can be bound to an IP multicast group and a single hand-over then
+ * reaches every consumer which has joined the group.
+ * This module defines the functions through which the InStreams and OutStreams of an
+ * application control the UDP socket:
+ * - Function <code>::CrDaUdpSocketInitAction</code> should be used as the Initialization
+ *   Action of the InStreams and OutStreams.
+ * - Function <code>::CrDaUdpSocketInitCheck</code> should be used as the Initialization
+ *   Check of the InStreams and OutStreams.
+ * - Function <code>::CrDaUdpSocketConfigAction</code> should be used as the Configuration
+ *   Action of the InStreams.
+ * - Function <code>::CrDaUdpSocketShutdownAction</code> should be used as the Shutdown
+ *   Action of the InStreams and OutStreams.
+ * - Function <code>::CrDaUdpSocketPcktCollect</code> should be used as the Packet Collect
+ *   Operation of the InStreams.
+ * - Function <code>::CrDaUdpSocketIsPcktAvail</code> should be used as the Packet Available
+ *   Check Operation of the InStreams.
+ * - Function <code>::CrDaUdpSocketPcktHandover</code> should be used as the Packet Hand-Over
+ *   Operation of the OutStreams.
+ * .
+ * The functions in this module should be accessed in mutual exclusion.
+ * Compliance with this constraint is not enforced and is therefore under the responsibility
+ * of the caller.
+ *
+ * Each datagram carries exactly one packet.
+ * Since datagrams are delivered independently of each other, the loss or the delay of a
+ * packet does not hold back the packets which follow it (there is no head-of-line blocking
+ * as on a stream connection).
+ * On the other hand, the transport is not reliable: datagrams may be lost or re-ordered.
+ * The sequence counters of the packets allow the InStreams to detect such events.
+ *
+ * The socket is bound to the port set with <code>::CrDaUdpSocketSetPort</code> on
+ * all local interfaces and it joins the multicast groups added with
+ * <code>::CrDaUdpSocketJoinGroup</code>.
+ * The address to which the packets for a destination are sent is set with
+ * <code>::CrDaUdpSocketSetDest</code>: this can be the unicast address of a single
+ * consumer or a multicast group.
+ * The address is re-used so that several consumers on the same host can bind the
+ * same port and receive the same multicast datagrams.
+ *
+ * The socket assumes a polling approach for incoming packets: function
+ * <code>::CrDaUdpSocketPoll</code> should be called periodically by an external scheduler.
+ * This function performs a non-blocking receive operation on the socket and, if a datagram
+ * has arrived, it frames it directly into a packet of the packet pool (the Pending Packet)
+ * and calls <code>::CrFwInStreamPcktAvail</code> on the InStream associated to its source.
+ * Datagrams whose length differs from the length field of their packet are discarded.
+ *
+ * If an error is encountered while performing a system call, this module uses function
+ * <code>perror</code> to print an error message and, if the error was encountered
+ * in the initialization action, it sets the outcome of the action to 0 ("failure")
+ * and returns.
+ *
+ * <b>Mode of Use of the UDP Socket Module</b>
+ *
+ * This module may be controlled jointly by multiple InStreams and/or OutStreams.
+ * Its socket is initialized when the first of these components is initialized
+ * and it is shut down when the first of these components is shut down.
+ * The port, destinations and groups must be set before the socket is initialized.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRDA_UDPSOCKET_H_
+#define CRDA_UDPSOCKET_H_
+
+/* Include Framework Files */
+#include "CrFwConstants.h"
+/* Include Configuration Files */
+#include "CrFwUserConstants.h"
+/* Include FW Profile files */
+#include "FwSmConstants.h"
+#include "FwSmConfig.h"
+#include "FwSmCore.h"
+#include "FwPrConfig.h"
+#include "FwPrCore.h"
+#include "FwPrConstants.h"
+
+/**
+ * Initialization action for the UDP socket.
+ * If the UDP socket has already been initialized, this function calls the
+ * Initialization Action of the base InStream/OutStream and then returns.
+ * If the UDP socket has not yet been initialized, this action:
+ * - creates the socket in non-blocking mode and binds it to the port set with
+ *   <code>::CrDaUdpSocketSetPort</code>
+ * - joins the multicast groups added with <code>::CrDaUdpSocketJoinGroup</code>
+ * - executes the Initialization Action of the base InStream/OutStream
+ * .
+ * If any of these operations fails, the outcome of the action is set to 0.
+ * @param prDesc the initialization procedure descriptor
+ */
+void CrDaUdpSocketInitAction(FwPrDesc_t prDesc);
+
+/**
+ * Initialization check for the UDP socket.
+ * The check is successful if the port number has been set.
+ * That the largest packet fits in one datagram is checked at compile time.
+ * @param prDesc the initialization procedure descriptor
+ */
+void CrDaUdpSocketInitCheck(FwPrDesc_t prDesc);
+
+/**
+ * Configuration action for the UDP socket.
+ * This action releases the Pending Packet and executes the Configuration Action of
+ * the base InStream/OutStream.
+ * @param prDesc the configuration procedure descriptor
+ */
+void CrDaUdpSocketConfigAction(FwPrDesc_t prDesc);
+
+/**
+ * Shutdown action for the UDP socket.
+ * This action executes the Shutdown Action of the base InStream/OutStream and, if the
+ * socket is still open, it releases the Pending Packet and closes the socket.
+ * @param smDesc the state machine descriptor
+ */
+void CrDaUdpSocketShutdownAction(FwSmDesc_t smDesc);
+
+/**
+ * Poll the UDP socket to check whether a new datagram has arrived.
+ * This function should be called periodically by an external scheduler.
+ * If a datagram has arrived, it is framed into the Pending Packet, its source
+ * is determined, and then function <code>::CrFwInStreamPcktAvail</code> is
+ * called on the InStream associated to that packet source.
+ */
+void CrDaUdpSocketPoll();
+
+/**
+ * Function implementing the Packet Collect Operation for the UDP socket.
+ * If the Pending Packet has a source attribute equal to <code>pcktSrc</code>,
+ * this function hands the Pending Packet over to the caller and receives the next
+ * datagram (if any) into a new Pending Packet.
+ * Otherwise, this function returns NULL.
+ * @param pcktSrc the source associated to the InStream
+ * @return the packet
+ */
+CrFwPckt_t CrDaUdpSocketPcktCollect(CrFwDestSrc_t pcktSrc);
+
+/**
+ * Function implementing the Packet Available Check Operation for the UDP socket.
+ * If there is no Pending Packet, the function performs a non-blocking receive on
+ * the socket into a new Pending Packet.
+ * The function returns 1 if the Pending Packet has a source attribute equal to
+ * <code>pcktSrc</code>.
+ * @param pcktSrc the source associated to the InStream
+ * @return 1 if a packet from the argument source is available; 0 otherwise
+ */
+CrFwBool_t CrDaUdpSocketIsPcktAvail(CrFwDestSrc_t pcktSrc);
+
+/**
+ * Function implementing the hand-over operation for the UDP socket.
+ * This function sends the packet as one datagram to the address set for its
+ * destination with <code>::CrDaUdpSocketSetDest</code>.
+ * It returns 0 if no address has been set for the destination or if the datagram
+ * could not be sent (in particular, if the socket buffer is full the OutStream
+ * keeps the packet and retries later).
+ * @param pckt the packet to be sent
+ * @return 1 if the datagram was sent; 0 otherwise.
+ */
+CrFwBool_t CrDaUdpSocketPcktHandover(CrFwPckt_t pckt);
+
+/**
+ * Set the port number to which the UDP socket is bound.
+ * The port number must be an integer greater than 2000.
+ * @param n the port number.
+ */
+void CrDaUdpSocketSetPort(int n);
+
+/**
+ * Set the address to which the packets for a destination are sent.
+ * The address can be the address of a single host or of an IP multicast group.
+ * @param dest the destination
+ * @param addr the address in dotted-decimal notation (e.g. "239.0.0.1")
+ * @param port the port number
+ * @return 1 if the address is valid; 0 otherwise
+ */
+CrFwBool_t CrDaUdpSocketSetDest(CrFwDestSrc_t dest, char* addr, int port);
+
+/**
+ * Add an IP multicast group to be joined by the UDP socket.
+ * At most <code>#CR_DA_UDP_SOCKET_MAX_NOF_GROUPS</code> groups can be added.
+ * @param group the address of the group in dotted-decimal notation
+ * @return 1 if the group was added; 0 otherwise
+ */
+CrFwBool_t CrDaUdpSocketJoinGroup(char* group);
+
+#endif /* CRDA_UDPSOCKET_H_ */
@@ -17,6 +17,8 @@
  * - Sub-Type 2: Command to disable temperature monitoring
  * - Sub-Type 3: Command to set the temperature limit
  * - Sub-Type 4: Report to report a temperature limit violation
+ * - Sub-Type 5: Report to acknowledge the start of a command (only sent when the
+ *   command requests it, see <code>CrDaOutCmpAck.h</code>)
  * .
  * The logical links among the three applications are as follows:
  * - The Master Application sends commands to both Slave Applications
@@ -53,6 +55,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <limits.h>
 #include <string.h>
 #include <unistd.h>
 /* Include Master Demo Files */
@@ -61,6 +64,50 @@
 #include "CrDaConstants.h"
 #include "CrDaClientSocket.h"
 #include "CrDaServerSocket.h"
+#include "CrDaShm.h"
+#include "CrDaSocketProfile.h"
+#include "CrDaCycle.h"
+#include "CrDaIoThread.h"
+#include "CrDaHandshake.h"
+#include "CrDaPhase.h"
+#include "CrDaMgrPool.h"
+#include "CrDaInLoad.h"
+#include "CrDaInManagerChain.h"
+#include "CrDaInCmdBatch.h"
+#include "CrDaInCmdExpress.h"
+#include "CrDaInCmdAsync.h"
+#include "CrDaConfig.h"
+#include "CrDaSmExec.h"
+#include "CrDaSmProf.h"
+#include "CrDaFootprint.h"
+#include "CrDaSnapshot.h"
+#include "CrDaStartUp.h"
+#include "CrDaStreamMap.h"
+#include "CrDaFrame.h"
+#include "CrDaThread.h"
+#include "CrDaShutdown.h"
+#include "CrDaSim.h"
+#include "CrDaLinkStats.h"
+#include "CrDaHeartbeat.h"
+#include "CrDaLatTrace.h"
+#include "CrDaTrace.h"
+#include "CrDaLog.h"
+#include "CrDaMetrics.h"
+#include "CrDaCapture.h"
+#include "CrDaEventLog.h"
+#include "CrDaErrQueue.h"
+#include "CrDaReplay.h"
+#include "CrDaOutBacklog.h"
+#include "CrDaOutCmpPool.h"
+#include "CrDaOutAdmit.h"
+#include "CrDaOutLoadQueue.h"
+#include "CrDaPcktTemplate.h"
+#include "CrDaInCmpPool.h"
+#include "CrDaTempGen.h"
+#include "CrDaSampler.h"
+#include "CrDaOutCmpTempBatch.h"
+#include "CrDaOutCmpTempStats.h"
+#include "CrDaOutCmpAckBatch.h"
 /* Include FW Profile files */
 #include "FwSmConstants.h"
 #include "FwSmConfig.h"
@@ -88,6 +135,125 @@
 #include "CrFwOutFactoryUserPar.h"
 #include "CrFwInFactoryUserPar.h"
 #include "CrFwCmpData.h"
+#include "CrFwPcktStats.h"
+#include "CrFwPcktArena.h"
+
+/** The InStream for the packets from the Master Application. */
+static FwSmDesc_t inStream1;
+
+#if (CR_DA_IO_THREAD == 1)
+/** The transport of the I/O thread (see <code>CrDaIoThread.h</code>). */
+#if (CR_DA_REPLAY == 1)
+static const CrDaIoTransport_t ioTransport = {&CrDaReplaySetPcktAvail, &CrDaReplayPoll,
+	&CrDaReplayWait, &CrDaReplayPcktCollect, &CrDaReplayPcktHandover};
+#else
+static const CrDaIoTransport_t ioTransport = {&CrDaClientSocketSetPcktAvail, &CrDaClientSocketPoll,
+	&CrDaClientSocketWait, &CrDaClientSocketPcktCollect, &CrDaClientSocketPcktHandover};
+#endif
+#endif
+
+/**
+ * Cycle Work Function of the Slave 2 Application (see <code>CrDaCycle.h</code>).
+ * The function performs the temperature monitoring action, polls the transport
+ * for incoming commands, and executes the InLoader and the Managers.
+ * @param i the number of the cycle
+ */
+static void slave2Cycle(unsigned int i);
+
+/**
+ * Event Work Function of the Slave 2 Application (see <code>CrDaCycle.h</code>).
+ * The function loads the packets from the InStream, executes the Managers, and
+ * checks the application errors.
+ * It is called by the Cycle Work Function and, in the event-driven mode (see
+ * <code>#CR_DA_CYCLE_EVENT_DRIVEN</code>), whenever packets arrive between the cycles.
+ * If the time-partitioned execution is selected (see <code>#CR_DA_FRAME_SCHED</code>),
+ * the Cycle Work Function executes a frame whose slots do the same work within their
+ * budgets instead (see <code>CrDaFrame.h</code>).
+ */
+static void slave2Process();
+
+/**
+ * Keep the state which must survive a restart (if the snapshot is selected) and check
+ * the application errors at the end of the processing of the incoming packets.
+ */
+static void slave2Check();
+
+/**
+ * Perform the temperature monitoring action of a cycle.
+ * @param i the number of the cycle
+ */
+static void slave2Monitor(unsigned int i);
+
+#if (CR_DA_SAMPLER == 1)
+/**
+ * The acquisition function of the sampler (see <code>CrDaSampler.h</code>) when the
+ * synthetic temperature source is not selected: acquire the temperature of channel 0.
+ * @param round the number of the round
+ * @param temp the sample of the round (output)
+ * @return always 1 (one channel)
+ */
+static unsigned int slave2Acquire(unsigned long long round, char* temp);
+#endif
+
+/** Poll the socket (or the shared-memory transport or the I/O thread) for incoming packets. */
+static void slave2Poll();
+
+#if (CR_DA_FRAME_SCHED == 1)
+/**
+ * Slot Step Function of the application slot (see <code>CrDaFrame.h</code>): it performs
+ * the temperature monitoring action of the current cycle.
+ * @return always 1
+ */
+static CrFwBool_t slave2StepApp();
+
+/**
+ * Slot Step Function of the I/O slot: it polls the transport.
+ * @return always 1
+ */
+static CrFwBool_t slave2StepIo();
+#endif
+
+/**
+ * Slot Step Function of the InLoader slot: it loads the packets from the InStream (with
+ * the InLoader drain, from all InStreams).
+ * @return always 1
+ */
+static CrFwBool_t slave2StepInLoader();
+
+/**
+ * Slot Step Function of the InManager slot: it executes the InManager (with the manager
+ * pool, all Managers) and sends the pending acknowledge reports.
+ * @return always 1
+ */
+static CrFwBool_t slave2StepInManager();
+
+#if (CR_DA_MGR_POOL == 0)
+/**
+ * Slot Step Function of the OutManager slot: it executes the OutManager.
+ * @return always 1
+ */
+static CrFwBool_t slave2StepOutManager();
+#endif
+
+/**
+ * Flag which is set if the control cycles are free-running.
+ * In the free-running mode, the cycles do not print their number, do not perform the
+ * temperature monitoring action and do not print the summary of their durations.
+ */
+static CrFwBool_t freeRunning = 0;
+
+/**
+ * The time in microseconds for which each control cycle is stalled before it loads and
+ * executes the incoming packets (zero if the cycles are not stalled).
+ * A stalled application is a slow consumer for the saturation harness
+ * <code>RunSaturation.sh</code>.
+ */
+static unsigned long stallUsec = 0;
+
+#if (CR_DA_FRAME_SCHED == 1)
+/** The number of the current cycle (for the application slot of the frame). */
+static unsigned int cycle = 0;
+#endif
 
 /**
  * Main program for the Slave 2 Application.
@@ -95,34 +261,93 @@
  * - It checks the consistency of the configuration parameters using
  *   <code>::CrFwAuxConfigCheck</code>.
  * - It initializes and configures the InStreams and OutStreams components
- *   (note that their initialization action initializes the client socket and
- *   this must be synchronized with the initialization of the server socket
- *   in the Slave 1 Application).
+ *   (note that their initialization action initializes the client socket which
+ *   connects to the server socket of the Slave 1 Application and which retries
+ *   the connection until the Slave 1 Application has started).
  * - It initializes and configures all framework components used by the
- *   Slave 2 Application.
- * - It executes a loop and in every cycle of the loop commands may be
- *   received from the Master Applications and reports may be sent to it.
+ *   Slave 2 Application (while the InStream and OutStream are initialized and
+ *   configured if the parallel start-up is selected, see <code>CrDaStartUp.h</code>).
+ * - It registers the work of a control cycle with the cycle scheduler (see
+ *   <code>CrDaCycle.h</code>) which executes the control cycles on absolute
+ *   deadlines with period <code>#CR_DA_CYCLE_PERIOD_USEC</code>; in every cycle
+ *   commands may be received from the Master Applications and reports may
+ *   be sent to it.
  * .
  * In all control cycles, the client socket waiting for commands from the
  * Master Application is polled through a call to
  * <code>::CrDaClientSocketPoll</code>.
+ * If the shared-memory transport is selected (see <code>#CR_DA_SHM_TRANSPORT</code>),
+ * <code>::CrDaShmPoll</code> is called instead.
+ * The poll and the executions of the InLoader and of the Managers are timed (see
+ * <code>CrDaPhase.h</code>) and a summary of their durations is printed every
+ * <code>#CR_DA_PHASE_REPORT_PERIOD</code> cycles and at the end of the run.
  *
  * In principle, in all control cycles, the temperature to be monitored
  * should be acquired from some external device.
  * In this example, instead, the temperature is set to a "low" value in all
  * cycles except those which are multiples of 5 when it is set to a "high"
  * value.
+ *
+ * If the synthetic temperature source is selected on the command line (see
+ * <code>CrDaTempGen.h</code>), the temperature samples are instead generated at a
+ * programmable rate over many channels and with a programmable percentage of
+ * violations and the control cycles have a period of <code>#CR_DA_TEMP_GEN_PERIOD_USEC</code>.
+ *
+ * At the end of the run, or when a termination signal is received, the application
+ * is shut down in an orderly way (see <code>CrDaShutdown.h</code>): its OutStreams
+ * are flushed and its framework components, OutStreams and InStreams are shut down.
+ *
+ * If the option <code>-f</code> is given on the command line, the control cycles are
+ * free-running (see <code>CrDaCycle.h</code>): they are executed back-to-back until a
+ * termination signal is received and they only route and execute the incoming packets.
+ * This mode is used by the throughput harness <code>RunThroughput.sh</code>.
+ * If the option <code>-w usec</code> is given on the command line, each control cycle is
+ * stalled for <code>usec</code> microseconds before it loads and executes the incoming
+ * packets so that the application is a slow consumer (this is used by the saturation
+ * harness <code>RunSaturation.sh</code>).
+ * At the end of the run, the packet and byte rates of the links are printed (see
+ * <code>CrDaLinkStats.h</code>).
+ * While the control cycles are executed, the messages of the application are written
+ * by a logging thread (see <code>CrDaLog.h</code>).
+ * If the binary trace is selected (see <code>#CR_DA_TRACE</code>), the error reports are
+ * written to the ring buffer of the trace and the ring buffer is written to a file at
+ * the end of the run (see <code>CrDaTrace.h</code>).
+ * @param argc the number of command line arguments
+ * @param argv the command line arguments
  * @return always returns EXIT_SUCCESS
  */
-int main() {
+int main(int argc, char* argv[]) {
 	FwSmDesc_t fwCmp[CR_S2_N_OF_FW_CMP];
-	FwSmDesc_t inStream1, outStream1;
+	FwSmDesc_t outStream1;
+	FwSmDesc_t stream[2];
 	CrFwConfigCheckOutcome_t configCheckOutcome;
-	int i;
-	char temp;
+	CrFwPcktStats_t pcktStats;
+	CrDaCycleStats_t cycleStats;
+	unsigned int nOfCycles;
+	int opt;
+
+	/* Parse the command line */
+	while ((opt = getopt(argc, argv, "fw:" CR_DA_TEMP_GEN_OPTIONS)) != -1) {
+		if (opt == 'f') {
+			freeRunning = 1;
+			continue;
+		}
+		if (opt == 'w') {
+			stallUsec = strtoul(optarg, NULL, 10);
+			continue;
+		}
+		if ((opt == '?') || !CrDaTempGenParseOpt(opt, optarg)) {
+			printf("Usage: %s [-f] [-w usec] [-g] [-r rate] [-n nOfChan] [-v percent] [-t duration]\n", argv[0]);
+			printf("  -f           free-running control cycles (stopped by a termination signal)\n");
+			printf("  -w usec      stall each control cycle for usec microseconds (a slow consumer)\n");
+			CrDaTempGenUsage();
+			return EXIT_SUCCESS;
+		}
+	}
 
-	/* User warning about order in which demo applications are started */
-	printf("S2: The Slave 1 Application (Server Socket) must be started before the Slave 2 Application\n");
+	/* Load the runtime configuration which overrides the compile-time sizes and tables */
+	if (!CrDaConfigLoad("S2", CR_DA_SLAVE_2))
+		return EXIT_SUCCESS;
 
 	/* Check consistency of configuration parameters */
 	configCheckOutcome = CrFwAuxConfigCheck();
@@ -137,33 +362,46 @@ int main() {
 			printf("Consistency check of InRepot parameters in InFactory failed\n");
 		return EXIT_SUCCESS;
 	}
+	if (!CrFwPcktArenaConfigure()) {
+		printf("Consistency check of the packet pool parameters failed\n");
+		return EXIT_SUCCESS;
+	}
 	printf("S2: Consistency check of configuration parameters ran successfully.\n");
 
+	/* Shut down in an orderly way on a termination signal */
+	CrDaShutdownSetSignals();
+
+	/* The pages of the packet pool are faulted in before the first packet is received */
+	CrFwPcktArenaInit();
+
+	/* The heap allocated from now on is that of the framework components */
+	CrDaFootprintStart();
+
 	/* Create In- and OutStreams */
 	inStream1 = CrFwInStreamMake(0);
 	outStream1 = CrFwOutStreamMake(0);
 
+	/* The OutStreams are flushed and shut down before the InStreams */
+	stream[0] = outStream1;
+	stream[1] = inStream1;
+
+	/* The streams of the packet sources and destinations are found in constant time */
+	CrDaStreamMapInit();
+
+#if (CR_DA_SHM_TRANSPORT == 0) && (CR_DA_REPLAY == 1)
+	/* Replay the packets captured by a previous run of the application */
+	CrDaReplaySetFile("CrDaCapture_S2.cap");
+#elif (CR_DA_SHM_TRANSPORT == 0)
 	/* Set port number and host name */
 	CrDaClientSocketSetPort(CR_DA_SOCKET_PORT);
 	CrDaClientSocketSetHost("localhost");
+	/* The standby server (if any) to which the connection fails over */
+	CrDaClientSocketSetStandby("localhost", CR_DA_SOCKET_STANDBY_PORT);
+	/* Small command and report packets must not wait for the Nagle algorithm */
+	CrDaSocketSetProfile(crDaSocketLowLatency);
+#endif
 
-	/* Initialize the InStreams and OutStreams */
-	CrFwCmpInit(outStream1);
-	if (!CrFwCmpIsInInitialized(outStream1))
-		return 0;
-	CrFwCmpInit(inStream1);
-	if (!CrFwCmpIsInInitialized(inStream1))
-		return 0;
-
-	/* Configure the InStream and OutStream */
-	CrFwCmpReset(inStream1);
-	CrFwCmpReset(outStream1);
-	if (!CrFwCmpIsInConfigured(inStream1))
-		return 0;
-	if (!CrFwCmpIsInConfigured(outStream1))
-		return 0;
-
-	/* Initialize and reset framework components */
+	/* Make the framework components */
 	fwCmp[0] = CrFwOutFactoryMake();
 	fwCmp[1] = CrFwInFactoryMake();
 	fwCmp[2] = CrFwInLoaderMake();
@@ -172,45 +410,386 @@ int main() {
 	fwCmp[5] = CrFwOutLoaderMake();
 	fwCmp[6] = CrFwOutRegistryMake();
 	fwCmp[7] = CrFwOutManagerMake(0);
-	for (i=0; i<CR_S2_N_OF_FW_CMP; i++) {
-		CrFwCmpInit(fwCmp[i]);
-		if (!CrFwCmpIsInInitialized(fwCmp[i]))
-			return 0;
-		CrFwCmpReset(fwCmp[i]);
-		if (!CrFwCmpIsInConfigured(fwCmp[i]))
-			return 0;
+
+	/* Initialize and configure the InStream and OutStream (lane 1) while the other
+	 * framework components are initialized and configured (lane 0) */
+	CrDaStartUpAddCmp("OutStream1 init", 1, crDaStartUpInit, outStream1);
+	CrDaStartUpAddCmp("InStream1 init", 1, crDaStartUpInit, inStream1);
+	CrDaStartUpAddCmp("InStream1 reset", 1, crDaStartUpReset, inStream1);
+	CrDaStartUpAddCmp("OutStream1 reset", 1, crDaStartUpReset, outStream1);
+	CrDaStartUpAddCmp("OutFactory", 0, crDaStartUpInitReset, fwCmp[0]);
+	CrDaStartUpAddCmp("InFactory", 0, crDaStartUpInitReset, fwCmp[1]);
+	CrDaStartUpAddCmp("InLoader", 0, crDaStartUpInitReset, fwCmp[2]);
+	CrDaStartUpAddCmp("InManager", 0, crDaStartUpInitReset, fwCmp[3]);
+	CrDaStartUpAddCmp("InRegistry", 0, crDaStartUpInitReset, fwCmp[4]);
+	CrDaStartUpAddCmp("OutLoader", 0, crDaStartUpInitReset, fwCmp[5]);
+	CrDaStartUpAddCmp("OutRegistry", 0, crDaStartUpInitReset, fwCmp[6]);
+	CrDaStartUpAddCmp("OutManager", 0, crDaStartUpInitReset, fwCmp[7]);
+	if (!CrDaStartUpRun())
+		return 0;
+	CrDaStartUpReport("S2");
+	if (!CrDaInManagerChainInit())
+		return 0;
+	if (!CrDaInCmdExpressInit())
+		return 0;
+	CrDaFootprintStop();
+
+	/* Resume from the state of the previous run (if the snapshot is selected) */
+	CrDaSnapshotStart("S2", CR_DA_SLAVE_2);
+
+#if (CR_DA_MGR_POOL == 1)
+	/* Start the worker threads of the independent managers */
+	CrDaMgrPoolStart();
+#endif
+
+	/* From now on, the log messages are written by the logging thread */
+	CrDaLogStart();
+
+	/* Sample the packet queues of the streams and serve the metrics (if selected) */
+	CrDaMetricsSetStreams(&stream[1], 1, &stream[0], 1);
+	CrDaMetricsStart("S2");
+
+	/* Record the traffic of the transport (if selected) */
+	CrDaCaptureStart("S2", CR_DA_SLAVE_2);
+
+	/* Append the events to the persistent event log (if selected) */
+	CrDaEventLogStart("S2", CR_DA_SLAVE_2);
+
+	/* Execute control cycles: between the cycles, the socket (or the shared-memory
+	 * transport) is serviced as incoming packets arrive and, in the event-driven mode,
+	 * the incoming packets are executed as soon as they arrive */
+	if (CrDaTempGenIsSelected()) {
+		CrDaCycleSetPeriod(CR_DA_TEMP_GEN_PERIOD_USEC);
+		nOfCycles = CrDaTempGenGetNOfCycles();
+	} else {
+		CrDaCycleSetPeriod(freeRunning ? 0 : CR_DA_CYCLE_PERIOD_USEC);
+		nOfCycles = (freeRunning ? UINT_MAX : 99);
 	}
+#if (CR_DA_SAMPLER == 1)
+	/* The samples are acquired by the sampler thread at their own rate */
+	if (!CrDaTempGenIsSelected() && !freeRunning)
+		CrDaSamplerStart(&slave2Acquire, CR_DA_SAMPLER_RATE, 0);
+#endif
+	CrDaCycleSetWork(&slave2Cycle);
+#if (CR_DA_SHM_TRANSPORT == 1)
+	CrDaCycleSetWait(&CrDaShmWait);
+#elif (CR_DA_IO_THREAD == 1)
+	CrDaCycleSetWait(&CrDaIoThreadWait);
+#elif (CR_DA_REPLAY == 1)
+	CrDaCycleSetWait(&CrDaReplayWait);
+#else
+	CrDaCycleSetWait(&CrDaClientSocketWait);
+#endif
+#if (CR_DA_OUT_BACKLOG == 1)
+	/* The OutStreams hand their packets over to the backlog which hands them over to the transport */
+#if (CR_DA_SHM_TRANSPORT == 1)
+	CrDaOutBacklogSetHandover(&CrDaShmPcktHandover);
+#elif (CR_DA_IO_THREAD == 1)
+	CrDaOutBacklogSetHandover(&CrDaIoThreadPcktHandover);
+#elif (CR_DA_REPLAY == 1)
+	CrDaOutBacklogSetHandover(&CrDaReplayPcktHandover);
+#else
+	CrDaOutBacklogSetHandover(&CrDaClientSocketPcktHandover);
+#endif
+#endif
+#if (CR_DA_CYCLE_EVENT_DRIVEN == 1)
+	CrDaCycleSetEvent(&slave2Process);
+#endif
+#if (CR_DA_HEARTBEAT == 1)
+	/* The heartbeats supervise the peers at the other end of the links (the server with the sockets) */
+#if (CR_DA_SHM_TRANSPORT == 1)
+	CrDaHeartbeatSetHandover(&CrDaShmPcktHandover);
+	CrDaHeartbeatAddPeer(CR_DA_MASTER);
+	CrDaHeartbeatAddPeer(CR_DA_SLAVE_1);
+#elif (CR_DA_REPLAY == 0)
+#if (CR_DA_IO_THREAD == 1)
+	CrDaHeartbeatSetHandover(&CrDaIoThreadPcktHandover);
+#else
+	CrDaHeartbeatSetHandover(&CrDaClientSocketPcktHandover);
+	/* A silent server is abandoned for the standby server (the socket is owned by this thread) */
+	CrDaHeartbeatSetHandler(&CrDaClientSocketLiveness);
+#endif
+	CrDaHeartbeatAddPeer(CR_DA_SLAVE_1);
+#endif
+#endif
+#if (CR_DA_FRAME_SCHED == 1)
+	/* Configure the slots of the frame of the control cycles */
+	CrDaFrameAddSlot("App", &slave2StepApp, CR_DA_FRAME_BUDGET_APP_USEC);
+	CrDaFrameAddSlot("I/O", &slave2StepIo, CR_DA_FRAME_BUDGET_IO_USEC);
+	CrDaFrameAddSlot("InLoader", &slave2StepInLoader, CR_DA_FRAME_BUDGET_IN_LOADER_USEC);
+	CrDaFrameAddSlot("InManager", &slave2StepInManager, CR_DA_FRAME_BUDGET_IN_MANAGER_USEC);
+#if (CR_DA_MGR_POOL == 0)
+	CrDaFrameAddSlot("OutManager", &slave2StepOutManager, CR_DA_FRAME_BUDGET_OUT_MANAGER_USEC);
+#endif
+#endif
+#if (CR_DA_IO_THREAD == 1)
+	/* From now on, the socket is owned by the I/O thread */
+	if (!CrDaIoThreadStart(&ioTransport))
+		return 0;
+	/* Keep the control loop on its core (the I/O thread has placed itself) */
+	CrDaThreadLockMemory();
+	CrDaThreadPlace(crDaThreadCycle);
+	CrDaCycleRun(nOfCycles);
+	CrDaShutdownFlush(stream, 1);
+	CrDaIoThreadStop();
+#else
+	/* Keep the control loop on its core (if the placement of the threads is selected) */
+	CrDaThreadLockMemory();
+	CrDaThreadPlace(crDaThreadCycle);
+	CrDaCycleRun(nOfCycles);
+	CrDaShutdownFlush(stream, 1);
+	/* Leave the simulation once the packets have been flushed (if the simulation mode is selected) */
+	CrDaSimLeave();
+#endif
+#if (CR_DA_MGR_POOL == 1)
+	CrDaMgrPoolStop();
+#endif
+	CrDaSamplerStop();
+	CrDaCaptureStop();
+	CrDaEventLogStop();
+	CrDaSnapshotStop();
+	CrDaMetricsStop();
+	CrDaLogStop();
+	if (CrDaCycleIsStopped())
+		printf("S2: Termination signal received, shutting down\n");
+
+	/* Report the overruns of the control cycles */
+	CrDaCycleGetStats(&cycleStats);
+	printf("S2: Control cycles: %u executed, %u overruns, %u deadlines skipped, worst overrun %lu us\n",
+	       cycleStats.nOfCycles, cycleStats.nOfOverruns, cycleStats.nOfSkipped, cycleStats.maxOverrun);
+	printf("S2: Control cycles: wake-up jitter mean %.1f us, max %.1f us over %u wake-ups\n",
+	       (cycleStats.nOfWakeUps == 0 ? 0.0 : (double)cycleStats.totJitter/cycleStats.nOfWakeUps/1000.0),
+	       cycleStats.maxJitter/1000.0, cycleStats.nOfWakeUps);
+	CrDaThreadReport("S2");
+	CrDaPhaseReport("S2");
+	CrDaFrameReport("S2");
+	CrDaLinkStatsReport("S2");
+	CrDaHandshakeReport("S2");
+	CrDaHeartbeatReport("S2");
+	CrDaLatTraceReport("S2");
+	CrDaIoThreadReport("S2");
+	CrDaOutBacklogReport("S2");
+	CrDaOutCmpPoolReport("S2");
+	CrDaOutAdmitReport("S2");
+	CrDaOutLoadQueueReport("S2");
+	CrDaPcktTemplateReport("S2");
+	CrDaInCmpPoolReport("S2");
+	CrDaInManagerChainReport("S2");
+	CrDaInCmdBatchReport("S2");
+	CrDaInCmdExpressReport("S2");
+	CrDaInCmdAsyncReport("S2");
+	CrDaSmExecReport("S2");
+	CrDaSmProfDump("S2");
+	CrDaFootprintReport("S2");
+	CrDaTempGenReport("S2");
+	CrDaSamplerReport("S2");
+	CrDaTempMonitoringReport("S2");
+	CrDaOutCmpTempBatchReport("S2");
+	CrDaOutCmpTempStatsReport("S2");
+	CrDaOutCmpAckBatchReport("S2");
+	CrDaEventLogReport("S2");
+	CrDaErrQueueReport("S2");
+
+	/* Shut down the framework components and then the OutStreams and InStreams (this
+	 * releases the packets which they still hold and closes the connections) */
+	CrDaShutdownCmp(fwCmp, CR_S2_N_OF_FW_CMP);
+	CrDaShutdownCmp(stream, 2);
+
+	/* Report the usage of the packet pool */
+	CrFwPcktGetStats(&pcktStats);
+	printf("S2: Packet pool: high-water mark %d of %d, %u allocations, %u releases\n", pcktStats.highWaterMark,
+	       CR_FW_MAX_NOF_PCKTS, pcktStats.nOfMake, pcktStats.nOfRelease);
+	printf("S2: Packet pool: failed allocations (small/medium/large/illegal): %u/%u/%u/%u\n",
+	       pcktStats.nOfMakeFail[0], pcktStats.nOfMakeFail[1], pcktStats.nOfMakeFail[2], pcktStats.nOfMakeFail[3]);
+
+	/* Write the binary trace of the error reports (if the binary trace is selected) */
+	CrDaTraceDump("S2", CR_DA_SLAVE_2);
+
+	return EXIT_SUCCESS;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void slave2Cycle(unsigned int i) {
+	CrDaMetricsSample();
+	/* Hand over the packets which the transport did not accept (if the OutStream backlog is selected) */
+	CrDaOutBacklogFlush();
+	/* Retry the requests which were deferred because no OutComponent was available */
+	CrDaOutAdmitCycle();
+
+#if (CR_DA_FRAME_SCHED == 1)
+	/* Perform the temperature monitoring action, poll the transport and load and execute
+	 * the incoming packets in the slots of the frame, each one within its budget (see
+	 * CrDaFrame.h) */
+	cycle = i;
+	CrDaFrameRun();
+	/* Send the pending batch report at the end of its window (if coalescing is selected) */
+	CrDaOutCmpTempBatchCycle();
+	/* Send the statistics reports at the end of their window (if they are selected) */
+	CrDaOutCmpTempStatsCycle();
+	slave2Check();
+#else
+	slave2Monitor(i);
+	/* Send the pending batch report at the end of its window (if coalescing is selected) */
+	CrDaOutCmpTempBatchCycle();
+	/* Send the statistics reports at the end of their window (if they are selected) */
+	CrDaOutCmpTempStatsCycle();
 
-	/* Execute control cycles */
-	for (i=1; i<100; i++) {
-		printf("S2: Starting cycle %d\n",i);
+	/* Poll socket (or shared-memory transport or I/O thread) for incoming commands */
+	slave2Poll();
+
+	/* Stall the cycle (if the application is a slow consumer) */
+	if (stallUsec > 0)
+		usleep(stallUsec);
+
+	/* Load and execute the incoming packets */
+	slave2Process();
+#endif
+
+	/* Send the heartbeats which are due and check the liveness of the peers */
+	CrDaHeartbeatCycle();
+
+	/* Report where the time of the cycles goes */
+	if (!freeRunning && ((i % CR_DA_PHASE_REPORT_PERIOD) == 0))
+		CrDaPhaseReport("S2");
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void slave2Process() {
+	/* Load packets from the InStream */
+	slave2StepInLoader();
+	/* Execute Managers (with the manager pool, the independent ones are executed concurrently) */
+	slave2StepInManager();
+#if (CR_DA_MGR_POOL == 0)
+	slave2StepOutManager();
+#endif
+	slave2Check();
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void slave2Check() {
+	/* Keep the state which must survive a restart (if the snapshot is selected) */
+	CrDaSnapshotTake();
+
+	/* Check application errors */
+#if (CR_DA_ERR_QUEUE == 1)
+	CrDaErrQueueMonitor("S2");
+#else
+	if (CrFwGetAppErrCode() != crNoAppErr) {
+		CR_DA_LOG(crDaLogError, "S2: Application Error Code is set and is equal to: %d\n",CrFwGetAppErrCode());
+	}
+#endif
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void slave2Monitor(unsigned int i) {
+#if (CR_DA_SAMPLER == 0)
+	char temp;
+#endif
+
+	if (CrDaTempGenIsSelected()) {
+		/* Perform temperature monitoring actions on the samples of the synthetic source */
+		CrDaTempGenCycle(CR_S2_LOW_TEMP_VALUE, CR_S2_HIGH_TEMP_VALUE);
+	} else if (!freeRunning) {
+		CR_DA_LOG(crDaLogDebug, "S2: Starting cycle %u\n",i);
+#if (CR_DA_SAMPLER == 1)
+		/* Perform temperature monitoring actions on the samples acquired since the previous cycle */
+		CrDaSamplerConsume(CR_DA_SLAVE_2);
+#else
 		/* Set temperature value */
 		if (i%5 != 0)
 			temp = CR_S2_LOW_TEMP_VALUE;
 		else
 			temp = CR_S2_HIGH_TEMP_VALUE;
 		/* Perform temperature monitoring action */
-		CrDaTempMonitoringExec(temp, CR_DA_SLAVE_2);
+		CrDaTempMonitoringExec(temp, 0, CR_DA_SLAVE_2);
+#endif
+	}
+}
 
-		/* Poll socket for incoming commands */
-		CrDaClientSocketPoll();
+#if (CR_DA_SAMPLER == 1)
+/* ---------------------------------------------------------------------------------------------*/
+static unsigned int slave2Acquire(unsigned long long round, char* temp) {
+	/* Set temperature value */
+	if (round%5 != 0)
+		temp[0] = CR_S2_LOW_TEMP_VALUE;
+	else
+		temp[0] = CR_S2_HIGH_TEMP_VALUE;
+	return 1;
+}
+#endif
 
-		/* Load packets from the InStream */
-		CrFwInLoaderSetInStream(inStream1);
-		FwSmExecute(CrFwInLoaderMake());
+/* ---------------------------------------------------------------------------------------------*/
+static void slave2Poll() {
+	CrDaPhaseStart(crDaPhasePoll);
+#if (CR_DA_SHM_TRANSPORT == 1)
+	CrDaShmPoll();
+#elif (CR_DA_IO_THREAD == 1)
+	CrDaIoThreadPoll();
+#elif (CR_DA_REPLAY == 1)
+	CrDaReplayPoll();
+#else
+	CrDaClientSocketPoll();
+#endif
+	CrDaPhaseStop(crDaPhasePoll);
+}
 
-		/* Execute Managers */
-		FwSmExecute(CrFwInManagerMake(0));
-		FwSmExecute(CrFwOutManagerMake(0));
+#if (CR_DA_FRAME_SCHED == 1)
+/* ---------------------------------------------------------------------------------------------*/
+static CrFwBool_t slave2StepApp() {
+	slave2Monitor(cycle);
+	return 1;
+}
 
-		/* Check application errors */
-		if (CrFwGetAppErrCode() != crNoAppErr) {
-			printf("S2: Application Error Code is set and is equal to: %d\n",CrFwGetAppErrCode());
-		}
+/* ---------------------------------------------------------------------------------------------*/
+static CrFwBool_t slave2StepIo() {
+	slave2Poll();
+	return 1;
+}
+#endif
 
-		/* Wait 1 second and then continue */
-		sleep(1);
-	}
+/* ---------------------------------------------------------------------------------------------*/
+static CrFwBool_t slave2StepInLoader() {
+#if (CR_DA_IN_LOAD_DRAIN == 1)
+	CrDaPhaseStart(crDaPhaseInLoader);
+	CrDaInLoadAll();
+	CrDaPhaseStop(crDaPhaseInLoader);
+#else
+	CrDaPhaseStart(crDaPhaseInLoader);
+	CrDaSmExecInLoader(inStream1);
+	CrDaInCmdExpressHandOff();
+	CrDaPhaseStop(crDaPhaseInLoader);
+#endif
 
-	return EXIT_SUCCESS;
+	/* Record the peak use of the InCommand and InReport pools */
+	CrDaInCmpPoolSample();
+	return 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static CrFwBool_t slave2StepInManager() {
+	CrDaPhaseStart(crDaPhaseInManager);
+#if (CR_DA_MGR_POOL == 1)
+	CrDaOutLoadQueueDrain();	/* the requests of the application threads are loaded before the OutManagers run */
+	CrDaMgrPoolExecute();
+	CrDaInManagerChainRelease();
+	CrDaInCmdExpressRelease();
+#else
+	CrDaInCmdExpressExecute();
+	CrDaInManagerChainExecute(0);
+#endif
+	CrDaInCmdBatchFlush();
+	CrDaOutCmpAckBatchFlush();	/* the outcomes of the cycle are sent in one report to each source */
+	CrDaPhaseStop(crDaPhaseInManager);
+	return 1;
+}
+
+#if (CR_DA_MGR_POOL == 0)
+/* ---------------------------------------------------------------------------------------------*/
+static CrFwBool_t slave2StepOutManager() {
+	CrDaPhaseStart(crDaPhaseOutManager);
+	CrDaOutLoadQueueDrain();	/* the requests of the application threads are loaded before the OutManager runs */
+	CrDaSmExecOutManager(CrFwOutManagerMake(0));
+	CrDaPhaseStop(crDaPhaseOutManager);
+	return 1;
 }
+#endif
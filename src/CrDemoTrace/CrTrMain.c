@@ -0,0 +1,147 @@
+/**
+ * @file
+ * @ingroup crDemoTrace
+ * Main program of the decoder of the binary event trace of the CORDET Demo.
+ * The decoder reads a trace file written by a demo application at the end of its run
+ * (see <code>CrDaTrace.h</code>) and prints its records in chronological order, one
+ * line per record, with the time relative to the first record.
+ * The error reports are rendered like the error reporting interface of the demo
+ * applications renders them when the binary trace is not selected.
+ *
+ * If more records were written than the ring buffer holds, only the last records are
+ * in the trace file and the number of overwritten records is printed first.
+ *
+ * The decoder only depends on <code>CrDaTrace.h</code>: it can be built without the
+ * framework (see the <code>trace</code> target of the Makefile).
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "CrDaTrace.h"
+
+/** The names of the kinds of trace records (the names of the reporting functions). */
+static const char* traceKindName[CR_DA_TRACE_N_OF_KINDS] = {
+	"CrFwRepErr", "CrFwRepErrDestSrc", "CrFwRepErrInstanceIdAndDest", "CrFwRepErrSeqCnt",
+	"CrFwRepErrGroup", "CrFwRepErrInstanceIdAndOutcome", "CrFwRepErrPckt", "CrFwRepErrRep",
+	"CrFwRepErrCmd", "CrFwRepErrKind", "CrFwRepInCmdOutcome", "CrFwRepInCmdOutcomeCreFail"
+};
+
+/**
+ * Print one trace record.
+ * @param rec the record
+ * @param start the time of the first record in nanoseconds
+ */
+static void tracePrintRec(const CrDaTraceRec_t* rec, uint64_t start);
+
+/**
+ * Main program of the trace decoder.
+ * @param argc the number of command line arguments
+ * @param argv the command line arguments: the name of the trace file
+ * @return EXIT_SUCCESS if the trace file could be decoded; EXIT_FAILURE otherwise
+ */
+int main(int argc, char* argv[]) {
+	CrDaTraceHeader_t header;
+	CrDaTraceRec_t* ring;
+	uint64_t i, first;
+	FILE* file;
+
+	if (argc != 2) {
+		printf("Usage: %s traceFile\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+	file = fopen(argv[1], "rb");
+	if (file == NULL) {
+		perror("main()");
+		return EXIT_FAILURE;
+	}
+	if (fread(&header, sizeof(header), 1, file) != 1) {
+		printf("main(): cannot read the header of %s\n", argv[1]);
+		fclose(file);
+		return EXIT_FAILURE;
+	}
+	if ((header.magic != CR_DA_TRACE_MAGIC) || (header.version != CR_DA_TRACE_VERSION) ||
+	        (header.recSize != sizeof(CrDaTraceRec_t)) || (header.nOfRecs == 0) ||
+	        ((header.nOfRecs & (header.nOfRecs - 1)) != 0)) {
+		printf("main(): %s is not a trace file of version %d\n", argv[1], CR_DA_TRACE_VERSION);
+		fclose(file);
+		return EXIT_FAILURE;
+	}
+	ring = malloc(header.nOfRecs * sizeof(CrDaTraceRec_t));
+	if ((ring == NULL) || (fread(ring, sizeof(CrDaTraceRec_t), header.nOfRecs, file) != header.nOfRecs)) {
+		printf("main(): cannot read the records of %s\n", argv[1]);
+		free(ring);
+		fclose(file);
+		return EXIT_FAILURE;
+	}
+	fclose(file);
+
+	/* The oldest record which has not been overwritten */
+	first = (header.nOfWritten > header.nOfRecs) ? header.nOfWritten - header.nOfRecs : 0;
+	printf("Trace of application %u: %llu records", header.appId, (unsigned long long)header.nOfWritten);
+	if (first > 0)
+		printf(" (the first %llu have been overwritten)", (unsigned long long)first);
+	printf("\n");
+	for (i=first; i<header.nOfWritten; i++)
+		tracePrintRec(&ring[i & (header.nOfRecs - 1)], ring[first & (header.nOfRecs - 1)].time);
+
+	free(ring);
+	return EXIT_SUCCESS;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void tracePrintRec(const CrDaTraceRec_t* rec, uint64_t start) {
+	const char* name = (rec->kind < CR_DA_TRACE_N_OF_KINDS) ? traceKindName[rec->kind] : "Unknown";
+
+	printf("%12.6f %s: ", (double)(int64_t)(rec->time - start) / 1e9, name);
+	switch (rec->kind) {
+	case crDaTraceInCmdOutcome:
+		printf("outcome %u for InCommand %u, service type %u, service sub-type %u, discriminant %u; fail code: %u\n",
+		       rec->code, rec->instanceId, rec->arg[0], rec->arg[1], rec->arg[2], rec->typeId);
+		return;
+	case crDaTraceInCmdOutcomeCreFail:
+		printf("outcome %u, failure to create InCommand component; fail code: %u\n", rec->code, rec->typeId);
+		return;
+	default:
+		break;
+	}
+
+	printf("error %u generated by component %u of type %u", rec->code, rec->instanceId, rec->typeId);
+	switch (rec->kind) {
+	case crDaTraceRepErrDestSrc:
+		printf(" for dest/src %u", rec->arg[0]);
+		break;
+	case crDaTraceRepErrInstanceIdAndDest:
+		printf(", secondary instance identifier: %u, destination: %u", rec->arg[0], rec->arg[1]);
+		break;
+	case crDaTraceRepErrSeqCnt:
+		printf(", expected sequence counter: %u, actual sequence counter: %u", rec->arg[0], rec->arg[1]);
+		break;
+	case crDaTraceRepErrGroup:
+		printf(", invalid group: %u", rec->arg[0]);
+		break;
+	case crDaTraceRepErrInstanceIdAndOutcome:
+		printf(", secondary instance identifier: %u, outcome: %u", rec->arg[0], rec->arg[1]);
+		break;
+	case crDaTraceRepErrPckt:
+		printf(", pckt[0]: %u, pckt[1]: %u", rec->arg[0], rec->arg[1]);
+		break;
+	case crDaTraceRepErrKind:
+		printf(", service type: %u, service sub-type: %u, discriminant: %u", rec->arg[0], rec->arg[1], rec->arg[2]);
+		break;
+	default:
+		break;
+	}
+	printf("\n");
+}